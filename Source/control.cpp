@@ -777,6 +777,18 @@ void DrawCtrlBtns(const CelOutputBuffer &out)
 	}
 }
 
+std::uint32_t GetCtrlBtnsState()
+{
+	std::uint32_t state = numpanbtns;
+	for (int i = 0; i < numpanbtns; i++) {
+		if (panbtns[i])
+			state |= 1 << (8 + i);
+	}
+	if (gbFriendlyMode)
+		state |= 1 << 16;
+	return state;
+}
+
 /**
  * Draws the "Speed Book": the rows of known spells for quick-setting a spell that
  * show up when you click the spell slot at the control panel.
@@ -1095,6 +1107,30 @@ void FreeControlPan()
 	pGBoxBuff = std::nullopt;
 }
 
+namespace {
+
+/** @brief Mix a string into an FNV-1a hash */
+std::uint32_t HashString(std::uint32_t hash, const char *str)
+{
+	for (; *str != '\0'; str++)
+		hash = (hash ^ static_cast<std::uint8_t>(*str)) * 16777619U;
+	// Separate consecutive strings
+	return (hash ^ 0xFF) * 16777619U;
+}
+
+} // namespace
+
+std::uint32_t GetInfoBoxState()
+{
+	std::uint32_t state = 2166136261U;
+	state = (state ^ infoclr) * 16777619U;
+	state = (state ^ (talkflag ? 1 : 0)) * 16777619U;
+	state = HashString(state, infostr);
+	for (int i = 0; i < pnumlines; i++)
+		state = HashString(state, panelstr[i]);
+	return state;
+}
+
 static void PrintInfo(const CelOutputBuffer &out)
 {
 	if (talkflag)
@@ -103,6 +103,11 @@ void DrawCtrlPan(const CelOutputBuffer &out);
  */
 void DrawCtrlBtns(const CelOutputBuffer &out);
 
+/**
+ * @brief Summary of what DrawCtrlBtns shows, changes whenever the buttons look different
+ */
+std::uint32_t GetCtrlBtnsState();
+
 void DoSpeedBook();
 void DoPanBtn();
 void control_check_btn_press();
@@ -115,6 +120,11 @@ void FreeControlPan();
  * Sets a string to be drawn in the info box and then draws it.
  */
 void DrawInfoBox(const CelOutputBuffer &out);
+
+/**
+ * @brief Summary of the text shown by the last DrawInfoBox, changes whenever the info box looks different
+ */
+std::uint32_t GetInfoBoxState();
 void DrawChr(const CelOutputBuffer &out);
 void CheckLvlBtn();
 void ReleaseLvlBtn();
@@ -292,10 +292,7 @@ void FindMeleeTarget()
 				continue;
 			}
 
-			PATHNODE pPath;
-			pPath.position = { node.x, node.y };
-
-			if (path_solid_pieces(&pPath, dx, dy)) {
+			if (path_solid_pieces({ node.x, node.y }, { dx, dy })) {
 				queue.push_back({ dx, dy, node.steps + 1 });
 				visited[dx][dy] = true;
 			}
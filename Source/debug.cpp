@@ -8,6 +8,7 @@
 #include "engine/cel_sprite.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/point.hpp"
+#include "engine/sprite_cache.hpp"
 #include "inv.h"
 #include "spells.h"
 #include "utils/language.h"
@@ -235,6 +236,17 @@ void NextDebugMonster()
 	sprintf(dstr, "Current debug monster = %i", dbgmon);
 	NetSendCmdString(1 << myplr, dstr);
 }
+
+void PrintDebugSpriteCache()
+{
+	char dstr[128];
+
+	SpriteCacheStats stats = GetSpriteCacheStats();
+	sprintf(dstr, "Sprite cache: %i hits, %i misses", stats.hits, stats.misses);
+	NetSendCmdString(1 << myplr, dstr);
+	sprintf(dstr, "%i sprites, %i KB", static_cast<int>(stats.entries), static_cast<int>(stats.bytes / 1024));
+	NetSendCmdString(1 << myplr, dstr);
+}
 #endif
 
 } // namespace devilution
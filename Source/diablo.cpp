@@ -25,9 +25,14 @@
 #include "drlg_l4.h"
 #include "dx.h"
 #include "encrypt.h"
+#include "engine/asset_loader.hpp"
 #include "engine/cel_sprite.hpp"
+#include "engine/compress_sectors.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
+#include "engine/render/dun_tile_cache.hpp"
+#include "engine/render/render_bands.hpp"
+#include "engine/sprite_cache.hpp"
 #include "error.h"
 #include "gamemenu.h"
 #include "gmenu.h"
@@ -59,6 +64,7 @@
 #include "utils/console.h"
 #include "utils/language.h"
 #include "utils/paths.h"
+#include "utils/profiler.h"
 #include "utils/language.h"
 #include "controls/keymapper.hpp"
 
@@ -101,6 +107,9 @@ int sgnTimeoutCurs;
 clicktype sgbMouseDown;
 int color_cycle_timer;
 uint16_t gnTickDelay = 50;
+/** Level whose files were last handed to the asset loader, to avoid queuing them again every game tick */
+int sgnPrefetchedLevel = -1;
+dungeon_type sgPrefetchedLevelType;
 Keymapper keymapper {
 	// Workaround: remove once the INI library has been replaced.
 	[](const std::string &key, const std::string &value) {
@@ -168,6 +177,8 @@ void initKeymapActions();
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "--ttf-name", _("Specify the name of a custom .ttf font"));
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "-n", _("Skip startup videos"));
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "-f", _("Display frames per second"));
+	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "--profile", _("Display the time spent on each stage of a frame"));
+	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "--profile-trace", _("Record a Chrome trace of each frame to the given file"));
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "-x", _("Run in windowed mode"));
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "--verbose", _("Enable verbose logging"));
 	printInConsole("    %-20s %-30s\n", /* TRANSLATORS: Commandline Option */ "--spawn", _("Force spawn mode even if diabdat.mpq is found"));
@@ -216,6 +227,10 @@ static void diablo_parse_flags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (strcasecmp("-f", argv[i]) == 0) {
 			EnableFrameCount();
+		} else if (strcasecmp("--profile", argv[i]) == 0) {
+			ToggleProfilerOverlay();
+		} else if (strcasecmp("--profile-trace", argv[i]) == 0) {
+			StartProfilerTrace(argv[++i]);
 		} else if (strcasecmp("-x", argv[i]) == 0) {
 			gbForceWindowed = true;
 		} else if (strcasecmp("--spawn", argv[i]) == 0) {
@@ -419,6 +434,8 @@ static void run_game_loop(interface_mode uMsg)
 	saveProc = SetWindowProc(saveProc);
 	assert(saveProc == GM_Game);
 	free_game();
+	ClearPrefetchedFiles();
+	sgnPrefetchedLevel = -1;
 
 	if (cineflag) {
 		cineflag = false;
@@ -493,6 +510,11 @@ static void diablo_init()
 {
 	if (sgOptions.Graphics.bShowFPS)
 		EnableFrameCount();
+	SetSpriteCacheBudget(static_cast<size_t>(std::max(sgOptions.Graphics.nSpriteCacheSize, 0)) * 1024 * 1024);
+	SetRenderThreadCount(sgOptions.Graphics.nRenderThreads);
+	SetCompressThreadCount(0);
+	// Each render thread keeps its own tile cache
+	SetTileCacheBudget(static_cast<size_t>(std::max(sgOptions.Graphics.nTileCacheSize, 0)) * 1024 / GetRenderThreadCount());
 
 	init_create_window();
 	was_window_init = true;
@@ -573,6 +595,12 @@ static void diablo_deinit()
 #endif
 	if (was_ui_init)
 		UiDestroy();
+	StopProfilerTrace();
+	FreeAssetLoader();
+	FreeSpriteCache();
+	FreeRenderThreads();
+	FreeCompressThreads();
+	InvalidateTileCache();
 	if (was_archives_init)
 		init_cleanup();
 	if (was_window_init)
@@ -1161,6 +1189,10 @@ static void PressChar(int32_t vkey)
 			ToggleLighting();
 		}
 		return;
+	case 'G':
+	case 'g':
+		PrintDebugSpriteCache();
+		return;
 	case 'M':
 		NextDebugMonster();
 		return;
@@ -1330,70 +1362,69 @@ void GM_Game(uint32_t uMsg, int32_t wParam, int32_t lParam)
 	MainWndProc(uMsg);
 }
 
-void LoadLvlGFX()
-{
-	assert(pDungeonCels == nullptr);
-	constexpr int SpecialCelWidth = 64;
+struct LevelGfxFiles {
+	const char *cel;
+	const char *til;
+	const char *min;
+	const char *special;
+};
 
-	switch (leveltype) {
+static LevelGfxFiles GetLevelGfxFiles(dungeon_type levelType, int level)
+{
+	switch (levelType) {
 	case DTYPE_TOWN:
-		if (gbIsHellfire) {
-			pDungeonCels = LoadFileInMem("NLevels\\TownData\\Town.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\TownData\\Town.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\TownData\\Town.MIN");
-		} else {
-			pDungeonCels = LoadFileInMem("Levels\\TownData\\Town.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("Levels\\TownData\\Town.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("Levels\\TownData\\Town.MIN");
-		}
-		pSpecialCels = LoadCel("Levels\\TownData\\TownS.CEL", SpecialCelWidth);
-		break;
+		if (gbIsHellfire)
+			return { "NLevels\\TownData\\Town.CEL", "NLevels\\TownData\\Town.TIL", "NLevels\\TownData\\Town.MIN", "Levels\\TownData\\TownS.CEL" };
+		return { "Levels\\TownData\\Town.CEL", "Levels\\TownData\\Town.TIL", "Levels\\TownData\\Town.MIN", "Levels\\TownData\\TownS.CEL" };
 	case DTYPE_CATHEDRAL:
-		if (currlevel < 21) {
-			pDungeonCels = LoadFileInMem("Levels\\L1Data\\L1.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L1Data\\L1.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L1Data\\L1.MIN");
-			pSpecialCels = LoadCel("Levels\\L1Data\\L1S.CEL", SpecialCelWidth);
-		} else {
-			pDungeonCels = LoadFileInMem("NLevels\\L5Data\\L5.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\L5Data\\L5.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\L5Data\\L5.MIN");
-			pSpecialCels = LoadCel("NLevels\\L5Data\\L5S.CEL", SpecialCelWidth);
-		}
-		break;
+		if (level < 21)
+			return { "Levels\\L1Data\\L1.CEL", "Levels\\L1Data\\L1.TIL", "Levels\\L1Data\\L1.MIN", "Levels\\L1Data\\L1S.CEL" };
+		return { "NLevels\\L5Data\\L5.CEL", "NLevels\\L5Data\\L5.TIL", "NLevels\\L5Data\\L5.MIN", "NLevels\\L5Data\\L5S.CEL" };
 	case DTYPE_CATACOMBS:
-		pDungeonCels = LoadFileInMem("Levels\\L2Data\\L2.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L2Data\\L2.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L2Data\\L2.MIN");
-		pSpecialCels = LoadCel("Levels\\L2Data\\L2S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L2Data\\L2.CEL", "Levels\\L2Data\\L2.TIL", "Levels\\L2Data\\L2.MIN", "Levels\\L2Data\\L2S.CEL" };
 	case DTYPE_CAVES:
-		if (currlevel < 17) {
-			pDungeonCels = LoadFileInMem("Levels\\L3Data\\L3.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L3Data\\L3.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L3Data\\L3.MIN");
-		} else {
-			pDungeonCels = LoadFileInMem("NLevels\\L6Data\\L6.CEL");
-			pMegaTiles = LoadFileInMem<MegaTile>("NLevels\\L6Data\\L6.TIL");
-			pLevelPieces = LoadFileInMem<uint16_t>("NLevels\\L6Data\\L6.MIN");
-		}
-		pSpecialCels = LoadCel("Levels\\L1Data\\L1S.CEL", SpecialCelWidth);
-		break;
+		if (level < 17)
+			return { "Levels\\L3Data\\L3.CEL", "Levels\\L3Data\\L3.TIL", "Levels\\L3Data\\L3.MIN", "Levels\\L1Data\\L1S.CEL" };
+		return { "NLevels\\L6Data\\L6.CEL", "NLevels\\L6Data\\L6.TIL", "NLevels\\L6Data\\L6.MIN", "Levels\\L1Data\\L1S.CEL" };
 	case DTYPE_HELL:
-		pDungeonCels = LoadFileInMem("Levels\\L4Data\\L4.CEL");
-		pMegaTiles = LoadFileInMem<MegaTile>("Levels\\L4Data\\L4.TIL");
-		pLevelPieces = LoadFileInMem<uint16_t>("Levels\\L4Data\\L4.MIN");
-		pSpecialCels = LoadCel("Levels\\L2Data\\L2S.CEL", SpecialCelWidth);
-		break;
+		return { "Levels\\L4Data\\L4.CEL", "Levels\\L4Data\\L4.TIL", "Levels\\L4Data\\L4.MIN", "Levels\\L2Data\\L2S.CEL" };
 	default:
 		app_fatal("LoadLvlGFX");
 	}
 }
 
+void LoadLvlGFX()
+{
+	assert(pDungeonCels == nullptr);
+	constexpr int SpecialCelWidth = 64;
+
+	InvalidateTileCache();
+	LevelGfxFiles files = GetLevelGfxFiles(leveltype, currlevel);
+	pDungeonCels = LoadFileInMem(files.cel);
+	pMegaTiles = LoadFileInMem<MegaTile>(files.til);
+	pLevelPieces = LoadFileInMem<uint16_t>(files.min);
+	pSpecialCels = LoadCel(files.special, SpecialCelWidth);
+}
+
+void PrefetchLevelAssets(int level, dungeon_type levelType)
+{
+	if (level == sgnPrefetchedLevel && levelType == sgPrefetchedLevelType)
+		return;
+
+	sgnPrefetchedLevel = level;
+	sgPrefetchedLevelType = levelType;
+
+	LevelGfxFiles files = GetLevelGfxFiles(levelType, level);
+	PrefetchFile(files.cel);
+	PrefetchFile(files.til);
+	PrefetchFile(files.min);
+	PrefetchFile(files.special);
+	PrefetchMissileGFX();
+}
+
 void LoadAllGFX()
 {
-	IncProgress();
-	IncProgress();
+	WaitForPrefetchedFiles(2);
 	InitObjectGFX();
 	IncProgress();
 	InitMissileGFX();
@@ -1412,7 +1443,10 @@ void CreateLevel(lvl_entry lvldir)
 		LoadRndLvlPal(DTYPE_TOWN);
 		break;
 	case DTYPE_CATHEDRAL:
-		CreateL5Dungeon(glSeedTbl[currlevel], lvldir);
+		DRLG_Init_Globals();
+		CreateL5Dungeon(ActiveDungeon, glSeedTbl[currlevel], lvldir);
+		ApplyDungeonQuestPositions(ActiveDungeon);
+		InitL5CornerStone();
 		InitL1Triggers();
 		Freeupstairs();
 		if (currlevel < 21) {
@@ -1422,13 +1456,18 @@ void CreateLevel(lvl_entry lvldir)
 		}
 		break;
 	case DTYPE_CATACOMBS:
-		CreateL2Dungeon(glSeedTbl[currlevel], lvldir);
+		DRLG_Init_Globals();
+		CreateL2Dungeon(ActiveDungeon, glSeedTbl[currlevel], lvldir);
+		ApplyDungeonQuestPositions(ActiveDungeon);
 		InitL2Triggers();
 		Freeupstairs();
 		LoadRndLvlPal(DTYPE_CATACOMBS);
 		break;
 	case DTYPE_CAVES:
-		CreateL3Dungeon(glSeedTbl[currlevel], lvldir);
+		DRLG_Init_Globals();
+		CreateL3Dungeon(ActiveDungeon, glSeedTbl[currlevel], lvldir);
+		ApplyDungeonQuestPositions(ActiveDungeon);
+		InitL3Lights();
 		InitL3Triggers();
 		Freeupstairs();
 		if (currlevel < 17) {
@@ -1438,7 +1477,9 @@ void CreateLevel(lvl_entry lvldir)
 		}
 		break;
 	case DTYPE_HELL:
-		CreateL4Dungeon(glSeedTbl[currlevel], lvldir);
+		DRLG_Init_Globals();
+		CreateL4Dungeon(ActiveDungeon, glSeedTbl[currlevel], lvldir);
+		ApplyDungeonQuestPositions(ActiveDungeon);
 		InitL4Triggers();
 		Freeupstairs();
 		LoadRndLvlPal(DTYPE_HELL);
@@ -1477,6 +1518,8 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	}
 	SetRndSeed(glSeedTbl[currlevel]);
 	IncProgress();
+	// Missile graphics keep loading in the background while the level is generated
+	PrefetchLevelAssets(currlevel, leveltype);
 	MakeLightTable();
 	LoadLvlGFX();
 	IncProgress();
@@ -1519,8 +1562,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 			InitThemes();
 			LoadAllGFX();
 		} else {
-			IncProgress();
-			IncProgress();
+			WaitForPrefetchedFiles(2);
 			InitMissileGFX();
 			IncProgress();
 			IncProgress();
@@ -1617,7 +1659,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		GetLevelMTypes();
 		IncProgress();
 		InitMonsters();
-		IncProgress();
+		WaitForPrefetchedFiles(1);
 		InitMissileGFX();
 		IncProgress();
 		InitDead();
@@ -1699,6 +1741,9 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	else
 		music_start(leveltype);
 
+	ClearPrefetchedFiles();
+	sgnPrefetchedLevel = -1;
+
 	while (!IncProgress())
 		;
 
@@ -1708,6 +1753,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 static void game_logic()
 {
+	ProfileScope profileScope(ProfileStage::GameLogic);
 	if (!ProcessInput()) {
 		return;
 	}
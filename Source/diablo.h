@@ -65,6 +65,14 @@ bool PressEscKey();
 void DisableInputWndProc(uint32_t uMsg, int32_t wParam, int32_t lParam);
 void GM_Game(uint32_t uMsg, int32_t wParam, int32_t lParam);
 void LoadGameLevel(bool firstflag, lvl_entry lvldir);
+/**
+ * @brief Load the tileset of the current level
+ */
+void LoadLvlGFX();
+/**
+ * @brief Start loading the tileset and missile graphics of a level before the player enters it
+ */
+void PrefetchLevelAssets(int level, dungeon_type levelType);
 void game_loop(bool bStartup);
 void diablo_color_cyc_logic();
 
@@ -14,37 +14,16 @@
 
 namespace devilution {
 
-int UberRow;
-int UberCol;
-bool IsUberRoomOpened;
-int UberLeverRow;
-int UberLeverCol;
-bool IsUberLeverActivated;
-int UberDiabloMonsterIndex;
+int &UberRow = ActiveDungeon.UberRow;
+int &UberCol = ActiveDungeon.UberCol;
+bool &IsUberRoomOpened = ActiveDungeon.IsUberRoomOpened;
+int &UberLeverRow = ActiveDungeon.UberLeverRow;
+int &UberLeverCol = ActiveDungeon.UberLeverCol;
+bool &IsUberLeverActivated = ActiveDungeon.IsUberLeverActivated;
+int &UberDiabloMonsterIndex = ActiveDungeon.UberDiabloMonsterIndex;
 
 namespace {
 
-/** Represents a tile ID map of twice the size, repeating each tile of the original map in blocks of 4. */
-BYTE L5dungeon[80][80];
-BYTE L5dflags[DMAXX][DMAXY];
-/** Specifies whether a single player quest DUN has been loaded. */
-bool L5setloadflag;
-/** Specifies whether to generate a horizontal room at position 1 in the Cathedral. */
-bool HR1;
-/** Specifies whether to generate a horizontal room at position 2 in the Cathedral. */
-bool HR2;
-/** Specifies whether to generate a horizontal room at position 3 in the Cathedral. */
-bool HR3;
-
-/** Specifies whether to generate a vertical room at position 1 in the Cathedral. */
-bool VR1;
-/** Specifies whether to generate a vertical room at position 2 in the Cathedral. */
-bool VR2;
-/** Specifies whether to generate a vertical room at position 3 in the Cathedral. */
-bool VR3;
-/** Contains the contents of the single player quest DUN file. */
-std::unique_ptr<uint16_t[]> L5pSetPiece;
-
 /** Contains shadows for 2x2 blocks of base tile IDs in the Cathedral. */
 const ShadowStruct SPATS[37] = {
 	// clang-format off
@@ -485,374 +464,374 @@ BYTE L5ConvTbl[16] = { 22, 13, 1, 13, 2, 13, 13, 13, 4, 13, 1, 13, 2, 13, 16, 13
 
 } // namespace
 
-void DRLG_InitL5Vals()
+void DRLG_InitL5Vals(DungeonContext &ctx)
 {
 	int i, j, pc;
 
 	for (j = 0; j < MAXDUNY; j++) {
 		for (i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] == 77) {
+			if (ctx.dPiece[i][j] == 77) {
 				pc = 1;
-			} else if (dPiece[i][j] == 80) {
+			} else if (ctx.dPiece[i][j] == 80) {
 				pc = 2;
 			} else {
 				continue;
 			}
-			dSpecial[i][j] = pc;
+			ctx.dSpecial[i][j] = pc;
 		}
 	}
 }
 
-static void DRLG_PlaceDoor(int x, int y)
+static void DRLG_PlaceDoor(DungeonContext &ctx, int x, int y)
 {
-	if ((L5dflags[x][y] & DLRG_PROTECTED) == 0) {
-		BYTE df = L5dflags[x][y] & 0x7F;
-		BYTE c = dungeon[x][y];
+	if ((ctx.L5dflags[x][y] & DLRG_PROTECTED) == 0) {
+		BYTE df = ctx.L5dflags[x][y] & 0x7F;
+		BYTE c = ctx.dungeon[x][y];
 
 		if (df == 1) {
 			if (y != 1 && c == 2)
-				dungeon[x][y] = 26;
+				ctx.dungeon[x][y] = 26;
 			if (y != 1 && c == 7)
-				dungeon[x][y] = 31;
+				ctx.dungeon[x][y] = 31;
 			if (y != 1 && c == 14)
-				dungeon[x][y] = 42;
+				ctx.dungeon[x][y] = 42;
 			if (y != 1 && c == 4)
-				dungeon[x][y] = 43;
+				ctx.dungeon[x][y] = 43;
 			if (x != 1 && c == 1)
-				dungeon[x][y] = 25;
+				ctx.dungeon[x][y] = 25;
 			if (x != 1 && c == 10)
-				dungeon[x][y] = 40;
+				ctx.dungeon[x][y] = 40;
 			if (x != 1 && c == 6)
-				dungeon[x][y] = 30;
+				ctx.dungeon[x][y] = 30;
 		}
 		if (df == 2) {
 			if (x != 1 && c == 1)
-				dungeon[x][y] = 25;
+				ctx.dungeon[x][y] = 25;
 			if (x != 1 && c == 6)
-				dungeon[x][y] = 30;
+				ctx.dungeon[x][y] = 30;
 			if (x != 1 && c == 10)
-				dungeon[x][y] = 40;
+				ctx.dungeon[x][y] = 40;
 			if (x != 1 && c == 4)
-				dungeon[x][y] = 41;
+				ctx.dungeon[x][y] = 41;
 			if (y != 1 && c == 2)
-				dungeon[x][y] = 26;
+				ctx.dungeon[x][y] = 26;
 			if (y != 1 && c == 14)
-				dungeon[x][y] = 42;
+				ctx.dungeon[x][y] = 42;
 			if (y != 1 && c == 7)
-				dungeon[x][y] = 31;
+				ctx.dungeon[x][y] = 31;
 		}
 		if (df == 3) {
 			if (x != 1 && y != 1 && c == 4)
-				dungeon[x][y] = 28;
+				ctx.dungeon[x][y] = 28;
 			if (x != 1 && c == 10)
-				dungeon[x][y] = 40;
+				ctx.dungeon[x][y] = 40;
 			if (y != 1 && c == 14)
-				dungeon[x][y] = 42;
+				ctx.dungeon[x][y] = 42;
 			if (y != 1 && c == 2)
-				dungeon[x][y] = 26;
+				ctx.dungeon[x][y] = 26;
 			if (x != 1 && c == 1)
-				dungeon[x][y] = 25;
+				ctx.dungeon[x][y] = 25;
 			if (y != 1 && c == 7)
-				dungeon[x][y] = 31;
+				ctx.dungeon[x][y] = 31;
 			if (x != 1 && c == 6)
-				dungeon[x][y] = 30;
+				ctx.dungeon[x][y] = 30;
 		}
 	}
 
-	L5dflags[x][y] = DLRG_PROTECTED;
+	ctx.L5dflags[x][y] = DLRG_PROTECTED;
 }
 
-void drlg_l1_crypt_lavafloor()
+void drlg_l1_crypt_lavafloor(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 1; j < 40; j++) {
 		for (i = 1; i < 40; i++) {
-			switch (dungeon[i][j]) {
+			switch (ctx.dungeon[i][j]) {
 			case 5:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 7:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 8:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 9:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 10:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 11:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 12:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 14:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 15:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 17:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 95:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 96:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 208;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 208;
 				break;
 			case 116:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 118:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 119:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 120:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 121:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 122:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 211;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 212;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 211;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 212;
 				break;
 			case 123:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 125:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 126:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 128:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 133:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 135:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 136:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 137:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 213;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 214;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 213;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 214;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 138:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 139:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 215;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 216;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 215;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 216;
 				break;
 			case 140:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 217;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 217;
 				break;
 			case 142:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 143:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 213;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 214;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 213;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 214;
 				break;
 			case 145:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 213;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 214;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 213;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 214;
 				break;
 			case 150:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 217;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 217;
 				break;
 			case 152:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 153:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 154:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 155:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 205;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 205;
 				break;
 			case 156:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 157:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 217;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 217;
 				break;
 			case 159:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 160:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 206;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 207;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 206;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 207;
 				break;
 			case 162:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 209;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 210;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 209;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 210;
 				break;
 			case 167:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 209;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 210;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 209;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 210;
 				break;
 			case 187:
-				if (dungeon[i][j - 1] == 13)
-					dungeon[i][j - 1] = 208;
+				if (ctx.dungeon[i][j - 1] == 13)
+					ctx.dungeon[i][j - 1] = 208;
 				break;
 			case 185:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 186:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 203;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 204;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 203;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 204;
 				break;
 			case 192:
-				if (dungeon[i - 1][j] == 13)
-					dungeon[i - 1][j] = 209;
-				if (dungeon[i - 1][j - 1] == 13)
-					dungeon[i - 1][j - 1] = 210;
+				if (ctx.dungeon[i - 1][j] == 13)
+					ctx.dungeon[i - 1][j] = 209;
+				if (ctx.dungeon[i - 1][j - 1] == 13)
+					ctx.dungeon[i - 1][j - 1] = 210;
 				break;
 			}
 		}
 	}
 }
 
-static void DRLG_L1Shadows()
+static void DRLG_L1Shadows(DungeonContext &ctx)
 {
 	int x, y, i;
 	BYTE sd[2][2];
@@ -861,10 +840,10 @@ static void DRLG_L1Shadows()
 
 	for (y = 1; y < DMAXY; y++) {
 		for (x = 1; x < DMAXX; x++) {
-			sd[0][0] = BSTYPES[dungeon[x][y]];
-			sd[1][0] = BSTYPES[dungeon[x - 1][y]];
-			sd[0][1] = BSTYPES[dungeon[x][y - 1]];
-			sd[1][1] = BSTYPES[dungeon[x - 1][y - 1]];
+			sd[0][0] = BSTYPES[ctx.dungeon[x][y]];
+			sd[1][0] = BSTYPES[ctx.dungeon[x - 1][y]];
+			sd[0][1] = BSTYPES[ctx.dungeon[x][y - 1]];
+			sd[1][1] = BSTYPES[ctx.dungeon[x - 1][y - 1]];
 
 			for (i = 0; i < 37; i++) {
 				if (SPATS[i].strig == sd[0][0]) {
@@ -876,12 +855,12 @@ static void DRLG_L1Shadows()
 					if (SPATS[i].s3 != 0 && SPATS[i].s3 != sd[1][0])
 						patflag = false;
 					if (patflag) {
-						if (SPATS[i].nv1 != 0 && L5dflags[x - 1][y - 1] == 0)
-							dungeon[x - 1][y - 1] = SPATS[i].nv1;
-						if (SPATS[i].nv2 != 0 && L5dflags[x][y - 1] == 0)
-							dungeon[x][y - 1] = SPATS[i].nv2;
-						if (SPATS[i].nv3 != 0 && L5dflags[x - 1][y] == 0)
-							dungeon[x - 1][y] = SPATS[i].nv3;
+						if (SPATS[i].nv1 != 0 && ctx.L5dflags[x - 1][y - 1] == 0)
+							ctx.dungeon[x - 1][y - 1] = SPATS[i].nv1;
+						if (SPATS[i].nv2 != 0 && ctx.L5dflags[x][y - 1] == 0)
+							ctx.dungeon[x][y - 1] = SPATS[i].nv2;
+						if (SPATS[i].nv3 != 0 && ctx.L5dflags[x - 1][y] == 0)
+							ctx.dungeon[x - 1][y] = SPATS[i].nv3;
 					}
 				}
 			}
@@ -890,59 +869,59 @@ static void DRLG_L1Shadows()
 
 	for (y = 1; y < DMAXY; y++) {
 		for (x = 1; x < DMAXX; x++) {
-			if (dungeon[x - 1][y] == 139 && L5dflags[x - 1][y] == 0) {
+			if (ctx.dungeon[x - 1][y] == 139 && ctx.L5dflags[x - 1][y] == 0) {
 				tnv3 = 139;
-				if (dungeon[x][y] == 29)
+				if (ctx.dungeon[x][y] == 29)
 					tnv3 = 141;
-				if (dungeon[x][y] == 32)
+				if (ctx.dungeon[x][y] == 32)
 					tnv3 = 141;
-				if (dungeon[x][y] == 35)
+				if (ctx.dungeon[x][y] == 35)
 					tnv3 = 141;
-				if (dungeon[x][y] == 37)
+				if (ctx.dungeon[x][y] == 37)
 					tnv3 = 141;
-				if (dungeon[x][y] == 38)
+				if (ctx.dungeon[x][y] == 38)
 					tnv3 = 141;
-				if (dungeon[x][y] == 39)
+				if (ctx.dungeon[x][y] == 39)
 					tnv3 = 141;
-				dungeon[x - 1][y] = tnv3;
+				ctx.dungeon[x - 1][y] = tnv3;
 			}
-			if (dungeon[x - 1][y] == 149 && L5dflags[x - 1][y] == 0) {
+			if (ctx.dungeon[x - 1][y] == 149 && ctx.L5dflags[x - 1][y] == 0) {
 				tnv3 = 149;
-				if (dungeon[x][y] == 29)
+				if (ctx.dungeon[x][y] == 29)
 					tnv3 = 153;
-				if (dungeon[x][y] == 32)
+				if (ctx.dungeon[x][y] == 32)
 					tnv3 = 153;
-				if (dungeon[x][y] == 35)
+				if (ctx.dungeon[x][y] == 35)
 					tnv3 = 153;
-				if (dungeon[x][y] == 37)
+				if (ctx.dungeon[x][y] == 37)
 					tnv3 = 153;
-				if (dungeon[x][y] == 38)
+				if (ctx.dungeon[x][y] == 38)
 					tnv3 = 153;
-				if (dungeon[x][y] == 39)
+				if (ctx.dungeon[x][y] == 39)
 					tnv3 = 153;
-				dungeon[x - 1][y] = tnv3;
+				ctx.dungeon[x - 1][y] = tnv3;
 			}
-			if (dungeon[x - 1][y] == 148 && L5dflags[x - 1][y] == 0) {
+			if (ctx.dungeon[x - 1][y] == 148 && ctx.L5dflags[x - 1][y] == 0) {
 				tnv3 = 148;
-				if (dungeon[x][y] == 29)
+				if (ctx.dungeon[x][y] == 29)
 					tnv3 = 154;
-				if (dungeon[x][y] == 32)
+				if (ctx.dungeon[x][y] == 32)
 					tnv3 = 154;
-				if (dungeon[x][y] == 35)
+				if (ctx.dungeon[x][y] == 35)
 					tnv3 = 154;
-				if (dungeon[x][y] == 37)
+				if (ctx.dungeon[x][y] == 37)
 					tnv3 = 154;
-				if (dungeon[x][y] == 38)
+				if (ctx.dungeon[x][y] == 38)
 					tnv3 = 154;
-				if (dungeon[x][y] == 39)
+				if (ctx.dungeon[x][y] == 39)
 					tnv3 = 154;
-				dungeon[x - 1][y] = tnv3;
+				ctx.dungeon[x - 1][y] = tnv3;
 			}
 		}
 	}
 }
 
-static int DRLG_PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int noquad, int ldir)
+static int DRLG_PlaceMiniSet(DungeonContext &ctx, const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int noquad, int ldir)
 {
 	int sx, sy, sw, sh, xx, yy, i, ii, numt, found, t;
 	bool abort;
@@ -995,9 +974,9 @@ static int DRLG_PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, in
 
 			for (yy = 0; yy < sh && abort; yy++) {
 				for (xx = 0; xx < sw && abort; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][sy + yy] != miniset[ii])
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][sy + yy] != miniset[ii])
 						abort = false;
-					if (L5dflags[xx + sx][sy + yy] != 0)
+					if (ctx.L5dflags[xx + sx][sy + yy] != 0)
 						abort = false;
 					ii++;
 				}
@@ -1019,29 +998,29 @@ static int DRLG_PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, in
 		for (yy = 0; yy < sh; yy++) {
 			for (xx = 0; xx < sw; xx++) {
 				if (miniset[ii] != 0)
-					dungeon[xx + sx][sy + yy] = miniset[ii];
+					ctx.dungeon[xx + sx][sy + yy] = miniset[ii];
 				ii++;
 			}
 		}
 	}
 
 	if (miniset == PWATERIN) {
-		t = TransVal;
-		TransVal = 0;
-		DRLG_MRectTrans(sx, sy + 2, sx + 5, sy + 4);
-		TransVal = t;
+		t = ctx.TransVal;
+		ctx.TransVal = 0;
+		DRLG_MRectTrans(ctx, sx, sy + 2, sx + 5, sy + 4);
+		ctx.TransVal = t;
 
-		quests[Q_PWATER].position = { 2 * sx + 21, 2 * sy + 22 };
+		ctx.pwaterPosition = Point { 2 * sx + 21, 2 * sy + 22 };
 	}
 
 	if (setview) {
-		ViewX = 2 * sx + 19;
-		ViewY = 2 * sy + 20;
+		ctx.ViewX = 2 * sx + 19;
+		ctx.ViewY = 2 * sy + 20;
 	}
 
 	if (ldir == 0) {
-		LvlViewX = 2 * sx + 19;
-		LvlViewY = 2 * sy + 20;
+		ctx.LvlViewX = 2 * sx + 19;
+		ctx.LvlViewY = 2 * sy + 20;
 	}
 
 	if (sx < cx && sy < cy)
@@ -1054,23 +1033,23 @@ static int DRLG_PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, in
 	return 3;
 }
 
-static void DRLG_L1Floor()
+static void DRLG_L1Floor(DungeonContext &ctx)
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (L5dflags[i][j] == 0 && dungeon[i][j] == 13) {
+			if (ctx.L5dflags[i][j] == 0 && ctx.dungeon[i][j] == 13) {
 				int rv = GenerateRnd(3);
 
 				if (rv == 1)
-					dungeon[i][j] = 162;
+					ctx.dungeon[i][j] = 162;
 				if (rv == 2)
-					dungeon[i][j] = 163;
+					ctx.dungeon[i][j] = 163;
 			}
 		}
 	}
 }
 
-void DRLG_LPass3(int lv)
+void DRLG_LPass3(DungeonContext &ctx, int lv)
 {
 	MegaTile mega = pMegaTiles[lv];
 	int v1 = SDL_SwapLE16(mega.micro1) + 1;
@@ -1080,10 +1059,10 @@ void DRLG_LPass3(int lv)
 
 	for (int j = 0; j < MAXDUNY; j += 2) {
 		for (int i = 0; i < MAXDUNX; i += 2) {
-			dPiece[i + 0][j + 0] = v1;
-			dPiece[i + 1][j + 0] = v2;
-			dPiece[i + 0][j + 1] = v3;
-			dPiece[i + 1][j + 1] = v4;
+			ctx.dPiece[i + 0][j + 0] = v1;
+			ctx.dPiece[i + 1][j + 0] = v2;
+			ctx.dPiece[i + 0][j + 1] = v3;
+			ctx.dPiece[i + 1][j + 1] = v4;
 		}
 	}
 
@@ -1096,7 +1075,7 @@ void DRLG_LPass3(int lv)
 			v3 = 0;
 			v4 = 0;
 
-			int tileId = dungeon[i][j] - 1;
+			int tileId = ctx.dungeon[i][j] - 1;
 			if (tileId >= 0) {
 				MegaTile mega = pMegaTiles[tileId];
 				v1 = SDL_SwapLE16(mega.micro1) + 1;
@@ -1104,41 +1083,41 @@ void DRLG_LPass3(int lv)
 				v3 = SDL_SwapLE16(mega.micro3) + 1;
 				v4 = SDL_SwapLE16(mega.micro4) + 1;
 			}
-			dPiece[xx + 0][yy + 0] = v1;
-			dPiece[xx + 1][yy + 0] = v2;
-			dPiece[xx + 0][yy + 1] = v3;
-			dPiece[xx + 1][yy + 1] = v4;
+			ctx.dPiece[xx + 0][yy + 0] = v1;
+			ctx.dPiece[xx + 1][yy + 0] = v2;
+			ctx.dPiece[xx + 0][yy + 1] = v3;
+			ctx.dPiece[xx + 1][yy + 1] = v4;
 			xx += 2;
 		}
 		yy += 2;
 	}
 }
 
-static void DRLG_L1Pass3()
+static void DRLG_L1Pass3(DungeonContext &ctx)
 {
-	DRLG_LPass3(22 - 1);
+	DRLG_LPass3(ctx, 22 - 1);
 }
 
-static void DRLG_LoadL1SP()
+static void DRLG_LoadL1SP(DungeonContext &ctx)
 {
-	L5setloadflag = false;
-	if (QuestStatus(Q_BUTCHER)) {
-		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\rnd6.DUN");
-		L5setloadflag = true;
+	ctx.L5setloadflag = false;
+	if (QuestStatus(Q_BUTCHER, ctx.currlevel)) {
+		ctx.L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\rnd6.DUN");
+		ctx.L5setloadflag = true;
 	}
-	if (QuestStatus(Q_SKELKING) && !gbIsMultiplayer) {
-		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\SKngDO.DUN");
-		L5setloadflag = true;
+	if (QuestStatus(Q_SKELKING, ctx.currlevel) && !gbIsMultiplayer) {
+		ctx.L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\SKngDO.DUN");
+		ctx.L5setloadflag = true;
 	}
-	if (QuestStatus(Q_LTBANNER)) {
-		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\Banner2.DUN");
-		L5setloadflag = true;
+	if (QuestStatus(Q_LTBANNER, ctx.currlevel)) {
+		ctx.L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\Banner2.DUN");
+		ctx.L5setloadflag = true;
 	}
 }
 
-static void DRLG_FreeL1SP()
+static void DRLG_FreeL1SP(DungeonContext &ctx)
 {
-	L5pSetPiece = nullptr;
+	ctx.L5pSetPiece = nullptr;
 }
 
 void DRLG_Init_Globals()
@@ -1155,65 +1134,65 @@ void DRLG_Init_Globals()
 	memset(dLight, c, sizeof(dLight));
 }
 
-static void DRLG_InitL1Vals()
+static void DRLG_InitL1Vals(DungeonContext &ctx)
 {
 	int i, j, pc;
 
 	for (j = 0; j < MAXDUNY; j++) {
 		for (i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] == 12) {
+			if (ctx.dPiece[i][j] == 12) {
 				pc = 1;
-			} else if (dPiece[i][j] == 11) {
+			} else if (ctx.dPiece[i][j] == 11) {
 				pc = 2;
-			} else if (dPiece[i][j] == 71) {
+			} else if (ctx.dPiece[i][j] == 71) {
 				pc = 1;
-			} else if (dPiece[i][j] == 253) {
+			} else if (ctx.dPiece[i][j] == 253) {
 				pc = 3;
-			} else if (dPiece[i][j] == 267) {
+			} else if (ctx.dPiece[i][j] == 267) {
 				pc = 6;
-			} else if (dPiece[i][j] == 259) {
+			} else if (ctx.dPiece[i][j] == 259) {
 				pc = 5;
-			} else if (dPiece[i][j] == 249) {
+			} else if (ctx.dPiece[i][j] == 249) {
 				pc = 2;
-			} else if (dPiece[i][j] == 325) {
+			} else if (ctx.dPiece[i][j] == 325) {
 				pc = 2;
-			} else if (dPiece[i][j] == 321) {
+			} else if (ctx.dPiece[i][j] == 321) {
 				pc = 1;
-			} else if (dPiece[i][j] == 255) {
+			} else if (ctx.dPiece[i][j] == 255) {
 				pc = 4;
-			} else if (dPiece[i][j] == 211) {
+			} else if (ctx.dPiece[i][j] == 211) {
 				pc = 1;
-			} else if (dPiece[i][j] == 344) {
+			} else if (ctx.dPiece[i][j] == 344) {
 				pc = 2;
-			} else if (dPiece[i][j] == 341) {
+			} else if (ctx.dPiece[i][j] == 341) {
 				pc = 1;
-			} else if (dPiece[i][j] == 331) {
+			} else if (ctx.dPiece[i][j] == 331) {
 				pc = 2;
-			} else if (dPiece[i][j] == 418) {
+			} else if (ctx.dPiece[i][j] == 418) {
 				pc = 1;
-			} else if (dPiece[i][j] == 421) {
+			} else if (ctx.dPiece[i][j] == 421) {
 				pc = 2;
 			} else {
 				continue;
 			}
-			dSpecial[i][j] = pc;
+			ctx.dSpecial[i][j] = pc;
 		}
 	}
 }
 
-void LoadL1Dungeon(const char *path, int vx, int vy)
+void LoadL1Dungeon(DungeonContext &ctx, const char *path, int vx, int vy)
 {
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
-	DRLG_InitTrans();
+	DRLG_InitTrans(ctx);
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 22;
-			L5dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 22;
+			ctx.L5dflags[i][j] = 0;
 		}
 	}
 
@@ -1229,42 +1208,42 @@ void LoadL1Dungeon(const char *path, int vx, int vy)
 			uint8_t tileId = SDL_SwapLE16(*tileLayer);
 			tileLayer++;
 			if (tileId != 0) {
-				dungeon[i][j] = tileId;
-				L5dflags[i][j] |= DLRG_PROTECTED;
+				ctx.dungeon[i][j] = tileId;
+				ctx.L5dflags[i][j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[i][j] = 13;
+				ctx.dungeon[i][j] = 13;
 			}
 		}
 	}
 
-	DRLG_L1Floor();
+	DRLG_L1Floor(ctx);
 
-	ViewX = vx;
-	ViewY = vy;
+	ctx.ViewX = vx;
+	ctx.ViewY = vy;
 
-	DRLG_L1Pass3();
+	DRLG_L1Pass3(ctx);
 	DRLG_Init_Globals();
 
-	if (currlevel < 17)
-		DRLG_InitL1Vals();
+	if (ctx.currlevel < 17)
+		DRLG_InitL1Vals(ctx);
 
 	SetMapMonsters(dunData.get(), { 0, 0 });
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL1Dungeon(const char *path)
+void LoadPreL1Dungeon(DungeonContext &ctx, const char *path)
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 22;
-			L5dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 22;
+			ctx.L5dflags[i][j] = 0;
 		}
 	}
 
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
@@ -1278,56 +1257,56 @@ void LoadPreL1Dungeon(const char *path)
 			uint8_t tileId = SDL_SwapLE16(*tileLayer);
 			tileLayer++;
 			if (tileId != 0) {
-				dungeon[i][j] = tileId;
-				L5dflags[i][j] |= DLRG_PROTECTED;
+				ctx.dungeon[i][j] = tileId;
+				ctx.L5dflags[i][j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[i][j] = 13;
+				ctx.dungeon[i][j] = 13;
 			}
 		}
 	}
 
-	DRLG_L1Floor();
+	DRLG_L1Floor(ctx);
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			pdungeon[i][j] = dungeon[i][j];
+			ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 		}
 	}
 }
 
-static void InitL5Dungeon()
+static void InitL5Dungeon(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 0;
-			L5dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 0;
+			ctx.L5dflags[i][j] = 0;
 		}
 	}
 }
 
-static void L5ClearFlags()
+static void L5ClearFlags(DungeonContext &ctx)
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			L5dflags[i][j] &= ~DLRG_CHAMBER;
+			ctx.L5dflags[i][j] &= ~DLRG_CHAMBER;
 		}
 	}
 }
 
-static void L5drawRoom(int x, int y, int w, int h)
+static void L5drawRoom(DungeonContext &ctx, int x, int y, int w, int h)
 {
 	int i, j;
 
 	for (j = 0; j < h; j++) {
 		for (i = 0; i < w; i++) {
-			dungeon[x + i][y + j] = 1;
+			ctx.dungeon[x + i][y + j] = 1;
 		}
 	}
 }
 
-static bool L5checkRoom(int x, int y, int width, int height)
+static bool L5checkRoom(DungeonContext &ctx, int x, int y, int width, int height)
 {
 	int i, j;
 
@@ -1335,7 +1314,7 @@ static bool L5checkRoom(int x, int y, int width, int height)
 		for (i = 0; i < width; i++) {
 			if (i + x < 0 || i + x >= DMAXX || j + y < 0 || j + y >= DMAXY)
 				return false;
-			if (dungeon[i + x][j + y] != 0)
+			if (ctx.dungeon[i + x][j + y] != 0)
 				return false;
 		}
 	}
@@ -1343,7 +1322,7 @@ static bool L5checkRoom(int x, int y, int width, int height)
 	return true;
 }
 
-static void L5roomGen(int x, int y, int w, int h, int dir)
+static void L5roomGen(DungeonContext &ctx, int x, int y, int w, int h, int dir)
 {
 	bool ran, ran2;
 	int width, height, rx, ry, ry2;
@@ -1358,20 +1337,20 @@ static void L5roomGen(int x, int y, int w, int h, int dir)
 			ch = (GenerateRnd(5) + 2) & ~1;
 			cy1 = h / 2 + y - ch / 2;
 			cx1 = x - cw;
-			ran = L5checkRoom(cx1 - 1, cy1 - 1, ch + 2, cw + 1); /// BUGFIX: swap args 3 and 4 ("ch+2" and "cw+1")
+			ran = L5checkRoom(ctx, cx1 - 1, cy1 - 1, ch + 2, cw + 1); /// BUGFIX: swap args 3 and 4 ("ch+2" and "cw+1")
 			num++;
 		} while (!ran && num < 20);
 
 		if (ran)
-			L5drawRoom(cx1, cy1, cw, ch);
+			L5drawRoom(ctx, cx1, cy1, cw, ch);
 		cx2 = x + w;
-		ran2 = L5checkRoom(cx2, cy1 - 1, cw + 1, ch + 2);
+		ran2 = L5checkRoom(ctx, cx2, cy1 - 1, cw + 1, ch + 2);
 		if (ran2)
-			L5drawRoom(cx2, cy1, cw, ch);
+			L5drawRoom(ctx, cx2, cy1, cw, ch);
 		if (ran)
-			L5roomGen(cx1, cy1, cw, ch, 1);
+			L5roomGen(ctx, cx1, cy1, cw, ch, 1);
 		if (ran2)
-			L5roomGen(cx2, cy1, cw, ch, 1);
+			L5roomGen(ctx, cx2, cy1, cw, ch, 1);
 		return;
 	}
 
@@ -1380,23 +1359,23 @@ static void L5roomGen(int x, int y, int w, int h, int dir)
 		height = (GenerateRnd(5) + 2) & ~1;
 		rx = w / 2 + x - width / 2;
 		ry = y - height;
-		ran = L5checkRoom(rx - 1, ry - 1, width + 2, height + 1);
+		ran = L5checkRoom(ctx, rx - 1, ry - 1, width + 2, height + 1);
 		num++;
 	} while (!ran && num < 20);
 
 	if (ran)
-		L5drawRoom(rx, ry, width, height);
+		L5drawRoom(ctx, rx, ry, width, height);
 	ry2 = y + h;
-	ran2 = L5checkRoom(rx - 1, ry2, width + 2, height + 1);
+	ran2 = L5checkRoom(ctx, rx - 1, ry2, width + 2, height + 1);
 	if (ran2)
-		L5drawRoom(rx, ry2, width, height);
+		L5drawRoom(ctx, rx, ry2, width, height);
 	if (ran)
-		L5roomGen(rx, ry, width, height, 0);
+		L5roomGen(ctx, rx, ry, width, height, 0);
 	if (ran2)
-		L5roomGen(rx, ry2, width, height, 0);
+		L5roomGen(ctx, rx, ry2, width, height, 0);
 }
 
-static void L5firstRoom()
+static void L5firstRoom(DungeonContext &ctx)
 {
 	int ys, ye, y;
 	int xs, xe, x;
@@ -1405,88 +1384,88 @@ static void L5firstRoom()
 		ys = 1;
 		ye = DMAXY - 1;
 
-		VR1 = (GenerateRnd(2) != 0);
-		VR2 = (GenerateRnd(2) != 0);
-		VR3 = (GenerateRnd(2) != 0);
+		ctx.VR1 = (GenerateRnd(2) != 0);
+		ctx.VR2 = (GenerateRnd(2) != 0);
+		ctx.VR3 = (GenerateRnd(2) != 0);
 
-		if (!VR1 || !VR3)
-			VR2 = true;
-		if (VR1)
-			L5drawRoom(15, 1, 10, 10);
+		if (!ctx.VR1 || !ctx.VR3)
+			ctx.VR2 = true;
+		if (ctx.VR1)
+			L5drawRoom(ctx, 15, 1, 10, 10);
 		else
 			ys = 18;
 
-		if (VR2)
-			L5drawRoom(15, 15, 10, 10);
-		if (VR3)
-			L5drawRoom(15, 29, 10, 10);
+		if (ctx.VR2)
+			L5drawRoom(ctx, 15, 15, 10, 10);
+		if (ctx.VR3)
+			L5drawRoom(ctx, 15, 29, 10, 10);
 		else
 			ye = 22;
 
 		for (y = ys; y < ye; y++) {
-			dungeon[17][y] = 1;
-			dungeon[18][y] = 1;
-			dungeon[19][y] = 1;
-			dungeon[20][y] = 1;
-			dungeon[21][y] = 1;
-			dungeon[22][y] = 1;
+			ctx.dungeon[17][y] = 1;
+			ctx.dungeon[18][y] = 1;
+			ctx.dungeon[19][y] = 1;
+			ctx.dungeon[20][y] = 1;
+			ctx.dungeon[21][y] = 1;
+			ctx.dungeon[22][y] = 1;
 		}
 
-		if (VR1)
-			L5roomGen(15, 1, 10, 10, 0);
-		if (VR2)
-			L5roomGen(15, 15, 10, 10, 0);
-		if (VR3)
-			L5roomGen(15, 29, 10, 10, 0);
+		if (ctx.VR1)
+			L5roomGen(ctx, 15, 1, 10, 10, 0);
+		if (ctx.VR2)
+			L5roomGen(ctx, 15, 15, 10, 10, 0);
+		if (ctx.VR3)
+			L5roomGen(ctx, 15, 29, 10, 10, 0);
 
-		HR3 = false;
-		HR2 = false;
-		HR1 = false;
+		ctx.HR3 = false;
+		ctx.HR2 = false;
+		ctx.HR1 = false;
 	} else {
 		xs = 1;
 		xe = DMAXX - 1;
 
-		HR1 = GenerateRnd(2) != 0;
-		HR2 = GenerateRnd(2) != 0;
-		HR3 = GenerateRnd(2) != 0;
+		ctx.HR1 = GenerateRnd(2) != 0;
+		ctx.HR2 = GenerateRnd(2) != 0;
+		ctx.HR3 = GenerateRnd(2) != 0;
 
-		if (!HR1 || !HR3)
-			HR2 = true;
-		if (HR1)
-			L5drawRoom(1, 15, 10, 10);
+		if (!ctx.HR1 || !ctx.HR3)
+			ctx.HR2 = true;
+		if (ctx.HR1)
+			L5drawRoom(ctx, 1, 15, 10, 10);
 		else
 			xs = 18;
 
-		if (HR2)
-			L5drawRoom(15, 15, 10, 10);
-		if (HR3)
-			L5drawRoom(29, 15, 10, 10);
+		if (ctx.HR2)
+			L5drawRoom(ctx, 15, 15, 10, 10);
+		if (ctx.HR3)
+			L5drawRoom(ctx, 29, 15, 10, 10);
 		else
 			xe = 22;
 
 		for (x = xs; x < xe; x++) {
-			dungeon[x][17] = 1;
-			dungeon[x][18] = 1;
-			dungeon[x][19] = 1;
-			dungeon[x][20] = 1;
-			dungeon[x][21] = 1;
-			dungeon[x][22] = 1;
+			ctx.dungeon[x][17] = 1;
+			ctx.dungeon[x][18] = 1;
+			ctx.dungeon[x][19] = 1;
+			ctx.dungeon[x][20] = 1;
+			ctx.dungeon[x][21] = 1;
+			ctx.dungeon[x][22] = 1;
 		}
 
-		if (HR1)
-			L5roomGen(1, 15, 10, 10, 1);
-		if (HR2)
-			L5roomGen(15, 15, 10, 10, 1);
-		if (HR3)
-			L5roomGen(29, 15, 10, 10, 1);
+		if (ctx.HR1)
+			L5roomGen(ctx, 1, 15, 10, 10, 1);
+		if (ctx.HR2)
+			L5roomGen(ctx, 15, 15, 10, 10, 1);
+		if (ctx.HR3)
+			L5roomGen(ctx, 29, 15, 10, 10, 1);
 
-		VR3 = false;
-		VR2 = false;
-		VR1 = false;
+		ctx.VR3 = false;
+		ctx.VR2 = false;
+		ctx.VR1 = false;
 	}
 }
 
-static int L5GetArea()
+static int L5GetArea(DungeonContext &ctx)
 {
 	int i, j;
 	int rv;
@@ -1495,7 +1474,7 @@ static int L5GetArea()
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 1)
+			if (ctx.dungeon[i][j] == 1)
 				rv++;
 		}
 	}
@@ -1503,7 +1482,7 @@ static int L5GetArea()
 	return rv;
 }
 
-static void L5makeDungeon()
+static void L5makeDungeon(DungeonContext &ctx)
 {
 	int i, j;
 	int i_2, j_2;
@@ -1512,52 +1491,52 @@ static void L5makeDungeon()
 		for (i = 0; i < DMAXX; i++) {
 			j_2 = j * 2;
 			i_2 = i * 2;
-			L5dungeon[i_2][j_2] = dungeon[i][j];
-			L5dungeon[i_2][j_2 + 1] = dungeon[i][j];
-			L5dungeon[i_2 + 1][j_2] = dungeon[i][j];
-			L5dungeon[i_2 + 1][j_2 + 1] = dungeon[i][j];
+			ctx.L5dungeon[i_2][j_2] = ctx.dungeon[i][j];
+			ctx.L5dungeon[i_2][j_2 + 1] = ctx.dungeon[i][j];
+			ctx.L5dungeon[i_2 + 1][j_2] = ctx.dungeon[i][j];
+			ctx.L5dungeon[i_2 + 1][j_2 + 1] = ctx.dungeon[i][j];
 		}
 	}
 }
 
-static void L5makeDmt()
+static void L5makeDmt(DungeonContext &ctx)
 {
 	int i, j, idx, val, dmtx, dmty;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 22;
+			ctx.dungeon[i][j] = 22;
 		}
 	}
 
 	for (j = 0, dmty = 1; dmty <= 77; j++, dmty += 2) {
 		for (i = 0, dmtx = 1; dmtx <= 77; i++, dmtx += 2) {
-			val = 8 * L5dungeon[dmtx + 1][dmty + 1]
-			    + 4 * L5dungeon[dmtx][dmty + 1]
-			    + 2 * L5dungeon[dmtx + 1][dmty]
-			    + L5dungeon[dmtx][dmty];
+			val = 8 * ctx.L5dungeon[dmtx + 1][dmty + 1]
+			    + 4 * ctx.L5dungeon[dmtx][dmty + 1]
+			    + 2 * ctx.L5dungeon[dmtx + 1][dmty]
+			    + ctx.L5dungeon[dmtx][dmty];
 			idx = L5ConvTbl[val];
-			dungeon[i][j] = idx;
+			ctx.dungeon[i][j] = idx;
 		}
 	}
 }
 
-static int L5HWallOk(int i, int j)
+static int L5HWallOk(DungeonContext &ctx, int i, int j)
 {
 	int x;
 	bool wallok;
 
-	for (x = 1; dungeon[i + x][j] == 13; x++) {
-		if (dungeon[i + x][j - 1] != 13 || dungeon[i + x][j + 1] != 13 || L5dflags[i + x][j] != 0)
+	for (x = 1; ctx.dungeon[i + x][j] == 13; x++) {
+		if (ctx.dungeon[i + x][j - 1] != 13 || ctx.dungeon[i + x][j + 1] != 13 || ctx.L5dflags[i + x][j] != 0)
 			break;
 	}
 
 	wallok = false;
-	if (dungeon[i + x][j] >= 3 && dungeon[i + x][j] <= 7)
+	if (ctx.dungeon[i + x][j] >= 3 && ctx.dungeon[i + x][j] <= 7)
 		wallok = true;
-	if (dungeon[i + x][j] >= 16 && dungeon[i + x][j] <= 24)
+	if (ctx.dungeon[i + x][j] >= 16 && ctx.dungeon[i + x][j] <= 24)
 		wallok = true;
-	if (dungeon[i + x][j] == 22)
+	if (ctx.dungeon[i + x][j] == 22)
 		wallok = false;
 	if (x == 1)
 		wallok = false;
@@ -1568,22 +1547,22 @@ static int L5HWallOk(int i, int j)
 	return -1;
 }
 
-static int L5VWallOk(int i, int j)
+static int L5VWallOk(DungeonContext &ctx, int i, int j)
 {
 	int y;
 	bool wallok;
 
-	for (y = 1; dungeon[i][j + y] == 13; y++) {
-		if (dungeon[i - 1][j + y] != 13 || dungeon[i + 1][j + y] != 13 || L5dflags[i][j + y] != 0)
+	for (y = 1; ctx.dungeon[i][j + y] == 13; y++) {
+		if (ctx.dungeon[i - 1][j + y] != 13 || ctx.dungeon[i + 1][j + y] != 13 || ctx.L5dflags[i][j + y] != 0)
 			break;
 	}
 
 	wallok = false;
-	if (dungeon[i][j + y] >= 3 && dungeon[i][j + y] <= 7)
+	if (ctx.dungeon[i][j + y] >= 3 && ctx.dungeon[i][j + y] <= 7)
 		wallok = true;
-	if (dungeon[i][j + y] >= 16 && dungeon[i][j + y] <= 24)
+	if (ctx.dungeon[i][j + y] >= 16 && ctx.dungeon[i][j + y] <= 24)
 		wallok = true;
-	if (dungeon[i][j + y] == 22)
+	if (ctx.dungeon[i][j + y] == 22)
 		wallok = false;
 	if (y == 1)
 		wallok = false;
@@ -1594,7 +1573,7 @@ static int L5VWallOk(int i, int j)
 	return -1;
 }
 
-static void L5HorizWall(int i, int j, char p, int dx)
+static void L5HorizWall(DungeonContext &ctx, int i, int j, char p, int dx)
 {
 	int xx;
 	char wt, dt;
@@ -1627,23 +1606,23 @@ static void L5HorizWall(int i, int j, char p, int dx)
 	if (dt == 12)
 		wt = 12;
 
-	dungeon[i][j] = p;
+	ctx.dungeon[i][j] = p;
 
 	for (xx = 1; xx < dx; xx++) {
-		dungeon[i + xx][j] = dt;
+		ctx.dungeon[i + xx][j] = dt;
 	}
 
 	xx = GenerateRnd(dx - 1) + 1;
 
 	if (wt == 12) {
-		dungeon[i + xx][j] = wt;
+		ctx.dungeon[i + xx][j] = wt;
 	} else {
-		dungeon[i + xx][j] = 2;
-		L5dflags[i + xx][j] |= DLRG_HDOOR;
+		ctx.dungeon[i + xx][j] = 2;
+		ctx.L5dflags[i + xx][j] |= DLRG_HDOOR;
 	}
 }
 
-static void L5VertWall(int i, int j, char p, int dy)
+static void L5VertWall(DungeonContext &ctx, int i, int j, char p, int dy)
 {
 	int yy;
 	char wt, dt;
@@ -1676,139 +1655,139 @@ static void L5VertWall(int i, int j, char p, int dy)
 	if (dt == 11)
 		wt = 11;
 
-	dungeon[i][j] = p;
+	ctx.dungeon[i][j] = p;
 
 	for (yy = 1; yy < dy; yy++) {
-		dungeon[i][j + yy] = dt;
+		ctx.dungeon[i][j + yy] = dt;
 	}
 
 	yy = GenerateRnd(dy - 1) + 1;
 
 	if (wt == 11) {
-		dungeon[i][j + yy] = wt;
+		ctx.dungeon[i][j + yy] = wt;
 	} else {
-		dungeon[i][j + yy] = 1;
-		L5dflags[i][j + yy] |= DLRG_VDOOR;
+		ctx.dungeon[i][j + yy] = 1;
+		ctx.L5dflags[i][j + yy] |= DLRG_VDOOR;
 	}
 }
 
-static void L5AddWall()
+static void L5AddWall(DungeonContext &ctx)
 {
 	int i, j, x, y;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (L5dflags[i][j] == 0) {
-				if (dungeon[i][j] == 3 && GenerateRnd(100) < WALL_CHANCE) {
-					x = L5HWallOk(i, j);
+			if (ctx.L5dflags[i][j] == 0) {
+				if (ctx.dungeon[i][j] == 3 && GenerateRnd(100) < WALL_CHANCE) {
+					x = L5HWallOk(ctx, i, j);
 					if (x != -1)
-						L5HorizWall(i, j, 2, x);
+						L5HorizWall(ctx, i, j, 2, x);
 				}
-				if (dungeon[i][j] == 3 && GenerateRnd(100) < WALL_CHANCE) {
-					y = L5VWallOk(i, j);
+				if (ctx.dungeon[i][j] == 3 && GenerateRnd(100) < WALL_CHANCE) {
+					y = L5VWallOk(ctx, i, j);
 					if (y != -1)
-						L5VertWall(i, j, 1, y);
+						L5VertWall(ctx, i, j, 1, y);
 				}
-				if (dungeon[i][j] == 6 && GenerateRnd(100) < WALL_CHANCE) {
-					x = L5HWallOk(i, j);
+				if (ctx.dungeon[i][j] == 6 && GenerateRnd(100) < WALL_CHANCE) {
+					x = L5HWallOk(ctx, i, j);
 					if (x != -1)
-						L5HorizWall(i, j, 4, x);
+						L5HorizWall(ctx, i, j, 4, x);
 				}
-				if (dungeon[i][j] == 7 && GenerateRnd(100) < WALL_CHANCE) {
-					y = L5VWallOk(i, j);
+				if (ctx.dungeon[i][j] == 7 && GenerateRnd(100) < WALL_CHANCE) {
+					y = L5VWallOk(ctx, i, j);
 					if (y != -1)
-						L5VertWall(i, j, 4, y);
+						L5VertWall(ctx, i, j, 4, y);
 				}
-				if (dungeon[i][j] == 2 && GenerateRnd(100) < WALL_CHANCE) {
-					x = L5HWallOk(i, j);
+				if (ctx.dungeon[i][j] == 2 && GenerateRnd(100) < WALL_CHANCE) {
+					x = L5HWallOk(ctx, i, j);
 					if (x != -1)
-						L5HorizWall(i, j, 2, x);
+						L5HorizWall(ctx, i, j, 2, x);
 				}
-				if (dungeon[i][j] == 1 && GenerateRnd(100) < WALL_CHANCE) {
-					y = L5VWallOk(i, j);
+				if (ctx.dungeon[i][j] == 1 && GenerateRnd(100) < WALL_CHANCE) {
+					y = L5VWallOk(ctx, i, j);
 					if (y != -1)
-						L5VertWall(i, j, 1, y);
+						L5VertWall(ctx, i, j, 1, y);
 				}
 			}
 		}
 	}
 }
 
-static void DRLG_L5GChamber(int sx, int sy, bool topflag, bool bottomflag, bool leftflag, bool rightflag)
+static void DRLG_L5GChamber(DungeonContext &ctx, int sx, int sy, bool topflag, bool bottomflag, bool leftflag, bool rightflag)
 {
 	int i, j;
 
 	if (topflag) {
-		dungeon[sx + 2][sy] = 12;
-		dungeon[sx + 3][sy] = 12;
-		dungeon[sx + 4][sy] = 3;
-		dungeon[sx + 7][sy] = 9;
-		dungeon[sx + 8][sy] = 12;
-		dungeon[sx + 9][sy] = 2;
+		ctx.dungeon[sx + 2][sy] = 12;
+		ctx.dungeon[sx + 3][sy] = 12;
+		ctx.dungeon[sx + 4][sy] = 3;
+		ctx.dungeon[sx + 7][sy] = 9;
+		ctx.dungeon[sx + 8][sy] = 12;
+		ctx.dungeon[sx + 9][sy] = 2;
 	}
 	if (bottomflag) {
 		sy += 11;
-		dungeon[sx + 2][sy] = 10;
-		dungeon[sx + 3][sy] = 12;
-		dungeon[sx + 4][sy] = 8;
-		dungeon[sx + 7][sy] = 5;
-		dungeon[sx + 8][sy] = 12;
-		if (dungeon[sx + 9][sy] != 4) {
-			dungeon[sx + 9][sy] = 21;
+		ctx.dungeon[sx + 2][sy] = 10;
+		ctx.dungeon[sx + 3][sy] = 12;
+		ctx.dungeon[sx + 4][sy] = 8;
+		ctx.dungeon[sx + 7][sy] = 5;
+		ctx.dungeon[sx + 8][sy] = 12;
+		if (ctx.dungeon[sx + 9][sy] != 4) {
+			ctx.dungeon[sx + 9][sy] = 21;
 		}
 		sy -= 11;
 	}
 	if (leftflag) {
-		dungeon[sx][sy + 2] = 11;
-		dungeon[sx][sy + 3] = 11;
-		dungeon[sx][sy + 4] = 3;
-		dungeon[sx][sy + 7] = 8;
-		dungeon[sx][sy + 8] = 11;
-		dungeon[sx][sy + 9] = 1;
+		ctx.dungeon[sx][sy + 2] = 11;
+		ctx.dungeon[sx][sy + 3] = 11;
+		ctx.dungeon[sx][sy + 4] = 3;
+		ctx.dungeon[sx][sy + 7] = 8;
+		ctx.dungeon[sx][sy + 8] = 11;
+		ctx.dungeon[sx][sy + 9] = 1;
 	}
 	if (rightflag) {
 		sx += 11;
-		dungeon[sx][sy + 2] = 14;
-		dungeon[sx][sy + 3] = 11;
-		dungeon[sx][sy + 4] = 9;
-		dungeon[sx][sy + 7] = 5;
-		dungeon[sx][sy + 8] = 11;
-		if (dungeon[sx][sy + 9] != 4) {
-			dungeon[sx][sy + 9] = 21;
+		ctx.dungeon[sx][sy + 2] = 14;
+		ctx.dungeon[sx][sy + 3] = 11;
+		ctx.dungeon[sx][sy + 4] = 9;
+		ctx.dungeon[sx][sy + 7] = 5;
+		ctx.dungeon[sx][sy + 8] = 11;
+		if (ctx.dungeon[sx][sy + 9] != 4) {
+			ctx.dungeon[sx][sy + 9] = 21;
 		}
 		sx -= 11;
 	}
 
 	for (j = 1; j < 11; j++) {
 		for (i = 1; i < 11; i++) {
-			dungeon[i + sx][j + sy] = 13;
-			L5dflags[i + sx][j + sy] |= DLRG_CHAMBER;
+			ctx.dungeon[i + sx][j + sy] = 13;
+			ctx.L5dflags[i + sx][j + sy] |= DLRG_CHAMBER;
 		}
 	}
 
-	dungeon[sx + 4][sy + 4] = 15;
-	dungeon[sx + 7][sy + 4] = 15;
-	dungeon[sx + 4][sy + 7] = 15;
-	dungeon[sx + 7][sy + 7] = 15;
+	ctx.dungeon[sx + 4][sy + 4] = 15;
+	ctx.dungeon[sx + 7][sy + 4] = 15;
+	ctx.dungeon[sx + 4][sy + 7] = 15;
+	ctx.dungeon[sx + 7][sy + 7] = 15;
 }
 
-static void DRLG_L5GHall(int x1, int y1, int x2, int y2)
+static void DRLG_L5GHall(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	if (y1 == y2) {
 		for (int i = x1; i < x2; i++) {
-			dungeon[i][y1] = 12;
-			dungeon[i][y1 + 3] = 12;
+			ctx.dungeon[i][y1] = 12;
+			ctx.dungeon[i][y1 + 3] = 12;
 		}
 		return;
 	}
 
 	for (int i = y1; i < y2; i++) {
-		dungeon[x1][i] = 11;
-		dungeon[x1 + 3][i] = 11;
+		ctx.dungeon[x1][i] = 11;
+		ctx.dungeon[x1 + 3][i] = 11;
 	}
 }
 
-static void L5tileFix()
+static void L5tileFix(DungeonContext &ctx)
 {
 	// BUGFIX: Bounds checks are required in all loop bodies.
 	// See https://github.com/diasurgical/devilutionX/pull/401
@@ -1816,22 +1795,22 @@ static void L5tileFix()
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
 			if (i + 1 < DMAXX) {
-				if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 23;
-				if (dungeon[i][j] == 13 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 18;
-				if (dungeon[i][j] == 13 && dungeon[i + 1][j] == 2)
-					dungeon[i + 1][j] = 7;
-				if (dungeon[i][j] == 6 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 24;
+				if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 23;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 18;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] == 2)
+					ctx.dungeon[i + 1][j] = 7;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 24;
 			}
 			if (j + 1 < DMAXY) {
-				if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 22)
-					dungeon[i][j + 1] = 24;
-				if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 1)
-					dungeon[i][j + 1] = 6;
-				if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 22)
-					dungeon[i][j + 1] = 19;
+				if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 22)
+					ctx.dungeon[i][j + 1] = 24;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 1)
+					ctx.dungeon[i][j + 1] = 6;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 22)
+					ctx.dungeon[i][j + 1] = 19;
 			}
 		}
 	}
@@ -1839,97 +1818,97 @@ static void L5tileFix()
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
 			if (i + 1 < DMAXX) {
-				if (dungeon[i][j] == 13 && dungeon[i + 1][j] == 19)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 13 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 20;
-				if (dungeon[i][j] == 7 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 23;
-				if (dungeon[i][j] == 13 && dungeon[i + 1][j] == 24)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 20;
-				if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 19)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 1)
-					dungeon[i + 1][j] = 6;
-				if (dungeon[i][j] == 7 && dungeon[i + 1][j] == 19)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 1)
-					dungeon[i + 1][j] = 6;
-				if (dungeon[i][j] == 3 && dungeon[i + 1][j] == 22)
-					dungeon[i + 1][j] = 24;
-				if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 1)
-					dungeon[i + 1][j] = 6;
-				if (dungeon[i][j] == 7 && dungeon[i + 1][j] == 1)
-					dungeon[i + 1][j] = 6;
-				if (dungeon[i][j] == 7 && dungeon[i + 1][j] == 24)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 4 && dungeon[i + 1][j] == 16)
-					dungeon[i + 1][j] = 17;
-				if (dungeon[i][j] == 7 && dungeon[i + 1][j] == 13)
-					dungeon[i + 1][j] = 17;
-				if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 24)
-					dungeon[i + 1][j] = 21;
-				if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 13)
-					dungeon[i + 1][j] = 17;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] == 19)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 20;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 23;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] == 24)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 20;
+				if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 19)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 1)
+					ctx.dungeon[i + 1][j] = 6;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i + 1][j] == 19)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 1)
+					ctx.dungeon[i + 1][j] = 6;
+				if (ctx.dungeon[i][j] == 3 && ctx.dungeon[i + 1][j] == 22)
+					ctx.dungeon[i + 1][j] = 24;
+				if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 1)
+					ctx.dungeon[i + 1][j] = 6;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i + 1][j] == 1)
+					ctx.dungeon[i + 1][j] = 6;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i + 1][j] == 24)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 4 && ctx.dungeon[i + 1][j] == 16)
+					ctx.dungeon[i + 1][j] = 17;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i + 1][j] == 13)
+					ctx.dungeon[i + 1][j] = 17;
+				if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 24)
+					ctx.dungeon[i + 1][j] = 21;
+				if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 13)
+					ctx.dungeon[i + 1][j] = 17;
 			}
 			if (i > 0) {
-				if (dungeon[i][j] == 23 && dungeon[i - 1][j] == 22)
-					dungeon[i - 1][j] = 19;
-				if (dungeon[i][j] == 19 && dungeon[i - 1][j] == 23)
-					dungeon[i - 1][j] = 21;
-				if (dungeon[i][j] == 6 && dungeon[i - 1][j] == 22)
-					dungeon[i - 1][j] = 24;
-				if (dungeon[i][j] == 6 && dungeon[i - 1][j] == 23)
-					dungeon[i - 1][j] = 21;
+				if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i - 1][j] == 22)
+					ctx.dungeon[i - 1][j] = 19;
+				if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i - 1][j] == 23)
+					ctx.dungeon[i - 1][j] = 21;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i - 1][j] == 22)
+					ctx.dungeon[i - 1][j] = 24;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i - 1][j] == 23)
+					ctx.dungeon[i - 1][j] = 21;
 			}
 			if (j + 1 < DMAXY) {
-				if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 2)
-					dungeon[i][j + 1] = 7;
-				if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 18)
-					dungeon[i][j + 1] = 21;
-				if (dungeon[i][j] == 18 && dungeon[i][j + 1] == 2)
-					dungeon[i][j + 1] = 7;
-				if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 2)
-					dungeon[i][j + 1] = 7;
-				if (dungeon[i][j] == 21 && dungeon[i][j + 1] == 2)
-					dungeon[i][j + 1] = 7;
-				if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 22)
-					dungeon[i][j + 1] = 24;
-				if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 13)
-					dungeon[i][j + 1] = 16;
-				if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 13)
-					dungeon[i][j + 1] = 16;
-				if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 16)
-					dungeon[i][j + 1] = 17;
+				if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 2)
+					ctx.dungeon[i][j + 1] = 7;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 18)
+					ctx.dungeon[i][j + 1] = 21;
+				if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 2)
+					ctx.dungeon[i][j + 1] = 7;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 2)
+					ctx.dungeon[i][j + 1] = 7;
+				if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] == 2)
+					ctx.dungeon[i][j + 1] = 7;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 22)
+					ctx.dungeon[i][j + 1] = 24;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 13)
+					ctx.dungeon[i][j + 1] = 16;
+				if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 13)
+					ctx.dungeon[i][j + 1] = 16;
+				if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 16)
+					ctx.dungeon[i][j + 1] = 17;
 			}
 			if (j > 0) {
-				if (dungeon[i][j] == 6 && dungeon[i][j - 1] == 22)
-					dungeon[i][j - 1] = 7;
-				if (dungeon[i][j] == 6 && dungeon[i][j - 1] == 22)
-					dungeon[i][j - 1] = 24;
-				if (dungeon[i][j] == 7 && dungeon[i][j - 1] == 24)
-					dungeon[i][j - 1] = 21;
-				if (dungeon[i][j] == 18 && dungeon[i][j - 1] == 24)
-					dungeon[i][j - 1] = 21;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j - 1] == 22)
+					ctx.dungeon[i][j - 1] = 7;
+				if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j - 1] == 22)
+					ctx.dungeon[i][j - 1] = 24;
+				if (ctx.dungeon[i][j] == 7 && ctx.dungeon[i][j - 1] == 24)
+					ctx.dungeon[i][j - 1] = 21;
+				if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j - 1] == 24)
+					ctx.dungeon[i][j - 1] = 21;
 			}
 		}
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (j + 1 < DMAXY && dungeon[i][j] == 4 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 7;
-			if (i + 1 < DMAXX && dungeon[i][j] == 2 && dungeon[i + 1][j] == 19)
-				dungeon[i + 1][j] = 21;
-			if (j + 1 < DMAXY && dungeon[i][j] == 18 && dungeon[i][j + 1] == 22)
-				dungeon[i][j + 1] = 20;
+			if (j + 1 < DMAXY && ctx.dungeon[i][j] == 4 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 7;
+			if (i + 1 < DMAXX && ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 19)
+				ctx.dungeon[i + 1][j] = 21;
+			if (j + 1 < DMAXY && ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 22)
+				ctx.dungeon[i][j + 1] = 20;
 		}
 	}
 }
 
-void drlg_l1_crypt_rndset(const BYTE *miniset, int rndper)
+void drlg_l1_crypt_rndset(DungeonContext &ctx, const BYTE *miniset, int rndper)
 {
 	int sw = miniset[0];
 	int sh = miniset[1];
@@ -1940,10 +1919,10 @@ void drlg_l1_crypt_rndset(const BYTE *miniset, int rndper)
 			int ii = 2;
 			for (int yy = 0; yy < sh && found; yy++) {
 				for (int xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1954,8 +1933,8 @@ void drlg_l1_crypt_rndset(const BYTE *miniset, int rndper)
 				// BUGFIX: accesses to dungeon can go out of bounds (fixed)
 				// BUGFIX: Comparisons vs 100 should use same tile as comparisons vs 84 - NOT A BUG - "fixing" this breaks crypt
 
-				constexpr auto comparison_with_bounds_check = [](Point p1, Point p2) {
-					return (p1.x >= 0 && p1.x < DMAXX && p1.y >= 0 && p1.y < DMAXY) && (p2.x >= 0 && p2.x < DMAXX && p2.y >= 0 && p2.y < DMAXY) && (dungeon[p1.x][p1.y] >= 84 && dungeon[p2.x][p2.y] <= 100);
+				auto comparison_with_bounds_check = [&ctx](Point p1, Point p2) {
+					return (p1.x >= 0 && p1.x < DMAXX && p1.y >= 0 && p1.y < DMAXY) && (p2.x >= 0 && p2.x < DMAXX && p2.y >= 0 && p2.y < DMAXY) && (ctx.dungeon[p1.x][p1.y] >= 84 && ctx.dungeon[p2.x][p2.y] <= 100);
 				};
 				if (comparison_with_bounds_check({ sx - 1, sy }, { sx - 1, sy })) {
 					found = false;
@@ -1974,7 +1953,7 @@ void drlg_l1_crypt_rndset(const BYTE *miniset, int rndper)
 				for (int yy = 0; yy < sh; yy++) {
 					for (int xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							ctx.dungeon[xx + sx][yy + sy] = miniset[kk];
 						}
 						kk++;
 					}
@@ -1984,16 +1963,16 @@ void drlg_l1_crypt_rndset(const BYTE *miniset, int rndper)
 	}
 }
 
-static void DRLG_L5Subs()
+static void DRLG_L5Subs(DungeonContext &ctx)
 {
 	int x, y, rv, i;
 
 	for (y = 0; y < DMAXY; y++) {
 		for (x = 0; x < DMAXX; x++) {
 			if (GenerateRnd(4) == 0) {
-				BYTE c = L5BTYPES[dungeon[x][y]];
+				BYTE c = L5BTYPES[ctx.dungeon[x][y]];
 
-				if (c != 0 && L5dflags[x][y] == 0) {
+				if (c != 0 && ctx.L5dflags[x][y] == 0) {
 					rv = GenerateRnd(16);
 					i = -1;
 
@@ -2006,369 +1985,369 @@ static void DRLG_L5Subs()
 
 					// BUGFIX: Add `&& y > 0` to the if statement. (fixed)
 					if (i == 89 && y > 0) {
-						if (L5BTYPES[dungeon[x][y - 1]] != 79 || L5dflags[x][y - 1] != 0)
+						if (L5BTYPES[ctx.dungeon[x][y - 1]] != 79 || ctx.L5dflags[x][y - 1] != 0)
 							i = 79;
 						else
-							dungeon[x][y - 1] = 90;
+							ctx.dungeon[x][y - 1] = 90;
 					}
 					// BUGFIX: Add `&& x + 1 < DMAXX` to the if statement. (fixed)
 					if (i == 91 && x + 1 < DMAXX) {
-						if (L5BTYPES[dungeon[x + 1][y]] != 80 || L5dflags[x + 1][y] != 0)
+						if (L5BTYPES[ctx.dungeon[x + 1][y]] != 80 || ctx.L5dflags[x + 1][y] != 0)
 							i = 80;
 						else
-							dungeon[x + 1][y] = 92;
+							ctx.dungeon[x + 1][y] = 92;
 					}
-					dungeon[x][y] = i;
+					ctx.dungeon[x][y] = i;
 				}
 			}
 		}
 	}
 }
 
-static void DRLG_L5SetRoom(int rx1, int ry1)
+static void DRLG_L5SetRoom(DungeonContext &ctx, int rx1, int ry1)
 {
-	int width = SDL_SwapLE16(L5pSetPiece[0]);
-	int height = SDL_SwapLE16(L5pSetPiece[1]);
+	int width = SDL_SwapLE16(ctx.L5pSetPiece[0]);
+	int height = SDL_SwapLE16(ctx.L5pSetPiece[1]);
 
-	setpc_x = rx1;
-	setpc_y = ry1;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = rx1;
+	ctx.setpc_y = ry1;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
-	uint16_t *tileLayer = &L5pSetPiece[2];
+	uint16_t *tileLayer = &ctx.L5pSetPiece[2];
 
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				dungeon[rx1 + i][ry1 + j] = tileId;
-				L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
+				ctx.dungeon[rx1 + i][ry1 + j] = tileId;
+				ctx.L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[rx1 + i][ry1 + j] = 13;
+				ctx.dungeon[rx1 + i][ry1 + j] = 13;
 			}
 		}
 	}
 }
 
-static void L5FillChambers()
+static void L5FillChambers(DungeonContext &ctx)
 {
-	if (HR1)
-		DRLG_L5GChamber(0, 14, false, false, false, true);
-
-	if (HR2) {
-		if (HR1 && !HR3)
-			DRLG_L5GChamber(14, 14, false, false, true, false);
-		if (!HR1 && HR3)
-			DRLG_L5GChamber(14, 14, false, false, false, true);
-		if (HR1 && HR3)
-			DRLG_L5GChamber(14, 14, false, false, true, true);
-		if (!HR1 && !HR3)
-			DRLG_L5GChamber(14, 14, false, false, false, false);
-	}
-
-	if (HR3)
-		DRLG_L5GChamber(28, 14, false, false, true, false);
-	if (HR1 && HR2)
-		DRLG_L5GHall(12, 18, 14, 18);
-	if (HR2 && HR3)
-		DRLG_L5GHall(26, 18, 28, 18);
-	if (HR1 && !HR2 && HR3)
-		DRLG_L5GHall(12, 18, 28, 18);
-	if (VR1)
-		DRLG_L5GChamber(14, 0, false, true, false, false);
-
-	if (VR2) {
-		if (VR1 && !VR3)
-			DRLG_L5GChamber(14, 14, true, false, false, false);
-		if (!VR1 && VR3)
-			DRLG_L5GChamber(14, 14, false, true, false, false);
-		if (VR1 && VR3)
-			DRLG_L5GChamber(14, 14, true, true, false, false);
-		if (!VR1 && !VR3)
-			DRLG_L5GChamber(14, 14, false, false, false, false);
-	}
-
-	if (VR3)
-		DRLG_L5GChamber(14, 28, true, false, false, false);
-	if (VR1 && VR2)
-		DRLG_L5GHall(18, 12, 18, 14);
-	if (VR2 && VR3)
-		DRLG_L5GHall(18, 26, 18, 28);
-	if (VR1 && !VR2 && VR3)
-		DRLG_L5GHall(18, 12, 18, 28);
-
-	if (currlevel == 24) {
-		if (VR1 || VR2 || VR3) {
+	if (ctx.HR1)
+		DRLG_L5GChamber(ctx, 0, 14, false, false, false, true);
+
+	if (ctx.HR2) {
+		if (ctx.HR1 && !ctx.HR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, false, true, false);
+		if (!ctx.HR1 && ctx.HR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, false, false, true);
+		if (ctx.HR1 && ctx.HR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, false, true, true);
+		if (!ctx.HR1 && !ctx.HR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, false, false, false);
+	}
+
+	if (ctx.HR3)
+		DRLG_L5GChamber(ctx, 28, 14, false, false, true, false);
+	if (ctx.HR1 && ctx.HR2)
+		DRLG_L5GHall(ctx, 12, 18, 14, 18);
+	if (ctx.HR2 && ctx.HR3)
+		DRLG_L5GHall(ctx, 26, 18, 28, 18);
+	if (ctx.HR1 && !ctx.HR2 && ctx.HR3)
+		DRLG_L5GHall(ctx, 12, 18, 28, 18);
+	if (ctx.VR1)
+		DRLG_L5GChamber(ctx, 14, 0, false, true, false, false);
+
+	if (ctx.VR2) {
+		if (ctx.VR1 && !ctx.VR3)
+			DRLG_L5GChamber(ctx, 14, 14, true, false, false, false);
+		if (!ctx.VR1 && ctx.VR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, true, false, false);
+		if (ctx.VR1 && ctx.VR3)
+			DRLG_L5GChamber(ctx, 14, 14, true, true, false, false);
+		if (!ctx.VR1 && !ctx.VR3)
+			DRLG_L5GChamber(ctx, 14, 14, false, false, false, false);
+	}
+
+	if (ctx.VR3)
+		DRLG_L5GChamber(ctx, 14, 28, true, false, false, false);
+	if (ctx.VR1 && ctx.VR2)
+		DRLG_L5GHall(ctx, 18, 12, 18, 14);
+	if (ctx.VR2 && ctx.VR3)
+		DRLG_L5GHall(ctx, 18, 26, 18, 28);
+	if (ctx.VR1 && !ctx.VR2 && ctx.VR3)
+		DRLG_L5GHall(ctx, 18, 12, 18, 28);
+
+	if (ctx.currlevel == 24) {
+		if (ctx.VR1 || ctx.VR2 || ctx.VR3) {
 			int c = 1;
-			if (!VR1 && VR2 && VR3 && GenerateRnd(2) != 0)
+			if (!ctx.VR1 && ctx.VR2 && ctx.VR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (VR1 && VR2 && !VR3 && GenerateRnd(2) != 0)
+			if (ctx.VR1 && ctx.VR2 && !ctx.VR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (VR1 && !VR2 && VR3) {
+			if (ctx.VR1 && !ctx.VR2 && ctx.VR3) {
 				c = (GenerateRnd(2) != 0) ? 0 : 2;
 			}
 
-			if (VR1 && VR2 && VR3)
+			if (ctx.VR1 && ctx.VR2 && ctx.VR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				drlg_l1_set_crypt_room(16, 2);
+				drlg_l1_set_crypt_room(ctx, 16, 2);
 				break;
 			case 1:
-				drlg_l1_set_crypt_room(16, 16);
+				drlg_l1_set_crypt_room(ctx, 16, 16);
 				break;
 			case 2:
-				drlg_l1_set_crypt_room(16, 30);
+				drlg_l1_set_crypt_room(ctx, 16, 30);
 				break;
 			}
 		} else {
 			int c = 1;
-			if (!HR1 && HR2 && HR3 && GenerateRnd(2) != 0)
+			if (!ctx.HR1 && ctx.HR2 && ctx.HR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (HR1 && HR2 && !HR3 && GenerateRnd(2) != 0)
+			if (ctx.HR1 && ctx.HR2 && !ctx.HR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (HR1 && !HR2 && HR3) {
+			if (ctx.HR1 && !ctx.HR2 && ctx.HR3) {
 				c = (GenerateRnd(2) != 0) ? 0 : 2;
 			}
 
-			if (HR1 && HR2 && HR3)
+			if (ctx.HR1 && ctx.HR2 && ctx.HR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				drlg_l1_set_crypt_room(2, 16);
+				drlg_l1_set_crypt_room(ctx, 2, 16);
 				break;
 			case 1:
-				drlg_l1_set_crypt_room(16, 16);
+				drlg_l1_set_crypt_room(ctx, 16, 16);
 				break;
 			case 2:
-				drlg_l1_set_crypt_room(30, 16);
+				drlg_l1_set_crypt_room(ctx, 30, 16);
 				break;
 			}
 		}
 	}
-	if (currlevel == 21) {
-		if (VR1 || VR2 || VR3) {
+	if (ctx.currlevel == 21) {
+		if (ctx.VR1 || ctx.VR2 || ctx.VR3) {
 			int c = 1;
-			if (!VR1 && VR2 && VR3 && GenerateRnd(2) != 0)
+			if (!ctx.VR1 && ctx.VR2 && ctx.VR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (VR1 && VR2 && !VR3 && GenerateRnd(2) != 0)
+			if (ctx.VR1 && ctx.VR2 && !ctx.VR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (VR1 && !VR2 && VR3) {
+			if (ctx.VR1 && !ctx.VR2 && ctx.VR3) {
 				if (GenerateRnd(2) != 0)
 					c = 0;
 				else
 					c = 2;
 			}
 
-			if (VR1 && VR2 && VR3)
+			if (ctx.VR1 && ctx.VR2 && ctx.VR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				drlg_l1_set_corner_room(16, 2);
+				drlg_l1_set_corner_room(ctx, 16, 2);
 				break;
 			case 1:
-				drlg_l1_set_corner_room(16, 16);
+				drlg_l1_set_corner_room(ctx, 16, 16);
 				break;
 			case 2:
-				drlg_l1_set_corner_room(16, 30);
+				drlg_l1_set_corner_room(ctx, 16, 30);
 				break;
 			}
 		} else {
 			int c = 1;
-			if (!HR1 && HR2 && HR3 && GenerateRnd(2) != 0)
+			if (!ctx.HR1 && ctx.HR2 && ctx.HR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (HR1 && HR2 && !HR3 && GenerateRnd(2) != 0)
+			if (ctx.HR1 && ctx.HR2 && !ctx.HR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (HR1 && !HR2 && HR3) {
+			if (ctx.HR1 && !ctx.HR2 && ctx.HR3) {
 				if (GenerateRnd(2) != 0)
 					c = 0;
 				else
 					c = 2;
 			}
 
-			if (HR1 && HR2 && HR3)
+			if (ctx.HR1 && ctx.HR2 && ctx.HR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				drlg_l1_set_corner_room(2, 16);
+				drlg_l1_set_corner_room(ctx, 2, 16);
 				break;
 			case 1:
-				drlg_l1_set_corner_room(16, 16);
+				drlg_l1_set_corner_room(ctx, 16, 16);
 				break;
 			case 2:
-				drlg_l1_set_corner_room(30, 16);
+				drlg_l1_set_corner_room(ctx, 30, 16);
 				break;
 			}
 		}
 	}
-	if (L5setloadflag) {
-		if (VR1 || VR2 || VR3) {
+	if (ctx.L5setloadflag) {
+		if (ctx.VR1 || ctx.VR2 || ctx.VR3) {
 			int c = 1;
-			if (!VR1 && VR2 && VR3 && GenerateRnd(2) != 0)
+			if (!ctx.VR1 && ctx.VR2 && ctx.VR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (VR1 && VR2 && !VR3 && GenerateRnd(2) != 0)
+			if (ctx.VR1 && ctx.VR2 && !ctx.VR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (VR1 && !VR2 && VR3) {
+			if (ctx.VR1 && !ctx.VR2 && ctx.VR3) {
 				if (GenerateRnd(2) != 0)
 					c = 0;
 				else
 					c = 2;
 			}
 
-			if (VR1 && VR2 && VR3)
+			if (ctx.VR1 && ctx.VR2 && ctx.VR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				DRLG_L5SetRoom(16, 2);
+				DRLG_L5SetRoom(ctx, 16, 2);
 				break;
 			case 1:
-				DRLG_L5SetRoom(16, 16);
+				DRLG_L5SetRoom(ctx, 16, 16);
 				break;
 			case 2:
-				DRLG_L5SetRoom(16, 30);
+				DRLG_L5SetRoom(ctx, 16, 30);
 				break;
 			}
 		} else {
 			int c = 1;
-			if (!HR1 && HR2 && HR3 && GenerateRnd(2) != 0)
+			if (!ctx.HR1 && ctx.HR2 && ctx.HR3 && GenerateRnd(2) != 0)
 				c = 2;
-			if (HR1 && HR2 && !HR3 && GenerateRnd(2) != 0)
+			if (ctx.HR1 && ctx.HR2 && !ctx.HR3 && GenerateRnd(2) != 0)
 				c = 0;
 
-			if (HR1 && !HR2 && HR3) {
+			if (ctx.HR1 && !ctx.HR2 && ctx.HR3) {
 				if (GenerateRnd(2) != 0)
 					c = 0;
 				else
 					c = 2;
 			}
 
-			if (HR1 && HR2 && HR3)
+			if (ctx.HR1 && ctx.HR2 && ctx.HR3)
 				c = GenerateRnd(3);
 
 			switch (c) {
 			case 0:
-				DRLG_L5SetRoom(2, 16);
+				DRLG_L5SetRoom(ctx, 2, 16);
 				break;
 			case 1:
-				DRLG_L5SetRoom(16, 16);
+				DRLG_L5SetRoom(ctx, 16, 16);
 				break;
 			case 2:
-				DRLG_L5SetRoom(30, 16);
+				DRLG_L5SetRoom(ctx, 30, 16);
 				break;
 			}
 		}
 	}
 }
 
-void drlg_l1_set_crypt_room(int rx1, int ry1)
+void drlg_l1_set_crypt_room(DungeonContext &ctx, int rx1, int ry1)
 {
 	int rw = UberRoomPattern[0];
 	int rh = UberRoomPattern[1];
 
-	UberRow = 2 * rx1 + 6;
-	UberCol = 2 * ry1 + 8;
-	setpc_x = rx1;
-	setpc_y = ry1;
-	setpc_w = rw;
-	setpc_h = rh;
-	IsUberRoomOpened = false;
-	IsUberLeverActivated = false;
+	ctx.UberRow = 2 * rx1 + 6;
+	ctx.UberCol = 2 * ry1 + 8;
+	ctx.setpc_x = rx1;
+	ctx.setpc_y = ry1;
+	ctx.setpc_w = rw;
+	ctx.setpc_h = rh;
+	ctx.IsUberRoomOpened = false;
+	ctx.IsUberLeverActivated = false;
 
 	int sp = 2;
 
 	for (int j = 0; j < rh; j++) {
 		for (int i = 0; i < rw; i++) {
 			if (UberRoomPattern[sp] != 0) {
-				dungeon[rx1 + i][ry1 + j] = UberRoomPattern[sp];
-				L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
+				ctx.dungeon[rx1 + i][ry1 + j] = UberRoomPattern[sp];
+				ctx.L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[rx1 + i][ry1 + j] = 13;
+				ctx.dungeon[rx1 + i][ry1 + j] = 13;
 			}
 			sp++;
 		}
 	}
 }
 
-void drlg_l1_set_corner_room(int rx1, int ry1)
+void drlg_l1_set_corner_room(DungeonContext &ctx, int rx1, int ry1)
 {
 	int rw = CornerstoneRoomPattern[0];
 	int rh = CornerstoneRoomPattern[1];
 
-	setpc_x = rx1;
-	setpc_y = ry1;
-	setpc_w = rw;
-	setpc_h = rh;
+	ctx.setpc_x = rx1;
+	ctx.setpc_y = ry1;
+	ctx.setpc_w = rw;
+	ctx.setpc_h = rh;
 
 	int sp = 2;
 
 	for (int j = 0; j < rh; j++) {
 		for (int i = 0; i < rw; i++) {
 			if (CornerstoneRoomPattern[sp] != 0) {
-				dungeon[rx1 + i][ry1 + j] = CornerstoneRoomPattern[sp];
-				L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
+				ctx.dungeon[rx1 + i][ry1 + j] = CornerstoneRoomPattern[sp];
+				ctx.L5dflags[rx1 + i][ry1 + j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[rx1 + i][ry1 + j] = 13;
+				ctx.dungeon[rx1 + i][ry1 + j] = 13;
 			}
 			sp++;
 		}
 	}
 }
 
-static void DRLG_L5FTVR(int i, int j, int x, int y, int d)
+static void DRLG_L5FTVR(DungeonContext &ctx, int i, int j, int x, int y, int d)
 {
-	if (dTransVal[x][y] != 0 || dungeon[i][j] != 13) {
+	if (ctx.dTransVal[x][y] != 0 || ctx.dungeon[i][j] != 13) {
 		if (d == 1) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		}
 		if (d == 2) {
-			dTransVal[x + 1][y] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 3) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		}
 		if (d == 4) {
-			dTransVal[x][y + 1] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 5)
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		if (d == 6)
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		if (d == 7)
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		if (d == 8)
-			dTransVal[x][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
 		return;
 	}
 
-	dTransVal[x][y] = TransVal;
-	dTransVal[x + 1][y] = TransVal;
-	dTransVal[x][y + 1] = TransVal;
-	dTransVal[x + 1][y + 1] = TransVal;
-	DRLG_L5FTVR(i + 1, j, x + 2, y, 1);
-	DRLG_L5FTVR(i - 1, j, x - 2, y, 2);
-	DRLG_L5FTVR(i, j + 1, x, y + 2, 3);
-	DRLG_L5FTVR(i, j - 1, x, y - 2, 4);
-	DRLG_L5FTVR(i - 1, j - 1, x - 2, y - 2, 5);
-	DRLG_L5FTVR(i + 1, j - 1, x + 2, y - 2, 6);
-	DRLG_L5FTVR(i - 1, j + 1, x - 2, y + 2, 7);
-	DRLG_L5FTVR(i + 1, j + 1, x + 2, y + 2, 8);
+	ctx.dTransVal[x][y] = ctx.TransVal;
+	ctx.dTransVal[x + 1][y] = ctx.TransVal;
+	ctx.dTransVal[x][y + 1] = ctx.TransVal;
+	ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
+	DRLG_L5FTVR(ctx, i + 1, j, x + 2, y, 1);
+	DRLG_L5FTVR(ctx, i - 1, j, x - 2, y, 2);
+	DRLG_L5FTVR(ctx, i, j + 1, x, y + 2, 3);
+	DRLG_L5FTVR(ctx, i, j - 1, x, y - 2, 4);
+	DRLG_L5FTVR(ctx, i - 1, j - 1, x - 2, y - 2, 5);
+	DRLG_L5FTVR(ctx, i + 1, j - 1, x + 2, y - 2, 6);
+	DRLG_L5FTVR(ctx, i - 1, j + 1, x - 2, y + 2, 7);
+	DRLG_L5FTVR(ctx, i + 1, j + 1, x + 2, y + 2, 8);
 }
 
-static void DRLG_L5FloodTVal()
+static void DRLG_L5FloodTVal(DungeonContext &ctx)
 {
 	int yy = 16;
 
@@ -2376,9 +2355,9 @@ static void DRLG_L5FloodTVal()
 		int xx = 16;
 
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 13 && dTransVal[xx][yy] == 0) {
-				DRLG_L5FTVR(i, j, xx, yy, 0);
-				TransVal++;
+			if (ctx.dungeon[i][j] == 13 && ctx.dTransVal[xx][yy] == 0) {
+				DRLG_L5FTVR(ctx, i, j, xx, yy, 0);
+				ctx.TransVal++;
 			}
 			xx += 2;
 		}
@@ -2386,7 +2365,7 @@ static void DRLG_L5FloodTVal()
 	}
 }
 
-static void DRLG_L5TransFix()
+static void DRLG_L5TransFix(DungeonContext &ctx)
 {
 	int yy = 16;
 
@@ -2395,27 +2374,27 @@ static void DRLG_L5TransFix()
 
 		for (int i = 0; i < DMAXX; i++) {
 			// BUGFIX: Should check for `j > 0` first. (fixed)
-			if (dungeon[i][j] == 23 && j > 0 && dungeon[i][j - 1] == 18) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 23 && j > 0 && ctx.dungeon[i][j - 1] == 18) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
 			// BUGFIX: Should check for `i + 1 < DMAXY` first. (fixed)
-			if (dungeon[i][j] == 24 && i + 1 < DMAXY && dungeon[i + 1][j] == 19) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 24 && i + 1 < DMAXY && ctx.dungeon[i + 1][j] == 19) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 18) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 18) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 19) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 19) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 20) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 20) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
 			xx += 2;
 		}
@@ -2423,23 +2402,23 @@ static void DRLG_L5TransFix()
 	}
 }
 
-static void DRLG_L5DirtFix()
+static void DRLG_L5DirtFix(DungeonContext &ctx)
 {
-	if (currlevel < 21) {
+	if (ctx.currlevel < 21) {
 		for (int j = 0; j < DMAXY - 1; j++) {
 			for (int i = 0; i < DMAXX - 1; i++) {
-				if (dungeon[i][j] == 21 && dungeon[i + 1][j] != 19)
-					dungeon[i][j] = 202;
-				if (dungeon[i][j] == 19 && dungeon[i + 1][j] != 19)
-					dungeon[i][j] = 200;
-				if (dungeon[i][j] == 24 && dungeon[i + 1][j] != 19)
-					dungeon[i][j] = 205;
-				if (dungeon[i][j] == 18 && dungeon[i][j + 1] != 18)
-					dungeon[i][j] = 199;
-				if (dungeon[i][j] == 21 && dungeon[i][j + 1] != 18)
-					dungeon[i][j] = 202;
-				if (dungeon[i][j] == 23 && dungeon[i][j + 1] != 18)
-					dungeon[i][j] = 204;
+				if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] != 19)
+					ctx.dungeon[i][j] = 202;
+				if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] != 19)
+					ctx.dungeon[i][j] = 200;
+				if (ctx.dungeon[i][j] == 24 && ctx.dungeon[i + 1][j] != 19)
+					ctx.dungeon[i][j] = 205;
+				if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] != 18)
+					ctx.dungeon[i][j] = 199;
+				if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] != 18)
+					ctx.dungeon[i][j] = 202;
+				if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i][j + 1] != 18)
+					ctx.dungeon[i][j] = 204;
 			}
 		}
 		return;
@@ -2447,41 +2426,41 @@ static void DRLG_L5DirtFix()
 
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
-			if (dungeon[i][j] == 19)
-				dungeon[i][j] = 83;
-			if (dungeon[i][j] == 21)
-				dungeon[i][j] = 85;
-			if (dungeon[i][j] == 23)
-				dungeon[i][j] = 87;
-			if (dungeon[i][j] == 24)
-				dungeon[i][j] = 88;
-			if (dungeon[i][j] == 18)
-				dungeon[i][j] = 82;
+			if (ctx.dungeon[i][j] == 19)
+				ctx.dungeon[i][j] = 83;
+			if (ctx.dungeon[i][j] == 21)
+				ctx.dungeon[i][j] = 85;
+			if (ctx.dungeon[i][j] == 23)
+				ctx.dungeon[i][j] = 87;
+			if (ctx.dungeon[i][j] == 24)
+				ctx.dungeon[i][j] = 88;
+			if (ctx.dungeon[i][j] == 18)
+				ctx.dungeon[i][j] = 82;
 		}
 	}
 }
 
-static void DRLG_L5CornerFix()
+static void DRLG_L5CornerFix(DungeonContext &ctx)
 {
 	for (int j = 1; j < DMAXY - 1; j++) {
 		for (int i = 1; i < DMAXX - 1; i++) {
-			if ((L5dflags[i][j] & DLRG_PROTECTED) == 0 && dungeon[i][j] == 17 && dungeon[i - 1][j] == 13 && dungeon[i][j - 1] == 1) {
-				dungeon[i][j] = 16;
-				L5dflags[i][j - 1] &= DLRG_PROTECTED;
+			if ((ctx.L5dflags[i][j] & DLRG_PROTECTED) == 0 && ctx.dungeon[i][j] == 17 && ctx.dungeon[i - 1][j] == 13 && ctx.dungeon[i][j - 1] == 1) {
+				ctx.dungeon[i][j] = 16;
+				ctx.L5dflags[i][j - 1] &= DLRG_PROTECTED;
 			}
-			if (dungeon[i][j] == 202 && dungeon[i + 1][j] == 13 && dungeon[i][j + 1] == 1) {
-				dungeon[i][j] = 8;
+			if (ctx.dungeon[i][j] == 202 && ctx.dungeon[i + 1][j] == 13 && ctx.dungeon[i][j + 1] == 1) {
+				ctx.dungeon[i][j] = 8;
 			}
 		}
 	}
 }
 
-static void DRLG_L5(lvl_entry entry)
+static void DRLG_L5(DungeonContext &ctx, lvl_entry entry)
 {
 	int i, j, minarea;
 	bool doneflag;
 
-	switch (currlevel) {
+	switch (ctx.currlevel) {
 	case 1:
 		minarea = 533;
 		break;
@@ -2494,121 +2473,121 @@ static void DRLG_L5(lvl_entry entry)
 	}
 
 	do {
-		DRLG_InitTrans();
+		DRLG_InitTrans(ctx);
 
 		do {
-			InitL5Dungeon();
-			L5firstRoom();
-		} while (L5GetArea() < minarea);
-
-		L5makeDungeon();
-		L5makeDmt();
-		L5FillChambers();
-		L5tileFix();
-		L5AddWall();
-		L5ClearFlags();
-		DRLG_L5FloodTVal();
+			InitL5Dungeon(ctx);
+			L5firstRoom(ctx);
+		} while (L5GetArea(ctx) < minarea);
+
+		L5makeDungeon(ctx);
+		L5makeDmt(ctx);
+		L5FillChambers(ctx);
+		L5tileFix(ctx);
+		L5AddWall(ctx);
+		L5ClearFlags(ctx);
+		DRLG_L5FloodTVal(ctx);
 
 		doneflag = true;
 
-		if (QuestStatus(Q_PWATER)) {
+		if (QuestStatus(Q_PWATER, ctx.currlevel)) {
 			if (entry == ENTRY_MAIN) {
-				if (DRLG_PlaceMiniSet(PWATERIN, 1, 1, 0, 0, true, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, PWATERIN, 1, 1, 0, 0, true, -1, 0) < 0)
 					doneflag = false;
 			} else {
-				if (DRLG_PlaceMiniSet(PWATERIN, 1, 1, 0, 0, false, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, PWATERIN, 1, 1, 0, 0, false, -1, 0) < 0)
 					doneflag = false;
-				ViewY--;
+				ctx.ViewY--;
 			}
 		}
-		if (QuestStatus(Q_LTBANNER)) {
+		if (QuestStatus(Q_LTBANNER, ctx.currlevel)) {
 			if (entry == ENTRY_MAIN) {
-				if (DRLG_PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
 					doneflag = false;
 			} else {
-				if (DRLG_PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
 					doneflag = false;
 				if (entry == ENTRY_PREV) {
-					ViewX = 2 * setpc_x + 20;
-					ViewY = 2 * setpc_y + 28;
+					ctx.ViewX = 2 * ctx.setpc_x + 20;
+					ctx.ViewY = 2 * ctx.setpc_y + 28;
 				} else {
-					ViewY--;
+					ctx.ViewY--;
 				}
 			}
 		} else if (entry == ENTRY_MAIN) {
-			if (currlevel < 21) {
+			if (ctx.currlevel < 21) {
 				if (!plr[myplr].pOriginalCathedral) {
-					if (DRLG_PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
+					if (DRLG_PlaceMiniSet(ctx, STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
 						doneflag = false;
-					if (DRLG_PlaceMiniSet(STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+					if (DRLG_PlaceMiniSet(ctx, STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 						doneflag = false;
 				} else {
-					if (DRLG_PlaceMiniSet(L5STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
+					if (DRLG_PlaceMiniSet(ctx, L5STAIRSUP, 1, 1, 0, 0, true, -1, 0) < 0)
 						doneflag = false;
-					else if (DRLG_PlaceMiniSet(STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+					else if (DRLG_PlaceMiniSet(ctx, STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 						doneflag = false;
 				}
-			} else if (currlevel == 21) {
-				if (DRLG_PlaceMiniSet(L5STAIRSTOWN, 1, 1, 0, 0, false, -1, 6) < 0)
+			} else if (ctx.currlevel == 21) {
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSTOWN, 1, 1, 0, 0, false, -1, 6) < 0)
 					doneflag = false;
-				if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 					doneflag = false;
-				ViewY++;
+				ctx.ViewY++;
 			} else {
-				if (DRLG_PlaceMiniSet(L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
 					doneflag = false;
-				if (currlevel != 24) {
-					if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+				if (ctx.currlevel != 24) {
+					if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 						doneflag = false;
 				}
-				ViewY++;
+				ctx.ViewY++;
 			}
 		} else if (!plr[myplr].pOriginalCathedral && entry == ENTRY_PREV) {
-			if (currlevel < 21) {
-				if (DRLG_PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
+			if (ctx.currlevel < 21) {
+				if (DRLG_PlaceMiniSet(ctx, STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
 					doneflag = false;
-				if (DRLG_PlaceMiniSet(STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
+				if (DRLG_PlaceMiniSet(ctx, STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
 					doneflag = false;
-				ViewY--;
-			} else if (currlevel == 21) {
-				if (DRLG_PlaceMiniSet(L5STAIRSTOWN, 1, 1, 0, 0, false, -1, 6) < 0)
+				ctx.ViewY--;
+			} else if (ctx.currlevel == 21) {
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSTOWN, 1, 1, 0, 0, false, -1, 6) < 0)
 					doneflag = false;
-				if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
 					doneflag = false;
-				ViewY += 3;
+				ctx.ViewY += 3;
 			} else {
-				if (DRLG_PlaceMiniSet(L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
 					doneflag = false;
-				if (currlevel != 24) {
-					if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
+				if (ctx.currlevel != 24) {
+					if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
 						doneflag = false;
 				}
-				ViewY += 3;
+				ctx.ViewY += 3;
 			}
 		} else {
-			if (currlevel < 21) {
+			if (ctx.currlevel < 21) {
 				if (!plr[myplr].pOriginalCathedral) {
-					if (DRLG_PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
+					if (DRLG_PlaceMiniSet(ctx, STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
 						doneflag = false;
-					if (DRLG_PlaceMiniSet(STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+					if (DRLG_PlaceMiniSet(ctx, STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 						doneflag = false;
 				} else {
-					if (DRLG_PlaceMiniSet(L5STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
+					if (DRLG_PlaceMiniSet(ctx, L5STAIRSUP, 1, 1, 0, 0, false, -1, 0) < 0)
 						doneflag = false;
-					else if (DRLG_PlaceMiniSet(STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
+					else if (DRLG_PlaceMiniSet(ctx, STAIRSDOWN, 1, 1, 0, 0, true, -1, 1) < 0)
 						doneflag = false;
-					ViewY--;
+					ctx.ViewY--;
 				}
-			} else if (currlevel == 21) {
-				if (DRLG_PlaceMiniSet(L5STAIRSTOWN, 1, 1, 0, 0, true, -1, 6) < 0)
+			} else if (ctx.currlevel == 21) {
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSTOWN, 1, 1, 0, 0, true, -1, 6) < 0)
 					doneflag = false;
-				if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 					doneflag = false;
 			} else {
-				if (DRLG_PlaceMiniSet(L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
+				if (DRLG_PlaceMiniSet(ctx, L5STAIRSUPHF, 1, 1, 0, 0, true, -1, 0) < 0)
 					doneflag = false;
-				if (currlevel != 24) {
-					if (DRLG_PlaceMiniSet(L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
+				if (ctx.currlevel != 24) {
+					if (DRLG_PlaceMiniSet(ctx, L5STAIRSDOWN, 1, 1, 0, 0, false, -1, 1) < 0)
 						doneflag = false;
 				}
 			}
@@ -2617,129 +2596,137 @@ static void DRLG_L5(lvl_entry entry)
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 64) {
+			if (ctx.dungeon[i][j] == 64) {
 				int xx = 2 * i + 16; /* todo: fix loop */
 				int yy = 2 * j + 16;
-				DRLG_CopyTrans(xx, yy + 1, xx, yy);
-				DRLG_CopyTrans(xx + 1, yy + 1, xx + 1, yy);
+				DRLG_CopyTrans(ctx, xx, yy + 1, xx, yy);
+				DRLG_CopyTrans(ctx, xx + 1, yy + 1, xx + 1, yy);
 			}
 		}
 	}
 
-	DRLG_L5TransFix();
-	DRLG_L5DirtFix();
-	DRLG_L5CornerFix();
+	DRLG_L5TransFix(ctx);
+	DRLG_L5DirtFix(ctx);
+	DRLG_L5CornerFix(ctx);
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if ((L5dflags[i][j] & ~DLRG_PROTECTED) != 0)
-				DRLG_PlaceDoor(i, j);
+			if ((ctx.L5dflags[i][j] & ~DLRG_PROTECTED) != 0)
+				DRLG_PlaceDoor(ctx, i, j);
 		}
 	}
 
-	if (currlevel < 21) {
-		DRLG_L5Subs();
+	if (ctx.currlevel < 21) {
+		DRLG_L5Subs(ctx);
 	} else {
-		drlg_l1_crypt_pattern1(10);
-		drlg_l1_crypt_rndset(byte_48A1B4, 95);
-		drlg_l1_crypt_rndset(byte_48A1B8, 95);
-		drlg_l1_crypt_rndset(byte_48A1C0, 100);
-		drlg_l1_crypt_rndset(byte_48A1C8, 100);
-		drlg_l1_crypt_rndset(byte_48A1E0, 60);
-		drlg_l1_crypt_lavafloor();
-		switch (currlevel) {
+		drlg_l1_crypt_pattern1(ctx, 10);
+		drlg_l1_crypt_rndset(ctx, byte_48A1B4, 95);
+		drlg_l1_crypt_rndset(ctx, byte_48A1B8, 95);
+		drlg_l1_crypt_rndset(ctx, byte_48A1C0, 100);
+		drlg_l1_crypt_rndset(ctx, byte_48A1C8, 100);
+		drlg_l1_crypt_rndset(ctx, byte_48A1E0, 60);
+		drlg_l1_crypt_lavafloor(ctx);
+		switch (ctx.currlevel) {
 		case 21:
-			drlg_l1_crypt_pattern2(30);
-			drlg_l1_crypt_pattern3(15);
-			drlg_l1_crypt_pattern4(5);
-			drlg_l1_crypt_lavafloor();
-			drlg_l1_crypt_pattern7(10);
-			drlg_l1_crypt_pattern6(5);
-			drlg_l1_crypt_pattern5(20);
+			drlg_l1_crypt_pattern2(ctx, 30);
+			drlg_l1_crypt_pattern3(ctx, 15);
+			drlg_l1_crypt_pattern4(ctx, 5);
+			drlg_l1_crypt_lavafloor(ctx);
+			drlg_l1_crypt_pattern7(ctx, 10);
+			drlg_l1_crypt_pattern6(ctx, 5);
+			drlg_l1_crypt_pattern5(ctx, 20);
 			break;
 		case 22:
-			drlg_l1_crypt_pattern7(10);
-			drlg_l1_crypt_pattern6(10);
-			drlg_l1_crypt_pattern5(20);
-			drlg_l1_crypt_pattern2(30);
-			drlg_l1_crypt_pattern3(20);
-			drlg_l1_crypt_pattern4(10);
-			drlg_l1_crypt_lavafloor();
+			drlg_l1_crypt_pattern7(ctx, 10);
+			drlg_l1_crypt_pattern6(ctx, 10);
+			drlg_l1_crypt_pattern5(ctx, 20);
+			drlg_l1_crypt_pattern2(ctx, 30);
+			drlg_l1_crypt_pattern3(ctx, 20);
+			drlg_l1_crypt_pattern4(ctx, 10);
+			drlg_l1_crypt_lavafloor(ctx);
 			break;
 		case 23:
-			drlg_l1_crypt_pattern7(10);
-			drlg_l1_crypt_pattern6(15);
-			drlg_l1_crypt_pattern5(30);
-			drlg_l1_crypt_pattern2(30);
-			drlg_l1_crypt_pattern3(20);
-			drlg_l1_crypt_pattern4(15);
-			drlg_l1_crypt_lavafloor();
+			drlg_l1_crypt_pattern7(ctx, 10);
+			drlg_l1_crypt_pattern6(ctx, 15);
+			drlg_l1_crypt_pattern5(ctx, 30);
+			drlg_l1_crypt_pattern2(ctx, 30);
+			drlg_l1_crypt_pattern3(ctx, 20);
+			drlg_l1_crypt_pattern4(ctx, 15);
+			drlg_l1_crypt_lavafloor(ctx);
 			break;
 		default:
-			drlg_l1_crypt_pattern7(10);
-			drlg_l1_crypt_pattern6(20);
-			drlg_l1_crypt_pattern5(30);
-			drlg_l1_crypt_pattern2(30);
-			drlg_l1_crypt_pattern3(20);
-			drlg_l1_crypt_pattern4(20);
-			drlg_l1_crypt_lavafloor();
+			drlg_l1_crypt_pattern7(ctx, 10);
+			drlg_l1_crypt_pattern6(ctx, 20);
+			drlg_l1_crypt_pattern5(ctx, 30);
+			drlg_l1_crypt_pattern2(ctx, 30);
+			drlg_l1_crypt_pattern3(ctx, 20);
+			drlg_l1_crypt_pattern4(ctx, 20);
+			drlg_l1_crypt_lavafloor(ctx);
 			break;
 		}
 	}
 
-	if (currlevel < 21) {
-		DRLG_L1Shadows();
-		DRLG_PlaceMiniSet(LAMPS, 5, 10, 0, 0, false, -1, 4);
-		DRLG_L1Floor();
+	if (ctx.currlevel < 21) {
+		DRLG_L1Shadows(ctx);
+		DRLG_PlaceMiniSet(ctx, LAMPS, 5, 10, 0, 0, false, -1, 4);
+		DRLG_L1Floor(ctx);
 	}
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			pdungeon[i][j] = dungeon[i][j];
+			ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 		}
 	}
 
-	DRLG_Init_Globals();
-	DRLG_CheckQuests(setpc_x, setpc_y);
+	DRLG_InitFlags(ctx);
+	DRLG_CheckQuests(ctx, ctx.setpc_x, ctx.setpc_y);
 }
 
-void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
+void CreateL5Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry)
 {
 	SetRndSeed(rseed);
 
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
-
-	UberRow = 0;
-	UberCol = 0;
-	IsUberRoomOpened = false;
-	UberLeverRow = 0;
-	UberLeverCol = 0;
-	IsUberLeverActivated = false;
-	UberDiabloMonsterIndex = 0;
-
-	DRLG_InitTrans();
-	DRLG_InitSetPC();
-	DRLG_LoadL1SP();
-	DRLG_L5(entry);
-	DRLG_L1Pass3();
-	DRLG_FreeL1SP();
-
-	if (currlevel < 17)
-		DRLG_InitL1Vals();
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
+
+	ctx.UberRow = 0;
+	ctx.UberCol = 0;
+	ctx.IsUberRoomOpened = false;
+	ctx.UberLeverRow = 0;
+	ctx.UberLeverCol = 0;
+	ctx.IsUberLeverActivated = false;
+	ctx.UberDiabloMonsterIndex = 0;
+
+	DRLG_InitTrans(ctx);
+	DRLG_InitSetPC(ctx);
+	DRLG_LoadL1SP(ctx);
+	DRLG_L5(ctx, entry);
+	DRLG_L1Pass3(ctx);
+	DRLG_FreeL1SP(ctx);
+
+	if (ctx.currlevel < 17)
+		DRLG_InitL1Vals(ctx);
 	else
-		DRLG_InitL5Vals();
+		DRLG_InitL5Vals(ctx);
 
-	DRLG_SetPC();
+	DRLG_SetPC(ctx);
 
+	for (int j = ctx.dminy; j < ctx.dmaxy; j++) {
+		for (int i = ctx.dminx; i < ctx.dmaxx; i++) {
+			if (ctx.dPiece[i][j] == 290) {
+				ctx.UberRow = i;
+				ctx.UberCol = j;
+			}
+		}
+	}
+}
+
+void InitL5CornerStone()
+{
 	for (int j = dminy; j < dmaxy; j++) {
 		for (int i = dminx; i < dmaxx; i++) {
-			if (dPiece[i][j] == 290) {
-				UberRow = i;
-				UberCol = j;
-			}
 			if (dPiece[i][j] == 317) {
 				CornerStone.position = { i, j };
 			}
@@ -2747,127 +2734,127 @@ void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
 	}
 }
 
-void drlg_l1_crypt_pattern1(int rndper)
+void drlg_l1_crypt_pattern1(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A3C8, rndper);
-	drlg_l1_crypt_rndset(byte_48A3CC, rndper);
-	drlg_l1_crypt_rndset(byte_48A3D0, rndper);
-	drlg_l1_crypt_rndset(byte_48A3D4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3C8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3CC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3D0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3D4, rndper);
 }
 
-void drlg_l1_crypt_pattern2(int rndper)
+void drlg_l1_crypt_pattern2(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A2FC, rndper);
-	drlg_l1_crypt_rndset(byte_48A300, rndper);
-	drlg_l1_crypt_rndset(byte_48A304, rndper);
-	drlg_l1_crypt_rndset(byte_48A308, rndper);
-	drlg_l1_crypt_rndset(byte_48A30C, rndper);
-	drlg_l1_crypt_rndset(byte_48A310, rndper);
-	drlg_l1_crypt_rndset(byte_48A314, rndper);
-	drlg_l1_crypt_rndset(byte_48A318, rndper);
-	drlg_l1_crypt_rndset(byte_48A31C, rndper);
-	drlg_l1_crypt_rndset(byte_48A320, rndper);
-	drlg_l1_crypt_rndset(byte_48A324, rndper);
-	drlg_l1_crypt_rndset(byte_48A328, rndper);
-	drlg_l1_crypt_rndset(byte_48A32C, rndper);
-	drlg_l1_crypt_rndset(byte_48A330, rndper);
-	drlg_l1_crypt_rndset(byte_48A334, rndper);
-	drlg_l1_crypt_rndset(byte_48A338, rndper);
-	drlg_l1_crypt_rndset(byte_48A33C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2FC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A300, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A304, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A308, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A30C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A310, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A314, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A318, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A31C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A320, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A324, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A328, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A32C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A330, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A334, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A338, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A33C, rndper);
 }
 
-void drlg_l1_crypt_pattern3(int rndper)
+void drlg_l1_crypt_pattern3(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A340, rndper);
-	drlg_l1_crypt_rndset(byte_48A344, rndper);
-	drlg_l1_crypt_rndset(byte_48A348, rndper);
-	drlg_l1_crypt_rndset(byte_48A34C, rndper);
-	drlg_l1_crypt_rndset(byte_48A350, rndper);
-	drlg_l1_crypt_rndset(byte_48A354, rndper);
-	drlg_l1_crypt_rndset(byte_48A358, rndper);
-	drlg_l1_crypt_rndset(byte_48A35C, rndper);
-	drlg_l1_crypt_rndset(byte_48A360, rndper);
-	drlg_l1_crypt_rndset(byte_48A364, rndper);
-	drlg_l1_crypt_rndset(byte_48A368, rndper);
-	drlg_l1_crypt_rndset(byte_48A36C, rndper);
-	drlg_l1_crypt_rndset(byte_48A370, rndper);
-	drlg_l1_crypt_rndset(byte_48A374, rndper);
-	drlg_l1_crypt_rndset(byte_48A378, rndper);
-	drlg_l1_crypt_rndset(byte_48A37C, rndper);
-	drlg_l1_crypt_rndset(byte_48A380, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A340, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A344, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A348, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A34C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A350, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A354, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A358, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A35C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A360, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A364, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A368, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A36C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A370, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A374, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A378, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A37C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A380, rndper);
 }
 
-void drlg_l1_crypt_pattern4(int rndper)
+void drlg_l1_crypt_pattern4(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A384, rndper);
-	drlg_l1_crypt_rndset(byte_48A388, rndper);
-	drlg_l1_crypt_rndset(byte_48A38C, rndper);
-	drlg_l1_crypt_rndset(byte_48A390, rndper);
-	drlg_l1_crypt_rndset(byte_48A394, rndper);
-	drlg_l1_crypt_rndset(byte_48A398, rndper);
-	drlg_l1_crypt_rndset(byte_48A39C, rndper);
-	drlg_l1_crypt_rndset(byte_48A3A0, rndper);
-	drlg_l1_crypt_rndset(byte_48A3A4, rndper);
-	drlg_l1_crypt_rndset(byte_48A3A8, rndper);
-	drlg_l1_crypt_rndset(byte_48A3AC, rndper);
-	drlg_l1_crypt_rndset(byte_48A3B0, rndper);
-	drlg_l1_crypt_rndset(byte_48A3B4, rndper);
-	drlg_l1_crypt_rndset(byte_48A3B8, rndper);
-	drlg_l1_crypt_rndset(byte_48A3BC, rndper);
-	drlg_l1_crypt_rndset(byte_48A3C0, rndper);
-	drlg_l1_crypt_rndset(byte_48A3C4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A384, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A388, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A38C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A390, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A394, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A398, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A39C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3A0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3A4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3A8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3AC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3B0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3B4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3B8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3BC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3C0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A3C4, rndper);
 }
 
-void drlg_l1_crypt_pattern5(int rndper)
+void drlg_l1_crypt_pattern5(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A260, rndper);
-	drlg_l1_crypt_rndset(byte_48A278, rndper);
-	drlg_l1_crypt_rndset(byte_48A290, rndper);
-	drlg_l1_crypt_rndset(byte_48A2A8, rndper);
-	drlg_l1_crypt_rndset(byte_48A2C0, rndper);
-	drlg_l1_crypt_rndset(byte_48A2D8, rndper);
-	drlg_l1_crypt_rndset(byte_48A2EC, rndper);
-	drlg_l1_crypt_rndset(byte_48A2F0, rndper);
-	drlg_l1_crypt_rndset(byte_48A2F4, rndper);
-	drlg_l1_crypt_rndset(byte_48A2F8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A260, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A278, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A290, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2A8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2C0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2D8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2EC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2F0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2F4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A2F8, rndper);
 }
 
-void drlg_l1_crypt_pattern6(int rndper)
+void drlg_l1_crypt_pattern6(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A1F4, rndper);
-	drlg_l1_crypt_rndset(byte_48A1FC, rndper);
-	drlg_l1_crypt_rndset(byte_48A1F8, rndper);
-	drlg_l1_crypt_rndset(byte_48A200, rndper);
-	drlg_l1_crypt_rndset(byte_48A204, rndper);
-	drlg_l1_crypt_rndset(byte_48A208, rndper);
-	drlg_l1_crypt_rndset(byte_48A20C, rndper);
-	drlg_l1_crypt_rndset(byte_48A210, rndper);
-	drlg_l1_crypt_rndset(byte_48A214, rndper);
-	drlg_l1_crypt_rndset(byte_48A218, rndper);
-	drlg_l1_crypt_rndset(byte_48A21C, rndper);
-	drlg_l1_crypt_rndset(byte_48A220, rndper);
-	drlg_l1_crypt_rndset(byte_48A224, rndper);
-	drlg_l1_crypt_rndset(byte_48A228, rndper);
-	drlg_l1_crypt_rndset(byte_48A22C, rndper);
-	drlg_l1_crypt_rndset(byte_48A230, rndper);
-	drlg_l1_crypt_rndset(byte_48A234, rndper);
-	drlg_l1_crypt_rndset(byte_48A238, rndper);
-	drlg_l1_crypt_rndset(byte_48A23C, rndper);
-	drlg_l1_crypt_rndset(byte_48A240, rndper);
-	drlg_l1_crypt_rndset(byte_48A244, rndper);
-	drlg_l1_crypt_rndset(byte_48A248, rndper);
-	drlg_l1_crypt_rndset(byte_48A24C, rndper);
-	drlg_l1_crypt_rndset(byte_48A250, rndper);
-	drlg_l1_crypt_rndset(byte_48A254, rndper);
-	drlg_l1_crypt_rndset(byte_48A258, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1F4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1FC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1F8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A200, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A204, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A208, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A20C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A210, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A214, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A218, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A21C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A220, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A224, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A228, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A22C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A230, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A234, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A238, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A23C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A240, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A244, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A248, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A24C, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A250, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A254, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A258, rndper);
 }
 
-void drlg_l1_crypt_pattern7(int rndper)
+void drlg_l1_crypt_pattern7(DungeonContext &ctx, int rndper)
 {
-	drlg_l1_crypt_rndset(byte_48A1D0, rndper);
-	drlg_l1_crypt_rndset(byte_48A1D4, rndper);
-	drlg_l1_crypt_rndset(byte_48A1D8, rndper);
-	drlg_l1_crypt_rndset(byte_48A1DC, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1D0, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1D4, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1D8, rndper);
+	drlg_l1_crypt_rndset(ctx, byte_48A1DC, rndper);
 }
 
 } // namespace devilution
@@ -11,27 +11,39 @@ namespace devilution {
 
 #define WALL_CHANCE 100
 
-extern int UberRow;
-extern int UberCol;
-extern bool IsUberRoomOpened;
-extern int UberLeverRow;
-extern int UberLeverCol;
-extern bool IsUberLeverActivated;
-extern int UberDiabloMonsterIndex;
+extern int &UberRow;
+extern int &UberCol;
+extern bool &IsUberRoomOpened;
+extern int &UberLeverRow;
+extern int &UberLeverCol;
+extern bool &IsUberLeverActivated;
+extern int &UberDiabloMonsterIndex;
 
-void DRLG_LPass3(int lv);
+void DRLG_LPass3(DungeonContext &ctx, int lv);
+/**
+ * @brief Clear the entity and lighting maps of the active level before a new one is built
+ */
 void DRLG_Init_Globals();
-void LoadL1Dungeon(const char *path, int vx, int vy);
-void LoadPreL1Dungeon(const char *sFileName);
-void CreateL5Dungeon(uint32_t rseed, lvl_entry entry);
-void drlg_l1_set_crypt_room(int rx1, int ry1);
-void drlg_l1_set_corner_room(int rx1, int ry1);
-void drlg_l1_crypt_pattern1(int rndper);
-void drlg_l1_crypt_pattern2(int rndper);
-void drlg_l1_crypt_pattern3(int rndper);
-void drlg_l1_crypt_pattern4(int rndper);
-void drlg_l1_crypt_pattern5(int rndper);
-void drlg_l1_crypt_pattern6(int rndper);
-void drlg_l1_crypt_pattern7(int rndper);
+void LoadL1Dungeon(DungeonContext &ctx, const char *path, int vx, int vy);
+void LoadPreL1Dungeon(DungeonContext &ctx, const char *sFileName);
+/**
+ * @brief Generate a Cathedral or Crypt level into the given context
+ *
+ * Call DRLG_Init_Globals before and InitL5CornerStone after when building the active level.
+ */
+void CreateL5Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry);
+/**
+ * @brief Place the Cornerstone of the World on the active Crypt level
+ */
+void InitL5CornerStone();
+void drlg_l1_set_crypt_room(DungeonContext &ctx, int rx1, int ry1);
+void drlg_l1_set_corner_room(DungeonContext &ctx, int rx1, int ry1);
+void drlg_l1_crypt_pattern1(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern2(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern3(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern4(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern5(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern6(DungeonContext &ctx, int rndper);
+void drlg_l1_crypt_pattern7(DungeonContext &ctx, int rndper);
 
 } // namespace devilution
@@ -18,18 +18,8 @@
 
 namespace devilution {
 
-BYTE predungeon[DMAXX][DMAXY];
-
 namespace {
 
-int nSx1;
-int nSy1;
-int nSx2;
-int nSy2;
-int nRoomCnt;
-ROOMNODE RoomList[81];
-std::list<HALLNODE> HallList;
-
 int Area_Min = 2;
 int Room_Max = 10;
 int Room_Min = 4;
@@ -1611,7 +1601,7 @@ int Patterns[100][10] = {
 
 } // namespace
 
-static bool DRLG_L2PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
+static bool DRLG_L2PlaceMiniSet(DungeonContext &ctx, const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
 {
 	int sx, sy, sw, sh, xx, yy, i, ii, numt, bailcnt;
 	bool found;
@@ -1631,7 +1621,7 @@ static bool DRLG_L2PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 		found = false;
 		for (bailcnt = 0; !found && bailcnt < 200; bailcnt++) {
 			found = true;
-			if (sx >= nSx1 && sx <= nSx2 && sy >= nSy1 && sy <= nSy2) {
+			if (sx >= ctx.nSx1 && sx <= ctx.nSx2 && sy >= ctx.nSy1 && sy <= ctx.nSy2) {
 				found = false;
 			}
 			if (cx != -1 && sx >= cx - sw && sx <= cx + 12) {
@@ -1647,10 +1637,10 @@ static bool DRLG_L2PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 			ii = 2;
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1674,7 +1664,7 @@ static bool DRLG_L2PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 		for (yy = 0; yy < sh; yy++) {
 			for (xx = 0; xx < sw; xx++) {
 				if (miniset[ii] != 0) {
-					dungeon[xx + sx][yy + sy] = miniset[ii];
+					ctx.dungeon[xx + sx][yy + sy] = miniset[ii];
 				}
 				ii++;
 			}
@@ -1682,22 +1672,22 @@ static bool DRLG_L2PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 	}
 
 	if (setview) {
-		ViewX = 2 * sx + 21;
-		ViewY = 2 * sy + 22;
+		ctx.ViewX = 2 * sx + 21;
+		ctx.ViewY = 2 * sy + 22;
 	}
 	if (ldir == 0) {
-		LvlViewX = 2 * sx + 21;
-		LvlViewY = 2 * sy + 22;
+		ctx.LvlViewX = 2 * sx + 21;
+		ctx.LvlViewY = 2 * sy + 22;
 	}
 	if (ldir == 6) {
-		LvlViewX = 2 * sx + 21;
-		LvlViewY = 2 * sy + 22;
+		ctx.LvlViewX = 2 * sx + 21;
+		ctx.LvlViewY = 2 * sy + 22;
 	}
 
 	return true;
 }
 
-static void DRLG_L2PlaceRndSet(const BYTE *miniset, int rndper)
+static void DRLG_L2PlaceRndSet(DungeonContext &ctx, const BYTE *miniset, int rndper)
 {
 	int sx, sy, sw, sh, xx, yy, ii, kk;
 	bool found;
@@ -1709,15 +1699,15 @@ static void DRLG_L2PlaceRndSet(const BYTE *miniset, int rndper)
 		for (sx = 0; sx < DMAXX - sw; sx++) {
 			found = true;
 			ii = 2;
-			if (sx >= nSx1 && sx <= nSx2 && sy >= nSy1 && sy <= nSy2) {
+			if (sx >= ctx.nSx1 && sx <= ctx.nSx2 && sy >= ctx.nSy1 && sy <= ctx.nSy2) {
 				found = false;
 			}
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1728,7 +1718,7 @@ static void DRLG_L2PlaceRndSet(const BYTE *miniset, int rndper)
 				for (yy = std::max(sy - sh, 0); yy < std::min(sy + 2 * sh, DMAXY) && found; yy++) {
 					for (xx = std::max(sx - sw, 0); xx < std::min(sx + 2 * sw, DMAXX); xx++) {
 						// BUGFIX: yy and xx can go out of bounds (fixed)
-						if (dungeon[xx][yy] == miniset[kk]) {
+						if (ctx.dungeon[xx][yy] == miniset[kk]) {
 							found = false;
 						}
 					}
@@ -1738,7 +1728,7 @@ static void DRLG_L2PlaceRndSet(const BYTE *miniset, int rndper)
 				for (yy = 0; yy < sh; yy++) {
 					for (xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							ctx.dungeon[xx + sx][yy + sy] = miniset[kk];
 						}
 						kk++;
 					}
@@ -1748,15 +1738,15 @@ static void DRLG_L2PlaceRndSet(const BYTE *miniset, int rndper)
 	}
 }
 
-static void DRLG_L2Subs()
+static void DRLG_L2Subs(DungeonContext &ctx)
 {
 	int x, y, i, j, k, rv;
 	BYTE c;
 
 	for (y = 0; y < DMAXY; y++) {
 		for (x = 0; x < DMAXX; x++) {
-			if ((x < nSx1 || x > nSx2) && (y < nSy1 || y > nSy2) && GenerateRnd(4) == 0) {
-				c = BTYPESL2[dungeon[x][y]];
+			if ((x < ctx.nSx1 || x > ctx.nSx2) && (y < ctx.nSy1 || y > ctx.nSy2) && GenerateRnd(4) == 0) {
+				c = BTYPESL2[ctx.dungeon[x][y]];
 				if (c != 0) {
 					rv = GenerateRnd(16);
 					k = -1;
@@ -1771,14 +1761,14 @@ static void DRLG_L2Subs()
 					}
 					for (j = y - 2; j < y + 2; j++) {
 						for (i = x - 2; i < x + 2; i++) {
-							if (dungeon[i][j] == k) {
+							if (ctx.dungeon[i][j] == k) {
 								j = y + 3;
 								i = x + 2;
 							}
 						}
 					}
 					if (j < y + 3) {
-						dungeon[x][y] = k;
+						ctx.dungeon[x][y] = k;
 					}
 				}
 			}
@@ -1786,7 +1776,7 @@ static void DRLG_L2Subs()
 	}
 }
 
-static void DRLG_L2Shadows()
+static void DRLG_L2Shadows(DungeonContext &ctx)
 {
 	int x, y, i;
 	bool patflag;
@@ -1794,10 +1784,10 @@ static void DRLG_L2Shadows()
 
 	for (y = 1; y < DMAXY; y++) {
 		for (x = 1; x < DMAXX; x++) {
-			sd[0][0] = BSTYPESL2[dungeon[x][y]];
-			sd[1][0] = BSTYPESL2[dungeon[x - 1][y]];
-			sd[0][1] = BSTYPESL2[dungeon[x][y - 1]];
-			sd[1][1] = BSTYPESL2[dungeon[x - 1][y - 1]];
+			sd[0][0] = BSTYPESL2[ctx.dungeon[x][y]];
+			sd[1][0] = BSTYPESL2[ctx.dungeon[x - 1][y]];
+			sd[0][1] = BSTYPESL2[ctx.dungeon[x][y - 1]];
+			sd[1][1] = BSTYPESL2[ctx.dungeon[x - 1][y - 1]];
 			for (i = 0; i < 2; i++) {
 				if (SPATSL2[i].strig == sd[0][0]) {
 					patflag = true;
@@ -1812,13 +1802,13 @@ static void DRLG_L2Shadows()
 					}
 					if (patflag) {
 						if (SPATSL2[i].nv1 != 0) {
-							dungeon[x - 1][y - 1] = SPATSL2[i].nv1;
+							ctx.dungeon[x - 1][y - 1] = SPATSL2[i].nv1;
 						}
 						if (SPATSL2[i].nv2 != 0) {
-							dungeon[x][y - 1] = SPATSL2[i].nv2;
+							ctx.dungeon[x][y - 1] = SPATSL2[i].nv2;
 						}
 						if (SPATSL2[i].nv3 != 0) {
-							dungeon[x - 1][y] = SPATSL2[i].nv3;
+							ctx.dungeon[x - 1][y] = SPATSL2[i].nv3;
 						}
 					}
 				}
@@ -1827,129 +1817,129 @@ static void DRLG_L2Shadows()
 	}
 }
 
-void InitDungeon()
+void InitDungeon(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			predungeon[i][j] = 32;
-			dflags[i][j] = 0;
+			ctx.predungeon[i][j] = 32;
+			ctx.dflags[i][j] = 0;
 		}
 	}
 }
 
-static void DRLG_LoadL2SP()
+static void DRLG_LoadL2SP(DungeonContext &ctx)
 {
-	setloadflag = false;
-
-	if (QuestStatus(Q_BLIND)) {
-		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blind1.DUN");
-		pSetPiece[13] = SDL_SwapLE16(154);  // Close outer wall
-		pSetPiece[100] = SDL_SwapLE16(154); // Close outer wall
-		setloadflag = true;
-	} else if (QuestStatus(Q_BLOOD)) {
-		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blood1.DUN");
-		setloadflag = true;
-	} else if (QuestStatus(Q_SCHAMB)) {
-		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Bonestr2.DUN");
-		setloadflag = true;
+	ctx.setloadflag = false;
+
+	if (QuestStatus(Q_BLIND, ctx.currlevel)) {
+		ctx.pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blind1.DUN");
+		ctx.pSetPiece[13] = SDL_SwapLE16(154);  // Close outer wall
+		ctx.pSetPiece[100] = SDL_SwapLE16(154); // Close outer wall
+		ctx.setloadflag = true;
+	} else if (QuestStatus(Q_BLOOD, ctx.currlevel)) {
+		ctx.pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blood1.DUN");
+		ctx.setloadflag = true;
+	} else if (QuestStatus(Q_SCHAMB, ctx.currlevel)) {
+		ctx.pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Bonestr2.DUN");
+		ctx.setloadflag = true;
 	}
 }
 
-static void DRLG_FreeL2SP()
+static void DRLG_FreeL2SP(DungeonContext &ctx)
 {
-	pSetPiece = nullptr;
+	ctx.pSetPiece = nullptr;
 }
 
-static void DRLG_L2SetRoom(int rx1, int ry1)
+static void DRLG_L2SetRoom(DungeonContext &ctx, int rx1, int ry1)
 {
-	int width = SDL_SwapLE16(pSetPiece[0]);
-	int height = SDL_SwapLE16(pSetPiece[1]);
+	int width = SDL_SwapLE16(ctx.pSetPiece[0]);
+	int height = SDL_SwapLE16(ctx.pSetPiece[1]);
 
-	setpc_x = rx1;
-	setpc_y = ry1;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = rx1;
+	ctx.setpc_y = ry1;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
-	uint16_t *tileLayer = &pSetPiece[2];
+	uint16_t *tileLayer = &ctx.pSetPiece[2];
 
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				dungeon[i + rx1][j + ry1] = tileId;
-				dflags[i + rx1][j + ry1] |= DLRG_PROTECTED;
+				ctx.dungeon[i + rx1][j + ry1] = tileId;
+				ctx.dflags[i + rx1][j + ry1] |= DLRG_PROTECTED;
 			} else {
-				dungeon[i + rx1][j + ry1] = 3;
+				ctx.dungeon[i + rx1][j + ry1] = 3;
 			}
 		}
 	}
 }
 
-static void DefineRoom(int nX1, int nY1, int nX2, int nY2, bool ForceHW)
+static void DefineRoom(DungeonContext &ctx, int nX1, int nY1, int nX2, int nY2, bool ForceHW)
 {
 	int i, j;
 
-	predungeon[nX1][nY1] = 67;
-	predungeon[nX1][nY2] = 69;
-	predungeon[nX2][nY1] = 66;
-	predungeon[nX2][nY2] = 65;
+	ctx.predungeon[nX1][nY1] = 67;
+	ctx.predungeon[nX1][nY2] = 69;
+	ctx.predungeon[nX2][nY1] = 66;
+	ctx.predungeon[nX2][nY2] = 65;
 
-	nRoomCnt++;
-	RoomList[nRoomCnt].nRoomx1 = nX1;
-	RoomList[nRoomCnt].nRoomx2 = nX2;
-	RoomList[nRoomCnt].nRoomy1 = nY1;
-	RoomList[nRoomCnt].nRoomy2 = nY2;
+	ctx.nRoomCnt++;
+	ctx.RoomList[ctx.nRoomCnt].nRoomx1 = nX1;
+	ctx.RoomList[ctx.nRoomCnt].nRoomx2 = nX2;
+	ctx.RoomList[ctx.nRoomCnt].nRoomy1 = nY1;
+	ctx.RoomList[ctx.nRoomCnt].nRoomy2 = nY2;
 
 	if (ForceHW) {
 		for (i = nX1; i < nX2; i++) {
 			/// BUGFIX: Should loop j between nY1 and nY2 instead of always using nY1.
 			while (i < nY2) {
-				dflags[i][nY1] |= DLRG_PROTECTED;
+				ctx.dflags[i][nY1] |= DLRG_PROTECTED;
 				i++;
 			}
 		}
 	}
 	for (i = nX1 + 1; i <= nX2 - 1; i++) {
-		predungeon[i][nY1] = 35;
-		predungeon[i][nY2] = 35;
+		ctx.predungeon[i][nY1] = 35;
+		ctx.predungeon[i][nY2] = 35;
 	}
 	nY2--;
 	for (j = nY1 + 1; j <= nY2; j++) {
-		predungeon[nX1][j] = 35;
-		predungeon[nX2][j] = 35;
+		ctx.predungeon[nX1][j] = 35;
+		ctx.predungeon[nX2][j] = 35;
 		for (i = nX1 + 1; i < nX2; i++) {
-			predungeon[i][j] = 46;
+			ctx.predungeon[i][j] = 46;
 		}
 	}
 }
 
-static void CreateDoorType(int nX, int nY)
+static void CreateDoorType(DungeonContext &ctx, int nX, int nY)
 {
-	if (predungeon[nX - 1][nY] == 68) {
+	if (ctx.predungeon[nX - 1][nY] == 68) {
 		return;
 	}
-	if (predungeon[nX + 1][nY] == 68) {
+	if (ctx.predungeon[nX + 1][nY] == 68) {
 		return;
 	}
-	if (predungeon[nX][nY - 1] == 68) {
+	if (ctx.predungeon[nX][nY - 1] == 68) {
 		return;
 	}
-	if (predungeon[nX][nY + 1] == 68) {
+	if (ctx.predungeon[nX][nY + 1] == 68) {
 		return;
 	}
-	if (predungeon[nX][nY] == 66 || predungeon[nX][nY] == 67 || predungeon[nX][nY] == 65 || predungeon[nX][nY] == 69) {
+	if (ctx.predungeon[nX][nY] == 66 || ctx.predungeon[nX][nY] == 67 || ctx.predungeon[nX][nY] == 65 || ctx.predungeon[nX][nY] == 69) {
 		return;
 	}
 
-	predungeon[nX][nY] = 68;
+	ctx.predungeon[nX][nY] = 68;
 }
 
-static void PlaceHallExt(int nX, int nY)
+static void PlaceHallExt(DungeonContext &ctx, int nX, int nY)
 {
-	if (predungeon[nX][nY] == 32) {
-		predungeon[nX][nY] = 44;
+	if (ctx.predungeon[nX][nY] == 32) {
+		ctx.predungeon[nX][nY] = 44;
 	}
 }
 
@@ -1965,11 +1955,11 @@ static void PlaceHallExt(int nX, int nY)
  * @param nH Height of the room, if ForceHW is set.
  * @param nW Width of the room, if ForceHW is set.
  */
-static void CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool ForceHW, int nH, int nW)
+static void CreateRoom(DungeonContext &ctx, int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool ForceHW, int nH, int nW)
 {
 	int nAw, nAh, nRw, nRh, nRx1, nRy1, nRx2, nRy2, nHw, nHh, nHx1, nHy1, nHx2, nHy2, nRid;
 
-	if (nRoomCnt >= 80) {
+	if (ctx.nRoomCnt >= 80) {
 		return;
 	}
 
@@ -2036,64 +2026,64 @@ static void CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir
 	if (nRy2 <= 1) {
 		nRy2 = 1;
 	}
-	DefineRoom(nRx1, nRy1, nRx2, nRy2, ForceHW);
+	DefineRoom(ctx, nRx1, nRy1, nRx2, nRy2, ForceHW);
 
 	if (ForceHW) {
-		nSx1 = nRx1 + 2;
-		nSy1 = nRy1 + 2;
-		nSx2 = nRx2;
-		nSy2 = nRy2;
+		ctx.nSx1 = nRx1 + 2;
+		ctx.nSy1 = nRy1 + 2;
+		ctx.nSx2 = nRx2;
+		ctx.nSy2 = nRy2;
 	}
 
-	nRid = nRoomCnt;
-	RoomList[nRid].nRoomDest = nRDest;
+	nRid = ctx.nRoomCnt;
+	ctx.RoomList[nRid].nRoomDest = nRDest;
 
 	if (nRDest != 0) {
 		if (nHDir == 1) {
 			nHx1 = GenerateRnd(nRx2 - nRx1 - 2) + nRx1 + 1;
 			nHy1 = nRy1;
-			nHw = RoomList[nRDest].nRoomx2 - RoomList[nRDest].nRoomx1 - 2;
-			nHx2 = GenerateRnd(nHw) + RoomList[nRDest].nRoomx1 + 1;
-			nHy2 = RoomList[nRDest].nRoomy2;
+			nHw = ctx.RoomList[nRDest].nRoomx2 - ctx.RoomList[nRDest].nRoomx1 - 2;
+			nHx2 = GenerateRnd(nHw) + ctx.RoomList[nRDest].nRoomx1 + 1;
+			nHy2 = ctx.RoomList[nRDest].nRoomy2;
 		}
 		if (nHDir == 3) {
 			nHx1 = GenerateRnd(nRx2 - nRx1 - 2) + nRx1 + 1;
 			nHy1 = nRy2;
-			nHw = RoomList[nRDest].nRoomx2 - RoomList[nRDest].nRoomx1 - 2;
-			nHx2 = GenerateRnd(nHw) + RoomList[nRDest].nRoomx1 + 1;
-			nHy2 = RoomList[nRDest].nRoomy1;
+			nHw = ctx.RoomList[nRDest].nRoomx2 - ctx.RoomList[nRDest].nRoomx1 - 2;
+			nHx2 = GenerateRnd(nHw) + ctx.RoomList[nRDest].nRoomx1 + 1;
+			nHy2 = ctx.RoomList[nRDest].nRoomy1;
 		}
 		if (nHDir == 2) {
 			nHx1 = nRx2;
 			nHy1 = GenerateRnd(nRy2 - nRy1 - 2) + nRy1 + 1;
-			nHx2 = RoomList[nRDest].nRoomx1;
-			nHh = RoomList[nRDest].nRoomy2 - RoomList[nRDest].nRoomy1 - 2;
-			nHy2 = GenerateRnd(nHh) + RoomList[nRDest].nRoomy1 + 1;
+			nHx2 = ctx.RoomList[nRDest].nRoomx1;
+			nHh = ctx.RoomList[nRDest].nRoomy2 - ctx.RoomList[nRDest].nRoomy1 - 2;
+			nHy2 = GenerateRnd(nHh) + ctx.RoomList[nRDest].nRoomy1 + 1;
 		}
 		if (nHDir == 4) {
 			nHx1 = nRx1;
 			nHy1 = GenerateRnd(nRy2 - nRy1 - 2) + nRy1 + 1;
-			nHx2 = RoomList[nRDest].nRoomx2;
-			nHh = RoomList[nRDest].nRoomy2 - RoomList[nRDest].nRoomy1 - 2;
-			nHy2 = GenerateRnd(nHh) + RoomList[nRDest].nRoomy1 + 1;
+			nHx2 = ctx.RoomList[nRDest].nRoomx2;
+			nHh = ctx.RoomList[nRDest].nRoomy2 - ctx.RoomList[nRDest].nRoomy1 - 2;
+			nHy2 = GenerateRnd(nHh) + ctx.RoomList[nRDest].nRoomy1 + 1;
 		}
-		HallList.push_back({ nHx1, nHy1, nHx2, nHy2, nHDir });
+		ctx.HallList.push_back({ nHx1, nHy1, nHx2, nHy2, nHDir });
 	}
 
 	if (nRh > nRw) {
-		CreateRoom(nX1 + 2, nY1 + 2, nRx1 - 2, nRy2 - 2, nRid, 2, false, 0, 0);
-		CreateRoom(nRx2 + 2, nRy1 + 2, nX2 - 2, nY2 - 2, nRid, 4, false, 0, 0);
-		CreateRoom(nX1 + 2, nRy2 + 2, nRx2 - 2, nY2 - 2, nRid, 1, false, 0, 0);
-		CreateRoom(nRx1 + 2, nY1 + 2, nX2 - 2, nRy1 - 2, nRid, 3, false, 0, 0);
+		CreateRoom(ctx, nX1 + 2, nY1 + 2, nRx1 - 2, nRy2 - 2, nRid, 2, false, 0, 0);
+		CreateRoom(ctx, nRx2 + 2, nRy1 + 2, nX2 - 2, nY2 - 2, nRid, 4, false, 0, 0);
+		CreateRoom(ctx, nX1 + 2, nRy2 + 2, nRx2 - 2, nY2 - 2, nRid, 1, false, 0, 0);
+		CreateRoom(ctx, nRx1 + 2, nY1 + 2, nX2 - 2, nRy1 - 2, nRid, 3, false, 0, 0);
 	} else {
-		CreateRoom(nX1 + 2, nY1 + 2, nRx2 - 2, nRy1 - 2, nRid, 3, false, 0, 0);
-		CreateRoom(nRx1 + 2, nRy2 + 2, nX2 - 2, nY2 - 2, nRid, 1, false, 0, 0);
-		CreateRoom(nX1 + 2, nRy1 + 2, nRx1 - 2, nY2 - 2, nRid, 2, false, 0, 0);
-		CreateRoom(nRx2 + 2, nY1 + 2, nX2 - 2, nRy2 - 2, nRid, 4, false, 0, 0);
+		CreateRoom(ctx, nX1 + 2, nY1 + 2, nRx2 - 2, nRy1 - 2, nRid, 3, false, 0, 0);
+		CreateRoom(ctx, nRx1 + 2, nRy2 + 2, nX2 - 2, nY2 - 2, nRid, 1, false, 0, 0);
+		CreateRoom(ctx, nX1 + 2, nRy1 + 2, nRx1 - 2, nY2 - 2, nRid, 2, false, 0, 0);
+		CreateRoom(ctx, nRx2 + 2, nY1 + 2, nX2 - 2, nRy2 - 2, nRid, 4, false, 0, 0);
 	}
 }
 
-static void ConnectHall(const HALLNODE &node)
+static void ConnectHall(DungeonContext &ctx, const HALLNODE &node)
 {
 	int nCurrd, nDx, nDy, nRp, nOrigX1, nOrigY1, fMinusFlag, fPlusFlag;
 	bool fDoneflag, fInroom;
@@ -2109,12 +2099,12 @@ static void ConnectHall(const HALLNODE &node)
 	fPlusFlag = GenerateRnd(100);
 	nOrigX1 = nX1;
 	nOrigY1 = nY1;
-	CreateDoorType(nX1, nY1);
-	CreateDoorType(nX2, nY2);
+	CreateDoorType(ctx, nX1, nY1);
+	CreateDoorType(ctx, nX2, nY2);
 	nCurrd = nHd;
 	nX2 -= Dir_Xadd[nCurrd];
 	nY2 -= Dir_Yadd[nCurrd];
-	predungeon[nX2][nY2] = 44;
+	ctx.predungeon[nX2][nY2] = 44;
 	fInroom = false;
 
 	while (!fDoneflag) {
@@ -2130,46 +2120,46 @@ static void ConnectHall(const HALLNODE &node)
 		if (nY1 <= 1 && nCurrd == 1) {
 			nCurrd = 3;
 		}
-		if (predungeon[nX1][nY1] == 67 && (nCurrd == 1 || nCurrd == 4)) {
+		if (ctx.predungeon[nX1][nY1] == 67 && (nCurrd == 1 || nCurrd == 4)) {
 			nCurrd = 2;
 		}
-		if (predungeon[nX1][nY1] == 66 && (nCurrd == 1 || nCurrd == 2)) {
+		if (ctx.predungeon[nX1][nY1] == 66 && (nCurrd == 1 || nCurrd == 2)) {
 			nCurrd = 3;
 		}
-		if (predungeon[nX1][nY1] == 69 && (nCurrd == 4 || nCurrd == 3)) {
+		if (ctx.predungeon[nX1][nY1] == 69 && (nCurrd == 4 || nCurrd == 3)) {
 			nCurrd = 1;
 		}
-		if (predungeon[nX1][nY1] == 65 && (nCurrd == 2 || nCurrd == 3)) {
+		if (ctx.predungeon[nX1][nY1] == 65 && (nCurrd == 2 || nCurrd == 3)) {
 			nCurrd = 4;
 		}
 		nX1 += Dir_Xadd[nCurrd];
 		nY1 += Dir_Yadd[nCurrd];
-		if (predungeon[nX1][nY1] == 32) {
+		if (ctx.predungeon[nX1][nY1] == 32) {
 			if (fInroom) {
-				CreateDoorType(nX1 - Dir_Xadd[nCurrd], nY1 - Dir_Yadd[nCurrd]);
+				CreateDoorType(ctx, nX1 - Dir_Xadd[nCurrd], nY1 - Dir_Yadd[nCurrd]);
 			} else {
 				if (fMinusFlag < 50) {
 					if (nCurrd != 1 && nCurrd != 3) {
-						PlaceHallExt(nX1, nY1 - 1);
+						PlaceHallExt(ctx, nX1, nY1 - 1);
 					} else {
-						PlaceHallExt(nX1 - 1, nY1);
+						PlaceHallExt(ctx, nX1 - 1, nY1);
 					}
 				}
 				if (fPlusFlag < 50) {
 					if (nCurrd != 1 && nCurrd != 3) {
-						PlaceHallExt(nX1, nY1 + 1);
+						PlaceHallExt(ctx, nX1, nY1 + 1);
 					} else {
-						PlaceHallExt(nX1 + 1, nY1);
+						PlaceHallExt(ctx, nX1 + 1, nY1);
 					}
 				}
 			}
-			predungeon[nX1][nY1] = 44;
+			ctx.predungeon[nX1][nY1] = 44;
 			fInroom = false;
 		} else {
-			if (!fInroom && predungeon[nX1][nY1] == 35) {
-				CreateDoorType(nX1, nY1);
+			if (!fInroom && ctx.predungeon[nX1][nY1] == 35) {
+				CreateDoorType(ctx, nX1, nY1);
 			}
-			if (predungeon[nX1][nY1] != 44) {
+			if (ctx.predungeon[nX1][nY1] != 44) {
 				fInroom = true;
 			}
 		}
@@ -2228,14 +2218,14 @@ static void ConnectHall(const HALLNODE &node)
 				nCurrd = 3;
 			}
 		}
-		if (nDx == 0 && predungeon[nX1][nY1] != 32 && (nCurrd == 2 || nCurrd == 4)) {
+		if (nDx == 0 && ctx.predungeon[nX1][nY1] != 32 && (nCurrd == 2 || nCurrd == 4)) {
 			if (nX2 <= nOrigX1 || nX1 >= DMAXX) {
 				nCurrd = 1;
 			} else {
 				nCurrd = 3;
 			}
 		}
-		if (nDy == 0 && predungeon[nX1][nY1] != 32 && (nCurrd == 1 || nCurrd == 3)) {
+		if (nDy == 0 && ctx.predungeon[nX1][nY1] != 32 && (nCurrd == 1 || nCurrd == 3)) {
 			if (nY2 <= nOrigY1 || nY1 >= DMAXY) {
 				nCurrd = 4;
 			} else {
@@ -2248,7 +2238,7 @@ static void ConnectHall(const HALLNODE &node)
 	}
 }
 
-static void DoPatternCheck(int i, int j)
+static void DoPatternCheck(DungeonContext &ctx, int i, int j)
 {
 	int k, l, x, y, nOk;
 
@@ -2268,42 +2258,42 @@ static void DoPatternCheck(int i, int j)
 					nOk = 254;
 					break;
 				case 1:
-					if (predungeon[x][y] == 35) {
+					if (ctx.predungeon[x][y] == 35) {
 						nOk = 254;
 					}
 					break;
 				case 2:
-					if (predungeon[x][y] == 46) {
+					if (ctx.predungeon[x][y] == 46) {
 						nOk = 254;
 					}
 					break;
 				case 4:
-					if (predungeon[x][y] == 32) {
+					if (ctx.predungeon[x][y] == 32) {
 						nOk = 254;
 					}
 					break;
 				case 3:
-					if (predungeon[x][y] == 68) {
+					if (ctx.predungeon[x][y] == 68) {
 						nOk = 254;
 					}
 					break;
 				case 5:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 46) {
+					if (ctx.predungeon[x][y] == 68 || ctx.predungeon[x][y] == 46) {
 						nOk = 254;
 					}
 					break;
 				case 6:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 35) {
+					if (ctx.predungeon[x][y] == 68 || ctx.predungeon[x][y] == 35) {
 						nOk = 254;
 					}
 					break;
 				case 7:
-					if (predungeon[x][y] == 32 || predungeon[x][y] == 46) {
+					if (ctx.predungeon[x][y] == 32 || ctx.predungeon[x][y] == 46) {
 						nOk = 254;
 					}
 					break;
 				case 8:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 35 || predungeon[x][y] == 46) {
+					if (ctx.predungeon[x][y] == 68 || ctx.predungeon[x][y] == 35 || ctx.predungeon[x][y] == 46) {
 						nOk = 254;
 					}
 					break;
@@ -2314,31 +2304,31 @@ static void DoPatternCheck(int i, int j)
 			x++;
 		}
 		if (nOk == 254) {
-			dungeon[i][j] = Patterns[k][9];
+			ctx.dungeon[i][j] = Patterns[k][9];
 		}
 	}
 }
 
-static void L2TileFix()
+static void L2TileFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 3) {
-				dungeon[i][j + 1] = 1;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 3) {
+				ctx.dungeon[i][j + 1] = 1;
 			}
-			if (dungeon[i][j] == 3 && dungeon[i][j + 1] == 1) {
-				dungeon[i][j + 1] = 3;
+			if (ctx.dungeon[i][j] == 3 && ctx.dungeon[i][j + 1] == 1) {
+				ctx.dungeon[i][j + 1] = 3;
 			}
-			if (dungeon[i][j] == 3 && dungeon[i + 1][j] == 7) {
-				dungeon[i + 1][j] = 3;
+			if (ctx.dungeon[i][j] == 3 && ctx.dungeon[i + 1][j] == 7) {
+				ctx.dungeon[i + 1][j] = 3;
 			}
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 3) {
-				dungeon[i + 1][j] = 2;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 3) {
+				ctx.dungeon[i + 1][j] = 2;
 			}
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 14) {
-				dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 14) {
+				ctx.dungeon[i + 1][j] = 16;
 			}
 		}
 	}
@@ -2359,14 +2349,14 @@ static bool DL2_Cont(bool x1f, bool y1f, bool x2f, bool y2f)
 	return false;
 }
 
-static int DL2_NumNoChar()
+static int DL2_NumNoChar(DungeonContext &ctx)
 {
 	int t, ii, jj;
 
 	t = 0;
 	for (jj = 0; jj < DMAXY; jj++) {
 		for (ii = 0; ii < DMAXX; ii++) {
-			if (predungeon[ii][jj] == 32) {
+			if (ctx.predungeon[ii][jj] == 32) {
 				t++;
 			}
 		}
@@ -2375,99 +2365,99 @@ static int DL2_NumNoChar()
 	return t;
 }
 
-static void DL2_DrawRoom(int x1, int y1, int x2, int y2)
+static void DL2_DrawRoom(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int ii, jj;
 
 	for (jj = y1; jj <= y2; jj++) {
 		for (ii = x1; ii <= x2; ii++) {
-			predungeon[ii][jj] = 46;
+			ctx.predungeon[ii][jj] = 46;
 		}
 	}
 	for (jj = y1; jj <= y2; jj++) {
-		predungeon[x1][jj] = 35;
-		predungeon[x2][jj] = 35;
+		ctx.predungeon[x1][jj] = 35;
+		ctx.predungeon[x2][jj] = 35;
 	}
 	for (ii = x1; ii <= x2; ii++) {
-		predungeon[ii][y1] = 35;
-		predungeon[ii][y2] = 35;
+		ctx.predungeon[ii][y1] = 35;
+		ctx.predungeon[ii][y2] = 35;
 	}
 }
 
-static void DL2_KnockWalls(int x1, int y1, int x2, int y2)
+static void DL2_KnockWalls(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int ii, jj;
 
 	for (ii = x1 + 1; ii < x2; ii++) {
-		if (predungeon[ii][y1 - 1] == 46 && predungeon[ii][y1 + 1] == 46) {
-			predungeon[ii][y1] = 46;
+		if (ctx.predungeon[ii][y1 - 1] == 46 && ctx.predungeon[ii][y1 + 1] == 46) {
+			ctx.predungeon[ii][y1] = 46;
 		}
-		if (predungeon[ii][y2 - 1] == 46 && predungeon[ii][y2 + 1] == 46) {
-			predungeon[ii][y2] = 46;
+		if (ctx.predungeon[ii][y2 - 1] == 46 && ctx.predungeon[ii][y2 + 1] == 46) {
+			ctx.predungeon[ii][y2] = 46;
 		}
-		if (predungeon[ii][y1 - 1] == 68) {
-			predungeon[ii][y1 - 1] = 46;
+		if (ctx.predungeon[ii][y1 - 1] == 68) {
+			ctx.predungeon[ii][y1 - 1] = 46;
 		}
-		if (predungeon[ii][y2 + 1] == 68) {
-			predungeon[ii][y2 + 1] = 46;
+		if (ctx.predungeon[ii][y2 + 1] == 68) {
+			ctx.predungeon[ii][y2 + 1] = 46;
 		}
 	}
 	for (jj = y1 + 1; jj < y2; jj++) {
-		if (predungeon[x1 - 1][jj] == 46 && predungeon[x1 + 1][jj] == 46) {
-			predungeon[x1][jj] = 46;
+		if (ctx.predungeon[x1 - 1][jj] == 46 && ctx.predungeon[x1 + 1][jj] == 46) {
+			ctx.predungeon[x1][jj] = 46;
 		}
-		if (predungeon[x2 - 1][jj] == 46 && predungeon[x2 + 1][jj] == 46) {
-			predungeon[x2][jj] = 46;
+		if (ctx.predungeon[x2 - 1][jj] == 46 && ctx.predungeon[x2 + 1][jj] == 46) {
+			ctx.predungeon[x2][jj] = 46;
 		}
-		if (predungeon[x1 - 1][jj] == 68) {
-			predungeon[x1 - 1][jj] = 46;
+		if (ctx.predungeon[x1 - 1][jj] == 68) {
+			ctx.predungeon[x1 - 1][jj] = 46;
 		}
-		if (predungeon[x2 + 1][jj] == 68) {
-			predungeon[x2 + 1][jj] = 46;
+		if (ctx.predungeon[x2 + 1][jj] == 68) {
+			ctx.predungeon[x2 + 1][jj] = 46;
 		}
 	}
 }
 
-static bool DL2_FillVoids()
+static bool DL2_FillVoids(DungeonContext &ctx)
 {
 	int ii, jj, xx, yy, x1, x2, y1, y2;
 	bool xf1, xf2, yf1, yf2;
 	int to;
 
 	to = 0;
-	while (DL2_NumNoChar() > 700 && to < 100) {
+	while (DL2_NumNoChar(ctx) > 700 && to < 100) {
 		xx = GenerateRnd(38) + 1;
 		yy = GenerateRnd(38) + 1;
-		if (predungeon[xx][yy] != 35) {
+		if (ctx.predungeon[xx][yy] != 35) {
 			continue;
 		}
 		xf1 = xf2 = yf1 = yf2 = false;
-		if (predungeon[xx - 1][yy] == 32 && predungeon[xx + 1][yy] == 46) {
-			if (predungeon[xx + 1][yy - 1] == 46
-			    && predungeon[xx + 1][yy + 1] == 46
-			    && predungeon[xx - 1][yy - 1] == 32
-			    && predungeon[xx - 1][yy + 1] == 32) {
+		if (ctx.predungeon[xx - 1][yy] == 32 && ctx.predungeon[xx + 1][yy] == 46) {
+			if (ctx.predungeon[xx + 1][yy - 1] == 46
+			    && ctx.predungeon[xx + 1][yy + 1] == 46
+			    && ctx.predungeon[xx - 1][yy - 1] == 32
+			    && ctx.predungeon[xx - 1][yy + 1] == 32) {
 				xf1 = yf1 = yf2 = true;
 			}
-		} else if (predungeon[xx + 1][yy] == 32 && predungeon[xx - 1][yy] == 46) {
-			if (predungeon[xx - 1][yy - 1] == 46
-			    && predungeon[xx - 1][yy + 1] == 46
-			    && predungeon[xx + 1][yy - 1] == 32
-			    && predungeon[xx + 1][yy + 1] == 32) {
+		} else if (ctx.predungeon[xx + 1][yy] == 32 && ctx.predungeon[xx - 1][yy] == 46) {
+			if (ctx.predungeon[xx - 1][yy - 1] == 46
+			    && ctx.predungeon[xx - 1][yy + 1] == 46
+			    && ctx.predungeon[xx + 1][yy - 1] == 32
+			    && ctx.predungeon[xx + 1][yy + 1] == 32) {
 				xf2 = yf1 = yf2 = true;
 			}
-		} else if (predungeon[xx][yy - 1] == 32 && predungeon[xx][yy + 1] == 46) {
-			if (predungeon[xx - 1][yy + 1] == 46
-			    && predungeon[xx + 1][yy + 1] == 46
-			    && predungeon[xx - 1][yy - 1] == 32
-			    && predungeon[xx + 1][yy - 1] == 32) {
+		} else if (ctx.predungeon[xx][yy - 1] == 32 && ctx.predungeon[xx][yy + 1] == 46) {
+			if (ctx.predungeon[xx - 1][yy + 1] == 46
+			    && ctx.predungeon[xx + 1][yy + 1] == 46
+			    && ctx.predungeon[xx - 1][yy - 1] == 32
+			    && ctx.predungeon[xx + 1][yy - 1] == 32) {
 				yf1 = xf1 = xf2 = true;
 			}
-		} else if (predungeon[xx][yy + 1] == 32 && predungeon[xx][yy - 1] == 46) {
-			if (predungeon[xx - 1][yy - 1] == 46
-			    && predungeon[xx + 1][yy - 1] == 46
-			    && predungeon[xx - 1][yy + 1] == 32
-			    && predungeon[xx + 1][yy + 1] == 32) {
+		} else if (ctx.predungeon[xx][yy + 1] == 32 && ctx.predungeon[xx][yy - 1] == 46) {
+			if (ctx.predungeon[xx - 1][yy - 1] == 46
+			    && ctx.predungeon[xx + 1][yy - 1] == 46
+			    && ctx.predungeon[xx - 1][yy + 1] == 32
+			    && ctx.predungeon[xx + 1][yy + 1] == 32) {
 				yf2 = xf1 = xf2 = true;
 			}
 		}
@@ -2510,10 +2500,10 @@ static bool DL2_FillVoids()
 					if (yf2) {
 						y2++;
 					}
-					if (predungeon[x2][y1] != 32) {
+					if (ctx.predungeon[x2][y1] != 32) {
 						yf1 = false;
 					}
-					if (predungeon[x2][y2] != 32) {
+					if (ctx.predungeon[x2][y2] != 32) {
 						yf2 = false;
 					}
 				}
@@ -2528,7 +2518,7 @@ static bool DL2_FillVoids()
 							xf2 = false;
 						}
 						for (jj = y1; jj <= y2; jj++) {
-							if (predungeon[x2][jj] != 32) {
+							if (ctx.predungeon[x2][jj] != 32) {
 								xf2 = false;
 							}
 						}
@@ -2538,8 +2528,8 @@ static bool DL2_FillVoids()
 					}
 					x2 -= 2;
 					if (x2 - x1 > 5) {
-						DL2_DrawRoom(x1, y1, x2, y2);
-						DL2_KnockWalls(x1, y1, x2, y2);
+						DL2_DrawRoom(ctx, x1, y1, x2, y2);
+						DL2_KnockWalls(ctx, x1, y1, x2, y2);
 					}
 				}
 			} else if (!xf2) {
@@ -2560,10 +2550,10 @@ static bool DL2_FillVoids()
 					if (yf2) {
 						y2++;
 					}
-					if (predungeon[x1][y1] != 32) {
+					if (ctx.predungeon[x1][y1] != 32) {
 						yf1 = false;
 					}
-					if (predungeon[x1][y2] != 32) {
+					if (ctx.predungeon[x1][y2] != 32) {
 						yf2 = false;
 					}
 				}
@@ -2578,7 +2568,7 @@ static bool DL2_FillVoids()
 							xf1 = false;
 						}
 						for (jj = y1; jj <= y2; jj++) {
-							if (predungeon[x1][jj] != 32) {
+							if (ctx.predungeon[x1][jj] != 32) {
 								xf1 = false;
 							}
 						}
@@ -2588,8 +2578,8 @@ static bool DL2_FillVoids()
 					}
 					x1 += 2;
 					if (x2 - x1 > 5) {
-						DL2_DrawRoom(x1, y1, x2, y2);
-						DL2_KnockWalls(x1, y1, x2, y2);
+						DL2_DrawRoom(ctx, x1, y1, x2, y2);
+						DL2_KnockWalls(ctx, x1, y1, x2, y2);
 					}
 				}
 			} else if (!yf1) {
@@ -2610,10 +2600,10 @@ static bool DL2_FillVoids()
 					if (xf2) {
 						x2++;
 					}
-					if (predungeon[x1][y2] != 32) {
+					if (ctx.predungeon[x1][y2] != 32) {
 						xf1 = false;
 					}
-					if (predungeon[x2][y2] != 32) {
+					if (ctx.predungeon[x2][y2] != 32) {
 						xf2 = false;
 					}
 				}
@@ -2628,7 +2618,7 @@ static bool DL2_FillVoids()
 							yf2 = false;
 						}
 						for (ii = x1; ii <= x2; ii++) {
-							if (predungeon[ii][y2] != 32) {
+							if (ctx.predungeon[ii][y2] != 32) {
 								yf2 = false;
 							}
 						}
@@ -2638,8 +2628,8 @@ static bool DL2_FillVoids()
 					}
 					y2 -= 2;
 					if (y2 - y1 > 5) {
-						DL2_DrawRoom(x1, y1, x2, y2);
-						DL2_KnockWalls(x1, y1, x2, y2);
+						DL2_DrawRoom(ctx, x1, y1, x2, y2);
+						DL2_KnockWalls(ctx, x1, y1, x2, y2);
 					}
 				}
 			} else if (!yf2) {
@@ -2660,10 +2650,10 @@ static bool DL2_FillVoids()
 					if (xf2) {
 						x2++;
 					}
-					if (predungeon[x1][y1] != 32) {
+					if (ctx.predungeon[x1][y1] != 32) {
 						xf1 = false;
 					}
-					if (predungeon[x2][y1] != 32) {
+					if (ctx.predungeon[x2][y1] != 32) {
 						xf2 = false;
 					}
 				}
@@ -2678,7 +2668,7 @@ static bool DL2_FillVoids()
 							yf1 = false;
 						}
 						for (ii = x1; ii <= x2; ii++) {
-							if (predungeon[ii][y1] != 32) {
+							if (ctx.predungeon[ii][y1] != 32) {
 								yf1 = false;
 							}
 						}
@@ -2688,8 +2678,8 @@ static bool DL2_FillVoids()
 					}
 					y1 += 2;
 					if (y2 - y1 > 5) {
-						DL2_DrawRoom(x1, y1, x2, y2);
-						DL2_KnockWalls(x1, y1, x2, y2);
+						DL2_DrawRoom(ctx, x1, y1, x2, y2);
+						DL2_KnockWalls(ctx, x1, y1, x2, y2);
 					}
 				}
 			}
@@ -2697,10 +2687,10 @@ static bool DL2_FillVoids()
 		to++;
 	}
 
-	return DL2_NumNoChar() <= 700;
+	return DL2_NumNoChar(ctx) <= 700;
 }
 
-static bool CreateDungeon()
+static bool CreateDungeon(DungeonContext &ctx)
 {
 	int i, j, ForceH, ForceW;
 	bool ForceHW;
@@ -2709,7 +2699,7 @@ static bool CreateDungeon()
 	ForceH = 0;
 	ForceHW = false;
 
-	switch (currlevel) {
+	switch (ctx.currlevel) {
 	case 5:
 		if (quests[Q_BLOOD]._qactive != QUEST_NOTAVAIL) {
 			ForceHW = true;
@@ -2735,123 +2725,123 @@ static bool CreateDungeon()
 		break;
 	}
 
-	CreateRoom(2, 2, DMAXX - 1, DMAXY - 1, 0, 0, ForceHW, ForceH, ForceW);
+	CreateRoom(ctx, 2, 2, DMAXX - 1, DMAXY - 1, 0, 0, ForceHW, ForceH, ForceW);
 
-	while (!HallList.empty()) {
-		ConnectHall(HallList.front());
-		HallList.pop_front();
+	while (!ctx.HallList.empty()) {
+		ConnectHall(ctx, ctx.HallList.front());
+		ctx.HallList.pop_front();
 	}
 
 	for (j = 0; j < DMAXY; j++) {     /// BUGFIX: change '<=' to '<' (fixed)
 		for (i = 0; i < DMAXX; i++) { /// BUGFIX: change '<=' to '<' (fixed)
-			if (predungeon[i][j] == 67) {
-				predungeon[i][j] = 35;
+			if (ctx.predungeon[i][j] == 67) {
+				ctx.predungeon[i][j] = 35;
 			}
-			if (predungeon[i][j] == 66) {
-				predungeon[i][j] = 35;
+			if (ctx.predungeon[i][j] == 66) {
+				ctx.predungeon[i][j] = 35;
 			}
-			if (predungeon[i][j] == 69) {
-				predungeon[i][j] = 35;
+			if (ctx.predungeon[i][j] == 69) {
+				ctx.predungeon[i][j] = 35;
 			}
-			if (predungeon[i][j] == 65) {
-				predungeon[i][j] = 35;
+			if (ctx.predungeon[i][j] == 65) {
+				ctx.predungeon[i][j] = 35;
 			}
-			if (predungeon[i][j] == 44) {
-				predungeon[i][j] = 46;
-				if (predungeon[i - 1][j - 1] == 32) {
-					predungeon[i - 1][j - 1] = 35;
+			if (ctx.predungeon[i][j] == 44) {
+				ctx.predungeon[i][j] = 46;
+				if (ctx.predungeon[i - 1][j - 1] == 32) {
+					ctx.predungeon[i - 1][j - 1] = 35;
 				}
-				if (predungeon[i - 1][j] == 32) {
-					predungeon[i - 1][j] = 35;
+				if (ctx.predungeon[i - 1][j] == 32) {
+					ctx.predungeon[i - 1][j] = 35;
 				}
-				if (predungeon[i - 1][1 + j] == 32) {
-					predungeon[i - 1][1 + j] = 35;
+				if (ctx.predungeon[i - 1][1 + j] == 32) {
+					ctx.predungeon[i - 1][1 + j] = 35;
 				}
-				if (predungeon[i + 1][j - 1] == 32) {
-					predungeon[i + 1][j - 1] = 35;
+				if (ctx.predungeon[i + 1][j - 1] == 32) {
+					ctx.predungeon[i + 1][j - 1] = 35;
 				}
-				if (predungeon[i + 1][j] == 32) {
-					predungeon[i + 1][j] = 35;
+				if (ctx.predungeon[i + 1][j] == 32) {
+					ctx.predungeon[i + 1][j] = 35;
 				}
-				if (predungeon[i + 1][1 + j] == 32) {
-					predungeon[i + 1][1 + j] = 35;
+				if (ctx.predungeon[i + 1][1 + j] == 32) {
+					ctx.predungeon[i + 1][1 + j] = 35;
 				}
-				if (predungeon[i][j - 1] == 32) {
-					predungeon[i][j - 1] = 35;
+				if (ctx.predungeon[i][j - 1] == 32) {
+					ctx.predungeon[i][j - 1] = 35;
 				}
-				if (predungeon[i][j + 1] == 32) {
-					predungeon[i][j + 1] = 35;
+				if (ctx.predungeon[i][j + 1] == 32) {
+					ctx.predungeon[i][j + 1] = 35;
 				}
 			}
 		}
 	}
 
-	if (!DL2_FillVoids()) {
+	if (!DL2_FillVoids(ctx)) {
 		return false;
 	}
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			DoPatternCheck(i, j);
+			DoPatternCheck(ctx, i, j);
 		}
 	}
 
 	return true;
 }
 
-static void DRLG_L2Pass3()
+static void DRLG_L2Pass3(DungeonContext &ctx)
 {
-	DRLG_LPass3(12 - 1);
+	DRLG_LPass3(ctx, 12 - 1);
 }
 
-static void DRLG_L2FTVR(int i, int j, int x, int y, int d)
+static void DRLG_L2FTVR(DungeonContext &ctx, int i, int j, int x, int y, int d)
 {
-	if (dTransVal[x][y] != 0 || dungeon[i][j] != 3) {
+	if (ctx.dTransVal[x][y] != 0 || ctx.dungeon[i][j] != 3) {
 		if (d == 1) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		}
 		if (d == 2) {
-			dTransVal[x + 1][y] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 3) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		}
 		if (d == 4) {
-			dTransVal[x][y + 1] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 5) {
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 6) {
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		}
 		if (d == 7) {
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		}
 		if (d == 8) {
-			dTransVal[x][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
 		}
 	} else {
-		dTransVal[x][y] = TransVal;
-		dTransVal[x + 1][y] = TransVal;
-		dTransVal[x][y + 1] = TransVal;
-		dTransVal[x + 1][y + 1] = TransVal;
-		DRLG_L2FTVR(i + 1, j, x + 2, y, 1);
-		DRLG_L2FTVR(i - 1, j, x - 2, y, 2);
-		DRLG_L2FTVR(i, j + 1, x, y + 2, 3);
-		DRLG_L2FTVR(i, j - 1, x, y - 2, 4);
-		DRLG_L2FTVR(i - 1, j - 1, x - 2, y - 2, 5);
-		DRLG_L2FTVR(i + 1, j - 1, x + 2, y - 2, 6);
-		DRLG_L2FTVR(i - 1, j + 1, x - 2, y + 2, 7);
-		DRLG_L2FTVR(i + 1, j + 1, x + 2, y + 2, 8);
+		ctx.dTransVal[x][y] = ctx.TransVal;
+		ctx.dTransVal[x + 1][y] = ctx.TransVal;
+		ctx.dTransVal[x][y + 1] = ctx.TransVal;
+		ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
+		DRLG_L2FTVR(ctx, i + 1, j, x + 2, y, 1);
+		DRLG_L2FTVR(ctx, i - 1, j, x - 2, y, 2);
+		DRLG_L2FTVR(ctx, i, j + 1, x, y + 2, 3);
+		DRLG_L2FTVR(ctx, i, j - 1, x, y - 2, 4);
+		DRLG_L2FTVR(ctx, i - 1, j - 1, x - 2, y - 2, 5);
+		DRLG_L2FTVR(ctx, i + 1, j - 1, x + 2, y - 2, 6);
+		DRLG_L2FTVR(ctx, i - 1, j + 1, x - 2, y + 2, 7);
+		DRLG_L2FTVR(ctx, i + 1, j + 1, x + 2, y + 2, 8);
 	}
 }
 
-static void DRLG_L2FloodTVal()
+static void DRLG_L2FloodTVal(DungeonContext &ctx)
 {
 	int i, j, xx, yy;
 
@@ -2859,9 +2849,9 @@ static void DRLG_L2FloodTVal()
 	for (j = 0; j < DMAXY; j++) {
 		xx = 16;
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 3 && dTransVal[xx][yy] == 0) {
-				DRLG_L2FTVR(i, j, xx, yy, 0);
-				TransVal++;
+			if (ctx.dungeon[i][j] == 3 && ctx.dTransVal[xx][yy] == 0) {
+				DRLG_L2FTVR(ctx, i, j, xx, yy, 0);
+				ctx.TransVal++;
 			}
 			xx += 2;
 		}
@@ -2869,7 +2859,7 @@ static void DRLG_L2FloodTVal()
 	}
 }
 
-static void DRLG_L2TransFix()
+static void DRLG_L2TransFix(DungeonContext &ctx)
 {
 	int i, j, xx, yy;
 
@@ -2877,26 +2867,26 @@ static void DRLG_L2TransFix()
 	for (j = 0; j < DMAXY; j++) {
 		xx = 16;
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 14 && dungeon[i][j - 1] == 10) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i][j - 1] == 10) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 11) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 11) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 10) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 10) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 11) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 11) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 16) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 16) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
 			xx += 2;
 		}
@@ -2904,336 +2894,336 @@ static void DRLG_L2TransFix()
 	}
 }
 
-static void L2DirtFix()
+static void L2DirtFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 13 && dungeon[i + 1][j] != 11) {
-				dungeon[i][j] = 146;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i + 1][j] != 11) {
+				ctx.dungeon[i][j] = 146;
 			}
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] != 11) {
-				dungeon[i][j] = 144;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] != 11) {
+				ctx.dungeon[i][j] = 144;
 			}
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] != 11) {
-				dungeon[i][j] = 148;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] != 11) {
+				ctx.dungeon[i][j] = 148;
 			}
-			if (dungeon[i][j] == 10 && dungeon[i][j + 1] != 10) {
-				dungeon[i][j] = 143;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i][j + 1] != 10) {
+				ctx.dungeon[i][j] = 143;
 			}
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] != 10) {
-				dungeon[i][j] = 146;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] != 10) {
+				ctx.dungeon[i][j] = 146;
 			}
-			if (dungeon[i][j] == 14 && dungeon[i][j + 1] != 15) {
-				dungeon[i][j] = 147;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i][j + 1] != 15) {
+				ctx.dungeon[i][j] = 147;
 			}
 		}
 	}
 }
 
-void L2LockoutFix()
+void L2LockoutFix(DungeonContext &ctx)
 {
 	int i, j;
 	bool doorok;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 4 && dungeon[i - 1][j] != 3) {
-				dungeon[i][j] = 1;
+			if (ctx.dungeon[i][j] == 4 && ctx.dungeon[i - 1][j] != 3) {
+				ctx.dungeon[i][j] = 1;
 			}
-			if (dungeon[i][j] == 5 && dungeon[i][j - 1] != 3) {
-				dungeon[i][j] = 2;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i][j - 1] != 3) {
+				ctx.dungeon[i][j] = 2;
 			}
 		}
 	}
 	for (j = 1; j < DMAXY - 1; j++) {
 		for (i = 1; i < DMAXX - 1; i++) {
-			if ((dflags[i][j] & DLRG_PROTECTED) != 0) {
+			if ((ctx.dflags[i][j] & DLRG_PROTECTED) != 0) {
 				continue;
 			}
-			if ((dungeon[i][j] == 2 || dungeon[i][j] == 5) && dungeon[i][j - 1] == 3 && dungeon[i][j + 1] == 3) {
+			if ((ctx.dungeon[i][j] == 2 || ctx.dungeon[i][j] == 5) && ctx.dungeon[i][j - 1] == 3 && ctx.dungeon[i][j + 1] == 3) {
 				doorok = false;
 				while (true) {
-					if (dungeon[i][j] != 2 && dungeon[i][j] != 5) {
+					if (ctx.dungeon[i][j] != 2 && ctx.dungeon[i][j] != 5) {
 						break;
 					}
-					if (dungeon[i][j - 1] != 3 || dungeon[i][j + 1] != 3) {
+					if (ctx.dungeon[i][j - 1] != 3 || ctx.dungeon[i][j + 1] != 3) {
 						break;
 					}
-					if (dungeon[i][j] == 5) {
+					if (ctx.dungeon[i][j] == 5) {
 						doorok = true;
 					}
 					i++;
 				}
-				if (!doorok && (dflags[i - 1][j] & DLRG_PROTECTED) == 0) {
-					dungeon[i - 1][j] = 5;
+				if (!doorok && (ctx.dflags[i - 1][j] & DLRG_PROTECTED) == 0) {
+					ctx.dungeon[i - 1][j] = 5;
 				}
 			}
 		}
 	}
 	for (j = 1; j < DMAXX - 1; j++) { /* check: might be flipped */
 		for (i = 1; i < DMAXY - 1; i++) {
-			if ((dflags[j][i] & DLRG_PROTECTED) != 0) {
+			if ((ctx.dflags[j][i] & DLRG_PROTECTED) != 0) {
 				continue;
 			}
-			if ((dungeon[j][i] == 1 || dungeon[j][i] == 4) && dungeon[j - 1][i] == 3 && dungeon[j + 1][i] == 3) {
+			if ((ctx.dungeon[j][i] == 1 || ctx.dungeon[j][i] == 4) && ctx.dungeon[j - 1][i] == 3 && ctx.dungeon[j + 1][i] == 3) {
 				doorok = false;
 				while (true) {
-					if (dungeon[j][i] != 1 && dungeon[j][i] != 4) {
+					if (ctx.dungeon[j][i] != 1 && ctx.dungeon[j][i] != 4) {
 						break;
 					}
-					if (dungeon[j - 1][i] != 3 || dungeon[j + 1][i] != 3) {
+					if (ctx.dungeon[j - 1][i] != 3 || ctx.dungeon[j + 1][i] != 3) {
 						break;
 					}
-					if (dungeon[j][i] == 4) {
+					if (ctx.dungeon[j][i] == 4) {
 						doorok = true;
 					}
 					i++;
 				}
-				if (!doorok && (dflags[j][i - 1] & DLRG_PROTECTED) == 0) {
-					dungeon[j][i - 1] = 4;
+				if (!doorok && (ctx.dflags[j][i - 1] & DLRG_PROTECTED) == 0) {
+					ctx.dungeon[j][i - 1] = 4;
 				}
 			}
 		}
 	}
 }
 
-void L2DoorFix()
+void L2DoorFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 1; j < DMAXY; j++) {
 		for (i = 1; i < DMAXX; i++) {
-			if (dungeon[i][j] == 4 && dungeon[i][j - 1] == 3) {
-				dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 4 && ctx.dungeon[i][j - 1] == 3) {
+				ctx.dungeon[i][j] = 7;
 			}
-			if (dungeon[i][j] == 5 && dungeon[i - 1][j] == 3) {
-				dungeon[i][j] = 9;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i - 1][j] == 3) {
+				ctx.dungeon[i][j] = 9;
 			}
 		}
 	}
 }
 
-static void DRLG_L2(lvl_entry entry)
+static void DRLG_L2(DungeonContext &ctx, lvl_entry entry)
 {
 	int i, j;
 	bool doneflag;
 
 	doneflag = false;
 	while (!doneflag) {
-		nRoomCnt = 0;
-		InitDungeon();
-		DRLG_InitTrans();
-		if (!CreateDungeon()) {
+		ctx.nRoomCnt = 0;
+		InitDungeon(ctx);
+		DRLG_InitTrans(ctx);
+		if (!CreateDungeon(ctx)) {
 			continue;
 		}
-		L2TileFix();
-		if (setloadflag) {
-			DRLG_L2SetRoom(nSx1, nSy1);
+		L2TileFix(ctx);
+		if (ctx.setloadflag) {
+			DRLG_L2SetRoom(ctx, ctx.nSx1, ctx.nSy1);
 		}
-		DRLG_L2FloodTVal();
-		DRLG_L2TransFix();
+		DRLG_L2FloodTVal(ctx);
+		DRLG_L2TransFix(ctx);
 		if (entry == ENTRY_MAIN) {
-			doneflag = DRLG_L2PlaceMiniSet(USTAIRS, 1, 1, -1, -1, true, 0);
+			doneflag = DRLG_L2PlaceMiniSet(ctx, USTAIRS, 1, 1, -1, -1, true, 0);
 			if (doneflag) {
-				doneflag = DRLG_L2PlaceMiniSet(DSTAIRS, 1, 1, -1, -1, false, 1);
-				if (doneflag && currlevel == 5) {
-					doneflag = DRLG_L2PlaceMiniSet(WARPSTAIRS, 1, 1, -1, -1, false, 6);
+				doneflag = DRLG_L2PlaceMiniSet(ctx, DSTAIRS, 1, 1, -1, -1, false, 1);
+				if (doneflag && ctx.currlevel == 5) {
+					doneflag = DRLG_L2PlaceMiniSet(ctx, WARPSTAIRS, 1, 1, -1, -1, false, 6);
 				}
 			}
-			ViewY -= 2;
+			ctx.ViewY -= 2;
 		} else if (entry == ENTRY_PREV) {
-			doneflag = DRLG_L2PlaceMiniSet(USTAIRS, 1, 1, -1, -1, false, 0);
+			doneflag = DRLG_L2PlaceMiniSet(ctx, USTAIRS, 1, 1, -1, -1, false, 0);
 			if (doneflag) {
-				doneflag = DRLG_L2PlaceMiniSet(DSTAIRS, 1, 1, -1, -1, true, 1);
-				if (doneflag && currlevel == 5) {
-					doneflag = DRLG_L2PlaceMiniSet(WARPSTAIRS, 1, 1, -1, -1, false, 6);
+				doneflag = DRLG_L2PlaceMiniSet(ctx, DSTAIRS, 1, 1, -1, -1, true, 1);
+				if (doneflag && ctx.currlevel == 5) {
+					doneflag = DRLG_L2PlaceMiniSet(ctx, WARPSTAIRS, 1, 1, -1, -1, false, 6);
 				}
 			}
-			ViewX--;
+			ctx.ViewX--;
 		} else {
-			doneflag = DRLG_L2PlaceMiniSet(USTAIRS, 1, 1, -1, -1, false, 0);
+			doneflag = DRLG_L2PlaceMiniSet(ctx, USTAIRS, 1, 1, -1, -1, false, 0);
 			if (doneflag) {
-				doneflag = DRLG_L2PlaceMiniSet(DSTAIRS, 1, 1, -1, -1, false, 1);
-				if (doneflag && currlevel == 5) {
-					doneflag = DRLG_L2PlaceMiniSet(WARPSTAIRS, 1, 1, -1, -1, true, 6);
+				doneflag = DRLG_L2PlaceMiniSet(ctx, DSTAIRS, 1, 1, -1, -1, false, 1);
+				if (doneflag && ctx.currlevel == 5) {
+					doneflag = DRLG_L2PlaceMiniSet(ctx, WARPSTAIRS, 1, 1, -1, -1, true, 6);
 				}
 			}
-			ViewY -= 2;
-		}
-	}
-
-	L2LockoutFix();
-	L2DoorFix();
-	L2DirtFix();
-
-	DRLG_PlaceThemeRooms(6, 10, 3, 0, false);
-	DRLG_L2PlaceRndSet(CTRDOOR1, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR2, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR3, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR4, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR5, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR6, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR7, 100);
-	DRLG_L2PlaceRndSet(CTRDOOR8, 100);
-	DRLG_L2PlaceRndSet(VARCH33, 100);
-	DRLG_L2PlaceRndSet(VARCH34, 100);
-	DRLG_L2PlaceRndSet(VARCH35, 100);
-	DRLG_L2PlaceRndSet(VARCH36, 100);
-	DRLG_L2PlaceRndSet(VARCH37, 100);
-	DRLG_L2PlaceRndSet(VARCH38, 100);
-	DRLG_L2PlaceRndSet(VARCH39, 100);
-	DRLG_L2PlaceRndSet(VARCH40, 100);
-	DRLG_L2PlaceRndSet(VARCH1, 100);
-	DRLG_L2PlaceRndSet(VARCH2, 100);
-	DRLG_L2PlaceRndSet(VARCH3, 100);
-	DRLG_L2PlaceRndSet(VARCH4, 100);
-	DRLG_L2PlaceRndSet(VARCH5, 100);
-	DRLG_L2PlaceRndSet(VARCH6, 100);
-	DRLG_L2PlaceRndSet(VARCH7, 100);
-	DRLG_L2PlaceRndSet(VARCH8, 100);
-	DRLG_L2PlaceRndSet(VARCH9, 100);
-	DRLG_L2PlaceRndSet(VARCH10, 100);
-	DRLG_L2PlaceRndSet(VARCH11, 100);
-	DRLG_L2PlaceRndSet(VARCH12, 100);
-	DRLG_L2PlaceRndSet(VARCH13, 100);
-	DRLG_L2PlaceRndSet(VARCH14, 100);
-	DRLG_L2PlaceRndSet(VARCH15, 100);
-	DRLG_L2PlaceRndSet(VARCH16, 100);
-	DRLG_L2PlaceRndSet(VARCH17, 100);
-	DRLG_L2PlaceRndSet(VARCH18, 100);
-	DRLG_L2PlaceRndSet(VARCH19, 100);
-	DRLG_L2PlaceRndSet(VARCH20, 100);
-	DRLG_L2PlaceRndSet(VARCH21, 100);
-	DRLG_L2PlaceRndSet(VARCH22, 100);
-	DRLG_L2PlaceRndSet(VARCH23, 100);
-	DRLG_L2PlaceRndSet(VARCH24, 100);
-	DRLG_L2PlaceRndSet(VARCH25, 100);
-	DRLG_L2PlaceRndSet(VARCH26, 100);
-	DRLG_L2PlaceRndSet(VARCH27, 100);
-	DRLG_L2PlaceRndSet(VARCH28, 100);
-	DRLG_L2PlaceRndSet(VARCH29, 100);
-	DRLG_L2PlaceRndSet(VARCH30, 100);
-	DRLG_L2PlaceRndSet(VARCH31, 100);
-	DRLG_L2PlaceRndSet(VARCH32, 100);
-	DRLG_L2PlaceRndSet(HARCH1, 100);
-	DRLG_L2PlaceRndSet(HARCH2, 100);
-	DRLG_L2PlaceRndSet(HARCH3, 100);
-	DRLG_L2PlaceRndSet(HARCH4, 100);
-	DRLG_L2PlaceRndSet(HARCH5, 100);
-	DRLG_L2PlaceRndSet(HARCH6, 100);
-	DRLG_L2PlaceRndSet(HARCH7, 100);
-	DRLG_L2PlaceRndSet(HARCH8, 100);
-	DRLG_L2PlaceRndSet(HARCH9, 100);
-	DRLG_L2PlaceRndSet(HARCH10, 100);
-	DRLG_L2PlaceRndSet(HARCH11, 100);
-	DRLG_L2PlaceRndSet(HARCH12, 100);
-	DRLG_L2PlaceRndSet(HARCH13, 100);
-	DRLG_L2PlaceRndSet(HARCH14, 100);
-	DRLG_L2PlaceRndSet(HARCH15, 100);
-	DRLG_L2PlaceRndSet(HARCH16, 100);
-	DRLG_L2PlaceRndSet(HARCH17, 100);
-	DRLG_L2PlaceRndSet(HARCH18, 100);
-	DRLG_L2PlaceRndSet(HARCH19, 100);
-	DRLG_L2PlaceRndSet(HARCH20, 100);
-	DRLG_L2PlaceRndSet(HARCH21, 100);
-	DRLG_L2PlaceRndSet(HARCH22, 100);
-	DRLG_L2PlaceRndSet(HARCH23, 100);
-	DRLG_L2PlaceRndSet(HARCH24, 100);
-	DRLG_L2PlaceRndSet(HARCH25, 100);
-	DRLG_L2PlaceRndSet(HARCH26, 100);
-	DRLG_L2PlaceRndSet(HARCH27, 100);
-	DRLG_L2PlaceRndSet(HARCH28, 100);
-	DRLG_L2PlaceRndSet(HARCH29, 100);
-	DRLG_L2PlaceRndSet(HARCH30, 100);
-	DRLG_L2PlaceRndSet(HARCH31, 100);
-	DRLG_L2PlaceRndSet(HARCH32, 100);
-	DRLG_L2PlaceRndSet(HARCH33, 100);
-	DRLG_L2PlaceRndSet(HARCH34, 100);
-	DRLG_L2PlaceRndSet(HARCH35, 100);
-	DRLG_L2PlaceRndSet(HARCH36, 100);
-	DRLG_L2PlaceRndSet(HARCH37, 100);
-	DRLG_L2PlaceRndSet(HARCH38, 100);
-	DRLG_L2PlaceRndSet(HARCH39, 100);
-	DRLG_L2PlaceRndSet(HARCH40, 100);
-	DRLG_L2PlaceRndSet(CRUSHCOL, 99);
-	DRLG_L2PlaceRndSet(RUINS1, 10);
-	DRLG_L2PlaceRndSet(RUINS2, 10);
-	DRLG_L2PlaceRndSet(RUINS3, 10);
-	DRLG_L2PlaceRndSet(RUINS4, 10);
-	DRLG_L2PlaceRndSet(RUINS5, 10);
-	DRLG_L2PlaceRndSet(RUINS6, 10);
-	DRLG_L2PlaceRndSet(RUINS7, 50);
-	DRLG_L2PlaceRndSet(PANCREAS1, 1);
-	DRLG_L2PlaceRndSet(PANCREAS2, 1);
-	DRLG_L2PlaceRndSet(BIG1, 3);
-	DRLG_L2PlaceRndSet(BIG2, 3);
-	DRLG_L2PlaceRndSet(BIG3, 3);
-	DRLG_L2PlaceRndSet(BIG4, 3);
-	DRLG_L2PlaceRndSet(BIG5, 3);
-	DRLG_L2PlaceRndSet(BIG6, 20);
-	DRLG_L2PlaceRndSet(BIG7, 20);
-	DRLG_L2PlaceRndSet(BIG8, 3);
-	DRLG_L2PlaceRndSet(BIG9, 20);
-	DRLG_L2PlaceRndSet(BIG10, 20);
-	DRLG_L2Subs();
-	DRLG_L2Shadows();
+			ctx.ViewY -= 2;
+		}
+	}
+
+	L2LockoutFix(ctx);
+	L2DoorFix(ctx);
+	L2DirtFix(ctx);
+
+	DRLG_PlaceThemeRooms(ctx, 6, 10, 3, 0, false);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR1, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR2, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR3, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR4, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR5, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR6, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR7, 100);
+	DRLG_L2PlaceRndSet(ctx, CTRDOOR8, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH33, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH34, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH35, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH36, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH37, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH38, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH39, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH40, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH1, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH2, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH3, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH4, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH5, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH6, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH7, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH8, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH9, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH10, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH11, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH12, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH13, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH14, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH15, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH16, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH17, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH18, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH19, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH20, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH21, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH22, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH23, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH24, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH25, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH26, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH27, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH28, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH29, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH30, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH31, 100);
+	DRLG_L2PlaceRndSet(ctx, VARCH32, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH1, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH2, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH3, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH4, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH5, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH6, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH7, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH8, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH9, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH10, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH11, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH12, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH13, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH14, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH15, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH16, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH17, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH18, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH19, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH20, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH21, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH22, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH23, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH24, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH25, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH26, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH27, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH28, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH29, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH30, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH31, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH32, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH33, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH34, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH35, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH36, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH37, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH38, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH39, 100);
+	DRLG_L2PlaceRndSet(ctx, HARCH40, 100);
+	DRLG_L2PlaceRndSet(ctx, CRUSHCOL, 99);
+	DRLG_L2PlaceRndSet(ctx, RUINS1, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS2, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS3, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS4, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS5, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS6, 10);
+	DRLG_L2PlaceRndSet(ctx, RUINS7, 50);
+	DRLG_L2PlaceRndSet(ctx, PANCREAS1, 1);
+	DRLG_L2PlaceRndSet(ctx, PANCREAS2, 1);
+	DRLG_L2PlaceRndSet(ctx, BIG1, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG2, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG3, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG4, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG5, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG6, 20);
+	DRLG_L2PlaceRndSet(ctx, BIG7, 20);
+	DRLG_L2PlaceRndSet(ctx, BIG8, 3);
+	DRLG_L2PlaceRndSet(ctx, BIG9, 20);
+	DRLG_L2PlaceRndSet(ctx, BIG10, 20);
+	DRLG_L2Subs(ctx);
+	DRLG_L2Shadows(ctx);
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			pdungeon[i][j] = dungeon[i][j];
+			ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 		}
 	}
 
-	DRLG_Init_Globals();
-	DRLG_CheckQuests(nSx1, nSy1);
+	DRLG_InitFlags(ctx);
+	DRLG_CheckQuests(ctx, ctx.nSx1, ctx.nSy1);
 }
 
-static void DRLG_InitL2Vals()
+static void DRLG_InitL2Vals(DungeonContext &ctx)
 {
 	int i, j, pc;
 
 	for (j = 0; j < MAXDUNY; j++) {
 		for (i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] == 541) {
+			if (ctx.dPiece[i][j] == 541) {
 				pc = 5;
-			} else if (dPiece[i][j] == 178) {
+			} else if (ctx.dPiece[i][j] == 178) {
 				pc = 5;
-			} else if (dPiece[i][j] == 551) {
+			} else if (ctx.dPiece[i][j] == 551) {
 				pc = 5;
-			} else if (dPiece[i][j] == 542) {
+			} else if (ctx.dPiece[i][j] == 542) {
 				pc = 6;
-			} else if (dPiece[i][j] == 553) {
+			} else if (ctx.dPiece[i][j] == 553) {
 				pc = 6;
 			} else {
 				continue;
 			}
-			dSpecial[i][j] = pc;
+			ctx.dSpecial[i][j] = pc;
 		}
 	}
 	for (j = 0; j < MAXDUNY; j++) {
 		for (i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] == 132) {
-				dSpecial[i][j + 1] = 2;
-				dSpecial[i][j + 2] = 1;
-			} else if (dPiece[i][j] == 135 || dPiece[i][j] == 139) {
-				dSpecial[i + 1][j] = 3;
-				dSpecial[i + 2][j] = 4;
+			if (ctx.dPiece[i][j] == 132) {
+				ctx.dSpecial[i][j + 1] = 2;
+				ctx.dSpecial[i][j + 2] = 1;
+			} else if (ctx.dPiece[i][j] == 135 || ctx.dPiece[i][j] == 139) {
+				ctx.dSpecial[i + 1][j] = 3;
+				ctx.dSpecial[i + 2][j] = 4;
 			}
 		}
 	}
 }
 
-static void LoadL2DungeonData(const uint16_t *dunData)
+static void LoadL2DungeonData(DungeonContext &ctx, const uint16_t *dunData)
 {
-	InitDungeon();
-	DRLG_InitTrans();
+	InitDungeon(ctx);
+	DRLG_InitTrans(ctx);
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 12;
-			dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 12;
+			ctx.dflags[i][j] = 0;
 		}
 	}
 
@@ -3247,122 +3237,122 @@ static void LoadL2DungeonData(const uint16_t *dunData)
 			uint8_t tileId = SDL_SwapLE16(*tileLayer);
 			tileLayer++;
 			if (tileId != 0) {
-				dungeon[i][j] = tileId;
-				dflags[i][j] |= DLRG_PROTECTED;
+				ctx.dungeon[i][j] = tileId;
+				ctx.dflags[i][j] |= DLRG_PROTECTED;
 			} else {
-				dungeon[i][j] = 3;
+				ctx.dungeon[i][j] = 3;
 			}
 		}
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 0) {
-				dungeon[i][j] = 12;
+			if (ctx.dungeon[i][j] == 0) {
+				ctx.dungeon[i][j] = 12;
 			}
 		}
 	}
 }
 
-void LoadL2Dungeon(const char *path, int vx, int vy)
+void LoadL2Dungeon(DungeonContext &ctx, const char *path, int vx, int vy)
 {
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
-	LoadL2DungeonData(dunData.get());
+	LoadL2DungeonData(ctx, dunData.get());
 
-	DRLG_L2Pass3();
+	DRLG_L2Pass3(ctx);
 	DRLG_Init_Globals();
 
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
 			int pc = 0;
-			if (dPiece[i][j] == 541) {
+			if (ctx.dPiece[i][j] == 541) {
 				pc = 5;
 			}
-			if (dPiece[i][j] == 178) {
+			if (ctx.dPiece[i][j] == 178) {
 				pc = 5;
 			}
-			if (dPiece[i][j] == 551) {
+			if (ctx.dPiece[i][j] == 551) {
 				pc = 5;
 			}
-			if (dPiece[i][j] == 542) {
+			if (ctx.dPiece[i][j] == 542) {
 				pc = 6;
 			}
-			if (dPiece[i][j] == 553) {
+			if (ctx.dPiece[i][j] == 553) {
 				pc = 6;
 			}
-			dSpecial[i][j] = pc;
+			ctx.dSpecial[i][j] = pc;
 		}
 	}
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] == 132) {
-				dSpecial[i][j + 1] = 2;
-				dSpecial[i][j + 2] = 1;
-			} else if (dPiece[i][j] == 135 || dPiece[i][j] == 139) {
-				dSpecial[i + 1][j] = 3;
-				dSpecial[i + 2][j] = 4;
+			if (ctx.dPiece[i][j] == 132) {
+				ctx.dSpecial[i][j + 1] = 2;
+				ctx.dSpecial[i][j + 2] = 1;
+			} else if (ctx.dPiece[i][j] == 135 || ctx.dPiece[i][j] == 139) {
+				ctx.dSpecial[i + 1][j] = 3;
+				ctx.dSpecial[i + 2][j] = 4;
 			}
 		}
 	}
 
-	ViewX = vx;
-	ViewY = vy;
+	ctx.ViewX = vx;
+	ctx.ViewY = vy;
 
 	SetMapMonsters(dunData.get(), { 0, 0 });
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL2Dungeon(const char *path)
+void LoadPreL2Dungeon(DungeonContext &ctx, const char *path)
 {
 	{
 		auto dunData = LoadFileInMem<uint16_t>(path);
-		LoadL2DungeonData(dunData.get());
+		LoadL2DungeonData(ctx, dunData.get());
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			pdungeon[i][j] = dungeon[i][j];
+			ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 		}
 	}
 }
 
-void CreateL2Dungeon(uint32_t rseed, lvl_entry entry)
+void CreateL2Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry)
 {
 	if (!gbIsMultiplayer) {
-		if (currlevel == 7 && quests[Q_BLIND]._qactive == QUEST_NOTAVAIL) {
-			currlevel = 6;
-			CreateL2Dungeon(glSeedTbl[6], ENTRY_LOAD);
-			currlevel = 7;
+		if (ctx.currlevel == 7 && quests[Q_BLIND]._qactive == QUEST_NOTAVAIL) {
+			ctx.currlevel = 6;
+			CreateL2Dungeon(ctx, glSeedTbl[6], ENTRY_LOAD);
+			ctx.currlevel = 7;
 		}
-		if (currlevel == 8) {
+		if (ctx.currlevel == 8) {
 			if (quests[Q_BLIND]._qactive == QUEST_NOTAVAIL) {
-				currlevel = 6;
-				CreateL2Dungeon(glSeedTbl[6], ENTRY_LOAD);
-				currlevel = 8;
+				ctx.currlevel = 6;
+				CreateL2Dungeon(ctx, glSeedTbl[6], ENTRY_LOAD);
+				ctx.currlevel = 8;
 			} else {
-				currlevel = 7;
-				CreateL2Dungeon(glSeedTbl[7], ENTRY_LOAD);
-				currlevel = 8;
+				ctx.currlevel = 7;
+				CreateL2Dungeon(ctx, glSeedTbl[7], ENTRY_LOAD);
+				ctx.currlevel = 8;
 			}
 		}
 	}
 
 	SetRndSeed(rseed);
 
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
-
-	DRLG_InitTrans();
-	DRLG_InitSetPC();
-	DRLG_LoadL2SP();
-	DRLG_L2(entry);
-	DRLG_L2Pass3();
-	DRLG_FreeL2SP();
-	DRLG_InitL2Vals();
-	DRLG_SetPC();
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
+
+	DRLG_InitTrans(ctx);
+	DRLG_InitSetPC(ctx);
+	DRLG_LoadL2SP(ctx);
+	DRLG_L2(ctx, entry);
+	DRLG_L2Pass3(ctx);
+	DRLG_FreeL2SP(ctx);
+	DRLG_InitL2Vals(ctx);
+	DRLG_SetPC(ctx);
 }
 
 } // namespace devilution
@@ -9,27 +9,14 @@
 
 namespace devilution {
 
-struct HALLNODE {
-	int nHallx1;
-	int nHally1;
-	int nHallx2;
-	int nHally2;
-	int nHalldir;
-};
-
-struct ROOMNODE {
-	int nRoomx1;
-	int nRoomy1;
-	int nRoomx2;
-	int nRoomy2;
-	int nRoomDest;
-};
-
-extern BYTE predungeon[DMAXX][DMAXY];
-
-void InitDungeon();
-void LoadL2Dungeon(const char *sFileName, int vx, int vy);
-void LoadPreL2Dungeon(const char *sFileName);
-void CreateL2Dungeon(uint32_t rseed, lvl_entry entry);
+void InitDungeon(DungeonContext &ctx);
+void LoadL2Dungeon(DungeonContext &ctx, const char *sFileName, int vx, int vy);
+void LoadPreL2Dungeon(DungeonContext &ctx, const char *sFileName);
+/**
+ * @brief Generate a Catacombs level into the given context
+ *
+ * Call DRLG_Init_Globals before when building the active level.
+ */
+void CreateL2Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry);
 
 } // namespace devilution
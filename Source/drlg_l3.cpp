@@ -19,11 +19,6 @@ namespace devilution {
 
 namespace {
 
-/** This will be true if a lava pool has been generated for the level */
-uint8_t lavapool;
-int lockoutcnt;
-bool lockout[DMAXX][DMAXY];
-
 /**
  * A lookup table for the 16 possible patterns of a 2x2 area,
  * where each cell either contains a SW wall or it doesn't.
@@ -843,21 +838,21 @@ const BYTE byte_48A9C8[] = {
 
 } // namespace
 
-static void InitL3Dungeon()
+static void InitL3Dungeon(DungeonContext &ctx)
 {
 	int i, j;
 
-	memset(dungeon, 0, sizeof(dungeon));
+	memset(ctx.dungeon, 0, sizeof(ctx.dungeon));
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 0;
-			dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 0;
+			ctx.dflags[i][j] = 0;
 		}
 	}
 }
 
-static bool DRLG_L3FillRoom(int x1, int y1, int x2, int y2)
+static bool DRLG_L3FillRoom(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int i, j, v;
 
@@ -868,7 +863,7 @@ static bool DRLG_L3FillRoom(int x1, int y1, int x2, int y2)
 	v = 0;
 	for (j = y1; j <= y2; j++) {
 		for (i = x1; i <= x2; i++) {
-			v += dungeon[i][j];
+			v += ctx.dungeon[i][j];
 		}
 	}
 
@@ -878,30 +873,30 @@ static bool DRLG_L3FillRoom(int x1, int y1, int x2, int y2)
 
 	for (j = y1 + 1; j < y2; j++) {
 		for (i = x1 + 1; i < x2; i++) {
-			dungeon[i][j] = 1;
+			ctx.dungeon[i][j] = 1;
 		}
 	}
 	for (j = y1; j <= y2; j++) {
 		if (GenerateRnd(2) != 0) {
-			dungeon[x1][j] = 1;
+			ctx.dungeon[x1][j] = 1;
 		}
 		if (GenerateRnd(2) != 0) {
-			dungeon[x2][j] = 1;
+			ctx.dungeon[x2][j] = 1;
 		}
 	}
 	for (i = x1; i <= x2; i++) {
 		if (GenerateRnd(2) != 0) {
-			dungeon[i][y1] = 1;
+			ctx.dungeon[i][y1] = 1;
 		}
 		if (GenerateRnd(2) != 0) {
-			dungeon[i][y2] = 1;
+			ctx.dungeon[i][y2] = 1;
 		}
 	}
 
 	return true;
 }
 
-static void DRLG_L3CreateBlock(int x, int y, int obs, int dir)
+static void DRLG_L3CreateBlock(DungeonContext &ctx, int x, int y, int obs, int dir)
 {
 	int blksizex, blksizey, x1, y1, x2, y2;
 	int contflag;
@@ -966,83 +961,83 @@ static void DRLG_L3CreateBlock(int x, int y, int obs, int dir)
 		y2 = y1 + blksizey;
 	}
 
-	if (DRLG_L3FillRoom(x1, y1, x2, y2)) {
+	if (DRLG_L3FillRoom(ctx, x1, y1, x2, y2)) {
 		contflag = GenerateRnd(4);
 		if (contflag != 0 && dir != 2) {
-			DRLG_L3CreateBlock(x1, y1, blksizey, 0);
+			DRLG_L3CreateBlock(ctx, x1, y1, blksizey, 0);
 		}
 		if (contflag != 0 && dir != 3) {
-			DRLG_L3CreateBlock(x2, y1, blksizex, 1);
+			DRLG_L3CreateBlock(ctx, x2, y1, blksizex, 1);
 		}
 		if (contflag != 0 && dir != 0) {
-			DRLG_L3CreateBlock(x1, y2, blksizey, 2);
+			DRLG_L3CreateBlock(ctx, x1, y2, blksizey, 2);
 		}
 		if (contflag != 0 && dir != 1) {
-			DRLG_L3CreateBlock(x1, y1, blksizex, 3);
+			DRLG_L3CreateBlock(ctx, x1, y1, blksizex, 3);
 		}
 	}
 }
 
-static void DRLG_L3FloorArea(int x1, int y1, int x2, int y2)
+static void DRLG_L3FloorArea(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int i, j;
 
 	for (j = y1; j <= y2; j++) {
 		for (i = x1; i <= x2; i++) {
-			dungeon[i][j] = 1;
+			ctx.dungeon[i][j] = 1;
 		}
 	}
 }
 
-static void DRLG_L3FillDiags()
+static void DRLG_L3FillDiags(DungeonContext &ctx)
 {
 	int i, j, v;
 
 	for (j = 0; j < DMAXY - 1; j++) {
 		for (i = 0; i < DMAXX - 1; i++) {
-			v = dungeon[i + 1][j + 1] + 2 * dungeon[i][j + 1] + 4 * dungeon[i + 1][j] + 8 * dungeon[i][j];
+			v = ctx.dungeon[i + 1][j + 1] + 2 * ctx.dungeon[i][j + 1] + 4 * ctx.dungeon[i + 1][j] + 8 * ctx.dungeon[i][j];
 			if (v == 6) {
 				if (GenerateRnd(2) == 0) {
-					dungeon[i][j] = 1;
+					ctx.dungeon[i][j] = 1;
 				} else {
-					dungeon[i + 1][j + 1] = 1;
+					ctx.dungeon[i + 1][j + 1] = 1;
 				}
 			}
 			if (v == 9) {
 				if (GenerateRnd(2) == 0) {
-					dungeon[i + 1][j] = 1;
+					ctx.dungeon[i + 1][j] = 1;
 				} else {
-					dungeon[i][j + 1] = 1;
+					ctx.dungeon[i][j + 1] = 1;
 				}
 			}
 		}
 	}
 }
 
-static void DRLG_L3FillSingles()
+static void DRLG_L3FillSingles(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 1; j < DMAXY - 1; j++) {
 		for (i = 1; i < DMAXX - 1; i++) {
-			if (dungeon[i][j] == 0
-			    && dungeon[i][j - 1] + dungeon[i - 1][j - 1] + dungeon[i + 1][j - 1] == 3
-			    && dungeon[i + 1][j] + dungeon[i - 1][j] == 2
-			    && dungeon[i][j + 1] + dungeon[i - 1][j + 1] + dungeon[i + 1][j + 1] == 3) {
-				dungeon[i][j] = 1;
+			if (ctx.dungeon[i][j] == 0
+			    && ctx.dungeon[i][j - 1] + ctx.dungeon[i - 1][j - 1] + ctx.dungeon[i + 1][j - 1] == 3
+			    && ctx.dungeon[i + 1][j] + ctx.dungeon[i - 1][j] == 2
+			    && ctx.dungeon[i][j + 1] + ctx.dungeon[i - 1][j + 1] + ctx.dungeon[i + 1][j + 1] == 3) {
+				ctx.dungeon[i][j] = 1;
 			}
 		}
 	}
 }
 
-static void DRLG_L3FillStraights()
+static void DRLG_L3FillStraights(DungeonContext &ctx)
 {
 	int i, j, xc, xs, yc, ys, k, rv;
 
 	for (j = 0; j < DMAXY - 1; j++) {
 		xs = 0;
 		for (i = 0; i < 37; i++) {
-			if (dungeon[i][j] == 0 && dungeon[i][j + 1] == 1) {
+			if (ctx.dungeon[i][j] == 0 && ctx.dungeon[i][j + 1] == 1) {
 				if (xs == 0) {
 					xc = i;
 				}
@@ -1051,7 +1046,7 @@ static void DRLG_L3FillStraights()
 				if (xs > 3 && GenerateRnd(2) != 0) {
 					for (k = xc; k < i; k++) {
 						rv = GenerateRnd(2);
-						dungeon[k][j] = rv;
+						ctx.dungeon[k][j] = rv;
 					}
 				}
 				xs = 0;
@@ -1061,7 +1056,7 @@ static void DRLG_L3FillStraights()
 	for (j = 0; j < DMAXY - 1; j++) {
 		xs = 0;
 		for (i = 0; i < 37; i++) {
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 0) {
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 0) {
 				if (xs == 0) {
 					xc = i;
 				}
@@ -1070,7 +1065,7 @@ static void DRLG_L3FillStraights()
 				if (xs > 3 && GenerateRnd(2) != 0) {
 					for (k = xc; k < i; k++) {
 						rv = GenerateRnd(2);
-						dungeon[k][j + 1] = rv;
+						ctx.dungeon[k][j + 1] = rv;
 					}
 				}
 				xs = 0;
@@ -1080,7 +1075,7 @@ static void DRLG_L3FillStraights()
 	for (i = 0; i < DMAXX - 1; i++) {
 		ys = 0;
 		for (j = 0; j < 37; j++) {
-			if (dungeon[i][j] == 0 && dungeon[i + 1][j] == 1) {
+			if (ctx.dungeon[i][j] == 0 && ctx.dungeon[i + 1][j] == 1) {
 				if (ys == 0) {
 					yc = j;
 				}
@@ -1089,7 +1084,7 @@ static void DRLG_L3FillStraights()
 				if (ys > 3 && GenerateRnd(2) != 0) {
 					for (k = yc; k < j; k++) {
 						rv = GenerateRnd(2);
-						dungeon[i][k] = rv;
+						ctx.dungeon[i][k] = rv;
 					}
 				}
 				ys = 0;
@@ -1099,7 +1094,7 @@ static void DRLG_L3FillStraights()
 	for (i = 0; i < DMAXX - 1; i++) {
 		ys = 0;
 		for (j = 0; j < 37; j++) {
-			if (dungeon[i][j] == 1 && dungeon[i + 1][j] == 0) {
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i + 1][j] == 0) {
 				if (ys == 0) {
 					yc = j;
 				}
@@ -1108,7 +1103,7 @@ static void DRLG_L3FillStraights()
 				if (ys > 3 && GenerateRnd(2) != 0) {
 					for (k = yc; k < j; k++) {
 						rv = GenerateRnd(2);
-						dungeon[i + 1][k] = rv;
+						ctx.dungeon[i + 1][k] = rv;
 					}
 				}
 				ys = 0;
@@ -1117,19 +1112,19 @@ static void DRLG_L3FillStraights()
 	}
 }
 
-static void DRLG_L3Edges()
+static void DRLG_L3Edges(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
-		dungeon[DMAXX - 1][j] = 0;
+		ctx.dungeon[DMAXX - 1][j] = 0;
 	}
 	for (i = 0; i < DMAXX; i++) {
-		dungeon[i][DMAXY - 1] = 0;
+		ctx.dungeon[i][DMAXY - 1] = 0;
 	}
 }
 
-static int DRLG_L3GetFloorArea()
+static int DRLG_L3GetFloorArea(DungeonContext &ctx)
 {
 	int i, j, gfa;
 
@@ -1137,20 +1132,20 @@ static int DRLG_L3GetFloorArea()
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			gfa += dungeon[i][j];
+			gfa += ctx.dungeon[i][j];
 		}
 	}
 
 	return gfa;
 }
 
-static void DRLG_L3MakeMegas()
+static void DRLG_L3MakeMegas(DungeonContext &ctx)
 {
 	int i, j, v, rv;
 
 	for (j = 0; j < DMAXY - 1; j++) {
 		for (i = 0; i < DMAXX - 1; i++) {
-			v = dungeon[i + 1][j + 1] + 2 * dungeon[i][j + 1] + 4 * dungeon[i + 1][j] + 8 * dungeon[i][j];
+			v = ctx.dungeon[i + 1][j + 1] + 2 * ctx.dungeon[i][j + 1] + 4 * ctx.dungeon[i + 1][j] + 8 * ctx.dungeon[i][j];
 			if (v == 6) {
 				rv = GenerateRnd(2);
 				if (rv == 0) {
@@ -1167,16 +1162,16 @@ static void DRLG_L3MakeMegas()
 					v = 14;
 				}
 			}
-			dungeon[i][j] = L3ConvTbl[v];
+			ctx.dungeon[i][j] = L3ConvTbl[v];
 		}
-		dungeon[DMAXX - 1][j] = 8;
+		ctx.dungeon[DMAXX - 1][j] = 8;
 	}
 	for (i = 0; i < DMAXX; i++) {
-		dungeon[i][DMAXY - 1] = 8;
+		ctx.dungeon[i][DMAXY - 1] = 8;
 	}
 }
 
-static void DRLG_L3River()
+static void DRLG_L3River(DungeonContext &ctx)
 {
 	int rx, ry, px, py, dir, nodir, nodir2, dircheck;
 	int river[3][100];
@@ -1197,12 +1192,12 @@ static void DRLG_L3River()
 			ry = 0;
 			i = 0;
 			// BUGFIX: Replace with `(ry >= DMAXY || dungeon[rx][ry] < 25 || dungeon[rx][ry] > 28) && i < 100` (fixed)
-			while ((ry >= DMAXY || dungeon[rx][ry] < 25 || dungeon[rx][ry] > 28) && i < 100) {
+			while ((ry >= DMAXY || ctx.dungeon[rx][ry] < 25 || ctx.dungeon[rx][ry] > 28) && i < 100) {
 				rx = GenerateRnd(DMAXX);
 				ry = GenerateRnd(DMAXY);
 				i++;
 				// BUGFIX: Move `ry < DMAXY` check before dungeon checks (fixed)
-				while (ry < DMAXY && (dungeon[rx][ry] < 25 || dungeon[rx][ry] > 28)) {
+				while (ry < DMAXY && (ctx.dungeon[rx][ry] < 25 || ctx.dungeon[rx][ry] > 28)) {
 					rx++;
 					if (rx >= DMAXX) {
 						rx = 0;
@@ -1216,7 +1211,7 @@ static void DRLG_L3River()
 			if (i >= 100) {
 				return;
 			}
-			switch (dungeon[rx][ry]) {
+			switch (ctx.dungeon[rx][ry]) {
 			case 25:
 				dir = 3;
 				nodir = 2;
@@ -1268,7 +1263,7 @@ static void DRLG_L3River()
 				if (dir == 3 && rx > 0) {
 					rx--;
 				}
-				if (dungeon[rx][ry] == 7) {
+				if (ctx.dungeon[rx][ry] == 7) {
 					dircheck = 0;
 					if (dir < 2) {
 						river[2][riveramt] = (BYTE)GenerateRnd(2) + 17;
@@ -1326,7 +1321,7 @@ static void DRLG_L3River()
 				}
 			}
 			// BUGFIX: Check `ry >= 2` (fixed)
-			if (dir == 0 && ry >= 2 && dungeon[rx][ry - 1] == 10 && dungeon[rx][ry - 2] == 8) {
+			if (dir == 0 && ry >= 2 && ctx.dungeon[rx][ry - 1] == 10 && ctx.dungeon[rx][ry - 2] == 8) {
 				river[0][riveramt] = rx;
 				river[1][riveramt] = ry - 1;
 				river[2][riveramt] = 24;
@@ -1339,7 +1334,7 @@ static void DRLG_L3River()
 				bail = true;
 			}
 			// BUGFIX: Check `ry + 2 < DMAXY` (fixed)
-			if (dir == 1 && ry + 2 < DMAXY && dungeon[rx][ry + 1] == 2 && dungeon[rx][ry + 2] == 8) {
+			if (dir == 1 && ry + 2 < DMAXY && ctx.dungeon[rx][ry + 1] == 2 && ctx.dungeon[rx][ry + 2] == 8) {
 				river[0][riveramt] = rx;
 				river[1][riveramt] = ry + 1;
 				river[2][riveramt] = 42;
@@ -1352,7 +1347,7 @@ static void DRLG_L3River()
 				bail = true;
 			}
 			// BUGFIX: Check `rx + 2 < DMAXX` (fixed)
-			if (dir == 2 && rx + 2 < DMAXX && dungeon[rx + 1][ry] == 4 && dungeon[rx + 2][ry] == 8) {
+			if (dir == 2 && rx + 2 < DMAXX && ctx.dungeon[rx + 1][ry] == 4 && ctx.dungeon[rx + 2][ry] == 8) {
 				river[0][riveramt] = rx + 1;
 				river[1][riveramt] = ry;
 				river[2][riveramt] = 43;
@@ -1365,7 +1360,7 @@ static void DRLG_L3River()
 				bail = true;
 			}
 			// BUGFIX: Check `rx >= 2` (fixed)
-			if (dir == 3 && rx >= 2 && dungeon[rx - 1][ry] == 9 && dungeon[rx - 2][ry] == 8) {
+			if (dir == 3 && rx >= 2 && ctx.dungeon[rx - 1][ry] == 9 && ctx.dungeon[rx - 2][ry] == 8) {
 				river[0][riveramt] = rx - 1;
 				river[1][riveramt] = ry;
 				river[2][riveramt] = 23;
@@ -1388,13 +1383,13 @@ static void DRLG_L3River()
 				lpcnt++;
 				bridge = GenerateRnd(riveramt);
 				if ((river[2][bridge] == 15 || river[2][bridge] == 16)
-				    && dungeon[river[0][bridge]][river[1][bridge] - 1] == 7
-				    && dungeon[river[0][bridge]][river[1][bridge] + 1] == 7) {
+				    && ctx.dungeon[river[0][bridge]][river[1][bridge] - 1] == 7
+				    && ctx.dungeon[river[0][bridge]][river[1][bridge] + 1] == 7) {
 					found = 1;
 				}
 				if ((river[2][bridge] == 17 || river[2][bridge] == 18)
-				    && dungeon[river[0][bridge] - 1][river[1][bridge]] == 7
-				    && dungeon[river[0][bridge] + 1][river[1][bridge]] == 7) {
+				    && ctx.dungeon[river[0][bridge] - 1][river[1][bridge]] == 7
+				    && ctx.dungeon[river[0][bridge] + 1][river[1][bridge]] == 7) {
 					found = 2;
 				}
 				for (i = 0; i < riveramt && found != 0; i++) {
@@ -1418,7 +1413,7 @@ static void DRLG_L3River()
 				}
 				rivercnt++;
 				for (bridge = 0; bridge <= riveramt; bridge++) {
-					dungeon[river[0][bridge]][river[1][bridge]] = river[2][bridge];
+					ctx.dungeon[river[0][bridge]][river[1][bridge]] = river[2][bridge];
 				}
 			} else {
 				bail = false;
@@ -1427,9 +1422,9 @@ static void DRLG_L3River()
 	}
 }
 
-static bool DRLG_L3Spawn(int x, int y, int *totarea);
+static bool DRLG_L3Spawn(DungeonContext &ctx, int x, int y, int *totarea);
 
-static bool DRLG_L3SpawnEdge(int x, int y, int *totarea)
+static bool DRLG_L3SpawnEdge(DungeonContext &ctx, int x, int y, int *totarea)
 {
 	BYTE i;
 	static BYTE spawntable[15] = { 0x00, 0x0A, 0x43, 0x05, 0x2c, 0x06, 0x09, 0x00, 0x00, 0x1c, 0x83, 0x06, 0x09, 0x0A, 0x05 };
@@ -1440,46 +1435,46 @@ static bool DRLG_L3SpawnEdge(int x, int y, int *totarea)
 	if (x < 0 || y < 0 || x >= DMAXX || y >= DMAXY) {
 		return true;
 	}
-	if ((dungeon[x][y] & 0x80) != 0) {
+	if ((ctx.dungeon[x][y] & 0x80) != 0) {
 		return false;
 	}
-	if (dungeon[x][y] > 15) {
+	if (ctx.dungeon[x][y] > 15) {
 		return true;
 	}
 
-	i = dungeon[x][y];
-	dungeon[x][y] |= 0x80;
+	i = ctx.dungeon[x][y];
+	ctx.dungeon[x][y] |= 0x80;
 	*totarea += 1;
 
-	if ((spawntable[i] & 8) != 0 && DRLG_L3SpawnEdge(x, y - 1, totarea)) {
+	if ((spawntable[i] & 8) != 0 && DRLG_L3SpawnEdge(ctx, x, y - 1, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 4) != 0 && DRLG_L3SpawnEdge(x, y + 1, totarea)) {
+	if ((spawntable[i] & 4) != 0 && DRLG_L3SpawnEdge(ctx, x, y + 1, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 2) != 0 && DRLG_L3SpawnEdge(x + 1, y, totarea)) {
+	if ((spawntable[i] & 2) != 0 && DRLG_L3SpawnEdge(ctx, x + 1, y, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 1) != 0 && DRLG_L3SpawnEdge(x - 1, y, totarea)) {
+	if ((spawntable[i] & 1) != 0 && DRLG_L3SpawnEdge(ctx, x - 1, y, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 0x80) != 0 && DRLG_L3Spawn(x, y - 1, totarea)) {
+	if ((spawntable[i] & 0x80) != 0 && DRLG_L3Spawn(ctx, x, y - 1, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 0x40) != 0 && DRLG_L3Spawn(x, y + 1, totarea)) {
+	if ((spawntable[i] & 0x40) != 0 && DRLG_L3Spawn(ctx, x, y + 1, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 0x20) != 0 && DRLG_L3Spawn(x + 1, y, totarea)) {
+	if ((spawntable[i] & 0x20) != 0 && DRLG_L3Spawn(ctx, x + 1, y, totarea)) {
 		return true;
 	}
-	if ((spawntable[i] & 0x10) != 0 && DRLG_L3Spawn(x - 1, y, totarea)) {
+	if ((spawntable[i] & 0x10) != 0 && DRLG_L3Spawn(ctx, x - 1, y, totarea)) {
 		return true;
 	}
 
 	return false;
 }
 
-static bool DRLG_L3Spawn(int x, int y, int *totarea)
+static bool DRLG_L3Spawn(DungeonContext &ctx, int x, int y, int *totarea)
 {
 	BYTE i;
 	static BYTE spawntable[15] = { 0x00, 0x0A, 0x03, 0x05, 0x0C, 0x06, 0x09, 0x00, 0x00, 0x0C, 0x03, 0x06, 0x09, 0x0A, 0x05 };
@@ -1490,41 +1485,41 @@ static bool DRLG_L3Spawn(int x, int y, int *totarea)
 	if (x < 0 || y < 0 || x >= DMAXX || y >= DMAXY) {
 		return true;
 	}
-	if ((dungeon[x][y] & 0x80) != 0) {
+	if ((ctx.dungeon[x][y] & 0x80) != 0) {
 		return false;
 	}
-	if (dungeon[x][y] > 15) {
+	if (ctx.dungeon[x][y] > 15) {
 		return true;
 	}
 
-	i = dungeon[x][y];
-	dungeon[x][y] |= 0x80;
+	i = ctx.dungeon[x][y];
+	ctx.dungeon[x][y] |= 0x80;
 	*totarea += 1;
 
 	if (i != 8) {
-		if ((spawntable[i] & 8) != 0 && DRLG_L3SpawnEdge(x, y - 1, totarea)) {
+		if ((spawntable[i] & 8) != 0 && DRLG_L3SpawnEdge(ctx, x, y - 1, totarea)) {
 			return true;
 		}
-		if ((spawntable[i] & 4) != 0 && DRLG_L3SpawnEdge(x, y + 1, totarea)) {
+		if ((spawntable[i] & 4) != 0 && DRLG_L3SpawnEdge(ctx, x, y + 1, totarea)) {
 			return true;
 		}
-		if ((spawntable[i] & 2) != 0 && DRLG_L3SpawnEdge(x + 1, y, totarea)) {
+		if ((spawntable[i] & 2) != 0 && DRLG_L3SpawnEdge(ctx, x + 1, y, totarea)) {
 			return true;
 		}
-		if ((spawntable[i] & 1) != 0 && DRLG_L3SpawnEdge(x - 1, y, totarea)) {
+		if ((spawntable[i] & 1) != 0 && DRLG_L3SpawnEdge(ctx, x - 1, y, totarea)) {
 			return true;
 		}
 	} else {
-		if (DRLG_L3Spawn(x + 1, y, totarea)) {
+		if (DRLG_L3Spawn(ctx, x + 1, y, totarea)) {
 			return true;
 		}
-		if (DRLG_L3Spawn(x - 1, y, totarea)) {
+		if (DRLG_L3Spawn(ctx, x - 1, y, totarea)) {
 			return true;
 		}
-		if (DRLG_L3Spawn(x, y + 1, totarea)) {
+		if (DRLG_L3Spawn(ctx, x, y + 1, totarea)) {
 			return true;
 		}
-		if (DRLG_L3Spawn(x, y - 1, totarea)) {
+		if (DRLG_L3Spawn(ctx, x, y - 1, totarea)) {
 			return true;
 		}
 	}
@@ -1537,7 +1532,7 @@ static bool DRLG_L3Spawn(int x, int y, int *totarea)
  * an area of at most 40 tiles and disconnected from the map edge.
  * If it finds one, converts it to lava tiles and sets lavapool to true.
  */
-static void DRLG_L3Pool()
+static void DRLG_L3Pool(DungeonContext &ctx)
 {
 	int i, j, dunx, duny, totarea, poolchance;
 	bool found;
@@ -1546,28 +1541,28 @@ static void DRLG_L3Pool()
 
 	for (duny = 0; duny < DMAXY; duny++) {
 		for (dunx = 0; dunx < DMAXY; dunx++) {
-			if (dungeon[dunx][duny] != 8) {
+			if (ctx.dungeon[dunx][duny] != 8) {
 				continue;
 			}
-			dungeon[dunx][duny] |= 0x80;
+			ctx.dungeon[dunx][duny] |= 0x80;
 			totarea = 1;
 			if (dunx + 1 < DMAXX) {
-				found = DRLG_L3Spawn(dunx + 1, duny, &totarea);
+				found = DRLG_L3Spawn(ctx, dunx + 1, duny, &totarea);
 			} else {
 				found = true;
 			}
 			if (dunx - 1 > 0 && !found) {
-				found = DRLG_L3Spawn(dunx - 1, duny, &totarea);
+				found = DRLG_L3Spawn(ctx, dunx - 1, duny, &totarea);
 			} else {
 				found = true;
 			}
 			if (duny + 1 < DMAXY && !found) {
-				found = DRLG_L3Spawn(dunx, duny + 1, &totarea);
+				found = DRLG_L3Spawn(ctx, dunx, duny + 1, &totarea);
 			} else {
 				found = true;
 			}
 			if (duny - 1 > 0 && !found) {
-				found = DRLG_L3Spawn(dunx, duny - 1, &totarea);
+				found = DRLG_L3Spawn(ctx, dunx, duny - 1, &totarea);
 			} else {
 				found = true;
 			}
@@ -1576,14 +1571,14 @@ static void DRLG_L3Pool()
 				for (i = std::max(dunx - totarea, 0); i < std::min(dunx + totarea, DMAXX); i++) {
 					// BUGFIX: In the following swap the order to first do the
 					// index checks and only then access dungeon[i][j] (fixed)
-					if ((dungeon[i][j] & 0x80) != 0) {
-						dungeon[i][j] &= ~0x80;
+					if ((ctx.dungeon[i][j] & 0x80) != 0) {
+						ctx.dungeon[i][j] &= ~0x80;
 						if (totarea > 4 && poolchance < 25 && !found) {
-							k = poolsub[dungeon[i][j]];
+							k = poolsub[ctx.dungeon[i][j]];
 							if (k != 0 && k <= 37) {
-								dungeon[i][j] = k;
+								ctx.dungeon[i][j] = k;
 							}
-							lavapool = 1;
+							ctx.lavapool = 1;
 						}
 					}
 				}
@@ -1592,31 +1587,31 @@ static void DRLG_L3Pool()
 	}
 }
 
-static void DRLG_L3PoolFix()
+static void DRLG_L3PoolFix(DungeonContext &ctx)
 {
 	int dunx, duny;
 
 	for (duny = 1; duny < DMAXY - 1; duny++) {     // BUGFIX: Change '0' to '1' and 'DMAXY' to 'DMAXY - 1' (fixed)
 		for (dunx = 1; dunx < DMAXX - 1; dunx++) { // BUGFIX: Change '0' to '1' and 'DMAXX' to 'DMAXX - 1' (fixed)
-			if (dungeon[dunx][duny] == 8) {
-				if (dungeon[dunx - 1][duny - 1] >= 25 && dungeon[dunx - 1][duny - 1] <= 41
-				    && dungeon[dunx - 1][duny] >= 25 && dungeon[dunx - 1][duny] <= 41
-				    && dungeon[dunx - 1][duny + 1] >= 25 && dungeon[dunx - 1][duny + 1] <= 41
-				    && dungeon[dunx][duny - 1] >= 25 && dungeon[dunx][duny - 1] <= 41
-				    && dungeon[dunx][duny + 1] >= 25 && dungeon[dunx][duny + 1] <= 41
-				    && dungeon[dunx + 1][duny - 1] >= 25 && dungeon[dunx + 1][duny - 1] <= 41
-				    && dungeon[dunx + 1][duny] >= 25 && dungeon[dunx + 1][duny] <= 41
-				    && dungeon[dunx + 1][duny + 1] >= 25 && dungeon[dunx + 1][duny + 1] <= 41) {
-					dungeon[dunx][duny] = 33;
-				} else if (dungeon[dunx + 1][duny] == 35 || dungeon[dunx + 1][duny] == 37) {
-					dungeon[dunx][duny] = 33;
+			if (ctx.dungeon[dunx][duny] == 8) {
+				if (ctx.dungeon[dunx - 1][duny - 1] >= 25 && ctx.dungeon[dunx - 1][duny - 1] <= 41
+				    && ctx.dungeon[dunx - 1][duny] >= 25 && ctx.dungeon[dunx - 1][duny] <= 41
+				    && ctx.dungeon[dunx - 1][duny + 1] >= 25 && ctx.dungeon[dunx - 1][duny + 1] <= 41
+				    && ctx.dungeon[dunx][duny - 1] >= 25 && ctx.dungeon[dunx][duny - 1] <= 41
+				    && ctx.dungeon[dunx][duny + 1] >= 25 && ctx.dungeon[dunx][duny + 1] <= 41
+				    && ctx.dungeon[dunx + 1][duny - 1] >= 25 && ctx.dungeon[dunx + 1][duny - 1] <= 41
+				    && ctx.dungeon[dunx + 1][duny] >= 25 && ctx.dungeon[dunx + 1][duny] <= 41
+				    && ctx.dungeon[dunx + 1][duny + 1] >= 25 && ctx.dungeon[dunx + 1][duny + 1] <= 41) {
+					ctx.dungeon[dunx][duny] = 33;
+				} else if (ctx.dungeon[dunx + 1][duny] == 35 || ctx.dungeon[dunx + 1][duny] == 37) {
+					ctx.dungeon[dunx][duny] = 33;
 				}
 			}
 		}
 	}
 }
 
-static bool DRLG_L3PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
+static bool DRLG_L3PlaceMiniSet(DungeonContext &ctx, const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
 {
 	int sx, sy, sw, sh, xx, yy, i, ii, numt, trys;
 	bool found;
@@ -1651,10 +1646,10 @@ static bool DRLG_L3PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 			ii = 2;
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1678,7 +1673,7 @@ static bool DRLG_L3PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 		for (yy = 0; yy < sh; yy++) {
 			for (xx = 0; xx < sw; xx++) {
 				if (miniset[ii] != 0) {
-					dungeon[xx + sx][yy + sy] = miniset[ii];
+					ctx.dungeon[xx + sx][yy + sy] = miniset[ii];
 				}
 				ii++;
 			}
@@ -1686,18 +1681,18 @@ static bool DRLG_L3PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 	}
 
 	if (setview) {
-		ViewX = 2 * sx + 17;
-		ViewY = 2 * sy + 19;
+		ctx.ViewX = 2 * sx + 17;
+		ctx.ViewY = 2 * sy + 19;
 	}
 	if (ldir == 0) {
-		LvlViewX = 2 * sx + 17;
-		LvlViewY = 2 * sy + 19;
+		ctx.LvlViewX = 2 * sx + 17;
+		ctx.LvlViewY = 2 * sy + 19;
 	}
 
 	return false;
 }
 
-static void DRLG_L3PlaceRndSet(const BYTE *miniset, int rndper)
+static void DRLG_L3PlaceRndSet(DungeonContext &ctx, const BYTE *miniset, int rndper)
 {
 	int sx, sy, sw, sh, xx, yy, ii, kk;
 	bool found;
@@ -1711,10 +1706,10 @@ static void DRLG_L3PlaceRndSet(const BYTE *miniset, int rndper)
 			ii = 2;
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1724,16 +1719,16 @@ static void DRLG_L3PlaceRndSet(const BYTE *miniset, int rndper)
 			if (miniset[kk] >= 84 && miniset[kk] <= 100 && found) {
 				// BUGFIX: accesses to dungeon can go out of bounds (fixed)
 				// BUGFIX: Comparisons vs 100 should use same tile as comparisons vs 84.
-				if (sx - 1 >= 0 && dungeon[sx - 1][sy] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (sx - 1 >= 0 && ctx.dungeon[sx - 1][sy] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (sx + 1 < 40 && sx - 1 >= 0 && dungeon[sx + 1][sy] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (sx + 1 < 40 && sx - 1 >= 0 && ctx.dungeon[sx + 1][sy] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (sy + 1 < 40 && sx - 1 >= 0 && dungeon[sx][sy + 1] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (sy + 1 < 40 && sx - 1 >= 0 && ctx.dungeon[sx][sy + 1] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (sy - 1 >= 0 && sx - 1 >= 0 && dungeon[sx][sy - 1] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (sy - 1 >= 0 && sx - 1 >= 0 && ctx.dungeon[sx][sy - 1] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
 			}
@@ -1741,7 +1736,7 @@ static void DRLG_L3PlaceRndSet(const BYTE *miniset, int rndper)
 				for (yy = 0; yy < sh; yy++) {
 					for (xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							ctx.dungeon[xx + sx][yy + sy] = miniset[kk];
 						}
 						kk++;
 					}
@@ -1751,7 +1746,7 @@ static void DRLG_L3PlaceRndSet(const BYTE *miniset, int rndper)
 	}
 }
 
-bool drlg_l3_hive_rnd_piece(const BYTE *miniset, int rndper)
+bool drlg_l3_hive_rnd_piece(DungeonContext &ctx, const BYTE *miniset, int rndper)
 {
 	int sx, sy, sw, sh, xx, yy, ii, kk;
 	bool found;
@@ -1767,10 +1762,10 @@ bool drlg_l3_hive_rnd_piece(const BYTE *miniset, int rndper)
 			ii = 2;
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1780,16 +1775,16 @@ bool drlg_l3_hive_rnd_piece(const BYTE *miniset, int rndper)
 			if (miniset[kk] >= 84 && miniset[kk] <= 100 && found) {
 				// BUGFIX: accesses to dungeon can go out of bounds
 				// BUGFIX: Comparisons vs 100 should use same tile as comparisons vs 84.
-				if (dungeon[sx - 1][sy] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (ctx.dungeon[sx - 1][sy] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (dungeon[sx + 1][sy] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (ctx.dungeon[sx + 1][sy] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (dungeon[sx][sy + 1] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (ctx.dungeon[sx][sy + 1] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
-				if (dungeon[sx][sy - 1] >= 84 && dungeon[sx - 1][sy] <= 100) {
+				if (ctx.dungeon[sx][sy - 1] >= 84 && ctx.dungeon[sx - 1][sy] <= 100) {
 					found = false;
 				}
 			}
@@ -1798,7 +1793,7 @@ bool drlg_l3_hive_rnd_piece(const BYTE *miniset, int rndper)
 				for (yy = 0; yy < sh; yy++) {
 					for (xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							ctx.dungeon[xx + sx][yy + sy] = miniset[kk];
 						}
 						kk++;
 					}
@@ -1810,26 +1805,26 @@ bool drlg_l3_hive_rnd_piece(const BYTE *miniset, int rndper)
 	return placed;
 }
 
-static bool WoodVertU(int i, int y)
+static bool WoodVertU(DungeonContext &ctx, int i, int y)
 {
-	if ((dungeon[i + 1][y] > 152 || dungeon[i + 1][y] < 130)
-	    && (dungeon[i - 1][y] > 152 || dungeon[i - 1][y] < 130)) {
-		if (dungeon[i][y] == 7) {
+	if ((ctx.dungeon[i + 1][y] > 152 || ctx.dungeon[i + 1][y] < 130)
+	    && (ctx.dungeon[i - 1][y] > 152 || ctx.dungeon[i - 1][y] < 130)) {
+		if (ctx.dungeon[i][y] == 7) {
 			return true;
 		}
-		if (dungeon[i][y] == 10) {
+		if (ctx.dungeon[i][y] == 10) {
 			return true;
 		}
-		if (dungeon[i][y] == 126) {
+		if (ctx.dungeon[i][y] == 126) {
 			return true;
 		}
-		if (dungeon[i][y] == 129) {
+		if (ctx.dungeon[i][y] == 129) {
 			return true;
 		}
-		if (dungeon[i][y] == 134) {
+		if (ctx.dungeon[i][y] == 134) {
 			return true;
 		}
-		if (dungeon[i][y] == 136) {
+		if (ctx.dungeon[i][y] == 136) {
 			return true;
 		}
 	}
@@ -1837,20 +1832,20 @@ static bool WoodVertU(int i, int y)
 	return false;
 }
 
-static bool WoodVertD(int i, int y)
+static bool WoodVertD(DungeonContext &ctx, int i, int y)
 {
-	if ((dungeon[i + 1][y] > 152 || dungeon[i + 1][y] < 130)
-	    && (dungeon[i - 1][y] > 152 || dungeon[i - 1][y] < 130)) {
-		if (dungeon[i][y] == 7) {
+	if ((ctx.dungeon[i + 1][y] > 152 || ctx.dungeon[i + 1][y] < 130)
+	    && (ctx.dungeon[i - 1][y] > 152 || ctx.dungeon[i - 1][y] < 130)) {
+		if (ctx.dungeon[i][y] == 7) {
 			return true;
 		}
-		if (dungeon[i][y] == 2) {
+		if (ctx.dungeon[i][y] == 2) {
 			return true;
 		}
-		if (dungeon[i][y] == 134) {
+		if (ctx.dungeon[i][y] == 134) {
 			return true;
 		}
-		if (dungeon[i][y] == 136) {
+		if (ctx.dungeon[i][y] == 136) {
 			return true;
 		}
 	}
@@ -1858,26 +1853,26 @@ static bool WoodVertD(int i, int y)
 	return false;
 }
 
-static bool WoodHorizL(int x, int j)
+static bool WoodHorizL(DungeonContext &ctx, int x, int j)
 {
-	if ((dungeon[x][j + 1] > 152 || dungeon[x][j + 1] < 130)
-	    && (dungeon[x][j - 1] > 152 || dungeon[x][j - 1] < 130)) {
-		if (dungeon[x][j] == 7) {
+	if ((ctx.dungeon[x][j + 1] > 152 || ctx.dungeon[x][j + 1] < 130)
+	    && (ctx.dungeon[x][j - 1] > 152 || ctx.dungeon[x][j - 1] < 130)) {
+		if (ctx.dungeon[x][j] == 7) {
 			return true;
 		}
-		if (dungeon[x][j] == 9) {
+		if (ctx.dungeon[x][j] == 9) {
 			return true;
 		}
-		if (dungeon[x][j] == 121) {
+		if (ctx.dungeon[x][j] == 121) {
 			return true;
 		}
-		if (dungeon[x][j] == 124) {
+		if (ctx.dungeon[x][j] == 124) {
 			return true;
 		}
-		if (dungeon[x][j] == 135) {
+		if (ctx.dungeon[x][j] == 135) {
 			return true;
 		}
-		if (dungeon[x][j] == 137) {
+		if (ctx.dungeon[x][j] == 137) {
 			return true;
 		}
 	}
@@ -1885,20 +1880,20 @@ static bool WoodHorizL(int x, int j)
 	return false;
 }
 
-static bool WoodHorizR(int x, int j)
+static bool WoodHorizR(DungeonContext &ctx, int x, int j)
 {
-	if ((dungeon[x][j + 1] > 152 || dungeon[x][j + 1] < 130)
-	    && (dungeon[x][j - 1] > 152 || dungeon[x][j - 1] < 130)) {
-		if (dungeon[x][j] == 7) {
+	if ((ctx.dungeon[x][j + 1] > 152 || ctx.dungeon[x][j + 1] < 130)
+	    && (ctx.dungeon[x][j - 1] > 152 || ctx.dungeon[x][j - 1] < 130)) {
+		if (ctx.dungeon[x][j] == 7) {
 			return true;
 		}
-		if (dungeon[x][j] == 4) {
+		if (ctx.dungeon[x][j] == 4) {
 			return true;
 		}
-		if (dungeon[x][j] == 135) {
+		if (ctx.dungeon[x][j] == 135) {
 			return true;
 		}
-		if (dungeon[x][j] == 137) {
+		if (ctx.dungeon[x][j] == 137) {
 			return true;
 		}
 	}
@@ -1906,23 +1901,23 @@ static bool WoodHorizR(int x, int j)
 	return false;
 }
 
-void AddFenceDoors()
+void AddFenceDoors(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 7) {
-				if (dungeon[i - 1][j] <= 152 && dungeon[i - 1][j] >= 130
-				    && dungeon[i + 1][j] <= 152 && dungeon[i + 1][j] >= 130) {
-					dungeon[i][j] = 146;
+			if (ctx.dungeon[i][j] == 7) {
+				if (ctx.dungeon[i - 1][j] <= 152 && ctx.dungeon[i - 1][j] >= 130
+				    && ctx.dungeon[i + 1][j] <= 152 && ctx.dungeon[i + 1][j] >= 130) {
+					ctx.dungeon[i][j] = 146;
 					continue;
 				}
 			}
-			if (dungeon[i][j] == 7) {
-				if (dungeon[i][j - 1] <= 152 && dungeon[i][j - 1] >= 130
-				    && dungeon[i][j + 1] <= 152 && dungeon[i][j + 1] >= 130) {
-					dungeon[i][j] = 147;
+			if (ctx.dungeon[i][j] == 7) {
+				if (ctx.dungeon[i][j - 1] <= 152 && ctx.dungeon[i][j - 1] >= 130
+				    && ctx.dungeon[i][j + 1] <= 152 && ctx.dungeon[i][j + 1] >= 130) {
+					ctx.dungeon[i][j] = 147;
 					continue;
 				}
 			}
@@ -1930,47 +1925,47 @@ void AddFenceDoors()
 	}
 }
 
-void FenceDoorFix()
+void FenceDoorFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 146) {
-				if (dungeon[i + 1][j] > 152 || dungeon[i + 1][j] < 130
-				    || dungeon[i - 1][j] > 152 || dungeon[i - 1][j] < 130) {
-					dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 146) {
+				if (ctx.dungeon[i + 1][j] > 152 || ctx.dungeon[i + 1][j] < 130
+				    || ctx.dungeon[i - 1][j] > 152 || ctx.dungeon[i - 1][j] < 130) {
+					ctx.dungeon[i][j] = 7;
 					continue;
 				}
 			}
-			if (dungeon[i][j] == 146) {
-				if (dungeon[i + 1][j] != 130 && dungeon[i - 1][j] != 130
-				    && dungeon[i + 1][j] != 132 && dungeon[i - 1][j] != 132
-				    && dungeon[i + 1][j] != 133 && dungeon[i - 1][j] != 133
-				    && dungeon[i + 1][j] != 134 && dungeon[i - 1][j] != 134
-				    && dungeon[i + 1][j] != 136 && dungeon[i - 1][j] != 136
-				    && dungeon[i + 1][j] != 138 && dungeon[i - 1][j] != 138
-				    && dungeon[i + 1][j] != 140 && dungeon[i - 1][j] != 140) {
-					dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 146) {
+				if (ctx.dungeon[i + 1][j] != 130 && ctx.dungeon[i - 1][j] != 130
+				    && ctx.dungeon[i + 1][j] != 132 && ctx.dungeon[i - 1][j] != 132
+				    && ctx.dungeon[i + 1][j] != 133 && ctx.dungeon[i - 1][j] != 133
+				    && ctx.dungeon[i + 1][j] != 134 && ctx.dungeon[i - 1][j] != 134
+				    && ctx.dungeon[i + 1][j] != 136 && ctx.dungeon[i - 1][j] != 136
+				    && ctx.dungeon[i + 1][j] != 138 && ctx.dungeon[i - 1][j] != 138
+				    && ctx.dungeon[i + 1][j] != 140 && ctx.dungeon[i - 1][j] != 140) {
+					ctx.dungeon[i][j] = 7;
 					continue;
 				}
 			}
-			if (dungeon[i][j] == 147) {
-				if (dungeon[i][j + 1] > 152 || dungeon[i][j + 1] < 130
-				    || dungeon[i][j - 1] > 152 || dungeon[i][j - 1] < 130) {
-					dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 147) {
+				if (ctx.dungeon[i][j + 1] > 152 || ctx.dungeon[i][j + 1] < 130
+				    || ctx.dungeon[i][j - 1] > 152 || ctx.dungeon[i][j - 1] < 130) {
+					ctx.dungeon[i][j] = 7;
 					continue;
 				}
 			}
-			if (dungeon[i][j] == 147) {
-				if (dungeon[i][j + 1] != 131 && dungeon[i][j - 1] != 131
-				    && dungeon[i][j + 1] != 132 && dungeon[i][j - 1] != 132
-				    && dungeon[i][j + 1] != 133 && dungeon[i][j - 1] != 133
-				    && dungeon[i][j + 1] != 135 && dungeon[i][j - 1] != 135
-				    && dungeon[i][j + 1] != 137 && dungeon[i][j - 1] != 137
-				    && dungeon[i][j + 1] != 138 && dungeon[i][j - 1] != 138
-				    && dungeon[i][j + 1] != 139 && dungeon[i][j - 1] != 139) {
-					dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 147) {
+				if (ctx.dungeon[i][j + 1] != 131 && ctx.dungeon[i][j - 1] != 131
+				    && ctx.dungeon[i][j + 1] != 132 && ctx.dungeon[i][j - 1] != 132
+				    && ctx.dungeon[i][j + 1] != 133 && ctx.dungeon[i][j - 1] != 133
+				    && ctx.dungeon[i][j + 1] != 135 && ctx.dungeon[i][j - 1] != 135
+				    && ctx.dungeon[i][j + 1] != 137 && ctx.dungeon[i][j - 1] != 137
+				    && ctx.dungeon[i][j + 1] != 138 && ctx.dungeon[i][j - 1] != 138
+				    && ctx.dungeon[i][j + 1] != 139 && ctx.dungeon[i][j - 1] != 139) {
+					ctx.dungeon[i][j] = 7;
 					continue;
 				}
 			}
@@ -1978,7 +1973,7 @@ void FenceDoorFix()
 	}
 }
 
-static void DRLG_L3Wood()
+static void DRLG_L3Wood(DungeonContext &ctx)
 {
 #if (_MSC_VER >= 1920)
 	volatile // visual studio 2019 throws internal compiler error without it, see #708
@@ -1990,96 +1985,96 @@ static void DRLG_L3Wood()
 
 	for (j = 1; j < DMAXY - 1; j++) {     // BUGFIX: Change '0' to '1' (fixed)
 		for (i = 1; i < DMAXX - 1; i++) { // BUGFIX: Change '0' to '1' (fixed)
-			if (dungeon[i][j] == 10 && GenerateRnd(2) != 0) {
+			if (ctx.dungeon[i][j] == 10 && GenerateRnd(2) != 0) {
 				x = i;
-				while (dungeon[x][j] == 10) {
+				while (ctx.dungeon[x][j] == 10) {
 					x++;
 				}
 				x--;
 				if (x - i > 0) {
-					dungeon[i][j] = 127;
+					ctx.dungeon[i][j] = 127;
 					for (xx = i + 1; xx < x; xx++) {
 						if (GenerateRnd(2) != 0) {
-							dungeon[xx][j] = 126;
+							ctx.dungeon[xx][j] = 126;
 						} else {
-							dungeon[xx][j] = 129;
+							ctx.dungeon[xx][j] = 129;
 						}
 					}
-					dungeon[x][j] = 128;
+					ctx.dungeon[x][j] = 128;
 				}
 			}
-			if (dungeon[i][j] == 9 && GenerateRnd(2) != 0) {
+			if (ctx.dungeon[i][j] == 9 && GenerateRnd(2) != 0) {
 				y = j;
-				while (dungeon[i][y] == 9) {
+				while (ctx.dungeon[i][y] == 9) {
 					y++;
 				}
 				y--;
 				if (y - j > 0) {
-					dungeon[i][j] = 123;
+					ctx.dungeon[i][j] = 123;
 					for (yy = j + 1; yy < y; yy++) {
 						if (GenerateRnd(2) != 0) {
-							dungeon[i][yy] = 121;
+							ctx.dungeon[i][yy] = 121;
 						} else {
-							dungeon[i][yy] = 124;
+							ctx.dungeon[i][yy] = 124;
 						}
 					}
-					dungeon[i][y] = 122;
+					ctx.dungeon[i][y] = 122;
 				}
 			}
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 10 && dungeon[i][j + 1] == 9 && GenerateRnd(2) != 0) {
-				dungeon[i][j] = 125;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 10 && ctx.dungeon[i][j + 1] == 9 && GenerateRnd(2) != 0) {
+				ctx.dungeon[i][j] = 125;
 				x = i + 1;
-				while (dungeon[x][j] == 10) {
+				while (ctx.dungeon[x][j] == 10) {
 					x++;
 				}
 				x--;
 				for (xx = i + 1; xx < x; xx++) {
 					if (GenerateRnd(2) != 0) {
-						dungeon[xx][j] = 126;
+						ctx.dungeon[xx][j] = 126;
 					} else {
-						dungeon[xx][j] = 129;
+						ctx.dungeon[xx][j] = 129;
 					}
 				}
-				dungeon[x][j] = 128;
+				ctx.dungeon[x][j] = 128;
 				y = j + 1;
-				while (dungeon[i][y] == 9) {
+				while (ctx.dungeon[i][y] == 9) {
 					y++;
 				}
 				y--;
 				for (yy = j + 1; yy < y; yy++) {
 					if (GenerateRnd(2) != 0) {
-						dungeon[i][yy] = 121;
+						ctx.dungeon[i][yy] = 121;
 					} else {
-						dungeon[i][yy] = 124;
+						ctx.dungeon[i][yy] = 124;
 					}
 				}
-				dungeon[i][y] = 122;
+				ctx.dungeon[i][y] = 122;
 			}
 		}
 	}
 
 	for (j = 1; j < DMAXY; j++) {     // BUGFIX: Change '0' to '1' (fixed)
 		for (i = 1; i < DMAXX; i++) { // BUGFIX: Change '0' to '1' (fixed)
-			if (dungeon[i][j] == 7 && GenerateRnd(1) == 0 && SkipThemeRoom(i, j)) {
+			if (ctx.dungeon[i][j] == 7 && GenerateRnd(1) == 0 && SkipThemeRoom(ctx, i, j)) {
 				rt = GenerateRnd(2);
 				if (rt == 0) {
 					y1 = j;
 					// BUGFIX: Check `y1 >= 0` first (fixed)
-					while (y1 >= 0 && WoodVertU(i, y1)) {
+					while (y1 >= 0 && WoodVertU(ctx, i, y1)) {
 						y1--;
 					}
 					y1++;
 					y2 = j;
 					// BUGFIX: Check `y2 < DMAXY` first (fixed)
-					while (y2 < DMAXY && WoodVertD(i, y2)) {
+					while (y2 < DMAXY && WoodVertD(ctx, i, y2)) {
 						y2++;
 					}
 					y2--;
 					skip = true;
-					if (dungeon[i][y1] == 7) {
+					if (ctx.dungeon[i][y1] == 7) {
 						skip = false;
 					}
-					if (dungeon[i][y2] == 7) {
+					if (ctx.dungeon[i][y2] == 7) {
 						skip = false;
 					}
 					if (y2 - y1 > 1 && skip) {
@@ -2088,30 +2083,30 @@ static void DRLG_L3Wood()
 							if (y == rp) {
 								continue;
 							}
-							if (dungeon[i][y] == 7) {
+							if (ctx.dungeon[i][y] == 7) {
 								if (GenerateRnd(2) != 0) {
-									dungeon[i][y] = 135;
+									ctx.dungeon[i][y] = 135;
 								} else {
-									dungeon[i][y] = 137;
+									ctx.dungeon[i][y] = 137;
 								}
 							}
-							if (dungeon[i][y] == 10) {
-								dungeon[i][y] = 131;
+							if (ctx.dungeon[i][y] == 10) {
+								ctx.dungeon[i][y] = 131;
 							}
-							if (dungeon[i][y] == 126) {
-								dungeon[i][y] = 133;
+							if (ctx.dungeon[i][y] == 126) {
+								ctx.dungeon[i][y] = 133;
 							}
-							if (dungeon[i][y] == 129) {
-								dungeon[i][y] = 133;
+							if (ctx.dungeon[i][y] == 129) {
+								ctx.dungeon[i][y] = 133;
 							}
-							if (dungeon[i][y] == 2) {
-								dungeon[i][y] = 139;
+							if (ctx.dungeon[i][y] == 2) {
+								ctx.dungeon[i][y] = 139;
 							}
-							if (dungeon[i][y] == 134) {
-								dungeon[i][y] = 138;
+							if (ctx.dungeon[i][y] == 134) {
+								ctx.dungeon[i][y] = 138;
 							}
-							if (dungeon[i][y] == 136) {
-								dungeon[i][y] = 138;
+							if (ctx.dungeon[i][y] == 136) {
+								ctx.dungeon[i][y] = 138;
 							}
 						}
 					}
@@ -2119,21 +2114,21 @@ static void DRLG_L3Wood()
 				if (rt == 1) {
 					x1 = i;
 					// BUGFIX: Check `x1 >= 0` first (fixed)
-					while (x1 >= 0 && WoodHorizL(x1, j)) {
+					while (x1 >= 0 && WoodHorizL(ctx, x1, j)) {
 						x1--;
 					}
 					x1++;
 					x2 = i;
 					// BUGFIX: Check `x2 < DMAXX` first (fixed)
-					while (x2 < DMAXX && WoodHorizR(x2, j)) {
+					while (x2 < DMAXX && WoodHorizR(ctx, x2, j)) {
 						x2++;
 					}
 					x2--;
 					skip = true;
-					if (dungeon[x1][j] == 7) {
+					if (ctx.dungeon[x1][j] == 7) {
 						skip = false;
 					}
-					if (dungeon[x2][j] == 7) {
+					if (ctx.dungeon[x2][j] == 7) {
 						skip = false;
 					}
 					if (x2 - x1 > 1 && skip) {
@@ -2142,30 +2137,30 @@ static void DRLG_L3Wood()
 							if (x == rp) {
 								continue;
 							}
-							if (dungeon[x][j] == 7) {
+							if (ctx.dungeon[x][j] == 7) {
 								if (GenerateRnd(2) != 0) {
-									dungeon[x][j] = 134;
+									ctx.dungeon[x][j] = 134;
 								} else {
-									dungeon[x][j] = 136;
+									ctx.dungeon[x][j] = 136;
 								}
 							}
-							if (dungeon[x][j] == 9) {
-								dungeon[x][j] = 130;
+							if (ctx.dungeon[x][j] == 9) {
+								ctx.dungeon[x][j] = 130;
 							}
-							if (dungeon[x][j] == 121) {
-								dungeon[x][j] = 132;
+							if (ctx.dungeon[x][j] == 121) {
+								ctx.dungeon[x][j] = 132;
 							}
-							if (dungeon[x][j] == 124) {
-								dungeon[x][j] = 132;
+							if (ctx.dungeon[x][j] == 124) {
+								ctx.dungeon[x][j] = 132;
 							}
-							if (dungeon[x][j] == 4) {
-								dungeon[x][j] = 140;
+							if (ctx.dungeon[x][j] == 4) {
+								ctx.dungeon[x][j] = 140;
 							}
-							if (dungeon[x][j] == 135) {
-								dungeon[x][j] = 138;
+							if (ctx.dungeon[x][j] == 135) {
+								ctx.dungeon[x][j] = 138;
 							}
-							if (dungeon[x][j] == 137) {
-								dungeon[x][j] = 138;
+							if (ctx.dungeon[x][j] == 137) {
+								ctx.dungeon[x][j] = 138;
 							}
 						}
 					}
@@ -2174,11 +2169,11 @@ static void DRLG_L3Wood()
 		}
 	}
 
-	AddFenceDoors();
-	FenceDoorFix();
+	AddFenceDoors(ctx);
+	FenceDoorFix(ctx);
 }
 
-static bool DRLG_L3Anvil()
+static bool DRLG_L3Anvil(DungeonContext &ctx)
 {
 	int sx, sy, sw, sh, xx, yy, ii, trys;
 	bool found;
@@ -2196,10 +2191,10 @@ static bool DRLG_L3Anvil()
 		ii = 2;
 		for (yy = 0; yy < sh && found; yy++) {
 			for (xx = 0; xx < sw && found; xx++) {
-				if (L3ANVIL[ii] != 0 && dungeon[xx + sx][yy + sy] != L3ANVIL[ii]) {
+				if (L3ANVIL[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != L3ANVIL[ii]) {
 					found = false;
 				}
-				if (dflags[xx + sx][yy + sy] != 0) {
+				if (ctx.dflags[xx + sx][yy + sy] != 0) {
 					found = false;
 				}
 				ii++;
@@ -2224,378 +2219,382 @@ static bool DRLG_L3Anvil()
 	for (yy = 0; yy < sh; yy++) {
 		for (xx = 0; xx < sw; xx++) {
 			if (L3ANVIL[ii] != 0) {
-				dungeon[xx + sx][yy + sy] = L3ANVIL[ii];
+				ctx.dungeon[xx + sx][yy + sy] = L3ANVIL[ii];
 			}
-			dflags[xx + sx][yy + sy] |= DLRG_PROTECTED;
+			ctx.dflags[xx + sx][yy + sy] |= DLRG_PROTECTED;
 			ii++;
 		}
 	}
 
-	setpc_x = sx;
-	setpc_y = sy;
-	setpc_w = sw;
-	setpc_h = sh;
+	ctx.setpc_x = sx;
+	ctx.setpc_y = sy;
+	ctx.setpc_w = sw;
+	ctx.setpc_h = sh;
 
 	return false;
 }
 
-static void FixL3Warp()
+static void FixL3Warp(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 125 && dungeon[i + 1][j] == 125 && dungeon[i][j + 1] == 125 && dungeon[i + 1][j + 1] == 125) {
-				dungeon[i][j] = 156;
-				dungeon[i + 1][j] = 155;
-				dungeon[i][j + 1] = 153;
-				dungeon[i + 1][j + 1] = 154;
+			if (ctx.dungeon[i][j] == 125 && ctx.dungeon[i + 1][j] == 125 && ctx.dungeon[i][j + 1] == 125 && ctx.dungeon[i + 1][j + 1] == 125) {
+				ctx.dungeon[i][j] = 156;
+				ctx.dungeon[i + 1][j] = 155;
+				ctx.dungeon[i][j + 1] = 153;
+				ctx.dungeon[i + 1][j + 1] = 154;
 				return;
 			}
-			if (dungeon[i][j] == 5 && dungeon[i + 1][j + 1] == 7) {
-				dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i + 1][j + 1] == 7) {
+				ctx.dungeon[i][j] = 7;
 			}
 		}
 	}
 }
 
-static void FixL3HallofHeroes()
+static void FixL3HallofHeroes(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 5 && dungeon[i + 1][j + 1] == 7) {
-				dungeon[i][j] = 7;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i + 1][j + 1] == 7) {
+				ctx.dungeon[i][j] = 7;
 			}
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 5 && dungeon[i + 1][j + 1] == 12 && dungeon[i + 1][j] == 7) {
-				dungeon[i][j] = 7;
-				dungeon[i][j + 1] = 7;
-				dungeon[i + 1][j + 1] = 7;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i + 1][j + 1] == 12 && ctx.dungeon[i + 1][j] == 7) {
+				ctx.dungeon[i][j] = 7;
+				ctx.dungeon[i][j + 1] = 7;
+				ctx.dungeon[i + 1][j + 1] = 7;
 			}
-			if (dungeon[i][j] == 5 && dungeon[i + 1][j + 1] == 12 && dungeon[i][j + 1] == 7) {
-				dungeon[i][j] = 7;
-				dungeon[i + 1][j] = 7;
-				dungeon[i + 1][j + 1] = 7;
+			if (ctx.dungeon[i][j] == 5 && ctx.dungeon[i + 1][j + 1] == 12 && ctx.dungeon[i][j + 1] == 7) {
+				ctx.dungeon[i][j] = 7;
+				ctx.dungeon[i + 1][j] = 7;
+				ctx.dungeon[i + 1][j + 1] = 7;
 			}
 		}
 	}
 }
 
-static void DRLG_L3LockRec(int x, int y)
+static void DRLG_L3LockRec(DungeonContext &ctx, int x, int y)
 {
-	if (!lockout[x][y]) {
+	if (!ctx.lockout[x][y]) {
 		return;
 	}
 
-	lockout[x][y] = false;
-	lockoutcnt++;
-	DRLG_L3LockRec(x, y - 1);
-	DRLG_L3LockRec(x, y + 1);
-	DRLG_L3LockRec(x - 1, y);
-	DRLG_L3LockRec(x + 1, y);
+	ctx.lockout[x][y] = false;
+	ctx.lockoutcnt++;
+	DRLG_L3LockRec(ctx, x, y - 1);
+	DRLG_L3LockRec(ctx, x, y + 1);
+	DRLG_L3LockRec(ctx, x - 1, y);
+	DRLG_L3LockRec(ctx, x + 1, y);
 }
 
-bool DRLG_L3Lockout()
+bool DRLG_L3Lockout(DungeonContext &ctx)
 {
 	int i, j, t, fx, fy;
 
 	t = 0;
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] != 0) {
-				lockout[i][j] = true;
+			if (ctx.dungeon[i][j] != 0) {
+				ctx.lockout[i][j] = true;
 				fx = i;
 				fy = j;
 				t++;
 			} else {
-				lockout[i][j] = false;
+				ctx.lockout[i][j] = false;
 			}
 		}
 	}
 
-	lockoutcnt = 0;
-	DRLG_L3LockRec(fx, fy);
+	ctx.lockoutcnt = 0;
+	DRLG_L3LockRec(ctx, fx, fy);
 
-	return t == lockoutcnt;
+	return t == ctx.lockoutcnt;
 }
 
-static void DRLG_L3(lvl_entry entry)
+static void DRLG_L3(DungeonContext &ctx, lvl_entry entry)
 {
 	int x1, y1, x2, y2, i, j;
 	bool found, genok;
 
-	lavapool = 0;
+	ctx.lavapool = 0;
 
 	do {
 		do {
 			do {
-				InitL3Dungeon();
+				InitL3Dungeon(ctx);
 				x1 = GenerateRnd(20) + 10;
 				y1 = GenerateRnd(20) + 10;
 				x2 = x1 + 2;
 				y2 = y1 + 2;
-				DRLG_L3FillRoom(x1, y1, x2, y2);
-				DRLG_L3CreateBlock(x1, y1, 2, 0);
-				DRLG_L3CreateBlock(x2, y1, 2, 1);
-				DRLG_L3CreateBlock(x1, y2, 2, 2);
-				DRLG_L3CreateBlock(x1, y1, 2, 3);
-				if (QuestStatus(Q_ANVIL)) {
+				DRLG_L3FillRoom(ctx, x1, y1, x2, y2);
+				DRLG_L3CreateBlock(ctx, x1, y1, 2, 0);
+				DRLG_L3CreateBlock(ctx, x2, y1, 2, 1);
+				DRLG_L3CreateBlock(ctx, x1, y2, 2, 2);
+				DRLG_L3CreateBlock(ctx, x1, y1, 2, 3);
+				if (QuestStatus(Q_ANVIL, ctx.currlevel)) {
 					x1 = GenerateRnd(10) + 10;
 					y1 = GenerateRnd(10) + 10;
 					x2 = x1 + 12;
 					y2 = y1 + 12;
-					DRLG_L3FloorArea(x1, y1, x2, y2);
-				}
-				DRLG_L3FillDiags();
-				DRLG_L3FillSingles();
-				DRLG_L3FillStraights();
-				DRLG_L3FillDiags();
-				DRLG_L3Edges();
-				if (DRLG_L3GetFloorArea() >= 600) {
-					found = DRLG_L3Lockout();
+					DRLG_L3FloorArea(ctx, x1, y1, x2, y2);
+				}
+				DRLG_L3FillDiags(ctx);
+				DRLG_L3FillSingles(ctx);
+				DRLG_L3FillStraights(ctx);
+				DRLG_L3FillDiags(ctx);
+				DRLG_L3Edges(ctx);
+				if (DRLG_L3GetFloorArea(ctx) >= 600) {
+					found = DRLG_L3Lockout(ctx);
 				} else {
 					found = false;
 				}
 			} while (!found);
-			DRLG_L3MakeMegas();
+			DRLG_L3MakeMegas(ctx);
 			if (entry == ENTRY_MAIN) {
-				if (currlevel < 17) {
-					genok = DRLG_L3PlaceMiniSet(L3UP, 1, 1, -1, -1, true, 0);
+				if (ctx.currlevel < 17) {
+					genok = DRLG_L3PlaceMiniSet(ctx, L3UP, 1, 1, -1, -1, true, 0);
 				} else {
-					if (currlevel != 17)
-						genok = DRLG_L3PlaceMiniSet(L6UP, 1, 1, -1, -1, true, 0);
+					if (ctx.currlevel != 17)
+						genok = DRLG_L3PlaceMiniSet(ctx, L6UP, 1, 1, -1, -1, true, 0);
 					else
-						genok = DRLG_L3PlaceMiniSet(L6HOLDWARP, 1, 1, -1, -1, true, 6);
+						genok = DRLG_L3PlaceMiniSet(ctx, L6HOLDWARP, 1, 1, -1, -1, true, 6);
 				}
 				if (!genok) {
-					if (currlevel < 17) {
-						genok = DRLG_L3PlaceMiniSet(L3DOWN, 1, 1, -1, -1, false, 1);
+					if (ctx.currlevel < 17) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3DOWN, 1, 1, -1, -1, false, 1);
 					} else {
-						if (currlevel != 20)
-							genok = DRLG_L3PlaceMiniSet(L6DOWN, 1, 1, -1, -1, false, 1);
+						if (ctx.currlevel != 20)
+							genok = DRLG_L3PlaceMiniSet(ctx, L6DOWN, 1, 1, -1, -1, false, 1);
 					}
-					if (!genok && currlevel == 9) {
-						genok = DRLG_L3PlaceMiniSet(L3HOLDWARP, 1, 1, -1, -1, false, 6);
+					if (!genok && ctx.currlevel == 9) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3HOLDWARP, 1, 1, -1, -1, false, 6);
 					}
 				}
 			} else if (entry == ENTRY_PREV) {
-				if (currlevel < 17) {
-					genok = DRLG_L3PlaceMiniSet(L3UP, 1, 1, -1, -1, false, 0);
+				if (ctx.currlevel < 17) {
+					genok = DRLG_L3PlaceMiniSet(ctx, L3UP, 1, 1, -1, -1, false, 0);
 				} else {
-					if (currlevel != 17)
-						genok = DRLG_L3PlaceMiniSet(L6UP, 1, 1, -1, -1, false, 0);
+					if (ctx.currlevel != 17)
+						genok = DRLG_L3PlaceMiniSet(ctx, L6UP, 1, 1, -1, -1, false, 0);
 					else
-						genok = DRLG_L3PlaceMiniSet(L6HOLDWARP, 1, 1, -1, -1, false, 6);
+						genok = DRLG_L3PlaceMiniSet(ctx, L6HOLDWARP, 1, 1, -1, -1, false, 6);
 				}
 				if (!genok) {
-					if (currlevel < 17) {
-						genok = DRLG_L3PlaceMiniSet(L3DOWN, 1, 1, -1, -1, true, 1);
-						ViewX += 2;
-						ViewY -= 2;
+					if (ctx.currlevel < 17) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3DOWN, 1, 1, -1, -1, true, 1);
+						ctx.ViewX += 2;
+						ctx.ViewY -= 2;
 					} else {
-						if (currlevel != 20) {
-							genok = DRLG_L3PlaceMiniSet(L6DOWN, 1, 1, -1, -1, true, 1);
-							ViewX += 2;
-							ViewY -= 2;
+						if (ctx.currlevel != 20) {
+							genok = DRLG_L3PlaceMiniSet(ctx, L6DOWN, 1, 1, -1, -1, true, 1);
+							ctx.ViewX += 2;
+							ctx.ViewY -= 2;
 						}
 					}
-					if (!genok && currlevel == 9) {
-						genok = DRLG_L3PlaceMiniSet(L3HOLDWARP, 1, 1, -1, -1, false, 6);
+					if (!genok && ctx.currlevel == 9) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3HOLDWARP, 1, 1, -1, -1, false, 6);
 					}
 				}
 			} else {
-				if (currlevel < 17) {
-					genok = DRLG_L3PlaceMiniSet(L3UP, 1, 1, -1, -1, false, 0);
+				if (ctx.currlevel < 17) {
+					genok = DRLG_L3PlaceMiniSet(ctx, L3UP, 1, 1, -1, -1, false, 0);
 				} else {
-					if (currlevel != 17)
-						genok = DRLG_L3PlaceMiniSet(L6UP, 1, 1, -1, -1, false, 0);
+					if (ctx.currlevel != 17)
+						genok = DRLG_L3PlaceMiniSet(ctx, L6UP, 1, 1, -1, -1, false, 0);
 					else
-						genok = DRLG_L3PlaceMiniSet(L6HOLDWARP, 1, 1, -1, -1, true, 6);
+						genok = DRLG_L3PlaceMiniSet(ctx, L6HOLDWARP, 1, 1, -1, -1, true, 6);
 				}
 				if (!genok) {
-					if (currlevel < 17) {
-						genok = DRLG_L3PlaceMiniSet(L3DOWN, 1, 1, -1, -1, false, 1);
+					if (ctx.currlevel < 17) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3DOWN, 1, 1, -1, -1, false, 1);
 					} else {
-						if (currlevel != 20)
-							genok = DRLG_L3PlaceMiniSet(L6DOWN, 1, 1, -1, -1, false, 1);
+						if (ctx.currlevel != 20)
+							genok = DRLG_L3PlaceMiniSet(ctx, L6DOWN, 1, 1, -1, -1, false, 1);
 					}
-					if (!genok && currlevel == 9) {
-						genok = DRLG_L3PlaceMiniSet(L3HOLDWARP, 1, 1, -1, -1, true, 6);
+					if (!genok && ctx.currlevel == 9) {
+						genok = DRLG_L3PlaceMiniSet(ctx, L3HOLDWARP, 1, 1, -1, -1, true, 6);
 					}
 				}
 			}
-			if (!genok && QuestStatus(Q_ANVIL)) {
-				genok = DRLG_L3Anvil();
+			if (!genok && QuestStatus(Q_ANVIL, ctx.currlevel)) {
+				genok = DRLG_L3Anvil(ctx);
 			}
 		} while (genok);
-		if (currlevel < 17) {
-			DRLG_L3Pool();
+		if (ctx.currlevel < 17) {
+			DRLG_L3Pool(ctx);
 		} else {
-			if (drlg_l3_hive_rnd_piece(byte_48A998, 30))
-				lavapool++;
-			if (drlg_l3_hive_rnd_piece(byte_48A9C8, 40))
-				lavapool++;
-			if (drlg_l3_hive_rnd_piece(byte_48A948, 50))
-				lavapool++;
-			if (drlg_l3_hive_rnd_piece(byte_48A970, 60))
-				lavapool++;
-			if (lavapool < 3)
-				lavapool = 0;
-		}
-	} while (lavapool == 0);
-
-	if (currlevel < 17)
-		DRLG_L3PoolFix();
-	if (currlevel < 17)
-		FixL3Warp();
-
-	if (currlevel < 17) {
-		DRLG_L3PlaceRndSet(L3ISLE1, 70);
-		DRLG_L3PlaceRndSet(L3ISLE2, 70);
-		DRLG_L3PlaceRndSet(L3ISLE3, 30);
-		DRLG_L3PlaceRndSet(L3ISLE4, 30);
-		DRLG_L3PlaceRndSet(L3ISLE1, 100);
-		DRLG_L3PlaceRndSet(L3ISLE2, 100);
-		DRLG_L3PlaceRndSet(L3ISLE5, 90);
+			if (drlg_l3_hive_rnd_piece(ctx, byte_48A998, 30))
+				ctx.lavapool++;
+			if (drlg_l3_hive_rnd_piece(ctx, byte_48A9C8, 40))
+				ctx.lavapool++;
+			if (drlg_l3_hive_rnd_piece(ctx, byte_48A948, 50))
+				ctx.lavapool++;
+			if (drlg_l3_hive_rnd_piece(ctx, byte_48A970, 60))
+				ctx.lavapool++;
+			if (ctx.lavapool < 3)
+				ctx.lavapool = 0;
+		}
+	} while (ctx.lavapool == 0);
+
+	if (ctx.currlevel < 17)
+		DRLG_L3PoolFix(ctx);
+	if (ctx.currlevel < 17)
+		FixL3Warp(ctx);
+
+	if (ctx.currlevel < 17) {
+		DRLG_L3PlaceRndSet(ctx, L3ISLE1, 70);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE2, 70);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE3, 30);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE4, 30);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE1, 100);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE2, 100);
+		DRLG_L3PlaceRndSet(ctx, L3ISLE5, 90);
 	} else {
-		DRLG_L3PlaceRndSet(L6ISLE1, 70);
-		DRLG_L3PlaceRndSet(L6ISLE2, 70);
-		DRLG_L3PlaceRndSet(L6ISLE3, 30);
-		DRLG_L3PlaceRndSet(L6ISLE4, 30);
-		DRLG_L3PlaceRndSet(L6ISLE1, 100);
-		DRLG_L3PlaceRndSet(L6ISLE2, 100);
-		DRLG_L3PlaceRndSet(L6ISLE5, 90);
-	}
-
-	if (currlevel < 17)
-		FixL3HallofHeroes();
-	if (currlevel < 17)
-		DRLG_L3River();
-
-	if (QuestStatus(Q_ANVIL)) {
-		dungeon[setpc_x + 7][setpc_y + 5] = 7;
-		dungeon[setpc_x + 8][setpc_y + 5] = 7;
-		dungeon[setpc_x + 9][setpc_y + 5] = 7;
-		if (dungeon[setpc_x + 10][setpc_y + 5] == 17 || dungeon[setpc_x + 10][setpc_y + 5] == 18) {
-			dungeon[setpc_x + 10][setpc_y + 5] = 45;
-		}
-	}
-
-	if (currlevel < 17)
-		DRLG_PlaceThemeRooms(5, 10, 7, 0, false);
-
-	if (currlevel < 17) {
-		DRLG_L3Wood();
-		DRLG_L3PlaceRndSet(L3TITE1, 10);
-		DRLG_L3PlaceRndSet(L3TITE2, 10);
-		DRLG_L3PlaceRndSet(L3TITE3, 10);
-		DRLG_L3PlaceRndSet(L3TITE6, 20);
-		DRLG_L3PlaceRndSet(L3TITE7, 20);
-		DRLG_L3PlaceRndSet(L3TITE8, 20);
-		DRLG_L3PlaceRndSet(L3TITE9, 20);
-		DRLG_L3PlaceRndSet(L3TITE10, 20);
-		DRLG_L3PlaceRndSet(L3TITE11, 30);
-		DRLG_L3PlaceRndSet(L3TITE12, 20);
-		DRLG_L3PlaceRndSet(L3TITE13, 20);
-		DRLG_L3PlaceRndSet(L3CREV1, 30);
-		DRLG_L3PlaceRndSet(L3CREV2, 30);
-		DRLG_L3PlaceRndSet(L3CREV3, 30);
-		DRLG_L3PlaceRndSet(L3CREV4, 30);
-		DRLG_L3PlaceRndSet(L3CREV5, 30);
-		DRLG_L3PlaceRndSet(L3CREV6, 30);
-		DRLG_L3PlaceRndSet(L3CREV7, 30);
-		DRLG_L3PlaceRndSet(L3CREV8, 30);
-		DRLG_L3PlaceRndSet(L3CREV9, 30);
-		DRLG_L3PlaceRndSet(L3CREV10, 30);
-		DRLG_L3PlaceRndSet(L3CREV11, 30);
-		DRLG_L3PlaceRndSet(L3XTRA1, 25);
-		DRLG_L3PlaceRndSet(L3XTRA2, 25);
-		DRLG_L3PlaceRndSet(L3XTRA3, 25);
-		DRLG_L3PlaceRndSet(L3XTRA4, 25);
-		DRLG_L3PlaceRndSet(L3XTRA5, 25);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE1, 70);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE2, 70);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE3, 30);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE4, 30);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE1, 100);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE2, 100);
+		DRLG_L3PlaceRndSet(ctx, L6ISLE5, 90);
+	}
+
+	if (ctx.currlevel < 17)
+		FixL3HallofHeroes(ctx);
+	if (ctx.currlevel < 17)
+		DRLG_L3River(ctx);
+
+	if (QuestStatus(Q_ANVIL, ctx.currlevel)) {
+		ctx.dungeon[ctx.setpc_x + 7][ctx.setpc_y + 5] = 7;
+		ctx.dungeon[ctx.setpc_x + 8][ctx.setpc_y + 5] = 7;
+		ctx.dungeon[ctx.setpc_x + 9][ctx.setpc_y + 5] = 7;
+		if (ctx.dungeon[ctx.setpc_x + 10][ctx.setpc_y + 5] == 17 || ctx.dungeon[ctx.setpc_x + 10][ctx.setpc_y + 5] == 18) {
+			ctx.dungeon[ctx.setpc_x + 10][ctx.setpc_y + 5] = 45;
+		}
+	}
+
+	if (ctx.currlevel < 17)
+		DRLG_PlaceThemeRooms(ctx, 5, 10, 7, 0, false);
+
+	if (ctx.currlevel < 17) {
+		DRLG_L3Wood(ctx);
+		DRLG_L3PlaceRndSet(ctx, L3TITE1, 10);
+		DRLG_L3PlaceRndSet(ctx, L3TITE2, 10);
+		DRLG_L3PlaceRndSet(ctx, L3TITE3, 10);
+		DRLG_L3PlaceRndSet(ctx, L3TITE6, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE7, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE8, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE9, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE10, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE11, 30);
+		DRLG_L3PlaceRndSet(ctx, L3TITE12, 20);
+		DRLG_L3PlaceRndSet(ctx, L3TITE13, 20);
+		DRLG_L3PlaceRndSet(ctx, L3CREV1, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV2, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV3, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV4, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV5, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV6, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV7, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV8, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV9, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV10, 30);
+		DRLG_L3PlaceRndSet(ctx, L3CREV11, 30);
+		DRLG_L3PlaceRndSet(ctx, L3XTRA1, 25);
+		DRLG_L3PlaceRndSet(ctx, L3XTRA2, 25);
+		DRLG_L3PlaceRndSet(ctx, L3XTRA3, 25);
+		DRLG_L3PlaceRndSet(ctx, L3XTRA4, 25);
+		DRLG_L3PlaceRndSet(ctx, L3XTRA5, 25);
 	} else {
-		DRLG_L3PlaceRndSet(byte_48A76C, 20);
-		DRLG_L3PlaceRndSet(byte_48A770, 20);
-		DRLG_L3PlaceRndSet(byte_48A774, 20);
-		DRLG_L3PlaceRndSet(byte_48A778, 20);
-		DRLG_L3PlaceRndSet(byte_48A808, 10);
-		DRLG_L3PlaceRndSet(byte_48A820, 15);
-		DRLG_L3PlaceRndSet(byte_48A838, 20);
-		DRLG_L3PlaceRndSet(byte_48A850, 25);
-		DRLG_L3PlaceRndSet(byte_48A868, 30);
-		DRLG_L3PlaceRndSet(byte_48A880, 35);
-		DRLG_L3PlaceRndSet(byte_48A898, 40);
-		DRLG_L3PlaceRndSet(byte_48A8B0, 45);
-		DRLG_L3PlaceRndSet(byte_48A8C8, 50);
-		DRLG_L3PlaceRndSet(byte_48A8E0, 55);
-		DRLG_L3PlaceRndSet(byte_48A8E0, 10);
-		DRLG_L3PlaceRndSet(byte_48A8C8, 15);
-		DRLG_L3PlaceRndSet(byte_48A8B0, 20);
-		DRLG_L3PlaceRndSet(byte_48A898, 25);
-		DRLG_L3PlaceRndSet(byte_48A880, 30);
-		DRLG_L3PlaceRndSet(byte_48A868, 35);
-		DRLG_L3PlaceRndSet(byte_48A850, 40);
-		DRLG_L3PlaceRndSet(byte_48A838, 45);
-		DRLG_L3PlaceRndSet(byte_48A820, 50);
-		DRLG_L3PlaceRndSet(byte_48A808, 55);
-		DRLG_L3PlaceRndSet(byte_48A790, 40);
-		DRLG_L3PlaceRndSet(byte_48A7A8, 45);
-		DRLG_L3PlaceRndSet(byte_48A77C, 25);
-		DRLG_L3PlaceRndSet(byte_48A780, 25);
-		DRLG_L3PlaceRndSet(byte_48A784, 25);
-		DRLG_L3PlaceRndSet(byte_48A788, 25);
-		DRLG_L3PlaceRndSet(byte_48A7BC, 25);
-		DRLG_L3PlaceRndSet(byte_48A7C0, 25);
-		DRLG_L3PlaceRndSet(byte_48A7C4, 25);
-		DRLG_L3PlaceRndSet(byte_48A7C8, 25);
-		DRLG_L3PlaceRndSet(byte_48A7CC, 25);
-		DRLG_L3PlaceRndSet(byte_48A7D4, 25);
-		DRLG_L3PlaceRndSet(byte_48A7D8, 25);
-		DRLG_L3PlaceRndSet(byte_48A7DC, 25);
-		DRLG_L3PlaceRndSet(byte_48A7E0, 25);
-		DRLG_L3PlaceRndSet(byte_48A7E4, 25);
-		DRLG_L3PlaceRndSet(byte_48A7EC, 25);
-		DRLG_L3PlaceRndSet(byte_48A7F0, 25);
-		DRLG_L3PlaceRndSet(byte_48A7F4, 25);
-		DRLG_L3PlaceRndSet(byte_48A7F8, 25);
-		DRLG_L3PlaceRndSet(byte_48A7D0, 25);
-		DRLG_L3PlaceRndSet(byte_48A7E8, 25);
-		DRLG_L3PlaceRndSet(byte_48A7FC, 25);
-		DRLG_L3PlaceRndSet(byte_48A800, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A76C, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A770, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A774, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A778, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A808, 10);
+		DRLG_L3PlaceRndSet(ctx, byte_48A820, 15);
+		DRLG_L3PlaceRndSet(ctx, byte_48A838, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A850, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A868, 30);
+		DRLG_L3PlaceRndSet(ctx, byte_48A880, 35);
+		DRLG_L3PlaceRndSet(ctx, byte_48A898, 40);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8B0, 45);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8C8, 50);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8E0, 55);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8E0, 10);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8C8, 15);
+		DRLG_L3PlaceRndSet(ctx, byte_48A8B0, 20);
+		DRLG_L3PlaceRndSet(ctx, byte_48A898, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A880, 30);
+		DRLG_L3PlaceRndSet(ctx, byte_48A868, 35);
+		DRLG_L3PlaceRndSet(ctx, byte_48A850, 40);
+		DRLG_L3PlaceRndSet(ctx, byte_48A838, 45);
+		DRLG_L3PlaceRndSet(ctx, byte_48A820, 50);
+		DRLG_L3PlaceRndSet(ctx, byte_48A808, 55);
+		DRLG_L3PlaceRndSet(ctx, byte_48A790, 40);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7A8, 45);
+		DRLG_L3PlaceRndSet(ctx, byte_48A77C, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A780, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A784, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A788, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7BC, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7C0, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7C4, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7C8, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7CC, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7D4, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7D8, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7DC, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7E0, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7E4, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7EC, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7F0, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7F4, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7F8, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7D0, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7E8, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A7FC, 25);
+		DRLG_L3PlaceRndSet(ctx, byte_48A800, 25);
 	}
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			pdungeon[i][j] = dungeon[i][j];
+			ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 		}
 	}
 
-	DRLG_Init_Globals();
+	DRLG_InitFlags(ctx);
 }
 
-static void DRLG_L3Pass3()
+static void DRLG_L3Pass3(DungeonContext &ctx)
 {
-	DRLG_LPass3(8 - 1);
+	DRLG_LPass3(ctx, 8 - 1);
 }
 
-void CreateL3Dungeon(uint32_t rseed, lvl_entry entry)
+void CreateL3Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry)
 {
-	int i, j;
-
 	SetRndSeed(rseed);
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
-	DRLG_InitTrans();
-	DRLG_InitSetPC();
-	DRLG_L3(entry);
-	DRLG_L3Pass3();
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
+	DRLG_InitTrans(ctx);
+	DRLG_InitSetPC(ctx);
+	DRLG_L3(ctx, entry);
+	DRLG_L3Pass3(ctx);
+	DRLG_SetPC(ctx);
+}
+
+void InitL3Lights()
+{
+	int i, j;
 
 	if (currlevel < 17) {
 		for (j = 0; j < MAXDUNY; j++) {
@@ -2620,19 +2619,17 @@ void CreateL3Dungeon(uint32_t rseed, lvl_entry entry)
 			}
 		}
 	}
-
-	DRLG_SetPC();
 }
 
-void LoadL3Dungeon(const char *path, int vx, int vy)
+void LoadL3Dungeon(DungeonContext &ctx, const char *path, int vx, int vy)
 {
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
-	InitL3Dungeon();
-	DRLG_InitTrans();
+	InitL3Dungeon(ctx);
+	DRLG_InitTrans(ctx);
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
@@ -2644,46 +2641,46 @@ void LoadL3Dungeon(const char *path, int vx, int vy)
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
-			dungeon[i][j] = (tileId != 0) ? tileId : 7;
+			ctx.dungeon[i][j] = (tileId != 0) ? tileId : 7;
 		}
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 0) {
-				dungeon[i][j] = 8;
+			if (ctx.dungeon[i][j] == 0) {
+				ctx.dungeon[i][j] = 8;
 			}
 		}
 	}
 
-	DRLG_L3Pass3();
+	DRLG_L3Pass3(ctx);
 	DRLG_Init_Globals();
 
-	ViewX = vx;
-	ViewY = vy;
+	ctx.ViewX = vx;
+	ctx.ViewY = vy;
 
 	SetMapMonsters(dunData.get(), { 0, 0 });
 	SetMapObjects(dunData.get(), 0, 0);
 
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
-			if (dPiece[i][j] >= 56 && dPiece[i][j] <= 147) {
+			if (ctx.dPiece[i][j] >= 56 && ctx.dPiece[i][j] <= 147) {
 				DoLighting({ i, j }, 7, -1);
-			} else if (dPiece[i][j] >= 154 && dPiece[i][j] <= 161) {
+			} else if (ctx.dPiece[i][j] >= 154 && ctx.dPiece[i][j] <= 161) {
 				DoLighting({ i, j }, 7, -1);
-			} else if (dPiece[i][j] == 150) {
+			} else if (ctx.dPiece[i][j] == 150) {
 				DoLighting({ i, j }, 7, -1);
-			} else if (dPiece[i][j] == 152) {
+			} else if (ctx.dPiece[i][j] == 152) {
 				DoLighting({ i, j }, 7, -1);
 			}
 		}
 	}
 }
 
-void LoadPreL3Dungeon(const char *path)
+void LoadPreL3Dungeon(DungeonContext &ctx, const char *path)
 {
-	InitL3Dungeon();
-	DRLG_InitTrans();
+	InitL3Dungeon(ctx);
+	DRLG_InitTrans(ctx);
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
@@ -2695,19 +2692,19 @@ void LoadPreL3Dungeon(const char *path)
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
-			dungeon[i][j] = (tileId != 0) ? tileId : 7;
+			ctx.dungeon[i][j] = (tileId != 0) ? tileId : 7;
 		}
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 0) {
-				dungeon[i][j] = 8;
+			if (ctx.dungeon[i][j] == 0) {
+				ctx.dungeon[i][j] = 8;
 			}
 		}
 	}
 
-	memcpy(pdungeon, dungeon, sizeof(pdungeon));
+	memcpy(ctx.pdungeon, ctx.dungeon, sizeof(ctx.pdungeon));
 }
 
 } // namespace devilution
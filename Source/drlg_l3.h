@@ -9,9 +9,18 @@
 
 namespace devilution {
 
-void AddFenceDoors();
-void CreateL3Dungeon(uint32_t rseed, lvl_entry entry);
-void LoadL3Dungeon(const char *sFileName, int vx, int vy);
-void LoadPreL3Dungeon(const char *sFileName);
+void AddFenceDoors(DungeonContext &ctx);
+/**
+ * @brief Generate a Caves or Nest level into the given context
+ *
+ * Call DRLG_Init_Globals before and InitL3Lights after when building the active level.
+ */
+void CreateL3Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry);
+/**
+ * @brief Light up the lava of the active level
+ */
+void InitL3Lights();
+void LoadL3Dungeon(DungeonContext &ctx, const char *sFileName, int vx, int vy);
+void LoadPreL3Dungeon(DungeonContext &ctx, const char *sFileName);
 
 } // namespace devilution
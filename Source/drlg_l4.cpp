@@ -13,26 +13,17 @@
 
 namespace devilution {
 
-int diabquad1x;
-int diabquad1y;
-int diabquad2x;
-int diabquad2y;
-int diabquad3x;
-int diabquad3y;
-int diabquad4x;
-int diabquad4y;
+int &diabquad1x = ActiveDungeon.diabquad1x;
+int &diabquad1y = ActiveDungeon.diabquad1y;
+int &diabquad2x = ActiveDungeon.diabquad2x;
+int &diabquad2y = ActiveDungeon.diabquad2y;
+int &diabquad3x = ActiveDungeon.diabquad3x;
+int &diabquad3y = ActiveDungeon.diabquad3y;
+int &diabquad4x = ActiveDungeon.diabquad4x;
+int &diabquad4y = ActiveDungeon.diabquad4y;
 
 namespace {
 
-bool hallok[20];
-int l4holdx;
-int l4holdy;
-int SP4x1;
-int SP4y1;
-int SP4x2;
-int SP4y2;
-BYTE L4dungeon[80][80];
-BYTE dung[20][20];
 //int dword_52A4DC;
 
 /**
@@ -152,7 +143,7 @@ const BYTE L4BTYPES[140] = {
 
 } // namespace
 
-static void DRLG_L4Shadows()
+static void DRLG_L4Shadows(DungeonContext &ctx)
 {
 	int x, y;
 	bool okflag;
@@ -160,65 +151,65 @@ static void DRLG_L4Shadows()
 	for (y = 1; y < DMAXY; y++) {
 		for (x = 1; x < DMAXY; x++) {
 			okflag = false;
-			if (dungeon[x][y] == 3) {
+			if (ctx.dungeon[x][y] == 3) {
 				okflag = true;
 			}
-			if (dungeon[x][y] == 4) {
+			if (ctx.dungeon[x][y] == 4) {
 				okflag = true;
 			}
-			if (dungeon[x][y] == 8) {
+			if (ctx.dungeon[x][y] == 8) {
 				okflag = true;
 			}
-			if (dungeon[x][y] == 15) {
+			if (ctx.dungeon[x][y] == 15) {
 				okflag = true;
 			}
 			if (!okflag) {
 				continue;
 			}
-			if (dungeon[x - 1][y] == 6) {
-				dungeon[x - 1][y] = 47;
+			if (ctx.dungeon[x - 1][y] == 6) {
+				ctx.dungeon[x - 1][y] = 47;
 			}
-			if (dungeon[x - 1][y - 1] == 6) {
-				dungeon[x - 1][y - 1] = 48;
+			if (ctx.dungeon[x - 1][y - 1] == 6) {
+				ctx.dungeon[x - 1][y - 1] = 48;
 			}
 		}
 	}
 }
 
-static void InitL4Dungeon()
+static void InitL4Dungeon(DungeonContext &ctx)
 {
 	int i, j;
 
-	memset(dung, 0, sizeof(dung));
-	memset(L4dungeon, 0, sizeof(L4dungeon));
+	memset(ctx.dung, 0, sizeof(ctx.dung));
+	memset(ctx.L4dungeon, 0, sizeof(ctx.L4dungeon));
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			dungeon[i][j] = 30;
-			dflags[i][j] = 0;
+			ctx.dungeon[i][j] = 30;
+			ctx.dflags[i][j] = 0;
 		}
 	}
 }
 
-void DRLG_LoadL4SP()
+void DRLG_LoadL4SP(DungeonContext &ctx)
 {
-	setloadflag = false;
-	if (QuestStatus(Q_WARLORD)) {
-		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L4Data\\Warlord.DUN");
-		setloadflag = true;
+	ctx.setloadflag = false;
+	if (QuestStatus(Q_WARLORD, ctx.currlevel)) {
+		ctx.pSetPiece = LoadFileInMem<uint16_t>("Levels\\L4Data\\Warlord.DUN");
+		ctx.setloadflag = true;
 	}
-	if (currlevel == 15 && gbIsMultiplayer) {
-		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L4Data\\Vile1.DUN");
-		setloadflag = true;
+	if (ctx.currlevel == 15 && gbIsMultiplayer) {
+		ctx.pSetPiece = LoadFileInMem<uint16_t>("Levels\\L4Data\\Vile1.DUN");
+		ctx.setloadflag = true;
 	}
 }
 
-void DRLG_FreeL4SP()
+void DRLG_FreeL4SP(DungeonContext &ctx)
 {
-	pSetPiece = nullptr;
+	ctx.pSetPiece = nullptr;
 }
 
-void DRLG_L4SetRoom(const uint16_t *dunData, int rx1, int ry1)
+void DRLG_L4SetRoom(DungeonContext &ctx, const uint16_t *dunData, int rx1, int ry1)
 {
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
@@ -229,79 +220,79 @@ void DRLG_L4SetRoom(const uint16_t *dunData, int rx1, int ry1)
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				dungeon[i + rx1][j + ry1] = tileId;
-				dflags[i + rx1][j + ry1] |= DLRG_PROTECTED;
+				ctx.dungeon[i + rx1][j + ry1] = tileId;
+				ctx.dflags[i + rx1][j + ry1] |= DLRG_PROTECTED;
 			} else {
-				dungeon[i + rx1][j + ry1] = 6;
+				ctx.dungeon[i + rx1][j + ry1] = 6;
 			}
 		}
 	}
 }
 
-void DRLG_L4SetSPRoom(int rx1, int ry1)
+void DRLG_L4SetSPRoom(DungeonContext &ctx, int rx1, int ry1)
 {
-	setpc_x = rx1;
-	setpc_y = ry1;
-	setpc_w = SDL_SwapLE16(pSetPiece[0]);
-	setpc_h = SDL_SwapLE16(pSetPiece[1]);
+	ctx.setpc_x = rx1;
+	ctx.setpc_y = ry1;
+	ctx.setpc_w = SDL_SwapLE16(ctx.pSetPiece[0]);
+	ctx.setpc_h = SDL_SwapLE16(ctx.pSetPiece[1]);
 
-	DRLG_L4SetRoom(pSetPiece.get(), rx1, ry1);
+	DRLG_L4SetRoom(ctx, ctx.pSetPiece.get(), rx1, ry1);
 }
 
-static void L4makeDmt()
+static void L4makeDmt(DungeonContext &ctx)
 {
 	int i, j, idx, val, dmtx, dmty;
 
 	for (j = 0, dmty = 1; dmty <= 77; j++, dmty += 2) {
 		for (i = 0, dmtx = 1; dmtx <= 77; i++, dmtx += 2) {
-			val = 8 * L4dungeon[dmtx + 1][dmty + 1]
-			    + 4 * L4dungeon[dmtx][dmty + 1]
-			    + 2 * L4dungeon[dmtx + 1][dmty]
-			    + L4dungeon[dmtx][dmty];
+			val = 8 * ctx.L4dungeon[dmtx + 1][dmty + 1]
+			    + 4 * ctx.L4dungeon[dmtx][dmty + 1]
+			    + 2 * ctx.L4dungeon[dmtx + 1][dmty]
+			    + ctx.L4dungeon[dmtx][dmty];
 			idx = L4ConvTbl[val];
-			dungeon[i][j] = idx;
+			ctx.dungeon[i][j] = idx;
 		}
 	}
 }
 
-static int L4HWallOk(int i, int j)
+static int L4HWallOk(DungeonContext &ctx, int i, int j)
 {
 	int x;
 	bool wallok;
 
-	for (x = 1; dungeon[i + x][j] == 6; x++) {
-		if (dflags[i + x][j] != 0) {
+	for (x = 1; ctx.dungeon[i + x][j] == 6; x++) {
+		if (ctx.dflags[i + x][j] != 0) {
 			break;
 		}
-		if (dungeon[i + x][j - 1] != 6) {
+		if (ctx.dungeon[i + x][j - 1] != 6) {
 			break;
 		}
-		if (dungeon[i + x][j + 1] != 6) {
+		if (ctx.dungeon[i + x][j + 1] != 6) {
 			break;
 		}
 	}
 
 	wallok = false;
 
-	if (dungeon[i + x][j] == 10) {
+	if (ctx.dungeon[i + x][j] == 10) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 12) {
+	if (ctx.dungeon[i + x][j] == 12) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 13) {
+	if (ctx.dungeon[i + x][j] == 13) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 15) {
+	if (ctx.dungeon[i + x][j] == 15) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 16) {
+	if (ctx.dungeon[i + x][j] == 16) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 21) {
+	if (ctx.dungeon[i + x][j] == 21) {
 		wallok = true;
 	}
-	if (dungeon[i + x][j] == 22) {
+	if (ctx.dungeon[i + x][j] == 22) {
 		wallok = true;
 	}
 	if (x <= 3) {
@@ -314,47 +305,47 @@ static int L4HWallOk(int i, int j)
 	return -1;
 }
 
-static int L4VWallOk(int i, int j)
+static int L4VWallOk(DungeonContext &ctx, int i, int j)
 {
 	int y;
 	bool wallok;
 
-	for (y = 1; dungeon[i][j + y] == 6; y++) {
-		if (dflags[i][j + y] != 0) {
+	for (y = 1; ctx.dungeon[i][j + y] == 6; y++) {
+		if (ctx.dflags[i][j + y] != 0) {
 			break;
 		}
-		if (dungeon[i - 1][j + y] != 6) {
+		if (ctx.dungeon[i - 1][j + y] != 6) {
 			break;
 		}
-		if (dungeon[i + 1][j + y] != 6) {
+		if (ctx.dungeon[i + 1][j + y] != 6) {
 			break;
 		}
 	}
 
 	wallok = false;
 
-	if (dungeon[i][j + y] == 8) {
+	if (ctx.dungeon[i][j + y] == 8) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 9) {
+	if (ctx.dungeon[i][j + y] == 9) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 11) {
+	if (ctx.dungeon[i][j + y] == 11) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 14) {
+	if (ctx.dungeon[i][j + y] == 14) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 15) {
+	if (ctx.dungeon[i][j + y] == 15) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 16) {
+	if (ctx.dungeon[i][j + y] == 16) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 21) {
+	if (ctx.dungeon[i][j + y] == 21) {
 		wallok = true;
 	}
-	if (dungeon[i][j + y] == 23) {
+	if (ctx.dungeon[i][j + y] == 23) {
 		wallok = true;
 	}
 	if (y <= 3) {
@@ -367,547 +358,547 @@ static int L4VWallOk(int i, int j)
 	return -1;
 }
 
-static void L4HorizWall(int i, int j, int dx)
+static void L4HorizWall(DungeonContext &ctx, int i, int j, int dx)
 {
 	int xx;
 
-	if (dungeon[i][j] == 13) {
-		dungeon[i][j] = 17;
+	if (ctx.dungeon[i][j] == 13) {
+		ctx.dungeon[i][j] = 17;
 	}
-	if (dungeon[i][j] == 16) {
-		dungeon[i][j] = 11;
+	if (ctx.dungeon[i][j] == 16) {
+		ctx.dungeon[i][j] = 11;
 	}
-	if (dungeon[i][j] == 12) {
-		dungeon[i][j] = 14;
+	if (ctx.dungeon[i][j] == 12) {
+		ctx.dungeon[i][j] = 14;
 	}
 
 	for (xx = 1; xx < dx; xx++) {
-		dungeon[i + xx][j] = 2;
+		ctx.dungeon[i + xx][j] = 2;
 	}
 
-	if (dungeon[i + dx][j] == 15) {
-		dungeon[i + dx][j] = 14;
+	if (ctx.dungeon[i + dx][j] == 15) {
+		ctx.dungeon[i + dx][j] = 14;
 	}
-	if (dungeon[i + dx][j] == 10) {
-		dungeon[i + dx][j] = 17;
+	if (ctx.dungeon[i + dx][j] == 10) {
+		ctx.dungeon[i + dx][j] = 17;
 	}
-	if (dungeon[i + dx][j] == 21) {
-		dungeon[i + dx][j] = 23;
+	if (ctx.dungeon[i + dx][j] == 21) {
+		ctx.dungeon[i + dx][j] = 23;
 	}
-	if (dungeon[i + dx][j] == 22) {
-		dungeon[i + dx][j] = 29;
+	if (ctx.dungeon[i + dx][j] == 22) {
+		ctx.dungeon[i + dx][j] = 29;
 	}
 
 	xx = GenerateRnd(dx - 3) + 1;
-	dungeon[i + xx][j] = 57;
-	dungeon[i + xx + 2][j] = 56;
-	dungeon[i + xx + 1][j] = 60;
+	ctx.dungeon[i + xx][j] = 57;
+	ctx.dungeon[i + xx + 2][j] = 56;
+	ctx.dungeon[i + xx + 1][j] = 60;
 
-	if (dungeon[i + xx][j - 1] == 6) {
-		dungeon[i + xx][j - 1] = 58;
+	if (ctx.dungeon[i + xx][j - 1] == 6) {
+		ctx.dungeon[i + xx][j - 1] = 58;
 	}
-	if (dungeon[i + xx + 1][j - 1] == 6) {
-		dungeon[i + xx + 1][j - 1] = 59;
+	if (ctx.dungeon[i + xx + 1][j - 1] == 6) {
+		ctx.dungeon[i + xx + 1][j - 1] = 59;
 	}
 }
 
-static void L4VertWall(int i, int j, int dy)
+static void L4VertWall(DungeonContext &ctx, int i, int j, int dy)
 {
 	int yy;
 
-	if (dungeon[i][j] == 14) {
-		dungeon[i][j] = 17;
+	if (ctx.dungeon[i][j] == 14) {
+		ctx.dungeon[i][j] = 17;
 	}
-	if (dungeon[i][j] == 8) {
-		dungeon[i][j] = 9;
+	if (ctx.dungeon[i][j] == 8) {
+		ctx.dungeon[i][j] = 9;
 	}
-	if (dungeon[i][j] == 15) {
-		dungeon[i][j] = 10;
+	if (ctx.dungeon[i][j] == 15) {
+		ctx.dungeon[i][j] = 10;
 	}
 
 	for (yy = 1; yy < dy; yy++) {
-		dungeon[i][j + yy] = 1;
+		ctx.dungeon[i][j + yy] = 1;
 	}
 
-	if (dungeon[i][j + dy] == 11) {
-		dungeon[i][j + dy] = 17;
+	if (ctx.dungeon[i][j + dy] == 11) {
+		ctx.dungeon[i][j + dy] = 17;
 	}
-	if (dungeon[i][j + dy] == 9) {
-		dungeon[i][j + dy] = 10;
+	if (ctx.dungeon[i][j + dy] == 9) {
+		ctx.dungeon[i][j + dy] = 10;
 	}
-	if (dungeon[i][j + dy] == 16) {
-		dungeon[i][j + dy] = 13;
+	if (ctx.dungeon[i][j + dy] == 16) {
+		ctx.dungeon[i][j + dy] = 13;
 	}
-	if (dungeon[i][j + dy] == 21) {
-		dungeon[i][j + dy] = 22;
+	if (ctx.dungeon[i][j + dy] == 21) {
+		ctx.dungeon[i][j + dy] = 22;
 	}
-	if (dungeon[i][j + dy] == 23) {
-		dungeon[i][j + dy] = 29;
+	if (ctx.dungeon[i][j + dy] == 23) {
+		ctx.dungeon[i][j + dy] = 29;
 	}
 
 	yy = GenerateRnd(dy - 3) + 1;
-	dungeon[i][j + yy] = 53;
-	dungeon[i][j + yy + 2] = 52;
-	dungeon[i][j + yy + 1] = 6;
+	ctx.dungeon[i][j + yy] = 53;
+	ctx.dungeon[i][j + yy + 2] = 52;
+	ctx.dungeon[i][j + yy + 1] = 6;
 
-	if (dungeon[i - 1][j + yy] == 6) {
-		dungeon[i - 1][j + yy] = 54;
+	if (ctx.dungeon[i - 1][j + yy] == 6) {
+		ctx.dungeon[i - 1][j + yy] = 54;
 	}
-	if (dungeon[i - 1][j + yy - 1] == 6) {
-		dungeon[i - 1][j + yy - 1] = 55;
+	if (ctx.dungeon[i - 1][j + yy - 1] == 6) {
+		ctx.dungeon[i - 1][j + yy - 1] = 55;
 	}
 }
 
-static void L4AddWall()
+static void L4AddWall(DungeonContext &ctx)
 {
 	int i, j, x, y;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dflags[i][j] != 0) {
+			if (ctx.dflags[i][j] != 0) {
 				continue;
 			}
-			if (dungeon[i][j] == 10 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 10 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 12 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 12 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 13 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 13 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 15 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 15 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 16 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 16 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 21 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 21 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 22 && GenerateRnd(100) < WALL_CHANCE) {
-				x = L4HWallOk(i, j);
+			if (ctx.dungeon[i][j] == 22 && GenerateRnd(100) < WALL_CHANCE) {
+				x = L4HWallOk(ctx, i, j);
 				if (x != -1) {
-					L4HorizWall(i, j, x);
+					L4HorizWall(ctx, i, j, x);
 				}
 			}
-			if (dungeon[i][j] == 8 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 8 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 9 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 9 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 11 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 11 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 14 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 14 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 15 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 15 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 16 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 16 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 21 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 21 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
-			if (dungeon[i][j] == 23 && GenerateRnd(100) < WALL_CHANCE) {
-				y = L4VWallOk(i, j);
+			if (ctx.dungeon[i][j] == 23 && GenerateRnd(100) < WALL_CHANCE) {
+				y = L4VWallOk(ctx, i, j);
 				if (y != -1) {
-					L4VertWall(i, j, y);
+					L4VertWall(ctx, i, j, y);
 				}
 			}
 		}
 	}
 }
 
-static void L4tileFix()
+static void L4tileFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 6)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 13;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 14;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 6)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 13;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 14;
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 6)
-				dungeon[i + 1][j] = 2;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 9 && dungeon[i + 1][j] == 6)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 13;
-			if (dungeon[i][j] == 6 && dungeon[i + 1][j] == 14)
-				dungeon[i + 1][j] = 15;
-			if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 13)
-				dungeon[i][j + 1] = 16;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 6 && dungeon[i][j - 1] == 1)
-				dungeon[i][j - 1] = 1;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 6)
+				ctx.dungeon[i + 1][j] = 2;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i + 1][j] == 6)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 13;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i + 1][j] == 14)
+				ctx.dungeon[i + 1][j] = 15;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 13)
+				ctx.dungeon[i][j + 1] = 16;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j - 1] == 1)
+				ctx.dungeon[i][j - 1] = 1;
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 27;
-			if (dungeon[i][j] == 27 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 27;
-			if (dungeon[i][j] == 27 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 27)
-				dungeon[i + 1][j] = 26;
-			if (dungeon[i][j] == 27 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 15)
-				dungeon[i + 1][j] = 14;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 15)
-				dungeon[i + 1][j] = 14;
-			if (dungeon[i][j] == 22 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 27 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 6 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] != 0) /* check */
-				dungeon[i + 1][j] = 22;
-			if (dungeon[i][j] == 22 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 1 && dungeon[i + 1][j - 1] == 1)
-				dungeon[i + 1][j] = 13;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 30 && dungeon[i][j + 1] == 6)
-				dungeon[i + 1][j] = 28;
-			if (dungeon[i][j] == 16 && dungeon[i + 1][j] == 6 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 27;
-			if (dungeon[i][j] == 16 && dungeon[i][j + 1] == 30 && dungeon[i + 1][j + 1] == 30)
-				dungeon[i][j + 1] = 27;
-			if (dungeon[i][j] == 6 && dungeon[i + 1][j] == 30 && dungeon[i + 1][j - 1] == 6)
-				dungeon[i + 1][j] = 21;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] == 9)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 9 && dungeon[i + 1][j] == 15)
-				dungeon[i + 1][j] = 14;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] == 2)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 18)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 9 && dungeon[i + 1][j] == 15)
-				dungeon[i + 1][j] = 14;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 19 && dungeon[i + 1][j - 1] == 30)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 24 && dungeon[i][j - 1] == 30 && dungeon[i][j - 2] == 6)
-				dungeon[i][j - 1] = 21;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 28;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 28;
-			if (dungeon[i][j] == 28 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 28 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 19 && dungeon[i + 2][j] == 2 && dungeon[i + 1][j - 1] == 18 && dungeon[i + 1][j + 1] == 1)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 19 && dungeon[i + 2][j] == 2 && dungeon[i + 1][j - 1] == 22 && dungeon[i + 1][j + 1] == 1)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 19 && dungeon[i + 2][j] == 2 && dungeon[i + 1][j - 1] == 18 && dungeon[i + 1][j + 1] == 13)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 21 && dungeon[i + 2][j] == 2 && dungeon[i + 1][j - 1] == 18 && dungeon[i + 1][j + 1] == 1)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j + 1] == 1 && dungeon[i + 1][j - 1] == 22 && dungeon[i + 2][j] == 3)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 28 && dungeon[i + 2][j] == 30 && dungeon[i + 1][j - 1] == 6)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 28 && dungeon[i + 2][j] == 1)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] == 30)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 28 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j - 1] == 21)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] == 30)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 18)
-				dungeon[i + 1][j] = 25;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 9 && dungeon[i + 2][j] == 2)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 10)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 15 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 22 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 18 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 24 && dungeon[i - 1][j] == 30)
-				dungeon[i - 1][j] = 19;
-			if (dungeon[i][j] == 21 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 21 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 22 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 21 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 16 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 22 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 18 && dungeon[i + 2][j] == 30)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 9 && dungeon[i + 1][j + 1] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 27 && dungeon[i + 1][j + 1] == 2)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 23 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 23 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 25 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 22 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 23 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 15)
-				dungeon[i + 1][j] = 14;
-			if (dungeon[i][j] == 23 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 27)
-				dungeon[i + 1][j] = 26;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 18)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 26 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 29 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 29 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 1 && dungeon[i][j - 1] == 15)
-				dungeon[i][j - 1] = 10;
-			if (dungeon[i][j] == 18 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 23 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 18 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 30 && dungeon[i + 1][j + 1] == 30)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 28 && dungeon[i + 1][j - 1] == 6)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 23 && dungeon[i + 1][j] == 18 && dungeon[i][j - 1] == 6)
-				dungeon[i + 1][j] = 24;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 23 && dungeon[i + 2][j] == 30)
-				dungeon[i + 1][j] = 28;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 28 && dungeon[i + 2][j] == 30 && dungeon[i + 1][j - 1] == 6)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 23 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 29 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 29 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 26 && dungeon[i + 1][j] == 30)
-				dungeon[i + 1][j] = 19;
-			if (dungeon[i][j] == 16 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 25 && dungeon[i][j + 1] == 30)
-				dungeon[i][j + 1] = 18;
-			if (dungeon[i][j] == 18 && dungeon[i][j + 1] == 2)
-				dungeon[i][j + 1] = 15;
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 13;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 13 && dungeon[i + 1][j - 1] == 6)
-				dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 27;
+			if (ctx.dungeon[i][j] == 27 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 27;
+			if (ctx.dungeon[i][j] == 27 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 27)
+				ctx.dungeon[i + 1][j] = 26;
+			if (ctx.dungeon[i][j] == 27 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 15)
+				ctx.dungeon[i + 1][j] = 14;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 15)
+				ctx.dungeon[i + 1][j] = 14;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 27 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] != 0) /* check */
+				ctx.dungeon[i + 1][j] = 22;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 1 && ctx.dungeon[i + 1][j - 1] == 1)
+				ctx.dungeon[i + 1][j] = 13;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 30 && ctx.dungeon[i][j + 1] == 6)
+				ctx.dungeon[i + 1][j] = 28;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i + 1][j] == 6 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 27;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i][j + 1] == 30 && ctx.dungeon[i + 1][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 27;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i + 1][j] == 30 && ctx.dungeon[i + 1][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 21;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] == 9)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i + 1][j] == 15)
+				ctx.dungeon[i + 1][j] = 14;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] == 2)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 18)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i + 1][j] == 15)
+				ctx.dungeon[i + 1][j] = 14;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 19 && ctx.dungeon[i + 1][j - 1] == 30)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 24 && ctx.dungeon[i][j - 1] == 30 && ctx.dungeon[i][j - 2] == 6)
+				ctx.dungeon[i][j - 1] = 21;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 28;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 28;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 2][j] == 2 && ctx.dungeon[i + 1][j - 1] == 18 && ctx.dungeon[i + 1][j + 1] == 1)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 2][j] == 2 && ctx.dungeon[i + 1][j - 1] == 22 && ctx.dungeon[i + 1][j + 1] == 1)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 2][j] == 2 && ctx.dungeon[i + 1][j - 1] == 18 && ctx.dungeon[i + 1][j + 1] == 13)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 2][j] == 2 && ctx.dungeon[i + 1][j - 1] == 18 && ctx.dungeon[i + 1][j + 1] == 1)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j + 1] == 1 && ctx.dungeon[i + 1][j - 1] == 22 && ctx.dungeon[i + 2][j] == 3)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 2][j] == 30 && ctx.dungeon[i + 1][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 2][j] == 1)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] == 30)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j - 1] == 21)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] == 30)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 18)
+				ctx.dungeon[i + 1][j] = 25;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 9 && ctx.dungeon[i + 2][j] == 2)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 10)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 24 && ctx.dungeon[i - 1][j] == 30)
+				ctx.dungeon[i - 1][j] = 19;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 18 && ctx.dungeon[i + 2][j] == 30)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 9 && ctx.dungeon[i + 1][j + 1] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 27 && ctx.dungeon[i + 1][j + 1] == 2)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 25 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 15)
+				ctx.dungeon[i + 1][j] = 14;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 27)
+				ctx.dungeon[i + 1][j] = 26;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 18)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 26 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 29 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 29 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j - 1] == 15)
+				ctx.dungeon[i][j - 1] = 10;
+			if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 30 && ctx.dungeon[i + 1][j + 1] == 30)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 1][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i + 1][j] == 18 && ctx.dungeon[i][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 24;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 23 && ctx.dungeon[i + 2][j] == 30)
+				ctx.dungeon[i + 1][j] = 28;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 2][j] == 30 && ctx.dungeon[i + 1][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 23 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 29 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 29 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 26 && ctx.dungeon[i + 1][j] == 30)
+				ctx.dungeon[i + 1][j] = 19;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 25 && ctx.dungeon[i][j + 1] == 30)
+				ctx.dungeon[i][j + 1] = 18;
+			if (ctx.dungeon[i][j] == 18 && ctx.dungeon[i][j + 1] == 2)
+				ctx.dungeon[i][j + 1] = 15;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 13;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 13 && ctx.dungeon[i + 1][j - 1] == 6)
+				ctx.dungeon[i + 1][j] = 16;
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 21 && dungeon[i][j + 1] == 24 && dungeon[i][j + 2] == 1)
-				dungeon[i][j + 1] = 17;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j + 1] == 9 && dungeon[i + 1][j - 1] == 1 && dungeon[i + 2][j] == 16)
-				dungeon[i + 1][j] = 29;
-			if (dungeon[i][j] == 2 && dungeon[i - 1][j] == 6)
-				dungeon[i - 1][j] = 8;
-			if (dungeon[i][j] == 1 && dungeon[i][j - 1] == 6)
-				dungeon[i][j - 1] = 7;
-			if (dungeon[i][j] == 6 && dungeon[i + 1][j] == 15 && dungeon[i + 1][j + 1] == 4)
-				dungeon[i + 1][j] = 10;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 6)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 9 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 10 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 16)
-				dungeon[i][j + 1] = 13;
-			if (dungeon[i][j] == 6 && dungeon[i][j + 1] == 13)
-				dungeon[i][j + 1] = 16;
-			if (dungeon[i][j] == 25 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 28 && dungeon[i][j - 1] == 6 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 10)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 10 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 27 && dungeon[i + 1][j] == 9)
-				dungeon[i + 1][j] = 11;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 1)
-				dungeon[i + 1][j] = 16;
-			if (dungeon[i][j] == 11 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 9 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 14 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 3)
-				dungeon[i + 1][j] = 5;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 5 && dungeon[i + 1][j - 1] == 16)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 2 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 9 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 1 && dungeon[i][j - 1] == 8)
-				dungeon[i][j - 1] = 9;
-			if (dungeon[i][j] == 28 && dungeon[i + 1][j] == 23 && dungeon[i + 1][j + 1] == 3)
-				dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i][j + 1] == 24 && ctx.dungeon[i][j + 2] == 1)
+				ctx.dungeon[i][j + 1] = 17;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j + 1] == 9 && ctx.dungeon[i + 1][j - 1] == 1 && ctx.dungeon[i + 2][j] == 16)
+				ctx.dungeon[i + 1][j] = 29;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i - 1][j] == 6)
+				ctx.dungeon[i - 1][j] = 8;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j - 1] == 6)
+				ctx.dungeon[i][j - 1] = 7;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i + 1][j] == 15 && ctx.dungeon[i + 1][j + 1] == 4)
+				ctx.dungeon[i + 1][j] = 10;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 6)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 16)
+				ctx.dungeon[i][j + 1] = 13;
+			if (ctx.dungeon[i][j] == 6 && ctx.dungeon[i][j + 1] == 13)
+				ctx.dungeon[i][j + 1] = 16;
+			if (ctx.dungeon[i][j] == 25 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i][j - 1] == 6 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 10)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 27 && ctx.dungeon[i + 1][j] == 9)
+				ctx.dungeon[i + 1][j] = 11;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 1)
+				ctx.dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 14 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 3)
+				ctx.dungeon[i + 1][j] = 5;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 5 && ctx.dungeon[i + 1][j - 1] == 16)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 2 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j - 1] == 8)
+				ctx.dungeon[i][j - 1] = 9;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i + 1][j] == 23 && ctx.dungeon[i + 1][j + 1] == 3)
+				ctx.dungeon[i + 1][j] = 16;
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 10)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 17 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 10 && dungeon[i + 1][j] == 4)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 17 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 29 && dungeon[i][j + 1] == 9)
-				dungeon[i][j + 1] = 10;
-			if (dungeon[i][j] == 13 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 9 && dungeon[i][j + 1] == 16)
-				dungeon[i][j + 1] = 13;
-			if (dungeon[i][j] == 10 && dungeon[i][j + 1] == 16)
-				dungeon[i][j + 1] = 13;
-			if (dungeon[i][j] == 16 && dungeon[i][j + 1] == 3)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 11 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 10 && dungeon[i + 1][j] == 3 && dungeon[i + 1][j - 1] == 16)
-				dungeon[i + 1][j] = 12;
-			if (dungeon[i][j] == 16 && dungeon[i][j + 1] == 5)
-				dungeon[i][j + 1] = 12;
-			if (dungeon[i][j] == 1 && dungeon[i][j + 1] == 6)
-				dungeon[i][j + 1] = 4;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j] == 13 && dungeon[i][j + 1] == 10)
-				dungeon[i + 1][j + 1] = 12;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 10)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 22 && dungeon[i][j + 1] == 11)
-				dungeon[i][j + 1] = 17;
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 28 && dungeon[i + 2][j] == 16)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 28 && dungeon[i + 1][j] == 23 && dungeon[i + 1][j + 1] == 1 && dungeon[i + 2][j] == 6)
-				dungeon[i + 1][j] = 16;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 10)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 17 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i + 1][j] == 4)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 17 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 29 && ctx.dungeon[i][j + 1] == 9)
+				ctx.dungeon[i][j + 1] = 10;
+			if (ctx.dungeon[i][j] == 13 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 9 && ctx.dungeon[i][j + 1] == 16)
+				ctx.dungeon[i][j + 1] = 13;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i][j + 1] == 16)
+				ctx.dungeon[i][j + 1] = 13;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i][j + 1] == 3)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 11 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 10 && ctx.dungeon[i + 1][j] == 3 && ctx.dungeon[i + 1][j - 1] == 16)
+				ctx.dungeon[i + 1][j] = 12;
+			if (ctx.dungeon[i][j] == 16 && ctx.dungeon[i][j + 1] == 5)
+				ctx.dungeon[i][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 1 && ctx.dungeon[i][j + 1] == 6)
+				ctx.dungeon[i][j + 1] = 4;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j] == 13 && ctx.dungeon[i][j + 1] == 10)
+				ctx.dungeon[i + 1][j + 1] = 12;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 10)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 22 && ctx.dungeon[i][j + 1] == 11)
+				ctx.dungeon[i][j + 1] = 17;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 2][j] == 16)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 28 && ctx.dungeon[i + 1][j] == 23 && ctx.dungeon[i + 1][j + 1] == 1 && ctx.dungeon[i + 2][j] == 6)
+				ctx.dungeon[i + 1][j] = 16;
 		}
 	}
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 15 && dungeon[i + 1][j] == 28 && dungeon[i + 2][j] == 16)
-				dungeon[i + 1][j] = 23;
-			if (dungeon[i][j] == 21 && dungeon[i + 1][j - 1] == 21 && dungeon[i + 1][j + 1] == 13 && dungeon[i + 2][j] == 2)
-				dungeon[i + 1][j] = 17;
-			if (dungeon[i][j] == 19 && dungeon[i + 1][j] == 15 && dungeon[i + 1][j + 1] == 12)
-				dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 15 && ctx.dungeon[i + 1][j] == 28 && ctx.dungeon[i + 2][j] == 16)
+				ctx.dungeon[i + 1][j] = 23;
+			if (ctx.dungeon[i][j] == 21 && ctx.dungeon[i + 1][j - 1] == 21 && ctx.dungeon[i + 1][j + 1] == 13 && ctx.dungeon[i + 2][j] == 2)
+				ctx.dungeon[i + 1][j] = 17;
+			if (ctx.dungeon[i][j] == 19 && ctx.dungeon[i + 1][j] == 15 && ctx.dungeon[i + 1][j + 1] == 12)
+				ctx.dungeon[i + 1][j] = 17;
 		}
 	}
 }
 
-static void DRLG_L4Subs()
+static void DRLG_L4Subs(DungeonContext &ctx)
 {
 	int x, y, i, rv;
 	BYTE c;
@@ -916,9 +907,9 @@ static void DRLG_L4Subs()
 		for (x = 0; x < DMAXX; x++) {
 			rv = GenerateRnd(3);
 			if (rv == 0) {
-				c = dungeon[x][y];
+				c = ctx.dungeon[x][y];
 				c = L4BTYPES[c];
-				if (c != 0 && dflags[x][y] == 0) {
+				if (c != 0 && ctx.dflags[x][y] == 0) {
 					rv = GenerateRnd(16);
 					i = -1;
 					while (rv >= 0) {
@@ -930,7 +921,7 @@ static void DRLG_L4Subs()
 							rv--;
 						}
 					}
-					dungeon[x][y] = i;
+					ctx.dungeon[x][y] = i;
 				}
 			}
 		}
@@ -939,16 +930,16 @@ static void DRLG_L4Subs()
 		for (x = 0; x < DMAXX; x++) {
 			rv = GenerateRnd(10);
 			if (rv == 0) {
-				c = dungeon[x][y];
-				if (L4BTYPES[c] == 6 && dflags[x][y] == 0) {
-					dungeon[x][y] = GenerateRnd(3) + 95;
+				c = ctx.dungeon[x][y];
+				if (L4BTYPES[c] == 6 && ctx.dflags[x][y] == 0) {
+					ctx.dungeon[x][y] = GenerateRnd(3) + 95;
 				}
 			}
 		}
 	}
 }
 
-static void L4makeDungeon()
+static void L4makeDungeon(DungeonContext &ctx)
 {
 	int i, j, k, l;
 
@@ -956,60 +947,60 @@ static void L4makeDungeon()
 		for (i = 0; i < 20; i++) {
 			k = i * 2;
 			l = j * 2;
-			L4dungeon[k][l] = dung[i][j];
-			L4dungeon[k][l + 1] = dung[i][j];
-			L4dungeon[k + 1][l] = dung[i][j];
-			L4dungeon[k + 1][l + 1] = dung[i][j];
+			ctx.L4dungeon[k][l] = ctx.dung[i][j];
+			ctx.L4dungeon[k][l + 1] = ctx.dung[i][j];
+			ctx.L4dungeon[k + 1][l] = ctx.dung[i][j];
+			ctx.L4dungeon[k + 1][l + 1] = ctx.dung[i][j];
 		}
 	}
 	for (j = 0; j < 20; j++) {
 		for (i = 0; i < 20; i++) {
 			k = i * 2;
 			l = j * 2;
-			L4dungeon[k][l + 40] = dung[i][19 - j];
-			L4dungeon[k][l + 41] = dung[i][19 - j];
-			L4dungeon[k + 1][l + 40] = dung[i][19 - j];
-			L4dungeon[k + 1][l + 41] = dung[i][19 - j];
+			ctx.L4dungeon[k][l + 40] = ctx.dung[i][19 - j];
+			ctx.L4dungeon[k][l + 41] = ctx.dung[i][19 - j];
+			ctx.L4dungeon[k + 1][l + 40] = ctx.dung[i][19 - j];
+			ctx.L4dungeon[k + 1][l + 41] = ctx.dung[i][19 - j];
 		}
 	}
 	for (j = 0; j < 20; j++) {
 		for (i = 0; i < 20; i++) {
 			k = i * 2;
 			l = j * 2;
-			L4dungeon[k + 40][l] = dung[19 - i][j];
-			L4dungeon[k + 40][l + 1] = dung[19 - i][j];
-			L4dungeon[k + 41][l] = dung[19 - i][j];
-			L4dungeon[k + 41][l + 1] = dung[19 - i][j];
+			ctx.L4dungeon[k + 40][l] = ctx.dung[19 - i][j];
+			ctx.L4dungeon[k + 40][l + 1] = ctx.dung[19 - i][j];
+			ctx.L4dungeon[k + 41][l] = ctx.dung[19 - i][j];
+			ctx.L4dungeon[k + 41][l + 1] = ctx.dung[19 - i][j];
 		}
 	}
 	for (j = 0; j < 20; j++) {
 		for (i = 0; i < 20; i++) {
 			k = i * 2;
 			l = j * 2;
-			L4dungeon[k + 40][l + 40] = dung[19 - i][19 - j];
-			L4dungeon[k + 40][l + 41] = dung[19 - i][19 - j];
-			L4dungeon[k + 41][l + 40] = dung[19 - i][19 - j];
-			L4dungeon[k + 41][l + 41] = dung[19 - i][19 - j];
+			ctx.L4dungeon[k + 40][l + 40] = ctx.dung[19 - i][19 - j];
+			ctx.L4dungeon[k + 40][l + 41] = ctx.dung[19 - i][19 - j];
+			ctx.L4dungeon[k + 41][l + 40] = ctx.dung[19 - i][19 - j];
+			ctx.L4dungeon[k + 41][l + 41] = ctx.dung[19 - i][19 - j];
 		}
 	}
 }
 
-static void uShape()
+static void uShape(DungeonContext &ctx)
 {
 	int j, i, rv;
 
 	for (j = 19; j >= 0; j--) {
 		for (i = 19; i >= 0; i--) {
-			if (dung[i][j] != 1) {
-				hallok[j] = false;
+			if (ctx.dung[i][j] != 1) {
+				ctx.hallok[j] = false;
 			}
-			if (dung[i][j] == 1) {
+			if (ctx.dung[i][j] == 1) {
 				// BUGFIX: check that i + 1 < 20 and j + 1 < 20 (fixed)
 				if (i + 1 < 20 && j + 1 < 20
-				    && dung[i][j + 1] == 1 && dung[i + 1][j + 1] == 0) {
-					hallok[j] = true;
+				    && ctx.dung[i][j + 1] == 1 && ctx.dung[i + 1][j + 1] == 0) {
+					ctx.hallok[j] = true;
 				} else {
-					hallok[j] = false;
+					ctx.hallok[j] = false;
 				}
 				i = 0;
 			}
@@ -1018,14 +1009,14 @@ static void uShape()
 
 	rv = GenerateRnd(19) + 1;
 	do {
-		if (hallok[rv]) {
+		if (ctx.hallok[rv]) {
 			for (i = 19; i >= 0; i--) {
-				if (dung[i][rv] == 1) {
+				if (ctx.dung[i][rv] == 1) {
 					i = -1;
 					rv = 0;
 				} else {
-					dung[i][rv] = 1;
-					dung[i][rv + 1] = 1;
+					ctx.dung[i][rv] = 1;
+					ctx.dung[i][rv + 1] = 1;
 				}
 			}
 		} else {
@@ -1038,16 +1029,16 @@ static void uShape()
 
 	for (i = 19; i >= 0; i--) {
 		for (j = 19; j >= 0; j--) {
-			if (dung[i][j] != 1) {
-				hallok[i] = false;
+			if (ctx.dung[i][j] != 1) {
+				ctx.hallok[i] = false;
 			}
-			if (dung[i][j] == 1) {
+			if (ctx.dung[i][j] == 1) {
 				// BUGFIX: check that i + 1 < 20 and j + 1 < 20 (fixed)
 				if (i + 1 < 20 && j + 1 < 20
-				    && dung[i + 1][j] == 1 && dung[i + 1][j + 1] == 0) {
-					hallok[i] = true;
+				    && ctx.dung[i + 1][j] == 1 && ctx.dung[i + 1][j + 1] == 0) {
+					ctx.hallok[i] = true;
 				} else {
-					hallok[i] = false;
+					ctx.hallok[i] = false;
 				}
 				j = 0;
 			}
@@ -1056,14 +1047,14 @@ static void uShape()
 
 	rv = GenerateRnd(19) + 1;
 	do {
-		if (hallok[rv]) {
+		if (ctx.hallok[rv]) {
 			for (j = 19; j >= 0; j--) {
-				if (dung[rv][j] == 1) {
+				if (ctx.dung[rv][j] == 1) {
 					j = -1;
 					rv = 0;
 				} else {
-					dung[rv][j] = 1;
-					dung[rv + 1][j] = 1;
+					ctx.dung[rv][j] = 1;
+					ctx.dung[rv + 1][j] = 1;
 				}
 			}
 		} else {
@@ -1075,7 +1066,7 @@ static void uShape()
 	} while (rv != 0);
 }
 
-static long GetArea()
+static long GetArea(DungeonContext &ctx)
 {
 	int i, j;
 	long rv;
@@ -1084,7 +1075,7 @@ static long GetArea()
 
 	for (j = 0; j < 20; j++) {
 		for (i = 0; i < 20; i++) {
-			if (dung[i][j] == 1) {
+			if (ctx.dung[i][j] == 1) {
 				rv++;
 			}
 		}
@@ -1093,18 +1084,18 @@ static long GetArea()
 	return rv;
 }
 
-static void L4drawRoom(int x, int y, int width, int height)
+static void L4drawRoom(DungeonContext &ctx, int x, int y, int width, int height)
 {
 	int i, j;
 
 	for (j = 0; j < height && j + y < 20; j++) {
 		for (i = 0; i < width && i + x < 20; i++) {
-			dung[i + x][j + y] = 1;
+			ctx.dung[i + x][j + y] = 1;
 		}
 	}
 }
 
-static bool L4checkRoom(int x, int y, int width, int height)
+static bool L4checkRoom(DungeonContext &ctx, int x, int y, int width, int height)
 {
 	int i, j;
 
@@ -1117,7 +1108,7 @@ static bool L4checkRoom(int x, int y, int width, int height)
 			if (i + x < 0 || i + x >= 20 || j + y < 0 || j + y >= 20) {
 				return false;
 			}
-			if (dung[i + x][j + y] != 0) {
+			if (ctx.dung[i + x][j + y] != 0) {
 				return false;
 			}
 		}
@@ -1126,7 +1117,7 @@ static bool L4checkRoom(int x, int y, int width, int height)
 	return true;
 }
 
-static void L4roomGen(int x, int y, int w, int h, int dir)
+static void L4roomGen(DungeonContext &ctx, int x, int y, int w, int h, int dir)
 {
 	bool ran, ran2;
 	int width, height, rx, ry, ry2;
@@ -1141,20 +1132,20 @@ static void L4roomGen(int x, int y, int w, int h, int dir)
 			ch = (GenerateRnd(5) + 2) & ~1;
 			cy1 = h / 2 + y - ch / 2;
 			cx1 = x - cw;
-			ran = L4checkRoom(cx1 - 1, cy1 - 1, ch + 2, cw + 1); /// BUGFIX: swap args 3 and 4 ("ch+2" and "cw+1")
+			ran = L4checkRoom(ctx, cx1 - 1, cy1 - 1, ch + 2, cw + 1); /// BUGFIX: swap args 3 and 4 ("ch+2" and "cw+1")
 			num++;
 		} while (!ran && num < 20);
 
 		if (ran)
-			L4drawRoom(cx1, cy1, cw, ch);
+			L4drawRoom(ctx, cx1, cy1, cw, ch);
 		cx2 = x + w;
-		ran2 = L4checkRoom(cx2, cy1 - 1, cw + 1, ch + 2);
+		ran2 = L4checkRoom(ctx, cx2, cy1 - 1, cw + 1, ch + 2);
 		if (ran2)
-			L4drawRoom(cx2, cy1, cw, ch);
+			L4drawRoom(ctx, cx2, cy1, cw, ch);
 		if (ran)
-			L4roomGen(cx1, cy1, cw, ch, 1);
+			L4roomGen(ctx, cx1, cy1, cw, ch, 1);
 		if (ran2)
-			L4roomGen(cx2, cy1, cw, ch, 1);
+			L4roomGen(ctx, cx2, cy1, cw, ch, 1);
 		return;
 	}
 
@@ -1163,32 +1154,32 @@ static void L4roomGen(int x, int y, int w, int h, int dir)
 		height = (GenerateRnd(5) + 2) & ~1;
 		rx = w / 2 + x - width / 2;
 		ry = y - height;
-		ran = L4checkRoom(rx - 1, ry - 1, width + 2, height + 1);
+		ran = L4checkRoom(ctx, rx - 1, ry - 1, width + 2, height + 1);
 		num++;
 	} while (!ran && num < 20);
 
 	if (ran)
-		L4drawRoom(rx, ry, width, height);
+		L4drawRoom(ctx, rx, ry, width, height);
 	ry2 = y + h;
-	ran2 = L4checkRoom(rx - 1, ry2, width + 2, height + 1);
+	ran2 = L4checkRoom(ctx, rx - 1, ry2, width + 2, height + 1);
 	if (ran2)
-		L4drawRoom(rx, ry2, width, height);
+		L4drawRoom(ctx, rx, ry2, width, height);
 	if (ran)
-		L4roomGen(rx, ry, width, height, 0);
+		L4roomGen(ctx, rx, ry, width, height, 0);
 	if (ran2)
-		L4roomGen(rx, ry2, width, height, 0);
+		L4roomGen(ctx, rx, ry2, width, height, 0);
 }
 
-static void L4firstRoom()
+static void L4firstRoom(DungeonContext &ctx)
 {
 	int x, y, w, h, rndx, rndy, xmin, xmax, ymin, ymax, tx, ty;
 
-	if (currlevel != 16) {
-		if (currlevel == quests[Q_WARLORD]._qlevel && quests[Q_WARLORD]._qactive != QUEST_NOTAVAIL) {
+	if (ctx.currlevel != 16) {
+		if (ctx.currlevel == quests[Q_WARLORD]._qlevel && quests[Q_WARLORD]._qactive != QUEST_NOTAVAIL) {
 			assert(!gbIsMultiplayer);
 			w = 11;
 			h = 11;
-		} else if (currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer) {
+		} else if (ctx.currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer) {
 			w = 11;
 			h = 11;
 		} else {
@@ -1219,72 +1210,72 @@ static void L4firstRoom()
 		y = rndy;
 	}
 
-	if (currlevel == 16) {
-		l4holdx = x;
-		l4holdy = y;
+	if (ctx.currlevel == 16) {
+		ctx.l4holdx = x;
+		ctx.l4holdy = y;
 	}
-	if (QuestStatus(Q_WARLORD) || (currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer)) {
-		SP4x1 = x + 1;
-		SP4y1 = y + 1;
-		SP4x2 = SP4x1 + w;
-		SP4y2 = SP4y1 + h;
+	if (QuestStatus(Q_WARLORD, ctx.currlevel) || (ctx.currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer)) {
+		ctx.SP4x1 = x + 1;
+		ctx.SP4y1 = y + 1;
+		ctx.SP4x2 = ctx.SP4x1 + w;
+		ctx.SP4y2 = ctx.SP4y1 + h;
 	} else {
-		SP4x1 = 0;
-		SP4y1 = 0;
-		SP4x2 = 0;
-		SP4y2 = 0;
+		ctx.SP4x1 = 0;
+		ctx.SP4y1 = 0;
+		ctx.SP4x2 = 0;
+		ctx.SP4y2 = 0;
 	}
 
-	L4drawRoom(x, y, w, h);
-	L4roomGen(x, y, w, h, GenerateRnd(2));
+	L4drawRoom(ctx, x, y, w, h);
+	L4roomGen(ctx, x, y, w, h, GenerateRnd(2));
 }
 
-void L4SaveQuads()
+void L4SaveQuads(DungeonContext &ctx)
 {
 	int i, j, x, y;
 
-	x = l4holdx;
-	y = l4holdy;
+	x = ctx.l4holdx;
+	y = ctx.l4holdy;
 
 	for (j = 0; j < 14; j++) {
 		for (i = 0; i < 14; i++) {
-			dflags[i + x][j + y] = 1;
-			dflags[DMAXX - 1 - i - x][j + y] = 1;
-			dflags[i + x][DMAXY - 1 - j - y] = 1;
-			dflags[DMAXX - 1 - i - x][DMAXY - 1 - j - y] = 1;
+			ctx.dflags[i + x][j + y] = 1;
+			ctx.dflags[DMAXX - 1 - i - x][j + y] = 1;
+			ctx.dflags[i + x][DMAXY - 1 - j - y] = 1;
+			ctx.dflags[DMAXX - 1 - i - x][DMAXY - 1 - j - y] = 1;
 		}
 	}
 }
 
-void DRLG_LoadDiabQuads(bool preflag)
+void DRLG_LoadDiabQuads(DungeonContext &ctx, bool preflag)
 {
 	{
 		auto dunData = LoadFileInMem<uint16_t>("Levels\\L4Data\\diab1.DUN");
-		diabquad1x = 4 + l4holdx;
-		diabquad1y = 4 + l4holdy;
-		DRLG_L4SetRoom(dunData.get(), diabquad1x, diabquad1y);
+		ctx.diabquad1x = 4 + ctx.l4holdx;
+		ctx.diabquad1y = 4 + ctx.l4holdy;
+		DRLG_L4SetRoom(ctx, dunData.get(), ctx.diabquad1x, ctx.diabquad1y);
 	}
 	{
 		auto dunData = LoadFileInMem<uint16_t>(preflag ? "Levels\\L4Data\\diab2b.DUN" : "Levels\\L4Data\\diab2a.DUN");
-		diabquad2x = 27 - l4holdx;
-		diabquad2y = 1 + l4holdy;
-		DRLG_L4SetRoom(dunData.get(), diabquad2x, diabquad2y);
+		ctx.diabquad2x = 27 - ctx.l4holdx;
+		ctx.diabquad2y = 1 + ctx.l4holdy;
+		DRLG_L4SetRoom(ctx, dunData.get(), ctx.diabquad2x, ctx.diabquad2y);
 	}
 	{
 		auto dunData = LoadFileInMem<uint16_t>(preflag ? "Levels\\L4Data\\diab3b.DUN" : "Levels\\L4Data\\diab3a.DUN");
-		diabquad3x = 1 + l4holdx;
-		diabquad3y = 27 - l4holdy;
-		DRLG_L4SetRoom(dunData.get(), diabquad3x, diabquad3y);
+		ctx.diabquad3x = 1 + ctx.l4holdx;
+		ctx.diabquad3y = 27 - ctx.l4holdy;
+		DRLG_L4SetRoom(ctx, dunData.get(), ctx.diabquad3x, ctx.diabquad3y);
 	}
 	{
 		auto dunData = LoadFileInMem<uint16_t>(preflag ? "Levels\\L4Data\\diab4b.DUN" : "Levels\\L4Data\\diab4a.DUN");
-		diabquad4x = 28 - l4holdx;
-		diabquad4y = 28 - l4holdy;
-		DRLG_L4SetRoom(dunData.get(), diabquad4x, diabquad4y);
+		ctx.diabquad4x = 28 - ctx.l4holdx;
+		ctx.diabquad4y = 28 - ctx.l4holdy;
+		DRLG_L4SetRoom(ctx, dunData.get(), ctx.diabquad4x, ctx.diabquad4y);
 	}
 }
 
-static bool DRLG_L4PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
+static bool DRLG_L4PlaceMiniSet(DungeonContext &ctx, const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int ldir)
 {
 	int sx, sy, sw, sh, xx, yy, i, ii, numt, bailcnt;
 	bool found;
@@ -1304,7 +1295,7 @@ static bool DRLG_L4PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 		found = false;
 		for (bailcnt = 0; !found && bailcnt < 200; bailcnt++) {
 			found = true;
-			if (sx >= SP4x1 && sx <= SP4x2 && sy >= SP4y1 && sy <= SP4y2) {
+			if (sx >= ctx.SP4x1 && sx <= ctx.SP4x2 && sy >= ctx.SP4y1 && sy <= ctx.SP4y2) {
 				found = false;
 			}
 			if (cx != -1 && sx >= cx - sw && sx <= cx + 12) {
@@ -1320,10 +1311,10 @@ static bool DRLG_L4PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 			ii = 2;
 			for (yy = 0; yy < sh && found; yy++) {
 				for (xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
+					if (miniset[ii] != 0 && ctx.dungeon[xx + sx][yy + sy] != miniset[ii]) {
 						found = false;
 					}
-					if (dflags[xx + sx][yy + sy] != 0) {
+					if (ctx.dflags[xx + sx][yy + sy] != 0) {
 						found = false;
 					}
 					ii++;
@@ -1347,24 +1338,24 @@ static bool DRLG_L4PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 		for (yy = 0; yy < sh; yy++) {
 			for (xx = 0; xx < sw; xx++) {
 				if (miniset[ii] != 0) {
-					dungeon[xx + sx][yy + sy] = miniset[ii];
-					dflags[xx + sx][yy + sy] |= 8;
+					ctx.dungeon[xx + sx][yy + sy] = miniset[ii];
+					ctx.dflags[xx + sx][yy + sy] |= 8;
 				}
 				ii++;
 			}
 		}
 	}
 
-	if (currlevel == 15 && quests[Q_BETRAYER]._qactive >= QUEST_ACTIVE) { /// Lazarus staff skip bug fixed
-		quests[Q_BETRAYER].position = { sx + 1, sy + 1 };
+	if (ctx.currlevel == 15 && quests[Q_BETRAYER]._qactive >= QUEST_ACTIVE) { /// Lazarus staff skip bug fixed
+		ctx.betrayerPosition = Point { sx + 1, sy + 1 };
 	}
 	if (setview) {
-		ViewX = 2 * sx + 21;
-		ViewY = 2 * sy + 22;
+		ctx.ViewX = 2 * sx + 21;
+		ctx.ViewY = 2 * sy + 22;
 	}
 	if (ldir == 0) {
-		LvlViewX = 2 * sx + 21;
-		LvlViewY = 2 * sy + 22;
+		ctx.LvlViewX = 2 * sx + 21;
+		ctx.LvlViewY = 2 * sy + 22;
 	}
 
 	return true;
@@ -1375,54 +1366,54 @@ static bool DRLG_L4PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx,
 #pragma GCC optimize("O0")
 #endif
 
-static void DRLG_L4FTVR(int i, int j, int x, int y, int d)
+static void DRLG_L4FTVR(DungeonContext &ctx, int i, int j, int x, int y, int d)
 {
-	if (dTransVal[x][y] != 0 || dungeon[i][j] != 6) {
+	if (ctx.dTransVal[x][y] != 0 || ctx.dungeon[i][j] != 6) {
 		if (d == 1) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		}
 		if (d == 2) {
-			dTransVal[x + 1][y] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 3) {
-			dTransVal[x][y] = TransVal;
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		}
 		if (d == 4) {
-			dTransVal[x][y + 1] = TransVal;
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 5) {
-			dTransVal[x + 1][y + 1] = TransVal;
+			ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
 		}
 		if (d == 6) {
-			dTransVal[x][y + 1] = TransVal;
+			ctx.dTransVal[x][y + 1] = ctx.TransVal;
 		}
 		if (d == 7) {
-			dTransVal[x + 1][y] = TransVal;
+			ctx.dTransVal[x + 1][y] = ctx.TransVal;
 		}
 		if (d == 8) {
-			dTransVal[x][y] = TransVal;
+			ctx.dTransVal[x][y] = ctx.TransVal;
 		}
 	} else {
-		dTransVal[x][y] = TransVal;
-		dTransVal[x + 1][y] = TransVal;
-		dTransVal[x][y + 1] = TransVal;
-		dTransVal[x + 1][y + 1] = TransVal;
-		DRLG_L4FTVR(i + 1, j, x + 2, y, 1);
-		DRLG_L4FTVR(i - 1, j, x - 2, y, 2);
-		DRLG_L4FTVR(i, j + 1, x, y + 2, 3);
-		DRLG_L4FTVR(i, j - 1, x, y - 2, 4);
-		DRLG_L4FTVR(i - 1, j - 1, x - 2, y - 2, 5);
-		DRLG_L4FTVR(i + 1, j - 1, x + 2, y - 2, 6);
-		DRLG_L4FTVR(i - 1, j + 1, x - 2, y + 2, 7);
-		DRLG_L4FTVR(i + 1, j + 1, x + 2, y + 2, 8);
+		ctx.dTransVal[x][y] = ctx.TransVal;
+		ctx.dTransVal[x + 1][y] = ctx.TransVal;
+		ctx.dTransVal[x][y + 1] = ctx.TransVal;
+		ctx.dTransVal[x + 1][y + 1] = ctx.TransVal;
+		DRLG_L4FTVR(ctx, i + 1, j, x + 2, y, 1);
+		DRLG_L4FTVR(ctx, i - 1, j, x - 2, y, 2);
+		DRLG_L4FTVR(ctx, i, j + 1, x, y + 2, 3);
+		DRLG_L4FTVR(ctx, i, j - 1, x, y - 2, 4);
+		DRLG_L4FTVR(ctx, i - 1, j - 1, x - 2, y - 2, 5);
+		DRLG_L4FTVR(ctx, i + 1, j - 1, x + 2, y - 2, 6);
+		DRLG_L4FTVR(ctx, i - 1, j + 1, x - 2, y + 2, 7);
+		DRLG_L4FTVR(ctx, i + 1, j + 1, x + 2, y + 2, 8);
 	}
 }
 
-static void DRLG_L4FloodTVal()
+static void DRLG_L4FloodTVal(DungeonContext &ctx)
 {
 	int i, j, xx, yy;
 
@@ -1430,9 +1421,9 @@ static void DRLG_L4FloodTVal()
 	for (j = 0; j < DMAXY; j++) {
 		xx = 16;
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == 6 && dTransVal[xx][yy] == 0) {
-				DRLG_L4FTVR(i, j, xx, yy, 0);
-				TransVal++;
+			if (ctx.dungeon[i][j] == 6 && ctx.dTransVal[xx][yy] == 0) {
+				DRLG_L4FTVR(ctx, i, j, xx, yy, 0);
+				ctx.TransVal++;
 			}
 			xx += 2;
 		}
@@ -1474,7 +1465,7 @@ bool IsDLLWall(char dd)
 	return false;
 }
 
-static void DRLG_L4TransFix()
+static void DRLG_L4TransFix(DungeonContext &ctx)
 {
 	int i, j, xx, yy;
 
@@ -1482,34 +1473,34 @@ static void DRLG_L4TransFix()
 	for (j = 0; j < DMAXY; j++) {
 		xx = 16;
 		for (i = 0; i < DMAXX; i++) {
-			if (IsDURWall(dungeon[i][j]) && dungeon[i][j - 1] == 18) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (IsDURWall(ctx.dungeon[i][j]) && ctx.dungeon[i][j - 1] == 18) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (IsDLLWall(dungeon[i][j]) && dungeon[i + 1][j] == 19) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (IsDLLWall(ctx.dungeon[i][j]) && ctx.dungeon[i + 1][j] == 19) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 18) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 18) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 19) {
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 19) {
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 24) {
-				dTransVal[xx + 1][yy] = dTransVal[xx][yy];
-				dTransVal[xx][yy + 1] = dTransVal[xx][yy];
-				dTransVal[xx + 1][yy + 1] = dTransVal[xx][yy];
+			if (ctx.dungeon[i][j] == 24) {
+				ctx.dTransVal[xx + 1][yy] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx][yy + 1] = ctx.dTransVal[xx][yy];
+				ctx.dTransVal[xx + 1][yy + 1] = ctx.dTransVal[xx][yy];
 			}
-			if (dungeon[i][j] == 57) {
-				dTransVal[xx - 1][yy] = dTransVal[xx][yy + 1];
-				dTransVal[xx][yy] = dTransVal[xx][yy + 1];
+			if (ctx.dungeon[i][j] == 57) {
+				ctx.dTransVal[xx - 1][yy] = ctx.dTransVal[xx][yy + 1];
+				ctx.dTransVal[xx][yy] = ctx.dTransVal[xx][yy + 1];
 			}
-			if (dungeon[i][j] == 53) {
-				dTransVal[xx][yy - 1] = dTransVal[xx + 1][yy];
-				dTransVal[xx][yy] = dTransVal[xx + 1][yy];
+			if (ctx.dungeon[i][j] == 53) {
+				ctx.dTransVal[xx][yy - 1] = ctx.dTransVal[xx + 1][yy];
+				ctx.dTransVal[xx][yy] = ctx.dTransVal[xx + 1][yy];
 			}
 			xx += 2;
 		}
@@ -1517,265 +1508,265 @@ static void DRLG_L4TransFix()
 	}
 }
 
-static void DRLG_L4Corners()
+static void DRLG_L4Corners(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 1; j < DMAXY - 1; j++) {
 		for (i = 1; i < DMAXX - 1; i++) {
-			if (dungeon[i][j] >= 18 && dungeon[i][j] <= 30) {
-				if (dungeon[i + 1][j] < 18) {
-					dungeon[i][j] += 98;
-				} else if (dungeon[i][j + 1] < 18) {
-					dungeon[i][j] += 98;
+			if (ctx.dungeon[i][j] >= 18 && ctx.dungeon[i][j] <= 30) {
+				if (ctx.dungeon[i + 1][j] < 18) {
+					ctx.dungeon[i][j] += 98;
+				} else if (ctx.dungeon[i][j + 1] < 18) {
+					ctx.dungeon[i][j] += 98;
 				}
 			}
 		}
 	}
 }
 
-void L4FixRim()
+void L4FixRim(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (i = 0; i < 20; i++) {
-		dung[i][0] = 0;
+		ctx.dung[i][0] = 0;
 	}
 	for (j = 0; j < 20; j++) {
-		dung[0][j] = 0;
+		ctx.dung[0][j] = 0;
 	}
 }
 
-void DRLG_L4GeneralFix()
+void DRLG_L4GeneralFix(DungeonContext &ctx)
 {
 	int i, j;
 
 	for (j = 0; j < DMAXY - 1; j++) {
 		for (i = 0; i < DMAXX - 1; i++) {
-			if ((dungeon[i][j] == 24 || dungeon[i][j] == 122) && dungeon[i + 1][j] == 2 && dungeon[i][j + 1] == 5) {
-				dungeon[i][j] = 17;
+			if ((ctx.dungeon[i][j] == 24 || ctx.dungeon[i][j] == 122) && ctx.dungeon[i + 1][j] == 2 && ctx.dungeon[i][j + 1] == 5) {
+				ctx.dungeon[i][j] = 17;
 			}
 		}
 	}
 }
 
-static void DRLG_L4(lvl_entry entry)
+static void DRLG_L4(DungeonContext &ctx, lvl_entry entry)
 {
 	int i, j, spi, spj, ar;
 	bool doneflag;
 
 	do {
-		DRLG_InitTrans();
+		DRLG_InitTrans(ctx);
 		do {
-			InitL4Dungeon();
-			L4firstRoom();
-			L4FixRim();
-			ar = GetArea();
+			InitL4Dungeon(ctx);
+			L4firstRoom(ctx);
+			L4FixRim(ctx);
+			ar = GetArea(ctx);
 			if (ar >= 173) {
-				uShape();
+				uShape(ctx);
 			}
 		} while (ar < 173);
-		L4makeDungeon();
-		L4makeDmt();
-		L4tileFix();
-		if (currlevel == 16) {
-			L4SaveQuads();
+		L4makeDungeon(ctx);
+		L4makeDmt(ctx);
+		L4tileFix(ctx);
+		if (ctx.currlevel == 16) {
+			L4SaveQuads(ctx);
 		}
-		if (QuestStatus(Q_WARLORD) || (currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer)) {
-			for (spi = SP4x1; spi < SP4x2; spi++) {
-				for (spj = SP4y1; spj < SP4y2; spj++) {
-					dflags[spi][spj] = 1;
+		if (QuestStatus(Q_WARLORD, ctx.currlevel) || (ctx.currlevel == quests[Q_BETRAYER]._qlevel && gbIsMultiplayer)) {
+			for (spi = ctx.SP4x1; spi < ctx.SP4x2; spi++) {
+				for (spj = ctx.SP4y1; spj < ctx.SP4y2; spj++) {
+					ctx.dflags[spi][spj] = 1;
 				}
 			}
 		}
-		L4AddWall();
-		DRLG_L4FloodTVal();
-		DRLG_L4TransFix();
-		if (setloadflag) {
-			DRLG_L4SetSPRoom(SP4x1, SP4y1);
+		L4AddWall(ctx);
+		DRLG_L4FloodTVal(ctx);
+		DRLG_L4TransFix(ctx);
+		if (ctx.setloadflag) {
+			DRLG_L4SetSPRoom(ctx, ctx.SP4x1, ctx.SP4y1);
 		}
-		if (currlevel == 16) {
-			DRLG_LoadDiabQuads(true);
+		if (ctx.currlevel == 16) {
+			DRLG_LoadDiabQuads(ctx, true);
 		}
-		if (QuestStatus(Q_WARLORD)) {
+		if (QuestStatus(Q_WARLORD, ctx.currlevel)) {
 			if (entry == ENTRY_MAIN) {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, true, 0);
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, false, 6);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, true, 0);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, false, 6);
 				}
-				ViewX++;
+				ctx.ViewX++;
 			} else if (entry == ENTRY_PREV) {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false, 0);
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, false, 6);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, false, 0);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, false, 6);
 				}
-				ViewX = 2 * setpc_x + 22;
-				ViewY = 2 * setpc_y + 22;
+				ctx.ViewX = 2 * ctx.setpc_x + 22;
+				ctx.ViewY = 2 * ctx.setpc_y + 22;
 			} else {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false, 0);
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, true, 6);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, false, 0);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, true, 6);
 				}
-				ViewX++;
+				ctx.ViewX++;
 			}
-		} else if (currlevel != 15) {
+		} else if (ctx.currlevel != 15) {
 			if (entry == ENTRY_MAIN) {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, true, 0);
-				if (doneflag && currlevel != 16) {
-					doneflag = DRLG_L4PlaceMiniSet(L4DSTAIRS, 1, 1, -1, -1, false, 1);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, true, 0);
+				if (doneflag && ctx.currlevel != 16) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4DSTAIRS, 1, 1, -1, -1, false, 1);
 				}
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, false, 6);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, false, 6);
 				}
-				ViewX++;
+				ctx.ViewX++;
 			} else if (entry == ENTRY_PREV) {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false, 0);
-				if (doneflag && currlevel != 16) {
-					doneflag = DRLG_L4PlaceMiniSet(L4DSTAIRS, 1, 1, -1, -1, true, 1);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, false, 0);
+				if (doneflag && ctx.currlevel != 16) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4DSTAIRS, 1, 1, -1, -1, true, 1);
 				}
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, false, 6);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, false, 6);
 				}
-				ViewY++;
+				ctx.ViewY++;
 			} else {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false, 0);
-				if (doneflag && currlevel != 16) {
-					doneflag = DRLG_L4PlaceMiniSet(L4DSTAIRS, 1, 1, -1, -1, false, 1);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, false, 0);
+				if (doneflag && ctx.currlevel != 16) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4DSTAIRS, 1, 1, -1, -1, false, 1);
 				}
-				if (doneflag && currlevel == 13) {
-					doneflag = DRLG_L4PlaceMiniSet(L4TWARP, 1, 1, -1, -1, true, 6);
+				if (doneflag && ctx.currlevel == 13) {
+					doneflag = DRLG_L4PlaceMiniSet(ctx, L4TWARP, 1, 1, -1, -1, true, 6);
 				}
-				ViewX++;
+				ctx.ViewX++;
 			}
 		} else {
 			if (entry == ENTRY_MAIN) {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, true, 0);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, true, 0);
 				if (doneflag) {
 					if (!gbIsMultiplayer && quests[Q_DIABLO]._qactive != QUEST_ACTIVE) {
-						doneflag = DRLG_L4PlaceMiniSet(L4PENTA, 1, 1, -1, -1, false, 1);
+						doneflag = DRLG_L4PlaceMiniSet(ctx, L4PENTA, 1, 1, -1, -1, false, 1);
 					} else {
-						doneflag = DRLG_L4PlaceMiniSet(L4PENTA2, 1, 1, -1, -1, false, 1);
+						doneflag = DRLG_L4PlaceMiniSet(ctx, L4PENTA2, 1, 1, -1, -1, false, 1);
 					}
 				}
-				ViewX++;
+				ctx.ViewX++;
 			} else {
-				doneflag = DRLG_L4PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false, 0);
+				doneflag = DRLG_L4PlaceMiniSet(ctx, L4USTAIRS, 1, 1, -1, -1, false, 0);
 				if (doneflag) {
 					if (!gbIsMultiplayer && quests[Q_DIABLO]._qactive != QUEST_ACTIVE) {
-						doneflag = DRLG_L4PlaceMiniSet(L4PENTA, 1, 1, -1, -1, true, 1);
+						doneflag = DRLG_L4PlaceMiniSet(ctx, L4PENTA, 1, 1, -1, -1, true, 1);
 					} else {
-						doneflag = DRLG_L4PlaceMiniSet(L4PENTA2, 1, 1, -1, -1, true, 1);
+						doneflag = DRLG_L4PlaceMiniSet(ctx, L4PENTA2, 1, 1, -1, -1, true, 1);
 					}
 				}
-				ViewY++;
+				ctx.ViewY++;
 			}
 		}
 	} while (!doneflag);
 
-	DRLG_L4GeneralFix();
+	DRLG_L4GeneralFix(ctx);
 
-	if (currlevel != 16) {
-		DRLG_PlaceThemeRooms(7, 10, 6, 8, true);
+	if (ctx.currlevel != 16) {
+		DRLG_PlaceThemeRooms(ctx, 7, 10, 6, 8, true);
 	}
 
-	DRLG_L4Shadows();
-	DRLG_L4Corners();
-	DRLG_L4Subs();
-	DRLG_Init_Globals();
+	DRLG_L4Shadows(ctx);
+	DRLG_L4Corners(ctx);
+	DRLG_L4Subs(ctx);
+	DRLG_InitFlags(ctx);
 
-	if (QuestStatus(Q_WARLORD)) {
+	if (QuestStatus(Q_WARLORD, ctx.currlevel)) {
 		for (j = 0; j < DMAXY; j++) {
 			for (i = 0; i < DMAXX; i++) {
-				pdungeon[i][j] = dungeon[i][j];
+				ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 			}
 		}
 	}
 
-	DRLG_CheckQuests(SP4x1, SP4y1);
+	DRLG_CheckQuests(ctx, ctx.SP4x1, ctx.SP4y1);
 
-	if (currlevel == 15) {
+	if (ctx.currlevel == 15) {
 		for (j = 0; j < DMAXY; j++) {
 			for (i = 0; i < DMAXX; i++) {
-				if (dungeon[i][j] == 98) {
-					Make_SetPC(i - 1, j - 1, 5, 5);
+				if (ctx.dungeon[i][j] == 98) {
+					Make_SetPC(ctx, i - 1, j - 1, 5, 5);
 				}
-				if (dungeon[i][j] == 107) {
-					Make_SetPC(i - 1, j - 1, 5, 5);
+				if (ctx.dungeon[i][j] == 107) {
+					Make_SetPC(ctx, i - 1, j - 1, 5, 5);
 				}
 			}
 		}
 	}
-	if (currlevel == 16) {
+	if (ctx.currlevel == 16) {
 		for (j = 0; j < DMAXY; j++) {
 			for (i = 0; i < DMAXX; i++) {
-				pdungeon[i][j] = dungeon[i][j];
+				ctx.pdungeon[i][j] = ctx.dungeon[i][j];
 			}
 		}
-		DRLG_LoadDiabQuads(false);
+		DRLG_LoadDiabQuads(ctx, false);
 	}
 }
 
-static void DRLG_L4Pass3()
+static void DRLG_L4Pass3(DungeonContext &ctx)
 {
-	DRLG_LPass3(30 - 1);
+	DRLG_LPass3(ctx, 30 - 1);
 }
 
-void CreateL4Dungeon(uint32_t rseed, lvl_entry entry)
+void CreateL4Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry)
 {
 	SetRndSeed(rseed);
 
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
-	ViewX = 40;
-	ViewY = 40;
+	ctx.ViewX = 40;
+	ctx.ViewY = 40;
 
-	DRLG_InitSetPC();
-	DRLG_LoadL4SP();
-	DRLG_L4(entry);
-	DRLG_L4Pass3();
-	DRLG_FreeL4SP();
-	DRLG_SetPC();
+	DRLG_InitSetPC(ctx);
+	DRLG_LoadL4SP(ctx);
+	DRLG_L4(ctx, entry);
+	DRLG_L4Pass3(ctx);
+	DRLG_FreeL4SP(ctx);
+	DRLG_SetPC(ctx);
 }
 
-void LoadL4Dungeon(const char *path, int vx, int vy)
+void LoadL4Dungeon(DungeonContext &ctx, const char *path, int vx, int vy)
 {
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
-	DRLG_InitTrans();
-	InitL4Dungeon();
+	DRLG_InitTrans(ctx);
+	InitL4Dungeon(ctx);
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
-	DRLG_L4SetRoom(dunData.get(), 0, 0);
+	DRLG_L4SetRoom(ctx, dunData.get(), 0, 0);
 
-	ViewX = vx;
-	ViewY = vy;
+	ctx.ViewX = vx;
+	ctx.ViewY = vy;
 
-	DRLG_L4Pass3();
+	DRLG_L4Pass3(ctx);
 	DRLG_Init_Globals();
 
 	SetMapMonsters(dunData.get(), { 0, 0 });
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL4Dungeon(const char *path)
+void LoadPreL4Dungeon(DungeonContext &ctx, const char *path)
 {
-	dminx = 16;
-	dminy = 16;
-	dmaxx = 96;
-	dmaxy = 96;
+	ctx.dminx = 16;
+	ctx.dminy = 16;
+	ctx.dmaxx = 96;
+	ctx.dmaxy = 96;
 
-	InitL4Dungeon();
+	InitL4Dungeon(ctx);
 
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
-	DRLG_L4SetRoom(dunData.get(), 0, 0);
+	DRLG_L4SetRoom(ctx, dunData.get(), 0, 0);
 }
 
 } // namespace devilution
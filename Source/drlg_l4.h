@@ -9,16 +9,21 @@
 
 namespace devilution {
 
-extern int diabquad1x;
-extern int diabquad1y;
-extern int diabquad2x;
-extern int diabquad2y;
-extern int diabquad3x;
-extern int diabquad3y;
-extern int diabquad4x;
-extern int diabquad4y;
+extern int &diabquad1x;
+extern int &diabquad1y;
+extern int &diabquad2x;
+extern int &diabquad2y;
+extern int &diabquad3x;
+extern int &diabquad3y;
+extern int &diabquad4x;
+extern int &diabquad4y;
 bool IsDURWall(char d);
 bool IsDLLWall(char dd);
-void CreateL4Dungeon(uint32_t rseed, lvl_entry entry);
+/**
+ * @brief Generate a Hell level into the given context
+ *
+ * Call DRLG_Init_Globals before when building the active level.
+ */
+void CreateL4Dungeon(DungeonContext &ctx, uint32_t rseed, lvl_entry entry);
 
 } // namespace devilution
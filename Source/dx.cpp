@@ -5,13 +5,17 @@
  */
 #include "dx.h"
 
+#include <algorithm>
+
 #include <SDL.h>
 
 #include "engine.h"
+#include "engine/render/output_convert.hpp"
 #include "options.h"
 #include "storm/storm.h"
 #include "utils/display.h"
 #include "utils/log.hpp"
+#include "utils/profiler.h"
 
 #ifdef __3DS__
 #include <3ds.h>
@@ -44,6 +48,16 @@ bool RenderDirectlyToOutputSurface;
 
 namespace {
 
+/** The palette in the pixel format of the output, indexed by palette entry */
+std::uint32_t OutputColors[256];
+unsigned int OutputColorsPaletteVersion = 0;
+
+/** Whether the whole back buffer is converted straight into the texture on the next RenderPresent */
+bool PresentBackBufferToTexture;
+
+/** Whether the last frame was presented from the back buffer, leaving `renderer_texture_surface` out of date */
+bool OutputSurfaceOutdated;
+
 bool CanRenderDirectlyToOutputSurface()
 {
 #ifdef USE_SDL1
@@ -60,6 +74,98 @@ bool CanRenderDirectlyToOutputSurface()
 #endif
 }
 
+const std::uint32_t *GetOutputColors(const SDL_PixelFormat *format)
+{
+	if (OutputColorsPaletteVersion != pal_surface_palette_version) {
+		for (int i = 0; i < 256; i++) {
+			const SDL_Color &color = palette->colors[i];
+			OutputColors[i] = SDL_MapRGB(format, color.r, color.g, color.b);
+		}
+		OutputColorsPaletteVersion = pal_surface_palette_version;
+	}
+	return OutputColors;
+}
+
+/**
+ * @brief Whether the back buffer can be converted to the output with ConvertPalettedToRgb32 instead of an SDL blit
+ */
+bool CanConvertToOutput(const SDL_Surface *src, const SDL_Surface *dst)
+{
+	return src == pal_surface && dst->format->BytesPerPixel == 4 && !OutputRequiresScaling();
+}
+
+bool CoversBackBuffer(const SDL_Rect *rect)
+{
+	return rect == nullptr || (rect->x == 0 && rect->y == 0 && rect->w == pal_surface->w && rect->h == pal_surface->h);
+}
+
+/**
+ * @brief Convert part of the back buffer to the output, clipped like SDL_BlitSurface
+ */
+void ConvertToOutput(const SDL_Surface *src, const SDL_Rect *src_rect, SDL_Surface *dst, const SDL_Rect *dst_rect)
+{
+	int srcX = 0;
+	int srcY = 0;
+	int width = src->w;
+	int height = src->h;
+	if (src_rect != nullptr) {
+		srcX = src_rect->x;
+		srcY = src_rect->y;
+		width = src_rect->w;
+		height = src_rect->h;
+	}
+	int dstX = dst_rect != nullptr ? dst_rect->x : 0;
+	int dstY = dst_rect != nullptr ? dst_rect->y : 0;
+
+	const int skipX = std::max({ 0, -srcX, -dstX });
+	const int skipY = std::max({ 0, -srcY, -dstY });
+	srcX += skipX;
+	dstX += skipX;
+	srcY += skipY;
+	dstY += skipY;
+	width = std::min({ width - skipX, src->w - srcX, dst->w - dstX });
+	height = std::min({ height - skipY, src->h - srcY, dst->h - dstY });
+	if (width <= 0 || height <= 0)
+		return;
+
+	if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0)
+		ErrSdl();
+	ConvertPalettedToRgb32(
+	    static_cast<std::uint32_t *>(dst->pixels) + dstY * (dst->pitch / 4) + dstX, dst->pitch / 4,
+	    static_cast<const std::uint8_t *>(src->pixels) + srcY * src->pitch + srcX, src->pitch,
+	    width, height, GetOutputColors(dst->format));
+	if (SDL_MUSTLOCK(dst))
+		SDL_UnlockSurface(dst);
+}
+
+#ifndef USE_SDL1
+/**
+ * @brief Whether frames covering the whole back buffer can be converted straight into the streaming texture
+ */
+bool CanPresentBackBufferToTexture()
+{
+	return renderer != nullptr
+	    && CanConvertToOutput(pal_surface, renderer_texture_surface)
+	    && renderer_texture_surface->w == pal_surface->w && renderer_texture_surface->h == pal_surface->h;
+}
+
+/**
+ * @brief Convert the back buffer into the streaming texture, skipping `renderer_texture_surface` and SDL_UpdateTexture
+ */
+void PresentBackBufferToStreamingTexture()
+{
+	void *pixels;
+	int pitch;
+	if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) <= -1)
+		ErrSdl();
+	ConvertPalettedToRgb32(
+	    static_cast<std::uint32_t *>(pixels), pitch / 4,
+	    static_cast<const std::uint8_t *>(pal_surface->pixels), pal_surface->pitch,
+	    pal_surface->w, pal_surface->h, GetOutputColors(renderer_texture_surface->format));
+	SDL_UnlockTexture(texture);
+}
+#endif
+
 } // namespace
 
 static void dx_create_back_buffer()
@@ -183,6 +289,8 @@ void dx_cleanup()
 		return;
 	SDL_FreeSurface(pal_surface);
 	pal_surface = nullptr;
+	PresentBackBufferToTexture = false;
+	OutputSurfaceOutdated = false;
 	SDL_FreePalette(palette);
 	SDL_FreeSurface(renderer_texture_surface);
 #ifndef USE_SDL1
@@ -215,6 +323,19 @@ void dx_reinit()
 	force_redraw = 255;
 }
 
+void SyncOutputSurface()
+{
+#ifndef USE_SDL1
+	if (!OutputSurfaceOutdated)
+		return;
+	OutputSurfaceOutdated = false;
+	ConvertPalettedToRgb32(
+	    static_cast<std::uint32_t *>(renderer_texture_surface->pixels), renderer_texture_surface->pitch / 4,
+	    static_cast<const std::uint8_t *>(pal_surface->pixels), pal_surface->pitch,
+	    pal_surface->w, pal_surface->h, GetOutputColors(renderer_texture_surface->format));
+#endif
+}
+
 void InitPalette()
 {
 	palette = SDL_AllocPalette(256);
@@ -227,12 +348,27 @@ void BltFast(SDL_Rect *src_rect, SDL_Rect *dst_rect)
 {
 	if (RenderDirectlyToOutputSurface)
 		return;
+#ifndef USE_SDL1
+	if (CanPresentBackBufferToTexture()) {
+		// The texture is filled from the back buffer in RenderPresent
+		if (PresentBackBufferToTexture)
+			return;
+		if (CoversBackBuffer(src_rect) && CoversBackBuffer(dst_rect)) {
+			PresentBackBufferToTexture = true;
+			return;
+		}
+	}
+#endif
 	Blit(pal_surface, src_rect, dst_rect);
 }
 
 void Blit(SDL_Surface *src, SDL_Rect *src_rect, SDL_Rect *dst_rect)
 {
 	SDL_Surface *dst = GetOutputSurface();
+	if (CanConvertToOutput(src, dst)) {
+		ConvertToOutput(src, src_rect, dst, dst_rect);
+		return;
+	}
 #ifndef USE_SDL1
 	if (SDL_BlitSurface(src, src_rect, dst, dst_rect) < 0)
 		ErrSdl();
@@ -305,7 +441,7 @@ void LimitFrameRate()
 
 void RenderPresent()
 {
-	SDL_Surface *surface = GetOutputSurface();
+	ProfileScope profileScope(ProfileStage::RenderPresent);
 
 	if (!gbActive) {
 		LimitFrameRate();
@@ -314,8 +450,15 @@ void RenderPresent()
 
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
-		if (SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch) <= -1) { //pitch is 2560
-			ErrSdl();
+		if (PresentBackBufferToTexture) {
+			PresentBackBufferToTexture = false;
+			PresentBackBufferToStreamingTexture();
+			OutputSurfaceOutdated = true;
+		} else {
+			SDL_Surface *surface = GetOutputSurface();
+			if (SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch) <= -1) { //pitch is 2560
+				ErrSdl();
+			}
 		}
 
 		// Clear buffer to avoid artifacts in case the window was resized
@@ -341,7 +484,7 @@ void RenderPresent()
 		LimitFrameRate();
 	}
 #else
-	if (SDL_Flip(surface) <= -1) {
+	if (SDL_Flip(GetOutputSurface()) <= -1) {
 		ErrSdl();
 	}
 	if (RenderDirectlyToOutputSurface)
@@ -23,6 +23,10 @@ void InitPalette();
 void BltFast(SDL_Rect *src_rect, SDL_Rect *dst_rect);
 void Blit(SDL_Surface *src, SDL_Rect *src_rect, SDL_Rect *dst_rect);
 void RenderPresent();
+/**
+ * @brief Bring the output surface up to date after frames that were converted straight from the back buffer into the texture
+ */
+void SyncOutputSurface();
 void PaletteGetEntries(DWORD dwNumEntries, SDL_Color *lpEntries);
 
 } // namespace devilution
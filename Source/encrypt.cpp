@@ -3,6 +3,7 @@
  *
  * Implementation of functions for compression and decompressing MPQ data.
  */
+#include <algorithm>
 #include <memory>
 #include <SDL.h>
 
@@ -90,54 +91,63 @@ static void PkwareBufferWrite(char *buf, unsigned int *size, void *param)
 {
 	TDataInfo *pInfo = (TDataInfo *)param;
 
+	if (*size > pInfo->destSize - pInfo->destOffset) {
+		pInfo->overflowed = true;
+		return;
+	}
+
 	memcpy(pInfo->destData + pInfo->destOffset, buf, *size);
 	pInfo->destOffset += *size;
 }
 
-uint32_t PkwareCompress(byte *srcData, uint32_t size)
+/**
+ * @brief Scratch space for implode and explode, allocated the first time a thread needs it and reused afterwards
+ */
+static char *PkwareWorkspace()
 {
-	std::unique_ptr<char[]> ptr { new char[CMP_BUFFER_SIZE] };
-
-	unsigned destSize = 2 * size;
-	if (destSize < 2 * 4096)
-		destSize = 2 * 4096;
-
-	std::unique_ptr<byte[]> destData { new byte[destSize] };
+	thread_local std::unique_ptr<char[]> workspace;
+	if (workspace == nullptr)
+		workspace.reset(new char[std::max(CMP_BUFFER_SIZE, EXP_BUFFER_SIZE)]);
+	return workspace.get();
+}
 
+uint32_t PkwareCompress(const byte *srcData, uint32_t size, byte *destData)
+{
 	TDataInfo param;
 	param.srcData = srcData;
 	param.srcOffset = 0;
-	param.destData = destData.get();
+	param.destData = destData;
 	param.destOffset = 0;
 	param.size = size;
+	// Output that doesn't end up smaller than the input gets replaced by the input anyway
+	param.destSize = size;
+	param.overflowed = false;
 
 	unsigned type = 0;
 	unsigned dsize = 4096;
-	implode(PkwareBufferRead, PkwareBufferWrite, ptr.get(), &param, &type, &dsize);
+	implode(PkwareBufferRead, PkwareBufferWrite, PkwareWorkspace(), &param, &type, &dsize);
 
-	if (param.destOffset < size) {
-		memcpy(srcData, destData.get(), param.destOffset);
-		size = param.destOffset;
-	}
+	if (!param.overflowed && param.destOffset < size)
+		return param.destOffset;
 
+	memcpy(destData, srcData, size);
 	return size;
 }
 
-void PkwareDecompress(byte *inBuff, int recvSize, int maxBytes)
+uint32_t PkwareDecompress(const byte *inBuff, uint32_t recvSize, byte *outBuff, uint32_t maxBytes)
 {
 	TDataInfo info;
-
-	std::unique_ptr<char[]> ptr { new char[CMP_BUFFER_SIZE] };
-	std::unique_ptr<byte[]> outBuff { new byte[maxBytes] };
-
 	info.srcData = inBuff;
 	info.srcOffset = 0;
-	info.destData = outBuff.get();
+	info.destData = outBuff;
 	info.destOffset = 0;
 	info.size = recvSize;
+	info.destSize = maxBytes;
+	info.overflowed = false;
+
+	explode(PkwareBufferRead, PkwareBufferWrite, PkwareWorkspace(), &info);
 
-	explode(PkwareBufferRead, PkwareBufferWrite, ptr.get(), &info);
-	memcpy(inBuff, outBuff.get(), info.destOffset);
+	return info.destOffset;
 }
 
 } // namespace devilution
@@ -12,18 +12,39 @@
 namespace devilution {
 
 struct TDataInfo {
-	byte *srcData;
+	const byte *srcData;
 	uint32_t srcOffset;
 	byte *destData;
 	uint32_t destOffset;
 	uint32_t size;
+	/** Capacity of destData, output beyond it is dropped */
+	uint32_t destSize;
+	/** Set when output was dropped for lack of room */
+	bool overflowed;
 };
 
 void Decrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 void Encrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 uint32_t Hash(const char *s, int type);
 void InitHash();
-uint32_t PkwareCompress(byte *srcData, uint32_t size);
-void PkwareDecompress(byte *inBuff, int recvSize, int maxBytes);
+/**
+ * @brief Compress a buffer straight into the given output, using a workspace owned by the calling thread
+ *
+ * Stores the data uncompressed if compressing doesn't make it smaller, so the result is never larger than the input.
+ * @param srcData Data to compress
+ * @param size Size of the data
+ * @param destData Receives the output, must have room for size bytes
+ * @return Number of bytes written to destData, size if the data was stored uncompressed
+ */
+uint32_t PkwareCompress(const byte *srcData, uint32_t size, byte *destData);
+/**
+ * @brief Decompress a buffer straight into the given output, using a workspace owned by the calling thread
+ * @param inBuff Compressed data
+ * @param recvSize Size of the compressed data
+ * @param outBuff Receives the decompressed data
+ * @param maxBytes Capacity of outBuff, anything beyond it is dropped
+ * @return Number of bytes written to outBuff
+ */
+uint32_t PkwareDecompress(const byte *inBuff, uint32_t recvSize, byte *outBuff, uint32_t maxBytes);
 
 } // namespace devilution
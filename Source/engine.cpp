@@ -20,8 +20,8 @@
 
 namespace devilution {
 
-/** Current game seed */
-int32_t sglGameSeed;
+/** Current game seed, each thread has its own so levels can be generated off the main thread */
+thread_local int32_t sglGameSeed;
 
 /**
  * Specifies the increment used in the Borland C/C++ pseudo-random.
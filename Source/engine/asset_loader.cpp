@@ -0,0 +1,275 @@
+/**
+ * @file asset_loader.cpp
+ *
+ * Implementation of the background loader that reads game files ahead of time.
+ */
+#include "engine/asset_loader.hpp"
+
+#include <cstring>
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "appfat.h"
+#include "interfac.h"
+#include "storm/storm.h"
+#include "utils/stdcompat/algorithm.hpp"
+#include "utils/thread.h"
+
+namespace devilution {
+
+namespace {
+
+/** Upper limit on the number of loader threads, reading is mostly bound by the archives */
+constexpr int MaxAssetLoaderThreads = 4;
+
+enum class PrefetchState {
+	Queued,
+	Loading,
+	Loaded,
+	Failed,
+};
+
+struct PrefetchedFile {
+	std::string path;
+	PrefetchState state;
+	std::unique_ptr<byte[]> data;
+	size_t size;
+};
+
+SDL_mutex *sgpLoaderMutex;
+/** Signaled when a file has been queued or the loader is shutting down */
+SDL_cond *sgpWorkQueued;
+/** Signaled when a file has finished loading */
+SDL_cond *sgpFileLoaded;
+std::vector<SDL_Thread *> sgLoaderThreads;
+bool sgbLoaderRunning;
+
+/** Every prefetched file that hasn't been used yet, the list keeps entries in place while loader threads fill them */
+std::list<PrefetchedFile> sgPrefetchedFiles;
+std::deque<PrefetchedFile *> sgLoadQueue;
+/** Number of files queued since the loader was last idle, used for reporting progress */
+int sgnQueuedFiles;
+int sgnFinishedFiles;
+
+std::unique_ptr<byte[]> ReadFile(const char *path, size_t *fileLen)
+{
+	HANDLE file;
+	if (!SFileOpenFile(path, &file))
+		return nullptr;
+
+	*fileLen = SFileGetFileSize(file);
+	std::unique_ptr<byte[]> data;
+	if (*fileLen != 0) {
+		data.reset(new byte[*fileLen]);
+		if (!SFileReadFileThreadSafe(file, data.get(), *fileLen))
+			data = nullptr;
+	}
+	SFileCloseFileThreadSafe(file);
+
+	return data;
+}
+
+unsigned int AssetLoaderThread(void * /*data*/)
+{
+	SDL_LockMutex(sgpLoaderMutex);
+	while (sgbLoaderRunning) {
+		if (sgLoadQueue.empty()) {
+			SDL_CondWait(sgpWorkQueued, sgpLoaderMutex);
+			continue;
+		}
+
+		PrefetchedFile &file = *sgLoadQueue.front();
+		sgLoadQueue.pop_front();
+		file.state = PrefetchState::Loading;
+		SDL_UnlockMutex(sgpLoaderMutex);
+
+		size_t fileLen = 0;
+		std::unique_ptr<byte[]> data = ReadFile(file.path.c_str(), &fileLen);
+
+		SDL_LockMutex(sgpLoaderMutex);
+		file.state = data != nullptr ? PrefetchState::Loaded : PrefetchState::Failed;
+		file.data = std::move(data);
+		file.size = fileLen;
+		sgnFinishedFiles++;
+		SDL_CondBroadcast(sgpFileLoaded);
+	}
+	SDL_UnlockMutex(sgpLoaderMutex);
+
+	return 0;
+}
+
+void StartAssetLoader()
+{
+	sgpLoaderMutex = SDL_CreateMutex();
+	sgpWorkQueued = SDL_CreateCond();
+	sgpFileLoaded = SDL_CreateCond();
+	if (sgpLoaderMutex == nullptr || sgpWorkQueued == nullptr || sgpFileLoaded == nullptr)
+		ErrSdl();
+
+	int threads = 1;
+#ifndef USE_SDL1
+	threads = clamp(SDL_GetCPUCount() - 1, 1, MaxAssetLoaderThreads);
+#endif
+
+	sgbLoaderRunning = true;
+	for (int i = 0; i < threads; i++) {
+		SDL_threadID threadId;
+		sgLoaderThreads.push_back(CreateThread(AssetLoaderThread, &threadId));
+	}
+}
+
+std::list<PrefetchedFile>::iterator FindPrefetchedFile(const char *path)
+{
+	return std::find_if(sgPrefetchedFiles.begin(), sgPrefetchedFiles.end(), [path](const PrefetchedFile &file) {
+		return file.path == path;
+	});
+}
+
+/**
+ * @brief Drop a file that hasn't been picked up by a loader thread yet so it can be read directly instead
+ */
+void UnqueueFile(std::list<PrefetchedFile>::iterator file)
+{
+	sgLoadQueue.erase(std::find(sgLoadQueue.begin(), sgLoadQueue.end(), &*file));
+	sgPrefetchedFiles.erase(file);
+	sgnQueuedFiles--;
+}
+
+} // namespace
+
+void PrefetchFile(const char *path)
+{
+	if (sgpLoaderMutex == nullptr)
+		StartAssetLoader();
+
+	SDL_LockMutex(sgpLoaderMutex);
+	if (FindPrefetchedFile(path) == sgPrefetchedFiles.end()) {
+		if (sgLoadQueue.empty() && sgnFinishedFiles == sgnQueuedFiles) {
+			sgnQueuedFiles = 0;
+			sgnFinishedFiles = 0;
+		}
+		sgPrefetchedFiles.push_back({ path, PrefetchState::Queued, nullptr, 0 });
+		sgLoadQueue.push_back(&sgPrefetchedFiles.back());
+		sgnQueuedFiles++;
+		SDL_CondSignal(sgpWorkQueued);
+	}
+	SDL_UnlockMutex(sgpLoaderMutex);
+}
+
+void WaitForPrefetchedFiles(int progressSteps)
+{
+	int step = 0;
+	if (sgpLoaderMutex != nullptr) {
+		SDL_LockMutex(sgpLoaderMutex);
+		while (sgnFinishedFiles < sgnQueuedFiles) {
+			SDL_CondWait(sgpFileLoaded, sgpLoaderMutex);
+			int progress = progressSteps * sgnFinishedFiles / sgnQueuedFiles;
+			SDL_UnlockMutex(sgpLoaderMutex);
+			for (; step < progress; step++)
+				IncProgress();
+			SDL_LockMutex(sgpLoaderMutex);
+		}
+		SDL_UnlockMutex(sgpLoaderMutex);
+	}
+
+	for (; step < progressSteps; step++)
+		IncProgress();
+}
+
+void ClearPrefetchedFiles()
+{
+	if (sgpLoaderMutex == nullptr)
+		return;
+
+	SDL_LockMutex(sgpLoaderMutex);
+	sgnQueuedFiles -= sgLoadQueue.size();
+	sgLoadQueue.clear();
+	while (sgnFinishedFiles < sgnQueuedFiles)
+		SDL_CondWait(sgpFileLoaded, sgpLoaderMutex);
+	sgPrefetchedFiles.clear();
+	sgnQueuedFiles = 0;
+	sgnFinishedFiles = 0;
+	SDL_UnlockMutex(sgpLoaderMutex);
+}
+
+void FreeAssetLoader()
+{
+	if (sgpLoaderMutex == nullptr)
+		return;
+
+	ClearPrefetchedFiles();
+
+	SDL_LockMutex(sgpLoaderMutex);
+	sgbLoaderRunning = false;
+	SDL_CondBroadcast(sgpWorkQueued);
+	SDL_UnlockMutex(sgpLoaderMutex);
+
+	for (SDL_Thread *thread : sgLoaderThreads)
+		SDL_WaitThread(thread, nullptr);
+	sgLoaderThreads.clear();
+
+	SDL_DestroyCond(sgpFileLoaded);
+	SDL_DestroyCond(sgpWorkQueued);
+	SDL_DestroyMutex(sgpLoaderMutex);
+	sgpFileLoaded = nullptr;
+	sgpWorkQueued = nullptr;
+	sgpLoaderMutex = nullptr;
+}
+
+bool GetPrefetchedFileSize(const char *path, size_t *fileLen)
+{
+	if (sgpLoaderMutex == nullptr)
+		return false;
+
+	SDL_LockMutex(sgpLoaderMutex);
+	auto file = FindPrefetchedFile(path);
+	if (file != sgPrefetchedFiles.end() && file->state == PrefetchState::Queued) {
+		// Reading it here is quicker than waiting for the files ahead of it in the queue
+		UnqueueFile(file);
+		file = sgPrefetchedFiles.end();
+	}
+	while (file != sgPrefetchedFiles.end() && file->state == PrefetchState::Loading)
+		SDL_CondWait(sgpFileLoaded, sgpLoaderMutex);
+
+	bool loaded = false;
+	if (file != sgPrefetchedFiles.end()) {
+		if (file->state == PrefetchState::Loaded) {
+			*fileLen = file->size;
+			loaded = true;
+		} else {
+			// Let the caller report the error the usual way
+			sgPrefetchedFiles.erase(file);
+		}
+	}
+	SDL_UnlockMutex(sgpLoaderMutex);
+
+	return loaded;
+}
+
+bool TakePrefetchedFile(const char *path, byte *buffer, size_t fileLen)
+{
+	if (sgpLoaderMutex == nullptr)
+		return false;
+
+	SDL_LockMutex(sgpLoaderMutex);
+	auto file = FindPrefetchedFile(path);
+	bool loaded = file != sgPrefetchedFiles.end() && file->state == PrefetchState::Loaded && file->size == fileLen;
+	std::unique_ptr<byte[]> data;
+	if (loaded) {
+		data = std::move(file->data);
+		sgPrefetchedFiles.erase(file);
+	}
+	SDL_UnlockMutex(sgpLoaderMutex);
+
+	if (loaded)
+		memcpy(buffer, data.get(), fileLen);
+
+	return loaded;
+}
+
+} // namespace devilution
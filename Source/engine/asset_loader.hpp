@@ -0,0 +1,49 @@
+/**
+ * @file asset_loader.hpp
+ *
+ * Interface of the background loader that reads game files ahead of time.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "utils/stdcompat/cstddef.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Queue a file to be read and decompressed on the asset loader threads
+ *
+ * The next LoadFileInMem call for the same path picks up the loaded file instead of reading it again.
+ */
+void PrefetchFile(const char *path);
+
+/**
+ * @brief Wait for all queued files to finish loading, advancing the progress bar as they complete
+ * @param progressSteps Number of times IncProgress is called, regardless of how many files are loaded
+ */
+void WaitForPrefetchedFiles(int progressSteps);
+
+/**
+ * @brief Drop queued files and release loaded files that were never used
+ */
+void ClearPrefetchedFiles();
+
+/**
+ * @brief Stop the asset loader threads and release all prefetched files
+ */
+void FreeAssetLoader();
+
+/**
+ * @brief Get the size of a prefetched file, waiting for it if it is still being loaded
+ * @return false if the file was not prefetched or could not be loaded
+ */
+bool GetPrefetchedFileSize(const char *path, size_t *fileLen);
+
+/**
+ * @brief Move the content of a prefetched file into the given buffer
+ * @return false if the file was not prefetched with the given size
+ */
+bool TakePrefetchedFile(const char *path, byte *buffer, size_t fileLen);
+
+} // namespace devilution
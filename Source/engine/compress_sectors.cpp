@@ -0,0 +1,192 @@
+/**
+ * @file compress_sectors.cpp
+ *
+ * Implementation of the worker threads that compress the sectors of archive files in parallel.
+ */
+#include "engine/compress_sectors.hpp"
+
+#include <cstring>
+
+#include <SDL.h>
+
+#include "appfat.h"
+#include "encrypt.h"
+#include "utils/stdcompat/algorithm.hpp"
+#include "utils/thread.h"
+
+namespace devilution {
+
+namespace {
+
+/** Upper limit on the number of compression threads, saving is bound by disk writes beyond this */
+constexpr int MaxCompressThreads = 4;
+
+struct SectorJob {
+	const byte *data;
+	size_t size;
+	int sectors;
+	/** Output of sector n starts at slots + n * ArchiveSectorSize */
+	byte *slots;
+	uint32_t *compressedSizes;
+	/** Next sector to be picked up by a thread */
+	int nextSector;
+	int finishedSectors;
+};
+
+SDL_mutex *sgpCompressMutex;
+/** Signaled when sectors are ready to be compressed or the workers are shutting down */
+SDL_cond *sgpSectorsQueued;
+/** Signaled when the last sector of a job is compressed */
+SDL_cond *sgpSectorsCompressed;
+std::vector<SDL_Thread *> sgCompressThreads;
+bool sgbCompressThreadsRunning;
+int sgnCompressThreads = 1;
+SectorJob sgJob;
+/** Sector output slots, kept between calls so saving doesn't allocate per file */
+std::vector<byte> sgSectorSlots;
+std::vector<uint32_t> sgCompressedSizes;
+
+void CompressSector(const SectorJob &job, int sector)
+{
+	const size_t offset = static_cast<size_t>(sector) * ArchiveSectorSize;
+	const uint32_t len = static_cast<uint32_t>(std::min<size_t>(job.size - offset, ArchiveSectorSize));
+	job.compressedSizes[sector] = PkwareCompress(&job.data[offset], len, &job.slots[offset]);
+}
+
+/**
+ * @brief Compress sectors of the current job until none are left, the mutex must be locked
+ */
+void CompressQueuedSectors()
+{
+	while (sgJob.nextSector < sgJob.sectors) {
+		const int sector = sgJob.nextSector++;
+		SDL_UnlockMutex(sgpCompressMutex);
+
+		CompressSector(sgJob, sector);
+
+		SDL_LockMutex(sgpCompressMutex);
+		sgJob.finishedSectors++;
+		if (sgJob.finishedSectors == sgJob.sectors)
+			SDL_CondSignal(sgpSectorsCompressed);
+	}
+}
+
+unsigned int CompressThread(void * /*data*/)
+{
+	SDL_LockMutex(sgpCompressMutex);
+	while (sgbCompressThreadsRunning) {
+		if (sgJob.nextSector >= sgJob.sectors) {
+			SDL_CondWait(sgpSectorsQueued, sgpCompressMutex);
+			continue;
+		}
+		CompressQueuedSectors();
+	}
+	SDL_UnlockMutex(sgpCompressMutex);
+
+	return 0;
+}
+
+void StartCompressThreads()
+{
+	sgpCompressMutex = SDL_CreateMutex();
+	sgpSectorsQueued = SDL_CreateCond();
+	sgpSectorsCompressed = SDL_CreateCond();
+	if (sgpCompressMutex == nullptr || sgpSectorsQueued == nullptr || sgpSectorsCompressed == nullptr)
+		ErrSdl();
+
+	sgJob = {};
+	sgbCompressThreadsRunning = true;
+	// The calling thread compresses sectors as well
+	for (int i = 1; i < sgnCompressThreads; i++) {
+		SDL_threadID threadId;
+		sgCompressThreads.push_back(CreateThread(CompressThread, &threadId));
+	}
+}
+
+} // namespace
+
+void SetCompressThreadCount(int threads)
+{
+	FreeCompressThreads();
+
+	if (threads <= 0) {
+		threads = 1;
+#ifndef USE_SDL1
+		threads = SDL_GetCPUCount();
+#endif
+	}
+	sgnCompressThreads = clamp(threads, 1, MaxCompressThreads);
+}
+
+int GetCompressThreadCount()
+{
+	return sgnCompressThreads;
+}
+
+void CompressSectors(const byte *data, size_t size, std::vector<byte> &out)
+{
+	const int sectors = static_cast<int>((size + (ArchiveSectorSize - 1)) / ArchiveSectorSize);
+	const uint32_t offsetTableSize = sizeof(uint32_t) * (sectors + 1);
+
+	if (sgSectorSlots.size() < sectors * ArchiveSectorSize)
+		sgSectorSlots.resize(sectors * ArchiveSectorSize);
+	if (sgCompressedSizes.size() < static_cast<size_t>(sectors))
+		sgCompressedSizes.resize(sectors);
+
+	SectorJob job = { data, size, sectors, sgSectorSlots.data(), sgCompressedSizes.data(), 0, 0 };
+	if (sgnCompressThreads == 1 || sectors == 1) {
+		for (int sector = 0; sector < sectors; sector++)
+			CompressSector(job, sector);
+	} else {
+		if (sgpCompressMutex == nullptr)
+			StartCompressThreads();
+
+		SDL_LockMutex(sgpCompressMutex);
+		sgJob = job;
+		SDL_CondBroadcast(sgpSectorsQueued);
+		CompressQueuedSectors();
+		while (sgJob.finishedSectors < sgJob.sectors)
+			SDL_CondWait(sgpSectorsCompressed, sgpCompressMutex);
+		sgJob = {};
+		SDL_UnlockMutex(sgpCompressMutex);
+	}
+
+	size_t totalSize = offsetTableSize;
+	for (int sector = 0; sector < sectors; sector++)
+		totalSize += sgCompressedSizes[sector];
+	out.resize(totalSize);
+
+	uint32_t offset = offsetTableSize;
+	for (int sector = 0; sector < sectors; sector++) {
+		const uint32_t offsetLE = SDL_SwapLE32(offset);
+		memcpy(&out[sector * sizeof(uint32_t)], &offsetLE, sizeof(offsetLE));
+		memcpy(&out[offset], &sgSectorSlots[sector * ArchiveSectorSize], sgCompressedSizes[sector]);
+		offset += sgCompressedSizes[sector];
+	}
+	const uint32_t endLE = SDL_SwapLE32(offset);
+	memcpy(&out[sectors * sizeof(uint32_t)], &endLE, sizeof(endLE));
+}
+
+void FreeCompressThreads()
+{
+	if (sgpCompressMutex == nullptr)
+		return;
+
+	SDL_LockMutex(sgpCompressMutex);
+	sgbCompressThreadsRunning = false;
+	SDL_CondBroadcast(sgpSectorsQueued);
+	SDL_UnlockMutex(sgpCompressMutex);
+
+	for (SDL_Thread *thread : sgCompressThreads)
+		SDL_WaitThread(thread, nullptr);
+	sgCompressThreads.clear();
+
+	SDL_DestroyCond(sgpSectorsCompressed);
+	SDL_DestroyCond(sgpSectorsQueued);
+	SDL_DestroyMutex(sgpCompressMutex);
+	sgpSectorsCompressed = nullptr;
+	sgpSectorsQueued = nullptr;
+	sgpCompressMutex = nullptr;
+}
+
+} // namespace devilution
@@ -0,0 +1,44 @@
+/**
+ * @file compress_sectors.hpp
+ *
+ * Interface of the worker threads that compress the sectors of archive files in parallel.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "utils/stdcompat/cstddef.hpp"
+
+namespace devilution {
+
+/** Size of the uncompressed sectors files are split into */
+constexpr uint32_t ArchiveSectorSize = 4096;
+
+/**
+ * @brief Set the number of threads that compress sectors, including the calling thread
+ * @param threads 1 compresses everything on the calling thread, 0 uses one thread per CPU core
+ */
+void SetCompressThreadCount(int threads);
+
+int GetCompressThreadCount();
+
+/**
+ * @brief Compress a file sector by sector into its on-disk form
+ *
+ * The output starts with the little-endian table of sector offsets, relative to the start of the output,
+ * with a final entry marking the end of the last sector. The compressed sectors follow, in order.
+ * Sectors that don't get smaller are stored as is.
+ * @param data File contents
+ * @param size Size of the file in bytes
+ * @param out Receives the offset table and the sectors, its capacity is reused between calls
+ */
+void CompressSectors(const byte *data, size_t size, std::vector<byte> &out);
+
+/**
+ * @brief Stop the compression worker threads
+ */
+void FreeCompressThreads();
+
+} // namespace devilution
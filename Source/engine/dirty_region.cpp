@@ -0,0 +1,53 @@
+/**
+ * @file dirty_region.cpp
+ *
+ * Implementation of the set of screen rectangles that need to be uploaded.
+ */
+#include "engine/dirty_region.hpp"
+
+#include <algorithm>
+
+namespace devilution {
+
+namespace {
+
+int Area(const Rectangle &rect)
+{
+	return rect.size.width * rect.size.height;
+}
+
+Rectangle BoundingBox(const Rectangle &a, const Rectangle &b)
+{
+	const int left = std::min(a.position.x, b.position.x);
+	const int top = std::min(a.position.y, b.position.y);
+	const int right = std::max(a.position.x + a.size.width, b.position.x + b.size.width);
+	const int bottom = std::max(a.position.y + a.size.height, b.position.y + b.size.height);
+	return { { left, top }, { right - left, bottom - top } };
+}
+
+} // namespace
+
+void DirtyRegion::Add(Rectangle rect)
+{
+	if (rect.size.width <= 0 || rect.size.height <= 0)
+		return;
+
+	// Absorb rectangles into the new one until nothing is left to merge, the box grows with every merge
+	bool merged;
+	do {
+		merged = false;
+		for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+			const Rectangle box = BoundingBox(*it, rect);
+			if (!it->Overlaps(rect) && Area(box) > Area(*it) + Area(rect))
+				continue;
+			rect = box;
+			rects_.erase(it);
+			merged = true;
+			break;
+		}
+	} while (merged);
+
+	rects_.push_back(rect);
+}
+
+} // namespace devilution
@@ -0,0 +1,49 @@
+/**
+ * @file dirty_region.hpp
+ *
+ * Interface of the set of screen rectangles that need to be uploaded.
+ */
+#pragma once
+
+#include <vector>
+
+#include "engine/rectangle.hpp"
+
+namespace devilution {
+
+/**
+ * @brief The parts of the screen that changed since the last upload
+ *
+ * Rectangles are merged when uploading their bounding box costs no more pixels than uploading both,
+ * so overlapping rectangles such as the old and new cursor position are uploaded once.
+ */
+class DirtyRegion {
+public:
+	/**
+	 * @brief Mark a rectangle as changed, rectangles without an area are ignored
+	 */
+	void Add(Rectangle rect);
+
+	void Clear()
+	{
+		rects_.clear();
+	}
+
+	bool IsEmpty() const
+	{
+		return rects_.empty();
+	}
+
+	/**
+	 * @brief The rectangles to upload, none of them overlap
+	 */
+	const std::vector<Rectangle> &Rects() const
+	{
+		return rects_;
+	}
+
+private:
+	std::vector<Rectangle> rects_;
+};
+
+} // namespace devilution
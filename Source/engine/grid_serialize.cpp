@@ -0,0 +1,210 @@
+/**
+ * @file grid_serialize.cpp
+ *
+ * Implementation of the bulk conversion of level grids to and from the layout of the save files.
+ *
+ * The grids are indexed [x][y] while the files store them one y at a time, so every conversion is a transpose.
+ * The grid is handled in square tiles, with SSE2 transposing whole tiles in registers where available.
+ */
+#include "engine/grid_serialize.hpp"
+
+#include <SDL.h>
+
+#include "utils/attributes.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GRID_SERIALIZE_X86
+#include <immintrin.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+/** Side of the tiles of bytes, one SSE2 register per tile line */
+constexpr int ByteTile = 16;
+/** Side of the tiles of 16-bit values, one SSE2 register per tile line */
+constexpr int WordTile = 8;
+
+void TransposeBytesScalar(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch, int rows, int cols)
+{
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++)
+			dst[c * dstPitch + r] = src[r * srcPitch + c];
+	}
+}
+
+void SaveBE32Scalar(std::uint8_t *dst, int dstPitch, const std::int16_t *src, int srcPitch, int rows, int cols)
+{
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			const std::uint32_t value = static_cast<std::uint32_t>(static_cast<std::int32_t>(src[r * srcPitch + c]));
+			std::uint8_t *out = &dst[(c * dstPitch + r) * 4];
+			out[0] = value >> 24;
+			out[1] = value >> 16;
+			out[2] = value >> 8;
+			out[3] = value;
+		}
+	}
+}
+
+void LoadBE32Scalar(std::int16_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch, int rows, int cols)
+{
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			const std::uint8_t *in = &src[(r * srcPitch + c) * 4];
+			dst[c * dstPitch + r] = static_cast<std::int16_t>((in[2] << 8) | in[3]);
+		}
+	}
+}
+
+#ifdef GRID_SERIALIZE_X86
+
+const bool HasSSE2 = SDL_HasSSE2() != SDL_FALSE;
+
+// Interleaving line k with line k + n/2 for every k rotates the bits of the element index (line, column) by one.
+// Doing it log2(n) times swaps the line and column bits, which transposes the tile.
+
+DVL_ATTRIBUTE_TARGET("sse2")
+void TransposeByteTileSSE2(std::uint8_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch)
+{
+	__m128i lines[ByteTile];
+	__m128i shuffled[ByteTile];
+	for (int k = 0; k < ByteTile; k++)
+		lines[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[k * srcPitch]));
+	for (int pass = 0; pass < 4; pass++) {
+		for (int k = 0; k < ByteTile / 2; k++) {
+			shuffled[2 * k] = _mm_unpacklo_epi8(lines[k], lines[k + ByteTile / 2]);
+			shuffled[2 * k + 1] = _mm_unpackhi_epi8(lines[k], lines[k + ByteTile / 2]);
+		}
+		for (int k = 0; k < ByteTile; k++)
+			lines[k] = shuffled[k];
+	}
+	for (int k = 0; k < ByteTile; k++)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[k * dstPitch]), lines[k]);
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+void TransposeWordTileSSE2(__m128i *lines)
+{
+	__m128i shuffled[WordTile];
+	for (int pass = 0; pass < 3; pass++) {
+		for (int k = 0; k < WordTile / 2; k++) {
+			shuffled[2 * k] = _mm_unpacklo_epi16(lines[k], lines[k + WordTile / 2]);
+			shuffled[2 * k + 1] = _mm_unpackhi_epi16(lines[k], lines[k + WordTile / 2]);
+		}
+		for (int k = 0; k < WordTile; k++)
+			lines[k] = shuffled[k];
+	}
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+__m128i ByteSwap16SSE2(__m128i words)
+{
+	return _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+void SaveBE32TileSSE2(std::uint8_t *dst, int dstPitch, const std::int16_t *src, int srcPitch)
+{
+	__m128i lines[WordTile];
+	for (int k = 0; k < WordTile; k++)
+		lines[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[k * srcPitch]));
+	TransposeWordTileSSE2(lines);
+	for (int k = 0; k < WordTile; k++) {
+		// Each 32-bit value is stored as two sign bytes followed by the value's high and low byte
+		const __m128i sign = _mm_srai_epi16(lines[k], 15);
+		const __m128i swapped = ByteSwap16SSE2(lines[k]);
+		std::uint8_t *out = &dst[k * dstPitch * 4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(sign, swapped));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_unpackhi_epi16(sign, swapped));
+	}
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+void LoadBE32TileSSE2(std::int16_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch)
+{
+	__m128i lines[WordTile];
+	for (int k = 0; k < WordTile; k++) {
+		const std::uint8_t *in = &src[k * srcPitch * 4];
+		const __m128i low = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), 16);
+		const __m128i high = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16)), 16);
+		lines[k] = ByteSwap16SSE2(_mm_packs_epi32(low, high));
+	}
+	TransposeWordTileSSE2(lines);
+	for (int k = 0; k < WordTile; k++)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[k * dstPitch]), lines[k]);
+}
+
+#endif // GRID_SERIALIZE_X86
+
+/**
+ * @brief Transpose a rows x cols matrix of bytes into a cols x rows one
+ */
+void TransposeBytes(std::uint8_t *dst, const std::uint8_t *src, int rows, int cols)
+{
+	int fullRows = 0;
+	int fullCols = 0;
+#ifdef GRID_SERIALIZE_X86
+	if (HasSSE2) {
+		fullRows = rows - rows % ByteTile;
+		fullCols = cols - cols % ByteTile;
+		for (int r = 0; r < fullRows; r += ByteTile) {
+			for (int c = 0; c < fullCols; c += ByteTile)
+				TransposeByteTileSSE2(&dst[c * rows + r], rows, &src[r * cols + c], cols);
+		}
+	}
+#endif
+	TransposeBytesScalar(&dst[fullCols * rows], rows, &src[fullCols], cols, fullRows, cols - fullCols);
+	TransposeBytesScalar(&dst[fullRows], rows, &src[fullRows * cols], cols, rows - fullRows, cols);
+}
+
+} // namespace
+
+void SaveGridBytes(std::uint8_t *dst, const std::uint8_t *grid, int width, int height)
+{
+	TransposeBytes(dst, grid, width, height);
+}
+
+void LoadGridBytes(std::uint8_t *grid, const std::uint8_t *src, int width, int height)
+{
+	TransposeBytes(grid, src, height, width);
+}
+
+void SaveGridBE32(std::uint8_t *dst, const std::int16_t *grid, int width, int height)
+{
+	int fullColumns = 0;
+	int fullRows = 0;
+#ifdef GRID_SERIALIZE_X86
+	if (HasSSE2) {
+		fullColumns = width - width % WordTile;
+		fullRows = height - height % WordTile;
+		for (int x = 0; x < fullColumns; x += WordTile) {
+			for (int y = 0; y < fullRows; y += WordTile)
+				SaveBE32TileSSE2(&dst[(y * width + x) * 4], width, &grid[x * height + y], height);
+		}
+	}
+#endif
+	SaveBE32Scalar(&dst[fullRows * width * 4], width, &grid[fullRows], height, fullColumns, height - fullRows);
+	SaveBE32Scalar(&dst[fullColumns * 4], width, &grid[fullColumns * height], height, width - fullColumns, height);
+}
+
+void LoadGridBE32(std::int16_t *grid, const std::uint8_t *src, int width, int height)
+{
+	int fullColumns = 0;
+	int fullRows = 0;
+#ifdef GRID_SERIALIZE_X86
+	if (HasSSE2) {
+		fullColumns = width - width % WordTile;
+		fullRows = height - height % WordTile;
+		for (int y = 0; y < fullRows; y += WordTile) {
+			for (int x = 0; x < fullColumns; x += WordTile)
+				LoadBE32TileSSE2(&grid[x * height + y], height, &src[(y * width + x) * 4], width);
+		}
+	}
+#endif
+	LoadBE32Scalar(&grid[fullColumns * height], height, &src[fullColumns * 4], width, fullRows, width - fullColumns);
+	LoadBE32Scalar(&grid[fullRows], height, &src[fullRows * width * 4], width, height - fullRows, width);
+}
+
+} // namespace devilution
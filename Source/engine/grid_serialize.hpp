@@ -0,0 +1,40 @@
+/**
+ * @file grid_serialize.hpp
+ *
+ * Interface of the bulk conversion of level grids to and from the layout of the save files.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Write a grid of bytes the way the save files store it, one y at a time with x increasing
+ * @param dst Receives width * height bytes
+ * @param grid Grid indexed [x][y]
+ */
+void SaveGridBytes(std::uint8_t *dst, const std::uint8_t *grid, int width, int height);
+
+/**
+ * @brief Read a grid of bytes stored by SaveGridBytes
+ * @param grid Grid indexed [x][y]
+ * @param src width * height bytes
+ */
+void LoadGridBytes(std::uint8_t *grid, const std::uint8_t *src, int width, int height);
+
+/**
+ * @brief Write a grid of 16-bit values as sign-extended big-endian 32-bit values, in the order of SaveGridBytes
+ * @param dst Receives width * height * 4 bytes
+ * @param grid Grid indexed [x][y]
+ */
+void SaveGridBE32(std::uint8_t *dst, const std::int16_t *grid, int width, int height);
+
+/**
+ * @brief Read a grid stored by SaveGridBE32, keeping the low 16 bits of every value
+ * @param grid Grid indexed [x][y]
+ * @param src width * height * 4 bytes
+ */
+void LoadGridBE32(std::int16_t *grid, const std::uint8_t *src, int width, int height);
+
+} // namespace devilution
@@ -1,26 +1,48 @@
 #include "load_file.hpp"
 
+#include <atomic>
+
 #include "diablo.h"
+#include "engine/asset_loader.hpp"
 #include "storm/storm.h"
 
 namespace devilution {
 
+namespace {
+
+std::atomic<uint32_t> LoadedFileCount;
+
+} // namespace
+
 size_t GetFileSize(const char *pszName)
 {
+	size_t fileLen;
+	if (GetPrefetchedFileSize(pszName, &fileLen))
+		return fileLen;
+
 	HANDLE file;
 	if (!SFileOpenFile(pszName, &file)) {
 		if (!gbQuietMode)
 			app_fatal("GetFileSize - SFileOpenFile failed for file:\n%s", pszName);
 		return 0;
 	}
-	const size_t fileLen = SFileGetFileSize(file);
+	fileLen = SFileGetFileSize(file);
 	SFileCloseFileThreadSafe(file);
 
 	return fileLen;
 }
 
+uint32_t GetLoadedFileCount()
+{
+	return LoadedFileCount.load(std::memory_order_relaxed);
+}
+
 void LoadFileData(const char *pszName, byte *buffer, size_t fileLen)
 {
+	LoadedFileCount.fetch_add(1, std::memory_order_relaxed);
+	if (fileLen != 0 && TakePrefetchedFile(pszName, buffer, fileLen))
+		return;
+
 	HANDLE file;
 	if (!SFileOpenFile(pszName, &file)) {
 		if (!gbQuietMode)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <memory>
 
 #include "appfat.h"
@@ -10,6 +11,13 @@ namespace devilution {
 
 size_t GetFileSize(const char *pszName);
 
+/**
+ * @brief Number of files read so far
+ *
+ * Caches of values derived from loaded data compare it to notice that a new file may have taken the place of a freed one.
+ */
+uint32_t GetLoadedFileCount();
+
 void LoadFileData(const char *pszName, byte *buffer, size_t fileLen);
 
 template <typename T>
@@ -0,0 +1,81 @@
+/**
+ * @file occlusion_map.cpp
+ *
+ * Implementation of the map of screen areas that get painted over by opaque level tiles.
+ */
+#include "engine/occlusion_map.hpp"
+
+#include <algorithm>
+
+namespace devilution {
+
+namespace {
+
+int FloorDiv(int value, int divisor)
+{
+	return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+} // namespace
+
+void OcclusionMap::Reset(Size size, Point origin)
+{
+	size_ = size;
+	const int offsetX = origin.x - FloorDiv(origin.x, CellWidth) * CellWidth;
+	const int offsetY = origin.y - FloorDiv(origin.y, CellHeight) * CellHeight;
+	origin_.x = offsetX == 0 ? 0 : offsetX - CellWidth;
+	origin_.y = offsetY == 0 ? 0 : offsetY - CellHeight;
+	columns_ = std::max(0, Column(size.width - 1) + 1);
+	rows_ = std::max(0, Row(size.height - 1) + 1);
+	coveredBy_.assign(static_cast<size_t>(columns_) * rows_, 0);
+}
+
+int OcclusionMap::Column(int x) const
+{
+	return FloorDiv(x - origin_.x, CellWidth);
+}
+
+int OcclusionMap::Row(int y) const
+{
+	return FloorDiv(y - origin_.y, CellHeight);
+}
+
+void OcclusionMap::AddOccluder(Rectangle rect, int order)
+{
+	// Round inwards, a cell only counts as covered if all of its pixels are
+	const int firstColumn = std::max(Column(rect.position.x + CellWidth - 1), 0);
+	const int lastColumn = std::min(Column(rect.position.x + rect.size.width) - 1, columns_ - 1);
+	const int firstRow = std::max(Row(rect.position.y + CellHeight - 1), 0);
+	const int lastRow = std::min(Row(rect.position.y + rect.size.height) - 1, rows_ - 1);
+
+	for (int row = firstRow; row <= lastRow; row++) {
+		for (int column = firstColumn; column <= lastColumn; column++) {
+			int &coveredBy = coveredBy_[row * columns_ + column];
+			coveredBy = std::max(coveredBy, order);
+		}
+	}
+}
+
+bool OcclusionMap::IsHidden(Rectangle rect, int order) const
+{
+	// Only the part inside the buffer is drawn
+	const int left = std::max(rect.position.x, 0);
+	const int top = std::max(rect.position.y, 0);
+	const int right = std::min(rect.position.x + rect.size.width, size_.width);
+	const int bottom = std::min(rect.position.y + rect.size.height, size_.height);
+	if (left >= right || top >= bottom)
+		return true;
+
+	const int lastColumn = Column(right - 1);
+	const int lastRow = Row(bottom - 1);
+	for (int row = Row(top); row <= lastRow; row++) {
+		for (int column = Column(left); column <= lastColumn; column++) {
+			if (coveredBy_[row * columns_ + column] <= order)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace devilution
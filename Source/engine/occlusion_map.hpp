@@ -0,0 +1,58 @@
+/**
+ * @file occlusion_map.hpp
+ *
+ * Interface of the map of screen areas that get painted over by opaque level tiles.
+ */
+#pragma once
+
+#include <vector>
+
+#include "engine/rectangle.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Tracks which parts of the screen are overwritten by opaque draws, and when
+ *
+ * The screen is split into cells the size of half a tile row. Every cell remembers the last draw that overwrote all of
+ * its pixels. Anything drawn to a cell before that draw can't be seen in the finished frame and can be skipped.
+ */
+class OcclusionMap {
+public:
+	static constexpr int CellWidth = 32;
+	static constexpr int CellHeight = 16;
+
+	/**
+	 * @brief Forget all occluders and set up the cells for a new frame
+	 * @param size Size of the output buffer
+	 * @param origin Any corner of the grid of cells, tiles that line up with it occlude whole cells
+	 */
+	void Reset(Size size, Point origin);
+
+	/**
+	 * @brief Record that a draw overwrites every pixel of a rectangle, only cells entirely inside it are marked
+	 * @param order Position of the draw in the frame, starting at 1
+	 */
+	void AddOccluder(Rectangle rect, int order);
+
+	/**
+	 * @brief Check if every pixel of a rectangle that is on screen gets overwritten by a draw that comes after order
+	 */
+	bool IsHidden(Rectangle rect, int order) const;
+
+private:
+	/** Index of the cell column containing x, can be negative or past the last column */
+	int Column(int x) const;
+	/** Index of the cell row containing y, can be negative or past the last row */
+	int Row(int y) const;
+
+	Size size_ {};
+	/** Top left corner of the first cell, never to the right of or below the buffer origin */
+	Point origin_ {};
+	int columns_ = 0;
+	int rows_ = 0;
+	/** For each cell, the order of the last draw that covered it or 0 */
+	std::vector<int> coveredBy_;
+};
+
+} // namespace devilution
@@ -0,0 +1,68 @@
+/**
+ * @file palette_match.cpp
+ *
+ * Implementation of the nearest color search used to build the blended transparency table.
+ */
+#include "engine/palette_match.hpp"
+
+namespace devilution {
+
+PaletteMatcher::PaletteMatcher(const SDL_Color *palette, int skipFrom, int skipTo)
+{
+	constexpr int CellSize = 1 << CellShift;
+
+	colors_.reserve(256);
+	for (int i = 0; i < 256; i++) {
+		if (i >= skipFrom && i <= skipTo)
+			continue;
+		colors_.push_back({ palette[i].r, palette[i].g, palette[i].b, static_cast<std::uint8_t>(i) });
+	}
+
+	minDistance_.resize(AxisRow(3, 0));
+	maxDistance_.resize(AxisRow(3, 0));
+	for (int position = 0; position < CellsPerAxis; position++) {
+		const int from = position * CellSize;
+		const int to = from + CellSize - 1;
+		for (size_t i = 0; i < colors_.size(); i++) {
+			const int values[3] = { colors_[i].r, colors_[i].g, colors_[i].b };
+			for (int axis = 0; axis < 3; axis++) {
+				const int value = values[axis];
+				const int minDiff = value < from ? from - value : (value > to ? value - to : 0);
+				const int maxDiff = std::max(value - from, to - value);
+				minDistance_[AxisRow(axis, position) + i] = minDiff * minDiff;
+				maxDistance_[AxisRow(axis, position) + i] = maxDiff * maxDiff;
+			}
+		}
+	}
+}
+
+void PaletteMatcher::BuildCell(int cell)
+{
+	constexpr int AxisMask = CellsPerAxis - 1;
+
+	const int count = static_cast<int>(colors_.size());
+	const size_t r = AxisRow(0, cell / (CellsPerAxis * CellsPerAxis));
+	const size_t g = AxisRow(1, (cell / CellsPerAxis) & AxisMask);
+	const size_t b = AxisRow(2, cell & AxisMask);
+	const std::uint32_t *minR = &minDistance_[r];
+	const std::uint32_t *minG = &minDistance_[g];
+	const std::uint32_t *minB = &minDistance_[b];
+	const std::uint32_t *maxR = &maxDistance_[r];
+	const std::uint32_t *maxG = &maxDistance_[g];
+	const std::uint32_t *maxB = &maxDistance_[b];
+
+	// Every color in the cell is at most this far from its closest entry
+	std::uint32_t bound = UINT32_MAX;
+	for (int i = 0; i < count; i++)
+		bound = std::min(bound, maxR[i] + maxG[i] + maxB[i]);
+
+	// So entries that are further than that from the whole cell can never be the closest one
+	std::vector<Entry> &candidates = cells_[cell];
+	for (int i = 0; i < count; i++) {
+		if (minR[i] + minG[i] + minB[i] <= bound)
+			candidates.push_back(colors_[i]);
+	}
+	cellBuilt_[cell] = true;
+}
+
+} // namespace devilution
@@ -0,0 +1,92 @@
+/**
+ * @file palette_match.hpp
+ *
+ * Interface of the nearest color search used to build the blended transparency table.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <SDL.h>
+
+namespace devilution {
+
+/**
+ * @brief Finds the palette entry closest to a color
+ *
+ * The RGB cube is split into a grid of 8x8x8 cells, and each cell lists the palette entries that can be the closest
+ * one to some color inside it. A search only compares the color against the list of its cell, which is usually a
+ * handful of entries instead of the whole palette. The lists are built the first time a cell is searched, as the
+ * blends of a palette only fall into a small part of the cube.
+ */
+class PaletteMatcher {
+public:
+	/**
+	 * @param palette The 256 colors to match against
+	 * @param skipFrom Do not match colors between this index and skipTo, -1 to use every color
+	 * @param skipTo Do not match colors between skipFrom and this index
+	 */
+	PaletteMatcher(const SDL_Color *palette, int skipFrom, int skipTo);
+
+	/**
+	 * @brief Find the entry with the smallest squared RGB distance to a color
+	 * @return The lowest such index, the same one a linear scan over the palette finds
+	 */
+	std::uint8_t FindBestMatch(SDL_Color color)
+	{
+		const int cell = CellIndex(color.r, color.g, color.b);
+		if (!cellBuilt_[cell])
+			BuildCell(cell);
+
+		// The distance goes in the high bits and the index in the low byte, so the smallest key is the closest
+		// entry and ties go to the lowest index. This also keeps the loop free of branches.
+		std::uint32_t best = UINT32_MAX;
+		for (const Entry &entry : cells_[cell]) {
+			const int diffr = entry.r - color.r;
+			const int diffg = entry.g - color.g;
+			const int diffb = entry.b - color.b;
+			const std::uint32_t diff = diffr * diffr + diffg * diffg + diffb * diffb;
+			best = std::min(best, (diff << 8) | entry.index);
+		}
+		return best & 0xFF;
+	}
+
+private:
+	static constexpr int CellShift = 5;
+	static constexpr int CellsPerAxis = 256 >> CellShift;
+	static constexpr int CellCount = CellsPerAxis * CellsPerAxis * CellsPerAxis;
+
+	struct Entry {
+		std::uint8_t r;
+		std::uint8_t g;
+		std::uint8_t b;
+		std::uint8_t index;
+	};
+
+	static int CellIndex(int r, int g, int b)
+	{
+		return ((r >> CellShift) * CellsPerAxis + (g >> CellShift)) * CellsPerAxis + (b >> CellShift);
+	}
+
+	void BuildCell(int cell);
+
+	/** Palette entries that aren't skipped, in palette order */
+	std::vector<Entry> colors_;
+	/** Squared distance along each axis from each entry to the closest value of each row of cells, see AxisRow */
+	std::vector<std::uint32_t> minDistance_;
+	/** Squared distance along each axis from each entry to the furthest value of each row of cells, see AxisRow */
+	std::vector<std::uint32_t> maxDistance_;
+
+	static size_t AxisRow(int axis, int position)
+	{
+		return (axis * CellsPerAxis + position) * 256;
+	}
+	/** Candidates of each cell, in palette order */
+	std::array<std::vector<Entry>, CellCount> cells_;
+	std::array<bool, CellCount> cellBuilt_ {};
+};
+
+} // namespace devilution
@@ -8,6 +8,15 @@ namespace devilution {
 struct Rectangle {
 	Point position;
 	Size size;
+
+	/**
+	 * @brief Whether two rectangles with an area share at least one pixel, touching edges do not count
+	 */
+	constexpr bool Overlaps(const Rectangle &other) const
+	{
+		return position.x < other.position.x + other.size.width && other.position.x < position.x + size.width
+		    && position.y < other.position.y + other.size.height && other.position.y < position.y + size.height;
+	}
 };
 
 } // namespace devilution
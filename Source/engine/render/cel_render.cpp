@@ -706,6 +706,27 @@ void CelBlitOutlineTo(const CelOutputBuffer &out, uint8_t col, Point position, c
 		RenderCelOutline<false>(out, position, src, nDataSize, cel.Width(frame), col);
 }
 
+int MeasureCelHeight(const CelSprite &cel, int frame)
+{
+	int nDataSize;
+	const byte *src = CelGetFrameClipped(cel.Data(), frame, &nDataSize);
+	const auto *end = &src[nDataSize];
+
+	// Runs never cross lines, so the number of rows follows from the total width of the runs
+	int pixels = 0;
+	while (src < end) {
+		const auto val = static_cast<std::uint8_t>(*src++);
+		if (IsCelTransparent(val)) {
+			pixels += GetCelTransparentWidth(val);
+		} else {
+			pixels += val;
+			src += val;
+		}
+	}
+	const int width = cel.Width(frame);
+	return (pixels + width - 1) / width;
+}
+
 std::pair<int, int> MeasureSolidHorizontalBounds(const CelSprite &cel, int frame)
 {
 	int nDataSize;
@@ -19,6 +19,11 @@ namespace devilution {
  */
 std::pair<int, int> MeasureSolidHorizontalBounds(const CelSprite &cel, int frame = 1);
 
+/**
+ * @brief Count the rows of a frame that starts with a header, as drawn by the clipped functions
+ */
+int MeasureCelHeight(const CelSprite &cel, int frame);
+
 /**
  * @brief Blit CEL sprite to the back buffer at the given coordinates
  * @param out Target buffer
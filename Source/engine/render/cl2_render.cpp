@@ -792,6 +792,32 @@ void Cl2DrawLightTbl(const CelOutputBuffer &out, int sx, int sy, const CelSprite
 	Cl2BlitLightSafe(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame), GetLightTable(light));
 }
 
+int MeasureCl2Height(const CelSprite &cel, int frame)
+{
+	assert(frame > 0);
+
+	int nDataSize;
+	const byte *src = CelGetFrameClipped(cel.Data(), frame, &nDataSize);
+	const auto *end = &src[nDataSize];
+
+	int pixels = 0;
+	while (src < end) {
+		const auto v = static_cast<std::uint8_t>(*src++);
+		if (!IsCl2Opaque(v)) {
+			pixels += v;
+		} else if (IsCl2OpaqueFill(v)) {
+			pixels += GetCl2OpaqueFillWidth(v);
+			++src;
+		} else {
+			const auto width = GetCl2OpaquePixelsWidth(v);
+			pixels += width;
+			src += width;
+		}
+	}
+	const int width = cel.Width(frame);
+	return (pixels + width - 1) / width;
+}
+
 void Cl2DrawLight(const CelOutputBuffer &out, int sx, int sy, const CelSprite &cel, int frame)
 {
 	assert(frame > 0);
@@ -64,4 +64,11 @@ void Cl2DrawLightTbl(const CelOutputBuffer &out, int sx, int sy, const CelSprite
  */
 void Cl2DrawLight(const CelOutputBuffer &out, int sx, int sy, const CelSprite &cel, int frame);
 
+/**
+ * @brief Count the rows of a CL2 frame
+ * @param cel CL2 buffer
+ * @param frame CL2 frame number
+ */
+int MeasureCl2Height(const CelSprite &cel, int frame);
+
 } // namespace devilution
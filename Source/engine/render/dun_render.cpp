@@ -9,6 +9,10 @@
 #include <climits>
 #include <cstdint>
 
+#include "engine/render/dun_render_kernels.hpp"
+#include "engine/render/dun_render_scalar.hpp"
+#include "engine/render/dun_tile_cache.hpp"
+#include "gendung.h"
 #include "lighting.h"
 #include "options.h"
 #include "utils/attributes.h"
@@ -450,44 +454,28 @@ const std::uint32_t LeftFoliageMask[TILE_HEIGHT] = {
 	0x00000000,
 };
 
-inline int CountLeadingZeros(std::uint32_t mask)
+/** Kernels the calling thread uses while it bakes a tile for the tile cache, nullptr otherwise */
+thread_local const DunRenderKernels *BakeKernels;
+
+/**
+ * @brief Draw one line with the kernels of the calling thread
+ *
+ * Builds without SIMD kernels call the scalar loop directly, so it gets inlined like any other loop of the renderer.
+ */
+template <RenderLineKernel DunRenderKernels::*Kernel, RenderLineKernel ScalarKernel>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void CallLineKernel(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
 {
-	// Note: This function assumes that the argument is not zero,
-	// which means there is at least one bit set.
-	static_assert(
-	    sizeof(std::uint32_t) == sizeof(uint32_t),
-	    "CountLeadingZeros: std::uint32_t must be 32bits");
-#if defined(__GNUC__) || defined(__clang__)
-	return __builtin_clz(mask);
+#ifdef DUN_RENDER_SIMD
+	const DunRenderKernels &kernels = BakeKernels != nullptr ? *BakeKernels : *ActiveDunRenderKernels;
+	(kernels.*Kernel)(dst, src, n, tbl, mask);
 #else
-	// Count the number of leading zeros using binary search.
-	int n = 0;
-	if ((mask & 0xFFFF0000) == 0)
-		n += 16, mask <<= 16;
-	if ((mask & 0xFF000000) == 0)
-		n += 8, mask <<= 8;
-	if ((mask & 0xF0000000) == 0)
-		n += 4, mask <<= 4;
-	if ((mask & 0xC0000000) == 0)
-		n += 2, mask <<= 2;
-	if ((mask & 0x80000000) == 0)
-		n += 1;
-	return n;
+	if (BakeKernels != nullptr)
+		(BakeKernels->*Kernel)(dst, src, n, tbl, mask);
+	else
+		ScalarKernel(dst, src, n, tbl, mask);
 #endif
 }
 
-template <typename F>
-DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void ForEachSetBit(std::uint32_t mask, const F &f)
-{
-	int i = 0;
-	while (mask != 0) {
-		int z = CountLeadingZeros(mask);
-		i += z, mask <<= z;
-		for (; mask & 0x80000000; i++, mask <<= 1)
-			f(i);
-	}
-}
-
 enum class TransparencyType {
 	Solid,
 	Blended,
@@ -513,9 +501,7 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineOpaque(std::uint8_t *dst, con
 #endif
 	} else { // Partially lit
 #ifndef DEBUG_RENDER_COLOR
-		for (size_t i = 0; i < n; i++) {
-			dst[i] = tbl[src[i]];
-		}
+		CallLineKernel<&DunRenderKernels::opaquePartiallyLit, OpaquePartiallyLitScalar>(dst, src, n, tbl, 0);
 #else
 		memset(dst, tbl[DBGCOLOR], n);
 #endif
@@ -527,26 +513,11 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineBlended(std::uint8_t *dst, co
 {
 #ifndef DEBUG_RENDER_COLOR
 	if (Light == LightType::FullyDark) {
-		for (size_t i = 0; i < n; i++, mask <<= 1) {
-			if ((mask & 0x80000000) != 0)
-				dst[i] = 0;
-			else
-				dst[i] = paletteTransparencyLookup[0][dst[i]];
-		}
+		CallLineKernel<&DunRenderKernels::blendedFullyDark, BlendedFullyDarkScalar>(dst, src, n, tbl, mask);
 	} else if (Light == LightType::FullyLit) {
-		for (size_t i = 0; i < n; i++, mask <<= 1) {
-			if ((mask & 0x80000000) != 0)
-				dst[i] = src[i];
-			else
-				dst[i] = paletteTransparencyLookup[dst[i]][src[i]];
-		}
+		CallLineKernel<&DunRenderKernels::blendedFullyLit, BlendedFullyLitScalar>(dst, src, n, tbl, mask);
 	} else { // Partially lit
-		for (size_t i = 0; i < n; i++, mask <<= 1) {
-			if ((mask & 0x80000000) != 0)
-				dst[i] = tbl[src[i]];
-			else
-				dst[i] = paletteTransparencyLookup[dst[i]][tbl[src[i]]];
-		}
+		CallLineKernel<&DunRenderKernels::blendedPartiallyLit, BlendedPartiallyLitScalar>(dst, src, n, tbl, mask);
 	}
 #else
 	for (size_t i = 0; i < n; i++, mask <<= 1) {
@@ -562,15 +533,18 @@ template <LightType Light>
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void RenderLineStippled(std::uint8_t *dst, const std::uint8_t *src, std::uint_fast8_t n, const std::uint8_t *tbl, std::uint32_t mask)
 {
 	if (Light == LightType::FullyDark) {
-		ForEachSetBit(mask, [=](int i) { dst[i] = 0; });
+		CallLineKernel<&DunRenderKernels::stippledFullyDark, StippledFullyDarkScalar>(dst, src, n, tbl, mask);
 	} else if (Light == LightType::FullyLit) {
 #ifndef DEBUG_RENDER_COLOR
-		ForEachSetBit(mask, [=](int i) { dst[i] = src[i]; });
+		CallLineKernel<&DunRenderKernels::stippledFullyLit, StippledFullyLitScalar>(dst, src, n, tbl, mask);
 #else
-		ForEachSetBit(mask, [=](int i) { dst[i] = DBGCOLOR; });
+		for (size_t i = 0; i < n; i++, mask <<= 1) {
+			if ((mask & 0x80000000) != 0)
+				dst[i] = DBGCOLOR;
+		}
 #endif
 	} else { // Partially lit
-		ForEachSetBit(mask, [=](int i) { dst[i] = tbl[src[i]]; });
+		CallLineKernel<&DunRenderKernels::stippledPartiallyLit, StippledPartiallyLitScalar>(dst, src, n, tbl, mask);
 	}
 }
 
@@ -1373,34 +1347,12 @@ void RenderBlackTileFull(std::uint8_t *dst, int dstPitch)
 	}
 }
 
-} // namespace
-
-void RenderTile(const CelOutputBuffer &out, int x, int y)
+/** @brief Draw the current tile with the transparency and light level given by the mask and light_table_index */
+void RenderTileClipped(TileType tile, std::uint8_t *dst, int dstPitch, const std::uint32_t *mask, Clip clip)
 {
-	const auto tile = static_cast<TileType>((level_cel_block & 0x7000) >> 12);
-	const auto *mask = GetMask(tile);
-	if (mask == nullptr)
-		return;
-
-#ifdef DEBUG_RENDER_OFFSET_X
-	x += DEBUG_RENDER_OFFSET_X;
-#endif
-#ifdef DEBUG_RENDER_OFFSET_Y
-	y += DEBUG_RENDER_OFFSET_Y;
-#endif
-#ifdef DEBUG_RENDER_COLOR
-	DBGCOLOR = GetTileDebugColor(tile);
-#endif
-
-	Clip clip = CalculateClip(x, y, Width, GetTileHeight(tile), out);
-	if (clip.width <= 0 || clip.height <= 0)
-		return;
-
 	const std::uint8_t *tbl = &pLightTbl[256 * light_table_index];
 	const auto *pFrameTable = reinterpret_cast<const std::uint32_t *>(pDungeonCels.get());
 	const auto *src = reinterpret_cast<const std::uint8_t *>(&pDungeonCels[SDL_SwapLE32(pFrameTable[level_cel_block & 0xFFF])]);
-	std::uint8_t *dst = out.at(static_cast<int>(x + clip.left), static_cast<int>(y - clip.bottom));
-	const auto dstPitch = out.pitch();
 
 	if (mask == &SolidMask[TILE_HEIGHT - 1]) {
 		if (light_table_index == lightmax) {
@@ -1432,6 +1384,231 @@ void RenderTile(const CelOutputBuffer &out, int x, int y)
 	}
 }
 
+/** Masks returned by GetMask, their position in this list identifies the transparency of a cached tile */
+const std::uint32_t *const CachedMasks[] = {
+	&SolidMask[TILE_HEIGHT - 1],
+	&WallMask[TILE_HEIGHT - 1],
+	&WallMaskFullyTrasparent[TILE_HEIGHT - 1],
+	&LeftMask[TILE_HEIGHT - 1],
+	&LeftMaskTransparent[TILE_HEIGHT - 1],
+	&RightMask[TILE_HEIGHT - 1],
+	&RightMaskTransparent[TILE_HEIGHT - 1],
+	&LeftFoliageMask[TILE_HEIGHT - 1],
+	&RightFoliageMask[TILE_HEIGHT - 1],
+};
+
+/** Start of the tile being baked, used by the capture kernels to locate the pixels they are given */
+thread_local const std::uint8_t *CaptureOrigin;
+/** Pixels of the tile being baked that the blended kernels mix with the screen */
+thread_local std::uint32_t CaptureBlended[TILE_HEIGHT];
+
+void CaptureBlendedPixels(const std::uint8_t *dst, unsigned n, std::uint32_t mask)
+{
+	const auto offset = static_cast<unsigned>(dst - CaptureOrigin);
+	const unsigned row = offset / Width;
+	const unsigned column = offset % Width;
+	const std::uint32_t line = std::uint32_t(-1) << (32 - n);
+	CaptureBlended[row] |= (~mask & line) >> column;
+}
+
+void CaptureBlendedFullyDark(std::uint8_t *dst, const std::uint8_t * /*src*/, unsigned n, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	CaptureBlendedPixels(dst, n, mask);
+	memset(dst, 0, n);
+}
+
+void CaptureBlendedFullyLit(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	CaptureBlendedPixels(dst, n, mask);
+	memcpy(dst, src, n);
+}
+
+void CaptureBlendedPartiallyLit(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	CaptureBlendedPixels(dst, n, mask);
+	for (unsigned i = 0; i < n; i++)
+		dst[i] = tbl[src[i]];
+}
+
+/**
+ * @brief Kernels that store the tile pixels as they are before blending, and note which ones get blended
+ */
+const DunRenderKernels &GetCaptureKernels()
+{
+	static const DunRenderKernels Kernels = [] {
+		DunRenderKernels kernels = *GetDunRenderKernels(DunRenderIsa::Scalar);
+		kernels.name = "capture";
+		kernels.blendedFullyDark = CaptureBlendedFullyDark;
+		kernels.blendedFullyLit = CaptureBlendedFullyLit;
+		kernels.blendedPartiallyLit = CaptureBlendedPartiallyLit;
+		return kernels;
+	}();
+	return Kernels;
+}
+
+/**
+ * @brief Identify the current tile, light level and transparency
+ */
+std::uint32_t GetTileCacheKey(const std::uint32_t *mask)
+{
+	std::uint32_t maskIndex = 0;
+	while (CachedMasks[maskIndex] != mask)
+		maskIndex++;
+	const std::uint32_t transparency = maskIndex * 2 + (sgOptions.Graphics.bBlendedTransparancy ? 1 : 0);
+	return (level_cel_block & 0xFFFF) | (light_table_index << 16) | (transparency << 24);
+}
+
+/**
+ * @brief Decode the current tile into a cache entry
+ *
+ * The tile is drawn twice over different backgrounds, pixels that come out the same both times are the ones it covers.
+ */
+void BakeTile(CachedTile &cached, TileType tile, const std::uint32_t *mask)
+{
+	std::uint8_t first[TILE_HEIGHT][Width];
+	std::uint8_t second[TILE_HEIGHT][Width];
+	const Clip clip { 0, 0, 0, 0, Width, GetTileHeight(tile) };
+
+	BakeKernels = &GetCaptureKernels();
+	memset(CaptureBlended, 0, sizeof(CaptureBlended));
+	memset(first, 0x00, sizeof(first));
+	memset(second, 0xFF, sizeof(second));
+	CaptureOrigin = &first[0][0];
+	RenderTileClipped(tile, &first[TILE_HEIGHT - 1][0], Width, mask, clip);
+	CaptureOrigin = &second[0][0];
+	RenderTileClipped(tile, &second[TILE_HEIGHT - 1][0], Width, mask, clip);
+	BakeKernels = nullptr;
+
+	memcpy(cached.pixels, first, sizeof(first));
+	for (int row = 0; row < TILE_HEIGHT; row++) {
+		std::uint32_t covered = 0;
+		for (int column = 0; column < Width; column++) {
+			if (first[row][column] == second[row][column])
+				covered |= 0x80000000 >> column;
+		}
+		cached.blended[row] = CaptureBlended[row] & covered;
+		cached.opaque[row] = covered & ~cached.blended[row];
+
+		// Rows that are a single run of opaque pixels can be copied in one go
+		cached.runStart[row] = 0;
+		cached.runLength[row] = 0;
+		std::uint32_t opaque = cached.opaque[row];
+		if (opaque == 0)
+			continue;
+		int start = 0;
+		for (; (opaque & 0x80000000) == 0; start++)
+			opaque <<= 1;
+		int length = 0;
+		for (; (opaque & 0x80000000) != 0; length++)
+			opaque <<= 1;
+		if (opaque == 0) {
+			cached.runStart[row] = start;
+			cached.runLength[row] = length;
+		}
+	}
+	cached.darkBlend = light_table_index == lightmax;
+}
+
+/**
+ * @brief Draw a cached tile
+ * @param dst Top left corner of the tile
+ */
+DVL_ATTRIBUTE_HOT void RenderCachedTile(std::uint8_t *dst, int dstPitch, const CachedTile &cached, std::int_fast16_t height)
+{
+	for (auto row = TILE_HEIGHT - height; row < TILE_HEIGHT; row++, dst += dstPitch) {
+		const std::uint8_t *src = cached.pixels[row];
+		if (cached.runLength[row] != 0) {
+			memcpy(dst + cached.runStart[row], src + cached.runStart[row], cached.runLength[row]);
+		} else {
+			std::uint32_t opaque = cached.opaque[row];
+			for (int column = 0; opaque != 0; column++, opaque <<= 1) {
+				if ((opaque & 0x80000000) != 0)
+					dst[column] = src[column];
+			}
+		}
+
+		std::uint32_t blended = cached.blended[row];
+		for (int column = 0; blended != 0; column++, blended <<= 1) {
+			if ((blended & 0x80000000) == 0)
+				continue;
+			if (cached.darkBlend)
+				dst[column] = paletteTransparencyLookup[0][dst[column]];
+			else
+				dst[column] = paletteTransparencyLookup[dst[column]][src[column]];
+		}
+	}
+}
+
+/**
+ * @brief Check if baked tiles stay valid from frame to frame
+ *
+ * Hell cycles the colors of its light tables every game tick.
+ */
+bool CanCacheTiles()
+{
+	return leveltype != DTYPE_HELL || !sgOptions.Graphics.bColorCycling;
+}
+
+} // namespace
+
+void RenderTile(const CelOutputBuffer &out, int x, int y)
+{
+	const auto tile = static_cast<TileType>((level_cel_block & 0x7000) >> 12);
+	const auto *mask = GetMask(tile);
+	if (mask == nullptr)
+		return;
+
+#ifdef DEBUG_RENDER_OFFSET_X
+	x += DEBUG_RENDER_OFFSET_X;
+#endif
+#ifdef DEBUG_RENDER_OFFSET_Y
+	y += DEBUG_RENDER_OFFSET_Y;
+#endif
+#ifdef DEBUG_RENDER_COLOR
+	DBGCOLOR = GetTileDebugColor(tile);
+#endif
+
+	const auto height = GetTileHeight(tile);
+	Clip clip = CalculateClip(x, y, Width, height, out);
+	if (clip.width <= 0 || clip.height <= 0)
+		return;
+
+#ifndef DEBUG_RENDER_COLOR
+	// Only tiles that are fully on screen are drawn from the cache, the few clipped ones along the edges are decoded as usual
+	if (clip.width == Width && clip.height == height && CanCacheTiles()) {
+		const std::uint32_t key = GetTileCacheKey(mask);
+		CachedTile *cached = FindCachedTile(key);
+		if (cached == nullptr) {
+			cached = AddCachedTile(key);
+			if (cached != nullptr)
+				BakeTile(*cached, tile, mask);
+		}
+		if (cached != nullptr) {
+			RenderCachedTile(out.at(x, static_cast<int>(y - height + 1)), out.pitch(), *cached, height);
+			return;
+		}
+	}
+#endif
+
+	RenderTileClipped(tile, out.at(static_cast<int>(x + clip.left), static_cast<int>(y - clip.bottom)), out.pitch(), mask, clip);
+}
+
+int GetTileOpaqueHeight()
+{
+#if defined(DEBUG_RENDER_OFFSET_X) || defined(DEBUG_RENDER_OFFSET_Y)
+	return 0;
+#else
+	const auto tile = static_cast<TileType>((level_cel_block & 0x7000) >> 12);
+	if (GetMask(tile) != &SolidMask[TILE_HEIGHT - 1])
+		return 0;
+	if (tile == TileType::Square)
+		return Height;
+	if (tile == TileType::LeftTrapezoid || tile == TileType::RightTrapezoid)
+		return TrapezoidUpperHeight;
+	return 0;
+#endif
+}
+
 void world_draw_black_tile(const CelOutputBuffer &out, int sx, int sy)
 {
 #ifdef DEBUG_RENDER_OFFSET_X
@@ -17,6 +17,15 @@ namespace devilution {
  */
 void RenderTile(const CelOutputBuffer &out, int x, int y);
 
+/**
+ * @brief Get how much of the current world CEL RenderTile overwrites with opaque pixels
+ *
+ * Only solid squares and the rectangular top of solid trapezoids count, other tiles leave some pixels untouched.
+ *
+ * @return Number of rows from the top of the 32x32 tile in which every pixel is overwritten
+ */
+int GetTileOpaqueHeight();
+
 /**
  * @brief Render a black 64x31 tile ◆
  * @param out Target buffer
@@ -0,0 +1,348 @@
+/**
+ * @file dun_render_kernels.cpp
+ *
+ * Implementation of the per-line pixel loops used to render level tiles.
+ *
+ * The SIMD kernels work on groups of 8 or 16 pixels and leave the remaining pixels of a line to the scalar kernels,
+ * they never read or write past the end of a line.
+ */
+#include "engine/render/dun_render_kernels.hpp"
+
+#include <cstring>
+
+#include <SDL.h>
+
+#include "engine/render/dun_render_scalar.hpp"
+#include "palette.h"
+#include "utils/attributes.h"
+
+#if defined(DUN_RENDER_X86)
+#include <immintrin.h>
+#elif defined(DUN_RENDER_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+const DunRenderKernels ScalarKernels = {
+	"scalar",
+	OpaquePartiallyLitScalar,
+	BlendedFullyDarkScalar,
+	BlendedFullyLitScalar,
+	BlendedPartiallyLitScalar,
+	StippledFullyDarkScalar,
+	StippledFullyLitScalar,
+	StippledPartiallyLitScalar,
+};
+
+#ifdef DUN_RENDER_X86
+
+/** @brief Turn the top 8 bits of the mask into 8 bytes of 0x00 or 0xFF, in the low half of the result */
+DVL_ATTRIBUTE_TARGET("sse2")
+inline __m128i ExpandMask8(std::uint32_t mask)
+{
+	const __m128i bits = _mm_set_epi32(0x01020408, 0x10204080, 0x01020408, 0x10204080);
+	const __m128i bytes = _mm_set1_epi8(static_cast<char>(mask >> 24));
+	return _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+}
+
+/** @brief Turn the top 16 bits of the mask into 16 bytes of 0x00 or 0xFF */
+DVL_ATTRIBUTE_TARGET("sse2")
+inline __m128i ExpandMask16(std::uint32_t mask)
+{
+	const __m128i bits = _mm_set_epi32(0x01020408, 0x10204080, 0x01020408, 0x10204080);
+	const __m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(mask >> 24)), _mm_set1_epi8(static_cast<char>(mask >> 16)));
+	return _mm_cmpeq_epi8(_mm_and_si128(bytes, bits), bits);
+}
+
+/** @brief Pick bytes from a where the mask is set and from b elsewhere */
+DVL_ATTRIBUTE_TARGET("sse2")
+inline __m128i Select(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+inline __m128i Load8(const std::uint8_t *p)
+{
+	return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+inline void Store8(std::uint8_t *p, __m128i v)
+{
+	_mm_storel_epi64(reinterpret_cast<__m128i *>(p), v);
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+DVL_ATTRIBUTE_HOT void StippledFullyDarkSSE2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 16 <= n; i += 16, mask <<= 16) {
+		auto *line = reinterpret_cast<__m128i *>(dst + i);
+		_mm_storeu_si128(line, _mm_andnot_si128(ExpandMask16(mask), _mm_loadu_si128(line)));
+	}
+	for (; i + 8 <= n; i += 8, mask <<= 8)
+		Store8(dst + i, _mm_andnot_si128(ExpandMask8(mask), Load8(dst + i)));
+	StippledFullyDarkScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_TARGET("sse2")
+DVL_ATTRIBUTE_HOT void StippledFullyLitSSE2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 16 <= n; i += 16, mask <<= 16) {
+		auto *line = reinterpret_cast<__m128i *>(dst + i);
+		const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		_mm_storeu_si128(line, Select(ExpandMask16(mask), pixels, _mm_loadu_si128(line)));
+	}
+	for (; i + 8 <= n; i += 8, mask <<= 8)
+		Store8(dst + i, Select(ExpandMask8(mask), Load8(src + i), Load8(dst + i)));
+	StippledFullyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+const DunRenderKernels SSE2Kernels = {
+	"sse2",
+	OpaquePartiallyLitScalar,
+	BlendedFullyDarkScalar,
+	BlendedFullyLitScalar,
+	BlendedPartiallyLitScalar,
+	StippledFullyDarkSSE2,
+	StippledFullyLitSSE2,
+	StippledPartiallyLitScalar,
+};
+
+/**
+ * @brief Look up 8 entries of a byte table with a gather
+ *
+ * The gather reads 4 bytes per entry, the last 3 entries are read from an earlier offset so nothing past the table is touched.
+ * @param table Table to read
+ * @param indices 8 indices into the table
+ * @param lastIndex Index of the last entry of the table
+ * @return The looked up bytes in the low half
+ */
+DVL_ATTRIBUTE_TARGET("avx2")
+inline __m128i GatherBytes8(const std::uint8_t *table, __m256i indices, int lastIndex)
+{
+	const __m256i start = _mm256_min_epi32(indices, _mm256_set1_epi32(lastIndex - 3));
+	__m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), start, 1);
+	words = _mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_sub_epi32(indices, start), 3));
+
+	const __m256i lowBytes = _mm256_setr_epi8(
+	    0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	    0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	words = _mm256_shuffle_epi8(words, lowBytes);
+	return _mm_unpacklo_epi32(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+inline __m256i Widen8(__m128i bytes)
+{
+	return _mm256_cvtepu8_epi32(bytes);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+inline __m128i LightPixels8(const std::uint8_t *tbl, const std::uint8_t *src)
+{
+	return GatherBytes8(tbl, Widen8(Load8(src)), 255);
+}
+
+/** @brief Look up paletteTransparencyLookup[dst][top] for 8 pixels */
+DVL_ATTRIBUTE_TARGET("avx2")
+inline __m128i BlendPixels8(__m128i dst, __m128i top)
+{
+	const __m256i indices = _mm256_or_si256(_mm256_slli_epi32(Widen8(dst), 8), Widen8(top));
+	return GatherBytes8(&paletteTransparencyLookup[0][0], indices, 256 * 256 - 1);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+DVL_ATTRIBUTE_HOT void OpaquePartiallyLitAVX2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8)
+		Store8(dst + i, LightPixels8(tbl, src + i));
+	OpaquePartiallyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+DVL_ATTRIBUTE_HOT void BlendedFullyDarkAVX2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8, mask <<= 8) {
+		const __m128i blended = GatherBytes8(paletteTransparencyLookup[0], Widen8(Load8(dst + i)), 255);
+		Store8(dst + i, _mm_andnot_si128(ExpandMask8(mask), blended));
+	}
+	BlendedFullyDarkScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+DVL_ATTRIBUTE_HOT void BlendedFullyLitAVX2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8, mask <<= 8) {
+		const __m128i pixels = Load8(src + i);
+		Store8(dst + i, Select(ExpandMask8(mask), pixels, BlendPixels8(Load8(dst + i), pixels)));
+	}
+	BlendedFullyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+DVL_ATTRIBUTE_HOT void BlendedPartiallyLitAVX2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8, mask <<= 8) {
+		const __m128i pixels = LightPixels8(tbl, src + i);
+		Store8(dst + i, Select(ExpandMask8(mask), pixels, BlendPixels8(Load8(dst + i), pixels)));
+	}
+	BlendedPartiallyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_TARGET("avx2")
+DVL_ATTRIBUTE_HOT void StippledPartiallyLitAVX2(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8, mask <<= 8)
+		Store8(dst + i, Select(ExpandMask8(mask), LightPixels8(tbl, src + i), Load8(dst + i)));
+	StippledPartiallyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+const DunRenderKernels AVX2Kernels = {
+	"avx2",
+	OpaquePartiallyLitAVX2,
+	BlendedFullyDarkAVX2,
+	BlendedFullyLitAVX2,
+	BlendedPartiallyLitAVX2,
+	StippledFullyDarkSSE2,
+	StippledFullyLitSSE2,
+	StippledPartiallyLitAVX2,
+};
+
+#endif // DUN_RENDER_X86
+
+#ifdef DUN_RENDER_NEON
+
+const std::uint8_t MaskBits[16] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+
+/** @brief Turn the top 16 bits of the mask into 16 bytes of 0x00 or 0xFF */
+inline uint8x16_t ExpandMask16(std::uint32_t mask)
+{
+	const uint8x16_t bytes = vcombine_u8(vdup_n_u8(static_cast<std::uint8_t>(mask >> 24)), vdup_n_u8(static_cast<std::uint8_t>(mask >> 16)));
+	return vtstq_u8(bytes, vld1q_u8(MaskBits));
+}
+
+/** @brief Light table loaded into registers, for 16 lookups at a time */
+struct LightTable {
+	uint8x16x4_t quarters[4];
+
+	explicit LightTable(const std::uint8_t *tbl)
+	{
+		for (int q = 0; q < 4; q++) {
+			for (int i = 0; i < 4; i++)
+				quarters[q].val[i] = vld1q_u8(tbl + 64 * q + 16 * i);
+		}
+	}
+
+	uint8x16_t Lookup(uint8x16_t indices) const
+	{
+		const uint8x16_t quarterSize = vdupq_n_u8(64);
+		uint8x16_t result = vqtbl4q_u8(quarters[0], indices);
+		indices = vsubq_u8(indices, quarterSize);
+		result = vqtbx4q_u8(result, quarters[1], indices);
+		indices = vsubq_u8(indices, quarterSize);
+		result = vqtbx4q_u8(result, quarters[2], indices);
+		indices = vsubq_u8(indices, quarterSize);
+		return vqtbx4q_u8(result, quarters[3], indices);
+	}
+};
+
+DVL_ATTRIBUTE_HOT void OpaquePartiallyLitNEON(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	if (n >= 16) {
+		const LightTable light(tbl);
+		for (; i + 16 <= n; i += 16)
+			vst1q_u8(dst + i, light.Lookup(vld1q_u8(src + i)));
+	}
+	OpaquePartiallyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_HOT void StippledFullyDarkNEON(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 16 <= n; i += 16, mask <<= 16)
+		vst1q_u8(dst + i, vbicq_u8(vld1q_u8(dst + i), ExpandMask16(mask)));
+	StippledFullyDarkScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_HOT void StippledFullyLitNEON(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	for (; i + 16 <= n; i += 16, mask <<= 16)
+		vst1q_u8(dst + i, vbslq_u8(ExpandMask16(mask), vld1q_u8(src + i), vld1q_u8(dst + i)));
+	StippledFullyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+DVL_ATTRIBUTE_HOT void StippledPartiallyLitNEON(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	unsigned i = 0;
+	if (n >= 16) {
+		const LightTable light(tbl);
+		for (; i + 16 <= n; i += 16, mask <<= 16)
+			vst1q_u8(dst + i, vbslq_u8(ExpandMask16(mask), light.Lookup(vld1q_u8(src + i)), vld1q_u8(dst + i)));
+	}
+	StippledPartiallyLitScalar(dst + i, src + i, n - i, tbl, mask);
+}
+
+const DunRenderKernels NEONKernels = {
+	"neon",
+	OpaquePartiallyLitNEON,
+	BlendedFullyDarkScalar,
+	BlendedFullyLitScalar,
+	BlendedPartiallyLitScalar,
+	StippledFullyDarkNEON,
+	StippledFullyLitNEON,
+	StippledPartiallyLitNEON,
+};
+
+#endif // DUN_RENDER_NEON
+
+const DunRenderKernels *SelectDunRenderKernels()
+{
+	for (DunRenderIsa isa : { DunRenderIsa::AVX2, DunRenderIsa::NEON, DunRenderIsa::SSE2 }) {
+		const DunRenderKernels *kernels = GetDunRenderKernels(isa);
+		if (kernels != nullptr)
+			return kernels;
+	}
+	return &ScalarKernels;
+}
+
+} // namespace
+
+const DunRenderKernels *ActiveDunRenderKernels = SelectDunRenderKernels();
+
+const DunRenderKernels *GetDunRenderKernels(DunRenderIsa isa)
+{
+	switch (isa) {
+	case DunRenderIsa::Scalar:
+		return &ScalarKernels;
+#ifdef DUN_RENDER_X86
+	case DunRenderIsa::SSE2:
+		return SDL_HasSSE2() ? &SSE2Kernels : nullptr;
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+	case DunRenderIsa::AVX2:
+		return SDL_HasAVX2() ? &AVX2Kernels : nullptr;
+#endif
+#endif
+#ifdef DUN_RENDER_NEON
+	case DunRenderIsa::NEON:
+		// NEON is part of the baseline on 64-bit ARM
+		return &NEONKernels;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,64 @@
+/**
+ * @file dun_render_kernels.hpp
+ *
+ * Interface of the per-line pixel loops used to render level tiles.
+ */
+#pragma once
+
+#include <cstdint>
+
+// Define DUN_RENDER_NO_SIMD to build only the scalar kernels
+#ifndef DUN_RENDER_NO_SIMD
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DUN_RENDER_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DUN_RENDER_NEON
+#endif
+#endif
+
+#if defined(DUN_RENDER_X86) || defined(DUN_RENDER_NEON)
+/** Set when SIMD kernels are built, the renderer then picks its kernels at runtime */
+#define DUN_RENDER_SIMD
+#endif
+
+namespace devilution {
+
+/**
+ * @brief Draw one line of a tile
+ * @param dst Output pixels
+ * @param src Palette indices of the tile
+ * @param n Number of pixels, at most 32
+ * @param tbl Light table
+ * @param mask Pixels to draw solid, starting from the most significant bit. Bits past n must be clear. Ignored by the opaque kernel
+ */
+using RenderLineKernel = void (*)(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask);
+
+/** Instruction sets the render kernels are implemented in */
+enum class DunRenderIsa {
+	Scalar,
+	SSE2,
+	AVX2,
+	NEON,
+};
+
+struct DunRenderKernels {
+	const char *name;
+	RenderLineKernel opaquePartiallyLit;
+	RenderLineKernel blendedFullyDark;
+	RenderLineKernel blendedFullyLit;
+	RenderLineKernel blendedPartiallyLit;
+	RenderLineKernel stippledFullyDark;
+	RenderLineKernel stippledFullyLit;
+	RenderLineKernel stippledPartiallyLit;
+};
+
+/**
+ * @brief Get the kernels for an instruction set
+ * @return nullptr if the build or the CPU doesn't support the instruction set
+ */
+const DunRenderKernels *GetDunRenderKernels(DunRenderIsa isa);
+
+/** The kernels used by RenderTile, the fastest ones supported by the CPU */
+extern const DunRenderKernels *ActiveDunRenderKernels;
+
+} // namespace devilution
@@ -0,0 +1,105 @@
+/**
+ * @file dun_render_scalar.hpp
+ *
+ * Plain C++ versions of the per-line pixel loops used to render level tiles.
+ *
+ * They live in a header so the tile renderer can inline them on builds without SIMD kernels,
+ * and so the SIMD kernels can finish the last few pixels of a line with them.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "palette.h"
+#include "utils/attributes.h"
+
+namespace devilution {
+
+inline int CountLeadingZeros(std::uint32_t mask)
+{
+	// Note: This function assumes that the argument is not zero,
+	// which means there is at least one bit set.
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clz(mask);
+#else
+	// Count the number of leading zeros using binary search.
+	int n = 0;
+	if ((mask & 0xFFFF0000) == 0)
+		n += 16, mask <<= 16;
+	if ((mask & 0xFF000000) == 0)
+		n += 8, mask <<= 8;
+	if ((mask & 0xF0000000) == 0)
+		n += 4, mask <<= 4;
+	if ((mask & 0xC0000000) == 0)
+		n += 2, mask <<= 2;
+	if ((mask & 0x80000000) == 0)
+		n += 1;
+	return n;
+#endif
+}
+
+template <typename F>
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void ForEachSetBit(std::uint32_t mask, const F &f)
+{
+	int i = 0;
+	while (mask != 0) {
+		int z = CountLeadingZeros(mask);
+		i += z, mask <<= z;
+		for (; mask & 0x80000000; i++, mask <<= 1)
+			f(i);
+	}
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void OpaquePartiallyLitScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t /*mask*/)
+{
+	for (unsigned i = 0; i < n; i++) {
+		dst[i] = tbl[src[i]];
+	}
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlendedFullyDarkScalar(std::uint8_t *dst, const std::uint8_t * /*src*/, unsigned n, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	for (unsigned i = 0; i < n; i++, mask <<= 1) {
+		if ((mask & 0x80000000) != 0)
+			dst[i] = 0;
+		else
+			dst[i] = paletteTransparencyLookup[0][dst[i]];
+	}
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlendedFullyLitScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	for (unsigned i = 0; i < n; i++, mask <<= 1) {
+		if ((mask & 0x80000000) != 0)
+			dst[i] = src[i];
+		else
+			dst[i] = paletteTransparencyLookup[dst[i]][src[i]];
+	}
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlendedPartiallyLitScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned n, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	for (unsigned i = 0; i < n; i++, mask <<= 1) {
+		if ((mask & 0x80000000) != 0)
+			dst[i] = tbl[src[i]];
+		else
+			dst[i] = paletteTransparencyLookup[dst[i]][tbl[src[i]]];
+	}
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void StippledFullyDarkScalar(std::uint8_t *dst, const std::uint8_t * /*src*/, unsigned /*n*/, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	ForEachSetBit(mask, [=](int i) { dst[i] = 0; });
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void StippledFullyLitScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned /*n*/, const std::uint8_t * /*tbl*/, std::uint32_t mask)
+{
+	ForEachSetBit(mask, [=](int i) { dst[i] = src[i]; });
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void StippledPartiallyLitScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned /*n*/, const std::uint8_t *tbl, std::uint32_t mask)
+{
+	ForEachSetBit(mask, [=](int i) { dst[i] = tbl[src[i]]; });
+}
+
+} // namespace devilution
@@ -0,0 +1,130 @@
+/**
+ * @file dun_tile_cache.cpp
+ *
+ * Implementation of the cache of level tiles that are already decoded and lit.
+ *
+ * Every thread that draws tiles keeps its own cache, so the render threads never wait on each other.
+ */
+#include "engine/render/dun_tile_cache.hpp"
+
+#include <atomic>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
+namespace devilution {
+
+namespace {
+
+struct TileEntry {
+	std::uint32_t key;
+	CachedTile tile;
+};
+
+struct ThreadTileCache {
+	/** Cached tiles, most recently used first */
+	std::list<TileEntry> tiles;
+	std::unordered_map<std::uint32_t, std::list<TileEntry>::iterator> index;
+	/** Value of Generation when the tiles were cached */
+	unsigned generation;
+
+	~ThreadTileCache()
+	{
+		Clear();
+	}
+
+	void Clear();
+};
+
+std::atomic<std::size_t> MaxTiles { 4 * 1024 * 1024 / sizeof(TileEntry) };
+/** Bumped to make every thread drop its cached tiles on its next lookup */
+std::atomic<unsigned> Generation;
+
+std::atomic<std::uint64_t> Hits;
+std::atomic<std::uint64_t> Misses;
+std::atomic<std::uint64_t> Evictions;
+/** Number of tiles cached by all threads */
+std::atomic<std::size_t> Entries;
+
+thread_local ThreadTileCache Cache;
+
+void ThreadTileCache::Clear()
+{
+	Entries -= tiles.size();
+	tiles.clear();
+	index.clear();
+}
+
+ThreadTileCache &GetCache()
+{
+	const unsigned generation = Generation.load(std::memory_order_acquire);
+	if (Cache.generation != generation) {
+		Cache.Clear();
+		Cache.generation = generation;
+	}
+	return Cache;
+}
+
+} // namespace
+
+CachedTile *FindCachedTile(std::uint32_t key)
+{
+	ThreadTileCache &cache = GetCache();
+	auto cached = cache.index.find(key);
+	if (cached == cache.index.end()) {
+		Misses.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Hits.fetch_add(1, std::memory_order_relaxed);
+	cache.tiles.splice(cache.tiles.begin(), cache.tiles, cached->second);
+	return &cached->second->tile;
+}
+
+CachedTile *AddCachedTile(std::uint32_t key)
+{
+	const std::size_t maxTiles = MaxTiles.load(std::memory_order_relaxed);
+	if (maxTiles == 0)
+		return nullptr;
+
+	ThreadTileCache &cache = GetCache();
+	if (cache.tiles.size() >= maxTiles) {
+		// Reuse the node of the least recently used tile
+		cache.index.erase(cache.tiles.back().key);
+		cache.tiles.splice(cache.tiles.begin(), cache.tiles, std::prev(cache.tiles.end()));
+		Evictions.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		cache.tiles.emplace_front();
+		Entries++;
+	}
+
+	cache.tiles.front().key = key;
+	cache.index[key] = cache.tiles.begin();
+	return &cache.tiles.front().tile;
+}
+
+void SetTileCacheBudget(std::size_t bytes)
+{
+	MaxTiles = bytes / sizeof(TileEntry);
+	InvalidateTileCache();
+}
+
+void InvalidateTileCache()
+{
+	Generation.fetch_add(1, std::memory_order_release);
+	// Release the memory of the calling thread right away, the others do so when they next draw
+	GetCache();
+}
+
+TileCacheStats GetTileCacheStats()
+{
+	TileCacheStats stats;
+	stats.hits = Hits;
+	stats.misses = Misses;
+	stats.evictions = Evictions;
+	stats.entries = Entries;
+	stats.bytes = stats.entries * sizeof(TileEntry);
+	return stats;
+}
+
+} // namespace devilution
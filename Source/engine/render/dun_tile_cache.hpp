@@ -0,0 +1,68 @@
+/**
+ * @file dun_tile_cache.hpp
+ *
+ * Interface of the cache of level tiles that are already decoded and lit.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "engine.h"
+
+namespace devilution {
+
+/**
+ * @brief A tile as RenderTile draws it when fully on screen, for a given light level and transparency
+ *
+ * Rows are stored top to bottom, bits of the masks map to pixels starting from the most significant bit.
+ */
+struct CachedTile {
+	std::uint8_t pixels[TILE_HEIGHT][TILE_WIDTH / 2];
+	/** Pixels that are copied to the screen */
+	std::uint32_t opaque[TILE_HEIGHT];
+	/** Pixels that are blended with the screen */
+	std::uint32_t blended[TILE_HEIGHT];
+	/** Start of the opaque pixels of rows where they form a single run */
+	std::uint8_t runStart[TILE_HEIGHT];
+	/** Length of the single run of opaque pixels, 0 if the row doesn't have one */
+	std::uint8_t runLength[TILE_HEIGHT];
+	/** Blended pixels darken the screen instead of mixing it with the tile */
+	bool darkBlend;
+};
+
+struct TileCacheStats {
+	std::uint64_t hits;
+	std::uint64_t misses;
+	std::uint64_t evictions;
+	std::size_t entries;
+	std::size_t bytes;
+};
+
+/**
+ * @brief Look up a tile in the cache of the calling thread and mark it as the most recently used one
+ * @return nullptr if the tile isn't cached
+ */
+CachedTile *FindCachedTile(std::uint32_t key);
+
+/**
+ * @brief Make room for a new tile, evicting the least recently used ones if the cache is full
+ * @return Storage for the tile to be filled in by the caller, nullptr if the cache is disabled
+ */
+CachedTile *AddCachedTile(std::uint32_t key);
+
+/**
+ * @brief Set the amount of memory the cached tiles of each render thread may take up, 0 disables the cache
+ */
+void SetTileCacheBudget(std::size_t bytes);
+
+/**
+ * @brief Drop the cached tiles of all threads, needed whenever the tile graphics or the light tables change
+ *
+ * Must not be called while other threads are drawing tiles.
+ */
+void InvalidateTileCache();
+
+TileCacheStats GetTileCacheStats();
+
+} // namespace devilution
@@ -0,0 +1,157 @@
+/**
+ * @file output_convert.cpp
+ *
+ * Implementation of the pixel loops that turn the 8-bit back buffer into the final output.
+ */
+#include "engine/render/output_convert.hpp"
+
+#include <initializer_list>
+
+#include <SDL.h>
+
+#include "utils/attributes.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OUTPUT_CONVERT_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OUTPUT_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace devilution {
+
+namespace {
+
+// Pixels are doubled from the end of the line so that the output may overlap the input.
+
+void DoublePixelsScalar(std::uint8_t *dst, const std::uint8_t *src, unsigned n)
+{
+	while (n-- > 0) {
+		const std::uint8_t pixel = src[n];
+		dst[2 * n + 1] = pixel;
+		dst[2 * n] = pixel;
+	}
+}
+
+void PalettedToRgb32Scalar(std::uint32_t *dst, const std::uint8_t *src, unsigned n, const std::uint32_t *colors)
+{
+	for (unsigned i = 0; i < n; i++)
+		dst[i] = colors[src[i]];
+}
+
+const OutputConvertKernels ScalarKernels = {
+	"scalar",
+	DoublePixelsScalar,
+	PalettedToRgb32Scalar,
+};
+
+#ifdef OUTPUT_CONVERT_X86
+
+DVL_ATTRIBUTE_TARGET("sse2")
+void DoublePixelsSSE2(std::uint8_t *dst, const std::uint8_t *src, unsigned n)
+{
+	while (n >= 16) {
+		n -= 16;
+		const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + n));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * n), _mm_unpacklo_epi8(pixels, pixels));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * n + 16), _mm_unpackhi_epi8(pixels, pixels));
+	}
+	DoublePixelsScalar(dst, src, n);
+}
+
+const OutputConvertKernels SSE2Kernels = {
+	"sse2",
+	DoublePixelsSSE2,
+	PalettedToRgb32Scalar,
+};
+
+DVL_ATTRIBUTE_TARGET("avx2")
+void PalettedToRgb32AVX2(std::uint32_t *dst, const std::uint8_t *src, unsigned n, const std::uint32_t *colors)
+{
+	const int *table = reinterpret_cast<const int *>(colors);
+	unsigned i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_i32gather_epi32(table, indices, 4));
+	}
+	PalettedToRgb32Scalar(dst + i, src + i, n - i, colors);
+}
+
+const OutputConvertKernels AVX2Kernels = {
+	"avx2",
+	DoublePixelsSSE2,
+	PalettedToRgb32AVX2,
+};
+
+#endif // OUTPUT_CONVERT_X86
+
+#ifdef OUTPUT_CONVERT_NEON
+
+void DoublePixelsNEON(std::uint8_t *dst, const std::uint8_t *src, unsigned n)
+{
+	while (n >= 16) {
+		n -= 16;
+		const uint8x16_t pixels = vld1q_u8(src + n);
+		const uint8x16x2_t doubled = vzipq_u8(pixels, pixels);
+		vst1q_u8(dst + 2 * n, doubled.val[0]);
+		vst1q_u8(dst + 2 * n + 16, doubled.val[1]);
+	}
+	DoublePixelsScalar(dst, src, n);
+}
+
+// NEON has no gather, the palette lookup stays scalar.
+const OutputConvertKernels NEONKernels = {
+	"neon",
+	DoublePixelsNEON,
+	PalettedToRgb32Scalar,
+};
+
+#endif // OUTPUT_CONVERT_NEON
+
+const OutputConvertKernels *SelectOutputConvertKernels()
+{
+	for (DunRenderIsa isa : { DunRenderIsa::AVX2, DunRenderIsa::NEON, DunRenderIsa::SSE2 }) {
+		const OutputConvertKernels *kernels = GetOutputConvertKernels(isa);
+		if (kernels != nullptr)
+			return kernels;
+	}
+	return &ScalarKernels;
+}
+
+} // namespace
+
+const OutputConvertKernels *ActiveOutputConvertKernels = SelectOutputConvertKernels();
+
+const OutputConvertKernels *GetOutputConvertKernels(DunRenderIsa isa)
+{
+	switch (isa) {
+	case DunRenderIsa::Scalar:
+		return &ScalarKernels;
+#ifdef OUTPUT_CONVERT_X86
+	case DunRenderIsa::SSE2:
+		return SDL_HasSSE2() ? &SSE2Kernels : nullptr;
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+	case DunRenderIsa::AVX2:
+		return SDL_HasAVX2() ? &AVX2Kernels : nullptr;
+#endif
+#endif
+#ifdef OUTPUT_CONVERT_NEON
+	case DunRenderIsa::NEON:
+		return &NEONKernels;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+void ConvertPalettedToRgb32(std::uint32_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch, int width, int height, const std::uint32_t *colors)
+{
+	for (int y = 0; y < height; y++) {
+		ActiveOutputConvertKernels->palettedToRgb32(dst, src, width, colors);
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,51 @@
+/**
+ * @file output_convert.hpp
+ *
+ * Interface of the pixel loops that turn the 8-bit back buffer into the final output.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "engine/render/dun_render_kernels.hpp"
+
+namespace devilution {
+
+struct OutputConvertKernels {
+	const char *name;
+	/**
+	 * @brief Write every source pixel twice
+	 * @param dst Output pixels, 2 * n of them. May overlap src as long as dst >= src
+	 * @param src Input pixels
+	 * @param n Number of input pixels
+	 */
+	void (*doublePixels)(std::uint8_t *dst, const std::uint8_t *src, unsigned n);
+	/**
+	 * @brief Look up the 32-bit color of every palette index
+	 * @param dst Output pixels
+	 * @param src Palette indices
+	 * @param n Number of pixels
+	 * @param colors 256 colors in the output pixel format
+	 */
+	void (*palettedToRgb32)(std::uint32_t *dst, const std::uint8_t *src, unsigned n, const std::uint32_t *colors);
+};
+
+/**
+ * @brief Get the output kernels for an instruction set
+ * @return nullptr if the build or the CPU doesn't support the instruction set
+ */
+const OutputConvertKernels *GetOutputConvertKernels(DunRenderIsa isa);
+
+/** The output kernels in use, the fastest ones supported by the CPU */
+extern const OutputConvertKernels *ActiveOutputConvertKernels;
+
+/**
+ * @brief Convert a rectangle of palette indices to 32-bit pixels
+ * @param dst Top left output pixel
+ * @param dstPitch Output line length in pixels
+ * @param src Top left palette index
+ * @param srcPitch Input line length in bytes
+ */
+void ConvertPalettedToRgb32(std::uint32_t *dst, int dstPitch, const std::uint8_t *src, int srcPitch, int width, int height, const std::uint32_t *colors);
+
+} // namespace devilution
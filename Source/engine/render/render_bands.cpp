@@ -0,0 +1,158 @@
+/**
+ * @file render_bands.cpp
+ *
+ * Implementation of the worker threads that draw horizontal bands of the screen in parallel.
+ */
+#include "engine/render/render_bands.hpp"
+
+#include <vector>
+
+#include <SDL.h>
+
+#include "appfat.h"
+#include "utils/stdcompat/algorithm.hpp"
+#include "utils/thread.h"
+
+namespace devilution {
+
+namespace {
+
+/** Upper limit on the number of render threads, more bands than this get too thin to be worth it */
+constexpr int MaxRenderThreads = 8;
+
+struct BandJob {
+	const CelOutputBuffer *out;
+	const std::function<void(const CelOutputBuffer &band, int top)> *draw;
+	int bands;
+	/** Next band to be picked up by a thread */
+	int nextBand;
+	int finishedBands;
+};
+
+SDL_mutex *sgpRenderMutex;
+/** Signaled when bands are ready to be drawn or the workers are shutting down */
+SDL_cond *sgpBandsQueued;
+/** Signaled when the last band of a job is drawn */
+SDL_cond *sgpBandsDrawn;
+std::vector<SDL_Thread *> sgRenderThreads;
+bool sgbRenderThreadsRunning;
+int sgnRenderThreads = 1;
+BandJob sgJob;
+
+/**
+ * @brief Draw bands of the current job until none are left, the mutex must be locked
+ */
+void DrawQueuedBands()
+{
+	while (sgJob.nextBand < sgJob.bands) {
+		const int band = sgJob.nextBand++;
+		SDL_UnlockMutex(sgpRenderMutex);
+
+		const CelOutputBuffer &out = *sgJob.out;
+		const int top = out.h() * band / sgJob.bands;
+		const int bottom = out.h() * (band + 1) / sgJob.bands;
+		if (bottom > top)
+			(*sgJob.draw)(out.subregionY(top, bottom - top), top);
+
+		SDL_LockMutex(sgpRenderMutex);
+		sgJob.finishedBands++;
+		if (sgJob.finishedBands == sgJob.bands)
+			SDL_CondSignal(sgpBandsDrawn);
+	}
+}
+
+unsigned int RenderThread(void * /*data*/)
+{
+	SDL_LockMutex(sgpRenderMutex);
+	while (sgbRenderThreadsRunning) {
+		if (sgJob.nextBand >= sgJob.bands) {
+			SDL_CondWait(sgpBandsQueued, sgpRenderMutex);
+			continue;
+		}
+		DrawQueuedBands();
+	}
+	SDL_UnlockMutex(sgpRenderMutex);
+
+	return 0;
+}
+
+void StartRenderThreads()
+{
+	sgpRenderMutex = SDL_CreateMutex();
+	sgpBandsQueued = SDL_CreateCond();
+	sgpBandsDrawn = SDL_CreateCond();
+	if (sgpRenderMutex == nullptr || sgpBandsQueued == nullptr || sgpBandsDrawn == nullptr)
+		ErrSdl();
+
+	sgJob = {};
+	sgbRenderThreadsRunning = true;
+	// The main thread draws bands as well
+	for (int i = 1; i < sgnRenderThreads; i++) {
+		SDL_threadID threadId;
+		sgRenderThreads.push_back(CreateThread(RenderThread, &threadId));
+	}
+}
+
+} // namespace
+
+void SetRenderThreadCount(int threads)
+{
+	FreeRenderThreads();
+
+	if (threads <= 0) {
+		threads = 1;
+#ifndef USE_SDL1
+		threads = SDL_GetCPUCount();
+#endif
+	}
+	sgnRenderThreads = clamp(threads, 1, MaxRenderThreads);
+}
+
+int GetRenderThreadCount()
+{
+	return sgnRenderThreads;
+}
+
+void DrawInBands(const CelOutputBuffer &out, const std::function<void(const CelOutputBuffer &band, int top)> &draw)
+{
+	if (sgnRenderThreads == 1) {
+		draw(out, 0);
+		return;
+	}
+
+	if (sgpRenderMutex == nullptr)
+		StartRenderThreads();
+
+	SDL_LockMutex(sgpRenderMutex);
+	sgJob = { &out, &draw, sgnRenderThreads, 0, 0 };
+	SDL_CondBroadcast(sgpBandsQueued);
+	DrawQueuedBands();
+	while (sgJob.finishedBands < sgJob.bands)
+		SDL_CondWait(sgpBandsDrawn, sgpRenderMutex);
+	sgJob = {};
+	SDL_UnlockMutex(sgpRenderMutex);
+}
+
+void FreeRenderThreads()
+{
+	if (sgpRenderMutex == nullptr)
+		return;
+
+	SDL_LockMutex(sgpRenderMutex);
+	sgbRenderThreadsRunning = false;
+	SDL_CondBroadcast(sgpBandsQueued);
+	SDL_UnlockMutex(sgpRenderMutex);
+
+	for (SDL_Thread *thread : sgRenderThreads)
+		SDL_WaitThread(thread, nullptr);
+	sgRenderThreads.clear();
+
+	SDL_DestroyCond(sgpBandsDrawn);
+	SDL_DestroyCond(sgpBandsQueued);
+	SDL_DestroyMutex(sgpRenderMutex);
+	sgpBandsDrawn = nullptr;
+	sgpBandsQueued = nullptr;
+	sgpRenderMutex = nullptr;
+}
+
+} // namespace devilution
@@ -0,0 +1,36 @@
+/**
+ * @file render_bands.hpp
+ *
+ * Interface of the worker threads that draw horizontal bands of the screen in parallel.
+ */
+#pragma once
+
+#include <functional>
+
+#include "engine.h"
+
+namespace devilution {
+
+/**
+ * @brief Set the number of threads that draw the level, including the main thread
+ * @param threads 1 draws everything on the main thread, 0 uses one thread per CPU core
+ */
+void SetRenderThreadCount(int threads);
+
+int GetRenderThreadCount();
+
+/**
+ * @brief Split the buffer into one horizontal band per render thread and draw them in parallel
+ *
+ * Returns once every band is drawn. The bands don't overlap, so they can be drawn in any order.
+ * @param out Target buffer
+ * @param draw Draws a band, given the band and the row of the target buffer it starts at
+ */
+void DrawInBands(const CelOutputBuffer &out, const std::function<void(const CelOutputBuffer &band, int top)> &draw);
+
+/**
+ * @brief Stop the render worker threads
+ */
+void FreeRenderThreads();
+
+} // namespace devilution
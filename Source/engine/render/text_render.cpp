@@ -5,9 +5,18 @@
  */
 #include "text_render.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "DiabloUI/ui_item.h"
 #include "cel_render.hpp"
 #include "engine.h"
+#include "engine/cel_header.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/point.hpp"
 #include "palette.h"
@@ -133,10 +142,90 @@ int LineHeights[3] = { 12, 38, 50 };
 /** Graphics for the fonts */
 std::array<std::optional<CelSprite>, 3> fonts;
 
+/** Height of the tallest glyph of each font */
+int GlyphHeights[3];
+
 uint8_t fontColorTableGold[256];
 uint8_t fontColorTableBlue[256];
 uint8_t fontColorTableRed[256];
 
+/** Memory the cached text rasters may take up */
+constexpr size_t TextCacheBudget = 512 * 1024;
+/** Longer strings, like the help and quest texts, are drawn glyph by glyph */
+constexpr size_t MaxCachedTextLength = 256;
+/** Rasters larger than this aren't cached */
+constexpr int MaxCachedTextArea = 64 * 1024;
+/** Number of strings remembered as drawn once without being cached */
+constexpr size_t TextSeenSlots = 256;
+
+/**
+ * @brief A string laid out and drawn once, so it can be copied to the screen on the next frames
+ */
+struct TextRaster {
+	/** Key of the cache entry: the text followed by everything else that affects the layout */
+	std::string key;
+	/** Top left corner of the pixels relative to the text rectangle */
+	Point origin;
+	int width;
+	std::vector<uint8_t> pixels;
+	/** Horizontal spans of drawn pixels */
+	struct Run {
+		uint16_t x;
+		uint16_t y;
+		uint16_t length;
+	};
+	std::vector<Run> runs;
+	/** Where the text cursor goes, relative to the text rectangle */
+	Point cursorPosition;
+	int charactersDrawn;
+
+	size_t Bytes() const
+	{
+		return sizeof(TextRaster) + key.size() + pixels.size() + runs.size() * sizeof(Run);
+	}
+};
+
+/** Most recently used first */
+std::list<TextRaster> TextCache;
+std::unordered_map<std::string, std::list<TextRaster>::iterator> TextCacheIndex;
+size_t TextCacheBytes;
+/** Key hashes of strings that missed the cache once, indexed by the hash */
+std::array<size_t, TextSeenSlots> TextSeen;
+
+void ClearTextCache()
+{
+	TextCacheIndex.clear();
+	TextCache.clear();
+	TextCacheBytes = 0;
+	TextSeen.fill(0);
+}
+
+/**
+ * @brief Measure the tallest frame of a font by decoding its CEL lines
+ */
+int GetMaxGlyphHeight(const CelSprite &font, int frames)
+{
+	int maxHeight = 0;
+	for (int frame = 1; frame <= frames; frame++) {
+		int nDataSize;
+		const auto *src = reinterpret_cast<const uint8_t *>(CelGetFrame(font.Data(), frame, &nDataSize));
+		const uint8_t *end = src + nDataSize;
+		int pixels = 0;
+		while (src < end) {
+			const auto control = static_cast<int8_t>(*src++);
+			if (control < 0) {
+				pixels -= control;
+			} else {
+				pixels += control;
+				src += control;
+			}
+		}
+		const int width = font.Width(frame);
+		maxHeight = std::max(maxHeight, (pixels + width - 1) / width);
+	}
+	return maxHeight;
+}
+
 void DrawChar(const CelOutputBuffer &out, Point position, GameFontTables size, int nCel, text_color color)
 {
 	switch (color) {
@@ -165,12 +254,23 @@ std::optional<CelSprite> pSPentSpn2Cels;
 
 void InitText()
 {
-	fonts[GameFontSmall] = LoadCel("CtrlPan\\SmalText.CEL", 13);
-	fonts[GameFontMed] = LoadCel("Data\\MedTextS.CEL", 22);
-	fonts[GameFontBig] = LoadCel("Data\\BigTGold.CEL", 46);
-
 	pSPentSpn2Cels = LoadCel("Data\\PentSpn2.CEL", 12);
 
+	InitText(LoadCel("CtrlPan\\SmalText.CEL", 13), LoadCel("Data\\MedTextS.CEL", 22), LoadCel("Data\\BigTGold.CEL", 46));
+}
+
+void InitText(CelSprite small, CelSprite medium, CelSprite big)
+{
+	fonts[GameFontSmall] = std::move(small);
+	fonts[GameFontMed] = std::move(medium);
+	fonts[GameFontBig] = std::move(big);
+
+	for (int size : { GameFontSmall, GameFontMed, GameFontBig }) {
+		const auto frames = static_cast<int>(LoadLE32(fonts[size]->Data()));
+		GlyphHeights[size] = GetMaxGlyphHeight(*fonts[size], frames);
+	}
+	ClearTextCache();
+
 	for (int i = 0; i < 256; i++) {
 		uint8_t pix = i;
 		if (pix >= PAL16_GRAY + 14)
@@ -268,29 +368,18 @@ void WordWrapGameString(char *text, size_t width, GameFontTables size, int spaci
 	}
 }
 
+namespace {
+
 /**
- * @todo replace Rectangle with cropped CelOutputBuffer
+ * @brief Work out where DrawString puts each glyph
+ * @param bottomMargin Lines starting at or below this are not drawn
+ * @param placeGlyph Called with the position and frame of every glyph in drawing order
+ * @param characterPosition Receives the position after the last character
+ * @return The number of characters laid out
  */
-int DrawString(const CelOutputBuffer &out, const char *text, const Rectangle &rect, uint16_t flags, int spacing, int lineHeight, bool drawTextCursor)
+template <typename PlaceGlyph>
+int LayoutString(const char *text, size_t textLength, const Rectangle &rect, int bottomMargin, uint16_t flags, GameFontTables size, int spacing, int lineHeight, Point &characterPosition, PlaceGlyph placeGlyph)
 {
-	GameFontTables size = GameFontSmall;
-	if ((flags & UIS_MED) != 0)
-		size = GameFontMed;
-	else if ((flags & UIS_HUGE) != 0)
-		size = GameFontBig;
-
-	text_color color = ColorGold;
-	if ((flags & UIS_SILVER) != 0)
-		color = ColorWhite;
-	else if ((flags & UIS_BLUE) != 0)
-		color = ColorBlue;
-	else if ((flags & UIS_RED) != 0)
-		color = ColorRed;
-	else if ((flags & UIS_BLACK) != 0)
-		color = ColorBlack;
-
-	const size_t textLength = strlen(text);
-
 	int charactersInLine = 0;
 	int lineWidth = 0;
 	if ((flags & (UIS_CENTER | UIS_RIGHT | UIS_FIT_SPACING)) != 0)
@@ -300,17 +389,13 @@ int DrawString(const CelOutputBuffer &out, const char *text, const Rectangle &re
 	if ((flags & UIS_FIT_SPACING) != 0)
 		spacing = AdjustSpacingToFitHorizontally(lineWidth, maxSpacing, charactersInLine, rect.size.width);
 
-	Point characterPosition = rect.position;
+	characterPosition = rect.position;
 	if ((flags & UIS_CENTER) != 0)
 		characterPosition.x += (rect.size.width - lineWidth) / 2;
 	else if ((flags & UIS_RIGHT) != 0)
 		characterPosition.x += rect.size.width - lineWidth;
 
 	int rightMargin = rect.position.x + rect.size.width;
-	int bottomMargin = rect.size.height != 0 ? rect.position.y + rect.size.height : out.h();
-
-	if (lineHeight == -1)
-		lineHeight = LineHeights[size];
 
 	unsigned i = 0;
 	for (; i < textLength; i++) {
@@ -334,16 +419,198 @@ int DrawString(const CelOutputBuffer &out, const char *text, const Rectangle &re
 				characterPosition.x += rect.size.width - lineWidth;
 		}
 		if (frame != 0) {
-			DrawChar(out, characterPosition, size, frame, color);
+			placeGlyph(characterPosition, frame);
 		}
 		if (text[i] != '\n')
 			characterPosition.x += symbolWidth + spacing;
 	}
+
+	return i;
+}
+
+/**
+ * @brief Lay out and draw a string into a new raster
+ * @return false if the string is too large to be worth caching
+ */
+bool BakeTextRaster(TextRaster &raster, const char *text, size_t textLength, const Size &rectSize, int availableHeight, uint16_t flags, GameFontTables size, text_color color, int spacing, int lineHeight)
+{
+	struct Glyph {
+		Point position;
+		uint8_t frame;
+	};
+	std::vector<Glyph> glyphs;
+	Point cursorPosition;
+	raster.charactersDrawn = LayoutString(text, textLength, { { 0, 0 }, rectSize }, availableHeight, flags, size, spacing, lineHeight, cursorPosition, [&glyphs](Point position, uint8_t frame) {
+		glyphs.push_back({ position, frame });
+	});
+	raster.cursorPosition = cursorPosition;
+	raster.origin = { 0, 0 };
+	raster.width = 0;
+	if (glyphs.empty())
+		return true;
+
+	// Glyphs are drawn upwards from their bottom left corner
+	int left = glyphs[0].position.x;
+	int right = left;
+	int top = glyphs[0].position.y;
+	int bottom = top;
+	for (const Glyph &glyph : glyphs) {
+		left = std::min(left, glyph.position.x);
+		right = std::max(right, glyph.position.x + fonts[size]->Width(glyph.frame));
+		top = std::min(top, glyph.position.y - GlyphHeights[size] + 1);
+		bottom = std::max(bottom, glyph.position.y + 1);
+	}
+	const int width = right - left;
+	const int height = bottom - top;
+	if (width * height > MaxCachedTextArea)
+		return false;
+
+	// Draw over two backgrounds, the pixels that differ are the ones no glyph covers
+	CelOutputBuffer canvas = CelOutputBuffer::Alloc(width, 2 * height);
+	const CelOutputBuffer overBlack = canvas.subregionY(0, height);
+	const CelOutputBuffer overWhite = canvas.subregionY(height, height);
+	for (int y = 0; y < height; y++) {
+		memset(overBlack.at(0, y), 0x00, width);
+		memset(overWhite.at(0, y), 0xFF, width);
+	}
+	for (const Glyph &glyph : glyphs) {
+		const Point position { glyph.position.x - left, glyph.position.y - top };
+		DrawChar(overBlack, position, size, glyph.frame, color);
+		DrawChar(overWhite, position, size, glyph.frame, color);
+	}
+
+	raster.origin = { left, top };
+	raster.width = width;
+	raster.pixels.resize(static_cast<size_t>(width) * height);
+	for (int y = 0; y < height; y++) {
+		const uint8_t *black = overBlack.at(0, y);
+		const uint8_t *white = overWhite.at(0, y);
+		memcpy(&raster.pixels[static_cast<size_t>(y) * width], black, width);
+		for (int x = 0; x < width;) {
+			if (black[x] != white[x]) {
+				x++;
+				continue;
+			}
+			const int start = x;
+			while (x < width && black[x] == white[x])
+				x++;
+			raster.runs.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(y), static_cast<uint16_t>(x - start) });
+		}
+	}
+	canvas.Free();
+	return true;
+}
+
+void DrawTextRaster(const CelOutputBuffer &out, Point position, const TextRaster &raster)
+{
+	const int originX = position.x + raster.origin.x;
+	const int originY = position.y + raster.origin.y;
+	for (const TextRaster::Run &run : raster.runs) {
+		const int y = originY + run.y;
+		if (y < 0 || y >= out.h())
+			continue;
+		const int x = std::max(originX + run.x, 0);
+		const int end = std::min(originX + run.x + run.length, out.w());
+		if (x >= end)
+			continue;
+		memcpy(out.at(x, y), &raster.pixels[static_cast<size_t>(run.y) * raster.width + (x - originX)], end - x);
+	}
+}
+
+/**
+ * @brief Find the raster of a string, laying it out and drawing it when it misses the cache a second time
+ * @return nullptr if the string isn't cached
+ */
+const TextRaster *GetTextRaster(const char *text, size_t textLength, const Size &rectSize, int availableHeight, uint16_t flags, GameFontTables size, text_color color, int spacing, int lineHeight)
+{
+	static std::string key;
+	const int params[] = { size, color, flags & (UIS_CENTER | UIS_RIGHT | UIS_FIT_SPACING), spacing, rectSize.width, availableHeight, lineHeight };
+	key.assign(text, textLength);
+	key.append(reinterpret_cast<const char *>(params), sizeof(params));
+
+	auto it = TextCacheIndex.find(key);
+	if (it != TextCacheIndex.end()) {
+		TextCache.splice(TextCache.begin(), TextCache, it->second);
+		return &*it->second;
+	}
+
+	// Strings that change every frame, like the FPS counter, would evict the cache without ever being drawn from it
+	const size_t hash = std::hash<std::string> {}(key);
+	size_t &seen = TextSeen[hash % TextSeenSlots];
+	if (seen != hash) {
+		seen = hash;
+		return nullptr;
+	}
+
+	TextRaster raster;
+	if (!BakeTextRaster(raster, text, textLength, rectSize, availableHeight, flags, size, color, spacing, lineHeight))
+		return nullptr;
+	raster.key = key;
+	TextCacheBytes += raster.Bytes();
+	TextCache.push_front(std::move(raster));
+	TextCacheIndex.emplace(TextCache.front().key, TextCache.begin());
+
+	while (TextCacheBytes > TextCacheBudget && TextCache.size() > 1) {
+		TextRaster &oldest = TextCache.back();
+		TextCacheBytes -= oldest.Bytes();
+		TextCacheIndex.erase(oldest.key);
+		TextCache.pop_back();
+	}
+
+	return &TextCache.front();
+}
+
+} // namespace
+
+/**
+ * @todo replace Rectangle with cropped CelOutputBuffer
+ */
+int DrawString(const CelOutputBuffer &out, const char *text, const Rectangle &rect, uint16_t flags, int spacing, int lineHeight, bool drawTextCursor)
+{
+	GameFontTables size = GameFontSmall;
+	if ((flags & UIS_MED) != 0)
+		size = GameFontMed;
+	else if ((flags & UIS_HUGE) != 0)
+		size = GameFontBig;
+
+	text_color color = ColorGold;
+	if ((flags & UIS_SILVER) != 0)
+		color = ColorWhite;
+	else if ((flags & UIS_BLUE) != 0)
+		color = ColorBlue;
+	else if ((flags & UIS_RED) != 0)
+		color = ColorRed;
+	else if ((flags & UIS_BLACK) != 0)
+		color = ColorBlack;
+
+	const size_t textLength = strlen(text);
+
+	int bottomMargin = rect.size.height != 0 ? rect.position.y + rect.size.height : out.h();
+
+	if (lineHeight == -1)
+		lineHeight = LineHeights[size];
+
+	// Black text depends on the current light table, it is drawn directly
+	const TextRaster *raster = nullptr;
+	if (color != ColorBlack && textLength <= MaxCachedTextLength)
+		raster = GetTextRaster(text, textLength, rect.size, bottomMargin - rect.position.y, flags, size, color, spacing, lineHeight);
+
+	Point characterPosition;
+	int charactersDrawn;
+	if (raster != nullptr) {
+		DrawTextRaster(out, rect.position, *raster);
+		characterPosition = rect.position + raster->cursorPosition;
+		charactersDrawn = raster->charactersDrawn;
+	} else {
+		charactersDrawn = LayoutString(text, textLength, rect, bottomMargin, flags, size, spacing, lineHeight, characterPosition, [&](Point position, uint8_t frame) {
+			DrawChar(out, position, size, frame, color);
+		});
+	}
 	if (drawTextCursor) {
 		CelDrawTo(out, characterPosition, *pSPentSpn2Cels, PentSpn2Spin());
 	}
 
-	return i;
+	return charactersDrawn;
 }
 
 int PentSpn2Spin()
@@ -27,6 +27,11 @@ extern std::optional<CelSprite> pSPentSpn2Cels;
 
 void InitText();
 
+/**
+ * @brief Set up text drawing with the given fonts instead of loading the game's
+ */
+void InitText(CelSprite small, CelSprite medium, CelSprite big);
+
 /**
  * @brief Calculate pixel width of first line of text, respecting kerning
  * @param text Text to check, will read until first eol or terminator
@@ -0,0 +1,119 @@
+/**
+ * @file sprite_cache.cpp
+ *
+ * Implementation of the cache that shares sprite data between monsters, players and missiles.
+ */
+#include "engine/sprite_cache.hpp"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "engine/load_file.hpp"
+
+namespace devilution {
+
+namespace {
+
+struct CachedSprite {
+	std::string key;
+	std::shared_ptr<byte[]> data;
+	size_t size;
+};
+
+/** Cached sprites, most recently used first */
+std::list<CachedSprite> Sprites;
+std::unordered_map<std::string, std::list<CachedSprite>::iterator> SpriteIndex;
+/** Combined size of all cached sprites, including the ones in use */
+size_t CacheSize;
+size_t CacheBudget = 64 * 1024 * 1024;
+
+#ifdef _DEBUG
+int CacheHits;
+int CacheMisses;
+#endif
+
+/**
+ * @brief Release the least recently used sprites that are not in use until the cache fits its budget
+ */
+void TrimCache()
+{
+	auto sprite = Sprites.end();
+	while (CacheSize > CacheBudget && sprite != Sprites.begin()) {
+		--sprite;
+		if (sprite->data.use_count() > 1)
+			continue;
+		CacheSize -= sprite->size;
+		SpriteIndex.erase(sprite->key);
+		sprite = Sprites.erase(sprite);
+	}
+}
+
+std::string GetSpriteKey(const char *path, const char *variant)
+{
+	std::string key = path;
+	if (variant != nullptr) {
+		key += '|';
+		key += variant;
+	}
+	return key;
+}
+
+} // namespace
+
+std::shared_ptr<byte[]> LoadSpriteData(const char *path, const char *variant, const std::function<void(byte *)> &prepare)
+{
+	std::string key = GetSpriteKey(path, variant);
+
+	auto cached = SpriteIndex.find(key);
+	if (cached != SpriteIndex.end()) {
+#ifdef _DEBUG
+		CacheHits++;
+#endif
+		Sprites.splice(Sprites.begin(), Sprites, cached->second);
+		return cached->second->data;
+	}
+
+#ifdef _DEBUG
+	CacheMisses++;
+#endif
+	size_t size;
+	std::shared_ptr<byte[]> data = LoadFileInMem(path, &size);
+	if (variant != nullptr && prepare)
+		prepare(data.get());
+
+	Sprites.push_front({ std::move(key), data, size });
+	SpriteIndex[Sprites.front().key] = Sprites.begin();
+	CacheSize += size;
+	TrimCache();
+
+	return data;
+}
+
+bool IsSpriteCached(const char *path, const char *variant)
+{
+	return SpriteIndex.count(GetSpriteKey(path, variant)) != 0;
+}
+
+void SetSpriteCacheBudget(size_t bytes)
+{
+	CacheBudget = bytes;
+	TrimCache();
+}
+
+void FreeSpriteCache()
+{
+	const size_t budget = CacheBudget;
+	CacheBudget = 0;
+	TrimCache();
+	CacheBudget = budget;
+}
+
+#ifdef _DEBUG
+SpriteCacheStats GetSpriteCacheStats()
+{
+	return { CacheHits, CacheMisses, Sprites.size(), CacheSize };
+}
+#endif
+
+} // namespace devilution
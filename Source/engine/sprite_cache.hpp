@@ -0,0 +1,55 @@
+/**
+ * @file sprite_cache.hpp
+ *
+ * Interface of the cache that shares sprite data between monsters, players and missiles.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "utils/stdcompat/cstddef.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Load a sprite file through the shared cache
+ *
+ * The data stays in memory for as long as a handle to it exists. After that it is kept around until the cache
+ * exceeds its budget, so it can be handed out again on the next level without reading it from the archives.
+ *
+ * @param path Path of the file
+ * @param variant Distinguishes copies of the same file that are modified after loading, such as recolored monsters
+ * @param prepare Applied once to newly loaded data of a variant before it is handed out
+ * @return Handle to the file content
+ */
+std::shared_ptr<byte[]> LoadSpriteData(const char *path, const char *variant = nullptr, const std::function<void(byte *)> &prepare = nullptr);
+
+/**
+ * @brief Check if a sprite file can be handed out without reading it from the archives
+ */
+bool IsSpriteCached(const char *path, const char *variant = nullptr);
+
+/**
+ * @brief Set the amount of memory the cached sprites may take up, unused ones are released to stay within it
+ */
+void SetSpriteCacheBudget(size_t bytes);
+
+/**
+ * @brief Release all sprites that are not in use
+ */
+void FreeSpriteCache();
+
+#ifdef _DEBUG
+struct SpriteCacheStats {
+	int hits;
+	int misses;
+	size_t entries;
+	size_t bytes;
+};
+
+SpriteCacheStats GetSpriteCacheStats();
+#endif
+
+} // namespace devilution
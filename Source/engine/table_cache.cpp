@@ -0,0 +1,130 @@
+/**
+ * @file table_cache.cpp
+ *
+ * Implementation of the on-disk cache for lookup tables derived from game data.
+ */
+#include "engine/table_cache.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+
+namespace devilution {
+
+namespace {
+
+/** Bump when the layout of the file or the way any cached table is generated changes */
+constexpr std::uint32_t TableCacheVersion = 1;
+constexpr std::size_t HeaderSize = 24;
+
+struct FileCloser {
+	void operator()(FILE *file) const
+	{
+		std::fclose(file);
+	}
+};
+
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+std::string GetTablePath(const char *name, std::uint64_t key)
+{
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), "%s_%016llx.tbl", name, static_cast<unsigned long long>(key));
+	return paths::ConfigPath() + fileName;
+}
+
+void WriteLE32(std::uint8_t *b, std::uint32_t value)
+{
+	b[0] = value & 0xFF;
+	b[1] = (value >> 8) & 0xFF;
+	b[2] = (value >> 16) & 0xFF;
+	b[3] = value >> 24;
+}
+
+/**
+ * @brief Fill in the header: magic, version, key, size of the table and a hash of its contents
+ */
+void WriteHeader(std::uint8_t *header, std::uint64_t key, const void *data, std::size_t size)
+{
+	const std::uint64_t checksum = HashTableInput(TableKeySeed, data, size);
+	header[0] = 'D';
+	header[1] = 'V';
+	header[2] = 'L';
+	header[3] = 'T';
+	WriteLE32(&header[4], TableCacheVersion);
+	WriteLE32(&header[8], static_cast<std::uint32_t>(key));
+	WriteLE32(&header[12], static_cast<std::uint32_t>(key >> 32));
+	WriteLE32(&header[16], static_cast<std::uint32_t>(size));
+	WriteLE32(&header[20], static_cast<std::uint32_t>(checksum ^ (checksum >> 32)));
+}
+
+} // namespace
+
+std::uint64_t HashTableInput(std::uint64_t key, const void *data, std::size_t size)
+{
+	const auto *bytes = static_cast<const std::uint8_t *>(data);
+	for (std::size_t i = 0; i < size; i++) {
+		key ^= bytes[i];
+		key *= 1099511628211ULL;
+	}
+	return key;
+}
+
+bool LoadCachedTable(const char *name, std::uint64_t key, void *data, std::size_t size)
+{
+	FilePtr file { FOpen(GetTablePath(name, key).c_str(), "rb") };
+	if (file == nullptr)
+		return false;
+
+	std::uint8_t header[HeaderSize];
+	if (std::fread(header, HeaderSize, 1, file.get()) != 1)
+		return false;
+	if (std::fread(data, size, 1, file.get()) != 1)
+		return false;
+
+	std::uint8_t expected[HeaderSize];
+	WriteHeader(expected, key, data, size);
+	for (std::size_t i = 0; i < HeaderSize; i++) {
+		if (header[i] != expected[i]) {
+			Log("Ignoring outdated or damaged table cache {}", GetTablePath(name, key));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void StoreCachedTable(const char *name, std::uint64_t key, const void *data, std::size_t size)
+{
+	const std::string path = GetTablePath(name, key);
+	const std::string tempPath = path + ".tmp";
+
+	std::uint8_t header[HeaderSize];
+	WriteHeader(header, key, data, size);
+
+	FilePtr file { FOpen(tempPath.c_str(), "wb") };
+	if (file == nullptr) {
+		Log("Failed to create table cache {}", tempPath);
+		return;
+	}
+	bool written = std::fwrite(header, HeaderSize, 1, file.get()) == 1 && std::fwrite(data, size, 1, file.get()) == 1;
+	written = std::fclose(file.release()) == 0 && written;
+
+	if (!written || !RenameFile(tempPath.c_str(), path.c_str())) {
+		Log("Failed to write table cache {}", path);
+		RemoveFile(tempPath.c_str());
+	}
+}
+
+void RemoveCachedTable(const char *name, std::uint64_t key)
+{
+	const std::string path = GetTablePath(name, key);
+	if (FileExists(path.c_str()))
+		RemoveFile(path.c_str());
+}
+
+} // namespace devilution
@@ -0,0 +1,43 @@
+/**
+ * @file table_cache.hpp
+ *
+ * Interface of the on-disk cache for lookup tables derived from game data.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/** @brief Starting value for HashTableInput */
+constexpr std::uint64_t TableKeySeed = 14695981039346656037ULL;
+
+/**
+ * @brief Mix some of the inputs of a table into its cache key
+ * @param key TableKeySeed or the result of hashing the previous inputs
+ */
+std::uint64_t HashTableInput(std::uint64_t key, const void *data, std::size_t size);
+
+/**
+ * @brief Read a table that was saved by StoreCachedTable
+ * @param name Kind of table, used in the file name
+ * @param key Hash of everything the table is generated from
+ * @return false if no intact table is cached for the key, data may be partially overwritten in that case
+ */
+bool LoadCachedTable(const char *name, std::uint64_t key, void *data, std::size_t size);
+
+/**
+ * @brief Save a table to the config folder so LoadCachedTable can skip generating it next time
+ *
+ * The table is written to a temporary file first and then moved in place, so an interrupted write never leaves
+ * a truncated table behind. Failures are logged and otherwise ignored.
+ */
+void StoreCachedTable(const char *name, std::uint64_t key, const void *data, std::size_t size);
+
+/**
+ * @brief Delete a table saved by StoreCachedTable, if there is one
+ */
+void RemoveCachedTable(const char *name, std::uint64_t key);
+
+} // namespace devilution
@@ -11,23 +11,16 @@
 
 namespace devilution {
 
-/** Contains the tile IDs of the map. */
-uint8_t dungeon[DMAXX][DMAXY];
-/** Contains a backup of the tile IDs of the map. */
-uint8_t pdungeon[DMAXX][DMAXY];
-char dflags[DMAXX][DMAXY];
-/** Specifies the active set level X-coordinate of the map. */
-int setpc_x;
-/** Specifies the active set level Y-coordinate of the map. */
-int setpc_y;
-/** Specifies the width of the active set level of the map. */
-int setpc_w;
-/** Specifies the height of the active set level of the map. */
-int setpc_h;
-/** Contains the contents of the single player quest DUN file. */
-std::unique_ptr<uint16_t[]> pSetPiece;
-/** Specifies whether a single player quest DUN has been loaded. */
-bool setloadflag;
+DungeonContext ActiveDungeon;
+uint8_t (&dungeon)[DMAXX][DMAXY] = ActiveDungeon.dungeon;
+uint8_t (&pdungeon)[DMAXX][DMAXY] = ActiveDungeon.pdungeon;
+char (&dflags)[DMAXX][DMAXY] = ActiveDungeon.dflags;
+int &setpc_x = ActiveDungeon.setpc_x;
+int &setpc_y = ActiveDungeon.setpc_y;
+int &setpc_w = ActiveDungeon.setpc_w;
+int &setpc_h = ActiveDungeon.setpc_h;
+std::unique_ptr<uint16_t[]> &pSetPiece = ActiveDungeon.pSetPiece;
+bool &setloadflag = ActiveDungeon.setloadflag;
 std::optional<CelSprite> pSpecialCels;
 /** Specifies the tile definitions of the active dungeon type; (e.g. levels/l1data/l1.til). */
 std::unique_ptr<MegaTile[]> pMegaTiles;
@@ -39,49 +32,36 @@ std::array<bool, MAXTILES + 1> nSolidTable;
 std::array<bool, MAXTILES + 1> nTransTable;
 std::array<bool, MAXTILES + 1> nMissileTable;
 std::array<bool, MAXTILES + 1> nTrapTable;
-/** Specifies the minimum X-coordinate of the map. */
-int dminx;
-/** Specifies the minimum Y-coordinate of the map. */
-int dminy;
-/** Specifies the maximum X-coordinate of the map. */
-int dmaxx;
-/** Specifies the maximum Y-coordinate of the map. */
-int dmaxy;
-/** Specifies the active dungeon type of the current game. */
-dungeon_type leveltype;
-/** Specifies the active dungeon level of the current game. */
-BYTE currlevel;
+int &dminx = ActiveDungeon.dminx;
+int &dminy = ActiveDungeon.dminy;
+int &dmaxx = ActiveDungeon.dmaxx;
+int &dmaxy = ActiveDungeon.dmaxy;
+dungeon_type &leveltype = ActiveDungeon.leveltype;
+BYTE &currlevel = ActiveDungeon.currlevel;
 bool setlevel;
 /** Specifies the active quest level of the current game. */
 _setlevels setlvlnum;
 /** Level type of the active quest level */
 dungeon_type setlvltype;
-/** Specifies the player viewpoint X-coordinate of the map. */
-int ViewX;
-/** Specifies the player viewpoint Y-coordinate of the map. */
-int ViewY;
+int &ViewX = ActiveDungeon.ViewX;
+int &ViewY = ActiveDungeon.ViewY;
 int ViewBX;
 int ViewBY;
 int ViewDX;
 int ViewDY;
 ScrollStruct ScrollInfo;
-/** Specifies the level viewpoint X-coordinate of the map. */
-int LvlViewX;
-/** Specifies the level viewpoint Y-coordinate of the map. */
-int LvlViewY;
+int &LvlViewX = ActiveDungeon.LvlViewX;
+int &LvlViewY = ActiveDungeon.LvlViewY;
 int MicroTileLen;
-char TransVal;
-/** Specifies the active transparency indices. */
-bool TransList[256];
-/** Contains the piece IDs of each tile on the map. */
-int dPiece[MAXDUNX][MAXDUNY];
+char &TransVal = ActiveDungeon.TransVal;
+bool (&TransList)[256] = ActiveDungeon.TransList;
+int (&dPiece)[MAXDUNX][MAXDUNY] = ActiveDungeon.dPiece;
 /** Specifies the dungeon piece information for a given coordinate and block number. */
 MICROS dpiece_defs_map_2[MAXDUNX][MAXDUNY];
-/** Specifies the transparency at each coordinate of the map. */
-int8_t dTransVal[MAXDUNX][MAXDUNY];
+int8_t (&dTransVal)[MAXDUNX][MAXDUNY] = ActiveDungeon.dTransVal;
 char dLight[MAXDUNX][MAXDUNY];
 char dPreLight[MAXDUNX][MAXDUNY];
-int8_t dFlags[MAXDUNX][MAXDUNY];
+int8_t (&dFlags)[MAXDUNX][MAXDUNY] = ActiveDungeon.dFlags;
 /** Contains the player numbers (players array indices) of the map. */
 int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
@@ -102,15 +82,10 @@ char dObject[MAXDUNX][MAXDUNY];
 /** Contains the item numbers (items array indices) of the map. */
 int8_t dItem[MAXDUNX][MAXDUNY];
 /** Contains the missile numbers (missiles array indices) of the map. */
-char dMissile[MAXDUNX][MAXDUNY];
-/**
- * Contains the arch frame numbers of the map from the special tileset
- * (e.g. "levels/l1data/l1s.cel"). Note, the special tileset of Tristram (i.e.
- * "levels/towndata/towns.cel") contains trees rather than arches.
- */
-char dSpecial[MAXDUNX][MAXDUNY];
-int themeCount;
-THEME_LOC themeLoc[MAXTHEMES];
+int16_t dMissile[MAXDUNX][MAXDUNY];
+char (&dSpecial)[MAXDUNX][MAXDUNY] = ActiveDungeon.dSpecial;
+int &themeCount = ActiveDungeon.themeCount;
+THEME_LOC (&themeLoc)[MAXTHEMES] = ActiveDungeon.themeLoc;
 
 std::unique_ptr<uint8_t[]> LoadLevelSOLData(size_t &tileCount)
 {
@@ -182,14 +157,20 @@ void SetDungeonMicros()
 	}
 }
 
-void DRLG_InitTrans()
+void DRLG_InitFlags(DungeonContext &ctx)
+{
+	memset(ctx.dFlags, 0, sizeof(ctx.dFlags));
+	memset(ctx.dSpecial, 0, sizeof(ctx.dSpecial));
+}
+
+void DRLG_InitTrans(DungeonContext &ctx)
 {
-	memset(dTransVal, 0, sizeof(dTransVal));
-	memset(TransList, 0, sizeof(TransList));
-	TransVal = 1;
+	memset(ctx.dTransVal, 0, sizeof(ctx.dTransVal));
+	memset(ctx.TransList, 0, sizeof(ctx.TransList));
+	ctx.TransVal = 1;
 }
 
-void DRLG_MRectTrans(int x1, int y1, int x2, int y2)
+void DRLG_MRectTrans(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int i, j;
 
@@ -200,31 +181,31 @@ void DRLG_MRectTrans(int x1, int y1, int x2, int y2)
 
 	for (j = y1; j <= y2; j++) {
 		for (i = x1; i <= x2; i++) {
-			dTransVal[i][j] = TransVal;
+			ctx.dTransVal[i][j] = ctx.TransVal;
 		}
 	}
 
-	TransVal++;
+	ctx.TransVal++;
 }
 
-void DRLG_RectTrans(int x1, int y1, int x2, int y2)
+void DRLG_RectTrans(DungeonContext &ctx, int x1, int y1, int x2, int y2)
 {
 	int i, j;
 
 	for (j = y1; j <= y2; j++) {
 		for (i = x1; i <= x2; i++) {
-			dTransVal[i][j] = TransVal;
+			ctx.dTransVal[i][j] = ctx.TransVal;
 		}
 	}
-	TransVal++;
+	ctx.TransVal++;
 }
 
-void DRLG_CopyTrans(int sx, int sy, int dx, int dy)
+void DRLG_CopyTrans(DungeonContext &ctx, int sx, int sy, int dx, int dy)
 {
-	dTransVal[dx][dy] = dTransVal[sx][sy];
+	ctx.dTransVal[dx][dy] = ctx.dTransVal[sx][sy];
 }
 
-void DRLG_ListTrans(int num, BYTE *List)
+void DRLG_ListTrans(DungeonContext &ctx, int num, BYTE *List)
 {
 	int i;
 	BYTE x1, y1, x2, y2;
@@ -234,11 +215,11 @@ void DRLG_ListTrans(int num, BYTE *List)
 		y1 = *List++;
 		x2 = *List++;
 		y2 = *List++;
-		DRLG_RectTrans(x1, y1, x2, y2);
+		DRLG_RectTrans(ctx, x1, y1, x2, y2);
 	}
 }
 
-void DRLG_AreaTrans(int num, BYTE *List)
+void DRLG_AreaTrans(DungeonContext &ctx, int num, BYTE *List)
 {
 	int i;
 	BYTE x1, y1, x2, y2;
@@ -248,37 +229,37 @@ void DRLG_AreaTrans(int num, BYTE *List)
 		y1 = *List++;
 		x2 = *List++;
 		y2 = *List++;
-		DRLG_RectTrans(x1, y1, x2, y2);
-		TransVal--;
+		DRLG_RectTrans(ctx, x1, y1, x2, y2);
+		ctx.TransVal--;
 	}
-	TransVal++;
+	ctx.TransVal++;
 }
 
-void DRLG_InitSetPC()
+void DRLG_InitSetPC(DungeonContext &ctx)
 {
-	setpc_x = 0;
-	setpc_y = 0;
-	setpc_w = 0;
-	setpc_h = 0;
+	ctx.setpc_x = 0;
+	ctx.setpc_y = 0;
+	ctx.setpc_w = 0;
+	ctx.setpc_h = 0;
 }
 
-void DRLG_SetPC()
+void DRLG_SetPC(DungeonContext &ctx)
 {
 	int i, j, x, y, w, h;
 
-	w = 2 * setpc_w;
-	h = 2 * setpc_h;
-	x = 2 * setpc_x + 16;
-	y = 2 * setpc_y + 16;
+	w = 2 * ctx.setpc_w;
+	h = 2 * ctx.setpc_h;
+	x = 2 * ctx.setpc_x + 16;
+	y = 2 * ctx.setpc_y + 16;
 
 	for (j = 0; j < h; j++) {
 		for (i = 0; i < w; i++) {
-			dFlags[i + x][j + y] |= BFLAG_POPULATED;
+			ctx.dFlags[i + x][j + y] |= BFLAG_POPULATED;
 		}
 	}
 }
 
-void Make_SetPC(int x, int y, int w, int h)
+void Make_SetPC(DungeonContext &ctx, int x, int y, int w, int h)
 {
 	int i, j, dx, dy, dh, dw;
 
@@ -289,12 +270,12 @@ void Make_SetPC(int x, int y, int w, int h)
 
 	for (j = 0; j < dh; j++) {
 		for (i = 0; i < dw; i++) {
-			dFlags[i + dx][j + dy] |= BFLAG_POPULATED;
+			ctx.dFlags[i + dx][j + dy] |= BFLAG_POPULATED;
 		}
 	}
 }
 
-bool DRLG_WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, int *width, int *height)
+bool DRLG_WillThemeRoomFit(DungeonContext &ctx, int floor, int x, int y, int minSize, int maxSize, int *width, int *height)
 {
 	int ii, xx, yy;
 	int xSmallest, ySmallest;
@@ -311,7 +292,7 @@ bool DRLG_WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, in
 	if (x > DMAXX - maxSize || y > DMAXY - maxSize) {
 		return false;
 	}
-	if (!SkipThemeRoom(x, y)) {
+	if (!SkipThemeRoom(ctx, x, y)) {
 		return false;
 	}
 
@@ -321,7 +302,7 @@ bool DRLG_WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, in
 	for (ii = 0; ii < maxSize; ii++) {
 		if (xFlag) {
 			for (xx = x; xx < x + maxSize; xx++) {
-				if (dungeon[xx][y + ii] != floor) {
+				if (ctx.dungeon[xx][y + ii] != floor) {
 					if (xx >= minSize) {
 						break;
 					}
@@ -337,7 +318,7 @@ bool DRLG_WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, in
 		}
 		if (yFlag) {
 			for (yy = y; yy < y + maxSize; yy++) {
-				if (dungeon[x + ii][yy] != floor) {
+				if (ctx.dungeon[x + ii][yy] != floor) {
 					if (yy >= minSize) {
 						break;
 					}
@@ -379,117 +360,117 @@ bool DRLG_WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, in
 	return true;
 }
 
-void DRLG_CreateThemeRoom(int themeIndex)
+void DRLG_CreateThemeRoom(DungeonContext &ctx, int themeIndex)
 {
 	int xx, yy;
-	const int lx = themeLoc[themeIndex].x;
-	const int ly = themeLoc[themeIndex].y;
-	const int hx = lx + themeLoc[themeIndex].width;
-	const int hy = ly + themeLoc[themeIndex].height;
+	const int lx = ctx.themeLoc[themeIndex].x;
+	const int ly = ctx.themeLoc[themeIndex].y;
+	const int hx = lx + ctx.themeLoc[themeIndex].width;
+	const int hy = ly + ctx.themeLoc[themeIndex].height;
 
 	for (yy = ly; yy < hy; yy++) {
 		for (xx = lx; xx < hx; xx++) {
-			if (leveltype == DTYPE_CATACOMBS) {
+			if (ctx.leveltype == DTYPE_CATACOMBS) {
 				if (yy == ly || yy == hy - 1) {
-					dungeon[xx][yy] = 2;
+					ctx.dungeon[xx][yy] = 2;
 				} else if (xx == lx || xx == hx - 1) {
-					dungeon[xx][yy] = 1;
+					ctx.dungeon[xx][yy] = 1;
 				} else {
-					dungeon[xx][yy] = 3;
+					ctx.dungeon[xx][yy] = 3;
 				}
 			}
-			if (leveltype == DTYPE_CAVES) {
+			if (ctx.leveltype == DTYPE_CAVES) {
 				if (yy == ly || yy == hy - 1) {
-					dungeon[xx][yy] = 134;
+					ctx.dungeon[xx][yy] = 134;
 				} else if (xx == lx || xx == hx - 1) {
-					dungeon[xx][yy] = 137;
+					ctx.dungeon[xx][yy] = 137;
 				} else {
-					dungeon[xx][yy] = 7;
+					ctx.dungeon[xx][yy] = 7;
 				}
 			}
-			if (leveltype == DTYPE_HELL) {
+			if (ctx.leveltype == DTYPE_HELL) {
 				if (yy == ly || yy == hy - 1) {
-					dungeon[xx][yy] = 2;
+					ctx.dungeon[xx][yy] = 2;
 				} else if (xx == lx || xx == hx - 1) {
-					dungeon[xx][yy] = 1;
+					ctx.dungeon[xx][yy] = 1;
 				} else {
-					dungeon[xx][yy] = 6;
+					ctx.dungeon[xx][yy] = 6;
 				}
 			}
 		}
 	}
 
-	if (leveltype == DTYPE_CATACOMBS) {
-		dungeon[lx][ly] = 8;
-		dungeon[hx - 1][ly] = 7;
-		dungeon[lx][hy - 1] = 9;
-		dungeon[hx - 1][hy - 1] = 6;
+	if (ctx.leveltype == DTYPE_CATACOMBS) {
+		ctx.dungeon[lx][ly] = 8;
+		ctx.dungeon[hx - 1][ly] = 7;
+		ctx.dungeon[lx][hy - 1] = 9;
+		ctx.dungeon[hx - 1][hy - 1] = 6;
 	}
-	if (leveltype == DTYPE_CAVES) {
-		dungeon[lx][ly] = 150;
-		dungeon[hx - 1][ly] = 151;
-		dungeon[lx][hy - 1] = 152;
-		dungeon[hx - 1][hy - 1] = 138;
+	if (ctx.leveltype == DTYPE_CAVES) {
+		ctx.dungeon[lx][ly] = 150;
+		ctx.dungeon[hx - 1][ly] = 151;
+		ctx.dungeon[lx][hy - 1] = 152;
+		ctx.dungeon[hx - 1][hy - 1] = 138;
 	}
-	if (leveltype == DTYPE_HELL) {
-		dungeon[lx][ly] = 9;
-		dungeon[hx - 1][ly] = 16;
-		dungeon[lx][hy - 1] = 15;
-		dungeon[hx - 1][hy - 1] = 12;
+	if (ctx.leveltype == DTYPE_HELL) {
+		ctx.dungeon[lx][ly] = 9;
+		ctx.dungeon[hx - 1][ly] = 16;
+		ctx.dungeon[lx][hy - 1] = 15;
+		ctx.dungeon[hx - 1][hy - 1] = 12;
 	}
 
-	if (leveltype == DTYPE_CATACOMBS) {
+	if (ctx.leveltype == DTYPE_CATACOMBS) {
 		switch (GenerateRnd(2)) {
 		case 0:
-			dungeon[hx - 1][(ly + hy) / 2] = 4;
+			ctx.dungeon[hx - 1][(ly + hy) / 2] = 4;
 			break;
 		case 1:
-			dungeon[(lx + hx) / 2][hy - 1] = 5;
+			ctx.dungeon[(lx + hx) / 2][hy - 1] = 5;
 			break;
 		}
 	}
-	if (leveltype == DTYPE_CAVES) {
+	if (ctx.leveltype == DTYPE_CAVES) {
 		switch (GenerateRnd(2)) {
 		case 0:
-			dungeon[hx - 1][(ly + hy) / 2] = 147;
+			ctx.dungeon[hx - 1][(ly + hy) / 2] = 147;
 			break;
 		case 1:
-			dungeon[(lx + hx) / 2][hy - 1] = 146;
+			ctx.dungeon[(lx + hx) / 2][hy - 1] = 146;
 			break;
 		}
 	}
-	if (leveltype == DTYPE_HELL) {
+	if (ctx.leveltype == DTYPE_HELL) {
 		switch (GenerateRnd(2)) {
 		case 0:
 			yy = (ly + hy) / 2;
-			dungeon[hx - 1][yy - 1] = 53;
-			dungeon[hx - 1][yy] = 6;
-			dungeon[hx - 1][yy + 1] = 52;
-			dungeon[hx - 2][yy - 1] = 54;
+			ctx.dungeon[hx - 1][yy - 1] = 53;
+			ctx.dungeon[hx - 1][yy] = 6;
+			ctx.dungeon[hx - 1][yy + 1] = 52;
+			ctx.dungeon[hx - 2][yy - 1] = 54;
 			break;
 		case 1:
 			xx = (lx + hx) / 2;
-			dungeon[xx - 1][hy - 1] = 57;
-			dungeon[xx][hy - 1] = 6;
-			dungeon[xx + 1][hy - 1] = 56;
-			dungeon[xx][hy - 2] = 59;
-			dungeon[xx - 1][hy - 2] = 58;
+			ctx.dungeon[xx - 1][hy - 1] = 57;
+			ctx.dungeon[xx][hy - 1] = 6;
+			ctx.dungeon[xx + 1][hy - 1] = 56;
+			ctx.dungeon[xx][hy - 2] = 59;
+			ctx.dungeon[xx - 1][hy - 2] = 58;
 			break;
 		}
 	}
 }
 
-void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize)
+void DRLG_PlaceThemeRooms(DungeonContext &ctx, int minSize, int maxSize, int floor, int freq, bool rndSize)
 {
 	int i, j;
 	int themeW, themeH;
 	int rv2, min, max;
 
-	themeCount = 0;
-	memset(themeLoc, 0, sizeof(*themeLoc));
+	ctx.themeCount = 0;
+	memset(ctx.themeLoc, 0, sizeof(*ctx.themeLoc));
 	for (j = 0; j < DMAXY; j++) {
 		for (i = 0; i < DMAXX; i++) {
-			if (dungeon[i][j] == floor && GenerateRnd(freq) == 0 && DRLG_WillThemeRoomFit(floor, i, j, minSize, maxSize, &themeW, &themeH)) {
+			if (ctx.dungeon[i][j] == floor && GenerateRnd(freq) == 0 && DRLG_WillThemeRoomFit(ctx, floor, i, j, minSize, maxSize, &themeW, &themeH)) {
 				if (rndSize) {
 					min = minSize - 2;
 					max = maxSize - 2;
@@ -504,47 +485,47 @@ void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rn
 					else
 						themeH = min;
 				}
-				themeLoc[themeCount].x = i + 1;
-				themeLoc[themeCount].y = j + 1;
-				themeLoc[themeCount].width = themeW;
-				themeLoc[themeCount].height = themeH;
-				if (leveltype == DTYPE_CAVES)
-					DRLG_RectTrans(2 * i + 20, 2 * j + 20, 2 * (i + themeW) + 15, 2 * (j + themeH) + 15);
+				ctx.themeLoc[ctx.themeCount].x = i + 1;
+				ctx.themeLoc[ctx.themeCount].y = j + 1;
+				ctx.themeLoc[ctx.themeCount].width = themeW;
+				ctx.themeLoc[ctx.themeCount].height = themeH;
+				if (ctx.leveltype == DTYPE_CAVES)
+					DRLG_RectTrans(ctx, 2 * i + 20, 2 * j + 20, 2 * (i + themeW) + 15, 2 * (j + themeH) + 15);
 				else
-					DRLG_MRectTrans(i + 1, j + 1, i + themeW, j + themeH);
-				themeLoc[themeCount].ttval = TransVal - 1;
-				DRLG_CreateThemeRoom(themeCount);
-				themeCount++;
+					DRLG_MRectTrans(ctx, i + 1, j + 1, i + themeW, j + themeH);
+				ctx.themeLoc[ctx.themeCount].ttval = ctx.TransVal - 1;
+				DRLG_CreateThemeRoom(ctx, ctx.themeCount);
+				ctx.themeCount++;
 			}
 		}
 	}
 }
 
-void DRLG_HoldThemeRooms()
+void DRLG_HoldThemeRooms(DungeonContext &ctx)
 {
 	int i, x, y, xx, yy;
 
-	for (i = 0; i < themeCount; i++) {
-		for (y = themeLoc[i].y; y < themeLoc[i].y + themeLoc[i].height - 1; y++) {
-			for (x = themeLoc[i].x; x < themeLoc[i].x + themeLoc[i].width - 1; x++) {
+	for (i = 0; i < ctx.themeCount; i++) {
+		for (y = ctx.themeLoc[i].y; y < ctx.themeLoc[i].y + ctx.themeLoc[i].height - 1; y++) {
+			for (x = ctx.themeLoc[i].x; x < ctx.themeLoc[i].x + ctx.themeLoc[i].width - 1; x++) {
 				xx = 2 * x + 16;
 				yy = 2 * y + 16;
-				dFlags[xx][yy] |= BFLAG_POPULATED;
-				dFlags[xx + 1][yy] |= BFLAG_POPULATED;
-				dFlags[xx][yy + 1] |= BFLAG_POPULATED;
-				dFlags[xx + 1][yy + 1] |= BFLAG_POPULATED;
+				ctx.dFlags[xx][yy] |= BFLAG_POPULATED;
+				ctx.dFlags[xx + 1][yy] |= BFLAG_POPULATED;
+				ctx.dFlags[xx][yy + 1] |= BFLAG_POPULATED;
+				ctx.dFlags[xx + 1][yy + 1] |= BFLAG_POPULATED;
 			}
 		}
 	}
 }
 
-bool SkipThemeRoom(int x, int y)
+bool SkipThemeRoom(DungeonContext &ctx, int x, int y)
 {
 	int i;
 
-	for (i = 0; i < themeCount; i++) {
-		if (x >= themeLoc[i].x - 2 && x <= themeLoc[i].x + themeLoc[i].width + 2
-		    && y >= themeLoc[i].y - 2 && y <= themeLoc[i].y + themeLoc[i].height + 2)
+	for (i = 0; i < ctx.themeCount; i++) {
+		if (x >= ctx.themeLoc[i].x - 2 && x <= ctx.themeLoc[i].x + ctx.themeLoc[i].width + 2
+		    && y >= ctx.themeLoc[i].y - 2 && y <= ctx.themeLoc[i].y + ctx.themeLoc[i].height + 2)
 			return false;
 	}
 
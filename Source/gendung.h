@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <list>
 #include <memory>
 
 #include "engine.h"
@@ -122,15 +123,171 @@ struct ShadowStruct {
 	uint8_t nv3;
 };
 
-extern uint8_t dungeon[DMAXX][DMAXY];
-extern uint8_t pdungeon[DMAXX][DMAXY];
-extern char dflags[DMAXX][DMAXY];
-extern int setpc_x;
-extern int setpc_y;
-extern int setpc_w;
-extern int setpc_h;
-extern std::unique_ptr<uint16_t[]> pSetPiece;
-extern bool setloadflag;
+struct HALLNODE {
+	int nHallx1;
+	int nHally1;
+	int nHallx2;
+	int nHally2;
+	int nHalldir;
+};
+
+struct ROOMNODE {
+	int nRoomx1;
+	int nRoomy1;
+	int nRoomx2;
+	int nRoomy2;
+	int nRoomDest;
+};
+
+/**
+ * @brief A level as built by the level generators, along with their working state
+ *
+ * The level globals (dungeon, dPiece, setpc_x, ...) are views of ActiveDungeon. CreateL5Dungeon and the other
+ * generators only write to the context they are given, so a level can be built without touching the one being played.
+ */
+struct DungeonContext {
+	/** Specifies the active dungeon type of the current game. */
+	dungeon_type leveltype;
+	/** Specifies the active dungeon level of the current game. */
+	BYTE currlevel;
+	/** Contains the tile IDs of the map. */
+	uint8_t dungeon[DMAXX][DMAXY];
+	/** Contains a backup of the tile IDs of the map. */
+	uint8_t pdungeon[DMAXX][DMAXY];
+	char dflags[DMAXX][DMAXY];
+	/** Specifies the active set level X-coordinate of the map. */
+	int setpc_x;
+	/** Specifies the active set level Y-coordinate of the map. */
+	int setpc_y;
+	/** Specifies the width of the active set level of the map. */
+	int setpc_w;
+	/** Specifies the height of the active set level of the map. */
+	int setpc_h;
+	/** Contains the contents of the single player quest DUN file. */
+	std::unique_ptr<uint16_t[]> pSetPiece;
+	/** Specifies whether a single player quest DUN has been loaded. */
+	bool setloadflag;
+	/** Specifies the minimum X-coordinate of the map. */
+	int dminx;
+	/** Specifies the minimum Y-coordinate of the map. */
+	int dminy;
+	/** Specifies the maximum X-coordinate of the map. */
+	int dmaxx;
+	/** Specifies the maximum Y-coordinate of the map. */
+	int dmaxy;
+	/** Specifies the player viewpoint X-coordinate of the map. */
+	int ViewX;
+	/** Specifies the player viewpoint Y-coordinate of the map. */
+	int ViewY;
+	/** Specifies the level viewpoint X-coordinate of the map. */
+	int LvlViewX;
+	/** Specifies the level viewpoint Y-coordinate of the map. */
+	int LvlViewY;
+	char TransVal;
+	/** Specifies the active transparency indices. */
+	bool TransList[256];
+	/** Contains the piece IDs of each tile on the map. */
+	int dPiece[MAXDUNX][MAXDUNY];
+	/** Specifies the transparency at each coordinate of the map. */
+	int8_t dTransVal[MAXDUNX][MAXDUNY];
+	int8_t dFlags[MAXDUNX][MAXDUNY];
+	/**
+	 * Contains the arch frame numbers of the map from the special tileset
+	 * (e.g. "levels/l1data/l1s.cel"). Note, the special tileset of Tristram (i.e.
+	 * "levels/towndata/towns.cel") contains trees rather than arches.
+	 */
+	char dSpecial[MAXDUNX][MAXDUNY];
+	int themeCount;
+	THEME_LOC themeLoc[MAXTHEMES];
+
+	// Na-Krul's room in the Crypt
+	int UberRow;
+	int UberCol;
+	bool IsUberRoomOpened;
+	int UberLeverRow;
+	int UberLeverCol;
+	bool IsUberLeverActivated;
+	int UberDiabloMonsterIndex;
+
+	// Quest entrances placed by the generators, copied to quests[] by ApplyDungeonQuestPositions
+	/** Entrance to the Poisoned Water Supply */
+	std::optional<Point> pwaterPosition;
+	/** Entrance to King Leoric's tomb */
+	std::optional<Point> skelKingPosition;
+	/** Entrance to the Chamber of Bone */
+	std::optional<Point> sChamberPosition;
+	/** Set piece holding Lazarus' staircase on level 15 */
+	std::optional<Point> betrayerPosition;
+
+	// Cathedral and Crypt generator
+	/** Represents a tile ID map of twice the size, repeating each tile of the original map in blocks of 4. */
+	BYTE L5dungeon[80][80];
+	BYTE L5dflags[DMAXX][DMAXY];
+	/** Specifies whether a single player quest DUN has been loaded. */
+	bool L5setloadflag;
+	/** Specifies whether to generate a horizontal room at position 1 in the Cathedral. */
+	bool HR1;
+	/** Specifies whether to generate a horizontal room at position 2 in the Cathedral. */
+	bool HR2;
+	/** Specifies whether to generate a horizontal room at position 3 in the Cathedral. */
+	bool HR3;
+	/** Specifies whether to generate a vertical room at position 1 in the Cathedral. */
+	bool VR1;
+	/** Specifies whether to generate a vertical room at position 2 in the Cathedral. */
+	bool VR2;
+	/** Specifies whether to generate a vertical room at position 3 in the Cathedral. */
+	bool VR3;
+	/** Contains the contents of the single player quest DUN file. */
+	std::unique_ptr<uint16_t[]> L5pSetPiece;
+
+	// Catacombs generator
+	BYTE predungeon[DMAXX][DMAXY];
+	int nSx1;
+	int nSy1;
+	int nSx2;
+	int nSy2;
+	int nRoomCnt;
+	ROOMNODE RoomList[81];
+	std::list<HALLNODE> HallList;
+
+	// Caves and Nest generator
+	/** This will be true if a lava pool has been generated for the level */
+	uint8_t lavapool;
+	int lockoutcnt;
+	bool lockout[DMAXX][DMAXY];
+
+	// Hell generator
+	int diabquad1x;
+	int diabquad1y;
+	int diabquad2x;
+	int diabquad2y;
+	int diabquad3x;
+	int diabquad3y;
+	int diabquad4x;
+	int diabquad4y;
+	bool hallok[20];
+	int l4holdx;
+	int l4holdy;
+	int SP4x1;
+	int SP4y1;
+	int SP4x2;
+	int SP4y2;
+	BYTE L4dungeon[80][80];
+	BYTE dung[20][20];
+};
+
+/** The level being played */
+extern DungeonContext ActiveDungeon;
+
+extern uint8_t (&dungeon)[DMAXX][DMAXY];
+extern uint8_t (&pdungeon)[DMAXX][DMAXY];
+extern char (&dflags)[DMAXX][DMAXY];
+extern int &setpc_x;
+extern int &setpc_y;
+extern int &setpc_w;
+extern int &setpc_h;
+extern std::unique_ptr<uint16_t[]> &pSetPiece;
+extern bool &setloadflag;
 extern std::optional<CelSprite> pSpecialCels;
 extern std::unique_ptr<MegaTile[]> pMegaTiles;
 extern std::unique_ptr<uint16_t[]> pLevelPieces;
@@ -156,57 +313,61 @@ extern std::array<bool, MAXTILES + 1> nTransTable;
  */
 extern std::array<bool, MAXTILES + 1> nMissileTable;
 extern std::array<bool, MAXTILES + 1> nTrapTable;
-extern int dminx;
-extern int dminy;
-extern int dmaxx;
-extern int dmaxy;
-extern dungeon_type leveltype;
-extern BYTE currlevel;
+extern int &dminx;
+extern int &dminy;
+extern int &dmaxx;
+extern int &dmaxy;
+extern dungeon_type &leveltype;
+extern BYTE &currlevel;
 extern bool setlevel;
 extern _setlevels setlvlnum;
 extern dungeon_type setlvltype;
-extern int ViewX;
-extern int ViewY;
+extern int &ViewX;
+extern int &ViewY;
 extern int ViewBX;
 extern int ViewBY;
 extern int ViewDX;
 extern int ViewDY;
 extern ScrollStruct ScrollInfo;
-extern int LvlViewX;
-extern int LvlViewY;
+extern int &LvlViewX;
+extern int &LvlViewY;
 extern int MicroTileLen;
-extern char TransVal;
-extern bool TransList[256];
-extern int dPiece[MAXDUNX][MAXDUNY];
+extern char &TransVal;
+extern bool (&TransList)[256];
+extern int (&dPiece)[MAXDUNX][MAXDUNY];
 extern MICROS dpiece_defs_map_2[MAXDUNX][MAXDUNY];
-extern int8_t dTransVal[MAXDUNX][MAXDUNY];
+extern int8_t (&dTransVal)[MAXDUNX][MAXDUNY];
 extern char dLight[MAXDUNX][MAXDUNY];
 extern char dPreLight[MAXDUNX][MAXDUNY];
-extern int8_t dFlags[MAXDUNX][MAXDUNY];
+extern int8_t (&dFlags)[MAXDUNX][MAXDUNY];
 extern int8_t dPlayer[MAXDUNX][MAXDUNY];
 extern int16_t dMonster[MAXDUNX][MAXDUNY];
 extern int8_t dDead[MAXDUNX][MAXDUNY];
 extern char dObject[MAXDUNX][MAXDUNY];
 extern int8_t dItem[MAXDUNX][MAXDUNY];
-extern char dMissile[MAXDUNX][MAXDUNY];
-extern char dSpecial[MAXDUNX][MAXDUNY];
-extern int themeCount;
-extern THEME_LOC themeLoc[MAXTHEMES];
+extern int16_t dMissile[MAXDUNX][MAXDUNY];
+extern char (&dSpecial)[MAXDUNX][MAXDUNY];
+extern int &themeCount;
+extern THEME_LOC (&themeLoc)[MAXTHEMES];
 
 void FillSolidBlockTbls();
 void SetDungeonMicros();
-void DRLG_InitTrans();
-void DRLG_MRectTrans(int x1, int y1, int x2, int y2);
-void DRLG_RectTrans(int x1, int y1, int x2, int y2);
-void DRLG_CopyTrans(int sx, int sy, int dx, int dy);
-void DRLG_ListTrans(int num, BYTE *List);
-void DRLG_AreaTrans(int num, BYTE *List);
-void DRLG_InitSetPC();
-void DRLG_SetPC();
-void Make_SetPC(int x, int y, int w, int h);
-void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize);
-void DRLG_HoldThemeRooms();
-bool SkipThemeRoom(int x, int y);
+/**
+ * @brief Clear the flags and arches of a level before the generator fills them in
+ */
+void DRLG_InitFlags(DungeonContext &ctx);
+void DRLG_InitTrans(DungeonContext &ctx);
+void DRLG_MRectTrans(DungeonContext &ctx, int x1, int y1, int x2, int y2);
+void DRLG_RectTrans(DungeonContext &ctx, int x1, int y1, int x2, int y2);
+void DRLG_CopyTrans(DungeonContext &ctx, int sx, int sy, int dx, int dy);
+void DRLG_ListTrans(DungeonContext &ctx, int num, BYTE *List);
+void DRLG_AreaTrans(DungeonContext &ctx, int num, BYTE *List);
+void DRLG_InitSetPC(DungeonContext &ctx);
+void DRLG_SetPC(DungeonContext &ctx);
+void Make_SetPC(DungeonContext &ctx, int x, int y, int w, int h);
+void DRLG_PlaceThemeRooms(DungeonContext &ctx, int minSize, int maxSize, int floor, int freq, bool rndSize);
+void DRLG_HoldThemeRooms(DungeonContext &ctx);
+bool SkipThemeRoom(DungeonContext &ctx, int x, int y);
 void InitLevels();
 
 } // namespace devilution
@@ -83,6 +83,8 @@ void init_cleanup()
 		pfile_write_hero(/*write_game_data=*/false, /*clear_tables=*/true);
 	}
 
+	SFileFreeFileCache();
+
 	if (spawn_mpq != nullptr) {
 		SFileCloseArchive(spawn_mpq);
 		spawn_mpq = nullptr;
@@ -215,6 +217,8 @@ void init_archives()
 	}
 
 	devilutionx_mpq = init_test_access(paths, "devilutionx.mpq");
+
+	SFileIndexArchives();
 }
 
 void init_create_window()
@@ -26,6 +26,7 @@
 #include "stores.h"
 #include "utils/language.h"
 #include "utils/math.h"
+#include "utils/profiler.h"
 #include "utils/stdcompat/algorithm.hpp"
 
 namespace devilution {
@@ -2947,6 +2948,7 @@ void ItemDoppel()
 
 void ProcessItems()
 {
+	ProfileScope profileScope(ProfileStage::ProcessItems);
 	for (int i = 0; i < numitems; i++) {
 		int ii = itemactive[i];
 		if (!items[ii]._iAnimFlag)
@@ -8,7 +8,10 @@
 #include "automap.h"
 #include "diablo.h"
 #include "engine/load_file.hpp"
+#include "engine/render/dun_tile_cache.hpp"
+#include "engine/rectangle.hpp"
 #include "player.h"
+#include "utils/profiler.h"
 
 namespace devilution {
 
@@ -22,6 +25,10 @@ int numvision;
 char lightmax;
 bool dolighting;
 uint8_t lightblock[64][16][16];
+/** Furthest tile distance, per light radius, at which DoLighting can leave a value below full darkness */
+uint8_t lightreach[16];
+/** Set when the light list has been reset, so the next update has to rebuild the whole light map */
+bool relightall;
 int visionid;
 std::array<uint8_t, LIGHTSIZE> pLightTbl;
 bool lightflag;
@@ -610,25 +617,27 @@ void DoLighting(Point position, int nRadius, int Lnum)
 	}
 }
 
-void DoUnLight(int nXPos, int nYPos, int nRadius)
+/**
+ * @brief Get the area of the light map that a light at the given tile may have changed
+ *
+ * The area includes the tile before, as DoLighting moves lights with a negative pixel offset back by one tile.
+ */
+Rectangle GetLightRegion(Point position, int nRadius)
 {
-	nRadius++;
+	int reach = lightreach[nRadius];
 
-	int min_x = nXPos - nRadius;
-	int max_x = nXPos + nRadius;
-	int min_y = nYPos - nRadius;
-	int max_y = nYPos + nRadius;
+	int min_x = std::max(position.x - reach - 1, 0);
+	int max_x = std::min(position.x + reach, MAXDUNX - 1);
+	int min_y = std::max(position.y - reach - 1, 0);
+	int max_y = std::min(position.y + reach, MAXDUNY - 1);
 
-	min_x = std::max(min_x, 0);
-	max_x = std::max(max_x, MAXDUNX);
-	min_y = std::max(min_y, 0);
-	max_y = std::max(max_y, MAXDUNY);
+	return { { min_x, min_y }, { std::max(max_x - min_x + 1, 0), std::max(max_y - min_y + 1, 0) } };
+}
 
-	for (int y = min_y; y < max_y; y++) {
-		for (int x = min_x; x < max_x; x++) {
-			if (x >= 0 && x < MAXDUNX && y >= 0 && y < MAXDUNY)
-				dLight[x][y] = dPreLight[x][y];
-		}
+void DoUnLight(const Rectangle &region)
+{
+	for (int x = region.position.x; x < region.position.x + region.size.width; x++) {
+		memcpy(&dLight[x][region.position.y], &dPreLight[x][region.position.y], region.size.height);
 	}
 }
 
@@ -754,6 +763,7 @@ void DoVision(Point position, int nRadius, bool doautomap, bool visible)
 
 void MakeLightTable()
 {
+	InvalidateTileCache();
 	uint8_t *tbl = pLightTbl.data();
 	int shade = 0;
 	int lights = 15;
@@ -899,6 +909,11 @@ void MakeLightTable()
 		*tbl++ = 0;
 	}
 
+	MakeLightRadiusTables();
+}
+
+void MakeLightRadiusTables()
+{
 	for (int j = 0; j < 16; j++) {
 		for (int i = 0; i < 128; i++) {
 			if (i > (j + 1) * 8) {
@@ -936,6 +951,20 @@ void MakeLightTable()
 			}
 		}
 	}
+
+	for (int j = 0; j < 16; j++) {
+		lightreach[j] = 0;
+		for (int mult = 0; mult < 64; mult++) {
+			for (int k = 0; k < 16; k++) {
+				for (int l = 0; l < 16; l++) {
+					int radiusBlock = lightblock[mult][k][l];
+					// Light blocks are indexed up to one tile past the distance they are drawn at, which is at most 14
+					if (radiusBlock < 128 && lightradius[j][radiusBlock] < 15)
+						lightreach[j] = std::max(lightreach[j], static_cast<uint8_t>(std::min(std::max(k, l), 14)));
+				}
+			}
+		}
+	}
 }
 
 #ifdef _DEBUG
@@ -967,6 +996,7 @@ void InitLighting()
 	numlights = 0;
 	dolighting = false;
 	lightflag = false;
+	relightall = true;
 
 	for (int i = 0; i < MAXLIGHTS; i++) {
 		lightactive[i] = i;
@@ -989,7 +1019,10 @@ int AddLight(Point position, int r)
 		LightList[lid]._lradius = r;
 		LightList[lid].position.offset = { 0, 0 };
 		LightList[lid]._ldel = false;
-		LightList[lid]._lunflag = false;
+		// Mark the light as moved onto its own tile so the next update draws it
+		LightList[lid]._lunflag = true;
+		LightList[lid].position.old = position;
+		LightList[lid].oldRadious = r;
 		dolighting = true;
 	}
 
@@ -1061,27 +1094,51 @@ void ChangeLight(int i, Point position, int r)
 
 void ProcessLightList()
 {
+	ProfileScope profileScope(ProfileStage::ProcessLightList);
 	if (lightflag) {
 		return;
 	}
 
 	if (dolighting) {
+		// Only the areas around deleted, moved and new lights are restored, after which only the lights touching those areas are redrawn
+		Rectangle dirtyRegions[MAXLIGHTS * 2];
+		bool relight[MAXLIGHTS] = {};
+		int numDirtyRegions = 0;
+
+		if (relightall)
+			memcpy(dLight, dPreLight, sizeof(dLight));
+
 		for (int i = 0; i < numlights; i++) {
 			int j = lightactive[i];
 			if (LightList[j]._ldel) {
-				DoUnLight(LightList[j].position.tile.x, LightList[j].position.tile.y, LightList[j]._lradius);
+				dirtyRegions[numDirtyRegions++] = GetLightRegion(LightList[j].position.tile, LightList[j]._lradius);
 			}
 			if (LightList[j]._lunflag) {
-				DoUnLight(LightList[j].position.old.x, LightList[j].position.old.y, LightList[j].oldRadious);
+				dirtyRegions[numDirtyRegions++] = GetLightRegion(LightList[j].position.old, LightList[j].oldRadious);
 				LightList[j]._lunflag = false;
+				relight[j] = true;
+			}
+		}
+		if (!relightall) {
+			for (int k = 0; k < numDirtyRegions; k++) {
+				DoUnLight(dirtyRegions[k]);
 			}
 		}
 		for (int i = 0; i < numlights; i++) {
 			int j = lightactive[i];
-			if (!LightList[j]._ldel) {
+			if (LightList[j]._ldel) {
+				continue;
+			}
+			bool touchesDirtyRegion = relightall || relight[j];
+			Rectangle region = GetLightRegion(LightList[j].position.tile, LightList[j]._lradius);
+			for (int k = 0; k < numDirtyRegions && !touchesDirtyRegion; k++) {
+				touchesDirtyRegion = region.Overlaps(dirtyRegions[k]);
+			}
+			if (touchesDirtyRegion) {
 				DoLighting(LightList[j].position.tile, LightList[j]._lradius, j);
 			}
 		}
+		relightall = false;
 		int i = 0;
 		while (i < numlights) {
 			if (LightList[lightactive[i]]._ldel) {
@@ -1161,6 +1218,7 @@ void ChangeVisionXY(int id, Point position)
 
 void ProcessVisionList()
 {
+	ProfileScope profileScope(ProfileStage::ProcessVisionList);
 	if (dovision) {
 		for (int i = 0; i < numvision; i++) {
 			if (VisionList[i]._ldel) {
@@ -1207,6 +1265,7 @@ void lighting_color_cycling()
 		return;
 	}
 
+	InvalidateTileCache();
 	uint8_t *tbl = pLightTbl.data();
 
 	for (int j = 0; j < 16; j++) {
@@ -53,6 +53,10 @@ void DoVision(Point position, int nRadius, bool doautomap, bool visible);
 void FreeLightTable();
 void InitLightTable();
 void MakeLightTable();
+/**
+ * @brief Build the light falloff tables used by DoLighting for the current level
+ */
+void MakeLightRadiusTables();
 #ifdef _DEBUG
 void ToggleLighting();
 #endif
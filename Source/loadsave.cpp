@@ -15,12 +15,12 @@
 #include "dead.h"
 #include "doom.h"
 #include "engine.h"
+#include "engine/grid_serialize.hpp"
 #include "engine/point.hpp"
 #include "init.h"
 #include "inv.h"
 #include "lighting.h"
 #include "missiles.h"
-#include "mpqapi.h"
 #include "pfile.h"
 #include "stores.h"
 #include "utils/endian.hpp"
@@ -33,8 +33,67 @@ uint8_t giNumberOfLevels;
 uint8_t giNumberQuests;
 uint8_t giNumberOfSmithPremiumItems;
 
+const char *const GameGridFileNames[NumGameGridFiles] = {
+	"gridlight",
+	"gridflags",
+	"gridplayer",
+	"griditem",
+	"gridmonster",
+	"griddead",
+	"gridobject",
+	"gridprelight",
+	"gridautomap",
+	"gridmissile",
+};
+
 namespace {
 
+/** Index of each grid in GameGridFileNames */
+enum GameGridFile : uint8_t {
+	GridLight,
+	GridFlags,
+	GridPlayer,
+	GridItem,
+	GridMonster,
+	GridDead,
+	GridObject,
+	GridPreLight,
+	GridAutomap,
+	GridMissile,
+};
+
+/** Set by IsHeaderValid when the game file doesn't contain the level grids, they are in the files of GameGridFileNames instead */
+bool gbIsSectionedSaveGame;
+
+/** Scratch space for converting a grid to and from its saved form */
+union {
+	int8_t bytes[MAXDUNX][MAXDUNY];
+	uint16_t words[MAXDUNX][MAXDUNY];
+	int8_t automap[DMAXX][DMAXY];
+} GridBuffer;
+
+/**
+ * @brief Set AutomapView from the saved bytes in GridBuffer.automap
+ */
+void LoadAutomapView()
+{
+	for (int i = 0; i < DMAXX; i++) {
+		for (int j = 0; j < DMAXY; j++)
+			AutomapView[i][j] = GridBuffer.automap[i][j] != 0;
+	}
+}
+
+/**
+ * @brief Put the dFlags bits that are saved in GridBuffer.bytes, leaving out the ones recalculated every tick
+ */
+void SaveFlagsToBuffer()
+{
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++)
+			GridBuffer.bytes[i][j] = dFlags[i][j] & ~(BFLAG_MISSILE | BFLAG_VISIBLE | BFLAG_DEAD_PLAYER);
+	}
+}
+
 template <class T>
 T SwapLE(T in)
 {
@@ -131,6 +190,37 @@ public:
 	{
 		return next<uint32_t>() != 0;
 	}
+
+	/**
+	 * @brief Read a grid of bytes stored one y at a time, the grid is cleared if the file is too short
+	 */
+	template <class T, size_t W, size_t H>
+	void nextGrid(T (&grid)[W][H])
+	{
+		static_assert(sizeof(T) == 1, "Only grids of bytes are stored as is");
+		if (!isValid(W * H)) {
+			memset(grid, 0, sizeof(grid));
+			return;
+		}
+
+		LoadGridBytes(reinterpret_cast<uint8_t *>(grid), reinterpret_cast<const uint8_t *>(&m_buffer[m_cur]), W, H);
+		m_cur += W * H;
+	}
+
+	/**
+	 * @brief Read a grid stored one y at a time as big-endian 32-bit values, the grid is cleared if the file is too short
+	 */
+	template <size_t W, size_t H>
+	void nextGridBE32(int16_t (&grid)[W][H])
+	{
+		if (!isValid(W * H * 4)) {
+			memset(grid, 0, sizeof(grid));
+			return;
+		}
+
+		LoadGridBE32(&grid[0][0], reinterpret_cast<const uint8_t *>(&m_buffer[m_cur]), W, H);
+		m_cur += W * H * 4;
+	}
 };
 
 class SaveHelper {
@@ -142,7 +232,7 @@ class SaveHelper {
 public:
 	SaveHelper(const char *szFileName, size_t bufferLen)
 	    : m_szFileName(szFileName)
-	    , m_buffer(new byte[codec_get_encoded_len(bufferLen)])
+	    , m_buffer(new byte[codec_get_encoded_len(bufferLen)] {})
 	    , m_capacity(bufferLen)
 	{
 	}
@@ -181,12 +271,36 @@ public:
 		writeBytes(&value, sizeof(value));
 	}
 
+	/**
+	 * @brief Write a grid of bytes one y at a time
+	 */
+	template <class T, size_t W, size_t H>
+	void writeGrid(const T (&grid)[W][H])
+	{
+		static_assert(sizeof(T) == 1, "Only grids of bytes are stored as is");
+		if (!isValid(W * H))
+			return;
+
+		SaveGridBytes(reinterpret_cast<uint8_t *>(&m_buffer[m_cur]), reinterpret_cast<const uint8_t *>(grid), W, H);
+		m_cur += W * H;
+	}
+
+	/**
+	 * @brief Write a grid one y at a time as big-endian 32-bit values
+	 */
+	template <size_t W, size_t H>
+	void writeGridBE32(const int16_t (&grid)[W][H])
+	{
+		if (!isValid(W * H * 4))
+			return;
+
+		SaveGridBE32(reinterpret_cast<uint8_t *>(&m_buffer[m_cur]), &grid[0][0], W, H);
+		m_cur += W * H * 4;
+	}
+
 	~SaveHelper()
 	{
-		const auto encoded_len = codec_get_encoded_len(m_cur);
-		const char *const password = pfile_get_password();
-		codec_encode(m_buffer.get(), m_cur, encoded_len, password);
-		mpqapi_write_file(m_szFileName, m_buffer.get(), encoded_len);
+		pfile_write_save_file(m_szFileName, m_buffer.get(), m_cur);
 	}
 };
 
@@ -910,6 +1024,27 @@ _item_indexes RemapItemIdxToSpawn(_item_indexes i)
 bool IsHeaderValid(uint32_t magicNumber)
 {
 	gbIsHellfireSaveGame = false;
+	gbIsSectionedSaveGame = false;
+	if (magicNumber == LoadLE32("SHR2")) {
+		gbIsSectionedSaveGame = true;
+		return true;
+	}
+	if (magicNumber == LoadLE32("SHL2")) {
+		gbIsHellfireSaveGame = true;
+		gbIsSectionedSaveGame = true;
+		return true;
+	}
+	if (!gbIsSpawn && magicNumber == LoadLE32("RTL2")) {
+		gbIsSectionedSaveGame = true;
+		return true;
+	}
+	if (!gbIsSpawn && magicNumber == LoadLE32("HLF2")) {
+		gbIsHellfireSaveGame = true;
+		gbIsSectionedSaveGame = true;
+		return true;
+	}
+
+	// Saves from before the grids got their own files
 	if (magicNumber == LoadLE32("SHAR")) {
 		return true;
 	}
@@ -1063,6 +1198,45 @@ void RemoveEmptyLevelItems()
 	}
 }
 
+/**
+ * @brief Read a grid of the current level from its own file in the save archive
+ */
+static void LoadGridFile(GameGridFile grid, void *data, size_t size)
+{
+	LoadHelper file(GameGridFileNames[grid]);
+	if (!file.isValid(size))
+		app_fatal("%s", _("Invalid save file"));
+
+	file.nextBytes(data, size);
+}
+
+static void LoadGameGrids()
+{
+	LoadGridFile(GridLight, dLight, sizeof(dLight));
+	LoadGridFile(GridFlags, dFlags, sizeof(dFlags));
+	LoadGridFile(GridPlayer, dPlayer, sizeof(dPlayer));
+	LoadGridFile(GridItem, dItem, sizeof(dItem));
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	LoadGridFile(GridMonster, GridBuffer.words, sizeof(GridBuffer.words));
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++)
+			dMonster[i][j] = static_cast<int16_t>(SDL_SwapLE16(GridBuffer.words[i][j]));
+	}
+	LoadGridFile(GridDead, dDead, sizeof(dDead));
+	LoadGridFile(GridObject, dObject, sizeof(dObject));
+	LoadGridFile(GridPreLight, dPreLight, sizeof(dPreLight));
+	LoadGridFile(GridAutomap, GridBuffer.automap, sizeof(GridBuffer.automap));
+	LoadAutomapView();
+	LoadGridFile(GridMissile, GridBuffer.bytes, sizeof(GridBuffer.bytes));
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++)
+			dMissile[i][j] = GridBuffer.bytes[i][j];
+	}
+}
+
 /**
  * @brief Load game state
  * @param firstflag Can be set to false if we are simply reloading the current game
@@ -1148,10 +1322,10 @@ void LoadGame(bool firstflag)
 			monsterId = file.nextBE<int32_t>();
 		for (int i = 0; i < nummonsters; i++)
 			LoadMonster(&file, monstactive[i]);
-		for (int &missileId : missileactive)
-			missileId = file.nextLE<int8_t>();
-		for (int &missileId : missileavail)
-			missileId = file.nextLE<int8_t>();
+		for (int i = 0; i < MAXMISSILES; i++)
+			missileactive[i] = file.nextLE<int8_t>();
+		for (int i = 0; i < MAXMISSILES; i++)
+			missileavail[i] = file.nextLE<int8_t>();
 		for (int i = 0; i < nummissiles; i++)
 			LoadMissile(&file, missileactive[i]);
 		for (int &objectId : objectactive)
@@ -1186,51 +1360,27 @@ void LoadGame(bool firstflag)
 	for (bool &UniqueItemFlag : UniqueItemFlags)
 		UniqueItemFlag = file.nextBool8();
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dLight[i][j] = file.nextLE<int8_t>();
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dFlags[i][j] = file.nextLE<int8_t>();
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dPlayer[i][j] = file.nextLE<int8_t>();
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dItem[i][j] = file.nextLE<int8_t>();
-	}
-
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dMonster[i][j] = file.nextBE<int32_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dDead[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dObject[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dLight[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dPreLight[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++)
-				AutomapView[i][j] = file.nextBool8();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dMissile[i][j] = file.nextLE<int8_t>();
+	if (gbIsSectionedSaveGame) {
+		LoadGameGrids();
+	} else {
+		file.nextGrid(dLight);
+		file.nextGrid(dFlags);
+		file.nextGrid(dPlayer);
+		file.nextGrid(dItem);
+
+		if (leveltype != DTYPE_TOWN) {
+			file.nextGridBE32(dMonster);
+			file.nextGrid(dDead);
+			file.nextGrid(dObject);
+			file.nextGrid(dLight);
+			file.nextGrid(dPreLight);
+			file.nextGrid(GridBuffer.automap);
+			LoadAutomapView();
+			file.nextGrid(GridBuffer.bytes);
+			for (int i = 0; i < MAXDUNX; i++) {
+				for (int j = 0; j < MAXDUNY; j++)
+					dMissile[i][j] = GridBuffer.bytes[i][j];
+			}
 		}
 	}
 
@@ -1682,6 +1832,27 @@ static void SaveMonster(SaveHelper *file, int i)
 	// Omit pointer MData;
 }
 
+/**
+ * @brief Missiles beyond the first block of the pool aren't saved, so their tiles are stored as holding several missiles
+ */
+static int8_t GetSavedMissileMapValue(int16_t missileId)
+{
+	if (missileId > MAXMISSILES)
+		return -1;
+	return static_cast<int8_t>(missileId);
+}
+
+/**
+ * @brief Put the saved form of dMissile in GridBuffer.bytes
+ */
+static void SaveMissilesToBuffer()
+{
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++)
+			GridBuffer.bytes[i][j] = GetSavedMissileMapValue(dMissile[i][j]);
+	}
+}
+
 static void SaveMissile(SaveHelper *file, int i)
 {
 	MissileStruct *pMissile = &missile[i];
@@ -1854,6 +2025,45 @@ void SaveHeroItems(PlayerStruct &player)
 	SaveItems(&file, player.SpdList, MAXBELTITEMS);
 }
 
+/**
+ * @brief Write a grid of the current level to its own file in the save archive
+ *
+ * The grids are kept out of the game file so a grid that didn't change since the last save isn't written again.
+ */
+static void SaveGridFile(GameGridFile grid, const void *data, size_t size)
+{
+	SaveHelper file(GameGridFileNames[grid], size);
+	file.writeBytes(data, size);
+}
+
+static void SaveGameGrids()
+{
+	SaveGridFile(GridLight, dLight, sizeof(dLight));
+	SaveFlagsToBuffer();
+	SaveGridFile(GridFlags, GridBuffer.bytes, sizeof(GridBuffer.bytes));
+	SaveGridFile(GridPlayer, dPlayer, sizeof(dPlayer));
+	SaveGridFile(GridItem, dItem, sizeof(dItem));
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int i = 0; i < MAXDUNX; i++) {
+		for (int j = 0; j < MAXDUNY; j++)
+			GridBuffer.words[i][j] = SDL_SwapLE16(static_cast<uint16_t>(dMonster[i][j]));
+	}
+	SaveGridFile(GridMonster, GridBuffer.words, sizeof(GridBuffer.words));
+	SaveGridFile(GridDead, dDead, sizeof(dDead));
+	SaveGridFile(GridObject, dObject, sizeof(dObject));
+	SaveGridFile(GridPreLight, dPreLight, sizeof(dPreLight));
+	for (int i = 0; i < DMAXX; i++) {
+		for (int j = 0; j < DMAXY; j++)
+			GridBuffer.automap[i][j] = AutomapView[i][j] ? 1 : 0;
+	}
+	SaveGridFile(GridAutomap, GridBuffer.automap, sizeof(GridBuffer.automap));
+	SaveMissilesToBuffer();
+	SaveGridFile(GridMissile, GridBuffer.bytes, sizeof(GridBuffer.bytes));
+}
+
 // 256 kilobytes + 3 bytes (demo leftover) for file magic (262147)
 // final game uses 4-byte magic instead of 3
 #define FILEBUFF ((256 * 1024) + 3)
@@ -1863,13 +2073,13 @@ void SaveGameData()
 	SaveHelper file("game", FILEBUFF);
 
 	if (gbIsSpawn && !gbIsHellfire)
-		file.writeLE<uint32_t>(LoadLE32("SHAR"));
+		file.writeLE<uint32_t>(LoadLE32("SHR2"));
 	else if (gbIsSpawn && gbIsHellfire)
-		file.writeLE<uint32_t>(LoadLE32("SHLF"));
+		file.writeLE<uint32_t>(LoadLE32("SHL2"));
 	else if (!gbIsSpawn && gbIsHellfire)
-		file.writeLE<uint32_t>(LoadLE32("HELF"));
+		file.writeLE<uint32_t>(LoadLE32("HLF2"));
 	else if (!gbIsSpawn && !gbIsHellfire)
-		file.writeLE<uint32_t>(LoadLE32("RETL"));
+		file.writeLE<uint32_t>(LoadLE32("RTL2"));
 	else
 		app_fatal("%s", _("Invalid game state"));
 
@@ -1893,7 +2103,10 @@ void SaveGameData()
 	file.writeLE<uint8_t>(chrflag ? 1 : 0);
 	file.writeBE<int32_t>(nummonsters);
 	file.writeBE<int32_t>(numitems);
-	file.writeBE<int32_t>(nummissiles);
+	int savedMissileActive[MAXMISSILES];
+	int savedMissileAvail[MAXMISSILES];
+	int savedMissiles = GetSavedMissiles(savedMissileActive, savedMissileAvail);
+	file.writeBE<int32_t>(savedMissiles);
 	file.writeBE<int32_t>(nobjects);
 
 	for (uint8_t i = 0; i < giNumberOfLevels; i++) {
@@ -1916,12 +2129,12 @@ void SaveGameData()
 			file.writeBE<int32_t>(monsterId);
 		for (int i = 0; i < nummonsters; i++)
 			SaveMonster(&file, monstactive[i]);
-		for (int missileId : missileactive)
+		for (int missileId : savedMissileActive)
 			file.writeLE<int8_t>(missileId);
-		for (int missileId : missileavail)
+		for (int missileId : savedMissileAvail)
 			file.writeLE<int8_t>(missileId);
-		for (int i = 0; i < nummissiles; i++)
-			SaveMissile(&file, missileactive[i]);
+		for (int i = 0; i < savedMissiles; i++)
+			SaveMissile(&file, savedMissileActive[i]);
 		for (int objectId : objectactive)
 			file.writeLE<int8_t>(objectId);
 		for (int objectId : objectavail)
@@ -1952,53 +2165,7 @@ void SaveGameData()
 	for (bool UniqueItemFlag : UniqueItemFlags)
 		file.writeLE<uint8_t>(UniqueItemFlag ? 1 : 0);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dLight[i][j]);
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dFlags[i][j] & ~(BFLAG_MISSILE | BFLAG_VISIBLE | BFLAG_DEAD_PLAYER));
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dPlayer[i][j]);
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dItem[i][j]);
-	}
-
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeBE<int32_t>(dMonster[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dDead[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dObject[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dLight[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dPreLight[i][j]);
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++)
-				file.writeLE<uint8_t>(AutomapView[i][j] ? 1 : 0);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dMissile[i][j]);
-		}
-	}
+	SaveGameGrids();
 
 	file.writeBE<int32_t>(numpremium);
 	file.writeBE<int32_t>(premiumlevel);
@@ -2029,12 +2196,8 @@ void SaveLevel()
 	GetTempLevelNames(szName);
 	SaveHelper file(szName, FILEBUFF);
 
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dDead[i][j]);
-		}
-	}
+	if (leveltype != DTYPE_TOWN)
+		file.writeGrid(dDead);
 
 	file.writeBE<int32_t>(nummonsters);
 	file.writeBE<int32_t>(numitems);
@@ -2061,40 +2224,18 @@ void SaveLevel()
 	for (int i = 0; i < numitems; i++)
 		SaveItem(&file, &items[itemactive[i]]);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dFlags[i][j] & ~(BFLAG_MISSILE | BFLAG_VISIBLE | BFLAG_DEAD_PLAYER));
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			file.writeLE<int8_t>(dItem[i][j]);
-	}
+	SaveFlagsToBuffer();
+	file.writeGrid(GridBuffer.bytes);
+	file.writeGrid(dItem);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeBE<int32_t>(dMonster[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dObject[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dLight[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dPreLight[i][j]);
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++)
-				file.writeLE<uint8_t>(AutomapView[i][j] ? 1 : 0);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				file.writeLE<int8_t>(dMissile[i][j]);
-		}
+		file.writeGridBE32(dMonster);
+		file.writeGrid(dObject);
+		file.writeGrid(dLight);
+		file.writeGrid(dPreLight);
+		file.writeGrid(AutomapView);
+		SaveMissilesToBuffer();
+		file.writeGrid(GridBuffer.bytes);
 	}
 
 	if (!setlevel)
@@ -2112,10 +2253,7 @@ void LoadLevel()
 		app_fatal("%s", _("Unable to open save file archive"));
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dDead[i][j] = file.nextLE<int8_t>();
-		}
+		file.nextGrid(dDead);
 		SetDead();
 	}
 
@@ -2147,36 +2285,16 @@ void LoadLevel()
 	for (int i = 0; i < numitems; i++)
 		LoadItem(&file, itemactive[i]);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dFlags[i][j] = file.nextLE<int8_t>();
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++)
-			dItem[i][j] = file.nextLE<int8_t>();
-	}
+	file.nextGrid(dFlags);
+	file.nextGrid(dItem);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dMonster[i][j] = file.nextBE<int32_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dObject[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dLight[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)
-				dPreLight[i][j] = file.nextLE<int8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++)
-				AutomapView[i][j] = file.nextBool8();
-		}
+		file.nextGridBE32(dMonster);
+		file.nextGrid(dObject);
+		file.nextGrid(dLight);
+		file.nextGrid(dPreLight);
+		file.nextGrid(GridBuffer.automap);
+		LoadAutomapView();
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++)
 				dMissile[i][j] = 0; /// BUGFIX: supposed to load saved missiles with "file.nextLE<int8_t>()"?
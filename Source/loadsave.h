@@ -12,6 +12,11 @@ namespace devilution {
 extern bool gbIsHellfireSaveGame;
 extern uint8_t giNumberOfLevels;
 
+/** Number of files next to "game" that hold the grids of the current level */
+constexpr int NumGameGridFiles = 10;
+/** Names of the files next to "game" that hold the grids of the current level, in saves that have them */
+extern const char *const GameGridFileNames[NumGameGridFiles];
+
 void RemoveInvalidItem(ItemStruct *pItem);
 _item_indexes RemapItemIdxFromDiablo(_item_indexes i);
 _item_indexes RemapItemIdxToDiablo(_item_indexes i);
@@ -5,29 +5,91 @@
  */
 #include "missiles.h"
 
+#include <algorithm>
 #include <climits>
 
 #include "control.h"
 #include "cursor.h"
 #include "dead.h"
+#include "engine/asset_loader.hpp"
 #include "engine/cel_header.hpp"
 #include "engine/load_file.hpp"
+#include "engine/sprite_cache.hpp"
 #include "init.h"
 #include "inv.h"
 #include "lighting.h"
 #include "spells.h"
 #include "trigs.h"
+#include "utils/profiler.h"
 
 namespace devilution {
 
-int missileactive[MAXMISSILES];
-int missileavail[MAXMISSILES];
-MissileStruct missile[MAXMISSILES];
+std::vector<int> missileactive(MAXMISSILES);
+std::vector<int> missileavail(MAXMISSILES);
+MissilePool missile;
 int nummissiles;
 ChainStruct chain[MAXMISSILES];
 bool MissilePreFlag;
 int numchains;
 
+namespace {
+
+/** Handles to the sprite data that misfiledata[].mAnimData points into */
+std::shared_ptr<byte[]> MissileSpriteData[MFILE_NONE][16];
+
+/** Upper limit on the number of blocks in the missile pool, keeps runaway spells from eating all memory */
+constexpr int MaxMissileBlocks = 8;
+
+bool GrowMissilePool()
+{
+	int capacity = missile.capacity();
+	if (capacity >= MaxMissileBlocks * MAXMISSILES)
+		return false;
+
+	missile.Grow();
+	missileactive.resize(missile.capacity());
+	missileavail.resize(missile.capacity());
+	int freeCount = capacity - nummissiles;
+	for (int i = 0; i < MAXMISSILES; i++)
+		missileavail[freeCount + i] = capacity + i;
+
+	return true;
+}
+
+} // namespace
+
+/**
+ * @brief Remove the missiles flagged for deletion in a single pass
+ *
+ * Each deleted missile is replaced by the last active one, so missiles are processed in the same order as before.
+ */
+void DeleteFlaggedMissiles()
+{
+	int i = 0;
+	while (i < nummissiles) {
+		if (missile[missileactive[i]]._miDelFlag) {
+			DeleteMissile(missileactive[i], i);
+		} else {
+			i++;
+		}
+	}
+}
+
+MissilePool::MissilePool()
+{
+	Grow();
+}
+
+void MissilePool::Grow()
+{
+	blocks_.emplace_back(new MissileStruct[MAXMISSILES]());
+}
+
+void MissilePool::Shrink()
+{
+	blocks_.resize(1);
+}
+
 const int CrawlNum[19] = { 0, 3, 12, 45, 94, 159, 240, 337, 450, 579, 724, 885, 1062, 1255, 1464, 1689, 1930, 2187, 2460 };
 
 int AddClassHealingBonus(int hp, HeroClass heroClass)
@@ -302,12 +364,41 @@ void DeleteMissile(int mi, int i)
 		plr[src].pManaShield = false;
 	}
 
-	missileavail[MAXMISSILES - nummissiles] = mi;
+	missileavail[missile.capacity() - nummissiles] = mi;
 	nummissiles--;
 	if (nummissiles > 0 && i != nummissiles)
 		missileactive[i] = missileactive[nummissiles];
 }
 
+int GetSavedMissiles(int (&active)[MAXMISSILES], int (&avail)[MAXMISSILES])
+{
+	if (missile.capacity() == MAXMISSILES) {
+		std::copy_n(missileactive.begin(), MAXMISSILES, active);
+		std::copy_n(missileavail.begin(), MAXMISSILES, avail);
+		return nummissiles;
+	}
+
+	bool used[MAXMISSILES] = {};
+	int count = 0;
+	for (int i = 0; i < nummissiles && count < MAXMISSILES - 1; i++) {
+		int mi = missileactive[i];
+		if (mi < MAXMISSILES) {
+			active[count++] = mi;
+			used[mi] = true;
+		}
+	}
+	std::fill(active + count, active + MAXMISSILES, 0);
+
+	int freeCount = 0;
+	for (int mi = 0; mi < MAXMISSILES; mi++) {
+		if (!used[mi])
+			avail[freeCount++] = mi;
+	}
+	std::fill(avail + freeCount, avail + MAXMISSILES, 0);
+
+	return count;
+}
+
 static void GetMissileVel(int i, Point source, Point destination, int v)
 {
 	missile[i].position.velocity = { 0, 0 };
@@ -892,7 +983,7 @@ void CheckMissileCol(int i, int mindam, int maxdam, bool shift, Point position,
 	int mx = position.x;
 	int my = position.y;
 
-	if (i >= MAXMISSILES || i < 0)
+	if (i >= missile.capacity() || i < 0)
 		return;
 	if (mx >= MAXDUNX || mx < 0)
 		return;
@@ -1090,16 +1181,18 @@ void LoadMissileGFX(BYTE mi)
 	char pszName[256];
 	if ((mfd->mFlags & MFLAG_ALLOW_SPECIAL) != 0) {
 		sprintf(pszName, "Missiles\\%s.CL2", mfd->mName);
-		byte *file = LoadFileInMem(pszName).release();
+		MissileSpriteData[mi][0] = LoadSpriteData(pszName);
 		for (unsigned i = 0; i < mfd->mAnimFAmt; i++)
-			mfd->mAnimData[i] = CelGetFrame(file, i);
+			mfd->mAnimData[i] = CelGetFrame(MissileSpriteData[mi][0].get(), i);
 	} else if (mfd->mAnimFAmt == 1) {
 		sprintf(pszName, "Missiles\\%s.CL2", mfd->mName);
-		mfd->mAnimData[0] = LoadFileInMem(pszName).release();
+		MissileSpriteData[mi][0] = LoadSpriteData(pszName);
+		mfd->mAnimData[0] = MissileSpriteData[mi][0].get();
 	} else {
 		for (unsigned i = 0; i < mfd->mAnimFAmt; i++) {
 			sprintf(pszName, "Missiles\\%s%u.CL2", mfd->mName, i + 1);
-			mfd->mAnimData[i] = LoadFileInMem(pszName).release();
+			MissileSpriteData[mi][i] = LoadSpriteData(pszName);
+			mfd->mAnimData[i] = MissileSpriteData[mi][i].get();
 		}
 	}
 }
@@ -1116,26 +1209,35 @@ void InitMissileGFX()
 	}
 }
 
-void FreeMissileGFX(int mi)
+void PrefetchMissileGFX()
 {
-	int i;
-	DWORD *p;
-
-	if ((misfiledata[mi].mFlags & MFLAG_ALLOW_SPECIAL) != 0) {
-		if (misfiledata[mi].mAnimData[0] != nullptr) {
-			p = (DWORD *)misfiledata[mi].mAnimData[0];
-			p -= misfiledata[mi].mAnimFAmt;
-			delete[] p;
-			misfiledata[mi].mAnimData[0] = nullptr;
+	char pszName[256];
+
+	for (int mi = 0; misfiledata[mi].mAnimFAmt != 0; mi++) {
+		if (!gbIsHellfire && mi > MFILE_SCBSEXPD)
+			break;
+		const MisFileData &mfd = misfiledata[mi];
+		if ((mfd.mFlags & MFLAG_HIDDEN) != 0)
+			continue;
+		if ((mfd.mFlags & MFLAG_ALLOW_SPECIAL) != 0 || mfd.mAnimFAmt == 1) {
+			sprintf(pszName, "Missiles\\%s.CL2", mfd.mName);
+			if (!IsSpriteCached(pszName))
+				PrefetchFile(pszName);
+		} else {
+			for (unsigned i = 0; i < mfd.mAnimFAmt; i++) {
+				sprintf(pszName, "Missiles\\%s%u.CL2", mfd.mName, i + 1);
+				if (!IsSpriteCached(pszName))
+					PrefetchFile(pszName);
+			}
 		}
-		return;
 	}
+}
 
-	for (i = 0; i < misfiledata[mi].mAnimFAmt; i++) {
-		if (misfiledata[mi].mAnimData[i] != nullptr) {
-			delete[] misfiledata[mi].mAnimData[i];
-			misfiledata[mi].mAnimData[i] = nullptr;
-		}
+void FreeMissileGFX(int mi)
+{
+	for (int i = 0; i < misfiledata[mi].mAnimFAmt; i++) {
+		misfiledata[mi].mAnimData[i] = nullptr;
+		MissileSpriteData[mi][i] = nullptr;
 	}
 }
 
@@ -1192,10 +1294,11 @@ void InitMissiles()
 	}
 
 	nummissiles = 0;
-	for (int i = 0; i < MAXMISSILES; i++) {
+	missile.Shrink();
+	missileactive.assign(MAXMISSILES, 0);
+	missileavail.resize(MAXMISSILES);
+	for (int i = 0; i < MAXMISSILES; i++)
 		missileavail[i] = i;
-		missileactive[i] = 0;
-	}
 	numchains = 0;
 	for (auto &link : chain) {
 		link.idx = -1;
@@ -2873,7 +2976,7 @@ void AddFlamec(int mi, Point src, Point dst, int midir, int8_t mienemy, int id,
 
 void AddCbolt(int mi, Point src, Point dst, int midir, int8_t micaster, int id, int dam)
 {
-	assert((DWORD)mi < MAXMISSILES);
+	assert(mi >= 0 && mi < missile.capacity());
 
 	missile[mi]._mirnd = GenerateRnd(15) + 1;
 	missile[mi]._midam = (micaster == 0) ? (GenerateRnd(plr[id]._pMagic / 4) + 1) : 15;
@@ -2987,7 +3090,7 @@ void AddDiabApoca(int mi, Point src, Point dst, int midir, int8_t mienemy, int i
 
 int AddMissile(Point src, Point dst, int midir, int mitype, int8_t micaster, int id, int midam, int spllvl)
 {
-	if (nummissiles >= MAXMISSILES - 1)
+	if (nummissiles >= missile.capacity() - 1 && !GrowMissilePool())
 		return -1;
 
 	if (mitype == MIS_MANASHIELD && plr[id].pManaShield) {
@@ -3003,11 +3106,11 @@ int AddMissile(Point src, Point dst, int midir, int mitype, int8_t micaster, int
 
 	int mi = missileavail[0];
 
-	missileavail[0] = missileavail[MAXMISSILES - nummissiles - 1];
+	missileavail[0] = missileavail[missile.capacity() - nummissiles - 1];
 	missileactive[nummissiles] = mi;
 	nummissiles++;
 
-	memset(&missile[mi], 0, sizeof(*missile));
+	memset(&missile[mi], 0, sizeof(MissileStruct));
 
 	missile[mi]._mitype = mitype;
 	missile[mi]._micaster = micaster;
@@ -3856,7 +3959,7 @@ void MI_Lightctrl(int i)
 {
 	int dam;
 
-	assert((DWORD)i < MAXMISSILES);
+	assert(i >= 0 && i < missile.capacity());
 	missile[i]._mirange--;
 
 	int id = missile[i]._misource;
@@ -4118,7 +4221,7 @@ void MI_Guardian(int i)
 {
 	int j, k, sx, sy, sx1, sy1, ex;
 
-	assert((DWORD)i < MAXMISSILES);
+	assert(i >= 0 && i < missile.capacity());
 
 	sx1 = 0;
 	sy1 = 0;
@@ -4522,7 +4625,7 @@ void MI_Wave(int i)
 {
 	bool f1 = false;
 	bool f2 = false;
-	assert((DWORD)i < MAXMISSILES);
+	assert(i >= 0 && i < missile.capacity());
 
 	int id = missile[i]._misource;
 	Point src = missile[i].position.tile;
@@ -4892,6 +4995,7 @@ void MI_Rportal(int i)
 
 void ProcessMissiles()
 {
+	ProfileScope profileScope(ProfileStage::ProcessMissiles);
 	int i, mi;
 
 	for (i = 0; i < nummissiles; i++) {
@@ -4901,15 +5005,7 @@ void ProcessMissiles()
 			missile[missileactive[i]]._miDelFlag = true;
 	}
 
-	i = 0;
-	while (i < nummissiles) {
-		if (missile[missileactive[i]]._miDelFlag) {
-			DeleteMissile(missileactive[i], i);
-			i = 0;
-		} else {
-			i++;
-		}
-	}
+	DeleteFlaggedMissiles();
 
 	MissilePreFlag = false;
 
@@ -4929,15 +5025,7 @@ void ProcessMissiles()
 		}
 	}
 
-	i = 0;
-	while (i < nummissiles) {
-		if (missile[missileactive[i]]._miDelFlag) {
-			DeleteMissile(missileactive[i], i);
-			i = 0;
-		} else {
-			i++;
-		}
-	}
+	DeleteFlaggedMissiles();
 }
 
 void missiles_process_charge()
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "miniwin/miniwin.h"
 #include "engine.h"
@@ -15,6 +17,7 @@
 
 namespace devilution {
 
+/** Number of missiles in each block of the missile pool, also the number of missiles stored in save games */
 #define MAXMISSILES 125
 
 struct ChainStruct {
@@ -106,9 +109,42 @@ struct MissileStruct {
 	bool limitReached;
 };
 
-extern int missileactive[MAXMISSILES];
-extern int missileavail[MAXMISSILES];
-extern MissileStruct missile[MAXMISSILES];
+/**
+ * @brief Storage for the missiles of the level, grown a block at a time so missiles never move once added
+ */
+class MissilePool {
+public:
+	MissilePool();
+
+	MissileStruct &operator[](size_t i)
+	{
+		return blocks_[i / MAXMISSILES][i % MAXMISSILES];
+	}
+
+	const MissileStruct &operator[](size_t i) const
+	{
+		return blocks_[i / MAXMISSILES][i % MAXMISSILES];
+	}
+
+	/** @brief Number of missiles that fit in the pool */
+	int capacity() const
+	{
+		return static_cast<int>(blocks_.size()) * MAXMISSILES;
+	}
+
+	void Grow();
+	/** @brief Release all blocks but the first */
+	void Shrink();
+
+private:
+	std::vector<std::unique_ptr<MissileStruct[]>> blocks_;
+};
+
+/** Ids of the active missiles, sized to the capacity of the pool */
+extern std::vector<int> missileactive;
+/** Ids of the free missile slots, sized to the capacity of the pool */
+extern std::vector<int> missileavail;
+extern MissilePool missile;
 extern int nummissiles;
 extern bool MissilePreFlag;
 
@@ -116,12 +152,26 @@ void GetDamageAmt(int i, int *mind, int *maxd);
 int GetSpellLevel(int playerId, spell_id sn);
 Direction16 GetDirection16(Point p1, Point p2);
 void DeleteMissile(int mi, int i);
+void DeleteFlaggedMissiles();
+/**
+ * @brief Lay out the active missiles the way save games store them
+ *
+ * Save games only have room for MAXMISSILES missiles, missiles beyond the first block of the pool are left out.
+ * @param active Receives the ids of the saved missiles
+ * @param avail Receives the ids of the free slots
+ * @return Number of saved missiles
+ */
+int GetSavedMissiles(int (&active)[MAXMISSILES], int (&avail)[MAXMISSILES]);
 bool MonsterTrapHit(int m, int mindam, int maxdam, int dist, int t, bool shift);
 bool PlayerMHit(int pnum, int m, int dist, int mind, int maxd, int mtype, bool shift, int earflag, bool *blocked);
 void SetMissAnim(int mi, int animtype);
 void SetMissDir(int mi, int dir);
 void LoadMissileGFX(BYTE mi);
 void InitMissileGFX();
+/**
+ * @brief Start loading the graphics that InitMissileGFX needs on the asset loader threads
+ */
+void PrefetchMissileGFX();
 void FreeMissiles();
 void FreeMissiles2();
 void InitMissiles();
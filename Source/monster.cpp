@@ -16,9 +16,11 @@
 #include "dead.h"
 #include "drlg_l1.h"
 #include "drlg_l4.h"
+#include "engine/asset_loader.hpp"
 #include "engine/cel_header.hpp"
 #include "engine/load_file.hpp"
 #include "engine/render/cl2_render.hpp"
+#include "engine/sprite_cache.hpp"
 #include "init.h"
 #include "lighting.h"
 #include "minitext.h"
@@ -30,6 +32,7 @@
 #include "towners.h"
 #include "trigs.h"
 #include "utils/language.h"
+#include "utils/profiler.h"
 
 #ifdef _DEBUG
 #include "debug.h"
@@ -144,25 +147,13 @@ void (*AiProc[])(int i) = {
 	&MAI_BoneDemon
 };
 
-void InitMonsterTRN(CMonster &monst)
+void InitMonsterTRN(byte *celBuf, const std::array<uint8_t, 256> &colorTranslations, int frames)
 {
-	std::array<uint8_t, 256> colorTranslations;
-	LoadFileInMem(monst.MData->TransFile, colorTranslations);
-
-	std::replace(colorTranslations.begin(), colorTranslations.end(), 255, 0);
-
-	int n = monst.MData->has_special ? 6 : 5;
-	for (int i = 0; i < n; i++) {
-		if (i == 1 && monst.mtype >= MT_COUNSLR && monst.mtype <= MT_ADVOCATE) {
-			continue;
-		}
-
-		for (int j = 0; j < 8; j++) {
-			Cl2ApplyTrans(
-			    CelGetFrame(monst.Anims[i].CMem.get(), j),
-			    colorTranslations,
-			    monst.Anims[i].Frames);
-		}
+	for (int j = 0; j < 8; j++) {
+		Cl2ApplyTrans(
+		    CelGetFrame(celBuf, j),
+		    colorTranslations,
+		    frames);
 	}
 }
 
@@ -189,6 +180,35 @@ void InitLevelMonsters()
 	uniquetrans = 0;
 }
 
+/**
+ * @brief Get the color translation applied to the given animation, recolored monsters get their own copy of the graphics
+ * @return Path of the TRN file or nullptr if the graphics are used as is
+ */
+static const char *GetMonsterTRN(_monster_id mtype, int anim)
+{
+	if (!monsterdata[mtype].has_trans)
+		return nullptr;
+	if (anim == 1 && mtype >= MT_COUNSLR && mtype <= MT_ADVOCATE)
+		return nullptr;
+	return monsterdata[mtype].TransFile;
+}
+
+/**
+ * @brief Start loading all animations of a monster type on the asset loader threads so they load side by side
+ */
+static void PrefetchMonsterGFX(_monster_id mtype)
+{
+	char strBuff[256];
+
+	for (int anim = 0; anim < 6; anim++) {
+		if ((animletter[anim] != 's' || monsterdata[mtype].has_special) && monsterdata[mtype].Frames[anim] > 0) {
+			sprintf(strBuff, monsterdata[mtype].GraphicType, animletter[anim]);
+			if (!IsSpriteCached(strBuff, GetMonsterTRN(mtype, anim)))
+				PrefetchFile(strBuff);
+		}
+	}
+}
+
 int AddMonsterType(_monster_id type, placeflag placeflag)
 {
 	bool done = false;
@@ -205,6 +225,7 @@ int AddMonsterType(_monster_id type, placeflag placeflag)
 		nummtypes++;
 		Monsters[i].mtype = type;
 		monstimgtot += monsterdata[type].mImage;
+		PrefetchMonsterGFX(type);
 		InitMonsterGFX(i);
 		InitMonsterSND(i);
 	}
@@ -341,6 +362,12 @@ void InitMonsterGFX(int monst)
 	mtype = Monsters[monst].mtype;
 	int width = monsterdata[mtype].width;
 
+	std::array<uint8_t, 256> colorTranslations;
+	if (monsterdata[mtype].has_trans) {
+		LoadFileInMem(monsterdata[mtype].TransFile, colorTranslations);
+		std::replace(colorTranslations.begin(), colorTranslations.end(), 255, 0);
+	}
+
 	for (anim = 0; anim < 6; anim++) {
 		int frames = monsterdata[mtype].Frames[anim];
 		if (gbIsHellfire && mtype == MT_DIABLO && anim == 3)
@@ -349,12 +376,10 @@ void InitMonsterGFX(int monst)
 		if ((animletter[anim] != 's' || monsterdata[mtype].has_special) && frames > 0) {
 			sprintf(strBuff, monsterdata[mtype].GraphicType, animletter[anim]);
 
-			byte *celBuf;
-			{
-				auto celData = LoadFileInMem(strBuff);
-				celBuf = celData.get();
-				Monsters[monst].Anims[anim].CMem = std::move(celData);
-			}
+			Monsters[monst].Anims[anim].CMem = LoadSpriteData(strBuff, GetMonsterTRN(Monsters[monst].mtype, anim), [&colorTranslations, frames](byte *celBuf) {
+				InitMonsterTRN(celBuf, colorTranslations, frames);
+			});
+			byte *celBuf = Monsters[monst].Anims[anim].CMem.get();
 
 			if (Monsters[monst].mtype != MT_GOLEM || (animletter[anim] != 's' && animletter[anim] != 'd')) {
 
@@ -383,10 +408,6 @@ void InitMonsterGFX(int monst)
 	Monsters[monst].mAFNum = monsterdata[mtype].mAFNum;
 	Monsters[monst].MData = &monsterdata[mtype];
 
-	if (monsterdata[mtype].has_trans) {
-		InitMonsterTRN(Monsters[monst]);
-	}
-
 	if (mtype >= MT_NMAGMA && mtype <= MT_WMAGMA && (MissileFileFlag & 1) == 0) {
 		MissileFileFlag |= 1;
 		LoadMissileGFX(MFILE_MAGBALL);
@@ -2424,7 +2445,7 @@ bool M_DoTalk(int i)
 			ObjChangeMap(setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 2, (setpc_h / 2) + setpc_y - 2);
 			tren = TransVal;
 			TransVal = 9;
-			DRLG_MRectTrans(setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
+			DRLG_MRectTrans(ActiveDungeon, setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
 			TransVal = tren;
 			quests[Q_LTBANNER]._qvar1 = 2;
 			if (quests[Q_LTBANNER]._qactive == QUEST_INIT)
@@ -4496,6 +4517,7 @@ void DeleteMonsterList()
 
 void ProcessMonsters()
 {
+	ProfileScope profileScope(ProfileStage::ProcessMonsters);
 	int i, mi, mx, my, _menemy;
 	bool raflag;
 	MonsterStruct *Monst;
@@ -5003,7 +5025,7 @@ void MissToMonst(int i, Point position)
 	MissileStruct *Miss;
 	MonsterStruct *Monst;
 
-	assurance((DWORD)i < MAXMISSILES, i);
+	assurance(i >= 0 && i < missile.capacity(), i);
 
 	Miss = &missile[i];
 	m = Miss->_misource;
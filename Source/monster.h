@@ -115,7 +115,7 @@ enum placeflag : uint8_t {
 };
 
 struct AnimStruct {
-	std::unique_ptr<byte[]> CMem;
+	std::shared_ptr<byte[]> CMem;
 	std::array<std::optional<CelSprite>, 8> CelSpritesForDirections;
 	int Frames;
 	int Rate;
@@ -13,10 +13,12 @@
 #include <fstream>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "appfat.h"
 #include "encrypt.h"
 #include "engine.h"
+#include "engine/compress_sectors.hpp"
 #include "utils/endian.hpp"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
@@ -543,65 +545,32 @@ static bool mpqapi_write_file_contents(const char *pszName, const byte *pbData,
 		pszName = tmp + 1;
 	Hash(pszName, 3);
 
-	constexpr size_t sectorSize = 4096;
-	const uint32_t num_sectors = (dwLen + (sectorSize - 1)) / sectorSize;
+	// The offset table and the compressed sectors are built in memory and written in one go.
+	static std::vector<byte> blockData;
+	CompressSectors(pbData, dwLen, blockData);
+	const uint32_t destsize = static_cast<uint32_t>(blockData.size());
+
+	const uint32_t num_sectors = (dwLen + (ArchiveSectorSize - 1)) / ArchiveSectorSize;
 	const uint32_t offset_table_bytesize = sizeof(uint32_t) * (num_sectors + 1);
 	pBlk->offset = mpqapi_find_free_block(dwLen + offset_table_bytesize, &pBlk->sizealloc);
 	pBlk->sizefile = dwLen;
 	pBlk->flags = 0x80000100;
 
-	// We populate the table of sector offset while we write the data.
-	// We can't pre-populate it because we don't know the compressed sector sizes yet.
-	// First offset is the start of the first sector, last offset is the end of the last sector.
-	std::unique_ptr<uint32_t[]> sectoroffsettable { new uint32_t[num_sectors + 1] };
-
-#ifdef CAN_SEEKP_BEYOND_EOF
-	if (!cur_archive.stream.seekp(pBlk->offset + offset_table_bytesize, std::ios::beg))
-		return false;
-#else
+#ifndef CAN_SEEKP_BEYOND_EOF
 	// Ensure we do not seekp beyond EOF by filling the missing space.
 	std::streampos stream_end;
 	if (!cur_archive.stream.seekp(0, std::ios::end) || !cur_archive.stream.tellp(&stream_end))
 		return false;
 	const std::uintmax_t cur_size = stream_end - cur_archive.stream_begin;
-	if (cur_size < pBlk->offset + offset_table_bytesize) {
-		if (cur_size < pBlk->offset) {
-			std::unique_ptr<char[]> filler { new char[pBlk->offset - cur_size] };
-			if (!cur_archive.stream.write(filler.get(), pBlk->offset - cur_size))
-				return false;
-		}
-		if (!cur_archive.stream.write(reinterpret_cast<const char *>(sectoroffsettable.get()), offset_table_bytesize))
-			return false;
-	} else {
-		if (!cur_archive.stream.seekp(pBlk->offset + offset_table_bytesize, std::ios::beg))
+	if (cur_size < pBlk->offset) {
+		std::unique_ptr<char[]> filler { new char[pBlk->offset - cur_size] };
+		if (!cur_archive.stream.write(filler.get(), pBlk->offset - cur_size))
 			return false;
 	}
 #endif
-
-	uint32_t destsize = offset_table_bytesize;
-	byte mpq_buf[sectorSize];
-	std::size_t cur_sector = 0;
-	while (true) {
-		uint32_t len = std::min(dwLen, sectorSize);
-		memcpy(mpq_buf, pbData, len);
-		pbData += len;
-		len = PkwareCompress(mpq_buf, len);
-		if (!cur_archive.stream.write((char *)mpq_buf, len))
-			return false;
-		sectoroffsettable[cur_sector++] = SDL_SwapLE32(destsize);
-		destsize += len; // compressed length
-		if (dwLen > sectorSize)
-			dwLen -= sectorSize;
-		else
-			break;
-	}
-
-	sectoroffsettable[num_sectors] = SDL_SwapLE32(destsize);
 	if (!cur_archive.stream.seekp(pBlk->offset, std::ios::beg))
 		return false;
-	if (!cur_archive.stream.write(reinterpret_cast<const char *>(sectoroffsettable.get()), offset_table_bytesize))
-		return false;
-	if (!cur_archive.stream.seekp(destsize - offset_table_bytesize, std::ios::cur))
+	if (!cur_archive.stream.write(reinterpret_cast<const char *>(blockData.data()), destsize))
 		return false;
 
 	if (destsize < pBlk->sizealloc) {
@@ -41,6 +41,8 @@ static DLevel sgLevels[NUMLEVELS];
 static BYTE sbLastCmd;
 static TMegaPkt *sgpCurrPkt;
 static byte sgRecvBuf[sizeof(DLevel) + 1];
+/** Decompressed contents of a received delta chunk */
+static byte sgDeltaBuf[sizeof(DLevel)];
 static BYTE sgbRecvCmd;
 static LocalLevel sgLocals[NUMLEVELS];
 static DJunk sgJunk;
@@ -341,12 +343,12 @@ static void DeltaImportJunk(byte *src)
 	}
 }
 
-static DWORD msg_comp_level(byte *buffer, byte *end)
+static DWORD msg_comp_level(const byte *src, const byte *srcEnd, byte *dst)
 {
-	DWORD size = end - buffer - 1;
-	DWORD pkSize = PkwareCompress(buffer + 1, size);
+	DWORD size = srcEnd - src;
+	DWORD pkSize = PkwareCompress(src, size, dst + 1);
 
-	*buffer = size != pkSize ? byte { 1 } : byte { 0 };
+	*dst = size != pkSize ? byte { 1 } : byte { 0 };
 
 	return pkSize + 1;
 }
@@ -355,19 +357,20 @@ void DeltaExportData(int pnum)
 {
 	if (sgbDeltaChanged) {
 		int size;
+		std::unique_ptr<byte[]> src { new byte[sizeof(DLevel)] };
 		std::unique_ptr<byte[]> dst { new byte[sizeof(DLevel) + 1] };
-		byte *dstEnd;
+		byte *srcEnd;
 		for (int i = 0; i < NUMLEVELS; i++) {
-			dstEnd = &dst[1];
-			dstEnd = DeltaExportItem(dstEnd, sgLevels[i].item);
-			dstEnd = DeltaExportObject(dstEnd, sgLevels[i].object);
-			dstEnd = DeltaExportMonster(dstEnd, sgLevels[i].monster);
-			size = msg_comp_level(dst.get(), dstEnd);
+			srcEnd = src.get();
+			srcEnd = DeltaExportItem(srcEnd, sgLevels[i].item);
+			srcEnd = DeltaExportObject(srcEnd, sgLevels[i].object);
+			srcEnd = DeltaExportMonster(srcEnd, sgLevels[i].monster);
+			size = msg_comp_level(src.get(), srcEnd, dst.get());
 			dthread_send_delta(pnum, static_cast<_cmd_id>(i + CMD_DLEVEL_0), dst.get(), size);
 		}
-		dstEnd = &dst[1];
-		dstEnd = DeltaExportJunk(dstEnd);
-		size = msg_comp_level(dst.get(), dstEnd);
+		srcEnd = src.get();
+		srcEnd = DeltaExportJunk(srcEnd);
+		size = msg_comp_level(src.get(), srcEnd, dst.get());
 		dthread_send_delta(pnum, CMD_DLEVEL_JUNK, dst.get(), size);
 	}
 	byte src { 0 };
@@ -376,10 +379,11 @@ void DeltaExportData(int pnum)
 
 static void DeltaImportData(BYTE cmd, DWORD recv_offset)
 {
-	if (sgRecvBuf[0] != byte { 0 })
-		PkwareDecompress(&sgRecvBuf[1], recv_offset, sizeof(sgRecvBuf) - 1);
-
 	byte *src = &sgRecvBuf[1];
+	if (sgRecvBuf[0] != byte { 0 }) {
+		PkwareDecompress(&sgRecvBuf[1], recv_offset, sgDeltaBuf, sizeof(sgDeltaBuf));
+		src = sgDeltaBuf;
+	}
 	if (cmd == CMD_DLEVEL_JUNK) {
 		DeltaImportJunk(src);
 	} else if (cmd >= CMD_DLEVEL_0 && cmd <= CMD_DLEVEL_24) {
@@ -26,6 +26,7 @@
 #include "track.h"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/profiler.h"
 
 namespace devilution {
 
@@ -950,7 +951,7 @@ void AddHookedBodies(int freq)
 				continue;
 			if (GenerateRnd(freq) != 0)
 				continue;
-			if (!SkipThemeRoom(i, j))
+			if (!SkipThemeRoom(ActiveDungeon, i, j))
 				continue;
 			if (dungeon[i][j] == 1 && dungeon[i + 1][j] == 6) {
 				switch (GenerateRnd(3)) {
@@ -2143,6 +2144,7 @@ void Obj_BCrossDamage(int i)
 
 void ProcessObjects()
 {
+	ProfileScope profileScope(ProfileStage::ProcessObjects);
 	int oi;
 	int i;
 
@@ -3005,7 +3007,7 @@ void OperateBookLever(int pnum, int i)
 				SpawnUnique(UITEM_OPTAMULET, Point { x, y } + Point { 5, 5 });
 				tren = TransVal;
 				TransVal = 9;
-				DRLG_MRectTrans(object[i]._oVar1, object[i]._oVar2, object[i]._oVar3, object[i]._oVar4);
+				DRLG_MRectTrans(ActiveDungeon, object[i]._oVar1, object[i]._oVar2, object[i]._oVar3, object[i]._oVar4);
 				TransVal = tren;
 			}
 		}
@@ -5286,7 +5288,7 @@ void SyncQSTLever(int i)
 		if (object[i]._otype == OBJ_BLINDBOOK) {
 			tren = TransVal;
 			TransVal = 9;
-			DRLG_MRectTrans(object[i]._oVar1, object[i]._oVar2, object[i]._oVar3, object[i]._oVar4);
+			DRLG_MRectTrans(ActiveDungeon, object[i]._oVar1, object[i]._oVar2, object[i]._oVar3, object[i]._oVar4);
 			TransVal = tren;
 		}
 	}
@@ -178,6 +178,9 @@ void LoadOptions()
 #endif
 	sgOptions.Graphics.bFPSLimit = getIniBool("Graphics", "FPS Limiter", true);
 	sgOptions.Graphics.bShowFPS = (getIniInt("Graphics", "Show FPS", 0) != 0);
+	sgOptions.Graphics.nSpriteCacheSize = getIniInt("Graphics", "Sprite Cache Size", 64);
+	sgOptions.Graphics.nTileCacheSize = getIniInt("Graphics", "Tile Cache Size", 4096);
+	sgOptions.Graphics.nRenderThreads = getIniInt("Graphics", "Render Threads", 1);
 
 	sgOptions.Gameplay.nTickRate = getIniInt("Game", "Speed", 20);
 	sgOptions.Gameplay.bRunInTown = getIniBool("Game", "Run in Town", false);
@@ -260,6 +263,9 @@ void SaveOptions()
 #endif
 	setIniValue("Graphics", "FPS Limiter", sgOptions.Graphics.bFPSLimit);
 	setIniValue("Graphics", "Show FPS", sgOptions.Graphics.bShowFPS);
+	setIniValue("Graphics", "Sprite Cache Size", sgOptions.Graphics.nSpriteCacheSize);
+	setIniValue("Graphics", "Tile Cache Size", sgOptions.Graphics.nTileCacheSize);
+	setIniValue("Graphics", "Render Threads", sgOptions.Graphics.nRenderThreads);
 
 	setIniValue("Game", "Speed", sgOptions.Gameplay.nTickRate);
 	setIniValue("Game", "Run in Town", sgOptions.Gameplay.bRunInTown);
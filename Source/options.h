@@ -67,6 +67,12 @@ struct GraphicsOptions {
 	bool bFPSLimit;
 	/** @brief Show FPS, even without the -f command line flag. */
 	bool bShowFPS;
+	/** @brief Megabytes of monster, player and missile graphics kept in memory between levels. */
+	int nSpriteCacheSize;
+	/** @brief Kilobytes of decoded and lit dungeon tiles kept for redrawing, 0 disables the tile cache. */
+	int nTileCacheSize;
+	/** @brief Number of threads drawing the floor tiles, 0 uses one per CPU core. */
+	int nRenderThreads;
 };
 
 struct GameplayOptions {
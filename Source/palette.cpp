@@ -6,6 +6,8 @@
 
 #include "dx.h"
 #include "engine/load_file.hpp"
+#include "engine/palette_match.hpp"
+#include "engine/table_cache.hpp"
 #include "hwcursor.hpp"
 #include "options.h"
 #include "utils/display.h"
@@ -66,41 +68,9 @@ void palette_init()
 	InitPalette();
 }
 
-static Uint8 FindBestMatchForColor(SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
-{
-	Uint8 best;
-	Uint32 bestDiff = SDL_MAX_UINT32;
-	for (int i = 0; i < 256; i++) {
-		if (i >= skipFrom && i <= skipTo)
-			continue;
-		int diffr = palette[i].r - color.r;
-		int diffg = palette[i].g - color.g;
-		int diffb = palette[i].b - color.b;
-		Uint32 diff = diffr * diffr + diffg * diffg + diffb * diffb;
-
-		if (bestDiff > diff) {
-			best = i;
-			bestDiff = diff;
-		}
-	}
-	return best;
-}
-
-/**
- * @brief Generate lookup table for transparency
- *
- * This is based of the same technique found in Quake2.
- *
- * To mimic 50% transparency we figure out what colors in the existing palette are the best match for the combination of any 2 colors.
- * We save this into a lookup table for use during rendering.
- *
- * @param palette The colors to operate on
- * @param skipFrom Do not use colors between this index and skipTo
- * @param skipTo Do not use colors between skipFrom and this index
- * @param toUpdate Only update the first n colors
- */
-static void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int skipTo, int toUpdate = 256)
+void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skipTo, int toUpdate /*= 256*/)
 {
+	PaletteMatcher matcher(palette, skipFrom, skipTo);
 	for (int i = 0; i < 256; i++) {
 		for (int j = 0; j < 256; j++) {
 			if (i == j) { // No need to calculate transparency between 2 identical colors
@@ -119,12 +89,31 @@ static void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int ski
 			blendedColor.r = ((int)palette[i].r + (int)palette[j].r) / 2;
 			blendedColor.g = ((int)palette[i].g + (int)palette[j].g) / 2;
 			blendedColor.b = ((int)palette[i].b + (int)palette[j].b) / 2;
-			Uint8 best = FindBestMatchForColor(palette, blendedColor, skipFrom, skipTo);
-			paletteTransparencyLookup[i][j] = best;
+			paletteTransparencyLookup[i][j] = matcher.FindBestMatch(blendedColor);
 		}
 	}
 }
 
+/**
+ * @brief Fill paletteTransparencyLookup from the table cache, or generate it and add it to the cache
+ */
+static void LoadBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skipTo)
+{
+	std::uint64_t key = TableKeySeed;
+	for (int i = 0; i < 256; i++) {
+		const Uint8 color[3] = { palette[i].r, palette[i].g, palette[i].b };
+		key = HashTableInput(key, color, sizeof(color));
+	}
+	const int32_t skipRange[2] = { skipFrom, skipTo };
+	key = HashTableInput(key, skipRange, sizeof(skipRange));
+
+	if (LoadCachedTable("blend", key, paletteTransparencyLookup, sizeof(paletteTransparencyLookup)))
+		return;
+
+	GenerateBlendedLookupTable(palette, skipFrom, skipTo);
+	StoreCachedTable("blend", key, paletteTransparencyLookup, sizeof(paletteTransparencyLookup));
+}
+
 void LoadPalette(const char *pszFileName, bool blend /*= true*/)
 {
 	assert(pszFileName);
@@ -150,11 +139,11 @@ void LoadPalette(const char *pszFileName, bool blend /*= true*/)
 
 	if (blend && sgOptions.Graphics.bBlendedTransparancy) {
 		if (leveltype == DTYPE_CAVES || leveltype == DTYPE_CRYPT) {
-			GenerateBlendedLookupTable(orig_palette, 1, 31);
+			LoadBlendedLookupTable(orig_palette, 1, 31);
 		} else if (leveltype == DTYPE_NEST) {
-			GenerateBlendedLookupTable(orig_palette, 1, 15);
+			LoadBlendedLookupTable(orig_palette, 1, 15);
 		} else {
-			GenerateBlendedLookupTable(orig_palette, -1, -1);
+			LoadBlendedLookupTable(orig_palette, -1, -1);
 		}
 	}
 }
@@ -399,6 +388,7 @@ void palette_update_quest_palette(int n)
 	palette_update();
 	if (sgOptions.Graphics.bBlendedTransparancy) {
 		// Update blended transparency, but only for the color that was updated
+		PaletteMatcher matcher(logical_palette, 1, 31);
 		for (int j = 0; j < 256; j++) {
 			if (i == j) { // No need to calculate transparency between 2 identical colors
 				paletteTransparencyLookup[i][j] = j;
@@ -408,8 +398,7 @@ void palette_update_quest_palette(int n)
 			blendedColor.r = ((int)logical_palette[i].r + (int)logical_palette[j].r) / 2;
 			blendedColor.g = ((int)logical_palette[i].g + (int)logical_palette[j].g) / 2;
 			blendedColor.b = ((int)logical_palette[i].b + (int)logical_palette[j].b) / 2;
-			Uint8 best = FindBestMatchForColor(logical_palette, blendedColor, 1, 31);
-			paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i] = best;
+			paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i] = matcher.FindBestMatch(blendedColor);
 		}
 	}
 }
@@ -5,35 +5,30 @@
  */
 #include "path.h"
 
+#include <array>
+#include <cstring>
+
 #include "gendung.h"
 
 namespace devilution {
 
-#define MAXPATHNODES 300
+/** For iterating over the 8 possible movement directions */
+const char pathxdir[8] = { -1, -1, 1, 1, -1, 0, 1, 0 };
+const char pathydir[8] = { -1, 1, -1, 1, 0, -1, 0, 1 };
+
+namespace {
 
-/** Notes visisted by the path finding algorithm. */
-PATHNODE path_nodes[MAXPATHNODES];
-/** size of the pnode_tblptr stack */
-int gdwCurPathStep;
-/** the number of in-use nodes in path_nodes */
-int gdwCurNodes;
 /**
- * for reconstructing the path after the A* search is done. The longest
- * possible path is actually 24 steps, even though we can fit 25
+ * @brief Maximum number of nodes a single search may create before giving up
+ *
+ * The original node pool held 300 entries, two of which were used as list heads.
  */
-int8_t pnode_vals[MAX_PATH_LENGTH];
-/** A linked list of all visited nodes */
-PATHNODE *pnode_ptr;
-/** A stack for recursively searching nodes */
-PATHNODE *pnode_tblptr[MAXPATHNODES];
-/** A linked list of the A* frontier, sorted by distance */
-PATHNODE *path_2_nodes;
+constexpr int MaxPathNodes = 298;
 
-/** For iterating over the 8 possible movement directions */
-const char pathxdir[8] = { -1, -1, 1, 1, -1, 0, 1, 0 };
-const char pathydir[8] = { -1, 1, -1, 1, 0, -1, 0, 1 };
+/** Number of buckets in the tile lookup table, a power of two comfortably larger than MaxPathNodes */
+constexpr unsigned NodeTableSize = 1024;
 
-/* data */
+constexpr int16_t NoNode = -1;
 
 /**
  * each step direction is assigned a number like this:
@@ -44,342 +39,332 @@ const char pathydir[8] = { -1, 1, -1, 1, 0, -1, 0, 1 };
  * dy 0|2 0 3
  *    1|8 4 7
  */
-int8_t path_directions[9] = { 5, 1, 6, 2, 0, 3, 8, 4, 7 };
-
-/**
- * find the shortest path from (sx,sy) to (dx,dy), using PosOk(PosOkArg,x,y) to
- * check that each step is a valid position. Store the step directions (see
- * path_directions) in path, which must have room for 24 steps
- */
-int FindPath(bool (*PosOk)(int, Point), int PosOkArg, int sx, int sy, int dx, int dy, int8_t path[MAX_PATH_LENGTH])
-{
-	PATHNODE *path_start, *next_node, *current;
-	int path_length, i;
-
-	// clear all nodes, create root nodes for the visited/frontier linked lists
-	gdwCurNodes = 0;
-	path_2_nodes = path_new_step();
-	pnode_ptr = path_new_step();
-	gdwCurPathStep = 0;
-	path_start = path_new_step();
-	path_start->g = 0;
-	path_start->h = path_get_h_cost(sx, sy, dx, dy);
-	path_start->position.x = sx;
-	path_start->f = path_start->h + path_start->g;
-	path_start->position.y = sy;
-	path_2_nodes->NextNode = path_start;
-	// A* search until we find (dx,dy) or fail
-	while ((next_node = GetNextPath()) != nullptr) {
-		// reached the end, success!
-		if (next_node->position.x == dx && next_node->position.y == dy) {
-			current = next_node;
-			path_length = 0;
-			while (current->Parent != nullptr) {
-				if (path_length >= MAX_PATH_LENGTH)
-					break;
-				pnode_vals[path_length++] = path_directions[3 * (current->position.y - current->Parent->position.y) - current->Parent->position.x + 4 + current->position.x];
-				current = current->Parent;
-			}
-			if (path_length != MAX_PATH_LENGTH) {
-				for (i = 0; i < path_length; i++)
-					path[i] = pnode_vals[path_length - i - 1];
-				return i;
-			}
-			return 0;
-		}
-		// ran out of nodes, abort!
-		if (!path_get_path(PosOk, PosOkArg, next_node, dx, dy))
-			return 0;
-	}
-	// frontier is empty, no path!
-	return 0;
-}
-
-/**
- * @brief heuristic, estimated cost from (sx,sy) to (dx,dy)
- */
-int path_get_h_cost(int sx, int sy, int dx, int dy)
-{
-	int delta_x = abs(sx - dx);
-	int delta_y = abs(sy - dy);
-
-	int min = delta_x < delta_y ? delta_x : delta_y;
-	int max = delta_x > delta_y ? delta_x : delta_y;
-
-	// see path_check_equal for why this is times 2
-	return 2 * (min + max);
-}
+const int8_t path_directions[9] = { 5, 1, 6, 2, 0, 3, 8, 4, 7 };
+
+struct PathNode {
+	uint8_t f;
+	uint8_t h;
+	uint8_t g;
+	Point position;
+	int16_t parent;
+	int16_t children[8];
+	/** Set once the node has been taken off the frontier */
+	bool explored;
+};
 
 /**
- * @brief return 2 if pPath is horizontally/vertically aligned with (dx,dy), else 3
+ * @brief return 2 if position is horizontally/vertically aligned with destination, else 3
  *
  * This approximates that diagonal movement on a square grid should have a cost
  * of sqrt(2). That's approximately 1.5, so they multiply all step costs by 2,
  * except diagonal steps which are times 3
  */
-int path_check_equal(PATHNODE *pPath, int dx, int dy)
+int path_check_equal(Point position, Point destination)
 {
-	if (pPath->position.x == dx || pPath->position.y == dy)
+	if (position.x == destination.x || position.y == destination.y)
 		return 2;
 
 	return 3;
 }
 
 /**
- * @brief get the next node on the A* frontier to explore (estimated to be closest to the goal), mark it as visited, and return it
- */
-PATHNODE *GetNextPath()
-{
-	PATHNODE *result;
-
-	result = path_2_nodes->NextNode;
-	if (result == nullptr) {
-		return result;
-	}
-
-	path_2_nodes->NextNode = result->NextNode;
-	result->NextNode = pnode_ptr->NextNode;
-	pnode_ptr->NextNode = result;
-	return result;
-}
-
-/**
- * @brief check if stepping from pPath to (dx,dy) cuts a corner.
- *
- * If you step from A to B, both Xs need to be clear:
+ * @brief State of a single A* search
  *
- *  AX
- *  XB
- *
- *  @return true if step is allowed
+ * Visited and frontier nodes share one fixed pool that lives with the search rather than in globals. Nodes are found
+ * by tile through an open addressing hash table instead of walking the frontier and visited lists.
  */
-bool path_solid_pieces(PATHNODE *pPath, int dx, int dy)
-{
-	bool rv = true;
-	switch (path_directions[3 * (dy - pPath->position.y) + 3 - pPath->position.x + 1 + dx]) {
-	case 5:
-		rv = !nSolidTable[dPiece[dx][dy + 1]] && !nSolidTable[dPiece[dx + 1][dy]];
-		break;
-	case 6:
-		rv = !nSolidTable[dPiece[dx][dy + 1]] && !nSolidTable[dPiece[dx - 1][dy]];
-		break;
-	case 7:
-		rv = !nSolidTable[dPiece[dx][dy - 1]] && !nSolidTable[dPiece[dx - 1][dy]];
-		break;
-	case 8:
-		rv = !nSolidTable[dPiece[dx + 1][dy]] && !nSolidTable[dPiece[dx][dy - 1]];
-		break;
+class PathFinder {
+public:
+	PathFinder(bool (*posOk)(int, Point), int posOkArg, Point destination)
+	    : posOk_(posOk)
+	    , posOkArg_(posOkArg)
+	    , destination_(destination)
+	{
+		nodeTable_.fill(NoNode);
 	}
-	return rv;
-}
 
-/**
- * @brief perform a single step of A* bread-first search by trying to step in every possible direction from pPath with goal (x,y). Check each step with PosOk
- *
- * @return false if we ran out of preallocated nodes to use, else true
- */
-bool path_get_path(bool (*PosOk)(int, Point), int PosOkArg, PATHNODE *pPath, int x, int y)
-{
-	int dx, dy;
-	int i;
-	bool ok;
-
-	for (i = 0; i < 8; i++) {
-		dx = pPath->position.x + pathxdir[i];
-		dy = pPath->position.y + pathydir[i];
-		ok = PosOk(PosOkArg, { dx, dy });
-		if ((ok && path_solid_pieces(pPath, dx, dy)) || (!ok && dx == x && dy == y)) {
-			if (!path_parent_path(pPath, dx, dy, x, y))
-				return false;
+	int Search(Point start, int8_t path[MAX_PATH_LENGTH])
+	{
+		int16_t startNode = NewNode(start);
+		PathNode &root = nodes_[startNode];
+		root.parent = NoNode;
+		root.g = 0;
+		root.h = path_get_h_cost(start.x, start.y, destination_.x, destination_.y);
+		root.f = root.h + root.g;
+		FrontierPush(startNode);
+
+		// A* search until we find the destination or fail
+		while (frontierSize_ > 0) {
+			int16_t current = FrontierPop();
+			// reached the end, success!
+			if (nodes_[current].position == destination_)
+				return ReconstructPath(current, path);
+			// ran out of nodes, abort!
+			if (!ExpandNode(current))
+				return 0;
 		}
+		// frontier is empty, no path!
+		return 0;
 	}
 
-	return true;
-}
-
-/**
- * @brief add a step from pPath to (dx,dy), return 1 if successful, and update the frontier/visited nodes accordingly
- *
- * @return true if step successfully added, false if we ran out of nodes to use
- */
-bool path_parent_path(PATHNODE *pPath, int dx, int dy, int sx, int sy)
-{
-	int next_g;
-	PATHNODE *dxdy;
-	int i;
-
-	next_g = pPath->g + path_check_equal(pPath, dx, dy);
-
-	// 3 cases to consider
-	// case 1: (dx,dy) is already on the frontier
-	dxdy = path_get_node1(dx, dy);
-	if (dxdy != nullptr) {
-		for (i = 0; i < 8; i++) {
-			if (pPath->Child[i] == nullptr)
-				break;
+private:
+	/**
+	 * @brief Store the step directions from the start to the given node, the path is discarded if it is too long
+	 */
+	int ReconstructPath(int16_t node, int8_t path[MAX_PATH_LENGTH]) const
+	{
+		int8_t steps[MAX_PATH_LENGTH];
+		int pathLength = 0;
+		while (nodes_[node].parent != NoNode) {
+			if (pathLength >= MAX_PATH_LENGTH)
+				return 0;
+			Point position = nodes_[node].position;
+			Point parentPosition = nodes_[nodes_[node].parent].position;
+			steps[pathLength++] = path_directions[3 * (position.y - parentPosition.y) - parentPosition.x + 4 + position.x];
+			node = nodes_[node].parent;
 		}
-		pPath->Child[i] = dxdy;
-		if (next_g < dxdy->g) {
-			if (path_solid_pieces(pPath, dx, dy)) {
-				// we'll explore it later, just update
-				dxdy->Parent = pPath;
-				dxdy->g = next_g;
-				dxdy->f = next_g + dxdy->h;
+		if (pathLength == MAX_PATH_LENGTH)
+			return 0;
+		for (int i = 0; i < pathLength; i++)
+			path[i] = steps[pathLength - i - 1];
+		return pathLength;
+	}
+
+	/**
+	 * @brief perform a single step of A* bread-first search by trying to step in every possible direction from the node. Check each step with PosOk
+	 *
+	 * @return false if we ran out of nodes to use, else true
+	 */
+	bool ExpandNode(int16_t node)
+	{
+		for (int i = 0; i < 8; i++) {
+			Point position = nodes_[node].position;
+			Point next = { position.x + pathxdir[i], position.y + pathydir[i] };
+			bool ok = posOk_(posOkArg_, next);
+			if ((ok && path_solid_pieces(position, next)) || (!ok && next == destination_)) {
+				if (!AddStep(node, next))
+					return false;
 			}
 		}
-	} else {
-		// case 2: (dx,dy) was already visited
-		dxdy = path_get_node2(dx, dy);
-		if (dxdy != nullptr) {
-			for (i = 0; i < 8; i++) {
-				if (pPath->Child[i] == nullptr)
-					break;
-			}
-			pPath->Child[i] = dxdy;
-			if (next_g < dxdy->g && path_solid_pieces(pPath, dx, dy)) {
-				// update the node
-				dxdy->Parent = pPath;
-				dxdy->g = next_g;
-				dxdy->f = next_g + dxdy->h;
+
+		return true;
+	}
+
+	/**
+	 * @brief add a step from the node to the given position, and update the frontier/visited nodes accordingly
+	 *
+	 * @return true if step successfully added, false if we ran out of nodes to use
+	 */
+	bool AddStep(int16_t node, Point next)
+	{
+		Point position = nodes_[node].position;
+		int nextG = nodes_[node].g + path_check_equal(position, next);
+
+		int16_t child = FindNode(next);
+		if (child != NoNode) {
+			AddChild(node, child);
+			PathNode &step = nodes_[child];
+			if (nextG < step.g && path_solid_pieces(position, next)) {
+				step.parent = node;
+				step.g = nextG;
+				step.f = nextG + step.h;
 				// already explored, so re-update others starting from that node
-				path_set_coords(dxdy);
+				if (step.explored)
+					PropagateCosts(child);
 			}
-		} else {
-			// case 3: (dx,dy) is totally new
-			dxdy = path_new_step();
-			if (dxdy == nullptr)
-				return false;
-			dxdy->Parent = pPath;
-			dxdy->g = next_g;
-			dxdy->h = path_get_h_cost(dx, dy, sx, sy);
-			dxdy->f = next_g + dxdy->h;
-			dxdy->position = { dx, dy };
-			// add it to the frontier
-			path_next_node(dxdy);
-
-			for (i = 0; i < 8; i++) {
-				if (pPath->Child[i] == nullptr)
+			return true;
+		}
+
+		child = NewNode(next);
+		if (child == NoNode)
+			return false;
+		PathNode &step = nodes_[child];
+		step.parent = node;
+		step.g = nextG;
+		step.h = path_get_h_cost(next.x, next.y, destination_.x, destination_.y);
+		step.f = nextG + step.h;
+		FrontierPush(child);
+		AddChild(node, child);
+
+		return true;
+	}
+
+	/**
+	 * @brief update all path costs using depth-first search starting at the given node
+	 */
+	void PropagateCosts(int16_t node)
+	{
+		std::array<int16_t, MaxPathNodes> stack;
+		int stackSize = 0;
+
+		stack[stackSize++] = node;
+		while (stackSize > 0) {
+			int16_t current = stack[--stackSize];
+			const PathNode &parent = nodes_[current];
+			for (int16_t child : parent.children) {
+				if (child == NoNode)
 					break;
+
+				PathNode &step = nodes_[child];
+				int nextG = parent.g + path_check_equal(parent.position, step.position);
+				if (nextG < step.g && path_solid_pieces(parent.position, step.position)) {
+					step.parent = current;
+					step.g = nextG;
+					step.f = nextG + step.h;
+					if (stackSize < MaxPathNodes)
+						stack[stackSize++] = child;
+				}
 			}
-			pPath->Child[i] = dxdy;
 		}
 	}
-	return true;
-}
 
-/**
- * @brief return a node for (dx,dy) on the frontier, or NULL if not found
- */
-PATHNODE *path_get_node1(int dx, int dy)
-{
-	PATHNODE *result = path_2_nodes->NextNode;
-	while (result != nullptr) {
-		if (result->position.x == dx && result->position.y == dy)
-			return result;
-		result = result->NextNode;
+	void AddChild(int16_t node, int16_t child)
+	{
+		for (int16_t &slot : nodes_[node].children) {
+			if (slot == NoNode) {
+				slot = child;
+				return;
+			}
+		}
 	}
-	return nullptr;
-}
 
-/**
- * @brief return a node for (dx,dy) if it was visited, or NULL if not found
- */
-PATHNODE *path_get_node2(int dx, int dy)
-{
-	PATHNODE *result = pnode_ptr->NextNode;
-	while (result != nullptr) {
-		if (result->position.x == dx && result->position.y == dy)
-			return result;
-		result = result->NextNode;
+	static unsigned TileBucket(Point position)
+	{
+		auto tile = static_cast<unsigned>(position.x * MAXDUNY + position.y);
+		return (tile * 2654435761U) >> 22;
 	}
-	return nullptr;
-}
 
-/**
- * @brief insert pPath into the frontier (keeping the frontier sorted by total distance)
- */
-void path_next_node(PATHNODE *pPath)
-{
-	PATHNODE *next = path_2_nodes;
-	if (path_2_nodes->NextNode == nullptr) {
-		path_2_nodes->NextNode = pPath;
-		return;
+	/**
+	 * @brief return the node for the given tile, or NoNode if it hasn't been reached yet
+	 */
+	int16_t FindNode(Point position) const
+	{
+		for (unsigned bucket = TileBucket(position);; bucket = (bucket + 1) % NodeTableSize) {
+			int16_t node = nodeTable_[bucket];
+			if (node == NoNode || nodes_[node].position == position)
+				return node;
+		}
 	}
 
-	PATHNODE *current = path_2_nodes;
-	next = path_2_nodes->NextNode;
-	int f = pPath->f;
-	while (next != nullptr && next->f < f) {
-		current = next;
-		next = next->NextNode;
+	/**
+	 * @brief initialize the next node in the pool for the given tile, or return NoNode if none are available
+	 */
+	int16_t NewNode(Point position)
+	{
+		if (nodeCount_ == MaxPathNodes)
+			return NoNode;
+
+		int16_t node = nodeCount_++;
+		PathNode &step = nodes_[node];
+		step.position = position;
+		for (int16_t &child : step.children)
+			child = NoNode;
+
+		unsigned bucket = TileBucket(position);
+		while (nodeTable_[bucket] != NoNode)
+			bucket = (bucket + 1) % NodeTableSize;
+		nodeTable_[bucket] = node;
+
+		return node;
 	}
-	pPath->NextNode = next;
-	current->NextNode = pPath;
-}
 
-/**
- * @brief update all path costs using depth-first search starting at pPath
- */
-void path_set_coords(PATHNODE *pPath)
-{
-	PATHNODE *PathOld;
-	PATHNODE *PathAct;
-	int i;
-
-	path_push_active_step(pPath);
-	// while there are path nodes to check
-	while (gdwCurPathStep > 0) {
-		PathOld = path_pop_active_step();
-		for (i = 0; i < 8; i++) {
-			PathAct = PathOld->Child[i];
-			if (PathAct == nullptr)
-				break;
-
-			if (PathOld->g + path_check_equal(PathOld, PathAct->position.x, PathAct->position.y) < PathAct->g) {
-				if (path_solid_pieces(PathOld, PathAct->position.x, PathAct->position.y)) {
-					PathAct->Parent = PathOld;
-					PathAct->g = PathOld->g + path_check_equal(PathOld, PathAct->position.x, PathAct->position.y);
-					PathAct->f = PathAct->g + PathAct->h;
-					path_push_active_step(PathAct);
-				}
-			}
-		}
+	/**
+	 * @brief insert the node into the frontier (keeping the frontier sorted by total distance)
+	 *
+	 * The frontier is stored with the closest node last so it can be popped without moving the rest. A node whose cost
+	 * is lowered while on the frontier keeps its place, exactly like the sorted linked list this replaces, so monsters
+	 * pick the same paths as before.
+	 */
+	void FrontierPush(int16_t node)
+	{
+		int index = frontierSize_;
+		while (index > 0 && nodes_[frontier_[index - 1]].f < nodes_[node].f)
+			index--;
+		memmove(frontier_.data() + index + 1, frontier_.data() + index, (frontierSize_ - index) * sizeof(frontier_[0]));
+		frontier_[index] = node;
+		frontierSize_++;
+		nodes_[node].explored = false;
 	}
-}
+
+	/**
+	 * @brief get the next node on the frontier to explore (estimated to be closest to the goal), mark it as visited, and return it
+	 */
+	int16_t FrontierPop()
+	{
+		int16_t node = frontier_[--frontierSize_];
+		nodes_[node].explored = true;
+		return node;
+	}
+
+	bool (*posOk_)(int, Point);
+	int posOkArg_;
+	Point destination_;
+
+	std::array<PathNode, MaxPathNodes> nodes_;
+	int16_t nodeCount_ = 0;
+	std::array<int16_t, MaxPathNodes> frontier_;
+	int frontierSize_ = 0;
+	std::array<int16_t, NodeTableSize> nodeTable_;
+};
+
+} // namespace
 
 /**
- * @brief push pPath onto the pnode_tblptr stack
+ * find the shortest path from (sx,sy) to (dx,dy), using PosOk(PosOkArg,x,y) to
+ * check that each step is a valid position. Store the step directions (see
+ * path_directions) in path, which must have room for 24 steps
  */
-void path_push_active_step(PATHNODE *pPath)
+int FindPath(bool (*PosOk)(int, Point), int PosOkArg, int sx, int sy, int dx, int dy, int8_t path[MAX_PATH_LENGTH])
 {
-	int stack_index = gdwCurPathStep;
-	gdwCurPathStep++;
-	pnode_tblptr[stack_index] = pPath;
+	PathFinder pathFinder(PosOk, PosOkArg, { dx, dy });
+	return pathFinder.Search({ sx, sy }, path);
 }
 
 /**
- * @brief pop and return a node from the pnode_tblptr stack
+ * @brief heuristic, estimated cost from (sx,sy) to (dx,dy)
  */
-PATHNODE *path_pop_active_step()
+int path_get_h_cost(int sx, int sy, int dx, int dy)
 {
-	gdwCurPathStep--;
-	return pnode_tblptr[gdwCurPathStep];
+	int delta_x = abs(sx - dx);
+	int delta_y = abs(sy - dy);
+
+	int min = delta_x < delta_y ? delta_x : delta_y;
+	int max = delta_x > delta_y ? delta_x : delta_y;
+
+	// see path_check_equal for why this is times 2
+	return 2 * (min + max);
 }
 
 /**
- * @brief zero one of the preallocated nodes and return a pointer to it, or NULL if none are available
+ * @brief check if stepping from a given position to a neighbouring tile cuts a corner.
+ *
+ * If you step from A to B, both Xs need to be clear:
+ *
+ *  AX
+ *  XB
+ *
+ *  @return true if step is allowed
  */
-PATHNODE *path_new_step()
+bool path_solid_pieces(Point startPosition, Point destinationPosition)
 {
-	PATHNODE *new_node;
-
-	if (gdwCurNodes == MAXPATHNODES)
-		return nullptr;
-
-	new_node = &path_nodes[gdwCurNodes];
-	gdwCurNodes++;
-	memset(new_node, 0, sizeof(PATHNODE));
-	return new_node;
+	bool rv = true;
+	const int dx = destinationPosition.x;
+	const int dy = destinationPosition.y;
+	switch (path_directions[3 * (dy - startPosition.y) + 3 - startPosition.x + 1 + dx]) {
+	case 5:
+		rv = !nSolidTable[dPiece[dx][dy + 1]] && !nSolidTable[dPiece[dx + 1][dy]];
+		break;
+	case 6:
+		rv = !nSolidTable[dPiece[dx][dy + 1]] && !nSolidTable[dPiece[dx - 1][dy]];
+		break;
+	case 7:
+		rv = !nSolidTable[dPiece[dx][dy - 1]] && !nSolidTable[dPiece[dx - 1][dy]];
+		break;
+	case 8:
+		rv = !nSolidTable[dPiece[dx + 1][dy]] && !nSolidTable[dPiece[dx][dy - 1]];
+		break;
+	}
+	return rv;
 }
 
 } // namespace devilution
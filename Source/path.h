@@ -13,29 +13,20 @@ namespace devilution {
 
 #define MAX_PATH_LENGTH 25
 
-struct PATHNODE {
-	uint8_t f;
-	uint8_t h;
-	uint8_t g;
-	Point position;
-	struct PATHNODE *Parent;
-	struct PATHNODE *Child[8];
-	struct PATHNODE *NextNode;
-};
-
+/**
+ * @brief Find the shortest path from (sx,sy) to (dx,dy)
+ *
+ * Each search keeps its state in its own context, so it is safe to call FindPath from within a PosOk callback
+ * or from several threads at once.
+ *
+ * @param PosOk Callback used to check that each step is a valid position
+ * @param PosOkArg First argument passed to PosOk
+ * @param path Receives the step directions, see path_directions
+ * @return Number of steps in the path, or 0 if no path was found
+ */
 int FindPath(bool (*PosOk)(int, Point), int PosOkArg, int sx, int sy, int dx, int dy, int8_t path[MAX_PATH_LENGTH]);
 int path_get_h_cost(int sx, int sy, int dx, int dy);
-PATHNODE *GetNextPath();
-bool path_solid_pieces(PATHNODE *pPath, int dx, int dy);
-bool path_get_path(bool (*PosOk)(int, Point), int PosOkArg, PATHNODE *pPath, int x, int y);
-bool path_parent_path(PATHNODE *pPath, int dx, int dy, int sx, int sy);
-PATHNODE *path_get_node1(int dx, int dy);
-PATHNODE *path_get_node2(int dx, int dy);
-void path_next_node(PATHNODE *pPath);
-void path_set_coords(PATHNODE *pPath);
-void path_push_active_step(PATHNODE *pPath);
-PATHNODE *path_pop_active_step();
-PATHNODE *path_new_step();
+bool path_solid_pieces(Point startPosition, Point destinationPosition);
 
 /* rdata */
 
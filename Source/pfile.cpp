@@ -5,10 +5,16 @@
  */
 #include "pfile.h"
 
+#include <array>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "codec.h"
+#include "config.h"
 #include "engine.h"
+#include "engine/table_cache.hpp"
 #include "init.h"
 #include "loadsave.h"
 #include "mainmenu.h"
@@ -29,6 +35,34 @@ namespace devilution {
 
 namespace {
 
+/** Path of the save archive that is open for writing */
+std::string OpenArchivePath;
+/** Slot of the save archive that is open for writing */
+uint32_t OpenArchiveSaveNum;
+/** Hash of the plain contents of every file written this session, keyed by archive path and file name */
+std::unordered_map<std::string, uint64_t> WrittenFiles;
+/** Files written since the archive was opened, moved to WrittenFiles once the archive is closed successfully */
+std::vector<std::pair<std::string, uint64_t>> PendingFiles;
+
+/** What the character selection screen shows for a save slot, cached so the archive doesn't have to be read */
+struct HeroSummary {
+	/** The summary matches the archive with the size and time below */
+	bool known;
+	/** The archive holds a readable hero */
+	bool hasHero;
+	/** Size of the archive when the summary was made, 0 if there was none */
+	std::uintmax_t archiveSize;
+	/** Modification time of the archive when the summary was made */
+	int64_t archiveTime;
+	char name[PLR_NAME_LEN];
+	_uiheroinfo info;
+};
+
+/** Summaries of every save slot, kept in the hero index next to the table caches */
+std::array<HeroSummary, MAX_CHARACTERS> HeroIndex;
+/** Cache key of the hero index that HeroIndex holds, 0 if none has been loaded */
+uint64_t HeroIndexKey;
+
 std::string GetSavePath(uint32_t save_num)
 {
 	std::string path = paths::PrefPath();
@@ -182,13 +216,47 @@ static void pfile_encode_hero(const PkPlayerStruct *pack)
 	std::unique_ptr<byte[]> packed { new byte[packedLen] };
 
 	memcpy(packed.get(), pack, sizeof(*pack));
-	codec_encode(packed.get(), sizeof(*pack), packedLen, pfile_get_password());
-	mpqapi_write_file("hero", packed.get(), packedLen);
+	pfile_write_save_file("hero", packed.get(), sizeof(*pack));
 }
 
 static bool pfile_open_archive(uint32_t save_num)
 {
-	return OpenMPQ(GetSavePath(save_num).c_str());
+	OpenArchivePath = GetSavePath(save_num);
+	OpenArchiveSaveNum = save_num;
+	PendingFiles.clear();
+	return OpenMPQ(OpenArchivePath.c_str());
+}
+
+/**
+ * @brief Write the archive tables and close it, remembering the files written if that succeeds
+ */
+static void pfile_close_archive(bool clear_tables)
+{
+	if (OpenArchiveSaveNum < MAX_CHARACTERS)
+		HeroIndex[OpenArchiveSaveNum].known = false;
+	if (mpqapi_flush_and_close(clear_tables)) {
+		for (auto &file : PendingFiles)
+			WrittenFiles[file.first] = file.second;
+	}
+	PendingFiles.clear();
+}
+
+void pfile_write_save_file(const char *pszName, byte *pbData, size_t dwLen)
+{
+	std::string key = OpenArchivePath;
+	key.push_back('\\');
+	key.append(pszName);
+	const uint64_t hash = HashTableInput(TableKeySeed, pbData, dwLen);
+
+	auto written = WrittenFiles.find(key);
+	if (written != WrittenFiles.end() && written->second == hash && mpqapi_has_file(pszName))
+		return;
+
+	const size_t encodedLen = codec_get_encoded_len(dwLen);
+	codec_encode(pbData, dwLen, encodedLen, pfile_get_password());
+	WrittenFiles.erase(key);
+	if (mpqapi_write_file(pszName, pbData, encodedLen))
+		PendingFiles.emplace_back(std::move(key), hash);
 }
 
 static HANDLE pfile_open_save_archive(uint32_t save_num)
@@ -219,7 +287,7 @@ PFileScopedArchiveWriter::PFileScopedArchiveWriter(bool clear_tables)
 
 PFileScopedArchiveWriter::~PFileScopedArchiveWriter()
 {
-	mpqapi_flush_and_close(clear_tables_);
+	pfile_close_archive(clear_tables_);
 }
 
 void pfile_write_hero(bool write_game_data, bool clear_tables)
@@ -254,38 +322,102 @@ static void game_2_ui_player(const PlayerStruct &player, _uiheroinfo *heroinfo,
 	heroinfo->spawned = gbIsSpawn;
 }
 
+/**
+ * @brief Read the hero of a save slot from its archive to refresh the summary
+ */
+static void pfile_read_hero_summary(uint32_t save_num, HeroSummary *summary)
+{
+	HANDLE archive = pfile_open_save_archive(save_num);
+	if (archive == nullptr)
+		return;
+
+	PkPlayerStruct pkplr;
+	if (pfile_read_hero(archive, &pkplr)) {
+		strcpy(summary->name, pkplr.pName);
+		bool hasSaveGame = pfile_archive_contains_game(archive);
+		if (hasSaveGame)
+			pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
+
+		UnPackPlayer(&pkplr, 0, false);
+
+		pfile_SFileCloseArchive(&archive);
+		LoadHeroItems(plr[0]);
+		RemoveEmptyInventory(plr[0]);
+		CalcPlrInv(0, false);
+
+		game_2_ui_player(plr[0], &summary->info, hasSaveGame);
+		summary->hasHero = true;
+	}
+	pfile_SFileCloseArchive(&archive);
+}
+
+/**
+ * @brief Cache key of the hero index for the current game mode
+ *
+ * Saves of each mode live in their own archives, and the summaries depend on the game version.
+ */
+static uint64_t pfile_get_hero_index_key()
+{
+	uint64_t key = HashTableInput(TableKeySeed, PROJECT_VERSION, sizeof(PROJECT_VERSION));
+	const std::string savePath = GetSavePath(0);
+	key = HashTableInput(key, savePath.data(), savePath.size());
+	const bool vanilla = gbVanilla;
+	key = HashTableInput(key, &vanilla, sizeof(vanilla));
+	const uint32_t summarySize = sizeof(HeroSummary);
+	return HashTableInput(key, &summarySize, sizeof(summarySize));
+}
+
 bool pfile_ui_set_hero_infos(bool (*ui_add_hero_info)(_uiheroinfo *))
 {
 	memset(hero_names, 0, sizeof(hero_names));
 
+	const uint64_t indexKey = pfile_get_hero_index_key();
+	if (HeroIndexKey != indexKey) {
+		if (!LoadCachedTable("heroes", indexKey, HeroIndex.data(), sizeof(HeroIndex)))
+			memset(HeroIndex.data(), 0, sizeof(HeroIndex));
+		HeroIndexKey = indexKey;
+	}
+
+	bool indexChanged = false;
 	for (uint32_t i = 0; i < MAX_CHARACTERS; i++) {
-		HANDLE archive = pfile_open_save_archive(i);
-		if (archive != nullptr) {
-			PkPlayerStruct pkplr;
-			if (pfile_read_hero(archive, &pkplr)) {
-				_uiheroinfo uihero;
-				strcpy(hero_names[i], pkplr.pName);
-				bool hasSaveGame = pfile_archive_contains_game(archive);
-				if (hasSaveGame)
-					pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
-
-				UnPackPlayer(&pkplr, 0, false);
-
-				pfile_SFileCloseArchive(&archive);
-				LoadHeroItems(plr[0]);
-				RemoveEmptyInventory(plr[0]);
-				CalcPlrInv(0, false);
-
-				game_2_ui_player(plr[0], &uihero, hasSaveGame);
-				ui_add_hero_info(&uihero);
-			}
-			pfile_SFileCloseArchive(&archive);
+		std::uintmax_t archiveSize = 0;
+		int64_t archiveTime = 0;
+		if (!GetFileSizeAndTime(GetSavePath(i).c_str(), &archiveSize, &archiveTime)) {
+			archiveSize = 0;
+			archiveTime = 0;
+		}
+
+		HeroSummary &summary = HeroIndex[i];
+		if (!summary.known || summary.archiveSize != archiveSize || summary.archiveTime != archiveTime) {
+			memset(&summary, 0, sizeof(summary));
+			if (archiveSize != 0)
+				pfile_read_hero_summary(i, &summary);
+			summary.known = true;
+			summary.archiveSize = archiveSize;
+			summary.archiveTime = archiveTime;
+			indexChanged = true;
+		}
+
+		if (summary.hasHero) {
+			strcpy(hero_names[i], summary.name);
+			_uiheroinfo uihero = summary.info;
+			ui_add_hero_info(&uihero);
 		}
 	}
 
+	if (indexChanged)
+		StoreCachedTable("heroes", indexKey, HeroIndex.data(), sizeof(HeroIndex));
+
 	return true;
 }
 
+void pfile_reset_hero_index(bool removeCachedIndex)
+{
+	HeroIndexKey = 0;
+	if (removeCachedIndex)
+		RemoveCachedTable("heroes", pfile_get_hero_index_key());
+}
+
 bool pfile_archive_contains_game(HANDLE hsArchive)
 {
 	if (gbIsMultiplayer)
@@ -339,7 +471,7 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 		SaveHeroItems(player);
 	}
 
-	mpqapi_flush_and_close(true);
+	pfile_close_archive(true);
 	return true;
 }
 
@@ -361,6 +493,8 @@ bool pfile_get_file_name(uint8_t lvl, char *dst)
 			fmt = "game";
 		else if (lvl == giNumberOfLevels * 2 + 1)
 			fmt = "hero";
+		else if (lvl < giNumberOfLevels * 2 + 2 + NumGameGridFiles)
+			fmt = GameGridFileNames[lvl - giNumberOfLevels * 2 - 2];
 		else
 			return false;
 	}
@@ -373,6 +507,7 @@ bool pfile_delete_save(_uiheroinfo *hero_info)
 	uint32_t save_num = pfile_get_save_num_from_name(hero_info->name);
 	if (save_num < MAX_CHARACTERS) {
 		hero_names[save_num][0] = '\0';
+		HeroIndex[save_num].known = false;
 		RemoveFile(GetSavePath(save_num).c_str());
 	}
 	return true;
@@ -414,7 +549,7 @@ bool LevelFileExists()
 		app_fatal("%s", _("Unable to read to save file archive"));
 
 	bool has_file = mpqapi_has_file(szName);
-	mpqapi_flush_and_close(true);
+	pfile_close_archive(true);
 	return has_file;
 }
 
@@ -434,7 +569,7 @@ void GetPermLevelNames(char *szPerm)
 		app_fatal("%s", _("Unable to read to save file archive"));
 
 	bool has_file = mpqapi_has_file(szPerm);
-	mpqapi_flush_and_close(true);
+	pfile_close_archive(true);
 	if (!has_file) {
 		if (setlevel)
 			sprintf(szPerm, "perms%02d", setlvlnum);
@@ -452,7 +587,7 @@ void pfile_remove_temp_files()
 	if (!pfile_open_archive(save_num))
 		app_fatal("%s", _("Unable to write to save file archive"));
 	mpqapi_remove_hash_entries(GetTempSaveNames);
-	mpqapi_flush_and_close(true);
+	pfile_close_archive(true);
 }
 
 std::unique_ptr<byte[]> pfile_read(const char *pszName, size_t *pdwLen)
@@ -28,8 +28,22 @@ private:
 };
 
 const char *pfile_get_password();
+/**
+ * @brief Encode a file and write it to the save archive that is open for writing
+ *
+ * Nothing is written if the archive still holds the file with the same contents, as written earlier this session.
+ * @param pszName Name of the file in the archive
+ * @param pbData Plain contents, encoded in place so the buffer must have room for codec_get_encoded_len(dwLen) bytes
+ * @param dwLen Size of the plain contents
+ */
+void pfile_write_save_file(const char *pszName, byte *pbData, size_t dwLen);
 void pfile_write_hero(bool write_game_data = false, bool clear_tables = !gbIsMultiplayer);
 bool pfile_ui_set_hero_infos(bool (*ui_add_hero_info)(_uiheroinfo *));
+/**
+ * @brief Drop the hero index held in memory, so the next pfile_ui_set_hero_infos reads it from the config folder
+ * @param removeCachedIndex Also delete the index stored in the config folder
+ */
+void pfile_reset_hero_index(bool removeCachedIndex = false);
 bool pfile_archive_contains_game(HANDLE hsArchive);
 void pfile_ui_set_class_stats(unsigned int player_class_nr, _uidefaultstats *class_stats);
 bool pfile_ui_save_create(_uiheroinfo *heroinfo);
@@ -11,6 +11,7 @@
 #include "dead.h"
 #include "engine/cel_header.hpp"
 #include "engine/load_file.hpp"
+#include "engine/sprite_cache.hpp"
 #include "gamemenu.h"
 #include "init.h"
 #include "lighting.h"
@@ -25,6 +26,7 @@
 #include "towners.h"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/profiler.h"
 
 namespace devilution {
 
@@ -575,10 +577,9 @@ void PlayerStruct::Reset()
 	*this = std::move(*emptyPlayer);
 }
 
-void SetPlayerGPtrs(const char *path, std::unique_ptr<byte[]> &data, std::array<std::optional<CelSprite>, 8> &anim, int width)
+void SetPlayerGPtrs(const char *path, std::shared_ptr<byte[]> &data, std::array<std::optional<CelSprite>, 8> &anim, int width)
 {
-	data = nullptr;
-	data = LoadFileInMem(path);
+	data = LoadSpriteData(path);
 
 	for (int i = 0; i < 8; i++) {
 		byte *pCelStart = CelGetFrame(data.get(), i);
@@ -3417,6 +3418,7 @@ static void CheckCheatStats(PlayerStruct &player)
 
 void ProcessPlayers()
 {
+	ProfileScope profileScope(ProfileStage::ProcessPlayers);
 	if ((DWORD)myplr >= MAX_PLRS) {
 		app_fatal("ProcessPlayers: illegal player %i", myplr);
 	}
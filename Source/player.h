@@ -159,9 +159,9 @@ struct PlayerAnimationData {
 	std::array<std::optional<CelSprite>, 8> CelSpritesForDirections;
 	/**
 	 * @brief Raw Data (binary) of the CL2 file.
-	 *        Is referenced from CelSprite in CelSpritesForDirections
+	 *        Is referenced from CelSprite in CelSpritesForDirections, shared with other players using the same graphics
 	 */
-	std::unique_ptr<byte[]> RawData;
+	std::shared_ptr<byte[]> RawData;
 };
 
 struct PlayerStruct {
@@ -110,6 +110,11 @@ void DrawXPBar(const CelOutputBuffer &out)
 	DrawEndCap(out, { xPos + static_cast<int>(fullBar), yPos }, fade, SILVER_GRADIENT);
 }
 
+Rectangle GetXPBarRect()
+{
+	return { { PANEL_LEFT + PANEL_WIDTH / 2 - 155, PANEL_TOP + PANEL_HEIGHT - 11 }, { BACK_WIDTH, BACK_HEIGHT } };
+}
+
 bool CheckXPBarInfo()
 {
 	if (!sgOptions.Gameplay.bExperienceBar)
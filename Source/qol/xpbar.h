@@ -5,6 +5,8 @@
 */
 #pragma once
 
+#include "engine/rectangle.hpp"
+
 namespace devilution {
 
 struct CelOutputBuffer;
@@ -15,4 +17,9 @@ void FreeXPBar();
 void DrawXPBar(const CelOutputBuffer &out);
 bool CheckXPBarInfo();
 
+/**
+ * @brief Screen area covered by the XP bar
+ */
+Rectangle GetXPBarRect();
+
 } // namespace devilution
@@ -299,7 +299,12 @@ bool QuestStatus(int i)
 {
 	if (setlevel)
 		return false;
-	if (currlevel != quests[i]._qlevel)
+	return QuestStatus(i, currlevel);
+}
+
+bool QuestStatus(int i, int level)
+{
+	if (level != quests[i]._qlevel)
 		return false;
 	if (quests[i]._qactive == QUEST_NOTAVAIL)
 		return false;
@@ -365,77 +370,77 @@ void CheckQuestKill(int m, bool sendmsg)
 	}
 }
 
-void DrawButcher()
+void DrawButcher(DungeonContext &ctx)
 {
 	int x, y;
 
-	x = 2 * setpc_x + 16;
-	y = 2 * setpc_y + 16;
-	DRLG_RectTrans(x + 3, y + 3, x + 10, y + 10);
+	x = 2 * ctx.setpc_x + 16;
+	y = 2 * ctx.setpc_y + 16;
+	DRLG_RectTrans(ctx, x + 3, y + 3, x + 10, y + 10);
 }
 
-void DrawSkelKing(int q, int x, int y)
+void DrawSkelKing(DungeonContext &ctx, int x, int y)
 {
-	quests[q].position = { 2 * x + 28, 2 * y + 23 };
+	ctx.skelKingPosition = Point { 2 * x + 28, 2 * y + 23 };
 }
 
-void DrawWarLord(int x, int y)
+void DrawWarLord(DungeonContext &ctx, int x, int y)
 {
 	auto dunData = LoadFileInMem<uint16_t>("Levels\\L4Data\\Warlord2.DUN");
 
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
 
-	setpc_x = x;
-	setpc_y = y;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = x;
+	ctx.setpc_y = y;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
 	const uint16_t *tileLayer = &dunData[2];
 
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
-			dungeon[x + i][y + j] = (tileId != 0) ? tileId : 6;
+			ctx.dungeon[x + i][y + j] = (tileId != 0) ? tileId : 6;
 		}
 	}
 }
 
-void DrawSChamber(int q, int x, int y)
+void DrawSChamber(DungeonContext &ctx, int x, int y)
 {
 	auto dunData = LoadFileInMem<uint16_t>("Levels\\L2Data\\Bonestr1.DUN");
 
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
 
-	setpc_x = x;
-	setpc_y = y;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = x;
+	ctx.setpc_y = y;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
 	const uint16_t *tileLayer = &dunData[2];
 
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
-			dungeon[x + i][y + j] = (tileId != 0) ? tileId : 3;
+			ctx.dungeon[x + i][y + j] = (tileId != 0) ? tileId : 3;
 		}
 	}
 
-	quests[q].position = { 2 * x + 22, 2 * y + 23 };
+	ctx.sChamberPosition = Point { 2 * x + 22, 2 * y + 23 };
 }
 
-void DrawLTBanner(int x, int y)
+void DrawLTBanner(DungeonContext &ctx, int x, int y)
 {
 	auto dunData = LoadFileInMem<uint16_t>("Levels\\L1Data\\Banner1.DUN");
 
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
 
-	setpc_x = x;
-	setpc_y = y;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = x;
+	ctx.setpc_y = y;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
 	const uint16_t *tileLayer = &dunData[2];
 
@@ -443,23 +448,23 @@ void DrawLTBanner(int x, int y)
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				pdungeon[x + i][y + j] = tileId;
+				ctx.pdungeon[x + i][y + j] = tileId;
 			}
 		}
 	}
 }
 
-void DrawBlind(int x, int y)
+void DrawBlind(DungeonContext &ctx, int x, int y)
 {
 	auto dunData = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blind1.DUN");
 
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
 
-	setpc_x = x;
-	setpc_y = y;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = x;
+	ctx.setpc_y = y;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
 	const uint16_t *tileLayer = &dunData[2];
 
@@ -467,23 +472,23 @@ void DrawBlind(int x, int y)
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				pdungeon[x + i][y + j] = tileId;
+				ctx.pdungeon[x + i][y + j] = tileId;
 			}
 		}
 	}
 }
 
-void DrawBlood(int x, int y)
+void DrawBlood(DungeonContext &ctx, int x, int y)
 {
 	auto dunData = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blood2.DUN");
 
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
 
-	setpc_x = x;
-	setpc_y = y;
-	setpc_w = width;
-	setpc_h = height;
+	ctx.setpc_x = x;
+	ctx.setpc_y = y;
+	ctx.setpc_w = width;
+	ctx.setpc_h = height;
 
 	const uint16_t *tileLayer = &dunData[2];
 
@@ -491,45 +496,62 @@ void DrawBlood(int x, int y)
 		for (int i = 0; i < width; i++) {
 			uint8_t tileId = SDL_SwapLE16(tileLayer[j * width + i]);
 			if (tileId != 0) {
-				dungeon[x + i][y + j] = tileId;
+				ctx.dungeon[x + i][y + j] = tileId;
 			}
 		}
 	}
 }
 
-void DRLG_CheckQuests(int x, int y)
+void DRLG_CheckQuests(DungeonContext &ctx, int x, int y)
 {
 	int i;
 
 	for (i = 0; i < MAXQUESTS; i++) {
-		if (QuestStatus(i)) {
+		if (QuestStatus(i, ctx.currlevel)) {
 			switch (quests[i]._qtype) {
 			case Q_BUTCHER:
-				DrawButcher();
+				DrawButcher(ctx);
 				break;
 			case Q_LTBANNER:
-				DrawLTBanner(x, y);
+				DrawLTBanner(ctx, x, y);
 				break;
 			case Q_BLIND:
-				DrawBlind(x, y);
+				DrawBlind(ctx, x, y);
 				break;
 			case Q_BLOOD:
-				DrawBlood(x, y);
+				DrawBlood(ctx, x, y);
 				break;
 			case Q_WARLORD:
-				DrawWarLord(x, y);
+				DrawWarLord(ctx, x, y);
 				break;
 			case Q_SKELKING:
-				DrawSkelKing(i, x, y);
+				DrawSkelKing(ctx, x, y);
 				break;
 			case Q_SCHAMB:
-				DrawSChamber(i, x, y);
+				DrawSChamber(ctx, x, y);
 				break;
 			}
 		}
 	}
 }
 
+void ApplyDungeonQuestPositions(DungeonContext &ctx)
+{
+	if (ctx.pwaterPosition)
+		quests[Q_PWATER].position = *ctx.pwaterPosition;
+	if (ctx.skelKingPosition)
+		quests[Q_SKELKING].position = *ctx.skelKingPosition;
+	if (ctx.sChamberPosition)
+		quests[Q_SCHAMB].position = *ctx.sChamberPosition;
+	if (ctx.betrayerPosition)
+		quests[Q_BETRAYER].position = *ctx.betrayerPosition;
+
+	ctx.pwaterPosition = std::nullopt;
+	ctx.skelKingPosition = std::nullopt;
+	ctx.sChamberPosition = std::nullopt;
+	ctx.betrayerPosition = std::nullopt;
+}
+
 void SetReturnLvlPos()
 {
 	switch (setlvlnum) {
@@ -662,7 +684,7 @@ void ResyncQuests()
 				SyncObjectAnim(objectactive[i]);
 			tren = TransVal;
 			TransVal = 9;
-			DRLG_MRectTrans(setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
+			DRLG_MRectTrans(ActiveDungeon, setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
 			TransVal = tren;
 		}
 		if (quests[Q_LTBANNER]._qvar1 == 3) {
@@ -673,7 +695,7 @@ void ResyncQuests()
 				SyncObjectAnim(objectactive[i]);
 			tren = TransVal;
 			TransVal = 9;
-			DRLG_MRectTrans(setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
+			DRLG_MRectTrans(ActiveDungeon, setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 4, setpc_y + (setpc_h / 2));
 			TransVal = tren;
 		}
 	}
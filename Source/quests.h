@@ -80,8 +80,16 @@ void InitQuests();
 void CheckQuests();
 bool ForceQuests();
 bool QuestStatus(int i);
+/**
+ * @brief Check if a quest takes place on the given dungeon level, regardless of the level being played
+ */
+bool QuestStatus(int i, int level);
 void CheckQuestKill(int m, bool sendmsg);
-void DRLG_CheckQuests(int x, int y);
+void DRLG_CheckQuests(DungeonContext &ctx, int x, int y);
+/**
+ * @brief Move the quest entrances placed while generating a level into quests[], must run on the main thread
+ */
+void ApplyDungeonQuestPositions(DungeonContext &ctx);
 void SetReturnLvlPos();
 void GetReturnLvlPos();
 void LoadPWaterPalette();
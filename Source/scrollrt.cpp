@@ -4,14 +4,22 @@
  * Implementation of functionality for rendering the dungeons, monsters and calling other render routines.
  */
 
+#include <unordered_map>
+
 #include "automap.h"
 #include "cursor.h"
 #include "dead.h"
 #include "doom.h"
 #include "dx.h"
+#include "engine/cel_header.hpp"
+#include "engine/dirty_region.hpp"
+#include "engine/load_file.hpp"
+#include "engine/occlusion_map.hpp"
 #include "engine/render/cel_render.hpp"
 #include "engine/render/cl2_render.hpp"
 #include "engine/render/dun_render.hpp"
+#include "engine/render/output_convert.hpp"
+#include "engine/render/render_bands.hpp"
 #include "engine/render/text_render.hpp"
 #include "error.h"
 #include "gmenu.h"
@@ -31,6 +39,7 @@
 #include "towners.h"
 #include "utils/endian.hpp"
 #include "utils/log.hpp"
+#include "utils/profiler.h"
 
 #ifdef _DEBUG
 #include "debug.h"
@@ -41,7 +50,7 @@ namespace devilution {
 /**
  * Specifies the current light entry.
  */
-int light_table_index;
+thread_local int light_table_index;
 uint32_t sgdwCursWdtOld;
 int sgdwCursX;
 int sgdwCursY;
@@ -56,32 +65,95 @@ uint32_t sgdwCursHgt;
  * frameNum  := block & 0x0FFF
  * frameType := block & 0x7000 >> 12
  */
-uint32_t level_cel_block;
+thread_local uint32_t level_cel_block;
 int sgdwCursXOld;
 int sgdwCursYOld;
 bool AutoMapShowItems;
 /**
  * Specifies the type of arches to render.
  */
-char arch_draw_type;
+thread_local char arch_draw_type;
 /**
  * Specifies whether transparency is active for the current CEL file being decoded.
  */
-bool cel_transparency_active;
+thread_local bool cel_transparency_active;
 /**
  * Specifies whether foliage (tile has extra content that overlaps previous tile) being rendered.
  */
-bool cel_foliage_active = false;
+thread_local bool cel_foliage_active = false;
 /**
  * Specifies the current dungeon piece ID of the level, as used during rendering of the level tiles.
  */
-int level_piece_id;
+thread_local int level_piece_id;
 uint32_t sgdwCursWdt;
 void (*DrawPlrProc)(int, int, int, int, int, BYTE *, int, int, int, int);
 BYTE sgSaveBack[8192];
 uint32_t sgdwCursHgtOld;
 
 bool dRendered[MAXDUNX][MAXDUNY];
+bool CullOccludedSprites = true;
+
+namespace {
+
+/** Parts of the screen that the level tiles of the current frame paint over */
+OcclusionMap Occluders;
+/** Number of level tiles drawn so far in the current frame */
+int TileDrawOrder;
+/** Set while walking the tiles to collect occluders, nothing is drawn during that pass */
+bool CollectingOccluders;
+/** Measured heights of sprite frames, by the address of the frame data */
+std::unordered_map<const byte *, int> SpriteHeights;
+/** GetLoadedFileCount() when SpriteHeights was last emptied */
+uint32_t SpriteHeightsFileCount;
+
+/**
+ * @brief Get the height of a sprite frame, it is only measured the first time the frame is drawn
+ */
+int GetSpriteHeight(const CelSprite &cel, int frame, bool cl2)
+{
+	// Sprite data doesn't change once loaded, but a newly loaded file can take the place of a freed one
+	const uint32_t fileCount = GetLoadedFileCount();
+	if (fileCount != SpriteHeightsFileCount) {
+		SpriteHeights.clear();
+		SpriteHeightsFileCount = fileCount;
+	}
+
+	int frameSize;
+	const byte *frameData = CelGetFrame(cel.Data(), frame, &frameSize);
+	auto it = SpriteHeights.find(frameData);
+	if (it != SpriteHeights.end())
+		return it->second;
+
+	const int height = cl2 ? MeasureCl2Height(cel, frame) : MeasureCelHeight(cel, frame);
+	SpriteHeights.emplace(frameData, height);
+	return height;
+}
+
+/**
+ * @brief Check if level tiles that are still to be drawn will cover every pixel of a sprite
+ * @param position Output buffer coordinate of the bottom left corner of the sprite
+ * @param cel CEL or CL2 sprite
+ * @param frame Frame number
+ * @param cl2 The sprite is a CL2 rather than a CEL with frame headers
+ * @param outlined The sprite also gets an outline, which reaches one pixel further out
+ */
+bool IsSpriteOccluded(Point position, const CelSprite &cel, int frame, bool cl2, bool outlined = false)
+{
+	if (!CullOccludedSprites)
+		return false;
+
+	const int margin = outlined ? 1 : 0;
+	const int width = cel.Width(frame) + 2 * margin;
+
+	// Most sprites are in plain sight, rule those out before measuring the frame
+	if (!Occluders.IsHidden({ { position.x - margin, position.y + margin }, { width, 1 } }, TileDrawOrder))
+		return false;
+
+	const int height = GetSpriteHeight(cel, frame, cl2) + 2 * margin;
+	return Occluders.IsHidden({ { position.x - margin, position.y + margin - height + 1 }, { width, height } }, TileDrawOrder);
+}
+
+} // namespace
 
 int frames;
 bool frameflag;
@@ -259,6 +331,8 @@ void DrawMissilePrivate(const CelOutputBuffer &out, MissileStruct *m, int sx, in
 	int mx = sx + m->position.offset.x - m->_miAnimWidth2;
 	int my = sy + m->position.offset.y;
 	CelSprite cel { m->_miAnimData, m->_miAnimWidth };
+	if (IsSpriteOccluded({ mx, my }, cel, m->_miAnimFrame, true))
+		return;
 	if (m->_miUniqTrans != 0)
 		Cl2DrawLightTbl(out, mx, my, cel, m->_miAnimFrame, m->_miUniqTrans + 3);
 	else if (m->_miLightFlag)
@@ -291,7 +365,7 @@ void DrawMissile(const CelOutputBuffer &out, int x, int y, int sx, int sy, bool
 	}
 
 	for (i = 0; i < nummissiles; i++) {
-		assert(missileactive[i] < MAXMISSILES);
+		assert(missileactive[i] < missile.capacity());
 		m = &missile[missileactive[i]];
 		if (m->position.tile.x != x || m->position.tile.y != y)
 			continue;
@@ -338,6 +412,8 @@ static void DrawMonster(const CelOutputBuffer &out, int x, int y, int mx, int my
 	}
 
 	CelSprite &cel = *monster[m].AnimInfo.pCelSprite;
+	if (IsSpriteOccluded({ mx, my }, cel, nCel, true))
+		return;
 
 	if ((dFlags[x][y] & BFLAG_LIT) == 0) {
 		Cl2DrawLightTbl(out, mx, my, cel, nCel, 1);
@@ -368,6 +444,8 @@ static void DrawPlayerIconHelper(const CelOutputBuffer &out, int pnum, missile_g
 	byte *pCelBuff = misfiledata[missileGraphicId].mAnimData[0];
 
 	CelSprite cel { pCelBuff, width };
+	if (IsSpriteOccluded({ x, y }, cel, 1, true))
+		return;
 
 	if (pnum == myplr) {
 		Cl2Draw(out, x, y, cel, 1);
@@ -445,14 +523,19 @@ static void DrawPlayer(const CelOutputBuffer &out, int pnum, int x, int y, int p
 	if (pnum == pcursplr)
 		Cl2DrawOutline(out, 165, px, py, *pCelSprite, nCel);
 
+	// The icons are drawn at their own positions, so they are checked separately
+	const bool hidden = IsSpriteOccluded({ px, py }, *pCelSprite, nCel, true);
+
 	if (pnum == myplr) {
-		Cl2Draw(out, px, py, *pCelSprite, nCel);
+		if (!hidden)
+			Cl2Draw(out, px, py, *pCelSprite, nCel);
 		DrawPlayerIcons(out, pnum, px, py, true);
 		return;
 	}
 
 	if ((dFlags[x][y] & BFLAG_LIT) == 0 || (plr[myplr]._pInfraFlag && light_table_index > 8)) {
-		Cl2DrawLightTbl(out, px, py, *pCelSprite, nCel, 1);
+		if (!hidden)
+			Cl2DrawLightTbl(out, px, py, *pCelSprite, nCel, 1);
 		DrawPlayerIcons(out, pnum, px, py, true);
 		return;
 	}
@@ -463,7 +546,8 @@ static void DrawPlayer(const CelOutputBuffer &out, int pnum, int x, int y, int p
 	else
 		light_table_index -= 5;
 
-	Cl2DrawLight(out, px, py, *pCelSprite, nCel);
+	if (!hidden)
+		Cl2DrawLight(out, px, py, *pCelSprite, nCel);
 	DrawPlayerIcons(out, pnum, px, py, false);
 
 	light_table_index = l;
@@ -541,6 +625,8 @@ static void DrawObject(const CelOutputBuffer &out, int x, int y, int ox, int oy,
 
 	const Point objectPosition { sx, sy };
 	CelSprite cel { object[bv]._oAnimData, object[bv]._oAnimWidth };
+	if (IsSpriteOccluded(objectPosition, cel, object[bv]._oAnimFrame, false, bv == pcursobj))
+		return;
 	if (bv == pcursobj)
 		CelBlitOutlineTo(out, 194, objectPosition, cel, object[bv]._oAnimFrame);
 	if (object[bv]._oLight) {
@@ -552,6 +638,25 @@ static void DrawObject(const CelOutputBuffer &out, int x, int y, int ox, int oy,
 
 static void scrollrt_draw_dungeon(const CelOutputBuffer &, int, int, int, int);
 
+/**
+ * @brief Render the current world CEL, or only record what it paints over while collecting occluders
+ * @param out Target buffer
+ * @param sx Target buffer coordinate
+ * @param sy Target buffer coordinate
+ */
+static void DrawMicroTile(const CelOutputBuffer &out, int sx, int sy)
+{
+	TileDrawOrder++;
+	if (!CollectingOccluders) {
+		RenderTile(out, sx, sy);
+		return;
+	}
+
+	const int opaqueHeight = GetTileOpaqueHeight();
+	if (opaqueHeight > 0)
+		Occluders.AddOccluder({ { sx, sy - TILE_HEIGHT + 1 }, { TILE_WIDTH / 2, opaqueHeight } }, TileDrawOrder);
+}
+
 /**
  * @brief Render a cell
  * @param out Target buffer
@@ -570,12 +675,12 @@ static void drawCell(const CelOutputBuffer &out, int x, int y, int sx, int sy)
 		level_cel_block = pMap->mt[2 * i];
 		if (level_cel_block != 0) {
 			arch_draw_type = i == 0 ? 1 : 0;
-			RenderTile(out, sx, sy);
+			DrawMicroTile(out, sx, sy);
 		}
 		level_cel_block = pMap->mt[2 * i + 1];
 		if (level_cel_block != 0) {
 			arch_draw_type = i == 0 ? 2 : 0;
-			RenderTile(out, sx + TILE_WIDTH / 2, sy);
+			DrawMicroTile(out, sx + TILE_WIDTH / 2, sy);
 		}
 		sy -= TILE_HEIGHT;
 	}
@@ -642,10 +747,13 @@ static void DrawItem(const CelOutputBuffer &out, int x, int y, int sx, int sy, b
 
 	int px = sx - CalculateWidth2(cel->Width());
 	const Point position { px, sy };
-	if (bItem - 1 == pcursitem || AutoMapShowItems) {
-		CelBlitOutlineTo(out, GetOutlineColor(*pItem, false), position, *cel, nCel);
+	const bool outlined = bItem - 1 == pcursitem || AutoMapShowItems;
+	if (!IsSpriteOccluded(position, *cel, nCel, false, outlined)) {
+		if (outlined) {
+			CelBlitOutlineTo(out, GetOutlineColor(*pItem, false), position, *cel, nCel);
+		}
+		CelClippedDrawLightTo(out, position, *cel, nCel);
 	}
-	CelClippedDrawLightTo(out, position, *cel, nCel);
 	if (pItem->AnimInfo.CurrentFrame == pItem->AnimInfo.NumberOfFrames || pItem->_iCurs == ICURS_MAGIC_ROCK)
 		AddItemToLabelQueue(bItem - 1, px, sy);
 }
@@ -670,6 +778,8 @@ static void DrawMonsterHelper(const CelOutputBuffer &out, int x, int y, int oy,
 	if (leveltype == DTYPE_TOWN) {
 		px = sx - CalculateWidth2(towners[mi]._tAnimWidth);
 		const Point position { px, sy };
+		if (IsSpriteOccluded(position, CelSprite(towners[mi]._tAnimData, towners[mi]._tAnimWidth), towners[mi]._tAnimFrame, false, mi == pcursmonst))
+			return;
 		if (mi == pcursmonst) {
 			CelBlitOutlineTo(out, 166, position, CelSprite(towners[mi]._tAnimData, towners[mi]._tAnimWidth), towners[mi]._tAnimFrame);
 		}
@@ -760,6 +870,8 @@ static void scrollrt_draw_dungeon(const CelOutputBuffer &out, int sx, int sy, in
 	light_table_index = dLight[sx][sy];
 
 	drawCell(out, sx, sy, dx, dy);
+	if (CollectingOccluders)
+		return;
 
 	int8_t bFlag = dFlags[sx][sy];
 	int8_t bDead = dDead[sx][sy];
@@ -793,6 +905,8 @@ static void scrollrt_draw_dungeon(const CelOutputBuffer &out, int sx, int sy, in
 				Log("Unclipped dead: frame {} of {}, deadnum=={}", nCel, frames, (bDead & 0x1F) - 1);
 				break;
 			}
+			if (IsSpriteOccluded({ px, dy }, CelSprite(pCelBuff, pDeadGuy->_deadWidth), nCel, true))
+				break;
 			if (pDeadGuy->_deadtrans != 0) {
 				Cl2DrawLightTbl(out, px, dy, CelSprite(pCelBuff, pDeadGuy->_deadWidth), nCel, pDeadGuy->_deadtrans);
 			} else {
@@ -852,36 +966,40 @@ static void scrollrt_draw_dungeon(const CelOutputBuffer &out, int sx, int sy, in
 }
 
 /**
- * @brief Render a row of tiles
- * @param out Buffer to render to
+ * @brief Render the floor tiles that reach into a band of the screen
+ * @param out Band to render to
  * @param x dPiece coordinate
  * @param y dPiece coordinate
  * @param sx Target buffer coordinate
- * @param sy Target buffer coordinate
+ * @param sy Target buffer coordinate, relative to the top of the band
  * @param rows Number of rows
  * @param columns Tile in a row
  */
-static void scrollrt_drawFloor(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
+static void DrawFloorBand(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
 {
+	cel_foliage_active = false;
 	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++) {
-			if (x >= 0 && x < MAXDUNX && y >= 0 && y < MAXDUNY) {
-				level_piece_id = dPiece[x][y];
-				if (level_piece_id != 0) {
-					if (!nSolidTable[level_piece_id])
-						drawFloor(out, x, y, sx, sy);
+		// Skip rows of tiles that are entirely above or below the band
+		if (sy >= 0 && sy - (TILE_HEIGHT - 1) < out.h()) {
+			for (int j = 0; j < columns; j++) {
+				if (x >= 0 && x < MAXDUNX && y >= 0 && y < MAXDUNY) {
+					level_piece_id = dPiece[x][y];
+					if (level_piece_id != 0) {
+						if (!nSolidTable[level_piece_id])
+							drawFloor(out, x, y, sx, sy);
+					} else {
+						world_draw_black_tile(out, sx, sy);
+					}
 				} else {
 					world_draw_black_tile(out, sx, sy);
 				}
-			} else {
-				world_draw_black_tile(out, sx, sy);
+				ShiftGrid(&x, &y, 1, 0);
+				sx += TILE_WIDTH;
 			}
-			ShiftGrid(&x, &y, 1, 0);
-			sx += TILE_WIDTH;
+			// Return to start of row
+			ShiftGrid(&x, &y, -columns, 0);
+			sx -= columns * TILE_WIDTH;
 		}
-		// Return to start of row
-		ShiftGrid(&x, &y, -columns, 0);
-		sx -= columns * TILE_WIDTH;
 
 		// Jump to next row
 		sy += TILE_HEIGHT / 2;
@@ -897,11 +1015,29 @@ static void scrollrt_drawFloor(const CelOutputBuffer &out, int x, int y, int sx,
 	}
 }
 
+/**
+ * @brief Render the floor tiles, split into bands that are drawn in parallel when more than one render thread is enabled
+ * @param out Output buffer
+ * @param x dPiece coordinate
+ * @param y dPiece coordinate
+ * @param sx Buffer coordinate
+ * @param sy Buffer coordinate
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+static void scrollrt_drawFloor(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
+{
+	ProfileScope profileScope(ProfileStage::DrawFloor);
+	DrawInBands(out, [&](const CelOutputBuffer &band, int top) {
+		DrawFloorBand(band, x, y, sx, sy - top, rows, columns);
+	});
+}
+
 #define IsWall(x, y) (dPiece[x][y] == 0 || nSolidTable[dPiece[x][y]] || dSpecial[x][y] != 0)
 #define IsWalkable(x, y) (dPiece[x][y] != 0 && !nSolidTable[dPiece[x][y]])
 
 /**
- * @brief Render a row of tile
+ * @brief Walk the tiles in the order they are drawn in, rendering them and their sprites
  * @param out Output buffer
  * @param x dPiece coordinate
  * @param y dPiece coordinate
@@ -910,11 +1046,10 @@ static void scrollrt_drawFloor(const CelOutputBuffer &out, int x, int y, int sx,
  * @param rows Number of rows
  * @param columns Tile in a row
  */
-static void scrollrt_draw(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
+static void DrawTileRows(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
 {
-	// Keep evaluating until MicroTiles can't affect screen
-	rows += MicroTileLen;
 	memset(dRendered, 0, sizeof(dRendered));
+	TileDrawOrder = 0;
 
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++) {
@@ -955,11 +1090,43 @@ static void scrollrt_draw(const CelOutputBuffer &out, int x, int y, int sx, int
 	}
 }
 
+/**
+ * @brief Render a row of tile
+ *
+ * With CullOccludedSprites set the tiles are walked twice. The first pass only records which parts of the screen get
+ * painted over by opaque wall tiles, so the second pass can skip sprites that would be drawn over completely.
+ *
+ * @param out Output buffer
+ * @param x dPiece coordinate
+ * @param y dPiece coordinate
+ * @param sx Buffer coordinate
+ * @param sy Buffer coordinate
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+static void scrollrt_draw(const CelOutputBuffer &out, int x, int y, int sx, int sy, int rows, int columns)
+{
+	ProfileScope profileScope(ProfileStage::DrawDungeon);
+	// Keep evaluating until MicroTiles can't affect screen
+	rows += MicroTileLen;
+
+	if (CullOccludedSprites) {
+		// Tiles are drawn with their bottom left corner on a grid of half tiles
+		Occluders.Reset({ out.w(), out.h() }, { sx, sy + 1 });
+		CollectingOccluders = true;
+		DrawTileRows(out, x, y, sx, sy, rows, columns);
+		CollectingOccluders = false;
+	}
+
+	DrawTileRows(out, x, y, sx, sy, rows, columns);
+}
+
 /**
  * @brief Scale up the top left part of the buffer 2x.
  */
 static void Zoom(const CelOutputBuffer &out)
 {
+	ProfileScope profileScope(ProfileStage::Zoom);
 	int viewport_width = out.w();
 	int viewport_offset_x = 0;
 	if (CanPanelsCoverView()) {
@@ -972,41 +1139,27 @@ static void Zoom(const CelOutputBuffer &out)
 	}
 
 	// We round to even for the source width and height.
-	// If the width / height was odd, we copy just one extra pixel / row later on.
+	// If the width / height was odd, the first source pixel / line is copied only once.
 	const int src_width = (viewport_width + 1) / 2;
 	const int doubleable_width = viewport_width / 2;
 	const int src_height = (out.h() + 1) / 2;
-	const int doubleable_height = out.h() / 2;
-
-	BYTE *src = out.at(src_width - 1, src_height - 1);
-	BYTE *dst = out.at(viewport_offset_x + viewport_width - 1, out.h() - 1);
-	const bool odd_viewport_width = (viewport_width % 2) == 1;
-
-	for (int hgt = 0; hgt < doubleable_height; hgt++) {
-		// Double the pixels in the line.
-		for (int i = 0; i < doubleable_width; i++) {
-			*dst-- = *src;
-			*dst-- = *src;
-			--src;
-		}
+	const int odd_width = src_width - doubleable_width;
+	const bool odd_height = (out.h() % 2) == 1;
+	const auto &kernels = *ActiveOutputConvertKernels;
 
-		// Copy a single extra pixel if the output width is odd.
-		if (odd_viewport_width) {
-			*dst-- = *src;
-			--src;
-		}
+	// Work from the bottom right so that no source pixel is overwritten before it is read.
+	for (int y = src_height - 1; y >= 0; y--) {
+		const BYTE *src = out.at(0, y);
+		const int dst_y = 2 * y - (odd_height ? 1 : 0);
+		BYTE *dst = out.at(viewport_offset_x, dst_y + (dst_y < 0 ? 1 : 0));
 
-		// Skip the rest of the source line.
-		src -= (out.pitch() - src_width);
+		kernels.doublePixels(dst + odd_width, src + odd_width, doubleable_width);
+		if (odd_width != 0)
+			*dst = *src;
 
 		// Double the line.
-		memcpy(dst - out.pitch() + 1, dst + 1, viewport_width);
-
-		// Skip the rest of the destination line.
-		dst -= 2 * out.pitch() - viewport_width;
-	}
-	if ((out.h() % 2) == 1) {
-		memcpy(dst - out.pitch() + 1, dst + 1, viewport_width);
+		if (dst_y >= 0)
+			memcpy(out.at(viewport_offset_x, dst_y + 1), dst, viewport_width);
 	}
 }
 
@@ -1154,7 +1307,7 @@ void CalcViewportGeometry()
  * @param x Center of view in dPiece coordinate
  * @param y Center of view in dPiece coordinate
  */
-static void DrawGame(const CelOutputBuffer &full_out, int x, int y)
+void DrawGame(const CelOutputBuffer &full_out, int x, int y)
 {
 	int sx, sy, columns, rows;
 
@@ -1471,54 +1624,108 @@ static void DoBlitScreen(Sint16 dwX, Sint16 dwY, Uint16 dwWdt, Uint16 dwHgt)
 	BltFast(&src_rect, &dst_rect);
 }
 
+namespace {
+
 /**
- * @brief Check render pipeline and blit individual screen parts
- * @param dwHgt Section of screen to update from top to bottom
- * @param draw_desc Render info box
- * @param draw_hp Render health bar
- * @param draw_mana Render mana bar
- * @param draw_sbar Render belt
- * @param draw_btn Render panel buttons
+ * @brief A part of the control panel that is only redrawn and uploaded when what it shows changes
  */
-static void DrawMain(int dwHgt, bool draw_desc, bool draw_hp, bool draw_mana, bool draw_sbar, bool draw_btn)
+struct PanelWidget {
+	std::uint64_t state;
+	bool valid;
+
+	/**
+	 * @brief Remember what the widget shows now
+	 * @param newState Summary of everything the widget shows
+	 * @param force Treat the widget as changed, i.e. when the whole panel was redrawn
+	 * @return Whether the widget needs to be redrawn and uploaded
+	 */
+	bool Update(std::uint64_t newState, bool force)
+	{
+		const bool changed = force || !valid || state != newState;
+		state = newState;
+		valid = true;
+		return changed;
+	}
+};
+
+PanelWidget LifeFlaskWidget;
+PanelWidget ManaFlaskWidget;
+PanelWidget SpellIconWidget;
+PanelWidget CtrlBtnsWidget;
+PanelWidget InfoBoxWidget;
+PanelWidget XPBarWidget;
+
+/** Parts of the screen to upload this frame */
+DirtyRegion ScreenDamage;
+
+std::uint64_t PackState(std::uint32_t high, std::uint32_t low)
+{
+	return (static_cast<std::uint64_t>(high) << 32) | low;
+}
+
+std::uint64_t GetLifeFlaskState()
+{
+	const auto &myPlayer = plr[myplr];
+	return PackState(myPlayer._pHitPoints, myPlayer._pMaxHP);
+}
+
+std::uint64_t GetManaFlaskState()
+{
+	const auto &myPlayer = plr[myplr];
+	return PackState(myPlayer._pMana, myPlayer._pMaxMana);
+}
+
+std::uint64_t GetSpellIconState()
 {
+	const auto &myPlayer = plr[myplr];
+	const spell_id spell = myPlayer._pRSpell;
+	const int spellLevel = spell != SPL_INVALID ? myPlayer._pISplLvlAdd + myPlayer._pSplLvl[spell] : 0;
+	// The icon is greyed out when there isn't enough mana to cast the spell
+	const std::uint32_t high = (spell & 0xFF) | (myPlayer._pRSplType & 0xFF) << 8 | (spellLevel & 0xFF) << 16 | (currlevel == 0 ? 1U << 24 : 0);
+	return PackState(high, myPlayer._pMana);
+}
+
+std::uint64_t GetXPBarState()
+{
+	if (!sgOptions.Gameplay.bExperienceBar)
+		return 0;
+	const auto &myPlayer = plr[myplr];
+	return PackState(myPlayer._pLevel | 1U << 31, myPlayer._pExperience);
+}
+
+} // namespace
+
+/**
+ * @brief Upload the changed parts of the screen from the back buffer
+ * @param damage Rectangles of the back buffer to upload
+ */
+static void DrawMain(const DirtyRegion &damage)
+{
+	ProfileScope profileScope(ProfileStage::DrawMain);
 	if (!gbActive || RenderDirectlyToOutputSurface) {
 		return;
 	}
 
-	assert(dwHgt >= 0 && dwHgt <= gnScreenHeight);
+	for (const Rectangle &rect : damage.Rects()) {
+		const int left = std::max(rect.position.x, 0);
+		const int top = std::max(rect.position.y, 0);
+		const int right = std::min<int>(rect.position.x + rect.size.width, gnScreenWidth);
+		const int bottom = std::min<int>(rect.position.y + rect.size.height, gnScreenHeight);
+		if (left < right && top < bottom)
+			DoBlitScreen(left, top, right - left, bottom - top);
+	}
+}
 
-	if (dwHgt > 0) {
-		DoBlitScreen(0, 0, gnScreenWidth, dwHgt);
+/**
+ * @brief Add the old and new position of the software cursor to the damage
+ */
+static void AddCursorDamage(DirtyRegion &damage)
+{
+	if (sgdwCursWdtOld != 0) {
+		damage.Add({ { sgdwCursXOld, sgdwCursYOld }, { static_cast<int>(sgdwCursWdtOld), static_cast<int>(sgdwCursHgtOld) } });
 	}
-	if (dwHgt < gnScreenHeight) {
-		if (draw_sbar) {
-			DoBlitScreen(PANEL_LEFT + 204, PANEL_TOP + 5, 232, 28);
-		}
-		if (draw_desc) {
-			DoBlitScreen(PANEL_LEFT + 176, PANEL_TOP + 46, 288, 60);
-		}
-		if (draw_mana) {
-			DoBlitScreen(PANEL_LEFT + 460, PANEL_TOP, 88, 72);
-			DoBlitScreen(PANEL_LEFT + 564, PANEL_TOP + 64, 56, 56);
-		}
-		if (draw_hp) {
-			DoBlitScreen(PANEL_LEFT + 96, PANEL_TOP, 88, 72);
-		}
-		if (draw_btn) {
-			DoBlitScreen(PANEL_LEFT + 8, PANEL_TOP + 5, 72, 119);
-			DoBlitScreen(PANEL_LEFT + 556, PANEL_TOP + 5, 72, 48);
-			if (gbIsMultiplayer) {
-				DoBlitScreen(PANEL_LEFT + 84, PANEL_TOP + 91, 36, 32);
-				DoBlitScreen(PANEL_LEFT + 524, PANEL_TOP + 91, 36, 32);
-			}
-		}
-		if (sgdwCursWdtOld != 0) {
-			DoBlitScreen(sgdwCursXOld, sgdwCursYOld, sgdwCursWdtOld, sgdwCursHgtOld);
-		}
-		if (sgdwCursWdt != 0) {
-			DoBlitScreen(sgdwCursX, sgdwCursY, sgdwCursWdt, sgdwCursHgt);
-		}
+	if (sgdwCursWdt != 0) {
+		damage.Add({ { sgdwCursX, sgdwCursY }, { static_cast<int>(sgdwCursWdt), static_cast<int>(sgdwCursHgt) } });
 	}
 }
 
@@ -1527,11 +1734,11 @@ static void DrawMain(int dwHgt, bool draw_desc, bool draw_hp, bool draw_mana, bo
  */
 void scrollrt_draw_game_screen()
 {
-	int hgt = 0;
+	ScreenDamage.Clear();
 
 	if (force_redraw == 255) {
 		force_redraw = 0;
-		hgt = gnScreenHeight;
+		ScreenDamage.Add({ { 0, 0 }, { gnScreenWidth, gnScreenHeight } });
 	}
 
 	if (IsHardwareCursor()) {
@@ -1542,7 +1749,8 @@ void scrollrt_draw_game_screen()
 		unlock_buf(0);
 	}
 
-	DrawMain(hgt, false, false, false, false, false);
+	AddCursorDamage(ScreenDamage);
+	DrawMain(ScreenDamage);
 
 	RenderPresent();
 
@@ -1558,30 +1766,23 @@ void scrollrt_draw_game_screen()
  */
 void DrawAndBlit()
 {
+	ProfileScope profileScope(ProfileStage::DrawAndBlit);
 	if (!gbRunGame) {
 		return;
 	}
 
-	int hgt = 0;
-	bool ddsdesc = false;
-	bool ctrlPan = false;
-
-	if (gnScreenWidth > PANEL_WIDTH || force_redraw == 255 || IsHighlightingLabelsEnabled()) {
-		drawhpflag = true;
-		drawmanaflag = true;
-		drawbtnflag = true;
-		drawsbarflag = true;
-		ddsdesc = false;
-		ctrlPan = true;
-		hgt = gnScreenHeight;
-	} else if (force_redraw == 1) {
-		ddsdesc = true;
-		ctrlPan = false;
-		hgt = gnViewportHeight;
-	}
-
+	const bool fullRedraw = gnScreenWidth > PANEL_WIDTH || force_redraw == 255 || IsHighlightingLabelsEnabled();
+	const bool redrawViewport = force_redraw == 1;
 	force_redraw = 0;
 
+	// The flasks, spell icon and buttons are only redrawn when what they show changes
+	drawhpflag = LifeFlaskWidget.Update(GetLifeFlaskState(), fullRedraw);
+	const bool manaChanged = ManaFlaskWidget.Update(GetManaFlaskState(), fullRedraw);
+	const bool spellChanged = SpellIconWidget.Update(GetSpellIconState(), fullRedraw);
+	drawmanaflag = manaChanged || spellChanged;
+	drawbtnflag = CtrlBtnsWidget.Update(GetCtrlBtnsState(), fullRedraw);
+	drawsbarflag = drawsbarflag || fullRedraw;
+
 	lock_buf(0);
 	const CelOutputBuffer &out = GlobalBackBuffer();
 	UndrawCursor(out);
@@ -1589,7 +1790,7 @@ void DrawAndBlit()
 	nthread_UpdateProgressToNextGameTick();
 
 	DrawView(out, ViewX, ViewY);
-	if (ctrlPan) {
+	if (fullRedraw) {
 		DrawCtrlPan(out);
 	}
 	if (drawhpflag) {
@@ -1606,7 +1807,6 @@ void DrawAndBlit()
 	}
 	if (talkflag) {
 		DrawTalkPan(out);
-		hgt = gnScreenHeight;
 	}
 	DrawXPBar(out);
 
@@ -1617,10 +1817,44 @@ void DrawAndBlit()
 	}
 
 	DrawFPS(out);
+	DrawProfilerOverlay(out);
 
 	unlock_buf(0);
 
-	DrawMain(hgt, ddsdesc, drawhpflag, drawmanaflag, drawsbarflag, drawbtnflag);
+	// DrawView sets the info box text
+	const bool infoChanged = InfoBoxWidget.Update(GetInfoBoxState(), fullRedraw);
+	const bool xpChanged = XPBarWidget.Update(GetXPBarState(), fullRedraw);
+
+	ScreenDamage.Clear();
+	if (fullRedraw || talkflag) {
+		ScreenDamage.Add({ { 0, 0 }, { gnScreenWidth, gnScreenHeight } });
+	} else {
+		if (redrawViewport)
+			ScreenDamage.Add({ { 0, 0 }, { gnScreenWidth, gnViewportHeight } });
+		if (drawsbarflag)
+			ScreenDamage.Add({ { PANEL_LEFT + 204, PANEL_TOP + 5 }, { 232, 28 } });
+		if (infoChanged)
+			ScreenDamage.Add({ { PANEL_LEFT + 176, PANEL_TOP + 46 }, { 288, 60 } });
+		if (manaChanged)
+			ScreenDamage.Add({ { PANEL_LEFT + 460, PANEL_TOP }, { 88, 72 } });
+		if (spellChanged)
+			ScreenDamage.Add({ { PANEL_LEFT + 564, PANEL_TOP + 64 }, { 56, 56 } });
+		if (drawhpflag)
+			ScreenDamage.Add({ { PANEL_LEFT + 96, PANEL_TOP }, { 88, 72 } });
+		if (drawbtnflag) {
+			ScreenDamage.Add({ { PANEL_LEFT + 8, PANEL_TOP + 5 }, { 72, 119 } });
+			ScreenDamage.Add({ { PANEL_LEFT + 556, PANEL_TOP + 5 }, { 72, 48 } });
+			if (gbIsMultiplayer) {
+				ScreenDamage.Add({ { PANEL_LEFT + 84, PANEL_TOP + 91 }, { 36, 32 } });
+				ScreenDamage.Add({ { PANEL_LEFT + 524, PANEL_TOP + 91 }, { 36, 32 } });
+			}
+		}
+		if (xpChanged)
+			ScreenDamage.Add(GetXPBarRect());
+		AddCursorDamage(ScreenDamage);
+	}
+
+	DrawMain(ScreenDamage);
 
 	RenderPresent();
 
@@ -29,13 +29,15 @@ enum _scroll_direction : uint8_t {
 extern bool sgbControllerActive;
 extern bool IsMovingMouseCursorWithController();
 
-extern int light_table_index;
-extern uint32_t level_cel_block;
-extern char arch_draw_type;
-extern bool cel_transparency_active;
-extern bool cel_foliage_active;
-extern int level_piece_id;
+extern thread_local int light_table_index;
+extern thread_local uint32_t level_cel_block;
+extern thread_local char arch_draw_type;
+extern thread_local bool cel_transparency_active;
+extern thread_local bool cel_foliage_active;
+extern thread_local int level_piece_id;
 extern bool AutoMapShowItems;
+/** Skip drawing sprites that level tiles drawn after them cover completely */
+extern bool CullOccludedSprites;
 
 /**
  * @brief Returns the offset for the walking animation
@@ -58,6 +60,7 @@ void CalcViewportGeometry();
  * @param StartX Center of view in dPiece coordinate
  * @param StartY Center of view in dPiece coordinate
  */
+void DrawGame(const CelOutputBuffer &full_out, int x, int y);
 void DrawView(const CelOutputBuffer &out, int StartX, int StartY);
 
 void ClearScreenBuffer();
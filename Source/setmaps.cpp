@@ -152,31 +152,31 @@ void LoadSetMap()
 			quests[Q_SKELKING]._qactive = QUEST_ACTIVE;
 			quests[Q_SKELKING]._qvar1 = 1;
 		}
-		LoadPreL1Dungeon("Levels\\L1Data\\SklKng1.DUN");
-		LoadL1Dungeon("Levels\\L1Data\\SklKng2.DUN", 83, 45);
+		LoadPreL1Dungeon(ActiveDungeon, "Levels\\L1Data\\SklKng1.DUN");
+		LoadL1Dungeon(ActiveDungeon, "Levels\\L1Data\\SklKng2.DUN", 83, 45);
 		LoadPalette("Levels\\L1Data\\L1_2.pal");
-		DRLG_AreaTrans(sizeof(SkelKingTrans1) / 4, &SkelKingTrans1[0]);
-		DRLG_ListTrans(sizeof(SkelKingTrans2) / 4, &SkelKingTrans2[0]);
-		DRLG_AreaTrans(sizeof(SkelKingTrans3) / 4, &SkelKingTrans3[0]);
-		DRLG_ListTrans(sizeof(SkelKingTrans4) / 4, &SkelKingTrans4[0]);
+		DRLG_AreaTrans(ActiveDungeon, sizeof(SkelKingTrans1) / 4, &SkelKingTrans1[0]);
+		DRLG_ListTrans(ActiveDungeon, sizeof(SkelKingTrans2) / 4, &SkelKingTrans2[0]);
+		DRLG_AreaTrans(ActiveDungeon, sizeof(SkelKingTrans3) / 4, &SkelKingTrans3[0]);
+		DRLG_ListTrans(ActiveDungeon, sizeof(SkelKingTrans4) / 4, &SkelKingTrans4[0]);
 		AddL1Objs(0, 0, MAXDUNX, MAXDUNY);
 		AddSKingObjs();
 		InitSKingTriggers();
 		break;
 	case SL_BONECHAMB:
-		LoadPreL2Dungeon("Levels\\L2Data\\Bonecha2.DUN");
-		LoadL2Dungeon("Levels\\L2Data\\Bonecha1.DUN", 69, 39);
+		LoadPreL2Dungeon(ActiveDungeon, "Levels\\L2Data\\Bonecha2.DUN");
+		LoadL2Dungeon(ActiveDungeon, "Levels\\L2Data\\Bonecha1.DUN", 69, 39);
 		LoadPalette("Levels\\L2Data\\L2_2.pal");
-		DRLG_ListTrans(sizeof(SkelChamTrans1) / 4, &SkelChamTrans1[0]);
-		DRLG_AreaTrans(sizeof(SkelChamTrans2) / 4, &SkelChamTrans2[0]);
-		DRLG_ListTrans(sizeof(SkelChamTrans3) / 4, &SkelChamTrans3[0]);
+		DRLG_ListTrans(ActiveDungeon, sizeof(SkelChamTrans1) / 4, &SkelChamTrans1[0]);
+		DRLG_AreaTrans(ActiveDungeon, sizeof(SkelChamTrans2) / 4, &SkelChamTrans2[0]);
+		DRLG_ListTrans(ActiveDungeon, sizeof(SkelChamTrans3) / 4, &SkelChamTrans3[0]);
 		AddL2Objs(0, 0, MAXDUNX, MAXDUNY);
 		AddSChamObjs();
 		InitSChambTriggers();
 		break;
 	case SL_MAZE:
-		LoadPreL1Dungeon("Levels\\L1Data\\Lv1MazeA.DUN");
-		LoadL1Dungeon("Levels\\L1Data\\Lv1MazeB.DUN", 20, 50);
+		LoadPreL1Dungeon(ActiveDungeon, "Levels\\L1Data\\Lv1MazeA.DUN");
+		LoadL1Dungeon(ActiveDungeon, "Levels\\L1Data\\Lv1MazeB.DUN", 20, 50);
 		LoadPalette("Levels\\L1Data\\L1_5.pal");
 		AddL1Objs(0, 0, MAXDUNX, MAXDUNY);
 		DRLG_SetMapTrans("Levels\\L1Data\\Lv1MazeA.DUN");
@@ -184,8 +184,8 @@ void LoadSetMap()
 	case SL_POISONWATER:
 		if (quests[Q_PWATER]._qactive == QUEST_INIT)
 			quests[Q_PWATER]._qactive = QUEST_ACTIVE;
-		LoadPreL3Dungeon("Levels\\L3Data\\Foulwatr.DUN");
-		LoadL3Dungeon("Levels\\L3Data\\Foulwatr.DUN", 31, 83);
+		LoadPreL3Dungeon(ActiveDungeon, "Levels\\L3Data\\Foulwatr.DUN");
+		LoadL3Dungeon(ActiveDungeon, "Levels\\L3Data\\Foulwatr.DUN", 31, 83);
 		LoadPalette("Levels\\L3Data\\L3pfoul.pal");
 		InitPWaterTriggers();
 		break;
@@ -195,8 +195,8 @@ void LoadSetMap()
 		} else if (quests[Q_BETRAYER]._qactive == QUEST_ACTIVE) {
 			quests[Q_BETRAYER]._qvar2 = 3;
 		}
-		LoadPreL1Dungeon("Levels\\L1Data\\Vile1.DUN");
-		LoadL1Dungeon("Levels\\L1Data\\Vile2.DUN", 35, 36);
+		LoadPreL1Dungeon(ActiveDungeon, "Levels\\L1Data\\Vile1.DUN");
+		LoadL1Dungeon(ActiveDungeon, "Levels\\L1Data\\Vile2.DUN", 35, 36);
 		LoadPalette("Levels\\L1Data\\L1_2.pal");
 		AddL1Objs(0, 0, MAXDUNX, MAXDUNY);
 		AddVileObjs();
@@ -1,12 +1,21 @@
 #include <SDL.h>
 #include <SDL_endian.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "storm/storm.h"
 #include "DiabloUI/diabloui.h"
+#include "encrypt.h"
+#include "mpqapi.h"
 #include "options.h"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
@@ -32,20 +41,214 @@ namespace {
 bool directFileAccess = false;
 std::string *SBasePath = nullptr;
 
+/** Guards files that were not opened through SFileOpenFile, such as those in save games */
 SdlMutex Mutex;
 
+/** Number of closed files that are kept open so they can be handed out again without a new lookup */
+constexpr std::size_t MaxCachedFiles = 16;
+
+struct OpenFile {
+	/** Lock of the archive the file belongs to */
+	SdlMutex *archiveMutex;
+	std::string filename;
+};
+
+struct CachedFile {
+	std::string filename;
+	HANDLE file;
+};
+
+/** Guards the tables below, but is never held while reading from an archive */
+SdlMutex HandleMutex;
+/** One lock per archive, StormLib can read from different archives at the same time but not twice from the same one */
+std::unordered_map<HANDLE, std::unique_ptr<SdlMutex>> ArchiveMutexes;
+/** Files opened from an archive by SFileOpenFile, including cached ones */
+std::unordered_map<HANDLE, OpenFile> OpenFiles;
+/** Closed files that are still open, most recently closed first */
+std::list<CachedFile> CachedFiles;
+
+SdlMutex &GetFileMutex(HANDLE hFile)
+{
+	const std::lock_guard<SdlMutex> lock(HandleMutex);
+	auto openFile = OpenFiles.find(hFile);
+	if (openFile == OpenFiles.end())
+		return Mutex;
+	return *openFile->second.archiveMutex;
+}
+
+bool OpenArchiveFile(HANDLE archive, const char *filename, HANDLE *phFile)
+{
+	if (archive == nullptr)
+		return false;
+
+	SdlMutex *archiveMutex;
+	{
+		const std::lock_guard<SdlMutex> lock(HandleMutex);
+		std::unique_ptr<SdlMutex> &mutex = ArchiveMutexes[archive];
+		if (mutex == nullptr)
+			mutex = std::make_unique<SdlMutex>();
+		archiveMutex = mutex.get();
+	}
+
+	{
+		const std::lock_guard<SdlMutex> lock(*archiveMutex);
+		if (!SFileOpenFileEx(archive, filename, SFILE_OPEN_FROM_MPQ, phFile))
+			return false;
+	}
+
+	const std::lock_guard<SdlMutex> lock(HandleMutex);
+	OpenFiles[*phFile] = { archiveMutex, filename };
+	return true;
+}
+
+bool CloseArchiveFile(HANDLE hFile)
+{
+	SdlMutex *mutex = &Mutex;
+	{
+		const std::lock_guard<SdlMutex> lock(HandleMutex);
+		auto openFile = OpenFiles.find(hFile);
+		if (openFile != OpenFiles.end()) {
+			mutex = openFile->second.archiveMutex;
+			OpenFiles.erase(openFile);
+		}
+	}
+
+	const std::lock_guard<SdlMutex> lock(*mutex);
+	return SFileCloseFile(hFile);
+}
+
+bool TakeCachedFile(const char *filename, HANDLE *phFile)
+{
+	{
+		const std::lock_guard<SdlMutex> lock(HandleMutex);
+		auto cachedFile = std::find_if(CachedFiles.begin(), CachedFiles.end(), [filename](const CachedFile &file) {
+			return file.filename == filename;
+		});
+		if (cachedFile == CachedFiles.end())
+			return false;
+		*phFile = cachedFile->file;
+		CachedFiles.erase(cachedFile);
+	}
+
+	SFileSetFilePointer(*phFile, 0, DVL_FILE_BEGIN);
+	return true;
+}
+
+/**
+ * @brief Keep a file open after it is closed so it can be handed out again by SFileOpenFile
+ * @return false if the file can't be cached and has to be closed
+ */
+bool CacheFile(HANDLE hFile, HANDLE *evictedFile)
+{
+	const std::lock_guard<SdlMutex> lock(HandleMutex);
+	auto openFile = OpenFiles.find(hFile);
+	if (openFile == OpenFiles.end())
+		return false;
+
+	const std::string &filename = openFile->second.filename;
+	for (const CachedFile &cachedFile : CachedFiles) {
+		if (cachedFile.filename == filename)
+			return false;
+	}
+
+	CachedFiles.push_front({ filename, hFile });
+	*evictedFile = nullptr;
+	if (CachedFiles.size() > MaxCachedFiles) {
+		*evictedFile = CachedFiles.back().file;
+		CachedFiles.pop_back();
+	}
+	return true;
+}
+
+/** Archives in the order SFileOpenFile searches them, bit i of an index entry is set if SearchOrder[i] holds the file */
+HANDLE *const SearchOrder[] = {
+	&devilutionx_mpq,
+	&hfopt2_mpq,
+	&hfopt1_mpq,
+	&hfvoice_mpq,
+	&hfmusic_mpq,
+	&hfbarb_mpq,
+	&hfbard_mpq,
+	&hfmonk_mpq,
+	&hellfire_mpq,
+	&patch_rt_mpq,
+	&spawn_mpq,
+	&diabdat_mpq,
+};
+/** Bits of the archives that are only searched when playing Hellfire */
+constexpr uint16_t HellfireArchives = 0b000111111110;
+
+/** Archives holding each file, keyed by the two name hashes of the file */
+std::unordered_map<uint64_t, uint16_t> FileIndex;
+/** File names read from the archives' listfiles */
+std::vector<std::string> ListedFiles;
+bool FileIndexBuilt = false;
+/** Files that have been looked for in the base path without being found, guarded by HandleMutex */
+std::unordered_set<uint64_t> MissingLocalFiles;
+
+uint64_t GetFileKey(const char *filename)
+{
+	return static_cast<uint64_t>(Hash(filename, 1)) << 32 | Hash(filename, 2);
+}
+
+void IndexArchive(HANDLE archive, uint16_t archiveBit)
+{
+	DWORD entries = 0;
+	if (!SFileGetFileInfo(archive, SFILE_INFO_HASH_TABLE_SIZE, &entries, sizeof(entries), nullptr))
+		return;
+
+	std::vector<_HASHENTRY> hashTable(entries);
+	if (!SFileGetFileInfo(archive, SFILE_INFO_HASH_TABLE, hashTable.data(), entries * sizeof(_HASHENTRY), nullptr))
+		return;
+
+	for (const _HASHENTRY &entry : hashTable) {
+		if (entry.block == -1 || entry.block == -2)
+			continue; // Free or deleted
+		FileIndex[static_cast<uint64_t>(entry.hashcheck[0]) << 32 | entry.hashcheck[1]] |= archiveBit;
+	}
+}
+
+void ReadListFile(HANDLE archive)
+{
+	HANDLE file;
+	if (!SFileOpenFileEx(archive, "(listfile)", SFILE_OPEN_FROM_MPQ, &file))
+		return;
+
+	std::string listFile(SFileGetFileSize(file), '\0');
+	bool success = SFileReadFile(file, &listFile[0], listFile.size(), nullptr, nullptr);
+	SFileCloseFile(file);
+	if (!success)
+		return;
+
+	size_t begin = 0;
+	while (begin < listFile.size()) {
+		size_t end = listFile.find_first_of(";\r\n", begin);
+		if (end == std::string::npos)
+			end = listFile.size();
+		if (end > begin)
+			ListedFiles.push_back(listFile.substr(begin, end - begin));
+		begin = end + 1;
+	}
+}
+
 } // namespace
 
 bool SFileReadFileThreadSafe(HANDLE hFile, void *buffer, DWORD nNumberOfBytesToRead, DWORD *read, int *lpDistanceToMoveHigh)
 {
-	const std::lock_guard<SdlMutex> lock(Mutex);
+	const std::lock_guard<SdlMutex> lock(GetFileMutex(hFile));
 	return SFileReadFile(hFile, buffer, nNumberOfBytesToRead, read, lpDistanceToMoveHigh);
 }
 
 bool SFileCloseFileThreadSafe(HANDLE hFile)
 {
-	const std::lock_guard<SdlMutex> lock(Mutex);
-	return SFileCloseFile(hFile);
+	HANDLE evictedFile;
+	if (CacheFile(hFile, &evictedFile)) {
+		if (evictedFile != nullptr)
+			CloseArchiveFile(evictedFile);
+		return true;
+	}
+
+	return CloseArchiveFile(hFile);
 }
 
 // Converts ASCII characters to lowercase
@@ -77,54 +280,71 @@ unsigned char AsciiToLowerTable_Path[256] = {
 	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
 };
 
-bool SFileOpenFile(const char *filename, HANDLE *phFile)
+namespace {
+
+bool OpenLocalFile(const char *filename, HANDLE *phFile)
 {
-	bool result = false;
+	std::string path = *SBasePath + filename;
+	for (std::size_t i = SBasePath->size(); i < path.size(); ++i)
+		path[i] = AsciiToLowerTable_Path[static_cast<unsigned char>(path[i])];
+	return SFileOpenFileEx((HANDLE) nullptr, path.c_str(), SFILE_OPEN_LOCAL_FILE, phFile);
+}
 
-	if (directFileAccess && SBasePath != nullptr) {
-		std::string path = *SBasePath + filename;
-		for (std::size_t i = SBasePath->size(); i < path.size(); ++i)
-			path[i] = AsciiToLowerTable_Path[static_cast<unsigned char>(path[i])];
-		result = SFileOpenFileEx((HANDLE) nullptr, path.c_str(), SFILE_OPEN_LOCAL_FILE, phFile);
-	}
+/**
+ * @brief Open a file from the base path or the first archive that holds it according to the file index
+ */
+bool OpenIndexedFile(const char *filename, HANDLE *phFile)
+{
+	const uint64_t key = GetFileKey(filename);
 
-	if (!result && devilutionx_mpq != nullptr) {
-		result = SFileOpenFileEx((HANDLE)devilutionx_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-	}
-	if (gbIsHellfire) {
-		if (!result && hfopt2_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfopt2_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfopt1_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfopt1_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfvoice_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfvoice_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfmusic_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfmusic_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfbarb_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfbarb_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfbard_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfbard_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-		}
-		if (!result && hfmonk_mpq != nullptr) {
-			result = SFileOpenFileEx((HANDLE)hfmonk_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
+	if (directFileAccess && SBasePath != nullptr) {
+		bool missing;
+		{
+			const std::lock_guard<SdlMutex> lock(HandleMutex);
+			missing = MissingLocalFiles.count(key) != 0;
 		}
-		if (!result) {
-			result = SFileOpenFileEx((HANDLE)hellfire_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
+		if (!missing) {
+			if (OpenLocalFile(filename, phFile))
+				return true;
+			const std::lock_guard<SdlMutex> lock(HandleMutex);
+			MissingLocalFiles.insert(key);
 		}
 	}
-	if (!result && patch_rt_mpq != nullptr) {
-		result = SFileOpenFileEx((HANDLE)patch_rt_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
-	}
-	if (!result && spawn_mpq != nullptr) {
-		result = SFileOpenFileEx((HANDLE)spawn_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
+
+	auto entry = FileIndex.find(key);
+	uint16_t archives = entry != FileIndex.end() ? entry->second : 0;
+	if (!gbIsHellfire)
+		archives &= ~HellfireArchives;
+	for (HANDLE *archive : SearchOrder) {
+		if ((archives & 1) != 0)
+			return OpenArchiveFile(*archive, filename, phFile);
+		archives >>= 1;
 	}
-	if (!result && diabdat_mpq != nullptr) {
-		result = SFileOpenFileEx((HANDLE)diabdat_mpq, filename, SFILE_OPEN_FROM_MPQ, phFile);
+
+	SErrSetLastError(STORM_ERROR_FILE_NOT_FOUND);
+	return false;
+}
+
+} // namespace
+
+bool SFileOpenFile(const char *filename, HANDLE *phFile)
+{
+	if (TakeCachedFile(filename, phFile))
+		return true;
+
+	bool result = false;
+
+	// The index is keyed by the archive form of the name, which uses backslashes
+	if (FileIndexBuilt && strchr(filename, '/') == nullptr) {
+		result = OpenIndexedFile(filename, phFile);
+	} else {
+		if (directFileAccess && SBasePath != nullptr)
+			result = OpenLocalFile(filename, phFile);
+		for (std::size_t i = 0; i < sizeof(SearchOrder) / sizeof(SearchOrder[0]) && !result; i++) {
+			if (!gbIsHellfire && (HellfireArchives & (1 << i)) != 0)
+				continue;
+			result = OpenArchiveFile(*SearchOrder[i], filename, phFile);
+		}
 	}
 
 	if (!result || (*phFile == nullptr)) {
@@ -138,6 +358,57 @@ bool SFileOpenFile(const char *filename, HANDLE *phFile)
 	return result;
 }
 
+void SFileFreeFileCache()
+{
+	std::vector<HANDLE> files;
+	{
+		const std::lock_guard<SdlMutex> lock(HandleMutex);
+		for (const CachedFile &cachedFile : CachedFiles)
+			files.push_back(cachedFile.file);
+		CachedFiles.clear();
+	}
+
+	for (HANDLE file : files)
+		CloseArchiveFile(file);
+
+	FileIndexBuilt = false;
+	FileIndex.clear();
+	ListedFiles.clear();
+	const std::lock_guard<SdlMutex> lock(HandleMutex);
+	MissingLocalFiles.clear();
+}
+
+void SFileIndexArchives()
+{
+	SFileFreeFileCache();
+	InitHash();
+
+	uint16_t archiveBit = 1;
+	for (HANDLE *archive : SearchOrder) {
+		if (*archive != nullptr) {
+			IndexArchive(*archive, archiveBit);
+			ReadListFile(*archive);
+		}
+		archiveBit <<= 1;
+	}
+
+	std::sort(ListedFiles.begin(), ListedFiles.end());
+	ListedFiles.erase(std::unique(ListedFiles.begin(), ListedFiles.end()), ListedFiles.end());
+	FileIndexBuilt = true;
+}
+
+std::vector<std::string> SFileListFiles(const char *directory)
+{
+	const std::size_t length = strlen(directory);
+
+	std::vector<std::string> files;
+	for (const std::string &file : ListedFiles) {
+		if (file.size() > length && file[length] == '\\' && strncasecmp(file.c_str(), directory, length) == 0)
+			files.push_back(file);
+	}
+	return files;
+}
+
 DWORD SErrGetLastError()
 {
 	return ::GetLastError();
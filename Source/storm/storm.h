@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <vector>
 #include <cstdint>
 
 #include "appfat.h"
@@ -255,6 +256,11 @@ bool WINAPI SFileReadFile(HANDLE hFile, void *buffer, DWORD nNumberOfBytesToRead
 DWORD WINAPI SFileGetFileSize(HANDLE hFile, uint32_t *lpFileSizeHigh = nullptr);
 DWORD WINAPI SFileSetFilePointer(HANDLE, int, int *, int);
 bool WINAPI SFileCloseFile(HANDLE hFile);
+bool WINAPI SFileGetFileInfo(HANDLE hMpqOrFile, int InfoClass, void *pvFileInfo, DWORD cbFileInfo, DWORD *pcbLengthNeeded);
+
+// Values for SFileGetFileInfo, see SFileInfoClass in StormLib/src/StormLib.h
+#define SFILE_INFO_HASH_TABLE_SIZE 18
+#define SFILE_INFO_HASH_TABLE 19
 
 // These error codes are used and returned by StormLib.
 // See StormLib/src/StormPort.h
@@ -320,10 +326,17 @@ bool SFileEnableDirectAccess(bool enable);
 bool SFileOpenArchive(const char *szMpqName, DWORD dwPriority, DWORD dwFlags, HANDLE *phMpq);
 #endif
 
-// Locks ReadFile and CloseFile under a mutex.
+// Locks ReadFile and CloseFile under the mutex of the file's archive, so different archives can be read at the same time.
 // See https://github.com/ladislav-zezula/StormLib/issues/175
 bool SFileReadFileThreadSafe(HANDLE hFile, void *buffer, DWORD nNumberOfBytesToRead, DWORD *read = nullptr, int *lpDistanceToMoveHigh = nullptr);
+// Files opened by SFileOpenFile stay open for a while after they are closed, to be reused when they are opened again.
 bool SFileCloseFileThreadSafe(HANDLE hFile);
+// Closes the files kept open by SFileCloseFileThreadSafe and drops the file index, must be called before closing the archives.
+void SFileFreeFileCache();
+// Merges the hash tables of all open archives into one index, so SFileOpenFile only has to look in the archive that holds the file.
+void SFileIndexArchives();
+// Lists the files in the given directory and its subdirectories, as far as they are known from the archives' listfiles.
+std::vector<std::string> SFileListFiles(const char *directory);
 
 // Sets the file's 64-bit seek position.
 inline std::uint64_t SFileSetFilePointer(HANDLE hFile, std::int64_t offset, int whence)
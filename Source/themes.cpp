@@ -482,7 +482,7 @@ void HoldThemeRooms()
 				}
 			}
 		} else {
-			DRLG_HoldThemeRooms();
+			DRLG_HoldThemeRooms(ActiveDungeon);
 		}
 	}
 }
@@ -288,7 +288,7 @@ void CreateTown(lvl_entry entry)
 	dminy = 10;
 	dmaxx = 84;
 	dmaxy = 84;
-	DRLG_InitTrans();
+	DRLG_InitTrans(ActiveDungeon);
 	DRLG_Init_Globals();
 
 	if (entry == ENTRY_MAIN) { // New game
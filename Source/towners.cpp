@@ -7,6 +7,7 @@
 #include "minitext.h"
 #include "stores.h"
 #include "utils/language.h"
+#include "utils/profiler.h"
 
 namespace devilution {
 namespace {
@@ -854,6 +855,7 @@ void FreeTownerGFX()
 
 void ProcessTowners()
 {
+	ProfileScope profileScope(ProfileStage::ProcessTowners);
 	for (auto &towner : towners) {
 		if (towner._ttype == TOWN_DEADGUY) {
 			TownDead(towner);
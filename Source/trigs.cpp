@@ -816,10 +816,50 @@ void CheckTrigForce()
 	}
 }
 
+/**
+ * @brief Start loading the files of the level behind a trigger once the player gets close to it
+ */
+void PrefetchTriggerLevel()
+{
+	/** Distance in tiles from a trigger at which the next level starts loading */
+	constexpr int PrefetchDistance = 5;
+
+	const Point position = plr[myplr].position.tile;
+
+	for (int i = 0; i < numtrigs; i++) {
+		if (position.WalkingDistance(trigs[i].position) > PrefetchDistance)
+			continue;
+
+		switch (trigs[i]._tmsg) {
+		case WM_DIABNEXTLVL:
+			if (!gbIsSpawn || currlevel < 2)
+				PrefetchLevelAssets(currlevel + 1, gnLevelTypeTbl[currlevel + 1]);
+			break;
+		case WM_DIABPREVLVL:
+			PrefetchLevelAssets(currlevel - 1, gnLevelTypeTbl[currlevel - 1]);
+			break;
+		case WM_DIABRTNLVL:
+			PrefetchLevelAssets(ReturnLvl, ReturnLvlT);
+			break;
+		case WM_DIABTOWNWARP:
+			PrefetchLevelAssets(trigs[i]._tlvl, gnLevelTypeTbl[trigs[i]._tlvl]);
+			break;
+		case WM_DIABTWARPUP:
+			PrefetchLevelAssets(0, DTYPE_TOWN);
+			break;
+		default:
+			break;
+		}
+		return;
+	}
+}
+
 void CheckTriggers()
 {
 	auto &myPlayer = plr[myplr];
 
+	PrefetchTriggerLevel();
+
 	if (myPlayer._pmode != PM_STAND)
 		return;
 
@@ -31,3 +31,9 @@
 #else
 #define DVL_ATTRIBUTE_HOT
 #endif
+
+#if DVL_HAVE_ATTRIBUTE(target) || (defined(__GNUC__) && !defined(__clang__))
+#define DVL_ATTRIBUTE_TARGET(x) __attribute__((target(x)))
+#else
+#define DVL_ATTRIBUTE_TARGET(x)
+#endif
@@ -15,6 +15,7 @@
 #include "controls/devices/joystick.h"
 #include "controls/devices/kbcontroller.h"
 #include "controls/game_controls.h"
+#include "dx.h"
 #include "options.h"
 #include "utils/log.hpp"
 
@@ -261,8 +262,10 @@ SDL_Surface *GetOutputSurface()
 #ifdef USE_SDL1
 	return SDL_GetVideoSurface();
 #else
-	if (renderer != nullptr)
+	if (renderer != nullptr) {
+		SyncOutputSurface();
 		return renderer_texture_surface;
+	}
 	return SDL_GetWindowSurface(ghMainWnd);
 #endif
 }
@@ -110,6 +110,37 @@ bool GetFileSize(const char *path, std::uintmax_t *size)
 #endif
 }
 
+bool GetFileSizeAndTime(const char *path, std::uintmax_t *size, std::int64_t *modified)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+	if (!GetFileAttributesExW(&pathUtf16[0], GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+	*size = static_cast<std::uintmax_t>(attr.nFileSizeHigh) << 32 | attr.nFileSizeLow;
+	*modified = static_cast<std::int64_t>(static_cast<std::uint64_t>(attr.ftLastWriteTime.dwHighDateTime) << 32 | attr.ftLastWriteTime.dwLowDateTime);
+	return true;
+#else
+	struct ::stat statResult;
+	if (::stat(path, &statResult) == -1)
+		return false;
+	*size = static_cast<uintmax_t>(statResult.st_size);
+#if defined(__APPLE__)
+	*modified = static_cast<std::int64_t>(statResult.st_mtimespec.tv_sec) * 1000000000 + statResult.st_mtimespec.tv_nsec;
+#elif _POSIX_C_SOURCE >= 200809L
+	*modified = static_cast<std::int64_t>(statResult.st_mtim.tv_sec) * 1000000000 + statResult.st_mtim.tv_nsec;
+#else
+	*modified = static_cast<std::int64_t>(statResult.st_mtime);
+#endif
+	return true;
+#endif
+}
+
 bool ResizeFile(const char *path, std::uintmax_t size)
 {
 #if defined(_WIN64) || defined(_WIN32)
@@ -163,6 +194,21 @@ void RemoveFile(const char *lpFileName)
 #endif
 }
 
+bool RenameFile(const char *from, const char *to)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	const auto fromUtf16 = ToWideChar(from);
+	const auto toUtf16 = ToWideChar(to);
+	if (fromUtf16 == nullptr || toUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	return ::MoveFileExW(&fromUtf16[0], &toUtf16[0], MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return std::rename(from, to) == 0;
+#endif
+}
+
 std::unique_ptr<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode)
 {
 #if defined(_WIN64) || defined(_WIN32)
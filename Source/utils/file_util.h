@@ -12,8 +12,15 @@ namespace devilution {
 bool FileExists(const char *path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
+/**
+ * @brief Read the size and last modification time of a file in one go
+ * @param modified Platform specific time stamp, only meant to be compared with earlier results for the same file
+ */
+bool GetFileSizeAndTime(const char *path, std::uintmax_t *size, std::int64_t *modified);
 bool ResizeFile(const char *path, std::uintmax_t size);
 void RemoveFile(const char *lpFileName);
+/** @brief Move a file, replacing the destination if it exists */
+bool RenameFile(const char *from, const char *to);
 std::unique_ptr<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode);
 FILE *FOpen(const char *path, const char *mode);
 
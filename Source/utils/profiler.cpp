@@ -0,0 +1,198 @@
+/**
+ * @file profiler.cpp
+ *
+ * Implementation of the frame profiler that times the stages of the game loop.
+ */
+#include "utils/profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "engine/render/dun_tile_cache.hpp"
+#include "engine/render/text_render.hpp"
+#include "utils/enum_traits.h"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+
+namespace devilution {
+
+bool ProfilerActive;
+
+namespace {
+
+/** Number of recent samples the overlay statistics are based on */
+constexpr size_t SampleCount = 256;
+/** Upper limit on the number of events kept for a trace, roughly a few minutes of play */
+constexpr size_t MaxTraceEvents = 1 << 20;
+
+struct StageInfo {
+	const char *name;
+	/** Nesting level in the overlay */
+	int depth;
+};
+
+const StageInfo Stages[] = {
+	{ "game_logic", 0 },
+	{ "ProcessPlayers", 1 },
+	{ "ProcessMonsters", 1 },
+	{ "ProcessObjects", 1 },
+	{ "ProcessMissiles", 1 },
+	{ "ProcessItems", 1 },
+	{ "ProcessTowners", 1 },
+	{ "ProcessLightList", 1 },
+	{ "ProcessVisionList", 1 },
+	{ "DrawAndBlit", 0 },
+	{ "scrollrt_drawFloor", 1 },
+	{ "scrollrt_draw", 1 },
+	{ "Zoom", 1 },
+	{ "DrawMain", 1 },
+	{ "RenderPresent", 1 },
+};
+
+static_assert(sizeof(Stages) / sizeof(Stages[0]) == enum_size<ProfileStage>::value, "Every stage needs a name");
+
+struct StageSamples {
+	/** Durations in microseconds */
+	std::array<uint32_t, SampleCount> durations;
+	size_t count;
+	size_t next;
+};
+
+struct TraceEvent {
+	ProfileStage stage;
+	/** Microseconds since the trace was started */
+	int64_t begin;
+	uint32_t duration;
+};
+
+bool OverlayVisible;
+std::array<StageSamples, enum_size<ProfileStage>::value> Samples;
+/** Tile cache counters when the overlay was opened */
+TileCacheStats TileCacheBaseline;
+
+bool Tracing;
+std::string TracePath;
+std::chrono::steady_clock::time_point TraceStart;
+std::vector<TraceEvent> TraceEvents;
+
+void UpdateProfilerActive()
+{
+	ProfilerActive = OverlayVisible || Tracing;
+}
+
+int64_t ToMicroseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+} // namespace
+
+void ToggleProfilerOverlay()
+{
+	OverlayVisible = !OverlayVisible;
+	Samples = {};
+	TileCacheBaseline = GetTileCacheStats();
+	UpdateProfilerActive();
+}
+
+void StartProfilerTrace(const char *path)
+{
+	TracePath = path;
+	TraceEvents.clear();
+	TraceStart = std::chrono::steady_clock::now();
+	Tracing = true;
+	UpdateProfilerActive();
+}
+
+void StopProfilerTrace()
+{
+	if (!Tracing)
+		return;
+	Tracing = false;
+	UpdateProfilerActive();
+
+	FILE *file = FOpen(TracePath.c_str(), "w");
+	if (file == nullptr) {
+		LogError("Failed to write the profiler trace to {}", TracePath);
+		return;
+	}
+
+	fputs("{\"traceEvents\":[\n", file);
+	for (size_t i = 0; i < TraceEvents.size(); i++) {
+		const TraceEvent &event = TraceEvents[i];
+		fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%u,\"pid\":1,\"tid\":1}%s\n",
+		    Stages[static_cast<size_t>(event.stage)].name,
+		    static_cast<long long>(event.begin),
+		    event.duration,
+		    i + 1 < TraceEvents.size() ? "," : "");
+	}
+	fputs("]}\n", file);
+	fclose(file);
+
+	TraceEvents.clear();
+	TraceEvents.shrink_to_fit();
+}
+
+void AddProfileSample(ProfileStage stage, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+{
+	const auto duration = static_cast<uint32_t>(ToMicroseconds(end - begin));
+
+	StageSamples &samples = Samples[static_cast<size_t>(stage)];
+	samples.durations[samples.next] = duration;
+	samples.next = (samples.next + 1) % SampleCount;
+	samples.count = std::min(samples.count + 1, SampleCount);
+
+	if (Tracing && TraceEvents.size() < MaxTraceEvents)
+		TraceEvents.push_back({ stage, ToMicroseconds(begin - TraceStart), duration });
+}
+
+void DrawProfilerOverlay(const CelOutputBuffer &out)
+{
+	if (!OverlayVisible)
+		return;
+
+	constexpr int LineHeight = 12;
+	Point position { 8, 85 };
+	DrawString(out, "Stage", position, UIS_GOLD);
+	DrawString(out, "avg ms", position + Point { 150, 0 }, UIS_GOLD);
+	DrawString(out, "p99 ms", position + Point { 200, 0 }, UIS_GOLD);
+
+	std::array<uint32_t, SampleCount> sorted;
+	char text[48];
+	for (size_t i = 0; i < Samples.size(); i++) {
+		const StageSamples &samples = Samples[i];
+		if (samples.count == 0)
+			continue;
+
+		uint64_t total = 0;
+		for (size_t j = 0; j < samples.count; j++)
+			total += samples.durations[j];
+		std::copy_n(samples.durations.begin(), samples.count, sorted.begin());
+		auto p99 = sorted.begin() + samples.count * 99 / 100;
+		std::nth_element(sorted.begin(), p99, sorted.begin() + samples.count);
+
+		position.y += LineHeight;
+		DrawString(out, Stages[i].name, position + Point { Stages[i].depth * 10, 0 }, UIS_SILVER);
+		snprintf(text, sizeof(text), "%.2f", total / 1000.0 / samples.count);
+		DrawString(out, text, position + Point { 150, 0 }, UIS_SILVER);
+		snprintf(text, sizeof(text), "%.2f", *p99 / 1000.0);
+		DrawString(out, text, position + Point { 200, 0 }, UIS_SILVER);
+	}
+
+	const TileCacheStats tiles = GetTileCacheStats();
+	const uint64_t hits = tiles.hits - TileCacheBaseline.hits;
+	const uint64_t lookups = hits + tiles.misses - TileCacheBaseline.misses;
+	position.y += LineHeight * 2;
+	snprintf(text, sizeof(text), "Tile cache: %.1f%% hits", lookups != 0 ? hits * 100.0 / lookups : 0.0);
+	DrawString(out, text, position, UIS_SILVER);
+	position.y += LineHeight;
+	snprintf(text, sizeof(text), "%i tiles, %i KB, %i evicted", static_cast<int>(tiles.entries), static_cast<int>(tiles.bytes / 1024),
+	    static_cast<int>(tiles.evictions - TileCacheBaseline.evictions));
+	DrawString(out, text, position, UIS_SILVER);
+}
+
+} // namespace devilution
@@ -0,0 +1,89 @@
+/**
+ * @file profiler.h
+ *
+ * Interface of the frame profiler that times the stages of the game loop.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace devilution {
+
+struct CelOutputBuffer;
+
+enum class ProfileStage : uint8_t {
+	GameLogic,
+	ProcessPlayers,
+	ProcessMonsters,
+	ProcessObjects,
+	ProcessMissiles,
+	ProcessItems,
+	ProcessTowners,
+	ProcessLightList,
+	ProcessVisionList,
+	DrawAndBlit,
+	DrawFloor,
+	DrawDungeon,
+	Zoom,
+	DrawMain,
+	RenderPresent,
+
+	LAST = RenderPresent
+};
+
+/** Set while the overlay is shown or a trace is being recorded */
+extern bool ProfilerActive;
+
+/**
+ * @brief Show or hide the per stage timings
+ */
+void ToggleProfilerOverlay();
+
+/**
+ * @brief Record every timed scope until StopProfilerTrace is called
+ * @param path File the trace is written to, in the Chrome trace event format
+ */
+void StartProfilerTrace(const char *path);
+
+/**
+ * @brief Write the recorded trace to disk, if one is being recorded
+ */
+void StopProfilerTrace();
+
+/**
+ * @brief Draw the rolling average and 99th percentile time of each stage
+ */
+void DrawProfilerOverlay(const CelOutputBuffer &out);
+
+void AddProfileSample(ProfileStage stage, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+/**
+ * @brief Times the enclosing scope as the given stage while the profiler is active
+ */
+class ProfileScope {
+public:
+	explicit ProfileScope(ProfileStage stage)
+	    : stage_(stage)
+	    , active_(ProfilerActive)
+	{
+		if (active_)
+			begin_ = std::chrono::steady_clock::now();
+	}
+
+	~ProfileScope()
+	{
+		if (active_)
+			AddProfileSample(stage_, begin_, std::chrono::steady_clock::now());
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+	ProfileStage stage_;
+	bool active_;
+	std::chrono::steady_clock::time_point begin_;
+};
+
+} // namespace devilution
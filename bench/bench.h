@@ -0,0 +1,77 @@
+/**
+ * @file bench.h
+ *
+ * Interface of the benchmarks run by devilutionx-bench.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Accumulates an FNV-1a hash of the simulation state, used to check that runs are deterministic
+ */
+class Checksum {
+public:
+	template <typename T>
+	void Add(const T &value)
+	{
+		Add(&value, sizeof(value));
+	}
+
+	void Add(const void *data, std::size_t size)
+	{
+		auto bytes = static_cast<const uint8_t *>(data);
+		for (std::size_t i = 0; i < size; i++) {
+			hash_ ^= bytes[i];
+			hash_ *= 1099511628211ULL;
+		}
+	}
+
+	uint64_t Value() const
+	{
+		return hash_;
+	}
+
+private:
+	uint64_t hash_ = 14695981039346656037ULL;
+};
+
+/**
+ * @brief Run the game simulation for a number of ticks without a window or sound
+ */
+int RunSimulationBench(int argc, char **argv);
+
+/**
+ * @brief Time the level generators over a range of seeds and report the distribution and the slowest seeds
+ */
+int RunDungeonBench(int argc, char **argv);
+
+/**
+ * @brief Render the level tiles with every supported set of line kernels and check that they match the scalar ones
+ */
+int RunTileBench(int argc, char **argv);
+
+/**
+ * @brief Build the blended transparency table for generated palettes and check it against a linear palette search
+ */
+int RunPaletteBench(int argc, char **argv);
+
+/**
+ * @brief Compress and decompress level delta payloads with the allocating and the workspace PKWare wrappers
+ */
+int RunPkwareBench(int argc, char **argv);
+
+/**
+ * @brief Read files from generated archives with a growing number of threads and check their contents
+ */
+int RunStormBench(int argc, char **argv);
+
+/**
+ * @brief Render a generated level view with and without culling hidden sprites and check that the frames match
+ */
+int RunViewBench(int argc, char **argv);
+
+} // namespace devilution
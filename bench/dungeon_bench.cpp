@@ -0,0 +1,268 @@
+/**
+ * @file dungeon_bench.cpp
+ *
+ * Measures how long the level generators take over a range of seeds, sharding the seeds over worker threads.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "diablo.h"
+#include "drlg_l1.h"
+#include "drlg_l2.h"
+#include "drlg_l3.h"
+#include "drlg_l4.h"
+#include "gendung.h"
+#include "init.h"
+#include "miniwin/miniwin.h"
+#include "utils/paths.h"
+
+namespace devilution {
+
+namespace {
+
+struct GeneratorInfo {
+	const char *name;
+	/** Level used to pick the tileset, generators use it to decide on stairs and special rooms */
+	int level;
+	dungeon_type type;
+	bool hellfire;
+};
+
+const GeneratorInfo Generators[] = {
+	{ "cathedral", 2, DTYPE_CATHEDRAL, false },
+	{ "catacombs", 6, DTYPE_CATACOMBS, false },
+	{ "caves", 10, DTYPE_CAVES, false },
+	{ "hell", 14, DTYPE_HELL, false },
+	{ "nest", 18, DTYPE_CAVES, true },
+	{ "crypt", 22, DTYPE_CATHEDRAL, true },
+};
+
+constexpr int GeneratorCount = sizeof(Generators) / sizeof(Generators[0]);
+
+struct DungeonOptions {
+	uint32_t firstSeed = 0;
+	int seeds = 1000;
+	int workers = 0;
+	int worstSeeds = 10;
+	const char *dataDir = nullptr;
+	const char *hashFile = nullptr;
+	const char *generator = nullptr;
+	bool forceDiablo = false;
+};
+
+struct SeedResult {
+	int generator;
+	uint32_t seed;
+	uint32_t micros;
+	uint64_t hash;
+};
+
+bool ParseOptions(int argc, char **argv, DungeonOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--data-dir", argv[i]) == 0 && i + 1 < argc) {
+			options.dataDir = argv[++i];
+			paths::SetBasePath(options.dataDir);
+		} else if (strcasecmp("--first-seed", argv[i]) == 0 && i + 1 < argc) {
+			options.firstSeed = strtoul(argv[++i], nullptr, 10);
+		} else if (strcasecmp("--seeds", argv[i]) == 0 && i + 1 < argc) {
+			options.seeds = atoi(argv[++i]);
+		} else if (strcasecmp("--workers", argv[i]) == 0 && i + 1 < argc) {
+			options.workers = atoi(argv[++i]);
+		} else if (strcasecmp("--worst", argv[i]) == 0 && i + 1 < argc) {
+			options.worstSeeds = atoi(argv[++i]);
+		} else if (strcasecmp("--hashes", argv[i]) == 0 && i + 1 < argc) {
+			options.hashFile = argv[++i];
+		} else if (strcasecmp("--type", argv[i]) == 0 && i + 1 < argc) {
+			options.generator = argv[++i];
+		} else if (strcasecmp("--diablo", argv[i]) == 0) {
+			options.forceDiablo = true;
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--data-dir", "Folder of diabdat.mpq");
+			printf("    %-20s %s\n", "--first-seed <#>", "First seed to generate");
+			printf("    %-20s %s\n", "--seeds <#>", "Number of seeds to generate per dungeon type");
+			printf("    %-20s %s\n", "--workers <#>", "Number of worker threads, defaults to one per core");
+			printf("    %-20s %s\n", "--worst <#>", "Number of slowest seeds to list per dungeon type");
+			printf("    %-20s %s\n", "--hashes <file>", "Write the layout hash of every seed to a file");
+			printf("    %-20s %s\n", "--type <name>", "Only generate one dungeon type");
+			printf("    %-20s %s\n", "--diablo", "Ignore hellfire.mpq");
+			return false;
+		}
+	}
+
+	if (options.workers <= 0)
+		options.workers = std::max(1U, std::thread::hardware_concurrency());
+
+	return options.seeds > 0;
+}
+
+bool IsGeneratorSelected(const DungeonOptions &options, int generator)
+{
+	if (options.generator != nullptr)
+		return strcasecmp(options.generator, Generators[generator].name) == 0;
+	return gbIsHellfire || !Generators[generator].hellfire;
+}
+
+void LoadGeneratorGFX(const GeneratorInfo &generator)
+{
+	pDungeonCels = nullptr;
+	pMegaTiles = nullptr;
+	pLevelPieces = nullptr;
+	pSpecialCels = std::nullopt;
+
+	currlevel = generator.level;
+	leveltype = generator.type;
+	setlevel = false;
+	LoadLvlGFX();
+}
+
+void GenerateDungeon(DungeonContext &ctx, const GeneratorInfo &generator, uint32_t seed)
+{
+	ctx.currlevel = generator.level;
+	ctx.leveltype = generator.type;
+	switch (generator.type) {
+	case DTYPE_CATHEDRAL:
+		CreateL5Dungeon(ctx, seed, ENTRY_MAIN);
+		break;
+	case DTYPE_CATACOMBS:
+		CreateL2Dungeon(ctx, seed, ENTRY_MAIN);
+		break;
+	case DTYPE_CAVES:
+		CreateL3Dungeon(ctx, seed, ENTRY_MAIN);
+		break;
+	default:
+		CreateL4Dungeon(ctx, seed, ENTRY_MAIN);
+		break;
+	}
+}
+
+uint64_t GetLayoutHash(const DungeonContext &ctx)
+{
+	Checksum checksum;
+	checksum.Add(ctx.dungeon, sizeof(ctx.dungeon));
+	checksum.Add(ctx.dPiece, sizeof(ctx.dPiece));
+	return checksum.Value();
+}
+
+/**
+ * @brief Generate every seed of one dungeon type, spreading the seeds over the worker threads
+ */
+void RunGenerator(const DungeonOptions &options, int generator, std::vector<SeedResult> &results)
+{
+	std::vector<std::vector<SeedResult>> workerResults(options.workers);
+	std::vector<std::thread> workers;
+	for (int worker = 0; worker < options.workers; worker++) {
+		workers.emplace_back([&options, &workerResults, generator, worker]() {
+			for (int i = worker; i < options.seeds; i += options.workers) {
+				// Every seed starts from a fresh context so nothing left by the previous seed affects it
+				auto ctx = std::make_unique<DungeonContext>();
+				const uint32_t seed = options.firstSeed + i;
+				const auto start = std::chrono::steady_clock::now();
+				GenerateDungeon(*ctx, Generators[generator], seed);
+				const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+				workerResults[worker].push_back({ generator, seed, static_cast<uint32_t>(elapsed.count()), GetLayoutHash(*ctx) });
+			}
+		});
+	}
+	for (std::thread &worker : workers)
+		worker.join();
+
+	for (const std::vector<SeedResult> &workerResult : workerResults)
+		results.insert(results.end(), workerResult.begin(), workerResult.end());
+}
+
+double GetPercentile(const std::vector<SeedResult> &sorted, int percentile)
+{
+	const size_t index = std::min(sorted.size() - 1, sorted.size() * percentile / 100);
+	return sorted[index].micros / 1000.0;
+}
+
+void PrintReport(const DungeonOptions &options, std::vector<SeedResult> &results)
+{
+	for (int generator = 0; generator < GeneratorCount; generator++) {
+		std::vector<SeedResult> sorted;
+		for (const SeedResult &result : results) {
+			if (result.generator == generator)
+				sorted.push_back(result);
+		}
+		if (sorted.empty())
+			continue;
+
+		std::sort(sorted.begin(), sorted.end(), [](const SeedResult &a, const SeedResult &b) {
+			return a.micros < b.micros;
+		});
+		double total = 0;
+		for (const SeedResult &result : sorted)
+			total += result.micros / 1000.0;
+
+		printf("%s: %zu levels, %.0f levels/s\n", Generators[generator].name, sorted.size(), sorted.size() * 1000 / total);
+		printf("    ms: mean %.2f, min %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+		    total / sorted.size(), sorted.front().micros / 1000.0, GetPercentile(sorted, 50), GetPercentile(sorted, 90), GetPercentile(sorted, 99), sorted.back().micros / 1000.0);
+		printf("    worst seeds:");
+		for (int i = 0; i < options.worstSeeds && i < static_cast<int>(sorted.size()); i++) {
+			const SeedResult &result = sorted[sorted.size() - 1 - i];
+			printf(" %u (%.2f ms)", result.seed, result.micros / 1000.0);
+		}
+		printf("\n");
+	}
+}
+
+bool WriteHashes(const char *path, std::vector<SeedResult> &results)
+{
+	FILE *file = fopen(path, "w");
+	if (file == nullptr)
+		return false;
+
+	std::sort(results.begin(), results.end(), [](const SeedResult &a, const SeedResult &b) {
+		if (a.generator != b.generator)
+			return a.generator < b.generator;
+		return a.seed < b.seed;
+	});
+	for (const SeedResult &result : results)
+		fprintf(file, "%s %u %016llx\n", Generators[result.generator].name, result.seed, static_cast<unsigned long long>(result.hash));
+
+	return fclose(file) == 0;
+}
+
+} // namespace
+
+int RunDungeonBench(int argc, char **argv)
+{
+	DungeonOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	init_archives();
+	if (options.forceDiablo)
+		gbIsHellfire = false;
+
+	// The generators write into the DungeonContext they are given, so the seeds can be spread over threads
+	std::vector<SeedResult> results;
+	const auto start = std::chrono::steady_clock::now();
+	for (int generator = 0; generator < GeneratorCount; generator++) {
+		if (!IsGeneratorSelected(options, generator))
+			continue;
+		LoadGeneratorGFX(Generators[generator]);
+		RunGenerator(options, generator, results);
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("%zu levels on %d threads in %.3f s\n", results.size(), options.workers, elapsed.count());
+	PrintReport(options, results);
+
+	if (options.hashFile != nullptr && !WriteHashes(options.hashFile, results)) {
+		printf("Failed to write %s\n", options.hashFile);
+		return 1;
+	}
+
+	return 0;
+}
+
+} // namespace devilution
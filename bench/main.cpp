@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench.h"
+#include "diablo.h"
+#include "miniwin/miniwin.h"
+
+using namespace devilution;
+
+namespace {
+
+struct Benchmark {
+	const char *name;
+	const char *description;
+	int (*run)(int argc, char **argv);
+};
+
+const Benchmark Benchmarks[] = {
+	{ "simulation", "Run monsters, missiles and lighting on a generated level", RunSimulationBench },
+	{ "dungeon", "Generate levels from many seeds and report the slowest ones", RunDungeonBench },
+	{ "tiles", "Render the tiles of every tileset with each instruction set", RunTileBench },
+	{ "palette", "Build the blended transparency table with and without the color grid", RunPaletteBench },
+	{ "pkware", "Compress level deltas with and without reusable workspaces", RunPkwareBench },
+	{ "storm", "Read files from archives with one thread and with several", RunStormBench },
+	{ "view", "Render a level view with and without culling sprites hidden by walls", RunViewBench },
+};
+
+void PrintUsage()
+{
+	printf("Usage: devilutionx-bench <benchmark> [options]\n\nBenchmarks:\n");
+	for (const Benchmark &benchmark : Benchmarks)
+		printf("    %-20s %s\n", benchmark.name, benchmark.description);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	gbQuietMode = true;
+
+	if (argc < 2) {
+		PrintUsage();
+		return 1;
+	}
+
+	for (const Benchmark &benchmark : Benchmarks) {
+		if (strcasecmp(benchmark.name, argv[1]) == 0)
+			return benchmark.run(argc - 1, argv + 1);
+	}
+
+	PrintUsage();
+	return 1;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file palette_bench.cpp
+ *
+ * Times building the blended transparency table with a linear palette search and with the color grid,
+ * and checks that both produce the same table.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "bench.h"
+#include "miniwin/miniwin.h"
+#include "palette.h"
+
+namespace devilution {
+
+namespace {
+
+struct SkipRange {
+	const char *name;
+	int skipFrom;
+	int skipTo;
+};
+
+/** The ranges LoadPalette leaves out for the tilesets with color cycling */
+const SkipRange SkipRanges[] = {
+	{ "none", -1, -1 },
+	{ "caves", 1, 31 },
+	{ "nest", 1, 15 },
+};
+
+struct PaletteOptions {
+	int iterations = 10;
+	uint32_t seed = 1;
+};
+
+bool ParseOptions(int argc, char **argv, PaletteOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--iterations", argv[i]) == 0 && i + 1 < argc) {
+			options.iterations = atoi(argv[++i]);
+		} else if (strcasecmp("--seed", argv[i]) == 0 && i + 1 < argc) {
+			options.seed = strtoul(argv[++i], nullptr, 10);
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--iterations <#>", "Number of palettes to build tables for");
+			printf("    %-20s %s\n", "--seed <#>", "Seed of the generated palettes");
+			return false;
+		}
+	}
+
+	return options.iterations > 0;
+}
+
+/**
+ * @brief Fill a palette with ramps of shades like the game palettes, with some random colors in between
+ */
+void GeneratePalette(std::mt19937 &rng, SDL_Color *palette)
+{
+	std::uniform_int_distribution<int> channel(0, 255);
+	for (int ramp = 0; ramp < 256; ramp += 16) {
+		const int r = channel(rng);
+		const int g = channel(rng);
+		const int b = channel(rng);
+		for (int shade = 0; shade < 16; shade++) {
+			SDL_Color &color = palette[ramp + shade];
+			if (shade % 5 == 4) {
+				color = { static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), 255 };
+				continue;
+			}
+			color.r = r * (16 - shade) / 16;
+			color.g = g * (16 - shade) / 16;
+			color.b = b * (16 - shade) / 16;
+			color.a = 255;
+		}
+	}
+}
+
+/** The search GenerateBlendedLookupTable used before the color grid */
+Uint8 FindBestMatchLinear(const SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
+{
+	Uint8 best = 0;
+	Uint32 bestDiff = SDL_MAX_UINT32;
+	for (int i = 0; i < 256; i++) {
+		if (i >= skipFrom && i <= skipTo)
+			continue;
+		int diffr = palette[i].r - color.r;
+		int diffg = palette[i].g - color.g;
+		int diffb = palette[i].b - color.b;
+		Uint32 diff = diffr * diffr + diffg * diffg + diffb * diffb;
+
+		if (bestDiff > diff) {
+			best = i;
+			bestDiff = diff;
+		}
+	}
+	return best;
+}
+
+void GenerateLinear(const SDL_Color *palette, int skipFrom, int skipTo, Uint8 (*table)[256])
+{
+	for (int i = 0; i < 256; i++) {
+		table[i][i] = i;
+		for (int j = 0; j < i; j++)
+			table[i][j] = table[j][i];
+		for (int j = i + 1; j < 256; j++) {
+			SDL_Color blendedColor;
+			blendedColor.r = ((int)palette[i].r + (int)palette[j].r) / 2;
+			blendedColor.g = ((int)palette[i].g + (int)palette[j].g) / 2;
+			blendedColor.b = ((int)palette[i].b + (int)palette[j].b) / 2;
+			table[i][j] = FindBestMatchLinear(palette, blendedColor, skipFrom, skipTo);
+		}
+	}
+}
+
+} // namespace
+
+int RunPaletteBench(int argc, char **argv)
+{
+	PaletteOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	static Uint8 linearTable[256][256];
+	bool succeeded = true;
+	for (const SkipRange &range : SkipRanges) {
+		std::mt19937 rng(options.seed);
+		std::chrono::duration<double> linearTime {};
+		std::chrono::duration<double> gridTime {};
+		Checksum checksum;
+		bool matches = true;
+
+		for (int iteration = 0; iteration < options.iterations; iteration++) {
+			SDL_Color palette[256];
+			GeneratePalette(rng, palette);
+
+			auto start = std::chrono::steady_clock::now();
+			GenerateLinear(palette, range.skipFrom, range.skipTo, linearTable);
+			linearTime += std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			GenerateBlendedLookupTable(palette, range.skipFrom, range.skipTo);
+			gridTime += std::chrono::steady_clock::now() - start;
+
+			checksum.Add(paletteTransparencyLookup, sizeof(paletteTransparencyLookup));
+			if (memcmp(linearTable, paletteTransparencyLookup, sizeof(linearTable)) != 0)
+				matches = false;
+		}
+
+		printf("%-6s linear %7.2f ms  grid %7.2f ms  %5.1fx  %016llx%s\n", range.name,
+		    linearTime.count() * 1000 / options.iterations, gridTime.count() * 1000 / options.iterations,
+		    linearTime.count() / gridTime.count(), static_cast<unsigned long long>(checksum.Value()),
+		    matches ? "" : "  MISMATCH");
+		if (!matches)
+			succeeded = false;
+	}
+
+	if (!succeeded) {
+		printf("The color grid picked different colors than the linear search\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+} // namespace devilution
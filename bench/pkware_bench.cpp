@@ -0,0 +1,252 @@
+/**
+ * @file pkware_bench.cpp
+ *
+ * Times compressing and decompressing level delta payloads with the allocating PKWare wrappers the game used to have
+ * and with the ones that reuse a per-thread workspace, and checks that both produce the same data.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "diablo.h"
+#include "encrypt.h"
+#include "miniwin/miniwin.h"
+#include "msg.h"
+#include "pkware.h"
+
+namespace devilution {
+
+namespace {
+
+struct PkwareOptions {
+	int iterations = 20;
+	uint32_t seed = 1;
+};
+
+bool ParseOptions(int argc, char **argv, PkwareOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--iterations", argv[i]) == 0 && i + 1 < argc) {
+			options.iterations = atoi(argv[++i]);
+		} else if (strcasecmp("--seed", argv[i]) == 0 && i + 1 < argc) {
+			options.seed = strtoul(argv[++i], nullptr, 10);
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--iterations <#>", "Number of times every payload is compressed");
+			printf("    %-20s %s\n", "--seed <#>", "Seed of the generated levels");
+			return false;
+		}
+	}
+
+	return options.iterations > 0;
+}
+
+/**
+ * @brief Fill a level with the kind of changes a multiplayer game accumulates: dropped items, used objects and slain monsters
+ */
+void GenerateLevel(std::mt19937 &rng, DLevel &level)
+{
+	memset(&level, 0xFF, sizeof(level));
+
+	const int items = std::uniform_int_distribution<int>(0, 40)(rng);
+	for (int i = 0; i < items; i++) {
+		TCmdPItem &item = level.item[std::uniform_int_distribution<int>(0, MAXITEMS - 1)(rng)];
+		item = {};
+		item.bCmd = i % 4 == 0 ? CMD_WALKXY : CMD_STAND;
+		item.x = std::uniform_int_distribution<int>(16, 95)(rng);
+		item.y = std::uniform_int_distribution<int>(16, 95)(rng);
+		item.wIndx = std::uniform_int_distribution<int>(0, 160)(rng);
+		item.wCI = std::uniform_int_distribution<int>(0, 0x7FFF)(rng);
+		item.dwSeed = static_cast<int32_t>(rng());
+		item.bId = 1;
+		item.bDur = item.bMDur = std::uniform_int_distribution<int>(0, 60)(rng);
+		item.wValue = std::uniform_int_distribution<int>(0, 5000)(rng);
+	}
+
+	const int objects = std::uniform_int_distribution<int>(0, 30)(rng);
+	for (int i = 0; i < objects; i++)
+		level.object[std::uniform_int_distribution<int>(0, MAXOBJECTS - 1)(rng)].bCmd = i % 3 == 0 ? CMD_OPENDOOR : CMD_OPERATEOBJ;
+
+	const int monsters = std::uniform_int_distribution<int>(0, 120)(rng);
+	for (int i = 0; i < monsters; i++) {
+		DMonsterStr &monster = level.monster[std::uniform_int_distribution<int>(0, MAXMONSTERS - 1)(rng)];
+		monster._mx = std::uniform_int_distribution<int>(16, 95)(rng);
+		monster._my = std::uniform_int_distribution<int>(16, 95)(rng);
+		monster._mdir = static_cast<Direction>(std::uniform_int_distribution<int>(0, 7)(rng));
+		monster._menemy = 0;
+		monster._mactive = i % 2 == 0 ? 0 : UINT8_MAX;
+		monster._mhitpoints = i % 2 == 0 ? 0 : std::uniform_int_distribution<int>(1, 400)(rng) << 6;
+	}
+}
+
+/** Serializes a level the way DeltaExportData does before compressing it */
+std::vector<byte> ExportLevel(const DLevel &level)
+{
+	std::vector<byte> payload;
+	for (const TCmdPItem &item : level.item) {
+		if (item.bCmd == 0xFF) {
+			payload.push_back(byte { 0xFF });
+			continue;
+		}
+		const byte *data = reinterpret_cast<const byte *>(&item);
+		payload.insert(payload.end(), data, data + sizeof(item));
+	}
+	const byte *objects = reinterpret_cast<const byte *>(level.object);
+	payload.insert(payload.end(), objects, objects + sizeof(level.object));
+	for (const DMonsterStr &monster : level.monster) {
+		if (monster._mx == 0xFF) {
+			payload.push_back(byte { 0xFF });
+			continue;
+		}
+		const byte *data = reinterpret_cast<const byte *>(&monster);
+		payload.insert(payload.end(), data, data + sizeof(monster));
+	}
+	return payload;
+}
+
+unsigned int LegacyRead(char *buf, unsigned int *size, void *param)
+{
+	TDataInfo *pInfo = (TDataInfo *)param;
+	const uint32_t sSize = std::min(*size, pInfo->size - pInfo->srcOffset);
+	memcpy(buf, pInfo->srcData + pInfo->srcOffset, sSize);
+	pInfo->srcOffset += sSize;
+	return sSize;
+}
+
+void LegacyWrite(char *buf, unsigned int *size, void *param)
+{
+	TDataInfo *pInfo = (TDataInfo *)param;
+	memcpy(pInfo->destData + pInfo->destOffset, buf, *size);
+	pInfo->destOffset += *size;
+}
+
+/** The in place compression the game used before, with two allocations and a copy back per call */
+uint32_t LegacyCompress(byte *srcData, uint32_t size)
+{
+	std::unique_ptr<char[]> ptr { new char[CMP_BUFFER_SIZE] };
+
+	unsigned destSize = 2 * size;
+	if (destSize < 2 * 4096)
+		destSize = 2 * 4096;
+
+	std::unique_ptr<byte[]> destData { new byte[destSize] };
+
+	TDataInfo param {};
+	param.srcData = srcData;
+	param.destData = destData.get();
+	param.size = size;
+
+	unsigned type = 0;
+	unsigned dsize = 4096;
+	implode(LegacyRead, LegacyWrite, ptr.get(), &param, &type, &dsize);
+
+	if (param.destOffset < size) {
+		memcpy(srcData, destData.get(), param.destOffset);
+		size = param.destOffset;
+	}
+
+	return size;
+}
+
+/** The in place decompression the game used before */
+void LegacyDecompress(byte *inBuff, int recvSize, int maxBytes)
+{
+	std::unique_ptr<char[]> ptr { new char[CMP_BUFFER_SIZE] };
+	std::unique_ptr<byte[]> outBuff { new byte[maxBytes] };
+
+	TDataInfo info {};
+	info.srcData = inBuff;
+	info.destData = outBuff.get();
+	info.size = recvSize;
+
+	explode(LegacyRead, LegacyWrite, ptr.get(), &info);
+	memcpy(inBuff, outBuff.get(), info.destOffset);
+}
+
+} // namespace
+
+int RunPkwareBench(int argc, char **argv)
+{
+	PkwareOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	std::mt19937 rng(options.seed);
+	std::vector<std::vector<byte>> payloads;
+	size_t totalSize = 0;
+	for (int i = 0; i < NUMLEVELS; i++) {
+		auto level = std::make_unique<DLevel>();
+		GenerateLevel(rng, *level);
+		payloads.push_back(ExportLevel(*level));
+		totalSize += payloads.back().size();
+	}
+
+	std::vector<byte> buffer(sizeof(DLevel));
+	std::vector<byte> compressed(sizeof(DLevel));
+	std::vector<byte> decompressed(sizeof(DLevel));
+	std::chrono::duration<double> legacyCompressTime {};
+	std::chrono::duration<double> legacyDecompressTime {};
+	std::chrono::duration<double> compressTime {};
+	std::chrono::duration<double> decompressTime {};
+	size_t totalCompressed = 0;
+	Checksum checksum;
+	bool matches = true;
+
+	for (int iteration = 0; iteration < options.iterations; iteration++) {
+		for (const std::vector<byte> &payload : payloads) {
+			const uint32_t size = static_cast<uint32_t>(payload.size());
+
+			memcpy(buffer.data(), payload.data(), size);
+			auto start = std::chrono::steady_clock::now();
+			const uint32_t legacySize = LegacyCompress(buffer.data(), size);
+			legacyCompressTime += std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			const uint32_t compressedSize = PkwareCompress(payload.data(), size, compressed.data());
+			compressTime += std::chrono::steady_clock::now() - start;
+
+			if (compressedSize != legacySize || memcmp(buffer.data(), compressed.data(), compressedSize) != 0)
+				matches = false;
+			if (iteration == 0) {
+				checksum.Add(compressed.data(), compressedSize);
+				totalCompressed += compressedSize;
+			}
+			if (compressedSize == size)
+				continue;
+
+			start = std::chrono::steady_clock::now();
+			LegacyDecompress(buffer.data(), compressedSize, static_cast<int>(buffer.size()));
+			legacyDecompressTime += std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			const uint32_t decompressedSize = PkwareDecompress(compressed.data(), compressedSize, decompressed.data(), static_cast<uint32_t>(decompressed.size()));
+			decompressTime += std::chrono::steady_clock::now() - start;
+
+			if (decompressedSize != size || memcmp(decompressed.data(), payload.data(), size) != 0 || memcmp(buffer.data(), payload.data(), size) != 0)
+				matches = false;
+		}
+	}
+
+	const double perPass = 1000.0 / options.iterations;
+	printf("%d levels, %zu bytes, compressed to %zu bytes  %016llx\n", NUMLEVELS, totalSize, totalCompressed,
+	    static_cast<unsigned long long>(checksum.Value()));
+	printf("compress    legacy %7.3f ms  workspace %7.3f ms  %5.2fx\n", legacyCompressTime.count() * perPass,
+	    compressTime.count() * perPass, legacyCompressTime.count() / compressTime.count());
+	printf("decompress  legacy %7.3f ms  workspace %7.3f ms  %5.2fx\n", legacyDecompressTime.count() * perPass,
+	    decompressTime.count() * perPass, legacyDecompressTime.count() / decompressTime.count());
+
+	if (!matches) {
+		printf("The workspace wrappers produced different data than the legacy ones\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+} // namespace devilution
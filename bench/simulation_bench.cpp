@@ -0,0 +1,220 @@
+/**
+ * @file simulation_bench.cpp
+ *
+ * Runs the game simulation on a generated level from a fixed seed, without a window or sound.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "bench.h"
+#include "diablo.h"
+#include "drlg_l1.h"
+#include "drlg_l2.h"
+#include "drlg_l3.h"
+#include "drlg_l4.h"
+#include "engine.h"
+#include "gendung.h"
+#include "init.h"
+#include "lighting.h"
+#include "miniwin/miniwin.h"
+#include "missiles.h"
+#include "monster.h"
+#include "player.h"
+#include "trigs.h"
+#include "utils/paths.h"
+
+namespace devilution {
+
+namespace {
+
+struct SimulationOptions {
+	int level = 5;
+	uint32_t seed = 12345;
+	int ticks = 2000;
+	/** Number of ticks between scripted moves of the player */
+	int moveInterval = 40;
+	bool forceDiablo = false;
+};
+
+bool ParseOptions(int argc, char **argv, SimulationOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--data-dir", argv[i]) == 0 && i + 1 < argc) {
+			paths::SetBasePath(argv[++i]);
+		} else if (strcasecmp("--level", argv[i]) == 0 && i + 1 < argc) {
+			options.level = atoi(argv[++i]);
+		} else if (strcasecmp("--seed", argv[i]) == 0 && i + 1 < argc) {
+			options.seed = strtoul(argv[++i], nullptr, 10);
+		} else if (strcasecmp("--ticks", argv[i]) == 0 && i + 1 < argc) {
+			options.ticks = atoi(argv[++i]);
+		} else if (strcasecmp("--diablo", argv[i]) == 0) {
+			options.forceDiablo = true;
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--data-dir", "Folder of diabdat.mpq");
+			printf("    %-20s %s\n", "--level <1-16>", "Dungeon level to generate");
+			printf("    %-20s %s\n", "--seed <#>", "Seed of the level");
+			printf("    %-20s %s\n", "--ticks <#>", "Number of game ticks to simulate");
+			printf("    %-20s %s\n", "--diablo", "Ignore hellfire.mpq");
+			return false;
+		}
+	}
+
+	return options.level >= 1 && options.level <= 16 && options.ticks > 0;
+}
+
+dungeon_type GetLevelType(int level)
+{
+	if (level <= 4)
+		return DTYPE_CATHEDRAL;
+	if (level <= 8)
+		return DTYPE_CATACOMBS;
+	if (level <= 12)
+		return DTYPE_CAVES;
+	return DTYPE_HELL;
+}
+
+void CreateBenchLevel(const SimulationOptions &options)
+{
+	currlevel = options.level;
+	leveltype = GetLevelType(options.level);
+	setlevel = false;
+	glSeedTbl[currlevel] = options.seed;
+
+	SetRndSeed(options.seed);
+	MakeLightTable();
+	LoadLvlGFX();
+	InitLighting();
+	InitVision();
+	InitLevelMonsters();
+
+	DRLG_Init_Globals();
+	switch (leveltype) {
+	case DTYPE_CATHEDRAL:
+		CreateL5Dungeon(ActiveDungeon, options.seed, ENTRY_MAIN);
+		InitL5CornerStone();
+		InitL1Triggers();
+		break;
+	case DTYPE_CATACOMBS:
+		CreateL2Dungeon(ActiveDungeon, options.seed, ENTRY_MAIN);
+		InitL2Triggers();
+		break;
+	case DTYPE_CAVES:
+		CreateL3Dungeon(ActiveDungeon, options.seed, ENTRY_MAIN);
+		InitL3Lights();
+		InitL3Triggers();
+		break;
+	default:
+		CreateL4Dungeon(ActiveDungeon, options.seed, ENTRY_MAIN);
+		InitL4Triggers();
+		break;
+	}
+	Freeupstairs();
+	FillSolidBlockTbls();
+
+	SetRndSeed(options.seed);
+	GetLevelMTypes();
+	InitMissileGFX();
+
+	myplr = 0;
+	auto &player = plr[myplr];
+	CreatePlayer(myplr, HeroClass::Warrior);
+	player.plractive = true;
+	player.plrlevel = currlevel;
+	// Keep the player alive so the monsters have someone to chase for the whole run
+	player._pMaxHPBase = player._pHPBase = player._pMaxHP = player._pHitPoints = 20000 << 6;
+	InitPlayerGFX(player);
+	InitPlayer(myplr, false);
+	InitMultiView();
+
+	InitMonsters();
+	InitMissiles();
+
+	dPlayer[player.position.tile.x][player.position.tile.y] = myplr + 1;
+	InitLightMax();
+	ProcessLightList();
+	ProcessVisionList();
+}
+
+/**
+ * @brief Walk the player to a random nearby tile, using its own generator so the game's random sequence is left alone
+ */
+void MovePlayer(uint32_t &inputSeed)
+{
+	auto &player = plr[myplr];
+	for (int attempt = 0; attempt < 10; attempt++) {
+		inputSeed = inputSeed * 1103515245 + 12345;
+		Point target = player.position.tile + Point { static_cast<int>((inputSeed >> 8) % 17) - 8, static_cast<int>((inputSeed >> 16) % 17) - 8 };
+		if (target.x < 0 || target.y < 0 || target.x >= MAXDUNX || target.y >= MAXDUNY)
+			continue;
+		if (PosOkPlayer(myplr, target)) {
+			MakePlrPath(myplr, target, true);
+			return;
+		}
+	}
+}
+
+uint64_t GetStateChecksum()
+{
+	Checksum checksum;
+
+	const auto &player = plr[myplr];
+	checksum.Add(player.position.tile);
+	checksum.Add(player._pHitPoints);
+
+	checksum.Add(nummonsters);
+	for (int i = 0; i < nummonsters; i++) {
+		const MonsterStruct &monst = monster[monstactive[i]];
+		checksum.Add(monst.position.tile);
+		checksum.Add(monst._mhitpoints);
+		checksum.Add(monst._mmode);
+	}
+
+	checksum.Add(nummissiles);
+	for (int i = 0; i < nummissiles; i++) {
+		const MissileStruct &mis = missile[missileactive[i]];
+		checksum.Add(mis._mitype);
+		checksum.Add(mis.position.tile);
+	}
+
+	checksum.Add(dLight, sizeof(dLight));
+
+	return checksum.Value();
+}
+
+} // namespace
+
+int RunSimulationBench(int argc, char **argv)
+{
+	SimulationOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	init_archives();
+	if (options.forceDiablo)
+		gbIsHellfire = false;
+
+	CreateBenchLevel(options);
+	printf("Level %d, seed %u: %d monsters\n", options.level, options.seed, nummonsters);
+
+	uint32_t inputSeed = options.seed;
+	const auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < options.ticks; tick++) {
+		if (tick % options.moveInterval == 0)
+			MovePlayer(inputSeed);
+		ProcessPlayers();
+		ProcessMonsters();
+		ProcessMissiles();
+		ProcessLightList();
+		ProcessVisionList();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("%d ticks in %.3f s: %.0f ticks/s\n", options.ticks, elapsed.count(), options.ticks / elapsed.count());
+	printf("Checksum: %016llx\n", static_cast<unsigned long long>(GetStateChecksum()));
+
+	return 0;
+}
+
+} // namespace devilution
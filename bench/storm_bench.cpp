@@ -0,0 +1,162 @@
+/**
+ * @file storm_bench.cpp
+ *
+ * Times reading files from two generated archives with a growing number of threads, and checks every file read.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "init.h"
+#include "miniwin/miniwin.h"
+#include "mpqapi.h"
+#include "storm/storm.h"
+
+namespace devilution {
+
+namespace {
+
+constexpr int FilesPerArchive = 32;
+constexpr size_t BenchFileSize = 32 * 1024;
+
+struct StormOptions {
+	int threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+	int reads = 200;
+};
+
+bool ParseOptions(int argc, char **argv, StormOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--threads", argv[i]) == 0 && i + 1 < argc) {
+			options.threads = atoi(argv[++i]);
+		} else if (strcasecmp("--reads", argv[i]) == 0 && i + 1 < argc) {
+			options.reads = atoi(argv[++i]);
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--threads <#>", "Highest number of threads reading at the same time");
+			printf("    %-20s %s\n", "--reads <#>", "Number of files each thread reads");
+			return false;
+		}
+	}
+
+	return options.threads > 0 && options.reads > 0;
+}
+
+void GetBenchFileName(char *name, char archive, int index)
+{
+	sprintf(name, "bench\\%c%02d.bin", archive, index);
+}
+
+byte GetBenchFileByte(char archive, int index, size_t offset)
+{
+	return static_cast<byte>((offset / 16 + index * 3 + archive) & 0xFF);
+}
+
+bool CreateBenchArchive(const char *path, char archive)
+{
+	std::remove(path);
+	if (!OpenMPQ(path))
+		return false;
+
+	std::vector<byte> data(BenchFileSize);
+	std::string listFile;
+	char name[32];
+	for (int index = 0; index < FilesPerArchive; index++) {
+		for (size_t offset = 0; offset < BenchFileSize; offset++)
+			data[offset] = GetBenchFileByte(archive, index, offset);
+		GetBenchFileName(name, archive, index);
+		if (!mpqapi_write_file(name, data.data(), data.size()))
+			return false;
+		listFile += name;
+		listFile += "\r\n";
+	}
+	if (!mpqapi_write_file("(listfile)", reinterpret_cast<const byte *>(listFile.data()), listFile.size()))
+		return false;
+
+	return mpqapi_flush_and_close(true);
+}
+
+bool ReadBenchFile(char archive, int index)
+{
+	char name[32];
+	GetBenchFileName(name, archive, index);
+
+	HANDLE file;
+	if (!SFileOpenFile(name, &file))
+		return false;
+
+	std::vector<byte> data(SFileGetFileSize(file));
+	bool success = data.size() == BenchFileSize && SFileReadFileThreadSafe(file, data.data(), data.size());
+	SFileCloseFileThreadSafe(file);
+
+	for (size_t offset = 0; success && offset < data.size(); offset++)
+		success = data[offset] == GetBenchFileByte(archive, index, offset);
+
+	return success;
+}
+
+} // namespace
+
+int RunStormBench(int argc, char **argv)
+{
+	StormOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	if (!CreateBenchArchive("Bench_Storm_A.mpq", 'a') || !CreateBenchArchive("Bench_Storm_B.mpq", 'b')) {
+		printf("Failed to write the archives\n");
+		return 1;
+	}
+	if (!SFileOpenArchive("Bench_Storm_A.mpq", 0, MPQ_OPEN_READ_ONLY, &devilutionx_mpq)
+	    || !SFileOpenArchive("Bench_Storm_B.mpq", 0, MPQ_OPEN_READ_ONLY, &diabdat_mpq)) {
+		printf("Failed to open the archives\n");
+		return 1;
+	}
+
+	int totalFailures = 0;
+	for (int threads = 1; threads <= options.threads; threads++) {
+		std::atomic<int> failures { 0 };
+		std::vector<std::thread> readers;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int reader = 0; reader < threads; reader++) {
+			readers.emplace_back([reader, &options, &failures]() {
+				for (int i = 0; i < options.reads; i++) {
+					char archive = (i + reader) % 2 == 0 ? 'a' : 'b';
+					if (!ReadBenchFile(archive, (i * 7 + reader) % FilesPerArchive))
+						failures++;
+				}
+			});
+		}
+		for (std::thread &reader : readers)
+			reader.join();
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		printf("%2d thread(s) %8.2f ms %10.0f files/s%s\n", threads, elapsed.count() * 1000,
+		    threads * options.reads / elapsed.count(), failures == 0 ? "" : "  READ FAILURES");
+		totalFailures += failures;
+	}
+
+	SFileFreeFileCache();
+	SFileCloseArchive(devilutionx_mpq);
+	SFileCloseArchive(diabdat_mpq);
+	devilutionx_mpq = nullptr;
+	diabdat_mpq = nullptr;
+	std::remove("Bench_Storm_A.mpq");
+	std::remove("Bench_Storm_B.mpq");
+
+	if (totalFailures != 0) {
+		printf("%d files were not read back correctly\n", totalFailures);
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace devilution
@@ -0,0 +1,299 @@
+/**
+ * @file tile_bench.cpp
+ *
+ * Renders the level tiles of every tileset with each supported set of line kernels, and from the tile cache,
+ * and checks that they all draw the same pixels.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "diablo.h"
+#include "engine.h"
+#include "engine/load_file.hpp"
+#include "engine/render/dun_render.hpp"
+#include "engine/render/dun_render_kernels.hpp"
+#include "engine/render/dun_tile_cache.hpp"
+#include "gendung.h"
+#include "init.h"
+#include "lighting.h"
+#include "miniwin/miniwin.h"
+#include "options.h"
+#include "palette.h"
+#include "scrollrt.h"
+#include "utils/paths.h"
+
+namespace devilution {
+
+namespace {
+
+struct TilesetInfo {
+	const char *name;
+	int level;
+	dungeon_type type;
+};
+
+const TilesetInfo Tilesets[] = {
+	{ "cathedral", 2, DTYPE_CATHEDRAL },
+	{ "catacombs", 6, DTYPE_CATACOMBS },
+	{ "caves", 10, DTYPE_CAVES },
+	{ "hell", 14, DTYPE_HELL },
+};
+
+struct DrawMode {
+	const char *name;
+	bool transparency;
+	bool blended;
+	char archDrawType;
+};
+
+const DrawMode DrawModes[] = {
+	{ "solid", false, true, 0 },
+	{ "blended", true, true, 0 },
+	{ "stippled", true, false, 0 },
+	{ "foliage", false, false, 1 },
+};
+
+struct KernelSet {
+	const char *name;
+	DunRenderIsa isa;
+};
+
+const KernelSet KernelSets[] = {
+	{ "scalar", DunRenderIsa::Scalar },
+	{ "sse2", DunRenderIsa::SSE2 },
+	{ "avx2", DunRenderIsa::AVX2 },
+	{ "neon", DunRenderIsa::NEON },
+};
+
+constexpr int TilesPerRow = 32;
+
+struct TileOptions {
+	int iterations = 20;
+	bool generated = false;
+};
+
+bool ParseOptions(int argc, char **argv, TileOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--data-dir", argv[i]) == 0 && i + 1 < argc) {
+			paths::SetBasePath(argv[++i]);
+		} else if (strcasecmp("--iterations", argv[i]) == 0 && i + 1 < argc) {
+			options.iterations = atoi(argv[++i]);
+		} else if (strcasecmp("--generated", argv[i]) == 0) {
+			options.generated = true;
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--data-dir", "Folder of diabdat.mpq");
+			printf("    %-20s %s\n", "--iterations <#>", "Number of times to render every tile per kernel set");
+			printf("    %-20s %s\n", "--generated", "Render random tiles of every type instead of the game's tilesets");
+			return false;
+		}
+	}
+
+	return options.iterations > 0;
+}
+
+void LoadTileset(const TilesetInfo &tileset)
+{
+	pDungeonCels = nullptr;
+	pMegaTiles = nullptr;
+	pLevelPieces = nullptr;
+	pSpecialCels = std::nullopt;
+
+	currlevel = tileset.level;
+	leveltype = tileset.type;
+	setlevel = false;
+	LoadLvlGFX();
+
+	char palette[32];
+	sprintf(palette, "Levels\\L%iData\\L%i_1.PAL", tileset.type, tileset.type);
+	LoadPalette(palette);
+}
+
+/**
+ * @brief Collect the distinct CEL blocks referenced by the MIN file, in order of first use
+ */
+std::vector<uint16_t> GetTileBlocks(const TilesetInfo &tileset)
+{
+	char path[32];
+	sprintf(path, "Levels\\L%iData\\L%i.MIN", tileset.type, tileset.type);
+	size_t count;
+	auto pieces = LoadFileInMem<uint16_t>(path, &count);
+
+	std::vector<bool> seen(0x10000);
+	std::vector<uint16_t> blocks;
+	for (size_t i = 0; i < count; i++) {
+		const uint16_t block = SDL_SwapLE16(pieces[i]);
+		if (block == 0 || seen[block])
+			continue;
+		seen[block] = true;
+		blocks.push_back(block);
+	}
+	return blocks;
+}
+
+/**
+ * @brief Build a tileset of random tiles, for measuring the renderer without the game data
+ */
+std::vector<uint16_t> LoadGeneratedTiles()
+{
+	constexpr int TilesPerType = 64;
+	constexpr int TileTypes = 6;
+	constexpr int TileCount = TilesPerType * TileTypes;
+	constexpr int TileSize = 1024;
+	constexpr int HeaderSize = (TileCount + 1) * 4;
+
+	std::mt19937 rng(1234);
+	for (auto &row : paletteTransparencyLookup) {
+		for (auto &entry : row)
+			entry = static_cast<Uint8>(rng());
+	}
+
+	pDungeonCels = std::make_unique<byte[]>(HeaderSize + TileCount * TileSize);
+	auto *frameTable = reinterpret_cast<uint32_t *>(pDungeonCels.get());
+	frameTable[0] = SDL_SwapLE32(TileCount);
+	std::vector<uint16_t> blocks;
+	for (int frame = 0; frame < TileCount; frame++) {
+		const int type = frame % TileTypes;
+		const uint32_t offset = HeaderSize + frame * TileSize;
+		frameTable[frame + 1] = SDL_SwapLE32(offset);
+		blocks.push_back((frame + 1) | (type << 12));
+
+		auto *data = reinterpret_cast<uint8_t *>(&pDungeonCels[offset]);
+		for (int i = 0; i < TileSize; i++)
+			data[i] = static_cast<uint8_t>(rng());
+		if (type != 1)
+			continue;
+		// Transparent square: each row is a run of pixels, a gap and another run of pixels
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			const int first = 1 + rng() % 20;
+			const int gap = 1 + rng() % 8;
+			*data++ = first;
+			data += first;
+			*data++ = static_cast<uint8_t>(-gap);
+			*data++ = TILE_WIDTH / 2 - first - gap;
+			data += TILE_WIDTH / 2 - first - gap;
+		}
+	}
+	return blocks;
+}
+
+void RenderTiles(const CelOutputBuffer &out, const std::vector<uint16_t> &blocks)
+{
+	for (int light : { 0, lightmax / 2, static_cast<int>(lightmax) }) {
+		light_table_index = light;
+		for (size_t i = 0; i < blocks.size(); i++) {
+			level_cel_block = blocks[i];
+			const int x = static_cast<int>(i % TilesPerRow) * TILE_WIDTH;
+			const int y = static_cast<int>(i / TilesPerRow) * TILE_HEIGHT + TILE_HEIGHT - 1;
+			RenderTile(out, x, y);
+		}
+	}
+}
+
+/**
+ * @brief Measure one tileset with every kernel set and the tile cache
+ * @return false if any of them drew different pixels than the scalar kernels
+ */
+bool MeasureTileset(const char *tilesetName, const std::vector<uint16_t> &blocks, const TileOptions &options, const DunRenderKernels *defaultKernels)
+{
+	bool identical = true;
+	const int rows = (static_cast<int>(blocks.size()) + TilesPerRow - 1) / TilesPerRow;
+	CelOutputBuffer out = CelOutputBuffer::Alloc(TilesPerRow * TILE_WIDTH, rows * TILE_HEIGHT);
+	const size_t outSize = static_cast<size_t>(out.pitch()) * out.h();
+	std::vector<uint8_t> expected(outSize);
+
+	for (const DrawMode &mode : DrawModes) {
+		cel_transparency_active = mode.transparency;
+		cel_foliage_active = !mode.transparency;
+		arch_draw_type = mode.archDrawType;
+		level_piece_id = 0;
+		sgOptions.Graphics.bBlendedTransparancy = mode.blended;
+
+		const auto measure = [&](const char *name, bool reference) {
+			memset(out.at(0, 0), 0, outSize);
+			RenderTiles(out, blocks);
+			Checksum checksum;
+			checksum.Add(out.at(0, 0), outSize);
+
+			bool matches = true;
+			if (reference)
+				memcpy(expected.data(), out.at(0, 0), outSize);
+			else
+				matches = memcmp(expected.data(), out.at(0, 0), outSize) == 0;
+			identical = identical && matches;
+
+			const auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < options.iterations; i++)
+				RenderTiles(out, blocks);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			const double tiles = 3.0 * blocks.size() * options.iterations;
+			printf("%-10s %-9s %-7s %6.2f ms %10.0f tiles/s  %016llx%s\n", tilesetName, mode.name, name,
+			    elapsed.count() * 1000, tiles / elapsed.count(), static_cast<unsigned long long>(checksum.Value()),
+			    matches ? "" : "  MISMATCH");
+		};
+
+		SetTileCacheBudget(0);
+		for (const KernelSet &kernelSet : KernelSets) {
+			const DunRenderKernels *kernels = GetDunRenderKernels(kernelSet.isa);
+			if (kernels == nullptr)
+				continue;
+			ActiveDunRenderKernels = kernels;
+			measure(kernels->name, kernelSet.isa == DunRenderIsa::Scalar);
+		}
+
+		// The same tiles again, drawn from the tile cache after the first pass
+		ActiveDunRenderKernels = defaultKernels;
+		SetTileCacheBudget(64 * 1024 * 1024);
+		InvalidateTileCache();
+		measure("cached", false);
+	}
+
+	out.Free();
+	return identical;
+}
+
+} // namespace
+
+int RunTileBench(int argc, char **argv)
+{
+	TileOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	if (!options.generated)
+		init_archives();
+	MakeLightTable();
+
+	const DunRenderKernels *defaultKernels = ActiveDunRenderKernels;
+	const bool blendedTransparancy = sgOptions.Graphics.bBlendedTransparancy;
+	bool identical = true;
+
+	if (options.generated) {
+		leveltype = DTYPE_CATHEDRAL;
+		identical = MeasureTileset("generated", LoadGeneratedTiles(), options, defaultKernels);
+	} else {
+		for (const TilesetInfo &tileset : Tilesets) {
+			LoadTileset(tileset);
+			if (!MeasureTileset(tileset.name, GetTileBlocks(tileset), options, defaultKernels))
+				identical = false;
+		}
+	}
+
+	ActiveDunRenderKernels = defaultKernels;
+	sgOptions.Graphics.bBlendedTransparancy = blendedTransparancy;
+
+	if (!identical) {
+		printf("Kernel or tile cache output differs from the scalar kernels\n");
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace devilution
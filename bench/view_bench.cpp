@@ -0,0 +1,252 @@
+/**
+ * @file view_bench.cpp
+ *
+ * Renders a generated level view with and without culling the sprites that walls cover, and checks that both draw
+ * the same pixels.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "dead.h"
+#include "diablo.h"
+#include "engine.h"
+#include "gendung.h"
+#include "lighting.h"
+#include "miniwin/miniwin.h"
+#include "missiles.h"
+#include "player.h"
+#include "scrollrt.h"
+
+namespace devilution {
+
+namespace {
+
+struct ViewOptions {
+	int iterations = 200;
+};
+
+struct SceneInfo {
+	const char *name;
+	bool walls;
+};
+
+const SceneInfo Scenes[] = {
+	{ "walls", true },
+	{ "open", false },
+};
+
+constexpr int CorpseWidth = 64;
+constexpr int CorpseHeight = 80;
+
+bool ParseOptions(int argc, char **argv, ViewOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcasecmp("--iterations", argv[i]) == 0 && i + 1 < argc) {
+			options.iterations = atoi(argv[++i]);
+		} else {
+			printf("Options:\n");
+			printf("    %-20s %s\n", "--iterations <#>", "Number of frames to render per scene and mode");
+			return false;
+		}
+	}
+
+	return options.iterations > 0;
+}
+
+/**
+ * @brief Build a level CEL with one tile of each type, tiles stored as plain pixels are filled with random data
+ */
+void LoadGeneratedTiles(std::mt19937 &rng)
+{
+	constexpr int TileTypes = 6;
+	constexpr int TileSize = 1024;
+	constexpr int HeaderSize = (TileTypes + 1) * 4;
+	pDungeonCels = std::make_unique<byte[]>(HeaderSize + TileTypes * TileSize);
+	auto *frameTable = reinterpret_cast<uint32_t *>(pDungeonCels.get());
+	frameTable[0] = SDL_SwapLE32(TileTypes);
+	for (int type = 0; type < TileTypes; type++) {
+		const uint32_t offset = HeaderSize + type * TileSize;
+		frameTable[type + 1] = SDL_SwapLE32(offset);
+		auto *data = reinterpret_cast<uint8_t *>(&pDungeonCels[offset]);
+		for (int i = 0; i < TileSize; i++)
+			data[i] = static_cast<uint8_t>(rng());
+		if (type != 1)
+			continue;
+		// Transparent square: each row is a run of pixels, a gap and another run of pixels
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			const int first = 1 + rng() % 20;
+			const int gap = 1 + rng() % 8;
+			*data++ = first;
+			data += first;
+			*data++ = static_cast<uint8_t>(-gap);
+			*data++ = TILE_WIDTH / 2 - first - gap;
+			data += TILE_WIDTH / 2 - first - gap;
+		}
+	}
+}
+
+/**
+ * @brief Build a CL2 sprite with one frame, every line has opaque pixels between two transparent gaps
+ */
+std::unique_ptr<byte[]> MakeCorpseSprite(std::mt19937 &rng)
+{
+	constexpr int Gap = 8;
+	constexpr int Opaque = CorpseWidth - 2 * Gap;
+	std::vector<uint8_t> frame;
+	for (int y = 0; y < CorpseHeight; y++) {
+		frame.push_back(Gap);
+		frame.push_back(static_cast<uint8_t>(-Opaque));
+		for (int x = 0; x < Opaque; x++)
+			frame.push_back(static_cast<uint8_t>(rng()));
+		frame.push_back(Gap);
+	}
+
+	constexpr uint32_t FrameHeaderSize = 10;
+	constexpr uint32_t FrameBegin = 3 * sizeof(uint32_t);
+	const uint32_t frameEnd = FrameBegin + FrameHeaderSize + static_cast<uint32_t>(frame.size());
+	auto data = std::make_unique<byte[]>(frameEnd);
+	const uint32_t table[] = { SDL_SwapLE32(1), SDL_SwapLE32(FrameBegin), SDL_SwapLE32(frameEnd) };
+	memcpy(data.get(), table, sizeof(table));
+	const uint8_t header[FrameHeaderSize] = { FrameHeaderSize, 0 };
+	memcpy(&data[FrameBegin], header, FrameHeaderSize);
+	memcpy(&data[FrameBegin + FrameHeaderSize], frame.data(), frame.size());
+	return data;
+}
+
+/**
+ * @brief Fill the level with floor, optionally crossed by lines of walls with gaps, and a corpse on every floor tile
+ */
+void LoadScene(const SceneInfo &scene, const byte *corpse)
+{
+	memset(dFlags, 0, sizeof(dFlags));
+	memset(dPlayer, 0, sizeof(dPlayer));
+	memset(dMonster, 0, sizeof(dMonster));
+	memset(dObject, 0, sizeof(dObject));
+	memset(dItem, 0, sizeof(dItem));
+	memset(dSpecial, 0, sizeof(dSpecial));
+	memset(dLight, 0, sizeof(dLight));
+	memset(dTransVal, 0, sizeof(dTransVal));
+	memset(dpiece_defs_map_2, 0, sizeof(dpiece_defs_map_2));
+
+	constexpr uint16_t Square = 1;
+	constexpr uint16_t LeftTriangle = 3 | (2 << 12);
+	constexpr uint16_t RightTriangle = 4 | (3 << 12);
+	constexpr uint16_t LeftTrapezoid = 5 | (4 << 12);
+	constexpr uint16_t RightTrapezoid = 6 | (5 << 12);
+	nSolidTable.fill(false);
+	nSolidTable[2] = true;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			MICROS &micros = dpiece_defs_map_2[x][y];
+			if (scene.walls && x % 4 == 0 && y % 6 != 0) {
+				dPiece[x][y] = 2;
+				micros.mt[0] = LeftTrapezoid;
+				micros.mt[1] = RightTrapezoid;
+				for (int i = 2; i < MicroTileLen; i++)
+					micros.mt[i] = Square;
+				dDead[x][y] = 0;
+			} else {
+				dPiece[x][y] = 1;
+				micros.mt[0] = LeftTriangle;
+				micros.mt[1] = RightTriangle;
+				dDead[x][y] = 1;
+			}
+		}
+	}
+
+	dead[0]._deadData.fill(corpse);
+	dead[0]._deadFrame = 1;
+	dead[0]._deadWidth = CorpseWidth;
+	dead[0]._deadtrans = 0;
+}
+
+/**
+ * @brief Render a frame from each of a few views at different offsets to the lines of walls
+ */
+void RenderViews(const CelOutputBuffer &out)
+{
+	for (int x = 40; x < 44; x++) {
+		for (int y = 40; y < 43; y++)
+			DrawGame(out, x, y);
+	}
+}
+
+} // namespace
+
+int RunViewBench(int argc, char **argv)
+{
+	ViewOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	MakeLightTable();
+	lightmax = 15;
+	std::mt19937 rng(1234);
+	LoadGeneratedTiles(rng);
+	const std::unique_ptr<byte[]> corpse = MakeCorpseSprite(rng);
+	leveltype = DTYPE_CATHEDRAL;
+	MicroTileLen = 10;
+	MissilePreFlag = false;
+
+	gnScreenWidth = 640;
+	gnScreenHeight = 480;
+	gnViewportHeight = gnScreenHeight - 128;
+	zoomflag = true;
+	CalcViewportGeometry();
+	myplr = 0;
+	plr[myplr]._pmode = PM_STAND;
+
+	CelOutputBuffer out = CelOutputBuffer::Alloc(gnScreenWidth, gnScreenHeight);
+	const size_t outSize = static_cast<size_t>(out.pitch()) * out.h();
+	std::vector<uint8_t> expected(outSize);
+	bool identical = true;
+
+	for (const SceneInfo &scene : Scenes) {
+		LoadScene(scene, corpse.get());
+		for (bool cull : { false, true }) {
+			CullOccludedSprites = cull;
+
+			memset(out.at(0, 0), 0, outSize);
+			RenderViews(out);
+			Checksum checksum;
+			checksum.Add(out.at(0, 0), outSize);
+
+			bool matches = true;
+			if (!cull)
+				memcpy(expected.data(), out.at(0, 0), outSize);
+			else
+				matches = memcmp(expected.data(), out.at(0, 0), outSize) == 0;
+			identical = identical && matches;
+
+			const auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < options.iterations; i++)
+				RenderViews(out);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			const double frames = 12.0 * options.iterations;
+			printf("%-6s %-6s %8.2f ms %8.1f us/frame  %016llx%s\n", scene.name, cull ? "culled" : "drawn",
+			    elapsed.count() * 1000, elapsed.count() * 1e6 / frames, static_cast<unsigned long long>(checksum.Value()),
+			    matches ? "" : "  MISMATCH");
+		}
+	}
+
+	CullOccludedSprites = true;
+	out.Free();
+	memset(dDead, 0, sizeof(dDead));
+	dead[0]._deadData.fill(nullptr);
+	pDungeonCels = nullptr;
+
+	if (!identical) {
+		printf("Culling hidden sprites changed the rendered frame\n");
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace devilution
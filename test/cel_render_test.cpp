@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "engine/render/cel_render.hpp"
+#include "engine/render/cl2_render.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/**
+ * @brief Wrap the pixel data of one frame in a sprite file with a frame table and a 10 byte frame header
+ */
+std::unique_ptr<byte[]> MakeSprite(const std::vector<uint8_t> &frameData)
+{
+	constexpr uint32_t FrameHeaderSize = 10;
+	constexpr uint32_t FrameBegin = 3 * sizeof(uint32_t);
+	const uint32_t frameEnd = FrameBegin + FrameHeaderSize + static_cast<uint32_t>(frameData.size());
+	auto data = std::make_unique<byte[]>(frameEnd);
+	const uint32_t table[] = { SDL_SwapLE32(1), SDL_SwapLE32(FrameBegin), SDL_SwapLE32(frameEnd) };
+	memcpy(data.get(), table, sizeof(table));
+	const uint8_t header[FrameHeaderSize] = { FrameHeaderSize, 0 };
+	memcpy(&data[FrameBegin], header, FrameHeaderSize);
+	memcpy(&data[FrameBegin + FrameHeaderSize], frameData.data(), frameData.size());
+	return data;
+}
+
+} // namespace
+
+TEST(CelRender, MeasureCelHeight)
+{
+	// 4 pixels wide: a transparent line, a line of 2 transparent and 2 opaque pixels, and a line of 4 opaque pixels
+	const std::vector<uint8_t> frame = { 0xFC, 0xFE, 2, 1, 2, 4, 1, 2, 3, 4 };
+	CelSprite cel { MakeSprite(frame), 4 };
+	EXPECT_EQ(MeasureCelHeight(cel, 1), 3);
+}
+
+TEST(CelRender, MeasureCl2Height)
+{
+	// 4 pixels wide: a transparent run over one and a half lines, a fill of 2 pixels and a line of 4 opaque pixels
+	const std::vector<uint8_t> frame = { 6, 0xBD, 9, 0xFC, 1, 2, 3, 4 };
+	CelSprite cel { MakeSprite(frame), 4 };
+	EXPECT_EQ(MeasureCl2Height(cel, 1), 3);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <SDL.h>
+
+#include "encrypt.h"
+#include "engine/compress_sectors.hpp"
+
+using namespace devilution;
+
+namespace {
+
+std::vector<byte> MakeFile(size_t size)
+{
+	std::vector<byte> data(size);
+	uint32_t seed = 1;
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		// Runs of repeated bytes in the first half, noise that doesn't compress in the second
+		data[i] = static_cast<byte>(i < size / 2 ? (i / 64) & 0xFF : seed >> 24);
+	}
+	return data;
+}
+
+uint32_t SectorOffset(const std::vector<byte> &out, size_t sector)
+{
+	uint32_t offset;
+	memcpy(&offset, &out[sector * sizeof(uint32_t)], sizeof(offset));
+	return SDL_SwapLE32(offset);
+}
+
+std::vector<byte> Decompress(const std::vector<byte> &out, size_t size)
+{
+	const size_t sectors = (size + ArchiveSectorSize - 1) / ArchiveSectorSize;
+	std::vector<byte> data;
+	for (size_t sector = 0; sector < sectors; sector++) {
+		const uint32_t begin = SectorOffset(out, sector);
+		const uint32_t end = SectorOffset(out, sector + 1);
+		const size_t len = std::min<size_t>(size - sector * ArchiveSectorSize, ArchiveSectorSize);
+		if (end - begin < len) {
+			byte buf[ArchiveSectorSize];
+			EXPECT_EQ(PkwareDecompress(&out[begin], end - begin, buf, len), len);
+			data.insert(data.end(), buf, buf + len);
+		} else {
+			data.insert(data.end(), &out[begin], &out[end]);
+		}
+	}
+	return data;
+}
+
+} // namespace
+
+TEST(CompressSectors, RoundTrip)
+{
+	SetCompressThreadCount(1);
+	const std::vector<byte> data = MakeFile(5 * ArchiveSectorSize + 123);
+	std::vector<byte> out;
+	CompressSectors(data.data(), data.size(), out);
+
+	EXPECT_EQ(SectorOffset(out, 0), 7 * sizeof(uint32_t));
+	EXPECT_EQ(SectorOffset(out, 6), out.size());
+	EXPECT_LT(out.size(), data.size());
+	EXPECT_EQ(Decompress(out, data.size()), data);
+}
+
+TEST(CompressSectors, ThreadsMatchSingleThread)
+{
+	const std::vector<byte> data = MakeFile(37 * ArchiveSectorSize + 5);
+
+	SetCompressThreadCount(1);
+	std::vector<byte> single;
+	CompressSectors(data.data(), data.size(), single);
+
+	SetCompressThreadCount(4);
+	std::vector<byte> threaded;
+	CompressSectors(data.data(), data.size(), threaded);
+	CompressSectors(data.data(), data.size(), threaded);
+	FreeCompressThreads();
+
+	EXPECT_EQ(threaded, single);
+	EXPECT_EQ(Decompress(threaded, data.size()), data);
+}
+
+TEST(CompressSectors, Empty)
+{
+	std::vector<byte> out;
+	CompressSectors(nullptr, 0, out);
+	ASSERT_EQ(out.size(), sizeof(uint32_t));
+	EXPECT_EQ(SectorOffset(out, 0), sizeof(uint32_t));
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "engine/dirty_region.hpp"
+
+using namespace devilution;
+
+namespace {
+
+bool SameRect(const Rectangle &a, const Rectangle &b)
+{
+	return a.position == b.position && a.size == b.size;
+}
+
+} // namespace
+
+TEST(DirtyRegion, IgnoresEmptyRects)
+{
+	DirtyRegion region;
+	region.Add({ { 10, 10 }, { 0, 5 } });
+	region.Add({ { 10, 10 }, { 5, -1 } });
+	EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegion, KeepsDistantRectsApart)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 100, 100 }, { 10, 10 } });
+	ASSERT_EQ(region.Rects().size(), 2);
+	EXPECT_TRUE(SameRect(region.Rects()[0], { { 0, 0 }, { 10, 10 } }));
+	EXPECT_TRUE(SameRect(region.Rects()[1], { { 100, 100 }, { 10, 10 } }));
+}
+
+TEST(DirtyRegion, MergesOverlappingRects)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 5, 2 }, { 10, 10 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_TRUE(SameRect(region.Rects()[0], { { 0, 0 }, { 15, 12 } }));
+}
+
+TEST(DirtyRegion, MergesAdjacentRects)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 10, 0 }, { 10, 10 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_TRUE(SameRect(region.Rects()[0], { { 0, 0 }, { 20, 10 } }));
+}
+
+TEST(DirtyRegion, MergesChains)
+{
+	DirtyRegion region;
+	region.Add({ { 0, 0 }, { 10, 10 } });
+	region.Add({ { 30, 0 }, { 10, 10 } });
+	// Overlaps both, the merged box then covers everything
+	region.Add({ { 5, 0 }, { 30, 10 } });
+	ASSERT_EQ(region.Rects().size(), 1);
+	EXPECT_TRUE(SameRect(region.Rects()[0], { { 0, 0 }, { 40, 10 } }));
+
+	region.Clear();
+	EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegion, RectangleOverlaps)
+{
+	const Rectangle rect { { 10, 10 }, { 10, 10 } };
+	EXPECT_TRUE(rect.Overlaps({ { 19, 19 }, { 5, 5 } }));
+	EXPECT_TRUE(rect.Overlaps({ { 0, 0 }, { 40, 40 } }));
+	EXPECT_FALSE(rect.Overlaps({ { 20, 10 }, { 5, 5 } }));
+	EXPECT_FALSE(rect.Overlaps({ { 10, 5 }, { 10, 5 } }));
+}
@@ -6,7 +6,7 @@ using namespace devilution;
 
 TEST(Drlg_l2, InitDungeon)
 {
-	InitDungeon();
-	EXPECT_EQ(predungeon[0][0], 32);
+	InitDungeon(ActiveDungeon);
+	EXPECT_EQ(ActiveDungeon.predungeon[0][0], 32);
 	EXPECT_EQ(dflags[0][0], 0);
 }
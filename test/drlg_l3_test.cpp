@@ -10,7 +10,7 @@ TEST(Drlg_l3, AddFenceDoors_x)
 	dungeon[5][5] = 7;
 	dungeon[5 - 1][5] = 130;
 	dungeon[5 + 1][5] = 152;
-	AddFenceDoors();
+	AddFenceDoors(ActiveDungeon);
 	EXPECT_EQ(dungeon[5][5], 146);
 }
 
@@ -20,7 +20,7 @@ TEST(Drlg_l3, AddFenceDoors_y)
 	dungeon[5][5] = 7;
 	dungeon[5][5 - 1] = 130;
 	dungeon[5][5 + 1] = 152;
-	AddFenceDoors();
+	AddFenceDoors(ActiveDungeon);
 	EXPECT_EQ(dungeon[5][5], 147);
 }
 
@@ -30,6 +30,6 @@ TEST(Drlg_l3, AddFenceDoors_no)
 	dungeon[5][5] = 7;
 	dungeon[5 - 1][5] = 130;
 	dungeon[5 + 1][5] = 153;
-	AddFenceDoors();
+	AddFenceDoors(ActiveDungeon);
 	EXPECT_EQ(dungeon[5][5], 7);
 }
@@ -0,0 +1,346 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "engine/render/dun_render.hpp"
+#include "engine/render/dun_render_kernels.hpp"
+#include "engine/render/dun_tile_cache.hpp"
+#include "engine/render/render_bands.hpp"
+#include "gendung.h"
+#include "lighting.h"
+#include "options.h"
+#include "palette.h"
+#include "scrollrt.h"
+
+using namespace devilution;
+
+namespace {
+
+using KernelMember = RenderLineKernel DunRenderKernels::*;
+
+constexpr KernelMember Kernels[] = {
+	&DunRenderKernels::opaquePartiallyLit,
+	&DunRenderKernels::blendedFullyDark,
+	&DunRenderKernels::blendedFullyLit,
+	&DunRenderKernels::blendedPartiallyLit,
+	&DunRenderKernels::stippledFullyDark,
+	&DunRenderKernels::stippledFullyLit,
+	&DunRenderKernels::stippledPartiallyLit,
+};
+
+void FillTables(std::mt19937 &rng)
+{
+	for (auto &entry : pLightTbl)
+		entry = static_cast<BYTE>(rng());
+	for (auto &row : paletteTransparencyLookup) {
+		for (auto &entry : row)
+			entry = static_cast<Uint8>(rng());
+	}
+}
+
+/**
+ * @brief Build a CEL file with one tile of each type, tiles stored as plain pixels are filled with random data
+ */
+void LoadTestTiles(std::mt19937 &rng)
+{
+	constexpr int TileTypes = 6;
+	constexpr int TileSize = 1024;
+	constexpr int HeaderSize = (TileTypes + 1) * 4;
+	pDungeonCels = std::make_unique<byte[]>(HeaderSize + TileTypes * TileSize);
+	auto *frameTable = reinterpret_cast<uint32_t *>(pDungeonCels.get());
+	frameTable[0] = TileTypes;
+	for (int type = 0; type < TileTypes; type++) {
+		const uint32_t offset = HeaderSize + type * TileSize;
+		frameTable[type + 1] = SDL_SwapLE32(offset);
+		auto *data = reinterpret_cast<uint8_t *>(&pDungeonCels[offset]);
+		for (int i = 0; i < TileSize; i++)
+			data[i] = static_cast<uint8_t>(rng());
+		if (type != 1)
+			continue;
+		// Transparent square: each row is a run of pixels, a gap and another run of pixels
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			const int first = 1 + rng() % 20;
+			const int gap = 1 + rng() % 8;
+			*data++ = first;
+			data += first;
+			*data++ = static_cast<uint8_t>(-gap);
+			*data++ = TILE_WIDTH / 2 - first - gap;
+			data += TILE_WIDTH / 2 - first - gap;
+		}
+	}
+}
+
+struct TransparencySetup {
+	bool transparency;
+	bool foliage;
+	char archDrawType;
+	bool blended;
+};
+
+void RenderTestTiles(const CelOutputBuffer &out)
+{
+	for (int type = 0; type < 6; type++) {
+		level_cel_block = (type + 1) | (type << 12);
+		RenderTile(out, type * TILE_WIDTH / 2 + 3, TILE_HEIGHT + 2);
+		// Also draw the tiles partly off screen
+		RenderTile(out, -5, type * 7 + 10);
+	}
+}
+
+} // namespace
+
+TEST(DunRender, KernelsMatchScalar)
+{
+	std::mt19937 rng(1234);
+	FillTables(rng);
+	const DunRenderKernels *scalar = GetDunRenderKernels(DunRenderIsa::Scalar);
+	ASSERT_NE(scalar, nullptr);
+
+	for (DunRenderIsa isa : { DunRenderIsa::SSE2, DunRenderIsa::AVX2, DunRenderIsa::NEON }) {
+		const DunRenderKernels *kernels = GetDunRenderKernels(isa);
+		if (kernels == nullptr)
+			continue;
+		for (KernelMember kernel : Kernels) {
+			for (unsigned n = 1; n <= 32; n++) {
+				for (int round = 0; round < 16; round++) {
+					std::array<std::uint8_t, 32> src;
+					std::array<std::uint8_t, 40> expected;
+					for (auto &pixel : src)
+						pixel = static_cast<std::uint8_t>(rng());
+					for (auto &pixel : expected)
+						pixel = static_cast<std::uint8_t>(rng());
+					std::array<std::uint8_t, 40> actual = expected;
+					const std::uint8_t *tbl = &pLightTbl[256 * (rng() % 16)];
+					const std::uint32_t mask = static_cast<std::uint32_t>(rng()) & (std::uint32_t(-1) << (32 - n));
+
+					(scalar->*kernel)(expected.data(), src.data(), n, tbl, mask);
+					(kernels->*kernel)(actual.data(), src.data(), n, tbl, mask);
+					ASSERT_EQ(actual, expected) << kernels->name << " n=" << n;
+				}
+			}
+		}
+	}
+}
+
+TEST(DunRender, CachedTilesMatchDecodedTiles)
+{
+	std::mt19937 rng(99);
+	FillTables(rng);
+	LoadTestTiles(rng);
+	lightmax = 15;
+	level_piece_id = 0;
+	block_lvid[0] = 3;
+
+	CelOutputBuffer expected = CelOutputBuffer::Alloc(4 * TILE_WIDTH, 2 * TILE_HEIGHT);
+	CelOutputBuffer actual = CelOutputBuffer::Alloc(4 * TILE_WIDTH, 2 * TILE_HEIGHT);
+	const size_t size = static_cast<size_t>(expected.pitch()) * expected.h();
+	std::vector<uint8_t> background(size);
+
+	const TransparencySetup setups[] = {
+		{ false, false, 0, true },
+		{ true, false, 0, true },
+		{ true, false, 0, false },
+		{ true, false, 1, true },
+		{ true, false, 2, false },
+		{ false, true, 1, false },
+		{ false, true, 2, true },
+	};
+	for (const TransparencySetup &setup : setups) {
+		cel_transparency_active = setup.transparency;
+		cel_foliage_active = setup.foliage;
+		arch_draw_type = setup.archDrawType;
+		sgOptions.Graphics.bBlendedTransparancy = setup.blended;
+		for (int light : { 0, 6, 15 }) {
+			light_table_index = light;
+			for (auto &pixel : background)
+				pixel = static_cast<uint8_t>(rng());
+
+			SetTileCacheBudget(0);
+			memcpy(expected.at(0, 0), background.data(), size);
+			RenderTestTiles(expected);
+
+			SetTileCacheBudget(1024 * 1024);
+			for (int pass = 0; pass < 2; pass++) {
+				memcpy(actual.at(0, 0), background.data(), size);
+				RenderTestTiles(actual);
+				EXPECT_EQ(memcmp(actual.at(0, 0), expected.at(0, 0), size), 0)
+				    << "transparency " << setup.transparency << " arch " << static_cast<int>(setup.archDrawType)
+				    << " blended " << setup.blended << " light " << light << " pass " << pass;
+			}
+		}
+	}
+
+	const TileCacheStats stats = GetTileCacheStats();
+	EXPECT_GT(stats.hits, 0);
+	EXPECT_GT(stats.entries, 0);
+	InvalidateTileCache();
+	EXPECT_EQ(GetTileCacheStats().entries, 0);
+
+	expected.Free();
+	actual.Free();
+	pDungeonCels = nullptr;
+}
+
+TEST(DunRender, BandsMatchFullBuffer)
+{
+	std::mt19937 rng(7);
+	FillTables(rng);
+	LoadTestTiles(rng);
+	lightmax = 15;
+	cel_transparency_active = false;
+	cel_foliage_active = false;
+	arch_draw_type = 1;
+	SetTileCacheBudget(0);
+
+	constexpr int BufferHeight = 3 * TILE_HEIGHT;
+	CelOutputBuffer expected = CelOutputBuffer::Alloc(TILE_WIDTH * 2, BufferHeight);
+	CelOutputBuffer actual = CelOutputBuffer::Alloc(TILE_WIDTH * 2, BufferHeight);
+	const size_t size = static_cast<size_t>(expected.pitch()) * expected.h();
+
+	for (int type = 0; type < 7; type++) {
+		level_cel_block = (type + 1) | (type << 12);
+		for (int light : { 0, 6, 15 }) {
+			light_table_index = light;
+			const auto render = [type](const CelOutputBuffer &out, int y) {
+				if (type == 6)
+					world_draw_black_tile(out, 10, y);
+				else
+					RenderTile(out, 10, y);
+			};
+
+			memset(expected.at(0, 0), 0xAA, size);
+			render(expected, 2 * TILE_HEIGHT);
+			for (int split = 1; split < BufferHeight; split++) {
+				memset(actual.at(0, 0), 0xAA, size);
+				render(actual.subregionY(0, split), 2 * TILE_HEIGHT);
+				render(actual.subregionY(split, BufferHeight - split), 2 * TILE_HEIGHT - split);
+				ASSERT_EQ(memcmp(actual.at(0, 0), expected.at(0, 0), size), 0) << "type " << type << " light " << light << " split " << split;
+			}
+		}
+	}
+
+	expected.Free();
+	actual.Free();
+	pDungeonCels = nullptr;
+}
+
+TEST(DunRender, ThreadedBandsMatchSingleThread)
+{
+	std::mt19937 rng(3);
+	FillTables(rng);
+	LoadTestTiles(rng);
+	lightmax = 15;
+	SetTileCacheBudget(1024 * 1024);
+
+	constexpr int Columns = 12;
+	constexpr int Rows = 20;
+	CelOutputBuffer expected = CelOutputBuffer::Alloc(Columns * TILE_WIDTH, Rows * TILE_HEIGHT / 2);
+	CelOutputBuffer actual = CelOutputBuffer::Alloc(Columns * TILE_WIDTH, Rows * TILE_HEIGHT / 2);
+	const size_t size = static_cast<size_t>(expected.pitch()) * expected.h();
+
+	// A staggered grid of tiles like the floor, with tiles that cross the band edges
+	const auto drawGrid = [](const CelOutputBuffer &band, int top) {
+		cel_transparency_active = false;
+		cel_foliage_active = false;
+		for (int row = 0; row < Rows + 2; row++) {
+			for (int column = 0; column < Columns; column++) {
+				const int type = (row * 3 + column) % 7;
+				const int sx = column * TILE_WIDTH + (row % 2) * TILE_WIDTH / 2 - TILE_WIDTH / 4;
+				const int sy = row * TILE_HEIGHT / 2 - top;
+				light_table_index = (row + column) % 16;
+				if (type == 6) {
+					world_draw_black_tile(band, sx, sy);
+					continue;
+				}
+				level_cel_block = (type + 1) | (type << 12);
+				arch_draw_type = 1;
+				RenderTile(band, sx, sy);
+				arch_draw_type = 2;
+				RenderTile(band, sx + TILE_WIDTH / 2, sy);
+			}
+		}
+	};
+
+	SetRenderThreadCount(1);
+	memset(expected.at(0, 0), 0x55, size);
+	DrawInBands(expected, drawGrid);
+
+	for (int threads : { 2, 3, 4, 8 }) {
+		SetRenderThreadCount(threads);
+		EXPECT_EQ(GetRenderThreadCount(), threads);
+		for (int frame = 0; frame < 3; frame++) {
+			memset(actual.at(0, 0), 0x55, size);
+			DrawInBands(actual, drawGrid);
+			EXPECT_EQ(memcmp(actual.at(0, 0), expected.at(0, 0), size), 0) << threads << " threads, frame " << frame;
+		}
+	}
+
+	SetRenderThreadCount(1);
+	InvalidateTileCache();
+	expected.Free();
+	actual.Free();
+	pDungeonCels = nullptr;
+}
+
+TEST(DunRender, OpaqueHeightIsFullyDrawn)
+{
+	std::mt19937 rng(21);
+	FillTables(rng);
+	LoadTestTiles(rng);
+	lightmax = 15;
+	light_table_index = 6;
+	level_piece_id = 0;
+	block_lvid[0] = 3;
+
+	constexpr int X = 8;
+	constexpr int Y = 40;
+	CelOutputBuffer black = CelOutputBuffer::Alloc(TILE_WIDTH, 2 * TILE_HEIGHT);
+	CelOutputBuffer white = CelOutputBuffer::Alloc(TILE_WIDTH, 2 * TILE_HEIGHT);
+	const size_t size = static_cast<size_t>(black.pitch()) * black.h();
+
+	const TransparencySetup setups[] = {
+		{ false, false, 0, true },
+		{ false, false, 1, true },
+		{ true, false, 0, true },
+		{ true, false, 1, false },
+		{ true, false, 2, true },
+		{ false, true, 1, false },
+		{ false, true, 2, true },
+	};
+	int opaqueTiles = 0;
+	for (const TransparencySetup &setup : setups) {
+		cel_transparency_active = setup.transparency;
+		cel_foliage_active = setup.foliage;
+		arch_draw_type = setup.archDrawType;
+		sgOptions.Graphics.bBlendedTransparancy = setup.blended;
+		for (int type = 0; type < 6; type++) {
+			level_cel_block = (type + 1) | (type << 12);
+			const int opaqueHeight = GetTileOpaqueHeight();
+			if (opaqueHeight > 0)
+				opaqueTiles++;
+			for (int budget : { 0, 1024 * 1024 }) {
+				SetTileCacheBudget(budget);
+				memset(black.at(0, 0), 0, size);
+				memset(white.at(0, 0), 0xFF, size);
+				RenderTile(black, X, Y);
+				RenderTile(white, X, Y);
+				// Pixels that don't depend on the background were all drawn by the tile
+				for (int row = Y - TILE_HEIGHT + 1; row < Y - TILE_HEIGHT + 1 + opaqueHeight; row++) {
+					for (int column = X; column < X + TILE_WIDTH / 2; column++) {
+						ASSERT_EQ(*black.at(column, row), *white.at(column, row))
+						    << "type " << type << " transparency " << setup.transparency << " arch " << static_cast<int>(setup.archDrawType) << " row " << row;
+					}
+				}
+			}
+		}
+	}
+	EXPECT_GT(opaqueTiles, 0);
+
+	InvalidateTileCache();
+	black.Free();
+	white.Free();
+	pDungeonCels = nullptr;
+}
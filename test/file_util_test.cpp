@@ -41,6 +41,20 @@ TEST(FileUtil, GetFileSize)
 	EXPECT_EQ(result, 42);
 }
 
+TEST(FileUtil, GetFileSizeAndTime)
+{
+	const std::string path = GetTmpPathName();
+	WriteDummyFile(path.c_str(), 42);
+	std::uintmax_t size;
+	std::int64_t modified;
+	ASSERT_TRUE(GetFileSizeAndTime(path.c_str(), &size, &modified));
+	EXPECT_EQ(size, 42);
+	std::int64_t again;
+	ASSERT_TRUE(GetFileSizeAndTime(path.c_str(), &size, &again));
+	EXPECT_EQ(again, modified);
+	EXPECT_FALSE(GetFileSizeAndTime("this-file-should-not-exist", &size, &modified));
+}
+
 TEST(FileUtil, FileExists)
 {
 	EXPECT_FALSE(FileExists("this-file-should-not-exist"));
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "drlg_l1.h"
+#include "drlg_l2.h"
+#include "drlg_l3.h"
+#include "drlg_l4.h"
+#include "gendung.h"
+#include "multi.h"
+#include "objdat.h"
+#include "quests.h"
+
+using namespace devilution;
+
+namespace {
+
+void SetupMegaTiles()
+{
+	pMegaTiles = std::make_unique<MegaTile[]>(256);
+	for (int i = 0; i < 256; i++) {
+		uint16_t base = i * 4;
+		pMegaTiles[i] = { base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3) };
+	}
+}
+
+void Generate(DungeonContext &ctx, int level, uint32_t seed)
+{
+	ctx.currlevel = level;
+	if (level <= 4) {
+		ctx.leveltype = DTYPE_CATHEDRAL;
+		CreateL5Dungeon(ctx, seed, ENTRY_MAIN);
+	} else if (level <= 8) {
+		ctx.leveltype = DTYPE_CATACOMBS;
+		CreateL2Dungeon(ctx, seed, ENTRY_MAIN);
+	} else if (level <= 12) {
+		ctx.leveltype = DTYPE_CAVES;
+		CreateL3Dungeon(ctx, seed, ENTRY_MAIN);
+	} else {
+		ctx.leveltype = DTYPE_HELL;
+		CreateL4Dungeon(ctx, seed, ENTRY_MAIN);
+	}
+}
+
+bool SameLayout(const DungeonContext &a, const DungeonContext &b)
+{
+	return memcmp(a.dungeon, b.dungeon, sizeof(a.dungeon)) == 0
+	    && memcmp(a.dPiece, b.dPiece, sizeof(a.dPiece)) == 0
+	    && memcmp(a.dTransVal, b.dTransVal, sizeof(a.dTransVal)) == 0
+	    && a.ViewX == b.ViewX && a.ViewY == b.ViewY;
+}
+
+} // namespace
+
+TEST(Gendung, ContextMatchesActiveDungeon)
+{
+	SetupMegaTiles();
+	for (int level : { 2, 6, 10, 14 }) {
+		Generate(ActiveDungeon, level, 42);
+
+		auto ctx = std::make_unique<DungeonContext>();
+		int activePiece = dPiece[50][50];
+		Generate(*ctx, level, 42);
+
+		EXPECT_TRUE(SameLayout(*ctx, ActiveDungeon)) << "level " << level;
+		EXPECT_EQ(dPiece[50][50], activePiece) << "level " << level;
+		EXPECT_EQ(currlevel, level);
+	}
+}
+
+TEST(Gendung, ConcurrentGeneration)
+{
+	SetupMegaTiles();
+	constexpr int Levels[] = { 2, 6, 10, 14 };
+
+	std::vector<std::unique_ptr<DungeonContext>> expected;
+	for (int level : Levels) {
+		expected.push_back(std::make_unique<DungeonContext>());
+		Generate(*expected.back(), level, 7);
+	}
+
+	std::vector<std::unique_ptr<DungeonContext>> contexts;
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < expected.size(); i++)
+		contexts.push_back(std::make_unique<DungeonContext>());
+	for (size_t i = 0; i < contexts.size(); i++) {
+		threads.emplace_back([&contexts, &Levels, i]() {
+			Generate(*contexts[i], Levels[i], 7);
+		});
+	}
+	for (std::thread &thread : threads)
+		thread.join();
+
+	for (size_t i = 0; i < contexts.size(); i++)
+		EXPECT_TRUE(SameLayout(*contexts[i], *expected[i])) << "level " << Levels[i];
+}
+
+TEST(Gendung, QuestEntrancesStayInContext)
+{
+	SetupMegaTiles();
+	gbIsMultiplayer = false;
+	quests[Q_PWATER]._qlevel = 2;
+	quests[Q_PWATER]._qactive = QUEST_INIT;
+	quests[Q_PWATER].position = { 0, 0 };
+
+	auto ctx = std::make_unique<DungeonContext>();
+	Generate(*ctx, 2, 42);
+
+	// Generation may run on any thread, so the live quest is only updated once the level is applied
+	ASSERT_TRUE(ctx->pwaterPosition);
+	EXPECT_TRUE(quests[Q_PWATER].position == (Point { 0, 0 }));
+	const Point entrance = *ctx->pwaterPosition;
+	ApplyDungeonQuestPositions(*ctx);
+	EXPECT_TRUE(quests[Q_PWATER].position == entrance);
+	EXPECT_FALSE(ctx->pwaterPosition);
+
+	quests[Q_PWATER]._qactive = QUEST_NOTAVAIL;
+	quests[Q_PWATER].position = { 0, 0 };
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "engine/grid_serialize.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/** Sizes of the level grids and the automap, plus sizes that leave partial tiles on both axes */
+const int Sizes[][2] = {
+	{ 112, 112 },
+	{ 40, 40 },
+	{ 13, 37 },
+	{ 19, 8 },
+	{ 33, 17 },
+};
+
+} // namespace
+
+TEST(GridSerialize, BytesMatchSaveLoop)
+{
+	std::mt19937 rng(1);
+	for (const auto &size : Sizes) {
+		const int width = size[0];
+		const int height = size[1];
+		std::vector<uint8_t> grid(width * height);
+		for (uint8_t &value : grid)
+			value = rng();
+
+		// The loops the save files were always written with
+		std::vector<uint8_t> expected;
+		for (int j = 0; j < height; j++) {
+			for (int i = 0; i < width; i++)
+				expected.push_back(grid[i * height + j]);
+		}
+
+		std::vector<uint8_t> saved(width * height);
+		SaveGridBytes(saved.data(), grid.data(), width, height);
+		EXPECT_EQ(saved, expected) << width << "x" << height;
+
+		std::vector<uint8_t> loaded(width * height);
+		LoadGridBytes(loaded.data(), saved.data(), width, height);
+		EXPECT_EQ(loaded, grid) << width << "x" << height;
+	}
+}
+
+TEST(GridSerialize, BE32MatchesSaveLoop)
+{
+	std::mt19937 rng(2);
+	for (const auto &size : Sizes) {
+		const int width = size[0];
+		const int height = size[1];
+		std::vector<int16_t> grid(width * height);
+		for (int16_t &value : grid)
+			value = static_cast<int16_t>(rng());
+
+		std::vector<uint8_t> expected;
+		for (int j = 0; j < height; j++) {
+			for (int i = 0; i < width; i++) {
+				const uint32_t value = static_cast<uint32_t>(static_cast<int32_t>(grid[i * height + j]));
+				expected.push_back(value >> 24);
+				expected.push_back(value >> 16);
+				expected.push_back(value >> 8);
+				expected.push_back(value);
+			}
+		}
+
+		std::vector<uint8_t> saved(width * height * 4);
+		SaveGridBE32(saved.data(), grid.data(), width, height);
+		EXPECT_EQ(saved, expected) << width << "x" << height;
+
+		std::vector<int16_t> loaded(width * height);
+		LoadGridBE32(loaded.data(), saved.data(), width, height);
+		EXPECT_EQ(loaded, grid) << width << "x" << height;
+	}
+}
+
+TEST(GridSerialize, BE32KeepsLowBits)
+{
+	// Values that don't fit 16 bits load the way the old int32 to int16 assignment truncated them
+	const uint8_t saved[] = {
+		0x00, 0x01, 0x12, 0x34,
+		0x7F, 0xFF, 0xFF, 0xFE,
+	};
+	int16_t grid[2];
+	LoadGridBE32(grid, saved, 2, 1);
+	EXPECT_EQ(grid[0], 0x1234);
+	EXPECT_EQ(grid[1], -2);
+}
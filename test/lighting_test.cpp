@@ -1,10 +1,86 @@
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "control.h"
+#include "gendung.h"
 #include "lighting.h"
 
 using namespace devilution;
 
+namespace {
+
+/**
+ * @brief Move lights around for a number of ticks and check the light map against one rebuilt from scratch
+ */
+void CheckIncrementalLighting(int level)
+{
+	currlevel = level;
+	MakeLightRadiusTables();
+
+	std::mt19937 rng(level);
+	for (auto &column : dPreLight) {
+		for (auto &light : column)
+			light = rng() % 16;
+	}
+	memcpy(dLight, dPreLight, sizeof(dLight));
+	InitLighting();
+
+	auto randomTile = [&]() { return Point { static_cast<int>(rng() % MAXDUNX), static_cast<int>(rng() % MAXDUNY) }; };
+
+	int lights[12];
+	for (int &id : lights) {
+		id = AddLight(randomTile(), rng() % 16);
+	}
+
+	for (int tick = 0; tick < 200; tick++) {
+		for (int &id : lights) {
+			switch (rng() % 8) {
+			case 0:
+				ChangeLightXY(id, LightList[id].position.tile + Point { static_cast<int>(rng() % 3) - 1, static_cast<int>(rng() % 3) - 1 });
+				break;
+			case 1:
+				ChangeLightOff(id, { static_cast<int>(rng() % 15) - 7, static_cast<int>(rng() % 15) - 7 });
+				break;
+			case 2:
+				ChangeLightRadius(id, rng() % 16);
+				break;
+			case 3:
+				if (rng() % 4 == 0) {
+					AddUnLight(id);
+					id = AddLight(randomTile(), rng() % 16);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		ProcessLightList();
+
+		char incremental[MAXDUNX][MAXDUNY];
+		memcpy(incremental, dLight, sizeof(incremental));
+		memcpy(dLight, dPreLight, sizeof(dLight));
+		for (int i = 0; i < numlights; i++) {
+			int id = lightactive[i];
+			DoLighting(LightList[id].position.tile, LightList[id]._lradius, id);
+		}
+		ASSERT_EQ(memcmp(incremental, dLight, sizeof(incremental)), 0) << "level " << level << ", tick " << tick;
+	}
+}
+
+} // namespace
+
+TEST(Lighting, IncrementalUpdate)
+{
+	CheckIncrementalLighting(1);
+	CheckIncrementalLighting(17);
+
+	currlevel = 0;
+	InitLighting();
+	memset(dLight, 0, sizeof(dLight));
+	memset(dPreLight, 0, sizeof(dPreLight));
+}
+
 TEST(Lighting, CrawlTables)
 {
 	int CrawlNum[19] = { 0, 3, 12, 45, 94, 159, 240, 337, 450, 579, 724, 885, 1062, 1255, 1464, 1689, 1930, 2187, 2460 };
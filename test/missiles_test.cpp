@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "missiles.h"
 
 using namespace devilution;
@@ -85,3 +88,65 @@ TEST(Missiles, GetDirection16)
 	EXPECT_EQ(DIR16_SE, GetDirection16({ 2, 2 }, { 4, 2 }));
 	EXPECT_EQ(DIR16_Se, GetDirection16({ 2, 2 }, { 4, 3 }));
 }
+
+TEST(Missiles, PoolGrowsPastFirstBlock)
+{
+	InitMissiles();
+	std::vector<bool> used(MAXMISSILES * 3);
+	for (int i = 0; i < MAXMISSILES * 3; i++) {
+		int mi = AddMissile({ 10, 10 }, { 12, 12 }, 0, MIS_BOOM, TARGET_MONSTERS, -1, 0, 0);
+		ASSERT_GE(mi, 0);
+		ASSERT_LT(mi, missile.capacity());
+		EXPECT_FALSE(used[mi]);
+		used[mi] = true;
+	}
+	EXPECT_EQ(nummissiles, MAXMISSILES * 3);
+
+	int active[MAXMISSILES];
+	int avail[MAXMISSILES];
+	int saved = GetSavedMissiles(active, avail);
+	EXPECT_EQ(saved, MAXMISSILES - 1);
+	std::vector<bool> savedIds(MAXMISSILES);
+	for (int i = 0; i < saved; i++)
+		savedIds[active[i]] = true;
+	for (int i = 0; i < MAXMISSILES - saved; i++) {
+		EXPECT_FALSE(savedIds[avail[i]]);
+		savedIds[avail[i]] = true;
+	}
+	EXPECT_EQ(std::count(savedIds.begin(), savedIds.end(), true), MAXMISSILES);
+
+	InitMissiles();
+	EXPECT_EQ(nummissiles, 0);
+	EXPECT_EQ(missile.capacity(), MAXMISSILES);
+}
+
+TEST(Missiles, DeleteFlaggedMissiles)
+{
+	InitMissiles();
+	int ids[6];
+	for (int &mi : ids)
+		mi = AddMissile({ 10, 10 }, { 12, 12 }, 0, MIS_BOOM, TARGET_MONSTERS, -1, 0, 0);
+	for (int i = 0; i < 6; i++)
+		ASSERT_EQ(missileactive[i], ids[i]);
+
+	missile[ids[0]]._miDelFlag = true;
+	missile[ids[2]]._miDelFlag = true;
+	missile[ids[5]]._miDelFlag = true;
+	DeleteFlaggedMissiles();
+
+	// Each deleted missile was replaced by the last active one
+	ASSERT_EQ(nummissiles, 3);
+	EXPECT_EQ(missileactive[0], ids[4]);
+	EXPECT_EQ(missileactive[1], ids[1]);
+	EXPECT_EQ(missileactive[2], ids[3]);
+
+	// The deleted ids went back to the free list
+	const int capacity = missile.capacity();
+	std::vector<int> freed { missileavail[capacity - 6], missileavail[capacity - 5], missileavail[capacity - 4] };
+	std::vector<int> expected { ids[0], ids[2], ids[5] };
+	std::sort(freed.begin(), freed.end());
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(freed, expected);
+
+	InitMissiles();
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "engine/occlusion_map.hpp"
+
+using namespace devilution;
+
+TEST(OcclusionMap, NothingIsHiddenWithoutOccluders)
+{
+	OcclusionMap map;
+	map.Reset({ 640, 352 }, { 0, 0 });
+	EXPECT_FALSE(map.IsHidden({ { 100, 100 }, { 10, 10 } }, 0));
+	EXPECT_TRUE(map.IsHidden({ { -50, 10 }, { 20, 20 } }, 0));
+	EXPECT_TRUE(map.IsHidden({ { 10, 400 }, { 20, 20 } }, 0));
+}
+
+TEST(OcclusionMap, HidesOnlyEarlierDraws)
+{
+	OcclusionMap map;
+	map.Reset({ 640, 352 }, { 0, 0 });
+	map.AddOccluder({ { 64, 32 }, { 64, 64 } }, 5);
+	EXPECT_TRUE(map.IsHidden({ { 70, 40 }, { 50, 50 } }, 4));
+	EXPECT_TRUE(map.IsHidden({ { 64, 32 }, { 64, 64 } }, 0));
+	EXPECT_FALSE(map.IsHidden({ { 70, 40 }, { 50, 50 } }, 5));
+	EXPECT_FALSE(map.IsHidden({ { 63, 40 }, { 50, 50 } }, 4));
+	EXPECT_FALSE(map.IsHidden({ { 70, 40 }, { 50, 57 } }, 4));
+}
+
+TEST(OcclusionMap, OnlyMarksWholeCells)
+{
+	OcclusionMap map;
+	map.Reset({ 640, 352 }, { 0, 0 });
+	// Covers all of the cells in [32, 64) x [16, 32) but only part of the cells around it
+	map.AddOccluder({ { 20, 10 }, { 50, 30 } }, 1);
+	EXPECT_TRUE(map.IsHidden({ { 32, 16 }, { 32, 16 } }, 0));
+	EXPECT_FALSE(map.IsHidden({ { 31, 16 }, { 2, 2 } }, 0));
+	EXPECT_FALSE(map.IsHidden({ { 40, 15 }, { 2, 2 } }, 0));
+}
+
+TEST(OcclusionMap, FollowsGridOrigin)
+{
+	OcclusionMap map;
+	map.Reset({ 640, 352 }, { -21, 7 });
+	// Tiles drawn at the grid origin cover whole cells
+	map.AddOccluder({ { 11, 23 }, { 32, 32 } }, 1);
+	EXPECT_TRUE(map.IsHidden({ { 11, 23 }, { 32, 32 } }, 0));
+	EXPECT_FALSE(map.IsHidden({ { 10, 23 }, { 32, 32 } }, 0));
+
+	// Cells along the edges are partly off screen, only the visible part has to be covered
+	map.AddOccluder({ { -21, -9 }, { 32, 16 } }, 2);
+	EXPECT_TRUE(map.IsHidden({ { -5, -5 }, { 10, 10 } }, 1));
+}
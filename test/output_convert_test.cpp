@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "engine/render/output_convert.hpp"
+
+using namespace devilution;
+
+namespace {
+
+std::vector<const OutputConvertKernels *> SupportedKernels()
+{
+	std::vector<const OutputConvertKernels *> kernels;
+	for (DunRenderIsa isa : { DunRenderIsa::SSE2, DunRenderIsa::AVX2, DunRenderIsa::NEON }) {
+		const OutputConvertKernels *isaKernels = GetOutputConvertKernels(isa);
+		if (isaKernels != nullptr)
+			kernels.push_back(isaKernels);
+	}
+	return kernels;
+}
+
+} // namespace
+
+TEST(OutputConvert, KernelsMatchScalar)
+{
+	const OutputConvertKernels &scalar = *GetOutputConvertKernels(DunRenderIsa::Scalar);
+	std::mt19937 rng(5);
+	std::uint32_t colors[256];
+	for (std::uint32_t &color : colors)
+		color = rng();
+	std::uint8_t src[128];
+	for (std::uint8_t &pixel : src)
+		pixel = rng();
+
+	for (const OutputConvertKernels *kernels : SupportedKernels()) {
+		for (unsigned n : { 0U, 1U, 7U, 8U, 15U, 16U, 17U, 33U, 64U, 101U, 128U }) {
+			std::uint8_t expectedDoubled[256];
+			std::uint8_t actualDoubled[256];
+			scalar.doublePixels(expectedDoubled, src, n);
+			kernels->doublePixels(actualDoubled, src, n);
+			EXPECT_EQ(memcmp(actualDoubled, expectedDoubled, 2 * n), 0) << kernels->name << " doublePixels n=" << n;
+
+			std::uint32_t expectedColors[128];
+			std::uint32_t actualColors[128];
+			scalar.palettedToRgb32(expectedColors, src, n, colors);
+			kernels->palettedToRgb32(actualColors, src, n, colors);
+			EXPECT_EQ(memcmp(actualColors, expectedColors, n * sizeof(std::uint32_t)), 0) << kernels->name << " palettedToRgb32 n=" << n;
+		}
+	}
+}
+
+TEST(OutputConvert, DoublePixelsInPlace)
+{
+	std::mt19937 rng(6);
+	for (const OutputConvertKernels *kernels : SupportedKernels()) {
+		for (unsigned offset : { 0U, 1U, 5U, 40U }) {
+			std::uint8_t line[300];
+			for (std::uint8_t &pixel : line)
+				pixel = rng();
+			std::uint8_t expected[300];
+			memcpy(expected, line, sizeof(line));
+			for (unsigned i = 0; i < 100; i++) {
+				expected[offset + 2 * i] = line[i];
+				expected[offset + 2 * i + 1] = line[i];
+			}
+			kernels->doublePixels(line + offset, line, 100);
+			EXPECT_EQ(memcmp(line, expected, sizeof(line)), 0) << kernels->name << " offset=" << offset;
+		}
+	}
+}
+
+TEST(OutputConvert, ConvertRect)
+{
+	std::uint32_t colors[256];
+	for (int i = 0; i < 256; i++)
+		colors[i] = 0xFF000000 | (i << 16) | (255 - i);
+	std::uint8_t src[10][20];
+	for (int y = 0; y < 10; y++) {
+		for (int x = 0; x < 20; x++)
+			src[y][x] = y * 20 + x;
+	}
+	std::uint32_t dst[8][32] = {};
+
+	ConvertPalettedToRgb32(&dst[1][2], 32, &src[3][4], 20, 13, 6, colors);
+
+	for (int y = 0; y < 8; y++) {
+		for (int x = 0; x < 32; x++) {
+			const bool inside = y >= 1 && y < 7 && x >= 2 && x < 15;
+			const std::uint32_t expected = inside ? colors[src[y + 2][x + 2]] : 0;
+			EXPECT_EQ(dst[y][x], expected) << x << "," << y;
+		}
+	}
+}
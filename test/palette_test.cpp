@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+#include "engine/palette_match.hpp"
+#include "palette.h"
+
+using namespace devilution;
+
+namespace {
+
+Uint8 FindBestMatchLinear(const SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
+{
+	Uint8 best = 0;
+	Uint32 bestDiff = SDL_MAX_UINT32;
+	for (int i = 0; i < 256; i++) {
+		if (i >= skipFrom && i <= skipTo)
+			continue;
+		int diffr = palette[i].r - color.r;
+		int diffg = palette[i].g - color.g;
+		int diffb = palette[i].b - color.b;
+		Uint32 diff = diffr * diffr + diffg * diffg + diffb * diffb;
+		if (bestDiff > diff) {
+			best = i;
+			bestDiff = diff;
+		}
+	}
+	return best;
+}
+
+void RandomPalette(std::mt19937 &rng, SDL_Color *palette, int channelMax)
+{
+	std::uniform_int_distribution<int> channel(0, channelMax);
+	for (int i = 0; i < 256; i++)
+		palette[i] = { static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), 255 };
+}
+
+void ExpectMatchesLinear(const SDL_Color *palette, int skipFrom, int skipTo, std::mt19937 &rng)
+{
+	PaletteMatcher matcher(palette, skipFrom, skipTo);
+	std::uniform_int_distribution<int> channel(0, 255);
+	for (int i = 0; i < 4096; i++) {
+		const SDL_Color color = { static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)), 255 };
+		ASSERT_EQ(matcher.FindBestMatch(color), FindBestMatchLinear(palette, color, skipFrom, skipTo))
+		    << "color " << (int)color.r << "," << (int)color.g << "," << (int)color.b;
+	}
+	for (int i = 0; i < 256; i++)
+		ASSERT_EQ(matcher.FindBestMatch(palette[i]), FindBestMatchLinear(palette, palette[i], skipFrom, skipTo)) << "entry " << i;
+}
+
+} // namespace
+
+TEST(Palette, MatcherFindsSameColorAsLinearSearch)
+{
+	std::mt19937 rng(3);
+	SDL_Color palette[256];
+	for (int channelMax : { 255, 63, 7 }) {
+		RandomPalette(rng, palette, channelMax);
+		ExpectMatchesLinear(palette, -1, -1, rng);
+		ExpectMatchesLinear(palette, 1, 31, rng);
+		ExpectMatchesLinear(palette, 1, 15, rng);
+	}
+}
+
+TEST(Palette, MatcherPrefersLowestIndexOnTies)
+{
+	SDL_Color palette[256];
+	for (int i = 0; i < 256; i++)
+		palette[i] = { static_cast<Uint8>(i & 0xE0), 0, 0, 255 };
+	PaletteMatcher matcher(palette, -1, -1);
+	EXPECT_EQ(matcher.FindBestMatch({ 0x40, 0, 0, 255 }), 64);
+	// 0x50 is as far from 0x40 as from 0x60
+	EXPECT_EQ(matcher.FindBestMatch({ 0x50, 0, 0, 255 }), 64);
+	EXPECT_EQ(matcher.FindBestMatch({ 0xFF, 0xFF, 0xFF, 255 }), 224);
+}
+
+TEST(Palette, BlendedLookupTableMatchesLinearSearch)
+{
+	std::mt19937 rng(5);
+	SDL_Color palette[256];
+	RandomPalette(rng, palette, 255);
+	for (int i = 32; i < 64; i++)
+		palette[i] = palette[i - 32];
+
+	GenerateBlendedLookupTable(palette, 1, 31);
+	for (int i = 0; i < 256; i++) {
+		for (int j = 0; j < 256; j++) {
+			Uint8 expected = i;
+			if (i != j) {
+				SDL_Color blendedColor;
+				blendedColor.r = ((int)palette[i].r + (int)palette[j].r) / 2;
+				blendedColor.g = ((int)palette[i].g + (int)palette[j].g) / 2;
+				blendedColor.b = ((int)palette[i].b + (int)palette[j].b) / 2;
+				expected = FindBestMatchLinear(palette, blendedColor, 1, 31);
+			}
+			ASSERT_EQ(paletteTransparencyLookup[i][j], expected) << i << "," << j;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "gendung.h"
+#include "path.h"
+
+using namespace devilution;
+
+namespace {
+
+/** Offsets for the step directions returned by FindPath, see path_directions */
+const Point StepOffsets[9] = { { 0, 0 }, { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+
+bool Blocked[MAXDUNX][MAXDUNY];
+
+void ClearMap()
+{
+	memset(dPiece, 0, sizeof(dPiece));
+	memset(Blocked, 0, sizeof(Blocked));
+	nSolidTable[0] = false;
+	nSolidTable[1] = true;
+}
+
+bool PosOkTest(int /*unused*/, Point position)
+{
+	if (position.x < 0 || position.y < 0 || position.x >= MAXDUNX || position.y >= MAXDUNY)
+		return false;
+	return !Blocked[position.x][position.y];
+}
+
+bool PosOkNested(int arg, Point position)
+{
+	int8_t innerPath[MAX_PATH_LENGTH];
+	FindPath(PosOkTest, arg, position.x, position.y, position.x + 3, position.y + 1, innerPath);
+	return PosOkTest(arg, position);
+}
+
+Point WalkPath(Point position, const int8_t *path, int steps)
+{
+	for (int i = 0; i < steps; i++) {
+		position += StepOffsets[path[i]];
+		EXPECT_TRUE(PosOkTest(0, position)) << "step " << i;
+	}
+	return position;
+}
+
+} // namespace
+
+TEST(Path, Heuristics)
+{
+	EXPECT_EQ(path_get_h_cost(0, 0, 0, 0), 0);
+	EXPECT_EQ(path_get_h_cost(0, 0, 3, 4), 14);
+	EXPECT_EQ(path_get_h_cost(10, 3, 2, 1), 20);
+}
+
+TEST(Path, SolidPieces)
+{
+	ClearMap();
+	EXPECT_TRUE(path_solid_pieces({ 10, 10 }, { 11, 11 }));
+	dPiece[11][10] = 1;
+	EXPECT_FALSE(path_solid_pieces({ 10, 10 }, { 11, 11 }));
+	EXPECT_FALSE(path_solid_pieces({ 11, 11 }, { 10, 10 }));
+	EXPECT_TRUE(path_solid_pieces({ 10, 10 }, { 9, 11 }));
+	EXPECT_TRUE(path_solid_pieces({ 10, 10 }, { 10, 11 }));
+}
+
+TEST(Path, FindPathStraight)
+{
+	ClearMap();
+	int8_t path[MAX_PATH_LENGTH];
+	ASSERT_EQ(FindPath(PosOkTest, 0, 10, 10, 15, 10, path), 5);
+	for (int i = 0; i < 5; i++)
+		EXPECT_EQ(path[i], 3);
+
+	ASSERT_EQ(FindPath(PosOkTest, 0, 10, 10, 14, 14, path), 4);
+	for (int i = 0; i < 4; i++)
+		EXPECT_EQ(path[i], 7);
+}
+
+TEST(Path, FindPathAroundWall)
+{
+	ClearMap();
+	for (int y = 8; y <= 12; y++) {
+		Blocked[12][y] = true;
+		dPiece[12][y] = 1;
+	}
+
+	int8_t path[MAX_PATH_LENGTH];
+	int steps = FindPath(PosOkTest, 0, 10, 10, 14, 10, path);
+	ASSERT_GE(steps, 6);
+	EXPECT_EQ(WalkPath({ 10, 10 }, path, steps), (Point { 14, 10 }));
+}
+
+TEST(Path, FindPathUnreachable)
+{
+	ClearMap();
+	for (int i = 8; i <= 12; i++) {
+		Blocked[i][8] = true;
+		Blocked[i][12] = true;
+		Blocked[8][i] = true;
+		Blocked[12][i] = true;
+	}
+
+	int8_t path[MAX_PATH_LENGTH];
+	EXPECT_EQ(FindPath(PosOkTest, 0, 10, 10, 20, 10, path), 0);
+}
+
+TEST(Path, FindPathTooLong)
+{
+	ClearMap();
+	int8_t path[MAX_PATH_LENGTH];
+	EXPECT_EQ(FindPath(PosOkTest, 0, 10, 10, 34, 10, path), 24);
+	EXPECT_EQ(FindPath(PosOkTest, 0, 10, 10, 35, 10, path), 0);
+}
+
+TEST(Path, FindPathReentrant)
+{
+	ClearMap();
+	for (int y = 5; y <= 15; y++)
+		Blocked[13][y] = true;
+
+	int8_t expected[MAX_PATH_LENGTH];
+	int expectedSteps = FindPath(PosOkTest, 0, 10, 10, 16, 10, expected);
+	ASSERT_GT(expectedSteps, 0);
+
+	int8_t path[MAX_PATH_LENGTH];
+	ASSERT_EQ(FindPath(PosOkNested, 0, 10, 10, 16, 10, path), expectedSteps);
+	for (int i = 0; i < expectedSteps; i++)
+		EXPECT_EQ(path[i], expected[i]) << "step " << i;
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "utils/profiler.h"
+
+using namespace devilution;
+
+namespace {
+
+std::string ReadFile(const char *path)
+{
+	std::ifstream file(path);
+	std::stringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+size_t CountOccurrences(const std::string &text, const std::string &pattern)
+{
+	size_t count = 0;
+	for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+		count++;
+	return count;
+}
+
+} // namespace
+
+TEST(Profiler, InactiveByDefault)
+{
+	EXPECT_FALSE(ProfilerActive);
+	{
+		ProfileScope scope(ProfileStage::GameLogic);
+	}
+	EXPECT_FALSE(ProfilerActive);
+}
+
+TEST(Profiler, WritesTrace)
+{
+	const char *path = "Test_Profiler_Trace.json";
+
+	StartProfilerTrace(path);
+	EXPECT_TRUE(ProfilerActive);
+	for (int frame = 0; frame < 3; frame++) {
+		ProfileScope logic(ProfileStage::GameLogic);
+		{
+			ProfileScope monsters(ProfileStage::ProcessMonsters);
+		}
+		ProfileScope missiles(ProfileStage::ProcessMissiles);
+	}
+	StopProfilerTrace();
+	EXPECT_FALSE(ProfilerActive);
+
+	// Scopes created after the trace is stopped are not recorded
+	{
+		ProfileScope scope(ProfileStage::DrawAndBlit);
+	}
+
+	std::string trace = ReadFile(path);
+	EXPECT_EQ(trace.compare(0, 16, "{\"traceEvents\":["), 0);
+	EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 9);
+	EXPECT_EQ(CountOccurrences(trace, "\"name\":\"game_logic\""), 3);
+	EXPECT_EQ(CountOccurrences(trace, "\"name\":\"ProcessMonsters\""), 3);
+	EXPECT_EQ(CountOccurrences(trace, "\"name\":\"ProcessMissiles\""), 3);
+	EXPECT_EQ(CountOccurrences(trace, "DrawAndBlit"), 0);
+	EXPECT_EQ(trace.substr(trace.size() - 3), "]}\n");
+
+	std::remove(path);
+}
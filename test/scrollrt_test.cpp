@@ -1,11 +1,135 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dead.h"
 #include "diablo.h"
+#include "gendung.h"
+#include "lighting.h"
+#include "missiles.h"
+#include "player.h"
 #include "scrollrt.h"
 #include "utils/ui_fwd.h"
 
 using namespace devilution;
 
+namespace {
+
+constexpr int CorpseWidth = 64;
+constexpr int CorpseHeight = 80;
+
+/**
+ * @brief Build a level CEL with one tile of each type, tiles stored as plain pixels are filled with random data
+ */
+void LoadSceneTiles(std::mt19937 &rng)
+{
+	constexpr int TileTypes = 6;
+	constexpr int TileSize = 1024;
+	constexpr int HeaderSize = (TileTypes + 1) * 4;
+	pDungeonCels = std::make_unique<byte[]>(HeaderSize + TileTypes * TileSize);
+	auto *frameTable = reinterpret_cast<uint32_t *>(pDungeonCels.get());
+	frameTable[0] = SDL_SwapLE32(TileTypes);
+	for (int type = 0; type < TileTypes; type++) {
+		const uint32_t offset = HeaderSize + type * TileSize;
+		frameTable[type + 1] = SDL_SwapLE32(offset);
+		auto *data = reinterpret_cast<uint8_t *>(&pDungeonCels[offset]);
+		for (int i = 0; i < TileSize; i++)
+			data[i] = static_cast<uint8_t>(rng());
+		if (type != 1)
+			continue;
+		// Transparent square: each row is a run of pixels, a gap and another run of pixels
+		for (int row = 0; row < TILE_HEIGHT; row++) {
+			const int first = 1 + rng() % 20;
+			const int gap = 1 + rng() % 8;
+			*data++ = first;
+			data += first;
+			*data++ = static_cast<uint8_t>(-gap);
+			*data++ = TILE_WIDTH / 2 - first - gap;
+			data += TILE_WIDTH / 2 - first - gap;
+		}
+	}
+}
+
+/**
+ * @brief Build a CL2 sprite with one frame, every line has opaque pixels between two transparent gaps
+ */
+std::unique_ptr<byte[]> MakeCorpseSprite(std::mt19937 &rng)
+{
+	constexpr int Gap = 8;
+	constexpr int Opaque = CorpseWidth - 2 * Gap;
+	std::vector<uint8_t> frame;
+	for (int y = 0; y < CorpseHeight; y++) {
+		frame.push_back(Gap);
+		frame.push_back(static_cast<uint8_t>(-Opaque));
+		for (int x = 0; x < Opaque; x++)
+			frame.push_back(static_cast<uint8_t>(rng()));
+		frame.push_back(Gap);
+	}
+
+	constexpr uint32_t FrameHeaderSize = 10;
+	constexpr uint32_t FrameBegin = 3 * sizeof(uint32_t);
+	const uint32_t frameEnd = FrameBegin + FrameHeaderSize + static_cast<uint32_t>(frame.size());
+	auto data = std::make_unique<byte[]>(frameEnd);
+	const uint32_t table[] = { SDL_SwapLE32(1), SDL_SwapLE32(FrameBegin), SDL_SwapLE32(frameEnd) };
+	memcpy(data.get(), table, sizeof(table));
+	const uint8_t header[FrameHeaderSize] = { FrameHeaderSize, 0 };
+	memcpy(&data[FrameBegin], header, FrameHeaderSize);
+	memcpy(&data[FrameBegin + FrameHeaderSize], frame.data(), frame.size());
+	return data;
+}
+
+/**
+ * @brief Fill the level with floor crossed by lines of walls that have gaps in them, with a corpse on every floor tile
+ */
+void LoadScene(const byte *corpse)
+{
+	memset(dFlags, 0, sizeof(dFlags));
+	memset(dPlayer, 0, sizeof(dPlayer));
+	memset(dMonster, 0, sizeof(dMonster));
+	memset(dObject, 0, sizeof(dObject));
+	memset(dItem, 0, sizeof(dItem));
+	memset(dSpecial, 0, sizeof(dSpecial));
+	memset(dLight, 0, sizeof(dLight));
+	memset(dTransVal, 0, sizeof(dTransVal));
+	memset(dpiece_defs_map_2, 0, sizeof(dpiece_defs_map_2));
+
+	constexpr uint16_t Square = 1;
+	constexpr uint16_t LeftTriangle = 3 | (2 << 12);
+	constexpr uint16_t RightTriangle = 4 | (3 << 12);
+	constexpr uint16_t LeftTrapezoid = 5 | (4 << 12);
+	constexpr uint16_t RightTrapezoid = 6 | (5 << 12);
+	nSolidTable.fill(false);
+	nSolidTable[2] = true;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			MICROS &micros = dpiece_defs_map_2[x][y];
+			if (x % 4 == 0 && y % 6 != 0) {
+				dPiece[x][y] = 2;
+				micros.mt[0] = LeftTrapezoid;
+				micros.mt[1] = RightTrapezoid;
+				for (int i = 2; i < MicroTileLen; i++)
+					micros.mt[i] = Square;
+				dDead[x][y] = 0;
+			} else {
+				dPiece[x][y] = 1;
+				micros.mt[0] = LeftTriangle;
+				micros.mt[1] = RightTriangle;
+				dDead[x][y] = 1;
+			}
+		}
+	}
+
+	dead[0]._deadData.fill(corpse);
+	dead[0]._deadFrame = 1;
+	dead[0]._deadWidth = CorpseWidth;
+	dead[0]._deadtrans = 0;
+}
+
+} // namespace
+
 // TilesInView
 
 TEST(Scrool_rt, calc_tiles_in_view_original)
@@ -162,3 +286,45 @@ TEST(Scrool_rt, calc_tiles_covered_by_panel_960_zoom)
 	zoomflag = false;
 	EXPECT_EQ(RowsCoveredByPanel(), 2);
 }
+
+TEST(Scrool_rt, culling_keeps_frame)
+{
+	std::mt19937 rng(42);
+	LoadSceneTiles(rng);
+	const std::unique_ptr<byte[]> corpse = MakeCorpseSprite(rng);
+	leveltype = DTYPE_CATHEDRAL;
+	MicroTileLen = 10;
+	lightmax = 15;
+	MissilePreFlag = false;
+	LoadScene(corpse.get());
+
+	gnScreenWidth = 640;
+	gnScreenHeight = 480;
+	gnViewportHeight = gnScreenHeight - 128;
+	zoomflag = true;
+	CalcViewportGeometry();
+	myplr = 0;
+	plr[myplr]._pmode = PM_STAND;
+
+	CelOutputBuffer culled = CelOutputBuffer::Alloc(gnScreenWidth, gnScreenHeight);
+	CelOutputBuffer drawn = CelOutputBuffer::Alloc(gnScreenWidth, gnScreenHeight);
+	// Views at different offsets to the lines of walls
+	for (int x = 40; x < 44; x++) {
+		for (int y = 40; y < 43; y++) {
+			memset(culled.begin(), 0, gnScreenWidth * gnScreenHeight);
+			memset(drawn.begin(), 0, gnScreenWidth * gnScreenHeight);
+			CullOccludedSprites = true;
+			DrawGame(culled, x, y);
+			CullOccludedSprites = false;
+			DrawGame(drawn, x, y);
+			EXPECT_EQ(memcmp(culled.begin(), drawn.begin(), gnScreenWidth * gnScreenHeight), 0) << x << ',' << y;
+		}
+	}
+	CullOccludedSprites = true;
+	culled.Free();
+	drawn.Free();
+
+	memset(dDead, 0, sizeof(dDead));
+	dead[0]._deadData.fill(nullptr);
+	pDungeonCels = nullptr;
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "engine/sprite_cache.hpp"
+#include "init.h"
+#include "mpqapi.h"
+#include "storm/storm.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr size_t TestSpriteSize = 4 * 1024;
+
+void OpenTestArchive()
+{
+	std::remove("Test_SpriteCache.mpq");
+	ASSERT_TRUE(OpenMPQ("Test_SpriteCache.mpq"));
+	std::vector<byte> data(TestSpriteSize);
+	for (const char *name : { "test\\a.cl2", "test\\b.cl2", "test\\c.cl2" }) {
+		for (size_t i = 0; i < TestSpriteSize; i++)
+			data[i] = static_cast<byte>(name[5] + i);
+		ASSERT_TRUE(mpqapi_write_file(name, data.data(), data.size()));
+	}
+	ASSERT_TRUE(mpqapi_flush_and_close(true));
+	ASSERT_TRUE(SFileOpenArchive("Test_SpriteCache.mpq", 0, MPQ_OPEN_READ_ONLY, &devilutionx_mpq));
+}
+
+void CloseTestArchive()
+{
+	SetSpriteCacheBudget(64 * 1024 * 1024);
+	FreeSpriteCache();
+	SFileFreeFileCache();
+	SFileCloseArchive(devilutionx_mpq);
+	devilutionx_mpq = nullptr;
+	std::remove("Test_SpriteCache.mpq");
+}
+
+} // namespace
+
+TEST(SpriteCache, SharesData)
+{
+	OpenTestArchive();
+
+	std::shared_ptr<byte[]> first = LoadSpriteData("test\\a.cl2");
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(first[0], static_cast<byte>('a'));
+	EXPECT_TRUE(IsSpriteCached("test\\a.cl2"));
+
+	std::shared_ptr<byte[]> second = LoadSpriteData("test\\a.cl2");
+	EXPECT_EQ(first.get(), second.get());
+
+	first = nullptr;
+	second = nullptr;
+	EXPECT_TRUE(IsSpriteCached("test\\a.cl2"));
+	FreeSpriteCache();
+	EXPECT_FALSE(IsSpriteCached("test\\a.cl2"));
+
+	CloseTestArchive();
+}
+
+TEST(SpriteCache, Variants)
+{
+	OpenTestArchive();
+
+	int prepared = 0;
+	auto recolor = [&prepared](byte *data) {
+		data[0] = static_cast<byte>('x');
+		prepared++;
+	};
+
+	std::shared_ptr<byte[]> plain = LoadSpriteData("test\\b.cl2");
+	std::shared_ptr<byte[]> recolored = LoadSpriteData("test\\b.cl2", "red.trn", recolor);
+	std::shared_ptr<byte[]> again = LoadSpriteData("test\\b.cl2", "red.trn", recolor);
+
+	EXPECT_EQ(plain[0], static_cast<byte>('b'));
+	EXPECT_EQ(recolored[0], static_cast<byte>('x'));
+	EXPECT_EQ(recolored.get(), again.get());
+	EXPECT_EQ(prepared, 1);
+	EXPECT_FALSE(IsSpriteCached("test\\b.cl2", "blue.trn"));
+
+	CloseTestArchive();
+}
+
+TEST(SpriteCache, EvictsLeastRecentlyUsed)
+{
+	OpenTestArchive();
+
+	SetSpriteCacheBudget(2 * TestSpriteSize);
+
+	std::shared_ptr<byte[]> a = LoadSpriteData("test\\a.cl2");
+	LoadSpriteData("test\\b.cl2");
+	LoadSpriteData("test\\c.cl2");
+
+	// a is still in use, so b is released to make room for c
+	EXPECT_TRUE(IsSpriteCached("test\\a.cl2"));
+	EXPECT_FALSE(IsSpriteCached("test\\b.cl2"));
+	EXPECT_TRUE(IsSpriteCached("test\\c.cl2"));
+
+	a = nullptr;
+	SetSpriteCacheBudget(TestSpriteSize);
+	EXPECT_FALSE(IsSpriteCached("test\\a.cl2"));
+	EXPECT_TRUE(IsSpriteCached("test\\c.cl2"));
+
+	CloseTestArchive();
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "init.h"
+#include "mpqapi.h"
+#include "storm/storm.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int FilesPerArchive = 32;
+constexpr size_t TestFileSize = 32 * 1024;
+
+void GetTestFileName(char *name, char archive, int index)
+{
+	sprintf(name, "test\\%c%02d.bin", archive, index);
+}
+
+byte GetTestFileByte(char archive, int index, size_t offset)
+{
+	return static_cast<byte>((offset / 16 + index * 3 + archive) & 0xFF);
+}
+
+void CreateTestArchive(const char *path, char archive)
+{
+	std::remove(path);
+	ASSERT_TRUE(OpenMPQ(path));
+
+	std::vector<byte> data(TestFileSize);
+	std::string listFile;
+	char name[32];
+	for (int index = 0; index < FilesPerArchive; index++) {
+		for (size_t offset = 0; offset < TestFileSize; offset++)
+			data[offset] = GetTestFileByte(archive, index, offset);
+		GetTestFileName(name, archive, index);
+		ASSERT_TRUE(mpqapi_write_file(name, data.data(), data.size()));
+		listFile += name;
+		listFile += "\r\n";
+	}
+	ASSERT_TRUE(mpqapi_write_file("(listfile)", reinterpret_cast<const byte *>(listFile.data()), listFile.size()));
+
+	ASSERT_TRUE(mpqapi_flush_and_close(true));
+}
+
+bool ReadTestFile(char archive, int index)
+{
+	char name[32];
+	GetTestFileName(name, archive, index);
+
+	HANDLE file;
+	if (!SFileOpenFile(name, &file))
+		return false;
+
+	std::vector<byte> data(SFileGetFileSize(file));
+	bool success = data.size() == TestFileSize && SFileReadFileThreadSafe(file, data.data(), data.size());
+	SFileCloseFileThreadSafe(file);
+
+	for (size_t offset = 0; success && offset < data.size(); offset++)
+		success = data[offset] == GetTestFileByte(archive, index, offset);
+
+	return success;
+}
+
+} // namespace
+
+TEST(Storm, ConcurrentReads)
+{
+	CreateTestArchive("Test_Storm_A.mpq", 'a');
+	CreateTestArchive("Test_Storm_B.mpq", 'b');
+	ASSERT_TRUE(SFileOpenArchive("Test_Storm_A.mpq", 0, MPQ_OPEN_READ_ONLY, &devilutionx_mpq));
+	ASSERT_TRUE(SFileOpenArchive("Test_Storm_B.mpq", 0, MPQ_OPEN_READ_ONLY, &diabdat_mpq));
+
+	constexpr int ReadsPerThread = 200;
+
+	for (int threads : { 1, 4 }) {
+		std::atomic<int> failures { 0 };
+		std::vector<std::thread> readers;
+
+		for (int reader = 0; reader < threads; reader++) {
+			readers.emplace_back([reader, &failures]() {
+				for (int i = 0; i < ReadsPerThread; i++) {
+					char archive = (i + reader) % 2 == 0 ? 'a' : 'b';
+					if (!ReadTestFile(archive, (i * 7 + reader) % FilesPerArchive))
+						failures++;
+				}
+			});
+		}
+		for (std::thread &reader : readers)
+			reader.join();
+
+		EXPECT_EQ(failures, 0) << "with " << threads << " threads";
+	}
+
+	SFileFreeFileCache();
+	SFileCloseArchive(devilutionx_mpq);
+	SFileCloseArchive(diabdat_mpq);
+	devilutionx_mpq = nullptr;
+	diabdat_mpq = nullptr;
+	std::remove("Test_Storm_A.mpq");
+	std::remove("Test_Storm_B.mpq");
+}
+
+TEST(Storm, FileIndex)
+{
+	CreateTestArchive("Test_Storm_A.mpq", 'a');
+	CreateTestArchive("Test_Storm_B.mpq", 'b');
+	ASSERT_TRUE(SFileOpenArchive("Test_Storm_A.mpq", 0, MPQ_OPEN_READ_ONLY, &devilutionx_mpq));
+	ASSERT_TRUE(SFileOpenArchive("Test_Storm_B.mpq", 0, MPQ_OPEN_READ_ONLY, &hellfire_mpq));
+	SFileIndexArchives();
+
+	HANDLE file;
+	gbIsHellfire = false;
+	EXPECT_TRUE(ReadTestFile('a', 3));
+	EXPECT_FALSE(ReadTestFile('b', 3));
+	EXPECT_FALSE(SFileOpenFile("test\\c00.bin", &file));
+
+	gbIsHellfire = true;
+	EXPECT_TRUE(ReadTestFile('b', 3));
+	ASSERT_TRUE(SFileOpenFile("TEST\\A31.BIN", &file));
+	EXPECT_EQ(SFileGetFileSize(file), TestFileSize);
+	SFileCloseFileThreadSafe(file);
+	gbIsHellfire = false;
+
+	EXPECT_EQ(SFileListFiles("test").size(), FilesPerArchive * 2);
+	EXPECT_EQ(SFileListFiles("Test").size(), FilesPerArchive * 2);
+	EXPECT_TRUE(SFileListFiles("tes").empty());
+	EXPECT_EQ(SFileListFiles("test")[0], "test\\a00.bin");
+
+	SFileFreeFileCache();
+	SFileCloseArchive(devilutionx_mpq);
+	SFileCloseArchive(hellfire_mpq);
+	devilutionx_mpq = nullptr;
+	hellfire_mpq = nullptr;
+	std::remove("Test_Storm_A.mpq");
+	std::remove("Test_Storm_B.mpq");
+}
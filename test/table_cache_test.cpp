@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "engine/table_cache.hpp"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+std::string TablePath(const char *name, std::uint64_t key)
+{
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), "%s_%016llx.tbl", name, static_cast<unsigned long long>(key));
+	return paths::ConfigPath() + fileName;
+}
+
+} // namespace
+
+TEST(TableCache, RoundTrip)
+{
+	paths::SetConfigPath(".");
+	const std::uint64_t key = HashTableInput(TableKeySeed, "roundtrip", 9);
+	std::uint8_t table[300];
+	for (int i = 0; i < 300; i++)
+		table[i] = i * 7;
+
+	StoreCachedTable("test", key, table, sizeof(table));
+	EXPECT_FALSE(FileExists((TablePath("test", key) + ".tmp").c_str()));
+
+	std::uint8_t loaded[300] = {};
+	EXPECT_TRUE(LoadCachedTable("test", key, loaded, sizeof(loaded)));
+	EXPECT_EQ(memcmp(table, loaded, sizeof(table)), 0);
+
+	EXPECT_FALSE(LoadCachedTable("test", key + 1, loaded, sizeof(loaded)));
+	EXPECT_FALSE(LoadCachedTable("test", key, loaded, sizeof(loaded) - 1));
+
+	RemoveCachedTable("test", key);
+	EXPECT_FALSE(FileExists(TablePath("test", key).c_str()));
+	EXPECT_FALSE(LoadCachedTable("test", key, loaded, sizeof(loaded)));
+}
+
+TEST(TableCache, RejectsDamagedFile)
+{
+	paths::SetConfigPath(".");
+	const std::uint64_t key = HashTableInput(TableKeySeed, "damaged", 7);
+	std::uint8_t table[64];
+	for (int i = 0; i < 64; i++)
+		table[i] = i;
+	StoreCachedTable("test", key, table, sizeof(table));
+
+	const std::string path = TablePath("test", key);
+	FILE *file = FOpen(path.c_str(), "r+b");
+	ASSERT_NE(file, nullptr);
+	fseek(file, -1, SEEK_END);
+	fputc(0xAA, file);
+	fclose(file);
+
+	std::uint8_t loaded[64];
+	EXPECT_FALSE(LoadCachedTable("test", key, loaded, sizeof(loaded)));
+	RemoveFile(path.c_str());
+}
+
+TEST(TableCache, HashDependsOnEveryByte)
+{
+	std::uint8_t input[16] = {};
+	const std::uint64_t key = HashTableInput(TableKeySeed, input, sizeof(input));
+	for (int i = 0; i < 16; i++) {
+		input[i] = 1;
+		EXPECT_NE(HashTableInput(TableKeySeed, input, sizeof(input)), key) << i;
+		input[i] = 0;
+	}
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DiabloUI/ui_item.h"
+#include "engine/render/text_render.hpp"
+#include "scrollrt.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int FontFrames = 68;
+
+/**
+ * @brief Build a CEL font of random glyphs with transparent gaps, every glyph filling the given height
+ */
+CelSprite MakeFont(int width, int height, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<std::vector<uint8_t>> frames(FontFrames);
+	for (std::vector<uint8_t> &frame : frames) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width;) {
+				const int length = std::min<int>(rng() % 8 + 1, width - x);
+				if (rng() % 3 == 0) {
+					frame.push_back(static_cast<uint8_t>(-length));
+				} else {
+					frame.push_back(static_cast<uint8_t>(length));
+					for (int i = 0; i < length; i++)
+						frame.push_back(static_cast<uint8_t>(rng()));
+				}
+				x += length;
+			}
+		}
+	}
+
+	std::vector<uint32_t> table = { FontFrames };
+	uint32_t offset = (FontFrames + 2) * sizeof(uint32_t);
+	for (const std::vector<uint8_t> &frame : frames) {
+		table.push_back(offset);
+		offset += static_cast<uint32_t>(frame.size());
+	}
+	table.push_back(offset);
+
+	auto data = std::make_unique<byte[]>(offset);
+	for (size_t i = 0; i < table.size(); i++) {
+		const uint32_t value = SDL_SwapLE32(table[i]);
+		memcpy(&data[i * sizeof(uint32_t)], &value, sizeof(value));
+	}
+	offset = static_cast<uint32_t>(table.size() * sizeof(uint32_t));
+	for (const std::vector<uint8_t> &frame : frames) {
+		memcpy(&data[offset], frame.data(), frame.size());
+		offset += static_cast<uint32_t>(frame.size());
+	}
+	return CelSprite { std::move(data), width };
+}
+
+/**
+ * @brief Load the test fonts, which also empties the text cache
+ */
+void ResetText()
+{
+	InitText(MakeFont(13, 11, 1), MakeFont(22, 30, 2), MakeFont(46, 45, 3));
+}
+
+/**
+ * @brief Draw a string uncached, then from a freshly baked raster and then from the cache, and compare the results
+ */
+void ExpectSameWithCache(const char *text, const Rectangle &rect, uint16_t flags, int spacing = 1, Rectangle clip = { { 0, 0 }, { 640, 480 } })
+{
+	ResetText();
+	CelOutputBuffer buffers[3];
+	int charactersDrawn[3];
+	for (int i = 0; i < 3; i++) {
+		buffers[i] = CelOutputBuffer::Alloc(640, 480);
+		memset(buffers[i].begin(), 0x55, 640 * 480);
+		const CelOutputBuffer out = buffers[i].subregion(clip.position.x, clip.position.y, clip.size.width, clip.size.height);
+		charactersDrawn[i] = DrawString(out, text, rect, flags, spacing);
+	}
+	light_table_index = 0;
+
+	for (int i = 1; i < 3; i++) {
+		EXPECT_EQ(charactersDrawn[i], charactersDrawn[0]) << "draw " << i;
+		EXPECT_EQ(memcmp(buffers[i].begin(), buffers[0].begin(), 640 * 480), 0) << "draw " << i;
+	}
+	for (CelOutputBuffer &buffer : buffers)
+		buffer.Free();
+}
+
+} // namespace
+
+TEST(TextRender, CachedAlignments)
+{
+	for (uint16_t alignment : { 0, +UIS_CENTER, +UIS_RIGHT, UIS_FIT_SPACING | UIS_CENTER }) {
+		SCOPED_TRACE(alignment);
+		ExpectSameWithCache("Hello, World!\nSecond line", { { 20, 40 }, { 300, 0 } }, alignment);
+		ExpectSameWithCache("Word wrapped text that does not fit on one line", { { 100, 100 }, { 120, 60 } }, alignment, 2);
+	}
+}
+
+TEST(TextRender, CachedColorsAndFonts)
+{
+	for (uint16_t font : { 0, +UIS_MED, +UIS_HUGE }) {
+		for (uint16_t color : { 0, +UIS_SILVER, +UIS_BLUE, +UIS_RED }) {
+			SCOPED_TRACE(font | color);
+			ExpectSameWithCache("Gold: 12345", { { 30, 200 }, { 500, 0 } }, font | color);
+		}
+	}
+}
+
+TEST(TextRender, CachedClipping)
+{
+	// Rectangles over each edge of the buffer, and a bottom margin that cuts off the second line
+	ExpectSameWithCache("Off the left edge", { { -25, 50 }, { 300, 0 } }, UIS_MED);
+	ExpectSameWithCache("Off the top edge", { { 50, 10 }, { 300, 0 } }, UIS_HUGE);
+	ExpectSameWithCache("Off the right edge", { { 560, 50 }, { 300, 0 } }, 0);
+	ExpectSameWithCache("Off the bottom edge", { { 50, 470 }, { 300, 0 } }, UIS_MED);
+	ExpectSameWithCache("First line\nSecond line", { { 50, 50 }, { 300, 20 } }, UIS_MED);
+	ExpectSameWithCache("In a subregion", { { -10, 15 }, { 300, 0 } }, UIS_HUGE | UIS_CENTER, 1, { { 100, 100 }, { 150, 40 } });
+}
+
+TEST(TextRender, UncachedStrings)
+{
+	// Black text, strings over 256 characters and rasters over 64 Ki pixels are always drawn glyph by glyph
+	ExpectSameWithCache("Black text", { { 20, 40 }, { 300, 0 } }, UIS_BLACK);
+	const std::string longText(300, 'a');
+	ExpectSameWithCache(longText.c_str(), { { 0, 20 }, { 640, 0 } }, 0);
+	const std::string largeText(100, 'W');
+	ExpectSameWithCache(largeText.c_str(), { { 0, 50 }, { 640, 0 } }, UIS_HUGE);
+}
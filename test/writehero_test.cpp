@@ -351,12 +351,15 @@ static void AssertPlayer(PlayerStruct &player)
 	ASSERT_EQ(player.pOriginalCathedral, 0);
 }
 
-TEST(Writehero, pfile_write_hero)
+/**
+ * @brief Create a fresh multiplayer save holding the test player
+ */
+static void CreateTestHero(bool vanilla)
 {
 	paths::SetPrefPath(".");
 	std::remove("multi_0.sv");
 
-	gbVanilla = true;
+	gbVanilla = vanilla;
 	gbIsHellfire = false;
 	gbIsMultiplayer = true;
 	gbIsHellfireSaveGame = false;
@@ -370,6 +373,11 @@ TEST(Writehero, pfile_write_hero)
 	PkPlayerStruct pks;
 	PackPlayerTest(&pks);
 	UnPackPlayer(&pks, myplr, true);
+}
+
+TEST(Writehero, pfile_write_hero)
+{
+	CreateTestHero(true);
 	AssertPlayer(plr[0]);
 	pfile_write_hero();
 
@@ -379,3 +387,67 @@ TEST(Writehero, pfile_write_hero)
 	EXPECT_EQ(picosha2::bytes_to_hex_string(s.begin(), s.end()),
 	    "08e9807d1281e4273268f4e265757b4429cfec7c3e8b6deb89dfa109d6797b1c");
 }
+
+TEST(Writehero, UnchangedFilesAreNotRewritten)
+{
+	CreateTestHero(false);
+	pfile_write_hero();
+
+	std::ifstream before("multi_0.sv", std::ios::binary);
+	std::vector<char> saved { std::istreambuf_iterator<char>(before), std::istreambuf_iterator<char>() };
+	before.close();
+
+	// Nothing changed, so the archive is left as is rather than getting the same files written again
+	pfile_write_hero();
+
+	std::ifstream after("multi_0.sv", std::ios::binary);
+	std::vector<char> resaved { std::istreambuf_iterator<char>(after), std::istreambuf_iterator<char>() };
+	EXPECT_EQ(resaved, saved);
+	gbVanilla = true;
+}
+
+static std::vector<_uiheroinfo> ListedHeroes;
+
+static bool AddListedHero(_uiheroinfo *info)
+{
+	ListedHeroes.push_back(*info);
+	return true;
+}
+
+TEST(Writehero, HeroListFollowsSaves)
+{
+	paths::SetConfigPath(".");
+	CreateTestHero(true);
+	pfile_write_hero();
+	pfile_reset_hero_index(true);
+
+	ListedHeroes.clear();
+	pfile_ui_set_hero_infos(AddListedHero);
+	ASSERT_EQ(ListedHeroes.size(), 1);
+	EXPECT_STREQ(ListedHeroes[0].name, "TestPlayer");
+	EXPECT_EQ(ListedHeroes[0].level, 50);
+
+	// The second listing comes from the hero index stored on disk, and must match the first
+	pfile_reset_hero_index();
+	ListedHeroes.clear();
+	pfile_ui_set_hero_infos(AddListedHero);
+	ASSERT_EQ(ListedHeroes.size(), 1);
+	EXPECT_EQ(ListedHeroes[0].level, 50);
+
+	// The stored index is outdated now, which the size and time of the save must reveal
+	plr[myplr]._pLevel = 30;
+	pfile_write_hero();
+	pfile_reset_hero_index();
+	ListedHeroes.clear();
+	pfile_ui_set_hero_infos(AddListedHero);
+	ASSERT_EQ(ListedHeroes.size(), 1);
+	EXPECT_EQ(ListedHeroes[0].level, 30);
+
+	pfile_delete_save(&ListedHeroes[0]);
+	pfile_reset_hero_index();
+	ListedHeroes.clear();
+	pfile_ui_set_hero_infos(AddListedHero);
+	EXPECT_TRUE(ListedHeroes.empty());
+
+	pfile_reset_hero_index(true);
+}